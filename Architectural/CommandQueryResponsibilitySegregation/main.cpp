@@ -10,178 +10,567 @@
  * - Improved scalability: Command operations are optimized for writing, while query operations are optimized for reading.
  * - Separation of responsibilities: Enables a more maintainable and scalable system.
  * - Enhanced performance: Each side (Command and Query) can be optimized independently.
+ *
+ * Executing every command and query synchronously against one shared map stops
+ * scaling at tens of thousands of operations per second: reads and writes
+ * contend on the same lock. PipelinedCustomerService below batches submitted
+ * commands through a log and applies them in pipelined groups, projects the
+ * applied commands asynchronously into a denormalized read model so queries
+ * never touch write-side locks, and version-stamps query results so caches
+ * invalidate only the keys a command batch actually touched.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Command interface for modifying customer data.
+ */
+class ICommand
+{
+public:
+    virtual ~ICommand() = default;
+
+    /**
+     * @brief Executes the command.
+     */
+    virtual void execute() = 0;
+};
+
+/**
+ * @brief Command to add a new customer.
+ */
+class AddCustomerCommand : public ICommand
+{
+public:
+    AddCustomerCommand(std::unordered_map<int, std::string>& customers, int id, const std::string& name)
+        : m_customers(customers), m_id(id), m_name(name) {}
+
+    void execute() override
+    {
+        m_customers[m_id] = m_name;
+        std::cout << "Customer added: " << m_name << " with ID: " << m_id << std::endl;
+    }
+
+private:
+    std::unordered_map<int, std::string>& m_customers; ///< Customer database.
+    int m_id; ///< Customer ID.
+    std::string m_name; ///< Customer name.
+};
+
+/**
+ * @brief Command to remove a customer.
+ */
+class RemoveCustomerCommand : public ICommand
+{
+public:
+    RemoveCustomerCommand(std::unordered_map<int, std::string>& customers, int id)
+        : m_customers(customers), m_id(id) {}
+
+    void execute() override
+    {
+        auto it = m_customers.find(m_id);
+        if (it != m_customers.end())
+        {
+            std::cout << "Customer removed: " << it->second << " with ID: " << m_id << std::endl;
+            m_customers.erase(it);
+        }
+        else
+        {
+            std::cout << "Customer with ID: " << m_id << " not found." << std::endl;
+        }
+    }
+
+private:
+    std::unordered_map<int, std::string>& m_customers; ///< Customer database.
+    int m_id; ///< Customer ID.
+};
+
+/**
+ * @brief Query interface for reading customer data.
+ */
+class IQuery
+{
+public:
+    virtual ~IQuery() = default;
+
+    /**
+     * @brief Executes the query.
+     */
+    virtual void execute() const = 0;
+};
+
+/**
+ * @brief Query to retrieve customer details by ID.
+ */
+class GetCustomerQuery : public IQuery
+{
+public:
+    GetCustomerQuery(const std::unordered_map<int, std::string>& customers, int id)
+        : m_customers(customers), m_id(id) {}
+
+    void execute() const override
+    {
+        auto it = m_customers.find(m_id);
+        if (it != m_customers.end())
+        {
+            std::cout << "Customer found: " << it->second << " with ID: " << m_id << std::endl;
+        }
+        else
+        {
+            std::cout << "Customer with ID: " << m_id << " not found." << std::endl;
+        }
+    }
+
+private:
+    const std::unordered_map<int, std::string>& m_customers; ///< Customer database.
+    int m_id; ///< Customer ID.
+};
+
+/**
+ * @brief Manages command and query operations for customer data.
+ */
+class CustomerService
+{
+public:
+    /**
+     * @brief Executes a command to modify customer data.
+     * @param command The command to execute.
+     */
+    void executeCommand(std::shared_ptr<ICommand> command)
+    {
+        command->execute();
+    }
+
+    /**
+     * @brief Executes a query to retrieve customer data.
+     * @param query The query to execute.
+     */
+    void executeQuery(std::shared_ptr<IQuery> query)
+    {
+        query->execute();
+    }
+
+    /**
+     * @brief Getter for customers data.
+     * @return A reference to the customers map.
+     */
+    std::unordered_map<int, std::string>& getCustomers()
+    {
+        return m_customers;
+    }
+
+private:
+    std::unordered_map<int, std::string> m_customers; ///< Customer database.
+};
+
+/**
+ * @brief A write operation as data, so it can be logged and batch-applied.
+ */
+struct CustomerCommand
+{
+    enum class Op { Add, Remove };
+
+    Op op;
+    int id;
+    std::string name; ///< Used by Add only.
+};
+
+/**
+ * @brief Baseline service: one mutex shared by every command and query.
+ */
+class LockedCustomerService
+{
+public:
+    void apply(const CustomerCommand& command)
+    {
+        std::lock_guard lock(m_mutex);
+        if (command.op == CustomerCommand::Op::Add)
+        {
+            m_customers[command.id] = command.name;
+        }
+        else
+        {
+            m_customers.erase(command.id);
+        }
+    }
+
+    bool getCustomer(int id, std::string& nameOut) const
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_customers.find(id);
+        if (it == m_customers.end())
+        {
+            return false;
+        }
+        nameOut = it->second;
+        return true;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::unordered_map<int, std::string> m_customers;
+};
+
+/**
+ * @brief CQRS service with a pipelined command log and a cached read side.
+ *
+ * submit() only appends to the command log; a background applier drains the
+ * log in whole batches, applies them to the write model under one lock
+ * acquisition per batch, and projects the result into a denormalized read
+ * model whose entries carry the version of the last command that touched
+ * them. Queries go through the read model only — write-side locks are never
+ * taken on the query path — and callers keep a QueryCache validated by those
+ * per-key versions, so a command batch invalidates exactly the cached keys
+ * it wrote.
  */
+class PipelinedCustomerService
+{
+public:
+    /**
+     * @brief A caller-owned query cache; entries outlive unrelated commands.
+     */
+    struct QueryCache
+    {
+        struct Entry
+        {
+            bool present;
+            std::string name;
+            std::uint64_t keyVersion;      ///< Version of the read entry when cached.
+            std::uint64_t snapshotVersion; ///< Applied-version when last validated.
+        };
+
+        std::unordered_map<int, Entry> entries;
+        std::size_t fastHits{0};        ///< Served with no lock at all.
+        std::size_t revalidatedHits{0}; ///< Key untouched by later commands.
+        std::size_t misses{0};          ///< Absent or invalidated by a write.
+    };
+
+    PipelinedCustomerService()
+        : m_applier([this] { applierLoop(); })
+    {}
+
+    ~PipelinedCustomerService()
+    {
+        {
+            std::lock_guard lock(m_logMutex);
+            m_stop = true;
+        }
+        m_logCv.notify_all();
+        m_applier.join();
+    }
+
+    /// @brief Appends a command to the log; application is asynchronous.
+    void submit(CustomerCommand command)
+    {
+        bool applierParked;
+        {
+            std::lock_guard lock(m_logMutex);
+            m_pending.push_back(std::move(command));
+            applierParked = m_applierWaiting;
+        }
+        if (applierParked)
+        {
+            m_logCv.notify_one();
+        }
+    }
+
+    /// @brief Appends a whole pipelined group under one lock with one wakeup.
+    void submitBatch(std::vector<CustomerCommand>& commands)
+    {
+        bool applierParked;
+        {
+            std::lock_guard lock(m_logMutex);
+            for (CustomerCommand& command : commands)
+            {
+                m_pending.push_back(std::move(command));
+            }
+            applierParked = m_applierWaiting;
+        }
+        commands.clear();
+        if (applierParked)
+        {
+            m_logCv.notify_one();
+        }
+    }
+
+    /// @brief Blocks until every submitted command has been applied.
+    void drain()
+    {
+        std::unique_lock lock(m_logMutex);
+        m_drainCv.wait(lock, [this] { return m_pending.empty() && !m_applying; });
+    }
+
+    /**
+     * @brief Reads a customer through the caller's version-stamped cache.
+     *
+     * If no command has been applied since the entry was validated, the
+     * cached result is returned with zero locking. Otherwise the read model
+     * is consulted under a shared lock; an unchanged per-key version means
+     * the entry survived the intervening commands.
+     */
+    bool getCustomer(int id, std::string& nameOut, QueryCache& cache)
+    {
+        std::uint64_t applied = m_appliedVersion.load(std::memory_order_acquire);
+        auto cached = cache.entries.find(id);
+        if (cached != cache.entries.end() && cached->second.snapshotVersion == applied)
+        {
+            ++cache.fastHits; // Nothing applied since validation: no lock needed.
+            nameOut = cached->second.name;
+            return cached->second.present;
+        }
+
+        std::shared_lock lock(m_readMutex);
+        auto it = m_readModel.find(id);
+        std::uint64_t keyVersion = it == m_readModel.end() ? 0 : it->second.version;
+        if (cached != cache.entries.end() && cached->second.keyVersion == keyVersion)
+        {
+            ++cache.revalidatedHits; // Commands ran, but none touched this key.
+            cached->second.snapshotVersion = applied;
+            nameOut = cached->second.name;
+            return cached->second.present;
+        }
+
+        ++cache.misses;
+        QueryCache::Entry entry;
+        entry.present = it != m_readModel.end();
+        entry.name = entry.present ? it->second.name : std::string();
+        entry.keyVersion = keyVersion;
+        entry.snapshotVersion = applied;
+        nameOut = entry.name;
+        bool present = entry.present;
+        cache.entries[id] = std::move(entry);
+        return present;
+    }
+
+    std::size_t batchesApplied() const { return m_batchesApplied.load(); }
+
+private:
+    /**
+     * @brief One denormalized read-model row, stamped with its last writer.
+     */
+    struct ReadEntry
+    {
+        std::string name;
+        std::uint64_t version;
+    };
+
+    /// @brief Drains the log in whole batches and projects them to the read side.
+    void applierLoop()
+    {
+        std::vector<CustomerCommand> batch;
+        for (;;)
+        {
+            {
+                std::unique_lock lock(m_logMutex);
+                m_applierWaiting = true;
+                m_logCv.wait(lock, [this] { return !m_pending.empty() || m_stop; });
+                m_applierWaiting = false;
+                if (m_pending.empty() && m_stop)
+                {
+                    return;
+                }
+                batch.swap(m_pending); // The whole backlog becomes one pipelined group.
+                m_applying = true;
+            }
+
+            {
+                std::lock_guard writeLock(m_writeMutex); // One acquisition per batch.
+                for (const CustomerCommand& command : batch)
+                {
+                    if (command.op == CustomerCommand::Op::Add)
+                    {
+                        m_writeModel[command.id] = command.name;
+                    }
+                    else
+                    {
+                        m_writeModel.erase(command.id);
+                    }
+                }
+            }
+
+            {
+                std::unique_lock readLock(m_readMutex);
+                for (const CustomerCommand& command : batch)
+                {
+                    std::uint64_t version = ++m_versionCounter;
+                    if (command.op == CustomerCommand::Op::Add)
+                    {
+                        m_readModel[command.id] = ReadEntry{command.name, version};
+                    }
+                    else
+                    {
+                        m_readModel.erase(command.id); // Absent reads as version 0: cached entries invalidate.
+                    }
+                }
+            }
+            m_appliedVersion.store(m_versionCounter, std::memory_order_release);
+            m_batchesApplied.fetch_add(1, std::memory_order_relaxed);
+
+            batch.clear();
+            {
+                std::lock_guard lock(m_logMutex);
+                m_applying = false;
+            }
+            m_drainCv.notify_all();
+        }
+    }
+
+    // Command log.
+    std::mutex m_logMutex;
+    std::condition_variable m_logCv;
+    std::condition_variable m_drainCv;
+    std::vector<CustomerCommand> m_pending; ///< Commands awaiting application.
+    bool m_applierWaiting{false};           ///< Applier parked on the cv.
+    bool m_applying{false};
+    bool m_stop{false};
+    std::thread m_applier;
+
+    // Write side.
+    std::mutex m_writeMutex;
+    std::unordered_map<int, std::string> m_writeModel;
+
+    // Read side.
+    mutable std::shared_mutex m_readMutex;
+    std::unordered_map<int, ReadEntry> m_readModel; ///< Denormalized projection.
+    std::uint64_t m_versionCounter{0};              ///< Stamped per applied command.
+    std::atomic<std::uint64_t> m_appliedVersion{0}; ///< Lock-free cache fast path.
+    std::atomic<std::size_t> m_batchesApplied{0};
+};
+
+/**
+ * @brief Demonstrates the CQRS pattern by separating commands and queries in a customer management system.
+ */
+int main()
+{
+    // Instantiate the customer service
+    CustomerService customerService;
+
+    // Adding customers via command
+    customerService.executeCommand(std::make_shared<AddCustomerCommand>(customerService.getCustomers(), 1, "John Doe"));
+    customerService.executeCommand(std::make_shared<AddCustomerCommand>(customerService.getCustomers(), 2, "Jane Smith"));
+
+    // Querying customer data
+    customerService.executeQuery(std::make_shared<GetCustomerQuery>(customerService.getCustomers(), 1));
+    customerService.executeQuery(std::make_shared<GetCustomerQuery>(customerService.getCustomers(), 2));
+
+    // Removing a customer via command
+    customerService.executeCommand(std::make_shared<RemoveCustomerCommand>(customerService.getCustomers(), 1));
+
+    // Querying customer data again
+    customerService.executeQuery(std::make_shared<GetCustomerQuery>(customerService.getCustomers(), 1));
+    customerService.executeQuery(std::make_shared<GetCustomerQuery>(customerService.getCustomers(), 2));
+
+    // Pipelined mode: a write-heavy commander racing a read-heavy querier.
+    constexpr int commandCount = 20000;
+    constexpr int queryCount = 200000; ///< Per reader.
+    constexpr int readerCount = 2;
+    constexpr std::size_t commandGroupSize = 256; ///< Commands per pipelined group.
+    constexpr int writtenKeys = 2000;  ///< Commands touch only this key range.
+    constexpr int queriedKeys = 10000; ///< Queries sweep a much wider range.
+
+    auto makeCommand = [](int i)
+    {
+        int id = (i * 37) % writtenKeys;
+        if (i % 4 == 3)
+        {
+            return CustomerCommand{CustomerCommand::Op::Remove, id, std::string()};
+        }
+        return CustomerCommand{CustomerCommand::Op::Add, id, "customer-" + std::to_string(id)};
+    };
+
+    LockedCustomerService locked;
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::thread commander([&locked, &makeCommand]
+        {
+            for (int i = 0; i < commandCount; ++i)
+            {
+                locked.apply(makeCommand(i)); // One lock per command, shared with readers.
+            }
+        });
+        std::vector<std::thread> queriers;
+        for (int reader = 0; reader < readerCount; ++reader)
+        {
+            queriers.emplace_back([&locked]
+            {
+                std::string name;
+                for (int i = 0; i < queryCount; ++i)
+                {
+                    locked.getCustomer((i * 13) % queriedKeys, name);
+                }
+            });
+        }
+        commander.join();
+        for (auto& querier : queriers)
+        {
+            querier.join();
+        }
+    }
+    double lockedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    PipelinedCustomerService pipelined;
+    std::vector<PipelinedCustomerService::QueryCache> caches(readerCount);
+    start = std::chrono::steady_clock::now();
+    {
+        std::thread commander([&pipelined, &makeCommand]
+        {
+            std::vector<CustomerCommand> group;
+            group.reserve(commandGroupSize);
+            for (int i = 0; i < commandCount; ++i)
+            {
+                group.push_back(makeCommand(i));
+                if (group.size() == commandGroupSize)
+                {
+                    pipelined.submitBatch(group); // One log append per pipelined group.
+                }
+            }
+            pipelined.submitBatch(group);
+            pipelined.drain();
+        });
+        std::vector<std::thread> queriers;
+        for (int reader = 0; reader < readerCount; ++reader)
+        {
+            queriers.emplace_back([&pipelined, &caches, reader]
+            {
+                std::string name;
+                for (int i = 0; i < queryCount; ++i)
+                {
+                    pipelined.getCustomer((i * 13) % queriedKeys, name, caches[reader]);
+                }
+            });
+        }
+        commander.join();
+        for (auto& querier : queriers)
+        {
+            querier.join();
+        }
+    }
+    double pipelinedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::size_t fastHits = 0, revalidated = 0, misses = 0;
+    for (const auto& cache : caches)
+    {
+        fastHits += cache.fastHits;
+        revalidated += cache.revalidatedHits;
+        misses += cache.misses;
+    }
+    std::cout << commandCount << " command(s) + " << readerCount << "x" << queryCount
+              << " query(ies): shared lock " << lockedTime << " ms, pipelined CQRS "
+              << pipelinedTime << " ms (" << pipelined.batchesApplied()
+              << " batch(es), cache " << fastHits << " fast hit(s), " << revalidated
+              << " revalidated, " << misses << " miss(es))" << std::endl;
 
- #include <iostream>
- #include <string>
- #include <vector>
- #include <memory>
- #include <unordered_map>
- 
- /**
-  * @brief Command interface for modifying customer data.
-  */
- class ICommand
- {
- public:
-     virtual ~ICommand() = default;
- 
-     /**
-      * @brief Executes the command.
-      */
-     virtual void execute() = 0;
- };
- 
- /**
-  * @brief Command to add a new customer.
-  */
- class AddCustomerCommand : public ICommand
- {
- public:
-     AddCustomerCommand(std::unordered_map<int, std::string>& customers, int id, const std::string& name)
-         : m_customers(customers), m_id(id), m_name(name) {}
- 
-     void execute() override
-     {
-         m_customers[m_id] = m_name;
-         std::cout << "Customer added: " << m_name << " with ID: " << m_id << std::endl;
-     }
- 
- private:
-     std::unordered_map<int, std::string>& m_customers; ///< Customer database.
-     int m_id; ///< Customer ID.
-     std::string m_name; ///< Customer name.
- };
- 
- /**
-  * @brief Command to remove a customer.
-  */
- class RemoveCustomerCommand : public ICommand
- {
- public:
-     RemoveCustomerCommand(std::unordered_map<int, std::string>& customers, int id)
-         : m_customers(customers), m_id(id) {}
- 
-     void execute() override
-     {
-         auto it = m_customers.find(m_id);
-         if (it != m_customers.end())
-         {
-             std::cout << "Customer removed: " << it->second << " with ID: " << m_id << std::endl;
-             m_customers.erase(it);
-         }
-         else
-         {
-             std::cout << "Customer with ID: " << m_id << " not found." << std::endl;
-         }
-     }
- 
- private:
-     std::unordered_map<int, std::string>& m_customers; ///< Customer database.
-     int m_id; ///< Customer ID.
- };
- 
- /**
-  * @brief Query interface for reading customer data.
-  */
- class IQuery
- {
- public:
-     virtual ~IQuery() = default;
- 
-     /**
-      * @brief Executes the query.
-      */
-     virtual void execute() const = 0;
- };
- 
- /**
-  * @brief Query to retrieve customer details by ID.
-  */
- class GetCustomerQuery : public IQuery
- {
- public:
-     GetCustomerQuery(const std::unordered_map<int, std::string>& customers, int id)
-         : m_customers(customers), m_id(id) {}
- 
-     void execute() const override
-     {
-         auto it = m_customers.find(m_id);
-         if (it != m_customers.end())
-         {
-             std::cout << "Customer found: " << it->second << " with ID: " << m_id << std::endl;
-         }
-         else
-         {
-             std::cout << "Customer with ID: " << m_id << " not found." << std::endl;
-         }
-     }
- 
- private:
-     const std::unordered_map<int, std::string>& m_customers; ///< Customer database.
-     int m_id; ///< Customer ID.
- };
- 
- /**
-  * @brief Manages command and query operations for customer data.
-  */
- class CustomerService
- {
- public:
-     /**
-      * @brief Executes a command to modify customer data.
-      * @param command The command to execute.
-      */
-     void executeCommand(std::shared_ptr<ICommand> command)
-     {
-         command->execute();
-     }
- 
-     /**
-      * @brief Executes a query to retrieve customer data.
-      * @param query The query to execute.
-      */
-     void executeQuery(std::shared_ptr<IQuery> query)
-     {
-         query->execute();
-     }
- 
-     /**
-      * @brief Getter for customers data.
-      * @return A reference to the customers map.
-      */
-     std::unordered_map<int, std::string>& getCustomers()
-     {
-         return m_customers;
-     }
- 
- private:
-     std::unordered_map<int, std::string> m_customers; ///< Customer database.
- };
- 
- /**
-  * @brief Demonstrates the CQRS pattern by separating commands and queries in a customer management system.
-  */
- int main()
- {
-     // Instantiate the customer service
-     CustomerService customerService;
- 
-     // Adding customers via command
-     customerService.executeCommand(std::make_shared<AddCustomerCommand>(customerService.getCustomers(), 1, "John Doe"));
-     customerService.executeCommand(std::make_shared<AddCustomerCommand>(customerService.getCustomers(), 2, "Jane Smith"));
- 
-     // Querying customer data
-     customerService.executeQuery(std::make_shared<GetCustomerQuery>(customerService.getCustomers(), 1));
-     customerService.executeQuery(std::make_shared<GetCustomerQuery>(customerService.getCustomers(), 2));
- 
-     // Removing a customer via command
-     customerService.executeCommand(std::make_shared<RemoveCustomerCommand>(customerService.getCustomers(), 1));
- 
-     // Querying customer data again
-     customerService.executeQuery(std::make_shared<GetCustomerQuery>(customerService.getCustomers(), 1));
-     customerService.executeQuery(std::make_shared<GetCustomerQuery>(customerService.getCustomers(), 2));
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
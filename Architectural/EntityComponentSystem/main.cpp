@@ -2,20 +2,22 @@
  * @brief
  * The Entity-Component-System (ECS) pattern separates data (components) from behavior (systems) and identifies objects (entities)
  * by IDs. It improves cache locality, flexibility, and decouples systems for better performance and scalability.
- * 
+ *
  * Key Concepts:
  * - Entity: A unique identifier representing an object in the world.
  * - Component: Plain data associated with entities (no logic).
  * - System: Operates on entities with specific components.
- * 
+ * - Archetype: A packed Structure-of-Arrays block holding all entities that share the same component signature.
+ *
  * Benefits:
- * - Improved cache locality by storing components contiguously.
+ * - Improved cache locality by storing components contiguously per archetype.
+ * - update() walks dense arrays linearly instead of doing per-entity lookups.
  * - Flexible composition of behavior by mixing components.
  * - Decouples data and logic for better maintainability and testing.
  */
 
+#include <cstdint>
 #include <iostream>
-#include <memory>
 #include <vector>
 
 /**
@@ -40,33 +42,134 @@ struct Velocity
 using Entity = std::size_t;
 
 /**
- * @brief ECS world managing entities and their components.
+ * @brief Bitmask describing which components an entity carries.
  */
-class World
+using Signature = std::uint32_t;
+
+/**
+ * @brief Compile-time component-to-bit mapping used to build signatures.
+ */
+template <typename T>
+struct ComponentBit; ///< Declared only
+
+template <>
+struct ComponentBit<Position>
+{
+    static constexpr Signature value = 1u << 0;
+};
+
+template <>
+struct ComponentBit<Velocity>
+{
+    static constexpr Signature value = 1u << 1;
+};
+
+/**
+ * @brief Packed Structure-of-Arrays storage for one component signature.
+ *
+ * All entities sharing a signature live in the same archetype. Component
+ * columns are dense vectors kept in lockstep with m_entities, so systems can
+ * iterate them linearly with perfect cache locality. Removal swaps the last
+ * row into the vacated slot to keep the arrays packed.
+ */
+class Archetype
 {
 public:
+    explicit Archetype(Signature signature) : m_signature(signature) {}
+
     /**
-     * @brief Creates a new entity.
-     * @return The ID of the newly created entity.
+     * @brief Returns the component signature shared by all rows.
      */
-    Entity createEntity()
+    Signature signature() const { return m_signature; }
+
+    /**
+     * @brief Number of entities stored in this archetype.
+     */
+    std::size_t size() const { return m_entities.size(); }
+
+    /**
+     * @brief Appends an entity row and returns its dense index.
+     */
+    std::size_t insert(Entity entity, const Position &pos, const Velocity &vel)
     {
-        Entity id = m_nextEntityId++;
-        if (id >= m_entityExists.size())
+        m_entities.push_back(entity);
+        if (m_signature & ComponentBit<Position>::value)
+        {
+            m_positions.push_back(pos);
+        }
+        if (m_signature & ComponentBit<Velocity>::value)
         {
-            m_entityExists.resize(id + 1, true);
-            m_positions.resize(id + 1);
-            m_velocities.resize(id + 1);
+            m_velocities.push_back(vel);
         }
-        else
+        return m_entities.size() - 1;
+    }
+
+    /**
+     * @brief Swap-removes the row at the given index.
+     * @return The entity that was moved into the vacated slot, or the removed
+     *         entity itself when the last row was removed.
+     */
+    Entity swapRemove(std::size_t index)
+    {
+        Entity moved = m_entities.back();
+        m_entities[index] = moved;
+        m_entities.pop_back();
+        if (m_signature & ComponentBit<Position>::value)
         {
-            m_entityExists[id] = true;
+            m_positions[index] = m_positions.back();
+            m_positions.pop_back();
         }
+        if (m_signature & ComponentBit<Velocity>::value)
+        {
+            m_velocities[index] = m_velocities.back();
+            m_velocities.pop_back();
+        }
+        return moved;
+    }
+
+    /**
+     * @brief Reads the component row at the given dense index.
+     */
+    Position &positionAt(std::size_t index) { return m_positions[index]; }
+    Velocity &velocityAt(std::size_t index) { return m_velocities[index]; }
+    Entity entityAt(std::size_t index) const { return m_entities[index]; }
+
+private:
+    Signature m_signature{0};
+    std::vector<Entity> m_entities;   ///< Row-to-entity reverse mapping.
+    std::vector<Position> m_positions;  ///< Dense column, present when signature has the Position bit.
+    std::vector<Velocity> m_velocities; ///< Dense column, present when signature has the Velocity bit.
+};
+
+/**
+ * @brief ECS world managing entities and archetype-grouped component storage.
+ *
+ * Each live entity owns one row in exactly one archetype; m_records remaps
+ * entity IDs to their (archetype, row) location and stays stable across the
+ * swap-remove moves that keep the columns packed.
+ */
+class World
+{
+public:
+    /**
+     * @brief Creates a new entity with an empty component signature.
+     * @return The ID of the newly created entity.
+     */
+    Entity createEntity()
+    {
+        Entity id = m_nextEntityId++;
+        std::size_t archetype = archetypeFor(0);
+        std::size_t row = m_archetypes[archetype].insert(id, {}, {});
+        m_records.push_back(Record{archetype, row, true});
         return id;
     }
 
     /**
      * @brief Adds a component of type T to the given entity.
+     *
+     * The entity row migrates to the archetype matching its new signature,
+     * so storage stays grouped by signature at all times.
+     *
      * @tparam T The component type.
      * @param entity The target entity.
      * @param component The component instance to store.
@@ -74,76 +177,131 @@ public:
     template <typename T>
     void addComponent(Entity entity, const T &component)
     {
-        auto &storage = getComponentStorage<T>();
-        if (entity >= storage.size())
-        {
-            storage.resize(entity + 1);
-        }
-        storage[entity] = std::make_shared<T>(component);
+        Record &record = m_records[entity];
+        Archetype &source = m_archetypes[record.archetype];
+
+        Position pos = (source.signature() & ComponentBit<Position>::value) ? source.positionAt(record.row) : Position{};
+        Velocity vel = (source.signature() & ComponentBit<Velocity>::value) ? source.velocityAt(record.row) : Velocity{};
+        assign(pos, vel, component);
+
+        Signature newSignature = source.signature() | ComponentBit<T>::value;
+        moveEntity(entity, newSignature, pos, vel);
     }
 
     /**
-     * @brief Gets the component of type T for a given entity.
+     * @brief Gets a pointer to the component of type T for a given entity.
      * @tparam T The component type.
      * @param entity The target entity.
-     * @return A shared_ptr to the component.
+     * @return A pointer into the packed column, or nullptr if absent.
      */
     template <typename T>
-    std::shared_ptr<T> getComponent(Entity entity)
+    T *getComponent(Entity entity)
     {
-        auto &storage = getComponentStorage<T>();
-        if (entity < storage.size())
+        Record &record = m_records[entity];
+        Archetype &archetype = m_archetypes[record.archetype];
+        if (!record.alive || !(archetype.signature() & ComponentBit<T>::value))
         {
-            return storage[entity];
+            return nullptr;
         }
-        return nullptr;
+        return &columnAt<T>(archetype, record.row);
     }
 
     /**
      * @brief Runs an update on all entities having both Position and Velocity components.
+     *
+     * Only archetypes whose signature contains both bits are visited, and
+     * their columns are walked linearly — no per-entity lookups.
      */
     void update()
     {
-        for (Entity id = 0; id < m_nextEntityId; ++id)
+        constexpr Signature required = ComponentBit<Position>::value | ComponentBit<Velocity>::value;
+        for (Archetype &archetype : m_archetypes)
         {
-            if (!m_entityExists[id])
+            if ((archetype.signature() & required) != required)
             {
                 continue;
             }
-
-            auto pos = getComponent<Position>(id);
-            auto vel = getComponent<Velocity>(id);
-            if (pos && vel)
+            for (std::size_t row = 0; row < archetype.size(); ++row)
             {
-                pos->x += vel->dx;
-                pos->y += vel->dy;
-                std::cout << "Entity " << id << " moved to (" << pos->x << ", " << pos->y << ")\n";
+                Position &pos = archetype.positionAt(row);
+                const Velocity &vel = archetype.velocityAt(row);
+                pos.x += vel.dx;
+                pos.y += vel.dy;
+                std::cout << "Entity " << archetype.entityAt(row) << " moved to (" << pos.x << ", " << pos.y << ")\n";
             }
         }
     }
 
 private:
-    Entity m_nextEntityId{0};
-    std::vector<bool> m_entityExists;
-    std::vector<std::shared_ptr<Position>> m_positions;
-    std::vector<std::shared_ptr<Velocity>> m_velocities;
+    /**
+     * @brief Location of an entity's row inside the archetype table.
+     */
+    struct Record
+    {
+        std::size_t archetype{0};
+        std::size_t row{0};
+        bool alive{false};
+    };
+
+    /**
+     * @brief Finds or creates the archetype for a signature.
+     * @return Index into m_archetypes (indices stay stable as archetypes are appended).
+     */
+    std::size_t archetypeFor(Signature signature)
+    {
+        for (std::size_t i = 0; i < m_archetypes.size(); ++i)
+        {
+            if (m_archetypes[i].signature() == signature)
+            {
+                return i;
+            }
+        }
+        m_archetypes.emplace_back(signature);
+        return m_archetypes.size() - 1;
+    }
+
+    /**
+     * @brief Moves an entity's row to the archetype matching the new signature.
+     */
+    void moveEntity(Entity entity, Signature newSignature, const Position &pos, const Velocity &vel)
+    {
+        Record &record = m_records[entity];
+        std::size_t targetIndex = archetypeFor(newSignature); // May reallocate m_archetypes; resolve references after.
+        Archetype &source = m_archetypes[record.archetype];
+
+        Entity moved = source.swapRemove(record.row);
+        if (moved != entity)
+        {
+            m_records[moved].row = record.row;
+        }
+
+        record.archetype = targetIndex;
+        record.row = m_archetypes[targetIndex].insert(entity, pos, vel);
+    }
+
+    static void assign(Position &pos, Velocity &, const Position &value) { pos = value; }
+    static void assign(Position &, Velocity &vel, const Velocity &value) { vel = value; }
 
     template <typename T>
-    std::vector<std::shared_ptr<T>> &getComponentStorage(); ///< Declared only
+    static T &columnAt(Archetype &archetype, std::size_t row); ///< Declared only
+
+    Entity m_nextEntityId{0};
+    std::vector<Record> m_records;     ///< Entity-to-(archetype,row) remapping.
+    std::vector<Archetype> m_archetypes;
 };
 
-// --- Specializations for Component Storage ---
+// --- Specializations for Column Access ---
 
 template <>
-std::vector<std::shared_ptr<Position>> &World::getComponentStorage<Position>()
+Position &World::columnAt<Position>(Archetype &archetype, std::size_t row)
 {
-    return m_positions;
+    return archetype.positionAt(row);
 }
 
 template <>
-std::vector<std::shared_ptr<Velocity>> &World::getComponentStorage<Velocity>()
+Velocity &World::columnAt<Velocity>(Archetype &archetype, std::size_t row)
 {
-    return m_velocities;
+    return archetype.velocityAt(row);
 }
 
 // --- Main ---
@@ -160,6 +318,9 @@ int main()
     world.addComponent(entity2, Position{5.0f, 5.0f});
     world.addComponent(entity2, Velocity{-0.5f, 0.5f});
 
+    auto entity3 = world.createEntity();
+    world.addComponent(entity3, Position{2.0f, 2.0f}); // Position only: lives in its own archetype, skipped by update().
+
     world.update();
 
     return 0;
@@ -4,143 +4,419 @@
  * **Key Concepts:**
  * 1. **Event Storage**: Instead of storing the current state, all state changes are recorded as events.
  * 2. **Reconstructing State**: The current state is derived by replaying past events.
- * 3. **Auditable History**: Complete traceability of all changes.
+ * 3. **Snapshots**: Periodic materialized checkpoints so queries replay only the tail, not the full history.
+ * 4. **Auditable History**: Complete traceability of all changes; compaction archives rather than deletes.
+ * 5. **Persistent Log**: Fixed-size framed records appended to a binary file in batches and
+ *    replayed through a zero-copy memory mapping (POSIX mmap) on cold start.
  *
  * **Benefits:**
  * - Provides a complete, immutable history of system state changes.
- * - Enables event replay for debugging, auditing, or rebuilding system state.
- * - Improves traceability and debugging in distributed systems.
+ * - getBalance() is O(events since last snapshot) instead of O(total history).
+ * - compact() bounds live-stream memory while preserving an archived stream for audit.
+ * - Cold-start recovery scans mapped binary records directly instead of parsing text.
  */
 
- #include <iostream>
- #include <vector>
- #include <memory>
- #include <string>
- 
- /**
-  * @brief Abstract base class for all transaction events.
-  */
- class Event
- {
- public:
-     virtual ~Event() = default;
- 
-     /**
-      * @brief Applies the event to reconstruct account state.
-      * @param balance Reference to the account balance.
-      */
-     virtual void apply(int& balance) const = 0;
- 
-     /**
-      * @brief Returns a string representation of the event.
-      * @return Event description.
-      */
-     virtual std::string toString() const = 0;
- };
- 
- /**
-  * @brief Event representing a deposit transaction.
-  */
- class DepositEvent : public Event
- {
- public:
-     explicit DepositEvent(int amount) : m_amount(amount) {}
- 
-     void apply(int& balance) const override
-     {
-         balance += m_amount;
-     }
- 
-     std::string toString() const override
-     {
-         return "Deposit: +" + std::to_string(m_amount);
-     }
- 
- private:
-     int m_amount; ///< Amount deposited.
- };
- 
- /**
-  * @brief Event representing a withdrawal transaction.
-  */
- class WithdrawEvent : public Event
- {
- public:
-     explicit WithdrawEvent(int amount) : m_amount(amount) {}
- 
-     void apply(int& balance) const override
-     {
-         balance -= m_amount;
-     }
- 
-     std::string toString() const override
-     {
-         return "Withdraw: -" + std::to_string(m_amount);
-     }
- 
- private:
-     int m_amount; ///< Amount withdrawn.
- };
- 
- /**
-  * @brief Manages the list of transaction events and reconstructs account state.
-  */
- class Account
- {
- public:
-     /**
-      * @brief Adds an event (transaction) to the history.
-      * @param event The event to record.
-      */
-     void addEvent(std::shared_ptr<Event> event)
-     {
-         m_events.push_back(event);
-     }
- 
-     /**
-      * @brief Computes the account balance by replaying all stored events.
-      * @return The reconstructed account balance.
-      */
-     int getBalance() const
-     {
-         int balance = 0;
-         for (const auto& event : m_events)
-         {
-             event->apply(balance);
-         }
-         return balance;
-     }
- 
-     /**
-      * @brief Displays all recorded transactions.
-      */
-     void printEventHistory() const
-     {
-         std::cout << "Transaction History:\n";
-         for (const auto& event : m_events)
-         {
-             std::cout << "  " << event->toString() << std::endl;
-         }
-     }
- 
- private:
-     std::vector<std::shared_ptr<Event>> m_events; ///< List of recorded events.
- };
- 
- /**
-  * @brief Demonstrates the Event Sourcing pattern with a simple banking system.
-  */
- int main()
- {
-     auto account = std::make_shared<Account>();
- 
-     account->addEvent(std::make_shared<DepositEvent>(100));
-     account->addEvent(std::make_shared<WithdrawEvent>(40));
-     account->addEvent(std::make_shared<DepositEvent>(50));
- 
-     account->printEventHistory();
-     std::cout << "Final Balance: " << account->getBalance() << " USD\n";
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <string>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Event type tag stored in the binary log.
+ */
+enum class EventType : std::uint32_t
+{
+    Deposit = 1,
+    Withdraw = 2
+};
+
+/**
+ * @brief Fixed-size framed record as laid out on disk.
+ *
+ * Every record occupies exactly 8 bytes, so replay can index the mapped
+ * file directly without any per-record framing or parsing.
+ */
+struct LogRecord
+{
+    std::uint32_t type;   ///< EventType as stored on disk.
+    std::int32_t amount;  ///< Transaction amount.
+};
+
+static_assert(sizeof(LogRecord) == 8, "log records must be fixed-size");
+
+/**
+ * @brief Abstract base class for all transaction events.
+ */
+class Event
+{
+public:
+    virtual ~Event() = default;
+
+    /**
+     * @brief Applies the event to reconstruct account state.
+     * @param balance Reference to the account balance.
+     */
+    virtual void apply(int& balance) const = 0;
+
+    /**
+     * @brief Returns a string representation of the event.
+     * @return Event description.
+     */
+    virtual std::string toString() const = 0;
+
+    /**
+     * @brief Encodes the event as a fixed-size binary log record.
+     * @return The on-disk representation.
+     */
+    virtual LogRecord toRecord() const = 0;
+};
+
+/**
+ * @brief Event representing a deposit transaction.
+ */
+class DepositEvent : public Event
+{
+public:
+    explicit DepositEvent(int amount) : m_amount(amount) {}
+
+    void apply(int& balance) const override
+    {
+        balance += m_amount;
+    }
+
+    std::string toString() const override
+    {
+        return "Deposit: +" + std::to_string(m_amount);
+    }
+
+    LogRecord toRecord() const override
+    {
+        return LogRecord{static_cast<std::uint32_t>(EventType::Deposit), m_amount};
+    }
+
+private:
+    int m_amount; ///< Amount deposited.
+};
+
+/**
+ * @brief Event representing a withdrawal transaction.
+ */
+class WithdrawEvent : public Event
+{
+public:
+    explicit WithdrawEvent(int amount) : m_amount(amount) {}
+
+    void apply(int& balance) const override
+    {
+        balance -= m_amount;
+    }
+
+    std::string toString() const override
+    {
+        return "Withdraw: -" + std::to_string(m_amount);
+    }
+
+    LogRecord toRecord() const override
+    {
+        return LogRecord{static_cast<std::uint32_t>(EventType::Withdraw), m_amount};
+    }
+
+private:
+    int m_amount; ///< Amount withdrawn.
+};
+
+/**
+ * @brief Decodes a binary log record back into an event.
+ * @param record The on-disk representation.
+ * @return The reconstructed event, or nullptr for an unknown type.
+ */
+std::shared_ptr<Event> eventFromRecord(const LogRecord& record)
+{
+    switch (static_cast<EventType>(record.type))
+    {
+        case EventType::Deposit:  return std::make_shared<DepositEvent>(record.amount);
+        case EventType::Withdraw: return std::make_shared<WithdrawEvent>(record.amount);
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Persistent append-only binary event log.
+ *
+ * Appends are buffered in memory and written to the file as one batched
+ * write on flush(). Replay maps the whole file and hands out a view over
+ * the fixed-size records, so recovery reads them in place with zero copies.
+ */
+class EventLog
+{
+public:
+    explicit EventLog(std::string path) : m_path(std::move(path)) {}
+
+    ~EventLog()
+    {
+        flush();
+    }
+
+    /**
+     * @brief Buffers a record for a later batched append.
+     * @param event The event to persist.
+     */
+    void append(const Event& event)
+    {
+        m_buffer.push_back(event.toRecord());
+    }
+
+    /**
+     * @brief Writes all buffered records to the log in a single append.
+     */
+    void flush()
+    {
+        if (m_buffer.empty())
+        {
+            return;
+        }
+        int fd = ::open(m_path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd < 0)
+        {
+            std::cerr << "EventLog: cannot open " << m_path << " for append\n";
+            return;
+        }
+        ::write(fd, m_buffer.data(), m_buffer.size() * sizeof(LogRecord));
+        ::close(fd);
+        m_buffer.clear();
+    }
+
+    /**
+     * @brief Replays every persisted record through a zero-copy memory mapping.
+     * @param apply Callback invoked for each record in append order.
+     */
+    void replay(const std::function<void(const LogRecord&)>& apply) const
+    {
+        int fd = ::open(m_path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return; // No log yet: nothing to replay.
+        }
+        struct stat info{};
+        if (::fstat(fd, &info) != 0 || info.st_size == 0)
+        {
+            ::close(fd);
+            return;
+        }
+        void* mapped = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED)
+        {
+            std::cerr << "EventLog: mmap failed for " << m_path << "\n";
+            return;
+        }
+
+        const auto* records = static_cast<const LogRecord*>(mapped);
+        std::size_t count = static_cast<std::size_t>(info.st_size) / sizeof(LogRecord);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            apply(records[i]); // Read in place; no deserialization copy.
+        }
+        ::munmap(mapped, static_cast<std::size_t>(info.st_size));
+    }
+
+private:
+    std::string m_path;               ///< Log file location.
+    std::vector<LogRecord> m_buffer;  ///< Records awaiting the next batched append.
+};
+
+/**
+ * @brief Materialized account state at a point in the event stream.
+ */
+struct Snapshot
+{
+    std::size_t eventCount{0}; ///< Number of events (since genesis) folded into the snapshot.
+    int balance{0};            ///< Balance after applying those events.
+};
+
+/**
+ * @brief Manages the list of transaction events and reconstructs account state.
+ *
+ * Every snapshotInterval events a snapshot is materialized, so balance
+ * queries fold the snapshot and replay only the tail recorded after it.
+ */
+class Account
+{
+public:
+    /**
+     * @brief Constructs an account with a configurable snapshot cadence.
+     * @param snapshotInterval Materialize a snapshot every N recorded events.
+     */
+    explicit Account(std::size_t snapshotInterval = 100) : m_snapshotInterval(snapshotInterval) {}
+
+    /**
+     * @brief Attaches a persistent log; every added event is appended to it.
+     * @param log The shared event log (may be nullptr for in-memory only).
+     */
+    void attachLog(std::shared_ptr<EventLog> log)
+    {
+        m_log = std::move(log);
+    }
+
+    /**
+     * @brief Rebuilds account state by replaying a persisted log.
+     * @param log The log to replay from.
+     */
+    void recoverFrom(const EventLog& log)
+    {
+        log.replay([this](const LogRecord& record)
+        {
+            if (auto event = eventFromRecord(record))
+            {
+                m_events.push_back(std::move(event));
+            }
+        });
+        takeSnapshot();
+    }
+
+    /**
+     * @brief Adds an event (transaction) to the history.
+     * @param event The event to record.
+     */
+    void addEvent(std::shared_ptr<Event> event)
+    {
+        if (m_log)
+        {
+            m_log->append(*event);
+        }
+        m_events.push_back(event);
+        if (totalEventCount() - m_snapshot.eventCount >= m_snapshotInterval)
+        {
+            takeSnapshot();
+        }
+    }
+
+    /**
+     * @brief Computes the account balance from the latest snapshot plus the tail.
+     * @return The reconstructed account balance.
+     */
+    int getBalance() const
+    {
+        int balance = m_snapshot.balance;
+        for (std::size_t i = tailStart(); i < m_events.size(); ++i)
+        {
+            m_events[i]->apply(balance);
+        }
+        return balance;
+    }
+
+    /**
+     * @brief Truncates live history behind the latest snapshot.
+     *
+     * Events folded into the snapshot move to the archived stream, so the
+     * audit trail survives while the live stream stays bounded.
+     */
+    void compact()
+    {
+        std::size_t keepFrom = tailStart();
+        m_archivedEvents.insert(m_archivedEvents.end(), m_events.begin(), m_events.begin() + keepFrom);
+        m_events.erase(m_events.begin(), m_events.begin() + keepFrom);
+    }
+
+    /**
+     * @brief Displays all recorded transactions, archived and live.
+     */
+    void printEventHistory() const
+    {
+        std::cout << "Transaction History:\n";
+        for (const auto& event : m_archivedEvents)
+        {
+            std::cout << "  [archived] " << event->toString() << std::endl;
+        }
+        for (const auto& event : m_events)
+        {
+            std::cout << "  " << event->toString() << std::endl;
+        }
+    }
+
+    /**
+     * @brief Displays the latest snapshot and live-stream size, for diagnostics.
+     */
+    void printSnapshotInfo() const
+    {
+        std::cout << "Snapshot at event " << m_snapshot.eventCount
+                  << " (balance " << m_snapshot.balance << " USD), "
+                  << (totalEventCount() - m_snapshot.eventCount) << " tail event(s), "
+                  << m_events.size() << " live event(s) in memory\n";
+    }
+
+private:
+    /**
+     * @brief Total events ever recorded, including archived ones.
+     */
+    std::size_t totalEventCount() const
+    {
+        return m_archivedEvents.size() + m_events.size();
+    }
+
+    /**
+     * @brief Index into m_events where the post-snapshot tail begins.
+     */
+    std::size_t tailStart() const
+    {
+        return m_snapshot.eventCount - m_archivedEvents.size();
+    }
+
+    /**
+     * @brief Materializes the current balance as the new snapshot.
+     */
+    void takeSnapshot()
+    {
+        m_snapshot.balance = getBalance();
+        m_snapshot.eventCount = totalEventCount();
+    }
+
+    std::size_t m_snapshotInterval;                       ///< Events between snapshots.
+    Snapshot m_snapshot;                                  ///< Latest materialized state.
+    std::vector<std::shared_ptr<Event>> m_events;         ///< Live event stream (snapshot prefix + tail).
+    std::vector<std::shared_ptr<Event>> m_archivedEvents; ///< Compacted-away events kept for audit.
+    std::shared_ptr<EventLog> m_log;                      ///< Optional persistent append-only log.
+};
+
+/**
+ * @brief Demonstrates the Event Sourcing pattern with snapshots, compaction and a persistent log.
+ */
+int main()
+{
+    const std::string logPath = "account.eventlog";
+    ::unlink(logPath.c_str()); // Fresh demo run.
+
+    auto log = std::make_shared<EventLog>(logPath);
+    auto account = std::make_shared<Account>(2); // Snapshot every 2 events.
+    account->attachLog(log);
+
+    account->addEvent(std::make_shared<DepositEvent>(100));
+    account->addEvent(std::make_shared<WithdrawEvent>(40));
+    account->addEvent(std::make_shared<DepositEvent>(50));
+
+    account->printEventHistory();
+    account->printSnapshotInfo();
+    std::cout << "Final Balance: " << account->getBalance() << " USD\n";
+
+    account->compact(); // Archive events behind the snapshot.
+    account->printEventHistory();
+    account->printSnapshotInfo();
+    std::cout << "Balance after compaction: " << account->getBalance() << " USD\n";
+
+    // Cold-start recovery: flush the batched appends, then rebuild a fresh
+    // account straight from the memory-mapped binary log.
+    log->flush();
+    auto recovered = std::make_shared<Account>(2);
+    recovered->recoverFrom(*log);
+    std::cout << "Recovered Balance from log: " << recovered->getBalance() << " USD\n";
+
+    return 0;
+}
@@ -11,148 +11,332 @@
  * - Improved maintainability due to clear separation of concerns.
  * - Easier to scale and modify individual layers without affecting others.
  * - Allows for independent testing of each layer.
+ *
+ * Crossing three layers per request with a fresh copy at every boundary turns
+ * the layer seams themselves into the hot path. The batch extensions below
+ * move request/response objects through the stack instead of copying them,
+ * carry whole batches through each layer in one call (one repository bulk
+ * read per batch instead of one full fetch per request), and build responses
+ * inside a per-batch arena that is freed in one shot after the response goes
+ * out.
+ */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <span>
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @brief The Data Access Layer: Manages interactions with the database (simulated here with an in-memory collection).
+ */
+class UserRepository
+{
+public:
+    /**
+     * @brief Adds a new user to the repository.
+     * @param userName The name of the user to add.
+     */
+    void addUser(const std::string& userName)
+    {
+        m_users.push_back(userName);
+    }
+
+    /**
+     * @brief Retrieves all users from the repository.
+     * @return A list of all user names.
+     */
+    std::vector<std::string> getUsers() const
+    {
+        return m_users;
+    }
+
+    /**
+     * @brief Bulk read: resolves a whole batch of indices in one call.
+     *
+     * Out-of-range indices resolve to nullptr. Pointers borrow the
+     * repository's own storage — no copies at this boundary.
+     */
+    void readBulk(std::span<const std::size_t> indices, std::span<const std::string*> out) const
+    {
+        for (std::size_t i = 0; i < indices.size(); ++i)
+        {
+            out[i] = indices[i] < m_users.size() ? &m_users[indices[i]] : nullptr;
+        }
+    }
+
+    std::size_t userCount() const { return m_users.size(); }
+
+private:
+    std::vector<std::string> m_users; ///< In-memory list of users.
+};
+
+/**
+ * @brief A lookup request; moved, never copied, through the layers.
+ */
+struct UserQuery
+{
+    std::size_t userIndex;
+};
+
+/**
+ * @brief A response row; its display name lives in the batch arena.
+ */
+struct UserView
+{
+    std::size_t userIndex;
+    std::string_view displayName; ///< Arena-backed; valid until the arena resets.
+    bool found;
+};
+
+/**
+ * @brief Per-batch bump arena; everything a response needs, freed in one shot.
+ */
+class RequestArena
+{
+public:
+    explicit RequestArena(std::size_t capacityBytes)
+        : m_buffer(capacityBytes)
+    {}
+
+    /// @brief Reserves aligned storage for count objects; nullptr when full.
+    template <typename T>
+    T* allocate(std::size_t count)
+    {
+        std::size_t offset = (m_used + alignof(T) - 1) & ~(alignof(T) - 1);
+        if (offset + count * sizeof(T) > m_buffer.size())
+        {
+            return nullptr;
+        }
+        m_used = offset + count * sizeof(T);
+        return reinterpret_cast<T*>(m_buffer.data() + offset);
+    }
+
+    /// @brief Copies text into the arena; the view dies when the arena resets.
+    std::string_view copyString(std::string_view text)
+    {
+        char* storage = allocate<char>(text.size());
+        if (!storage)
+        {
+            return {};
+        }
+        std::copy(text.begin(), text.end(), storage);
+        return std::string_view(storage, text.size());
+    }
+
+    /// @brief Frees every per-request allocation of the batch at once.
+    void reset() { m_used = 0; }
+
+private:
+    std::vector<std::byte> m_buffer; ///< The single backing allocation.
+    std::size_t m_used{0};           ///< Bump offset.
+};
+
+/**
+ * @brief The Business Layer: Provides the logic for user-related operations.
  */
+class UserService
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param repository The UserRepository instance.
+     */
+    UserService(std::shared_ptr<UserRepository> repository)
+        : m_repository(repository)
+    {}
+
+    /**
+     * @brief Adds a new user to the system.
+     * @param userName The name of the user.
+     */
+    void addUser(const std::string& userName)
+    {
+        m_repository->addUser(userName);
+    }
+
+    /**
+     * @brief Retrieves a list of all users.
+     * @return A list of user names.
+     */
+    std::vector<std::string> getUsers() const
+    {
+        return m_repository->getUsers();
+    }
+
+    /**
+     * @brief Carries a whole batch through the business layer in one call.
+     *
+     * Queries arrive as a span (no per-request copies), the repository is
+     * hit with one bulk read, and every response row — including its
+     * formatted display name — is built in the caller's arena.
+     *
+     * @return Arena-resident response rows, one per query.
+     */
+    std::span<UserView> handleBatch(std::span<const UserQuery> queries, RequestArena& arena) const
+    {
+        std::size_t* indices = arena.allocate<std::size_t>(queries.size());
+        const std::string** rows = arena.allocate<const std::string*>(queries.size());
+        UserView* views = arena.allocate<UserView>(queries.size());
+        if (!indices || !rows || !views)
+        {
+            return {};
+        }
+        for (std::size_t i = 0; i < queries.size(); ++i)
+        {
+            indices[i] = queries[i].userIndex;
+        }
+        m_repository->readBulk({indices, queries.size()}, {rows, queries.size()}); // One bulk read per batch.
+        for (std::size_t i = 0; i < queries.size(); ++i)
+        {
+            views[i].userIndex = queries[i].userIndex;
+            views[i].found = rows[i] != nullptr;
+            views[i].displayName = rows[i] ? arena.copyString(*rows[i]) : std::string_view();
+        }
+        return {views, queries.size()};
+    }
+
+private:
+    std::shared_ptr<UserRepository> m_repository; ///< User repository instance.
+};
+
+/**
+ * @brief The Presentation Layer: Interacts with the user and displays information.
+ */
+class UserController
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param service The UserService instance.
+     */
+    UserController(std::shared_ptr<UserService> service)
+        : m_service(service)
+    {}
+
+    /**
+     * @brief Displays the list of users.
+     */
+    void showUsers() const
+    {
+        auto users = m_service->getUsers();
+        if (users.empty())
+        {
+            std::cout << "No users found.\n";
+        }
+        else
+        {
+            std::cout << "Users:\n";
+            for (const auto& user : users)
+            {
+                std::cout << "- " << user << '\n';
+            }
+        }
+    }
+
+    /**
+     * @brief Adds a user.
+     * @param userName The name of the user to add.
+     */
+    void addUser(const std::string& userName)
+    {
+        m_service->addUser(userName);
+        std::cout << "User \"" << userName << "\" added successfully.\n";
+    }
+
+    /**
+     * @brief Per-request lookup the old way: a full fetch copied per layer.
+     */
+    std::string lookupUser(std::size_t userIndex) const
+    {
+        auto users = m_service->getUsers(); // Copies the whole table across two seams.
+        if (userIndex >= users.size())
+        {
+            return "not-found";
+        }
+        return users[userIndex];
+    }
+
+    /**
+     * @brief Batch path: the span moves through all three layers in one call.
+     */
+    std::span<UserView> handleBatch(std::span<const UserQuery> queries, RequestArena& arena) const
+    {
+        return m_service->handleBatch(queries, arena);
+    }
+
+private:
+    std::shared_ptr<UserService> m_service; ///< User service instance.
+};
+
+/**
+ * @brief Main function demonstrating the use of a layered architecture.
+ */
+int main()
+{
+    // Data Access Layer: The repository where user data is stored.
+    auto userRepository = std::make_shared<UserRepository>();
+
+    // Business Layer: The service that handles business logic.
+    auto userService = std::make_shared<UserService>(userRepository);
+
+    // Presentation Layer: The controller that interacts with the user.
+    auto userController = std::make_shared<UserController>(userService);
+
+    // Add some users
+    userController->addUser("Alice");
+    userController->addUser("Bob");
+    userController->addUser("Charlie");
+
+    // Show all users
+    userController->showUsers();
+
+    // Batch mode: spans through every layer, one bulk read, arena responses.
+    constexpr std::size_t tableSize = 1000;
+    constexpr std::size_t requestCount = 20480; ///< A whole number of batches.
+    constexpr std::size_t batchSize = 256;
+
+    std::cout.setstate(std::ios_base::failbit); // Silence the per-user add lines.
+    for (std::size_t i = 0; i < tableSize; ++i)
+    {
+        userController->addUser("layered-user-record-" + std::to_string(i));
+    }
+    std::cout.clear();
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t perRequestChars = 0;
+    for (std::size_t i = 0; i < requestCount; ++i)
+    {
+        perRequestChars += userController->lookupUser((i * 31) % tableSize).size();
+    }
+    double perRequestTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    RequestArena arena(batchSize * 128);
+    std::vector<UserQuery> queries(batchSize);
+    start = std::chrono::steady_clock::now();
+    std::size_t batchChars = 0;
+    for (std::size_t i = 0; i < requestCount; i += batchSize)
+    {
+        for (std::size_t j = 0; j < batchSize; ++j)
+        {
+            queries[j].userIndex = ((i + j) * 31) % tableSize;
+        }
+        std::span<UserView> views = userController->handleBatch(queries, arena);
+        for (const UserView& view : views)
+        {
+            batchChars += view.displayName.size();
+        }
+        arena.reset(); // Every per-request allocation of the batch, freed at once.
+    }
+    double batchTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << requestCount << " lookup(s): per-request copies " << perRequestTime
+              << " ms, batched arena path " << batchTime << " ms (checksums "
+              << perRequestChars << " / " << batchChars << ")" << std::endl;
 
- #include <iostream>
- #include <memory>
- #include <string>
- #include <vector>
- #include <algorithm>
- 
- /**
-  * @brief The Data Access Layer: Manages interactions with the database (simulated here with an in-memory collection).
-  */
- class UserRepository
- {
- public:
-     /**
-      * @brief Adds a new user to the repository.
-      * @param userName The name of the user to add.
-      */
-     void addUser(const std::string& userName)
-     {
-         m_users.push_back(userName);
-     }
- 
-     /**
-      * @brief Retrieves all users from the repository.
-      * @return A list of all user names.
-      */
-     std::vector<std::string> getUsers() const
-     {
-         return m_users;
-     }
- 
- private:
-     std::vector<std::string> m_users; ///< In-memory list of users.
- };
- 
- /**
-  * @brief The Business Layer: Provides the logic for user-related operations.
-  */
- class UserService
- {
- public:
-     /**
-      * @brief Constructor.
-      * @param repository The UserRepository instance.
-      */
-     UserService(std::shared_ptr<UserRepository> repository)
-         : m_repository(repository)
-     {}
- 
-     /**
-      * @brief Adds a new user to the system.
-      * @param userName The name of the user.
-      */
-     void addUser(const std::string& userName)
-     {
-         m_repository->addUser(userName);
-     }
- 
-     /**
-      * @brief Retrieves a list of all users.
-      * @return A list of user names.
-      */
-     std::vector<std::string> getUsers() const
-     {
-         return m_repository->getUsers();
-     }
- 
- private:
-     std::shared_ptr<UserRepository> m_repository; ///< User repository instance.
- };
- 
- /**
-  * @brief The Presentation Layer: Interacts with the user and displays information.
-  */
- class UserController
- {
- public:
-     /**
-      * @brief Constructor.
-      * @param service The UserService instance.
-      */
-     UserController(std::shared_ptr<UserService> service)
-         : m_service(service)
-     {}
- 
-     /**
-      * @brief Displays the list of users.
-      */
-     void showUsers() const
-     {
-         auto users = m_service->getUsers();
-         if (users.empty())
-         {
-             std::cout << "No users found.\n";
-         }
-         else
-         {
-             std::cout << "Users:\n";
-             for (const auto& user : users)
-             {
-                 std::cout << "- " << user << '\n';
-             }
-         }
-     }
- 
-     /**
-      * @brief Adds a user.
-      * @param userName The name of the user to add.
-      */
-     void addUser(const std::string& userName)
-     {
-         m_service->addUser(userName);
-         std::cout << "User \"" << userName << "\" added successfully.\n";
-     }
- 
- private:
-     std::shared_ptr<UserService> m_service; ///< User service instance.
- };
- 
- /**
-  * @brief Main function demonstrating the use of a layered architecture.
-  */
- int main()
- {
-     // Data Access Layer: The repository where user data is stored.
-     auto userRepository = std::make_shared<UserRepository>();
- 
-     // Business Layer: The service that handles business logic.
-     auto userService = std::make_shared<UserService>(userRepository);
- 
-     // Presentation Layer: The controller that interacts with the user.
-     auto userController = std::make_shared<UserController>(userService);
- 
-     // Add some users
-     userController->addUser("Alice");
-     userController->addUser("Bob");
-     userController->addUser("Charlie");
- 
-     // Show all users
-     userController->showUsers();
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
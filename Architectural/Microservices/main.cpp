@@ -10,130 +10,370 @@
  * - **Scalability**: Each service can be scaled independently to meet the demands of its specific functionality.
  * - **Fault Isolation**: A failure in one microservice doesn't affect the entire system.
  * - **Flexibility**: Services can be developed and deployed independently, using the most appropriate technologies for each service.
+ *
+ * Calling each downstream service strictly in sequence makes registration
+ * latency the sum of every call. The async orchestrator below issues the
+ * independent calls (fraud screening, profile provisioning) concurrently and
+ * joins them, and hands the welcome email to a queued background dispatcher
+ * that batches sends over one reused connection — so the email never blocks
+ * returning success to the caller. A simulated-latency harness reports p50/p99
+ * for both modes.
+ */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <thread>
+#include <chrono>
+#include <mutex>
+#include <future>
+#include <condition_variable>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+/**
+ * @brief Simulates a simple Microservice that performs user registration.
+ */
+class UserService
+{
+public:
+    /**
+     * @brief Registers a new user by adding to the "database".
+     * @param userId The unique identifier of the user.
+     * @param userName The name of the user.
+     */
+    void registerUser(int userId, const std::string& userName)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_users[userId] = userName;
+        std::cout << "User Registered: " << userName << " with ID: " << userId << std::endl;
+    }
+
+    /**
+     * @brief Gets the user information by ID.
+     * @param userId The unique identifier of the user.
+     * @return The name of the user.
+     */
+    std::string getUser(int userId)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_users.find(userId) != m_users.end())
+        {
+            return m_users[userId];
+        }
+        else
+        {
+            return "User not found!";
+        }
+    }
+
+private:
+    std::unordered_map<int, std::string> m_users; ///< Simulated "database" of users.
+    std::mutex m_mutex; ///< Protects access to the user data.
+};
+
+/**
+ * @brief Simulates a simple Microservice that performs email notifications.
+ */
+class EmailService
+{
+public:
+    /**
+     * @brief Sends a welcome email to the user after registration.
+     * @param userId The unique identifier of the user.
+     * @param userName The name of the user.
+     */
+    void sendWelcomeEmail(int userId, const std::string& userName)
+    {
+        std::cout << "Sending welcome email to: " << userName << " (ID: " << userId << ")\n";
+        // Simulate email sending process
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        std::cout << "Email sent to: " << userName << " (ID: " << userId << ")\n";
+    }
+};
+
+/**
+ * @brief Orchestrates the interaction between the UserService and the EmailService in a microservices architecture.
+ */
+class UserRegistrationFacade
+{
+public:
+    UserRegistrationFacade(std::shared_ptr<UserService> userService, std::shared_ptr<EmailService> emailService)
+        : m_userService(userService), m_emailService(emailService)
+    {
+    }
+
+    /**
+     * @brief Registers a user and sends a welcome email asynchronously.
+     * @param userId The unique identifier of the user.
+     * @param userName The name of the user.
+     * @return A future representing the asynchronous email sending task.
+     */
+    std::future<void> registerUser(int userId, const std::string& userName)
+    {
+        return std::async(std::launch::async, [this, userId, userName] {
+            // First, register the user
+            m_userService->registerUser(userId, userName);
+
+            // Then, send the welcome email asynchronously
+            m_emailService->sendWelcomeEmail(userId, userName);
+        });
+    }
+
+private:
+    std::shared_ptr<UserService> m_userService; ///< The UserService microservice.
+    std::shared_ptr<EmailService> m_emailService; ///< The EmailService microservice.
+};
+
+/// @brief Stands in for one network round trip of known latency.
+static void simulateCall(std::chrono::microseconds latency)
+{
+    std::this_thread::sleep_for(latency);
+}
+
+/**
+ * @brief Downstream fraud screen; independent of profile provisioning.
+ */
+class FraudCheckService
+{
+public:
+    bool screen(int userId)
+    {
+        simulateCall(std::chrono::microseconds(300));
+        return userId >= 0;
+    }
+};
+
+/**
+ * @brief Downstream profile provisioning; independent of the fraud screen.
  */
+class ProfileService
+{
+public:
+    void provision(int userId)
+    {
+        (void)userId;
+        simulateCall(std::chrono::microseconds(300));
+    }
+};
+
+/**
+ * @brief Queued, batched background email dispatch over a reused connection.
+ *
+ * enqueue() appends the email and returns immediately; a background worker
+ * drains the whole backlog per wakeup, paying one connection setup per batch
+ * instead of per email. Registration success never waits on SMTP.
+ */
+class BatchedEmailDispatcher
+{
+public:
+    static constexpr auto CONNECT_COST = std::chrono::microseconds(200); ///< Per batch.
+    static constexpr auto SEND_COST = std::chrono::microseconds(150);    ///< Per email.
+
+    BatchedEmailDispatcher()
+        : m_worker([this] { dispatchLoop(); })
+    {}
+
+    ~BatchedEmailDispatcher()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        m_worker.join();
+    }
+
+    /// @brief Queues one welcome email; never blocks on the send itself.
+    void enqueue(int userId, const std::string& userName)
+    {
+        bool workerParked;
+        {
+            std::lock_guard lock(m_mutex);
+            m_pending.emplace_back(userId, userName);
+            workerParked = m_workerWaiting;
+        }
+        if (workerParked)
+        {
+            m_cv.notify_one();
+        }
+    }
+
+    /// @brief Blocks until the queue is empty and the current batch is sent.
+    void drain()
+    {
+        std::unique_lock lock(m_mutex);
+        m_drainCv.wait(lock, [this] { return m_pending.empty() && !m_sending; });
+    }
+
+    std::size_t emailsSent() const { return m_emailsSent; }
+    std::size_t connectionsOpened() const { return m_connectionsOpened; }
+
+private:
+    /// @brief Drains the backlog batch-wise, one connection per batch.
+    void dispatchLoop()
+    {
+        std::vector<std::pair<int, std::string>> batch;
+        for (;;)
+        {
+            {
+                std::unique_lock lock(m_mutex);
+                m_workerWaiting = true;
+                m_cv.wait(lock, [this] { return !m_pending.empty() || m_stop; });
+                m_workerWaiting = false;
+                if (m_pending.empty() && m_stop)
+                {
+                    return;
+                }
+                batch.swap(m_pending);
+                m_sending = true;
+            }
+
+            simulateCall(CONNECT_COST); // One connection reused for the batch.
+            ++m_connectionsOpened;
+            for (const auto& email : batch)
+            {
+                (void)email;
+                simulateCall(SEND_COST);
+                ++m_emailsSent;
+            }
+            batch.clear();
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_sending = false;
+            }
+            m_drainCv.notify_all();
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::condition_variable m_drainCv;
+    std::vector<std::pair<int, std::string>> m_pending; ///< Emails awaiting dispatch.
+    bool m_workerWaiting{false};
+    bool m_sending{false};
+    bool m_stop{false};
+    std::size_t m_emailsSent{0};
+    std::size_t m_connectionsOpened{0};
+    std::thread m_worker;
+};
+
+/**
+ * @brief Registration orchestrator with sequential and async modes.
+ *
+ * Sequential mode is the old shape: every downstream call in a row,
+ * including the email send with a fresh connection each time. Async mode
+ * issues the independent calls concurrently, joins them, and queues the
+ * email on the batched dispatcher.
+ */
+class AsyncRegistrationOrchestrator
+{
+public:
+    AsyncRegistrationOrchestrator(std::shared_ptr<UserService> userService,
+                                  std::shared_ptr<FraudCheckService> fraudService,
+                                  std::shared_ptr<ProfileService> profileService,
+                                  std::shared_ptr<BatchedEmailDispatcher> emailDispatcher)
+        : m_userService(std::move(userService)),
+          m_fraudService(std::move(fraudService)),
+          m_profileService(std::move(profileService)),
+          m_emailDispatcher(std::move(emailDispatcher))
+    {}
+
+    /// @brief Old shape: latency is the sum of every downstream call.
+    void registerUserSequential(int userId, const std::string& userName)
+    {
+        m_fraudService->screen(userId);
+        m_profileService->provision(userId);
+        m_userService->registerUser(userId, userName);
+        simulateCall(BatchedEmailDispatcher::CONNECT_COST); // Fresh connection...
+        simulateCall(BatchedEmailDispatcher::SEND_COST);    // ...and the send, inline.
+    }
+
+    /// @brief Async shape: independent calls overlap; the email is queued.
+    void registerUserAsync(int userId, const std::string& userName)
+    {
+        auto fraudDone = std::async(std::launch::async, [this, userId]
+        {
+            return m_fraudService->screen(userId);
+        });
+        m_profileService->provision(userId); // Runs concurrently with the screen.
+        fraudDone.get();
+        m_userService->registerUser(userId, userName);
+        m_emailDispatcher->enqueue(userId, userName); // Never blocks the caller.
+    }
+
+private:
+    std::shared_ptr<UserService> m_userService;
+    std::shared_ptr<FraudCheckService> m_fraudService;
+    std::shared_ptr<ProfileService> m_profileService;
+    std::shared_ptr<BatchedEmailDispatcher> m_emailDispatcher;
+};
+
+/// @brief Runs registrations and reports p50/p99 latency in microseconds.
+template <typename RegisterFn>
+static std::pair<double, double> measureLatencies(int count, RegisterFn registerOne)
+{
+    std::vector<double> latencies;
+    latencies.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        registerOne(i);
+        latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    return {latencies[count / 2], latencies[count * 99 / 100]};
+}
+
+/**
+ * @brief Demonstrates a simple microservices architecture using UserService and EmailService.
+ */
+int main()
+{
+    // Instantiate services and facade
+    auto userService = std::make_shared<UserService>();
+    auto emailService = std::make_shared<EmailService>();
+    UserRegistrationFacade registrationFacade(userService, emailService);
+
+    // Register a user asynchronously
+    auto registrationFuture = registrationFacade.registerUser(1, "Alice");
+
+    // Wait for the email to be sent before exiting
+    registrationFuture.get();
+
+    // Perform another registration
+    registrationFacade.registerUser(2, "Bob").get();
+
+    // Latency harness: sequential orchestration vs async + queued email.
+    constexpr int registrations = 500;
+
+    auto quietUsers = std::make_shared<UserService>();
+    auto fraudService = std::make_shared<FraudCheckService>();
+    auto profileService = std::make_shared<ProfileService>();
+    auto emailDispatcher = std::make_shared<BatchedEmailDispatcher>();
+
+    std::cout.setstate(std::ios_base::failbit); // Silence per-user registration lines.
+    AsyncRegistrationOrchestrator orchestrator(quietUsers, fraudService, profileService, emailDispatcher);
+
+    auto [sequentialP50, sequentialP99] = measureLatencies(registrations, [&orchestrator](int i)
+    {
+        orchestrator.registerUserSequential(1000 + i, "user-" + std::to_string(i));
+    });
+    auto [asyncP50, asyncP99] = measureLatencies(registrations, [&orchestrator](int i)
+    {
+        orchestrator.registerUserAsync(2000 + i, "user-" + std::to_string(i));
+    });
+    emailDispatcher->drain();
+    std::cout.clear();
+
+    std::cout << registrations << " registration(s): sequential p50 " << sequentialP50
+              << " us / p99 " << sequentialP99 << " us, async p50 " << asyncP50
+              << " us / p99 " << asyncP99 << " us (" << emailDispatcher->emailsSent()
+              << " email(s) over " << emailDispatcher->connectionsOpened()
+              << " connection(s))" << std::endl;
 
- #include <iostream>
- #include <memory>
- #include <string>
- #include <unordered_map>
- #include <thread>
- #include <chrono>
- #include <mutex>
- #include <future>
- 
- /**
-  * @brief Simulates a simple Microservice that performs user registration.
-  */
- class UserService
- {
- public:
-     /**
-      * @brief Registers a new user by adding to the "database".
-      * @param userId The unique identifier of the user.
-      * @param userName The name of the user.
-      */
-     void registerUser(int userId, const std::string& userName)
-     {
-         std::lock_guard<std::mutex> lock(m_mutex);
-         m_users[userId] = userName;
-         std::cout << "User Registered: " << userName << " with ID: " << userId << std::endl;
-     }
- 
-     /**
-      * @brief Gets the user information by ID.
-      * @param userId The unique identifier of the user.
-      * @return The name of the user.
-      */
-     std::string getUser(int userId)
-     {
-         std::lock_guard<std::mutex> lock(m_mutex);
-         if (m_users.find(userId) != m_users.end())
-         {
-             return m_users[userId];
-         }
-         else
-         {
-             return "User not found!";
-         }
-     }
- 
- private:
-     std::unordered_map<int, std::string> m_users; ///< Simulated "database" of users.
-     std::mutex m_mutex; ///< Protects access to the user data.
- };
- 
- /**
-  * @brief Simulates a simple Microservice that performs email notifications.
-  */
- class EmailService
- {
- public:
-     /**
-      * @brief Sends a welcome email to the user after registration.
-      * @param userId The unique identifier of the user.
-      * @param userName The name of the user.
-      */
-     void sendWelcomeEmail(int userId, const std::string& userName)
-     {
-         std::cout << "Sending welcome email to: " << userName << " (ID: " << userId << ")\n";
-         // Simulate email sending process
-         std::this_thread::sleep_for(std::chrono::seconds(1));
-         std::cout << "Email sent to: " << userName << " (ID: " << userId << ")\n";
-     }
- };
- 
- /**
-  * @brief Orchestrates the interaction between the UserService and the EmailService in a microservices architecture.
-  */
- class UserRegistrationFacade
- {
- public:
-     UserRegistrationFacade(std::shared_ptr<UserService> userService, std::shared_ptr<EmailService> emailService)
-         : m_userService(userService), m_emailService(emailService)
-     {
-     }
- 
-     /**
-      * @brief Registers a user and sends a welcome email asynchronously.
-      * @param userId The unique identifier of the user.
-      * @param userName The name of the user.
-      * @return A future representing the asynchronous email sending task.
-      */
-     std::future<void> registerUser(int userId, const std::string& userName)
-     {
-         return std::async(std::launch::async, [this, userId, userName] {
-             // First, register the user
-             m_userService->registerUser(userId, userName);
- 
-             // Then, send the welcome email asynchronously
-             m_emailService->sendWelcomeEmail(userId, userName);
-         });
-     }
- 
- private:
-     std::shared_ptr<UserService> m_userService; ///< The UserService microservice.
-     std::shared_ptr<EmailService> m_emailService; ///< The EmailService microservice.
- };
- 
- /**
-  * @brief Demonstrates a simple microservices architecture using UserService and EmailService.
-  */
- int main()
- {
-     // Instantiate services and facade
-     auto userService = std::make_shared<UserService>();
-     auto emailService = std::make_shared<EmailService>();
-     UserRegistrationFacade registrationFacade(userService, emailService);
- 
-     // Register a user asynchronously
-     auto registrationFuture = registrationFacade.registerUser(1, "Alice");
- 
-     // Wait for the email to be sent before exiting
-     registrationFuture.get();
- 
-     // Perform another registration
-     registrationFacade.registerUser(2, "Bob").get();
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
@@ -1,133 +1,410 @@
 /**
  * @brief
  * The Serverless Architecture design pattern abstracts away the management of servers and focuses purely on the application logic.
- * 
+ *
  * Key Concepts:
  * - Serverless Computing: The developer writes business logic while the cloud provider manages the infrastructure.
  * - Event-Driven: Functions are triggered by events (e.g., HTTP requests, database changes).
  * - Focus on Application Logic: Developers are relieved from managing servers and only focus on writing code.
- * 
+ *
  * Benefits:
  * - Reduced operational overhead: No need to provision, manage, or scale servers.
  * - Cost-effective: Pay only for the execution time of the function, instead of maintaining idle server resources.
  * - Auto-scaling: The cloud provider handles scaling automatically based on demand.
  * - Simplifies Deployment: The developer focuses on deploying functions without worrying about infrastructure.
+ *
+ * Constructing a function instance per invocation is the cold-start problem:
+ * the p99 pays full initialization every time. The warm-pool subsystem below
+ * keeps pre-initialized instances in per-type pools and reuses them with a
+ * cheap state reset; instances created after the first restore from a
+ * snapshot instead of fully initializing; a sliding invocation-rate window
+ * drives predictive pre-warming between bursts; and cold/warm latency
+ * counters expose the data needed to tune pool sizes against memory cost.
  */
 
- #include <iostream>
- #include <functional>
- #include <memory>
- #include <string>
- #include <unordered_map>
- #include <cassert>
- 
- /**
-  * @brief A base class representing a serverless function in the system.
-  * 
-  * This abstract class defines the interface for any serverless function. The concrete function implementations will define
-  * the application logic in the `execute` method.
-  */
- class ServerlessFunction
- {
- public:
-     virtual ~ServerlessFunction() = default;
- 
-     /**
-      * @brief Executes the function logic. Derived classes should implement the specific logic.
-      */
-     virtual void execute() = 0;
- };
- 
- /**
-  * @brief A concrete implementation of a serverless function for a "UserService" that handles user requests.
-  */
- class UserServiceFunction : public ServerlessFunction
- {
- public:
-     /**
-      * @brief Executes the logic for handling a user request.
-      */
-     void execute() override
-     {
-         std::cout << "Executing UserService logic: Handling user-related requests!" << std::endl;
-     }
- };
- 
- /**
-  * @brief A concrete implementation of a serverless function for an "OrderService" that handles order requests.
-  */
- class OrderServiceFunction : public ServerlessFunction
- {
- public:
-     /**
-      * @brief Executes the logic for handling an order request.
-      */
-     void execute() override
-     {
-         std::cout << "Executing OrderService logic: Handling order-related requests!" << std::endl;
-     }
- };
- 
- /**
-  * @brief A manager that triggers serverless functions based on events.
-  * 
-  * This class acts as a serverless function orchestrator. It maps event names to specific serverless functions and 
-  * executes the function when an event occurs.
-  */
- class ServerlessOrchestrator
- {
- public:
-     /**
-      * @brief Registers a serverless function for a given event name.
-      * 
-      * @param eventName The name of the event.
-      * @param function The serverless function to execute for the event.
-      */
-     void registerFunction(const std::string &eventName, std::shared_ptr<ServerlessFunction> function)
-     {
-         m_functions[eventName] = function;
-     }
- 
-     /**
-      * @brief Triggers the execution of the registered function for a given event.
-      * 
-      * @param eventName The name of the event that should trigger the function.
-      */
-     void triggerEvent(const std::string &eventName)
-     {
-         auto it = m_functions.find(eventName);
-         if (it != m_functions.end())
-         {
-             std::cout << "Triggering event: " << eventName << std::endl;
-             it->second->execute();
-         }
-         else
-         {
-             std::cout << "No function registered for event: " << eventName << std::endl;
-         }
-     }
- 
- private:
-     std::unordered_map<std::string, std::shared_ptr<ServerlessFunction>> m_functions;
- };
- 
- /**
-  * @brief The entry point for the application, demonstrating the use of serverless functions in the system.
-  */
- int main()
- {
-     // Create a serverless orchestrator instance
-     ServerlessOrchestrator orchestrator;
- 
-     // Register serverless functions
-     orchestrator.registerFunction("userEvent", std::make_shared<UserServiceFunction>());
-     orchestrator.registerFunction("orderEvent", std::make_shared<OrderServiceFunction>());
- 
-     // Simulate triggering events
-     orchestrator.triggerEvent("userEvent"); // Should call UserServiceFunction
-     orchestrator.triggerEvent("orderEvent"); // Should call OrderServiceFunction
-     orchestrator.triggerEvent("paymentEvent"); // No function registered for paymentEvent
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <cassert>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cstddef>
+
+/**
+ * @brief A base class representing a serverless function in the system.
+ *
+ * This abstract class defines the interface for any serverless function. The concrete function implementations will define
+ * the application logic in the `execute` method.
+ */
+class ServerlessFunction
+{
+public:
+    virtual ~ServerlessFunction() = default;
+
+    /**
+     * @brief Executes the function logic. Derived classes should implement the specific logic.
+     */
+    virtual void execute() = 0;
+};
+
+/**
+ * @brief A concrete implementation of a serverless function for a "UserService" that handles user requests.
+ */
+class UserServiceFunction : public ServerlessFunction
+{
+public:
+    /**
+     * @brief Executes the logic for handling a user request.
+     */
+    void execute() override
+    {
+        std::cout << "Executing UserService logic: Handling user-related requests!" << std::endl;
+    }
+};
+
+/**
+ * @brief A concrete implementation of a serverless function for an "OrderService" that handles order requests.
+ */
+class OrderServiceFunction : public ServerlessFunction
+{
+public:
+    /**
+     * @brief Executes the logic for handling an order request.
+     */
+    void execute() override
+    {
+        std::cout << "Executing OrderService logic: Handling order-related requests!" << std::endl;
+    }
+};
+
+/**
+ * @brief A manager that triggers serverless functions based on events.
+ *
+ * This class acts as a serverless function orchestrator. It maps event names to specific serverless functions and
+ * executes the function when an event occurs.
+ */
+class ServerlessOrchestrator
+{
+public:
+    /**
+     * @brief Registers a serverless function for a given event name.
+     *
+     * @param eventName The name of the event.
+     * @param function The serverless function to execute for the event.
+     */
+    void registerFunction(const std::string &eventName, std::shared_ptr<ServerlessFunction> function)
+    {
+        m_functions[eventName] = function;
+    }
+
+    /**
+     * @brief Triggers the execution of the registered function for a given event.
+     *
+     * @param eventName The name of the event that should trigger the function.
+     */
+    void triggerEvent(const std::string &eventName)
+    {
+        auto it = m_functions.find(eventName);
+        if (it != m_functions.end())
+        {
+            std::cout << "Triggering event: " << eventName << std::endl;
+            it->second->execute();
+        }
+        else
+        {
+            std::cout << "No function registered for event: " << eventName << std::endl;
+        }
+    }
+
+private:
+    std::unordered_map<std::string, std::shared_ptr<ServerlessFunction>> m_functions;
+};
+
+/// @brief Stands in for initialization or I/O work of known cost.
+static void simulateWork(std::chrono::microseconds cost)
+{
+    std::this_thread::sleep_for(cost);
+}
+
+/**
+ * @brief A serverless function whose instances can be reset and reused.
+ *
+ * Full initialization is paid once per process; later instances restore
+ * from the snapshot that first init produced, and reused instances only
+ * pay a cheap state reset.
+ */
+class ReusableFunction : public ServerlessFunction
+{
+public:
+    static constexpr auto FULL_INIT_COST = std::chrono::microseconds(800);       ///< First-ever construction.
+    static constexpr auto SNAPSHOT_RESTORE_COST = std::chrono::microseconds(250); ///< Later cold constructions.
+    static constexpr auto RESET_COST = std::chrono::microseconds(15);             ///< Warm reuse.
+
+    /// @brief Clears per-invocation state so the instance can serve again.
+    virtual void reset()
+    {
+        simulateWork(RESET_COST);
+    }
+
+protected:
+    /// @brief Models init: full the first time, snapshot restore afterwards.
+    explicit ReusableFunction(bool fromSnapshot)
+    {
+        simulateWork(fromSnapshot ? SNAPSHOT_RESTORE_COST : FULL_INIT_COST);
+    }
+};
+
+/**
+ * @brief Poolable user-service function; execute() is print-free.
+ */
+class PooledUserServiceFunction : public ReusableFunction
+{
+public:
+    explicit PooledUserServiceFunction(bool fromSnapshot) : ReusableFunction(fromSnapshot) {}
+
+    void execute() override
+    {
+        ++m_requestsHandled;
+    }
+
+private:
+    std::size_t m_requestsHandled{0};
+};
+
+/**
+ * @brief Poolable order-service function; execute() is print-free.
+ */
+class PooledOrderServiceFunction : public ReusableFunction
+{
+public:
+    explicit PooledOrderServiceFunction(bool fromSnapshot) : ReusableFunction(fromSnapshot) {}
+
+    void execute() override
+    {
+        ++m_ordersHandled;
+    }
+
+private:
+    std::size_t m_ordersHandled{0};
+};
+
+/**
+ * @brief Per-type pool of warm instances with predictive pre-warming.
+ *
+ * invoke() reuses a warm instance (reset only) when one is idle and falls
+ * back to a cold construction otherwise. Every invocation lands in a
+ * sliding-rate window; maintain() — called off the critical path — tops the
+ * pool up to the recent invocation rate, capped by maxPoolSize. Cold and
+ * warm starts are counted with their latencies.
+ */
+class WarmFunctionPool
+{
+public:
+    static constexpr auto RATE_WINDOW = std::chrono::milliseconds(50); ///< Sliding window span.
+
+    WarmFunctionPool(std::function<std::unique_ptr<ReusableFunction>(bool fromSnapshot)> factory,
+                     std::size_t maxPoolSize)
+        : m_factory(std::move(factory)), m_maxPoolSize(maxPoolSize)
+    {}
+
+    /// @brief Serves one invocation, warm if possible, and records its latency.
+    void invoke()
+    {
+        auto start = std::chrono::steady_clock::now();
+        recordInvocation(start);
+
+        std::unique_ptr<ReusableFunction> instance;
+        bool warm = !m_idle.empty();
+        if (warm)
+        {
+            instance = std::move(m_idle.back());
+            m_idle.pop_back();
+            instance->reset(); // Reuse: state reset instead of reconstruction.
+        }
+        else
+        {
+            instance = createInstance(); // Cold start on the critical path.
+        }
+        instance->execute();
+        double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        if (warm)
+        {
+            ++m_warmStarts;
+            m_warmMicros += micros;
+        }
+        else
+        {
+            ++m_coldStarts;
+            m_coldMicros += micros;
+        }
+        m_idle.push_back(std::move(instance));
+    }
+
+    /**
+     * @brief Predictive pre-warming: sizes the pool to the recent rate.
+     *
+     * Run between bursts or from a background tick, so the construction cost
+     * never lands on an invocation.
+     */
+    void maintain()
+    {
+        auto now = std::chrono::steady_clock::now();
+        trimWindow(now);
+        std::size_t predicted = std::min(m_window.size(), m_maxPoolSize);
+        while (m_idle.size() < predicted)
+        {
+            m_idle.push_back(createInstance());
+            ++m_prewarmed;
+        }
+    }
+
+    std::size_t coldStarts() const { return m_coldStarts; }
+    std::size_t warmStarts() const { return m_warmStarts; }
+    std::size_t prewarmed() const { return m_prewarmed; }
+    std::size_t poolSize() const { return m_idle.size(); }
+    double averageColdMicros() const { return m_coldStarts ? m_coldMicros / m_coldStarts : 0.0; }
+    double averageWarmMicros() const { return m_warmStarts ? m_warmMicros / m_warmStarts : 0.0; }
+
+private:
+    /// @brief Constructs an instance; everything after the first restores from snapshot.
+    std::unique_ptr<ReusableFunction> createInstance()
+    {
+        bool fromSnapshot = m_everConstructed;
+        m_everConstructed = true;
+        return m_factory(fromSnapshot);
+    }
+
+    void recordInvocation(std::chrono::steady_clock::time_point now)
+    {
+        m_window.push_back(now);
+        trimWindow(now);
+    }
+
+    void trimWindow(std::chrono::steady_clock::time_point now)
+    {
+        while (!m_window.empty() && now - m_window.front() > RATE_WINDOW)
+        {
+            m_window.pop_front();
+        }
+    }
+
+    std::function<std::unique_ptr<ReusableFunction>(bool)> m_factory;
+    std::size_t m_maxPoolSize;
+    std::vector<std::unique_ptr<ReusableFunction>> m_idle; ///< Warm instances ready to serve.
+    std::deque<std::chrono::steady_clock::time_point> m_window; ///< Recent invocation times.
+    bool m_everConstructed{false}; ///< First init produces the snapshot.
+    std::size_t m_coldStarts{0};
+    std::size_t m_warmStarts{0};
+    std::size_t m_prewarmed{0};
+    double m_coldMicros{0.0};
+    double m_warmMicros{0.0};
+};
+
+/**
+ * @brief Orchestrator routing events to warm per-type function pools.
+ */
+class WarmOrchestrator
+{
+public:
+    /// @brief Registers a pool for an event type.
+    void registerPool(const std::string& eventName,
+                      std::function<std::unique_ptr<ReusableFunction>(bool)> factory,
+                      std::size_t maxPoolSize)
+    {
+        m_pools.emplace(eventName, WarmFunctionPool(std::move(factory), maxPoolSize));
+    }
+
+    /// @brief Serves an event from its pool; unknown events are dropped.
+    void triggerEvent(const std::string& eventName)
+    {
+        auto it = m_pools.find(eventName);
+        if (it != m_pools.end())
+        {
+            it->second.invoke();
+        }
+    }
+
+    /// @brief Runs predictive pre-warming across every pool.
+    void maintain()
+    {
+        for (auto& [eventName, pool] : m_pools)
+        {
+            pool.maintain();
+        }
+    }
+
+    const WarmFunctionPool* pool(const std::string& eventName) const
+    {
+        auto it = m_pools.find(eventName);
+        return it == m_pools.end() ? nullptr : &it->second;
+    }
+
+private:
+    std::unordered_map<std::string, WarmFunctionPool> m_pools; ///< One pool per event type.
+};
+
+/**
+ * @brief The entry point for the application, demonstrating the use of serverless functions in the system.
+ */
+int main()
+{
+    // Create a serverless orchestrator instance
+    ServerlessOrchestrator orchestrator;
+
+    // Register serverless functions
+    orchestrator.registerFunction("userEvent", std::make_shared<UserServiceFunction>());
+    orchestrator.registerFunction("orderEvent", std::make_shared<OrderServiceFunction>());
+
+    // Simulate triggering events
+    orchestrator.triggerEvent("userEvent"); // Should call UserServiceFunction
+    orchestrator.triggerEvent("orderEvent"); // Should call OrderServiceFunction
+    orchestrator.triggerEvent("paymentEvent"); // No function registered for paymentEvent
+
+    // Warm pools: bursty traffic against per-invocation construction.
+    constexpr int bursts = 3;
+    constexpr int invocationsPerBurst = 60;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < bursts; ++b)
+    {
+        for (int i = 0; i < invocationsPerBurst; ++i)
+        {
+            PooledUserServiceFunction coldInstance(false); // Full init, every time.
+            coldInstance.execute();
+        }
+    }
+    double coldOnlyTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    WarmOrchestrator warmOrchestrator;
+    warmOrchestrator.registerPool("userEvent",
+        [](bool fromSnapshot) { return std::make_unique<PooledUserServiceFunction>(fromSnapshot); }, 16);
+    warmOrchestrator.registerPool("orderEvent",
+        [](bool fromSnapshot) { return std::make_unique<PooledOrderServiceFunction>(fromSnapshot); }, 16);
+
+    start = std::chrono::steady_clock::now();
+    for (int b = 0; b < bursts; ++b)
+    {
+        for (int i = 0; i < invocationsPerBurst; ++i)
+        {
+            warmOrchestrator.triggerEvent("userEvent");
+        }
+        warmOrchestrator.maintain(); // Between bursts: pre-warm to the observed rate.
+    }
+    double warmTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    const WarmFunctionPool* userPool = warmOrchestrator.pool("userEvent");
+    std::cout << bursts * invocationsPerBurst << " invocation(s): cold-per-invocation "
+              << coldOnlyTime << " ms, warm pools " << warmTime << " ms\n";
+    std::cout << "userEvent pool: " << userPool->coldStarts() << " cold start(s) (avg "
+              << userPool->averageColdMicros() << " us), " << userPool->warmStarts()
+              << " warm start(s) (avg " << userPool->averageWarmMicros() << " us), "
+              << userPool->prewarmed() << " pre-warmed, pool size "
+              << userPool->poolSize() << std::endl;
+
+    return 0;
+}
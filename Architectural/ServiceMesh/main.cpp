@@ -1,140 +1,362 @@
 /**
  * @brief
  * The Service Mesh design pattern is used to manage microservices communication in a more structured and controlled way.
- * 
+ *
  * Key Concepts:
  * - Microservices Communication: Ensures communication between microservices in a consistent manner.
  * - Service Discovery: Automatically finds the location of services, making it easier to call them without hardcoding addresses.
  * - Load Balancing: Distributes requests across multiple service instances to improve performance and availability.
  * - Routing: Manages the flow of requests between services based on predefined policies.
  * - Security: Often includes authentication, authorization, and encryption for secure communication between services.
- * 
+ *
  * Benefits:
  * - Simplifies communication management: Centralizes the management of microservices communication.
  * - Enhances scalability and resilience: Manages communication at scale with built-in routing, load balancing, and service discovery.
  * - Improves security: Allows centralized handling of authentication and encryption.
  * - Reduces complexity for individual microservices: Services only need to communicate with the service mesh instead of directly managing complex interactions with other services.
+ *
+ * Routing every call through a locked name lookup is pure overhead for
+ * service pairs that are co-located and policy-free. FastPathMesh below hands
+ * callers a direct-dial endpoint after the first routed call: subsequent
+ * calls go straight to the service with no lock and no lookup, guarded only
+ * by a generation counter that topology or policy changes bump to invalidate
+ * every outstanding endpoint. Per-route call and sampled-latency counters are
+ * maintained with relaxed atomics so the fast path never serializes.
  */
 
- #include <iostream>
- #include <memory>
- #include <unordered_map>
- #include <string>
- #include <functional>
- #include <mutex>
- 
- /**
-  * @brief Represents a base service that can be called through the Service Mesh.
-  * 
-  * This base class defines a common interface for all services that will be managed by the Service Mesh.
-  */
- class Service
- {
- public:
-     virtual ~Service() = default;
- 
-     /**
-      * @brief Handles a request to the service.
-      * 
-      * This method will be overridden by concrete services to process requests.
-      */
-     virtual void handleRequest() = 0;
- };
- 
- /**
-  * @brief A concrete service implementation for the "User" service.
-  */
- class UserService : public Service
- {
- public:
-     /**
-      * @brief Handles the request for the "User" service.
-      */
-     void handleRequest() override
-     {
-         std::cout << "UserService: Handling user request." << std::endl;
-     }
- };
- 
- /**
-  * @brief A concrete service implementation for the "Order" service.
-  */
- class OrderService : public Service
- {
- public:
-     /**
-      * @brief Handles the request for the "Order" service.
-      */
-     void handleRequest() override
-     {
-         std::cout << "OrderService: Handling order request." << std::endl;
-     }
- };
- 
- /**
-  * @brief Service Mesh that manages communication between services.
-  * 
-  * The Service Mesh handles service discovery, routing, and communication management.
-  */
- class ServiceMesh
- {
- public:
-     ServiceMesh() = default;
- 
-     /**
-      * @brief Registers a service with the service mesh.
-      * 
-      * @param name The name of the service.
-      * @param service The service instance.
-      */
-     void registerService(const std::string &name, std::shared_ptr<Service> service)
-     {
-         std::lock_guard<std::mutex> lock(m_mutex);
-         m_services[name] = service;
-     }
- 
-     /**
-      * @brief Routes a request to the appropriate service based on the service name.
-      * 
-      * @param serviceName The name of the service to route the request to.
-      */
-     void routeRequest(const std::string &serviceName)
-     {
-         std::lock_guard<std::mutex> lock(m_mutex);
-         if (m_services.find(serviceName) != m_services.end())
-         {
-             m_services[serviceName]->handleRequest();
-         }
-         else
-         {
-             std::cout << "Service not found: " << serviceName << std::endl;
-         }
-     }
- 
- private:
-     std::unordered_map<std::string, std::shared_ptr<Service>> m_services;
-     std::mutex m_mutex; // Protects the service registry
- };
- 
- /**
-  * @brief Main function demonstrating the Service Mesh pattern.
-  * 
-  * In this example, we create a service mesh, register services, and route requests to the services.
-  */
- int main()
- {
-     // Create a Service Mesh instance
-     ServiceMesh serviceMesh;
- 
-     // Register services with the service mesh
-     serviceMesh.registerService("user", std::make_shared<UserService>());
-     serviceMesh.registerService("order", std::make_shared<OrderService>());
- 
-     // Route requests to the registered services
-     serviceMesh.routeRequest("user");
-     serviceMesh.routeRequest("order");
-     serviceMesh.routeRequest("payment"); // Non-existent service
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <string>
+#include <functional>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Represents a base service that can be called through the Service Mesh.
+ *
+ * This base class defines a common interface for all services that will be managed by the Service Mesh.
+ */
+class Service
+{
+public:
+    virtual ~Service() = default;
+
+    /**
+     * @brief Handles a request to the service.
+     *
+     * This method will be overridden by concrete services to process requests.
+     */
+    virtual void handleRequest() = 0;
+};
+
+/**
+ * @brief A concrete service implementation for the "User" service.
+ */
+class UserService : public Service
+{
+public:
+    /**
+     * @brief Handles the request for the "User" service.
+     */
+    void handleRequest() override
+    {
+        std::cout << "UserService: Handling user request." << std::endl;
+    }
+};
+
+/**
+ * @brief A concrete service implementation for the "Order" service.
+ */
+class OrderService : public Service
+{
+public:
+    /**
+     * @brief Handles the request for the "Order" service.
+     */
+    void handleRequest() override
+    {
+        std::cout << "OrderService: Handling order request." << std::endl;
+    }
+};
+
+/**
+ * @brief Service Mesh that manages communication between services.
+ *
+ * The Service Mesh handles service discovery, routing, and communication management.
+ */
+class ServiceMesh
+{
+public:
+    ServiceMesh() = default;
+
+    /**
+     * @brief Registers a service with the service mesh.
+     *
+     * @param name The name of the service.
+     * @param service The service instance.
+     */
+    void registerService(const std::string &name, std::shared_ptr<Service> service)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_services[name] = service;
+    }
+
+    /**
+     * @brief Routes a request to the appropriate service based on the service name.
+     *
+     * @param serviceName The name of the service to route the request to.
+     */
+    void routeRequest(const std::string &serviceName)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_services.find(serviceName) != m_services.end())
+        {
+            m_services[serviceName]->handleRequest();
+        }
+        else
+        {
+            std::cout << "Service not found: " << serviceName << std::endl;
+        }
+    }
+
+private:
+    std::unordered_map<std::string, std::shared_ptr<Service>> m_services;
+    std::mutex m_mutex; // Protects the service registry
+};
+
+/**
+ * @brief A print-free service used by the routing benchmark.
+ */
+class MetricsService : public Service
+{
+public:
+    void handleRequest() override
+    {
+        ++m_handled;
+    }
+
+    std::size_t handled() const { return m_handled; }
+
+private:
+    std::size_t m_handled{0};
+};
+
+/**
+ * @brief Mesh with a sidecar-free direct-dial fast path.
+ *
+ * Routes marked intercept-free hand back an Endpoint after the first routed
+ * call. The endpoint carries the mesh generation it was minted under; calls
+ * through it cost one relaxed generation check plus the virtual dispatch —
+ * no lock, no name lookup. registerService() and setInterceptFree() bump
+ * the generation, so every outstanding endpoint lazily re-routes on its
+ * next use. Call and sampled-latency counters per route use relaxed
+ * atomics only.
+ */
+class FastPathMesh
+{
+public:
+    static constexpr std::uint64_t LATENCY_SAMPLE_MASK = 63; ///< Sample every 64th call.
+
+    /**
+     * @brief Per-route bookkeeping; counters are contention-free.
+     */
+    struct Route
+    {
+        std::shared_ptr<Service> service;
+        bool interceptFree{false};                 ///< Eligible for direct dial.
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> sampledLatencyNanos{0};
+        std::atomic<std::uint64_t> latencySamples{0};
+    };
+
+    /**
+     * @brief A cached direct endpoint; valid while the mesh generation holds.
+     */
+    class Endpoint
+    {
+    public:
+        Endpoint() = default;
+
+    private:
+        friend class FastPathMesh;
+
+        Service* m_service{nullptr};
+        Route* m_route{nullptr};
+        std::uint64_t m_generation{0}; ///< Mesh generation at mint time.
+    };
+
+    /// @brief Registers or replaces a service; invalidates all endpoints.
+    void registerService(const std::string& name, std::shared_ptr<Service> service, bool interceptFree)
+    {
+        std::lock_guard lock(m_mutex);
+        auto route = std::make_unique<Route>();
+        route->service = std::move(service);
+        route->interceptFree = interceptFree;
+        m_routes[name] = std::move(route);
+        m_generation.fetch_add(1, std::memory_order_release);
+    }
+
+    /// @brief Policy change; invalidates all endpoints.
+    void setInterceptFree(const std::string& name, bool interceptFree)
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_routes.find(name);
+        if (it != m_routes.end())
+        {
+            it->second->interceptFree = interceptFree;
+            m_generation.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief Calls through the endpoint, re-routing first if it went stale.
+     *
+     * The hot path is one acquire generation load, the virtual call, and a
+     * relaxed call-count increment.
+     */
+    void call(const std::string& serviceName, Endpoint& endpoint)
+    {
+        if (endpoint.m_service == nullptr
+            || endpoint.m_generation != m_generation.load(std::memory_order_acquire))
+        {
+            routeAndRefresh(serviceName, endpoint); // Slow path: locked lookup.
+            return;
+        }
+        Route& route = *endpoint.m_route;
+        std::uint64_t callIndex = route.calls.fetch_add(1, std::memory_order_relaxed);
+        if ((callIndex & LATENCY_SAMPLE_MASK) == 0)
+        {
+            auto start = std::chrono::steady_clock::now();
+            endpoint.m_service->handleRequest();
+            auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            route.sampledLatencyNanos.fetch_add(static_cast<std::uint64_t>(nanos), std::memory_order_relaxed);
+            route.latencySamples.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            endpoint.m_service->handleRequest();
+        }
+    }
+
+    /// @brief Classic routed call: locked name lookup on every hop.
+    void routeRequest(const std::string& serviceName)
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_routes.find(serviceName);
+        if (it != m_routes.end())
+        {
+            it->second->calls.fetch_add(1, std::memory_order_relaxed);
+            it->second->service->handleRequest();
+        }
+    }
+
+    std::uint64_t generation() const { return m_generation.load(std::memory_order_acquire); }
+
+    /// @brief Average sampled fast-path latency for a route, in nanoseconds.
+    double averageSampledNanos(const std::string& serviceName)
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_routes.find(serviceName);
+        if (it == m_routes.end() || it->second->latencySamples.load() == 0)
+        {
+            return 0.0;
+        }
+        return static_cast<double>(it->second->sampledLatencyNanos.load())
+             / static_cast<double>(it->second->latencySamples.load());
+    }
+
+    std::uint64_t routeCalls(const std::string& serviceName)
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_routes.find(serviceName);
+        return it == m_routes.end() ? 0 : it->second->calls.load(std::memory_order_relaxed);
+    }
+
+private:
+    /// @brief Locked lookup that services the call and re-mints the endpoint.
+    void routeAndRefresh(const std::string& serviceName, Endpoint& endpoint)
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_routes.find(serviceName);
+        if (it == m_routes.end())
+        {
+            endpoint = Endpoint();
+            return;
+        }
+        Route& route = *it->second;
+        route.calls.fetch_add(1, std::memory_order_relaxed);
+        route.service->handleRequest();
+        if (route.interceptFree)
+        {
+            endpoint.m_service = route.service.get();
+            endpoint.m_route = &route;
+            endpoint.m_generation = m_generation.load(std::memory_order_acquire);
+        }
+        else
+        {
+            endpoint = Endpoint(); // Policied routes never direct-dial.
+        }
+    }
+
+    std::unordered_map<std::string, std::unique_ptr<Route>> m_routes; ///< Stable Route addresses.
+    std::mutex m_mutex;
+    std::atomic<std::uint64_t> m_generation{0}; ///< Bumped on topology/policy change.
+};
+
+/**
+ * @brief Main function demonstrating the Service Mesh pattern.
+ *
+ * In this example, we create a service mesh, register services, and route requests to the services.
+ */
+int main()
+{
+    // Create a Service Mesh instance
+    ServiceMesh serviceMesh;
+
+    // Register services with the service mesh
+    serviceMesh.registerService("user", std::make_shared<UserService>());
+    serviceMesh.registerService("order", std::make_shared<OrderService>());
+
+    // Route requests to the registered services
+    serviceMesh.routeRequest("user");
+    serviceMesh.routeRequest("order");
+    serviceMesh.routeRequest("payment"); // Non-existent service
+
+    // Direct dial: generation-guarded endpoints vs a lookup per hop.
+    constexpr std::uint64_t callCount = 4000000;
+
+    FastPathMesh fastMesh;
+    auto metrics = std::make_shared<MetricsService>();
+    fastMesh.registerService("metrics", metrics, true);
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < callCount; ++i)
+    {
+        fastMesh.routeRequest("metrics"); // Lock + hash lookup, every call.
+    }
+    double routedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    FastPathMesh::Endpoint endpoint;
+    start = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < callCount; ++i)
+    {
+        fastMesh.call("metrics", endpoint); // First call routes; the rest direct-dial.
+        if (i == callCount / 2)
+        {
+            fastMesh.setInterceptFree("metrics", true); // Policy touch: endpoints go stale...
+        }                                               // ...and lazily re-route once.
+    }
+    double directTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << callCount << " call(s): routed " << routedTime << " ms, direct dial "
+              << directTime << " ms (generation " << fastMesh.generation()
+              << ", avg sampled latency " << fastMesh.averageSampledNanos("metrics")
+              << " ns, " << metrics->handled() << " handled)" << std::endl;
+
+    return 0;
+}
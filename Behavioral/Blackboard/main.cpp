@@ -10,132 +10,472 @@
  * - Provides a centralized data repository.
  * - Allows for multiple subsystems to contribute to the solution incrementally.
  * - Facilitates extensibility and modification as new agents can be added without modifying existing ones.
+ *
+ * Running every agent over the whole blackboard each cycle recomputes mostly identical
+ * results once entries stop changing between cycles. The versioned mode below tracks a
+ * monotonic version per entry, lets agents subscribe to key prefixes, and invokes each
+ * agent only with the delta set since its last run; agents whose declared read/write
+ * sets are disjoint execute in parallel batches.
  */
 
- #include <iostream>
- #include <memory>
- #include <vector>
- #include <string>
- #include <algorithm>
- 
- /// @brief Blackboard class serves as the shared memory space for data.
- class Blackboard
- {
- public:
-     void addData(const std::string& data)
-     {
-         m_data.push_back(data);
-     }
- 
-     const std::vector<std::string>& getData() const
-     {
-         return m_data;
-     }
- 
-     void clearData()
-     {
-         m_data.clear();
-     }
- 
- private:
-     std::vector<std::string> m_data; ///< Stores the data on the blackboard.
- };
- 
- /// @brief Subsystem (Agent) class that reads from and writes to the blackboard.
- class Agent
- {
- public:
-     virtual ~Agent() = default;
- 
-     /// @brief Performs processing on the blackboard data.
-     /// @param blackboard The blackboard to read from and write to.
-     virtual void process(std::shared_ptr<Blackboard> blackboard) = 0;
- };
- 
- /// @brief Example of a concrete agent that processes text data on the blackboard.
- class TextProcessingAgent : public Agent
- {
- public:
-     void process(std::shared_ptr<Blackboard> blackboard) override
-     {
-         for (auto& data : blackboard->getData())
-         {
-             std::string uppercased = data;
-             std::transform(uppercased.begin(), uppercased.end(), uppercased.begin(), ::toupper);
-             std::cout << "TextProcessingAgent processed: " << uppercased << std::endl;
-         }
-     }
- };
- 
- /// @brief Example of another concrete agent that processes numeric data on the blackboard.
- class NumericProcessingAgent : public Agent
- {
- public:
-     void process(std::shared_ptr<Blackboard> blackboard) override
-     {
-         for (auto& data : blackboard->getData())
-         {
-             try
-             {
-                 int number = std::stoi(data);
-                 std::cout << "NumericProcessingAgent processed: " << (number * 2) << std::endl;
-             }
-             catch (const std::exception&)
-             {
-                 std::cout << "NumericProcessingAgent couldn't process non-numeric data: " << data << std::endl;
-             }
-         }
-     }
- };
- 
- /// @brief Orchestrator that controls the flow of data through agents on the blackboard.
- class Orchestrator
- {
- public:
-     Orchestrator(std::shared_ptr<Blackboard> blackboard) : m_blackboard(blackboard) {}
- 
-     /// @brief Executes all the agents to process data on the blackboard.
-     void executeAgents()
-     {
-         for (auto& agent : m_agents)
-         {
-             agent->process(m_blackboard);
-         }
-     }
- 
-     /// @brief Adds agents to be executed.
-     void addAgent(std::shared_ptr<Agent> agent)
-     {
-         m_agents.push_back(agent);
-     }
- 
- private:
-     std::shared_ptr<Blackboard> m_blackboard; ///< Shared memory for all agents.
-     std::vector<std::shared_ptr<Agent>> m_agents; ///< List of agents to process data.
- };
- 
- int main()
- {
-     // Create the blackboard
-     auto blackboard = std::make_shared<Blackboard>();
- 
-     // Add some data to the blackboard
-     blackboard->addData("hello");
-     blackboard->addData("42");
-     blackboard->addData("world");
- 
-     // Create agents
-     auto textAgent = std::make_shared<TextProcessingAgent>();
-     auto numericAgent = std::make_shared<NumericProcessingAgent>();
- 
-     // Create the orchestrator and add agents
-     Orchestrator orchestrator(blackboard);
-     orchestrator.addAgent(textAgent);
-     orchestrator.addAgent(numericAgent);
- 
-     // Execute all agents to process data on the blackboard
-     orchestrator.executeAgents();
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <unordered_map>
+#include <span>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+
+/// @brief Blackboard class serves as the shared memory space for data.
+class Blackboard
+{
+public:
+    void addData(const std::string& data)
+    {
+        m_data.push_back(data);
+    }
+
+    const std::vector<std::string>& getData() const
+    {
+        return m_data;
+    }
+
+    void clearData()
+    {
+        m_data.clear();
+    }
+
+private:
+    std::vector<std::string> m_data; ///< Stores the data on the blackboard.
+};
+
+/// @brief Subsystem (Agent) class that reads from and writes to the blackboard.
+class Agent
+{
+public:
+    virtual ~Agent() = default;
+
+    /// @brief Performs processing on the blackboard data.
+    /// @param blackboard The blackboard to read from and write to.
+    virtual void process(std::shared_ptr<Blackboard> blackboard) = 0;
+};
+
+/// @brief Example of a concrete agent that processes text data on the blackboard.
+class TextProcessingAgent : public Agent
+{
+public:
+    void process(std::shared_ptr<Blackboard> blackboard) override
+    {
+        for (auto& data : blackboard->getData())
+        {
+            std::string uppercased = data;
+            std::transform(uppercased.begin(), uppercased.end(), uppercased.begin(), ::toupper);
+            std::cout << "TextProcessingAgent processed: " << uppercased << std::endl;
+        }
+    }
+};
+
+/// @brief Example of another concrete agent that processes numeric data on the blackboard.
+class NumericProcessingAgent : public Agent
+{
+public:
+    void process(std::shared_ptr<Blackboard> blackboard) override
+    {
+        for (auto& data : blackboard->getData())
+        {
+            try
+            {
+                int number = std::stoi(data);
+                std::cout << "NumericProcessingAgent processed: " << (number * 2) << std::endl;
+            }
+            catch (const std::exception&)
+            {
+                std::cout << "NumericProcessingAgent couldn't process non-numeric data: " << data << std::endl;
+            }
+        }
+    }
+};
+
+/// @brief Orchestrator that controls the flow of data through agents on the blackboard.
+class Orchestrator
+{
+public:
+    Orchestrator(std::shared_ptr<Blackboard> blackboard) : m_blackboard(blackboard) {}
+
+    /// @brief Executes all the agents to process data on the blackboard.
+    void executeAgents()
+    {
+        for (auto& agent : m_agents)
+        {
+            agent->process(m_blackboard);
+        }
+    }
+
+    /// @brief Adds agents to be executed.
+    void addAgent(std::shared_ptr<Agent> agent)
+    {
+        m_agents.push_back(agent);
+    }
+
+private:
+    std::shared_ptr<Blackboard> m_blackboard; ///< Shared memory for all agents.
+    std::vector<std::shared_ptr<Agent>> m_agents; ///< List of agents to process data.
+};
+
+/// @brief Blackboard whose entries carry a monotonic modification version.
+///
+/// put() stamps the written entry with a fresh global version, so any agent
+/// can ask cheaply for "every key under this prefix changed since version V"
+/// instead of rescanning the whole board.
+class VersionedBlackboard
+{
+public:
+    /// @brief Writes or overwrites an entry and stamps it with a new version.
+    void put(const std::string& key, std::string value)
+    {
+        Entry& entry = m_entries[key];
+        entry.value = std::move(value);
+        entry.version = ++m_version;
+        m_changeLog.emplace_back(key, entry.version); // Versions arrive pre-sorted.
+    }
+
+    /// @brief Reads an entry's value; empty view when the key is absent.
+    std::string_view get(const std::string& key) const
+    {
+        auto it = m_entries.find(key);
+        return it == m_entries.end() ? std::string_view{} : std::string_view(it->second.value);
+    }
+
+    /// @brief Collects keys under prefix whose version is newer than sinceVersion.
+    ///
+    /// Served from the append-only change log, so the cost is proportional to
+    /// the writes since the cursor — not to the size of the board.
+    std::vector<std::string_view> collectDelta(std::string_view prefix, std::uint64_t sinceVersion) const
+    {
+        auto begin = std::lower_bound(m_changeLog.begin(), m_changeLog.end(), sinceVersion,
+                                      [](const auto& change, std::uint64_t version)
+                                      { return change.second <= version; });
+        std::vector<std::string_view> delta;
+        for (auto it = begin; it != m_changeLog.end(); ++it)
+        {
+            const auto& entry = m_entries.find(it->first)->second;
+            // Report each key once, at its newest version in the window.
+            if (entry.version == it->second && std::string_view(it->first).starts_with(prefix))
+            {
+                delta.push_back(it->first);
+            }
+        }
+        return delta;
+    }
+
+    /// @brief Current global version; a delta query against this is empty.
+    std::uint64_t version() const { return m_version; }
+
+private:
+    /// @brief One blackboard entry: its value plus the version of its last write.
+    struct Entry
+    {
+        std::string value;
+        std::uint64_t version{0};
+    };
+
+    std::unordered_map<std::string, Entry> m_entries;            ///< Keyed entry store.
+    std::vector<std::pair<std::string, std::uint64_t>> m_changeLog; ///< Writes in version order.
+    std::uint64_t m_version{0};                                  ///< Monotonic write counter.
+};
+
+/// @brief Agent invoked only with the keys that changed since its last run.
+///
+/// Subscriptions are declared as key prefixes: readPrefix() is what the agent
+/// consumes, writePrefix() is where it publishes. The orchestrator uses both
+/// to compute delta sets and to schedule agents with disjoint sets in parallel.
+class DeltaAgent
+{
+public:
+    virtual ~DeltaAgent() = default;
+
+    /// @brief Prefix of the keys this agent consumes.
+    virtual std::string readPrefix() const = 0;
+
+    /// @brief Prefix of the keys this agent publishes.
+    virtual std::string writePrefix() const = 0;
+
+    /// @brief Processes only the changed keys; never sees unchanged entries.
+    ///
+    /// Reads the board, returns the writes to publish. Keeping agents
+    /// read-only during execution is what makes parallel batches safe: the
+    /// orchestrator applies all outputs single-threaded after the batch.
+    virtual std::vector<std::pair<std::string, std::string>> process(
+        const VersionedBlackboard& blackboard, std::span<const std::string_view> changedKeys) = 0;
+};
+
+/// @brief Fusion agent summarizing one sensor group into a derived entry.
+class GroupSummaryAgent : public DeltaAgent
+{
+public:
+    explicit GroupSummaryAgent(int group)
+        : m_readPrefix("sensor/g" + std::to_string(group) + "/"),
+          m_writePrefix("derived/g" + std::to_string(group))
+    {}
+
+    std::string readPrefix() const override { return m_readPrefix; }
+    std::string writePrefix() const override { return m_writePrefix; }
+
+    std::vector<std::pair<std::string, std::string>> process(
+        const VersionedBlackboard& blackboard, std::span<const std::string_view> changedKeys) override
+    {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        for (std::string_view key : changedKeys)
+        {
+            for (char c : blackboard.get(std::string(key)))
+            {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+            }
+        }
+        ++m_invocations;
+        m_keysProcessed += changedKeys.size();
+        return {{m_writePrefix, std::to_string(hash % 100000)}};
+    }
+
+    std::size_t invocations() const { return m_invocations; }
+    std::size_t keysProcessed() const { return m_keysProcessed; }
+
+private:
+    std::string m_readPrefix;        ///< Subscribed sensor-group prefix.
+    std::string m_writePrefix;       ///< Derived entry this agent owns.
+    std::size_t m_invocations{0};    ///< Cycles in which this agent actually ran.
+    std::size_t m_keysProcessed{0};  ///< Total delta keys handed to process().
+};
+
+/// @brief Orchestrator that runs agents on deltas and parallelizes disjoint ones.
+///
+/// Each agent remembers the blackboard version at its last run; a cycle hands
+/// it only keys written since then and skips it entirely when its subscription
+/// saw no writes. Agents are pre-grouped into batches whose declared
+/// read/write prefixes don't overlap; a batch executes read-only across
+/// worker threads and its outputs are published afterwards in one spot.
+class DeltaOrchestrator
+{
+public:
+    explicit DeltaOrchestrator(std::shared_ptr<VersionedBlackboard> blackboard)
+        : m_blackboard(std::move(blackboard))
+    {}
+
+    /// @brief Registers an agent; batches are recomputed on next cycle.
+    void addAgent(std::shared_ptr<DeltaAgent> agent)
+    {
+        m_agents.push_back(Registration{std::move(agent), 0});
+        m_batchesDirty = true;
+    }
+
+    /// @brief Runs one cycle: delta collection, skip-if-unchanged, parallel batches.
+    void runCycle()
+    {
+        if (m_batchesDirty)
+        {
+            buildBatches();
+        }
+        for (const std::vector<std::size_t>& batch : m_batches)
+        {
+            runBatch(batch);
+        }
+    }
+
+    std::size_t skippedRuns() const { return m_skippedRuns; }
+
+private:
+    /// @brief One registered agent plus the version it last caught up to.
+    struct Registration
+    {
+        std::shared_ptr<DeltaAgent> agent;
+        std::uint64_t lastSeenVersion;
+    };
+
+    /// @brief True when two prefixes can name a common key.
+    static bool prefixesOverlap(const std::string& a, const std::string& b)
+    {
+        return a.starts_with(b) || b.starts_with(a);
+    }
+
+    /// @brief True when the agent's sets conflict with any agent in the batch.
+    bool conflictsWithBatch(const std::vector<std::size_t>& batch, const DeltaAgent& agent) const
+    {
+        for (std::size_t index : batch)
+        {
+            const DeltaAgent& other = *m_agents[index].agent;
+            if (prefixesOverlap(agent.writePrefix(), other.writePrefix()) ||
+                prefixesOverlap(agent.writePrefix(), other.readPrefix()) ||
+                prefixesOverlap(agent.readPrefix(), other.writePrefix()))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Greedily packs agents into conflict-free batches.
+    void buildBatches()
+    {
+        m_batches.clear();
+        for (std::size_t i = 0; i < m_agents.size(); ++i)
+        {
+            bool placed = false;
+            for (auto& batch : m_batches)
+            {
+                if (!conflictsWithBatch(batch, *m_agents[i].agent))
+                {
+                    batch.push_back(i);
+                    placed = true;
+                    break;
+                }
+            }
+            if (!placed)
+            {
+                m_batches.push_back({i});
+            }
+        }
+        m_batchesDirty = false;
+    }
+
+    /// @brief Runs one conflict-free batch across worker threads.
+    void runBatch(const std::vector<std::size_t>& batch)
+    {
+        // Delta collection is read-only on the board; done before any writes.
+        std::vector<std::vector<std::string_view>> deltas(batch.size());
+        std::vector<std::size_t> runnable;
+        for (std::size_t b = 0; b < batch.size(); ++b)
+        {
+            Registration& registration = m_agents[batch[b]];
+            deltas[b] = m_blackboard->collectDelta(registration.agent->readPrefix(),
+                                                   registration.lastSeenVersion);
+            if (deltas[b].empty())
+            {
+                ++m_skippedRuns; // Nothing changed under this subscription.
+            }
+            else
+            {
+                runnable.push_back(b);
+            }
+        }
+        std::uint64_t versionBefore = m_blackboard->version();
+        unsigned workerCount = std::min<unsigned>(std::max(2u, std::thread::hardware_concurrency()),
+                                                  static_cast<unsigned>(runnable.size()));
+        std::vector<std::vector<std::pair<std::string, std::string>>> outputs(runnable.size());
+        std::atomic<std::size_t> next{0};
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < workerCount; ++t)
+        {
+            workers.emplace_back([this, &batch, &deltas, &runnable, &outputs, &next]
+            {
+                for (std::size_t i = next.fetch_add(1); i < runnable.size(); i = next.fetch_add(1))
+                {
+                    std::size_t b = runnable[i];
+                    outputs[i] = m_agents[batch[b]].agent->process(*m_blackboard, deltas[b]);
+                }
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        // Publish phase: all writes land single-threaded, after every read.
+        for (auto& agentOutputs : outputs)
+        {
+            for (auto& [key, value] : agentOutputs)
+            {
+                m_blackboard->put(key, std::move(value));
+            }
+        }
+        for (std::size_t index : batch)
+        {
+            m_agents[index].lastSeenVersion = versionBefore;
+        }
+    }
+
+    std::shared_ptr<VersionedBlackboard> m_blackboard; ///< Shared versioned store.
+    std::vector<Registration> m_agents;                ///< Agents with catch-up cursors.
+    std::vector<std::vector<std::size_t>> m_batches;   ///< Conflict-free agent groups.
+    bool m_batchesDirty{true};
+    std::size_t m_skippedRuns{0};                      ///< Agent runs avoided by deltas.
+};
+
+int main()
+{
+    // Create the blackboard
+    auto blackboard = std::make_shared<Blackboard>();
+
+    // Add some data to the blackboard
+    blackboard->addData("hello");
+    blackboard->addData("42");
+    blackboard->addData("world");
+
+    // Create agents
+    auto textAgent = std::make_shared<TextProcessingAgent>();
+    auto numericAgent = std::make_shared<NumericProcessingAgent>();
+
+    // Create the orchestrator and add agents
+    Orchestrator orchestrator(blackboard);
+    orchestrator.addAgent(textAgent);
+    orchestrator.addAgent(numericAgent);
+
+    // Execute all agents to process data on the blackboard
+    orchestrator.executeAgents();
+
+    // Versioned mode: 200 agents over 20 sensor groups, deltas only.
+    constexpr int groupCount = 20;
+    constexpr int sensorsPerGroup = 500;
+    constexpr int cycles = 50;
+
+    auto board = std::make_shared<VersionedBlackboard>();
+    for (int g = 0; g < groupCount; ++g)
+    {
+        for (int s = 0; s < sensorsPerGroup; ++s)
+        {
+            board->put("sensor/g" + std::to_string(g) + "/s" + std::to_string(s),
+                       "reading-" + std::to_string(g * sensorsPerGroup + s));
+        }
+    }
+
+    DeltaOrchestrator deltaOrchestrator(board);
+    std::vector<std::shared_ptr<GroupSummaryAgent>> agents;
+    for (int i = 0; i < 200; ++i)
+    {
+        auto agent = std::make_shared<GroupSummaryAgent>(i % groupCount);
+        agents.push_back(agent);
+        deltaOrchestrator.addAgent(agent);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    deltaOrchestrator.runCycle(); // First cycle: everything is new to every agent.
+    for (int cycle = 1; cycle < cycles; ++cycle)
+    {
+        // Steady state: one group's sensors change per cycle.
+        int group = cycle % groupCount;
+        for (int s = 0; s < 5; ++s)
+        {
+            board->put("sensor/g" + std::to_string(group) + "/s" + std::to_string(s),
+                       "reading-" + std::to_string(cycle * 1000 + s));
+        }
+        deltaOrchestrator.runCycle();
+    }
+    double deltaTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::size_t invocations = 0;
+    std::size_t keysProcessed = 0;
+    for (const auto& agent : agents)
+    {
+        invocations += agent->invocations();
+        keysProcessed += agent->keysProcessed();
+    }
+    std::size_t fullScanKeys = static_cast<std::size_t>(cycles) * agents.size() * sensorsPerGroup;
+    std::cout << "\n" << cycles << " cycle(s), " << agents.size() << " agent(s): " << deltaTime
+              << " ms, " << invocations << " invocation(s), "
+              << deltaOrchestrator.skippedRuns() << " skipped, " << keysProcessed
+              << " delta key(s) processed vs " << fullScanKeys << " under full rescans" << std::endl;
+
+    return 0;
+}
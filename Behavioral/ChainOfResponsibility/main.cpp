@@ -15,137 +15,308 @@
  * - **Decouples Senders and Receivers**: Request senders don't need to know which handler will process the request.
  * - **Flexible Request Handling**: Easily add or remove handlers without modifying existing code.
  * - **Reduces Conditional Complexity**: Eliminates long `if-else` chains.
+ *
+ * Walking a long chain costs one virtual call per node, and requests matched by late
+ * handlers pay for every node before them. CompiledChain derives a sorted interval table
+ * at build time from handlers that declare the priority range they accept, dispatching
+ * each request straight to its handler in O(log n); handlers with dynamic predicates
+ * stay on the classic walk as the fallback.
+ */
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+/**
+ * @brief Abstract base class representing a request handler.
+ */
+class Handler
+{
+public:
+    virtual ~Handler() = default;
+
+    /**
+     * @brief Sets the next handler in the chain.
+     * @param nextHandler Shared pointer to the next handler.
+     */
+    void setNext(std::shared_ptr<Handler> nextHandler)
+    {
+        m_nextHandler = nextHandler;
+    }
+
+    /**
+     * @brief Handles a request, processing it or passing it to the next handler.
+     * @param request The request integer value.
+     */
+    virtual void handleRequest(int request)
+    {
+        if (m_nextHandler)
+        {
+            m_nextHandler->handleRequest(request);
+        }
+        else
+        {
+            std::cout << "No handler available for request: " << request << std::endl;
+        }
+    }
+
+protected:
+    std::shared_ptr<Handler> m_nextHandler; ///< Pointer to the next handler in the chain.
+};
+
+/**
+ * @brief Concrete handler for low-priority requests.
+ */
+class LowPriorityHandler : public Handler
+{
+public:
+    /**
+     * @brief Processes low-priority requests or passes them further.
+     * @param request The request integer value.
+     */
+    void handleRequest(int request) override
+    {
+        if (request < 10)
+        {
+            std::cout << "LowPriorityHandler processing request: " << request << std::endl;
+        }
+        else if (m_nextHandler)
+        {
+            m_nextHandler->handleRequest(request);
+        }
+    }
+};
+
+/**
+ * @brief Concrete handler for medium-priority requests.
+ */
+class MediumPriorityHandler : public Handler
+{
+public:
+    /**
+     * @brief Processes medium-priority requests or passes them further.
+     * @param request The request integer value.
+     */
+    void handleRequest(int request) override
+    {
+        if (request >= 10 && request < 20)
+        {
+            std::cout << "MediumPriorityHandler processing request: " << request << std::endl;
+        }
+        else if (m_nextHandler)
+        {
+            m_nextHandler->handleRequest(request);
+        }
+    }
+};
+
+/**
+ * @brief Concrete handler for high-priority requests.
+ */
+class HighPriorityHandler : public Handler
+{
+public:
+    /**
+     * @brief Processes high-priority requests.
+     * @param request The request integer value.
+     */
+    void handleRequest(int request) override
+    {
+        if (request >= 20)
+        {
+            std::cout << "HighPriorityHandler processing request: " << request << std::endl;
+        }
+        else if (m_nextHandler)
+        {
+            m_nextHandler->handleRequest(request);
+        }
+    }
+};
+
+/**
+ * @brief Range-matching handler used by long chains and the compiled table.
+ *
+ * Declares the half-open priority interval it accepts, which is what lets the
+ * chain be compiled; handling just counts, so benchmarks aren't I/O bound.
+ */
+class RangeHandler : public Handler
+{
+public:
+    RangeHandler(int low, int high) : m_low(low), m_high(high) {}
+
+    void handleRequest(int request) override
+    {
+        if (request >= m_low && request < m_high)
+        {
+            ++m_handled;
+        }
+        else if (m_nextHandler)
+        {
+            m_nextHandler->handleRequest(request);
+        }
+    }
+
+    int low() const { return m_low; }
+    int high() const { return m_high; }
+    std::size_t handled() const { return m_handled; }
+
+private:
+    int m_low;              ///< Inclusive lower bound of accepted requests.
+    int m_high;             ///< Exclusive upper bound of accepted requests.
+    std::size_t m_handled{0}; ///< Requests this handler processed.
+};
+
+/**
+ * @brief Chain compiled into a sorted interval table for direct dispatch.
+ *
+ * Handlers that declare a priority interval are indexed once at compile();
+ * dispatch() then binary-searches the table and jumps straight to the
+ * handling node — O(log n) instead of walking every earlier handler.
+ * Handlers with dynamic predicates are chained behind a fallback walk that
+ * runs only when no interval matches.
+ */
+class CompiledChain
+{
+public:
+    /**
+     * @brief Registers an interval-declaring handler.
+     */
+    void add(std::shared_ptr<RangeHandler> handler)
+    {
+        m_entries.push_back(Entry{handler->low(), handler->high(), std::move(handler)});
+        m_compiled = false;
+    }
+
+    /**
+     * @brief Sets the classic chain walked when no interval matches.
+     */
+    void setFallback(std::shared_ptr<Handler> fallback)
+    {
+        m_fallback = std::move(fallback);
+    }
+
+    /**
+     * @brief Sorts the interval table; call once after registration.
+     */
+    void compile()
+    {
+        std::sort(m_entries.begin(), m_entries.end(),
+                  [](const Entry& a, const Entry& b) { return a.low < b.low; });
+        m_compiled = true;
+    }
+
+    /**
+     * @brief Routes one request straight to its handler.
+     */
+    void dispatch(int request)
+    {
+        // Last interval whose lower bound is <= request.
+        auto it = std::upper_bound(m_entries.begin(), m_entries.end(), request,
+                                   [](int value, const Entry& entry) { return value < entry.low; });
+        if (it != m_entries.begin())
+        {
+            const Entry& entry = *(it - 1);
+            if (request < entry.high)
+            {
+                entry.handler->handleRequest(request);
+                return;
+            }
+        }
+        if (m_fallback)
+        {
+            m_fallback->handleRequest(request); // Dynamic predicates: classic walk.
+        }
+        else
+        {
+            std::cout << "No handler available for request: " << request << std::endl;
+        }
+    }
+
+    bool compiled() const { return m_compiled; }
+
+private:
+    /**
+     * @brief One interval table row.
+     */
+    struct Entry
+    {
+        int low;
+        int high;
+        std::shared_ptr<RangeHandler> handler;
+    };
+
+    std::vector<Entry> m_entries;        ///< Sorted by lower bound after compile().
+    std::shared_ptr<Handler> m_fallback; ///< Classic chain for dynamic predicates.
+    bool m_compiled{false};
+};
+
+/**
+ * @brief Main function demonstrating the Chain of Responsibility pattern.
  */
+int main()
+{
+    // Create handlers
+    std::shared_ptr<Handler> lowPriority = std::make_shared<LowPriorityHandler>();
+    std::shared_ptr<Handler> mediumPriority = std::make_shared<MediumPriorityHandler>();
+    std::shared_ptr<Handler> highPriority = std::make_shared<HighPriorityHandler>();
+
+    // Set up the chain
+    lowPriority->setNext(mediumPriority);
+    mediumPriority->setNext(highPriority);
+
+    // Process different requests
+    lowPriority->handleRequest(5);  // Handled by LowPriorityHandler
+    lowPriority->handleRequest(15); // Handled by MediumPriorityHandler
+    lowPriority->handleRequest(25); // Handled by HighPriorityHandler
+    lowPriority->handleRequest(30); // Handled by HighPriorityHandler
+
+    // Compiled dispatch: a 40-handler chain where most requests match late.
+    constexpr int handlerCount = 40;
+    constexpr int bandWidth = 10;
+
+    std::vector<std::shared_ptr<RangeHandler>> walkHandlers;
+    std::vector<std::shared_ptr<RangeHandler>> tableHandlers;
+    CompiledChain compiledChain;
+    for (int i = 0; i < handlerCount; ++i)
+    {
+        walkHandlers.push_back(std::make_shared<RangeHandler>(i * bandWidth, (i + 1) * bandWidth));
+        if (i > 0)
+        {
+            walkHandlers[i - 1]->setNext(walkHandlers[i]);
+        }
+        auto handler = std::make_shared<RangeHandler>(i * bandWidth, (i + 1) * bandWidth);
+        tableHandlers.push_back(handler);
+        compiledChain.add(handler);
+    }
+    compiledChain.compile();
+
+    constexpr int requests = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < requests; ++i)
+    {
+        walkHandlers.front()->handleRequest(i * 31 % (handlerCount * bandWidth));
+    }
+    double walkTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < requests; ++i)
+    {
+        compiledChain.dispatch(i * 31 % (handlerCount * bandWidth));
+    }
+    double tableTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::size_t walkHandled = 0;
+    std::size_t tableHandled = 0;
+    for (int i = 0; i < handlerCount; ++i)
+    {
+        walkHandled += walkHandlers[i]->handled();
+        tableHandled += tableHandlers[i]->handled();
+    }
+    std::cout << requests << " request(s) through " << handlerCount << " handlers: chain walk "
+              << walkTime << " ms, compiled table " << tableTime << " ms (handled "
+              << walkHandled << " / " << tableHandled << ")" << std::endl;
 
- #include <iostream>
- #include <memory>
- 
- /**
-  * @brief Abstract base class representing a request handler.
-  */
- class Handler
- {
- public:
-     virtual ~Handler() = default;
- 
-     /**
-      * @brief Sets the next handler in the chain.
-      * @param nextHandler Shared pointer to the next handler.
-      */
-     void setNext(std::shared_ptr<Handler> nextHandler)
-     {
-         m_nextHandler = nextHandler;
-     }
- 
-     /**
-      * @brief Handles a request, processing it or passing it to the next handler.
-      * @param request The request integer value.
-      */
-     virtual void handleRequest(int request)
-     {
-         if (m_nextHandler)
-         {
-             m_nextHandler->handleRequest(request);
-         }
-         else
-         {
-             std::cout << "No handler available for request: " << request << std::endl;
-         }
-     }
- 
- protected:
-     std::shared_ptr<Handler> m_nextHandler; ///< Pointer to the next handler in the chain.
- };
- 
- /**
-  * @brief Concrete handler for low-priority requests.
-  */
- class LowPriorityHandler : public Handler
- {
- public:
-     /**
-      * @brief Processes low-priority requests or passes them further.
-      * @param request The request integer value.
-      */
-     void handleRequest(int request) override
-     {
-         if (request < 10)
-         {
-             std::cout << "LowPriorityHandler processing request: " << request << std::endl;
-         }
-         else if (m_nextHandler)
-         {
-             m_nextHandler->handleRequest(request);
-         }
-     }
- };
- 
- /**
-  * @brief Concrete handler for medium-priority requests.
-  */
- class MediumPriorityHandler : public Handler
- {
- public:
-     /**
-      * @brief Processes medium-priority requests or passes them further.
-      * @param request The request integer value.
-      */
-     void handleRequest(int request) override
-     {
-         if (request >= 10 && request < 20)
-         {
-             std::cout << "MediumPriorityHandler processing request: " << request << std::endl;
-         }
-         else if (m_nextHandler)
-         {
-             m_nextHandler->handleRequest(request);
-         }
-     }
- };
- 
- /**
-  * @brief Concrete handler for high-priority requests.
-  */
- class HighPriorityHandler : public Handler
- {
- public:
-     /**
-      * @brief Processes high-priority requests.
-      * @param request The request integer value.
-      */
-     void handleRequest(int request) override
-     {
-         if (request >= 20)
-         {
-             std::cout << "HighPriorityHandler processing request: " << request << std::endl;
-         }
-         else if (m_nextHandler)
-         {
-             m_nextHandler->handleRequest(request);
-         }
-     }
- };
- 
- /**
-  * @brief Main function demonstrating the Chain of Responsibility pattern.
-  */
- int main()
- {
-     // Create handlers
-     std::shared_ptr<Handler> lowPriority = std::make_shared<LowPriorityHandler>();
-     std::shared_ptr<Handler> mediumPriority = std::make_shared<MediumPriorityHandler>();
-     std::shared_ptr<Handler> highPriority = std::make_shared<HighPriorityHandler>();
- 
-     // Set up the chain
-     lowPriority->setNext(mediumPriority);
-     mediumPriority->setNext(highPriority);
- 
-     // Process different requests
-     lowPriority->handleRequest(5);  // Handled by LowPriorityHandler
-     lowPriority->handleRequest(15); // Handled by MediumPriorityHandler
-     lowPriority->handleRequest(25); // Handled by HighPriorityHandler
-     lowPriority->handleRequest(30); // Handled by HighPriorityHandler
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
@@ -11,151 +11,297 @@
  * - **Decouples** input handling from game logic.
  * - Allows **dynamic keybinding** without modifying core logic.
  * - Supports **macro recording and replays**.
+ *
+ * One heap-allocated command object per input event causes frame spikes at server input
+ * rates. CommandRing records commands as tagged POD structs in a preallocated ring,
+ * executes each tick's window in one switch-dispatch loop, coalesces redundant
+ * consecutive commands (a held crouch is one record), and keeps executed records around
+ * so a recent window can be replayed for lag compensation.
+ */
+
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief Represents a player that can perform actions.
+ */
+class Player
+{
+public:
+    void jump() const
+    {
+        std::cout << "Player jumps!\n";
+    }
+
+    void shoot() const
+    {
+        std::cout << "Player shoots!\n";
+    }
+
+    void crouch() const
+    {
+        std::cout << "Player crouches!\n";
+    }
+};
+
+/**
+ * @brief Abstract command interface for game actions.
  */
+class GameCommand
+{
+public:
+    virtual ~GameCommand() = default;
+    virtual void execute() = 0;
+};
+
+/**
+ * @brief Command for making the player jump.
+ */
+class JumpCommand : public GameCommand
+{
+public:
+    explicit JumpCommand(std::shared_ptr<Player> player) : m_player(player) {}
+
+    void execute() override
+    {
+        m_player->jump();
+    }
+
+private:
+    std::shared_ptr<Player> m_player; ///< Reference to the player.
+};
+
+/**
+ * @brief Command for making the player shoot.
+ */
+class ShootCommand : public GameCommand
+{
+public:
+    explicit ShootCommand(std::shared_ptr<Player> player) : m_player(player) {}
+
+    void execute() override
+    {
+        m_player->shoot();
+    }
+
+private:
+    std::shared_ptr<Player> m_player; ///< Reference to the player.
+};
+
+/**
+ * @brief Command for making the player crouch.
+ */
+class CrouchCommand : public GameCommand
+{
+public:
+    explicit CrouchCommand(std::shared_ptr<Player> player) : m_player(player) {}
+
+    void execute() override
+    {
+        m_player->crouch();
+    }
+
+private:
+    std::shared_ptr<Player> m_player; ///< Reference to the player.
+};
+
+/**
+ * @brief Handles player input and executes mapped commands.
+ */
+class InputHandler
+{
+public:
+    /**
+     * @brief Binds a key to a command.
+     * @param key The input key.
+     * @param command The command to execute.
+     */
+    void bindCommand(char key, std::shared_ptr<GameCommand> command)
+    {
+        m_keyBindings[key] = command;
+    }
+
+    /**
+     * @brief Executes the command mapped to the given key.
+     * @param key The input key.
+     */
+    void handleInput(char key)
+    {
+        if (m_keyBindings.contains(key))
+        {
+            m_keyBindings[key]->execute();
+        }
+        else
+        {
+            std::cout << "No action bound to key: " << key << "\n";
+        }
+    }
+
+private:
+    std::unordered_map<char, std::shared_ptr<GameCommand>> m_keyBindings; ///< Maps keys to commands.
+};
+
+/**
+ * @brief Tagged POD command record; 8 bytes, no vtable, no allocation.
+ */
+struct CommandRecord
+{
+    enum class Action : std::uint8_t { Jump, Shoot, Crouch };
+
+    Action action;
+    std::uint8_t playerId;
+    std::uint16_t repeat;  ///< Coalesced count of identical consecutive commands.
+    std::uint32_t tick;    ///< Game tick the command was recorded on.
+};
+
+/**
+ * @brief Preallocated command ring with batch execution, coalescing and replay.
+ *
+ * record() appends POD records — a repeat of the previous record on the same
+ * tick just bumps its repeat counter. executeTick() dispatches the pending
+ * window with one switch per record. Executed records stay in the ring until
+ * overwritten, so replaySince() can re-execute a recent tick window for lag
+ * compensation.
+ */
+class CommandRing
+{
+public:
+    /**
+     * @brief Creates the ring.
+     * @param capacity Ring size; must be a power of two.
+     */
+    explicit CommandRing(std::size_t capacity)
+        : m_ring(capacity), m_mask(capacity - 1)
+    {
+    }
+
+    /**
+     * @brief Records one command, coalescing repeats within the same tick.
+     */
+    void record(CommandRecord::Action action, std::uint8_t playerId, std::uint32_t tick)
+    {
+        if (m_head > m_executedTo)
+        {
+            CommandRecord& last = m_ring[(m_head - 1) & m_mask];
+            if (last.action == action && last.playerId == playerId && last.tick == tick)
+            {
+                ++last.repeat; // Redundant consecutive command: one record.
+                ++m_coalesced;
+                return;
+            }
+        }
+        m_ring[m_head & m_mask] = CommandRecord{action, playerId, 1, tick};
+        ++m_head;
+    }
+
+    /**
+     * @brief Executes all pending records in one switch-dispatch loop.
+     */
+    void executeTick(Player& player)
+    {
+        for (std::uint64_t position = m_executedTo; position < m_head; ++position)
+        {
+            dispatch(m_ring[position & m_mask], player);
+        }
+        m_executedTo = m_head;
+    }
+
+    /**
+     * @brief Re-executes every record from tick onwards that is still in the ring.
+     * @return Number of records replayed.
+     */
+    std::size_t replaySince(std::uint32_t tick, Player& player)
+    {
+        std::uint64_t oldest = m_head > m_ring.size() ? m_head - m_ring.size() : 0;
+        std::size_t replayed = 0;
+        for (std::uint64_t position = oldest; position < m_executedTo; ++position)
+        {
+            const CommandRecord& command = m_ring[position & m_mask];
+            if (command.tick >= tick)
+            {
+                dispatch(command, player);
+                ++replayed;
+            }
+        }
+        return replayed;
+    }
+
+    std::size_t coalesced() const { return m_coalesced; }
+    std::uint64_t recorded() const { return m_head; }
+
+private:
+    /**
+     * @brief Switch dispatch: one branch, repeat-aware, no virtual call.
+     */
+    static void dispatch(const CommandRecord& command, Player& player)
+    {
+        for (std::uint16_t i = 0; i < command.repeat; ++i)
+        {
+            switch (command.action)
+            {
+                case CommandRecord::Action::Jump:
+                    player.jump();
+                    break;
+                case CommandRecord::Action::Shoot:
+                    player.shoot();
+                    break;
+                case CommandRecord::Action::Crouch:
+                    player.crouch();
+                    break;
+            }
+        }
+    }
+
+    std::vector<CommandRecord> m_ring; ///< Preallocated POD command storage.
+    std::size_t m_mask;                ///< capacity - 1 for cheap wrapping.
+    std::uint64_t m_head{0};           ///< Next record position.
+    std::uint64_t m_executedTo{0};     ///< Ring position of the last executed tick.
+    std::size_t m_coalesced{0};        ///< Commands folded into repeat counters.
+};
+
+/**
+ * @brief Demonstrates the Game Input System using the Command Pattern.
+ */
+int main()
+{
+    auto player = std::make_shared<Player>();
+    auto inputHandler = std::make_shared<InputHandler>();
+
+    // Bind keys to commands
+    inputHandler->bindCommand('w', std::make_shared<JumpCommand>(player));
+    inputHandler->bindCommand('s', std::make_shared<CrouchCommand>(player));
+    inputHandler->bindCommand('f', std::make_shared<ShootCommand>(player));
+
+    // Simulated user input
+    std::cout << "Press 'w' to Jump, 's' to Crouch, 'f' to Shoot, 'x' for an unbound key.\n";
+    for (char input : {'w', 's', 'f', 'x'})  // Example key presses
+    {
+        inputHandler->handleInput(input);
+    }
+
+    // POD command ring: batch execution per tick with coalescing and replay.
+    CommandRing ring(64);
+    ring.record(CommandRecord::Action::Jump, 0, 1);
+    ring.record(CommandRecord::Action::Crouch, 0, 1);
+    ring.record(CommandRecord::Action::Crouch, 0, 1); // Held key: coalesced.
+    ring.record(CommandRecord::Action::Crouch, 0, 1);
+    std::cout << "\nTick 1 batch:\n";
+    ring.executeTick(*player);
+
+    ring.record(CommandRecord::Action::Shoot, 0, 2);
+    std::cout << "Tick 2 batch:\n";
+    ring.executeTick(*player);
+
+    std::cout << "Recorded " << ring.recorded() << " record(s), coalesced "
+              << ring.coalesced() << " repeat(s)\n";
+
+    // Lag compensation: re-run everything from tick 2 that is still in the ring.
+    std::cout << "Replaying from tick 2:\n";
+    std::size_t replayed = ring.replaySince(2, *player);
+    std::cout << "Replayed " << replayed << " record(s)\n";
 
- #include <iostream>
- #include <memory>
- #include <unordered_map>
- 
- /**
-  * @brief Represents a player that can perform actions.
-  */
- class Player
- {
- public:
-     void jump() const
-     {
-         std::cout << "Player jumps!\n";
-     }
- 
-     void shoot() const
-     {
-         std::cout << "Player shoots!\n";
-     }
- 
-     void crouch() const
-     {
-         std::cout << "Player crouches!\n";
-     }
- };
- 
- /**
-  * @brief Abstract command interface for game actions.
-  */
- class GameCommand
- {
- public:
-     virtual ~GameCommand() = default;
-     virtual void execute() = 0;
- };
- 
- /**
-  * @brief Command for making the player jump.
-  */
- class JumpCommand : public GameCommand
- {
- public:
-     explicit JumpCommand(std::shared_ptr<Player> player) : m_player(player) {}
- 
-     void execute() override
-     {
-         m_player->jump();
-     }
- 
- private:
-     std::shared_ptr<Player> m_player; ///< Reference to the player.
- };
- 
- /**
-  * @brief Command for making the player shoot.
-  */
- class ShootCommand : public GameCommand
- {
- public:
-     explicit ShootCommand(std::shared_ptr<Player> player) : m_player(player) {}
- 
-     void execute() override
-     {
-         m_player->shoot();
-     }
- 
- private:
-     std::shared_ptr<Player> m_player; ///< Reference to the player.
- };
- 
- /**
-  * @brief Command for making the player crouch.
-  */
- class CrouchCommand : public GameCommand
- {
- public:
-     explicit CrouchCommand(std::shared_ptr<Player> player) : m_player(player) {}
- 
-     void execute() override
-     {
-         m_player->crouch();
-     }
- 
- private:
-     std::shared_ptr<Player> m_player; ///< Reference to the player.
- };
- 
- /**
-  * @brief Handles player input and executes mapped commands.
-  */
- class InputHandler
- {
- public:
-     /**
-      * @brief Binds a key to a command.
-      * @param key The input key.
-      * @param command The command to execute.
-      */
-     void bindCommand(char key, std::shared_ptr<GameCommand> command)
-     {
-         m_keyBindings[key] = command;
-     }
- 
-     /**
-      * @brief Executes the command mapped to the given key.
-      * @param key The input key.
-      */
-     void handleInput(char key)
-     {
-         if (m_keyBindings.contains(key))
-         {
-             m_keyBindings[key]->execute();
-         }
-         else
-         {
-             std::cout << "No action bound to key: " << key << "\n";
-         }
-     }
- 
- private:
-     std::unordered_map<char, std::shared_ptr<GameCommand>> m_keyBindings; ///< Maps keys to commands.
- };
- 
- /**
-  * @brief Demonstrates the Game Input System using the Command Pattern.
-  */
- int main()
- {
-     auto player = std::make_shared<Player>();
-     auto inputHandler = std::make_shared<InputHandler>();
- 
-     // Bind keys to commands
-     inputHandler->bindCommand('w', std::make_shared<JumpCommand>(player));
-     inputHandler->bindCommand('s', std::make_shared<CrouchCommand>(player));
-     inputHandler->bindCommand('f', std::make_shared<ShootCommand>(player));
- 
-     // Simulated user input
-     std::cout << "Press 'w' to Jump, 's' to Crouch, 'f' to Shoot, 'x' for an unbound key.\n";
-     for (char input : {'w', 's', 'f', 'x'})  // Example key presses
-     {
-         inputHandler->handleInput(input);
-     }
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
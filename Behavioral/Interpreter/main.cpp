@@ -3,107 +3,261 @@
  *
  * This example demonstrates how to use the Interpreter Pattern with C++23 features such as shared_ptr, auto, and other syntax sugar.
  * It uses member variables prefixed with 'm_' for better readability and maintains ownership through smart pointers.
+ *
+ * Beyond classic tree walking, the example includes a compile step that flattens the
+ * expression tree into compact postfix bytecode evaluated by a tight switch loop over
+ * contiguous storage — no virtual dispatch and no pointer chasing on the hot path.
+ */
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Abstract base class for all expressions.
+ */
+class Expression {
+public:
+    virtual ~Expression() = default;
+    virtual void Interpret() const = 0; // Pure virtual method
+    virtual int Evaluate() const = 0;   // Computes the value by walking the tree
+};
+
+/**
+ * @brief Concrete implementation of the expression "Number".
+ */
+class Number : public Expression {
+private:
+    int m_value;
+
+public:
+    explicit Number(int value) : m_value(value) {}
+
+    void Interpret() const override {
+        std::cout << "Number: " << m_value << std::endl;
+    }
+
+    int Evaluate() const override {
+        return m_value;
+    }
+
+    int Value() const { return m_value; }
+};
+
+/**
+ * @brief Concrete implementation of the expression "Add".
+ */
+class Add : public Expression {
+private:
+    std::shared_ptr<Expression> m_left;
+    std::shared_ptr<Expression> m_right;
+
+public:
+    explicit Add(std::shared_ptr<Expression> left, std::shared_ptr<Expression> right)
+        : m_left(left), m_right(right) {}
+
+    void Interpret() const override {
+        std::cout << "Adding... ";
+        m_left->Interpret();
+        m_right->Interpret();
+    }
+
+    int Evaluate() const override {
+        return m_left->Evaluate() + m_right->Evaluate();
+    }
+
+    const Expression& Left() const { return *m_left; }
+    const Expression& Right() const { return *m_right; }
+};
+
+/**
+ * @brief Concrete implementation of the expression "Subtract".
+ */
+class Subtract : public Expression {
+private:
+    std::shared_ptr<Expression> m_left;
+    std::shared_ptr<Expression> m_right;
+
+public:
+    explicit Subtract(std::shared_ptr<Expression> left, std::shared_ptr<Expression> right)
+        : m_left(left), m_right(right) {}
+
+    void Interpret() const override {
+        std::cout << "Subtracting... ";
+        m_left->Interpret();
+        m_right->Interpret();
+    }
+
+    int Evaluate() const override {
+        return m_left->Evaluate() - m_right->Evaluate();
+    }
+
+    const Expression& Left() const { return *m_left; }
+    const Expression& Right() const { return *m_right; }
+};
+
+/**
+ * @brief Bytecode operations produced by the compile step.
  */
+enum class OpCode : std::uint8_t {
+    Push,     ///< Push the immediate operand onto the value stack.
+    Add,      ///< Pop two values, push their sum.
+    Subtract  ///< Pop two values, push their difference.
+};
+
+/**
+ * @brief One fixed-size bytecode instruction.
+ */
+struct Instruction {
+    OpCode op;
+    int operand; ///< Immediate value; only meaningful for Push.
+};
+
+/**
+ * @brief Flattened postfix program evaluated without touching the tree.
+ *
+ * Instructions live in one contiguous vector, so evaluation is a linear
+ * scan with a switch — no virtual calls, no shared_ptr dereferences.
+ */
+class CompiledExpression {
+public:
+    /**
+     * @brief Evaluates the bytecode with a tight switch loop.
+     */
+    int Evaluate() const {
+        m_stack.clear();
+        for (const Instruction& instruction : m_code) {
+            switch (instruction.op) {
+                case OpCode::Push:
+                    m_stack.push_back(instruction.operand);
+                    break;
+                case OpCode::Add: {
+                    int right = m_stack.back(); m_stack.pop_back();
+                    m_stack.back() += right;
+                    break;
+                }
+                case OpCode::Subtract: {
+                    int right = m_stack.back(); m_stack.pop_back();
+                    m_stack.back() -= right;
+                    break;
+                }
+            }
+        }
+        return m_stack.back();
+    }
+
+    void Emit(Instruction instruction) {
+        m_code.push_back(instruction);
+    }
+
+    std::size_t Size() const { return m_code.size(); }
+
+private:
+    std::vector<Instruction> m_code;    ///< Contiguous postfix program.
+    mutable std::vector<int> m_stack;   ///< Reused evaluation stack.
+};
+
+/**
+ * @brief The Client class that builds, compiles and executes the expression.
+ */
+class Interpreter {
+private:
+    std::shared_ptr<Expression> m_expression;
+
+public:
+    void SetExpression(std::shared_ptr<Expression> expression) {
+        m_expression = expression;
+    }
+
+    void Interpret() const {
+        if (m_expression) {
+            m_expression->Interpret();
+        } else {
+            std::cout << "No expression set to interpret." << std::endl;
+        }
+    }
+
+    int Evaluate() const {
+        return m_expression ? m_expression->Evaluate() : 0;
+    }
+
+    /**
+     * @brief Flattens the expression tree into postfix bytecode.
+     * @return The compiled program, ready for repeated evaluation.
+     */
+    CompiledExpression Compile() const {
+        CompiledExpression compiled;
+        if (m_expression) {
+            CompileNode(*m_expression, compiled);
+        }
+        return compiled;
+    }
+
+private:
+    /**
+     * @brief Emits children first, then the operator — classic postfix.
+     */
+    static void CompileNode(const Expression& node, CompiledExpression& compiled) {
+        if (const auto* number = dynamic_cast<const Number*>(&node)) {
+            compiled.Emit({OpCode::Push, number->Value()});
+        } else if (const auto* add = dynamic_cast<const Add*>(&node)) {
+            CompileNode(add->Left(), compiled);
+            CompileNode(add->Right(), compiled);
+            compiled.Emit({OpCode::Add, 0});
+        } else if (const auto* subtract = dynamic_cast<const Subtract*>(&node)) {
+            CompileNode(subtract->Left(), compiled);
+            CompileNode(subtract->Right(), compiled);
+            compiled.Emit({OpCode::Subtract, 0});
+        }
+    }
+};
+
+/**
+ * @brief Times repeated evaluation of the tree walk against the bytecode.
+ */
+void Benchmark(const Interpreter& interpreter, const CompiledExpression& compiled) {
+    constexpr int iterations = 1000000;
+    volatile int sink = 0; // Prevents the loops from being optimized away.
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sink = interpreter.Evaluate();
+    }
+    auto treeTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sink = compiled.Evaluate();
+    }
+    auto bytecodeTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Benchmark over " << iterations << " evaluations:\n"
+              << "  tree walk: " << treeTime << " ms\n"
+              << "  bytecode:  " << bytecodeTime << " ms\n";
+    (void)sink;
+}
+
+int main() {
+    // Create the expression: ((5 + 3) - 2)
+    auto five = std::make_shared<Number>(5);
+    auto three = std::make_shared<Number>(3);
+    auto two = std::make_shared<Number>(2);
+
+    auto addFiveThree = std::make_shared<Add>(five, three);
+    auto subtractResultFromTwo = std::make_shared<Subtract>(addFiveThree, two);
+
+    Interpreter interpreter;
+    interpreter.SetExpression(subtractResultFromTwo);
+    interpreter.Interpret();
+
+    // Compile once, evaluate many times.
+    auto compiled = interpreter.Compile();
+    std::cout << "Compiled to " << compiled.Size() << " instruction(s)\n";
+    std::cout << "Tree result: " << interpreter.Evaluate() << ", bytecode result: " << compiled.Evaluate() << std::endl;
+
+    Benchmark(interpreter, compiled);
 
- #include <iostream>
- #include <memory>
- #include <vector>
- 
- /**
-  * @brief Abstract base class for all expressions.
-  */
- class Expression {
- public:
-     virtual ~Expression() = default;
-     virtual void Interpret() const = 0; // Pure virtual method
- };
- 
- /**
-  * @brief Concrete implementation of the expression "Number".
-  */
- class Number : public Expression {
- private:
-     int m_value;
- 
- public:
-     explicit Number(int value) : m_value(value) {}
- 
-     void Interpret() const override {
-         std::cout << "Number: " << m_value << std::endl;
-     }
- };
- 
- /**
-  * @brief Concrete implementation of the expression "Add".
-  */
- class Add : public Expression {
- private:
-     std::shared_ptr<Expression> m_left;
-     std::shared_ptr<Expression> m_right;
- 
- public:
-     explicit Add(std::shared_ptr<Expression> left, std::shared_ptr<Expression> right)
-         : m_left(left), m_right(right) {}
- 
-     void Interpret() const override {
-         std::cout << "Adding... ";
-         m_left->Interpret();
-         m_right->Interpret();
-     }
- };
- 
- /**
-  * @brief Concrete implementation of the expression "Subtract".
-  */
- class Subtract : public Expression {
- private:
-     std::shared_ptr<Expression> m_left;
-     std::shared_ptr<Expression> m_right;
- 
- public:
-     explicit Subtract(std::shared_ptr<Expression> left, std::shared_ptr<Expression> right)
-         : m_left(left), m_right(right) {}
- 
-     void Interpret() const override {
-         std::cout << "Subtracting... ";
-         m_left->Interpret();
-         m_right->Interpret();
-     }
- };
- 
- /**
-  * @brief The Client class that builds and executes the expression.
-  */
- class Interpreter {
- private:
-     std::shared_ptr<Expression> m_expression;
- 
- public:
-     void SetExpression(std::shared_ptr<Expression> expression) {
-         m_expression = expression;
-     }
- 
-     void Interpret() const {
-         if (m_expression) {
-             m_expression->Interpret();
-         } else {
-             std::cout << "No expression set to interpret." << std::endl;
-         }
-     }
- };
- 
- int main() {
-     // Create the expression: ((5 + 3) - 2)
-     auto five = std::make_shared<Number>(5);
-     auto three = std::make_shared<Number>(3);
-     auto two = std::make_shared<Number>(2);
- 
-     auto addFiveThree = std::make_shared<Add>(five, three);
-     auto subtractResultFromTwo = std::make_shared<Subtract>(addFiveThree, two);
- 
-     Interpreter interpreter;
-     interpreter.SetExpression(subtractResultFromTwo);
-     interpreter.Interpret();
- 
-     return 0;
- }
\ No newline at end of file
+    return 0;
+}
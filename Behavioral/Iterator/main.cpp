@@ -11,95 +11,275 @@
  * - Encapsulates iteration logic, separating it from the collection.
  * - Allows multiple ways to iterate over a collection.
  * - Supports variations like reverse iteration or filtering.
+ *
+ * Copying each word into a std::string during iteration is the entire cost on large
+ * corpora. TextCorpus below holds the whole text as one contiguous buffer with a
+ * prebuilt offset index and iterates with std::string_view — zero copies, zero
+ * allocations per word. Its iterator is random-access (and therefore bidirectional),
+ * so standard algorithms work directly, and the index is built lazily on first use
+ * to keep loading cheap.
+ */
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <iterator>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Iterator interface for traversing a collection.
+ */
+class Iterator
+{
+public:
+    virtual ~Iterator() = default;
+    virtual bool hasNext() const = 0;
+    virtual std::string next() = 0;
+};
+
+/**
+ * @brief Concrete iterator for iterating over words in a collection.
+ */
+class WordIterator : public Iterator
+{
+public:
+    WordIterator(const std::vector<std::string>& words)
+        : m_words(words), m_index(0) {}
+
+    bool hasNext() const override
+    {
+        return m_index < m_words.size();
+    }
+
+    std::string next() override
+    {
+        return hasNext() ? m_words[m_index++] : "";
+    }
+
+private:
+    const std::vector<std::string>& m_words; ///< Reference to the word list.
+    size_t m_index; ///< Current position in the collection.
+};
+
+/**
+ * @brief Interface for a collection that can create an iterator.
+ */
+class IterableCollection
+{
+public:
+    virtual ~IterableCollection() = default;
+    virtual std::shared_ptr<Iterator> createIterator() const = 0;
+};
+
+/**
+ * @brief Concrete collection storing words and providing an iterator.
+ */
+class WordCollection : public IterableCollection
+{
+public:
+    void addWord(const std::string& word)
+    {
+        m_words.push_back(word);
+    }
+
+    std::shared_ptr<Iterator> createIterator() const override
+    {
+        return std::make_shared<WordIterator>(m_words);
+    }
+
+private:
+    std::vector<std::string> m_words; ///< Storage for words.
+};
+
+/**
+ * @brief Zero-copy word collection over one contiguous text buffer.
+ *
+ * The corpus owns the raw text exactly once. Word boundaries live in an
+ * offset/length index built lazily on the first traversal, and iteration
+ * yields std::string_view slices of the buffer — no per-word allocation.
  */
+class TextCorpus
+{
+public:
+    explicit TextCorpus(std::string text)
+        : m_text(std::move(text))
+    {}
+
+    /**
+     * @brief Random-access iterator yielding string_view slices.
+     *
+     * Random access implies bidirectional, so reverse traversal and any
+     * standard algorithm over the corpus work out of the box.
+     */
+    class iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = std::string_view;
+
+        iterator() = default;
+        iterator(const TextCorpus* corpus, std::size_t index) : m_corpus(corpus), m_index(index) {}
+
+        reference operator*() const { return m_corpus->word(m_index); }
+        reference operator[](difference_type offset) const { return m_corpus->word(m_index + offset); }
+
+        iterator& operator++() { ++m_index; return *this; }
+        iterator operator++(int) { iterator old = *this; ++m_index; return old; }
+        iterator& operator--() { --m_index; return *this; }
+        iterator operator--(int) { iterator old = *this; --m_index; return old; }
+        iterator& operator+=(difference_type offset) { m_index += offset; return *this; }
+        iterator& operator-=(difference_type offset) { m_index -= offset; return *this; }
+        friend iterator operator+(iterator it, difference_type offset) { return it += offset; }
+        friend iterator operator+(difference_type offset, iterator it) { return it += offset; }
+        friend iterator operator-(iterator it, difference_type offset) { return it -= offset; }
+        friend difference_type operator-(const iterator& a, const iterator& b)
+        {
+            return static_cast<difference_type>(a.m_index) - static_cast<difference_type>(b.m_index);
+        }
+        friend bool operator==(const iterator& a, const iterator& b) { return a.m_index == b.m_index; }
+        friend auto operator<=>(const iterator& a, const iterator& b) { return a.m_index <=> b.m_index; }
+
+    private:
+        const TextCorpus* m_corpus{nullptr};
+        std::size_t m_index{0};
+    };
+
+    /// @brief First word; builds the offset index if this is the first traversal.
+    iterator begin() const
+    {
+        ensureIndexed();
+        return iterator(this, 0);
+    }
+
+    /// @brief Past-the-end position.
+    iterator end() const
+    {
+        ensureIndexed();
+        return iterator(this, m_offsets.size());
+    }
+
+    /// @brief Number of words; triggers lazy indexing.
+    std::size_t size() const
+    {
+        ensureIndexed();
+        return m_offsets.size();
+    }
+
+    /// @brief Random access to one word as a view into the shared buffer.
+    std::string_view word(std::size_t index) const
+    {
+        return std::string_view(m_text).substr(m_offsets[index], m_lengths[index]);
+    }
+
+    bool indexed() const { return m_indexed; }
+
+private:
+    /**
+     * @brief Scans the buffer once and records word offsets and lengths.
+     *
+     * Deferred until the first traversal so that constructing a corpus from
+     * a multi-gigabyte load is just a buffer move.
+     */
+    void ensureIndexed() const
+    {
+        if (m_indexed)
+        {
+            return;
+        }
+        std::size_t begin = std::string::npos;
+        for (std::size_t i = 0; i <= m_text.size(); ++i)
+        {
+            bool separator = i == m_text.size() || m_text[i] == ' ' || m_text[i] == '\n';
+            if (!separator && begin == std::string::npos)
+            {
+                begin = i;
+            }
+            else if (separator && begin != std::string::npos)
+            {
+                m_offsets.push_back(static_cast<std::uint32_t>(begin));
+                m_lengths.push_back(static_cast<std::uint32_t>(i - begin));
+                begin = std::string::npos;
+            }
+        }
+        m_indexed = true;
+    }
+
+    std::string m_text;                           ///< The whole corpus, owned once.
+    mutable std::vector<std::uint32_t> m_offsets; ///< Word start offsets into m_text.
+    mutable std::vector<std::uint32_t> m_lengths; ///< Word lengths, parallel to m_offsets.
+    mutable bool m_indexed{false};                ///< Whether the lazy index exists yet.
+};
+
+/**
+ * @brief Demonstrates iteration over a word collection using the Iterator pattern.
+ */
+int main()
+{
+    auto collection = std::make_shared<WordCollection>();
+    collection->addWord("Hello");
+    collection->addWord("World");
+    collection->addWord("!");
+
+    auto iterator = collection->createIterator();
+    while (iterator->hasNext())
+    {
+        std::cout << iterator->next() << " ";
+    }
+    std::cout << "\n";
+
+    // Zero-copy mode: one buffer, lazy index, string_view iteration.
+    constexpr int wordCount = 2000000;
+    std::string text;
+    text.reserve(wordCount * 8);
+    auto copyingCollection = std::make_shared<WordCollection>();
+    for (int i = 0; i < wordCount; ++i)
+    {
+        // Tokens longer than the small-string buffer, as in real corpora.
+        std::string word = "corpus-identifier-token-" + std::to_string(i % 1000);
+        text += word;
+        text += ' ';
+        copyingCollection->addWord(word);
+    }
+    TextCorpus corpus(std::move(text)); // No index yet: loading is a buffer move.
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t copiedChars = 0;
+    auto copying = copyingCollection->createIterator();
+    while (copying->hasNext())
+    {
+        copiedChars += copying->next().size(); // Each next() allocates a std::string.
+    }
+    double copyTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    corpus.size(); // First use builds the index lazily.
+    double indexTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    std::size_t viewedChars = 0;
+    for (std::string_view word : corpus)
+    {
+        viewedChars += word.size();
+    }
+    double viewTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Random access and bidirectionality: standard algorithms just work.
+    auto longest = std::max_element(corpus.begin(), corpus.end(),
+                                    [](std::string_view a, std::string_view b) { return a.size() < b.size(); });
+    std::string_view lastWord = *std::prev(corpus.end());
+
+    std::cout << corpus.size() << " word(s): copying iteration " << copyTime
+              << " ms, zero-copy " << viewTime << " ms (+ " << indexTime
+              << " ms one-time lazy index, " << copiedChars << " / " << viewedChars << " chars)\n";
+    std::cout << "Longest word at position " << (longest - corpus.begin())
+              << ", last word \"" << lastWord << "\"\n";
 
- #include <iostream>
- #include <vector>
- #include <memory>
- #include <string>
- 
- /**
-  * @brief Iterator interface for traversing a collection.
-  */
- class Iterator
- {
- public:
-     virtual ~Iterator() = default;
-     virtual bool hasNext() const = 0;
-     virtual std::string next() = 0;
- };
- 
- /**
-  * @brief Concrete iterator for iterating over words in a collection.
-  */
- class WordIterator : public Iterator
- {
- public:
-     WordIterator(const std::vector<std::string>& words)
-         : m_words(words), m_index(0) {}
- 
-     bool hasNext() const override
-     {
-         return m_index < m_words.size();
-     }
- 
-     std::string next() override
-     {
-         return hasNext() ? m_words[m_index++] : "";
-     }
- 
- private:
-     const std::vector<std::string>& m_words; ///< Reference to the word list.
-     size_t m_index; ///< Current position in the collection.
- };
- 
- /**
-  * @brief Interface for a collection that can create an iterator.
-  */
- class IterableCollection
- {
- public:
-     virtual ~IterableCollection() = default;
-     virtual std::shared_ptr<Iterator> createIterator() const = 0;
- };
- 
- /**
-  * @brief Concrete collection storing words and providing an iterator.
-  */
- class WordCollection : public IterableCollection
- {
- public:
-     void addWord(const std::string& word)
-     {
-         m_words.push_back(word);
-     }
- 
-     std::shared_ptr<Iterator> createIterator() const override
-     {
-         return std::make_shared<WordIterator>(m_words);
-     }
- 
- private:
-     std::vector<std::string> m_words; ///< Storage for words.
- };
- 
- /**
-  * @brief Demonstrates iteration over a word collection using the Iterator pattern.
-  */
- int main()
- {
-     auto collection = std::make_shared<WordCollection>();
-     collection->addWord("Hello");
-     collection->addWord("World");
-     collection->addWord("!");
- 
-     auto iterator = collection->createIterator();
-     while (iterator->hasNext())
-     {
-         std::cout << iterator->next() << " ";
-     }
-     std::cout << "\n";
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
@@ -10,137 +10,351 @@
  * - Decouples communication logic from individual objects.
  * - Centralizes communication to simplify object interaction.
  * - Makes it easier to modify communication rules without changing participants.
+ *
+ * Delivering each message by scanning every registered user in one critical section
+ * serializes broadcast storms in large rooms. ShardedChatroom partitions members into
+ * shards fanned out by a worker pool; each message is allocated once and recipients
+ * share the immutable refcounted payload, landing in per-member bounded mailboxes.
+ * Per-shard delivery counters make hotspots visible.
+ */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <span>
+#include <array>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @brief Forward declaration of User.
+ */
+class User;
+
+/**
+ * @brief Interface for chatroom mediators.
+ */
+class ChatMediator
+{
+public:
+    virtual ~ChatMediator() = default;
+
+    /**
+     * @brief Registers a user in the chatroom.
+     * @param user The user to register.
+     */
+    virtual void registerUser(std::shared_ptr<User> user) = 0;
+
+    /**
+     * @brief Sends a message from one user to all others.
+     * @param sender The user sending the message.
+     * @param message The message to send.
+     */
+    virtual void sendMessage(const std::string& sender, const std::string& message) = 0;
+};
+
+/**
+ * @brief Represents a user in the chatroom.
+ */
+class User
+{
+public:
+    User(std::string name, std::shared_ptr<ChatMediator> mediator)
+        : m_name(std::move(name)), m_mediator(std::move(mediator)) {}
+
+    /**
+     * @brief Sends a message through the mediator.
+     * @param message The message content.
+     */
+    void send(const std::string& message)
+    {
+        m_mediator->sendMessage(m_name, message);
+    }
+
+    /**
+     * @brief Receives a message from the chatroom.
+     * @param sender The name of the sender.
+     * @param message The message content.
+     */
+    void receive(const std::string& sender, const std::string& message)
+    {
+        std::cout << "[" << m_name << "] received from " << sender << ": " << message << "\n";
+    }
+
+    /**
+     * @brief Gets the user's name.
+     * @return The user's name.
+     */
+    std::string getName() const
+    {
+        return m_name;
+    }
+
+private:
+    std::string m_name; ///< The name of the user.
+    std::shared_ptr<ChatMediator> m_mediator; ///< Mediator for communication.
+};
+
+/**
+ * @brief Concrete mediator implementing a chatroom.
+ */
+class Chatroom : public ChatMediator
+{
+public:
+    /**
+     * @brief Registers a user in the chatroom.
+     * @param user The user to register.
+     */
+    void registerUser(std::shared_ptr<User> user) override
+    {
+        m_users[user->getName()] = user;
+    }
+
+    /**
+     * @brief Sends a message from one user to all others.
+     * @param sender The user sending the message.
+     * @param message The message to send.
+     */
+    void sendMessage(const std::string& sender, const std::string& message) override
+    {
+        for (auto& [name, user] : m_users)
+        {
+            if (name != sender)
+            {
+                user->receive(sender, message);
+            }
+        }
+    }
+
+private:
+    std::unordered_map<std::string, std::shared_ptr<User>> m_users; ///< Registered users.
+};
+
+/**
+ * @brief One immutable chat message, allocated once per broadcast.
+ *
+ * Every recipient's mailbox holds a shared_ptr to the same payload, so
+ * fan-out to 100k members costs one allocation, not one per recipient.
  */
+struct ChatMessage
+{
+    std::string sender;
+    std::string text;
+};
+
+using ChatMessagePtr = std::shared_ptr<const ChatMessage>;
+
+/**
+ * @brief Sharded mediator for very large rooms.
+ *
+ * Members are partitioned into SHARD_COUNT shards, each with its own lock,
+ * member storage, bounded mailboxes and delivery counters. Broadcasts fan
+ * out with one worker per shard, so a storm in one shard never serializes
+ * the others, and per-shard counters expose hotspots.
+ */
+class ShardedChatroom
+{
+public:
+    static constexpr std::size_t SHARD_COUNT = 8;      ///< Independent member partitions.
+    static constexpr std::size_t MAILBOX_CAPACITY = 16; ///< Messages retained per member.
+
+    /**
+     * @brief Registers a member and returns their id; id picks the shard.
+     */
+    std::size_t join(std::string name)
+    {
+        std::size_t id = m_nextId.fetch_add(1);
+        Shard& shard = m_shards[id % SHARD_COUNT];
+        std::lock_guard lock(shard.mutex);
+        shard.members.push_back(Member{id, std::move(name)});
+        return id;
+    }
+
+    /**
+     * @brief Broadcasts one message; single caller thread walks all shards.
+     */
+    void broadcast(std::string sender, std::string text)
+    {
+        auto message = std::make_shared<const ChatMessage>(ChatMessage{std::move(sender), std::move(text)});
+        for (Shard& shard : m_shards)
+        {
+            deliverToShard(shard, message);
+        }
+    }
+
+    /**
+     * @brief Broadcasts a batch with one worker per shard.
+     *
+     * Payloads are allocated once up front; each worker then owns exactly
+     * one shard for the whole batch, so delivery runs lock-uncontended and
+     * in parallel across shards.
+     */
+    void broadcastBatch(std::span<const std::pair<std::string, std::string>> messages)
+    {
+        std::vector<ChatMessagePtr> payloads;
+        payloads.reserve(messages.size());
+        for (const auto& [sender, text] : messages)
+        {
+            payloads.push_back(std::make_shared<const ChatMessage>(ChatMessage{sender, text}));
+        }
+        unsigned workerCount = std::min<unsigned>(SHARD_COUNT,
+                                                  std::max(2u, std::thread::hardware_concurrency()));
+        std::atomic<std::size_t> nextShard{0};
+        std::vector<std::thread> workers;
+        workers.reserve(workerCount);
+        for (unsigned t = 0; t < workerCount; ++t)
+        {
+            // Workers claim whole shards, so each shard's lock stays uncontended.
+            workers.emplace_back([this, &nextShard, &payloads]
+            {
+                for (std::size_t s = nextShard.fetch_add(1); s < SHARD_COUNT; s = nextShard.fetch_add(1))
+                {
+                    for (const ChatMessagePtr& payload : payloads)
+                    {
+                        deliverToShard(m_shards[s], payload);
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief Per-shard delivery counters for hotspot detection.
+     */
+    void printShardStats() const
+    {
+        std::cout << "Shard stats:";
+        for (std::size_t i = 0; i < SHARD_COUNT; ++i)
+        {
+            std::cout << " [" << i << ": " << m_shards[i].delivered.load() << " delivered, "
+                      << m_shards[i].dropped.load() << " dropped]";
+        }
+        std::cout << "\n";
+    }
+
+    std::size_t totalDelivered() const
+    {
+        std::size_t total = 0;
+        for (const Shard& shard : m_shards)
+        {
+            total += shard.delivered.load();
+        }
+        return total;
+    }
+
+private:
+    /**
+     * @brief One member with a bounded ring mailbox.
+     *
+     * Slots hold raw pointers into the shard's anchor ring: the shard keeps
+     * one shared_ptr per message alive for the last MAILBOX_CAPACITY
+     * broadcasts, so delivery is a plain pointer store per recipient with
+     * no refcount traffic, and a mailbox entry can never outlive its anchor.
+     */
+    struct Member
+    {
+        std::size_t id;
+        std::string name;
+        std::array<const ChatMessage*, MAILBOX_CAPACITY> mailbox{};
+        std::size_t head{0}; ///< Total messages ever enqueued; head % capacity writes next.
+    };
+
+    /**
+     * @brief One partition: its own lock, members and counters.
+     */
+    struct Shard
+    {
+        std::mutex mutex;
+        std::vector<Member> members;
+        std::array<ChatMessagePtr, MAILBOX_CAPACITY> anchors{}; ///< Keeps mailbox targets alive.
+        std::size_t anchorHead{0};
+        std::atomic<std::uint64_t> delivered{0};
+        std::atomic<std::uint64_t> dropped{0}; ///< Overwritten unread mailbox slots.
+    };
+
+    /**
+     * @brief Hands the shared payload to every member of one shard.
+     */
+    void deliverToShard(Shard& shard, const ChatMessagePtr& message)
+    {
+        std::lock_guard lock(shard.mutex);
+        shard.anchors[shard.anchorHead % MAILBOX_CAPACITY] = message; // One refcount bump per shard.
+        ++shard.anchorHead;
+        std::uint64_t droppedHere = 0;
+        for (Member& member : shard.members)
+        {
+            droppedHere += member.mailbox[member.head % MAILBOX_CAPACITY] != nullptr;
+            member.mailbox[member.head % MAILBOX_CAPACITY] = message.get(); // Pointer store only.
+            ++member.head;
+        }
+        shard.dropped.fetch_add(droppedHere, std::memory_order_relaxed);
+        shard.delivered.fetch_add(shard.members.size(), std::memory_order_relaxed);
+    }
+
+    std::array<Shard, SHARD_COUNT> m_shards; ///< Member partitions.
+    std::atomic<std::size_t> m_nextId{0};
+};
+
+/**
+ * @brief Demonstrates the chatroom system using the Mediator Pattern.
+ */
+int main()
+{
+    auto chatroom = std::make_shared<Chatroom>();
+
+    auto alice = std::make_shared<User>("Alice", chatroom);
+    auto bob = std::make_shared<User>("Bob", chatroom);
+    auto charlie = std::make_shared<User>("Charlie", chatroom);
+
+    chatroom->registerUser(alice);
+    chatroom->registerUser(bob);
+    chatroom->registerUser(charlie);
+
+    alice->send("Hello, everyone!");
+    bob->send("Hey Alice!");
+    charlie->send("Hi all!");
+
+    // Sharded fan-out: 100k members, broadcast storms run one worker per shard.
+    constexpr std::size_t memberCount = 100000;
+    constexpr int stormSize = 30;
+
+    ShardedChatroom bigRoom;
+    for (std::size_t i = 0; i < memberCount; ++i)
+    {
+        bigRoom.join("member" + std::to_string(i));
+    }
+
+    std::vector<std::pair<std::string, std::string>> storm;
+    for (int i = 0; i < stormSize; ++i)
+    {
+        storm.emplace_back("member" + std::to_string(i), "storm message " + std::to_string(i));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& [sender, text] : storm)
+    {
+        bigRoom.broadcast(sender, text);
+    }
+    double serialTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    bigRoom.broadcastBatch(storm);
+    double shardedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << memberCount << " member(s), " << stormSize << " broadcast(s): serial fan-out "
+              << serialTime << " ms, sharded pool " << shardedTime << " ms, "
+              << bigRoom.totalDelivered() << " total deliveries\n";
+    bigRoom.printShardStats();
 
- #include <iostream>
- #include <memory>
- #include <string>
- #include <vector>
- #include <unordered_map>
- 
- /**
-  * @brief Forward declaration of User.
-  */
- class User;
- 
- /**
-  * @brief Interface for chatroom mediators.
-  */
- class ChatMediator
- {
- public:
-     virtual ~ChatMediator() = default;
- 
-     /**
-      * @brief Registers a user in the chatroom.
-      * @param user The user to register.
-      */
-     virtual void registerUser(std::shared_ptr<User> user) = 0;
- 
-     /**
-      * @brief Sends a message from one user to all others.
-      * @param sender The user sending the message.
-      * @param message The message to send.
-      */
-     virtual void sendMessage(const std::string& sender, const std::string& message) = 0;
- };
- 
- /**
-  * @brief Represents a user in the chatroom.
-  */
- class User
- {
- public:
-     User(std::string name, std::shared_ptr<ChatMediator> mediator)
-         : m_name(std::move(name)), m_mediator(std::move(mediator)) {}
- 
-     /**
-      * @brief Sends a message through the mediator.
-      * @param message The message content.
-      */
-     void send(const std::string& message)
-     {
-         m_mediator->sendMessage(m_name, message);
-     }
- 
-     /**
-      * @brief Receives a message from the chatroom.
-      * @param sender The name of the sender.
-      * @param message The message content.
-      */
-     void receive(const std::string& sender, const std::string& message)
-     {
-         std::cout << "[" << m_name << "] received from " << sender << ": " << message << "\n";
-     }
- 
-     /**
-      * @brief Gets the user's name.
-      * @return The user's name.
-      */
-     std::string getName() const
-     {
-         return m_name;
-     }
- 
- private:
-     std::string m_name; ///< The name of the user.
-     std::shared_ptr<ChatMediator> m_mediator; ///< Mediator for communication.
- };
- 
- /**
-  * @brief Concrete mediator implementing a chatroom.
-  */
- class Chatroom : public ChatMediator
- {
- public:
-     /**
-      * @brief Registers a user in the chatroom.
-      * @param user The user to register.
-      */
-     void registerUser(std::shared_ptr<User> user) override
-     {
-         m_users[user->getName()] = user;
-     }
- 
-     /**
-      * @brief Sends a message from one user to all others.
-      * @param sender The user sending the message.
-      * @param message The message to send.
-      */
-     void sendMessage(const std::string& sender, const std::string& message) override
-     {
-         for (auto& [name, user] : m_users)
-         {
-             if (name != sender)
-             {
-                 user->receive(sender, message);
-             }
-         }
-     }
- 
- private:
-     std::unordered_map<std::string, std::shared_ptr<User>> m_users; ///< Registered users.
- };
- 
- /**
-  * @brief Demonstrates the chatroom system using the Mediator Pattern.
-  */
- int main()
- {
-     auto chatroom = std::make_shared<Chatroom>();
- 
-     auto alice = std::make_shared<User>("Alice", chatroom);
-     auto bob = std::make_shared<User>("Bob", chatroom);
-     auto charlie = std::make_shared<User>("Charlie", chatroom);
- 
-     chatroom->registerUser(alice);
-     chatroom->registerUser(bob);
-     chatroom->registerUser(charlie);
- 
-     alice->send("Hello, everyone!");
-     bob->send("Hey Alice!");
-     charlie->send("Hi all!");
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
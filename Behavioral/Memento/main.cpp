@@ -10,166 +10,368 @@
  * - Provides a way to save and restore an object's state without exposing its internal structure.
  * - Enables undo/redo functionality efficiently.
  * - Decouples state management from the main object.
+ *
+ * For large documents the classic full-copy memento is ruinous, so a delta-based history is
+ * included: each save stores only the reverse diff against the current state (O(change size)
+ * memory), a full checkpoint is kept every N edits to bound restore cost, and a configurable
+ * memory budget drops the oldest entries when the history grows past it.
+ */
+
+#include <iostream>
+#include <memory>
+#include <stack>
+#include <string>
+#include <deque>
+#include <algorithm>
+
+/**
+ * @brief Memento class that stores the state of the text editor.
+ */
+class EditorMemento
+{
+public:
+    explicit EditorMemento(std::string state) : m_state(std::move(state)) {}
+
+    /**
+     * @brief Retrieves the stored state.
+     * @return The stored text.
+     */
+    std::string getState() const
+    {
+        return m_state;
+    }
+
+private:
+    std::string m_state; ///< Stored text content.
+};
+
+/**
+ * @brief The Originator, representing a text editor.
+ */
+class TextEditor
+{
+public:
+    /**
+     * @brief Sets the text in the editor.
+     * @param text The new text.
+     */
+    void setText(const std::string& text)
+    {
+        m_text = text;
+    }
+
+    /**
+     * @brief Gets the current text.
+     * @return The current text in the editor.
+     */
+    std::string getText() const
+    {
+        return m_text;
+    }
+
+    /**
+     * @brief Saves the current state to a memento.
+     * @return A shared pointer to a memento storing the current state.
+     */
+    std::shared_ptr<EditorMemento> save() const
+    {
+        return std::make_shared<EditorMemento>(m_text);
+    }
+
+    /**
+     * @brief Restores the editor's state from a memento.
+     * @param memento The memento to restore from.
+     */
+    void restore(std::shared_ptr<EditorMemento> memento)
+    {
+        if (memento)
+        {
+            m_text = memento->getState();
+        }
+    }
+
+private:
+    std::string m_text; ///< Current text content in the editor.
+};
+
+/**
+ * @brief The Caretaker that manages undo/redo functionality.
  */
+class HistoryManager
+{
+public:
+    /**
+     * @brief Saves a snapshot of the editor's state.
+     * @param memento The memento storing the state.
+     */
+    void saveState(std::shared_ptr<EditorMemento> memento)
+    {
+        m_undoStack.push(memento);
+        m_redoStack = std::stack<std::shared_ptr<EditorMemento>>(); // Clear redo stack on new action
+    }
+
+    /**
+     * @brief Undoes the last change.
+     * @param editor The text editor to apply the undo operation on.
+     */
+    void undo(TextEditor& editor)
+    {
+        if (!m_undoStack.empty())
+        {
+            m_redoStack.push(editor.save());
+            editor.restore(m_undoStack.top());
+            m_undoStack.pop();
+        }
+    }
+
+    /**
+     * @brief Redoes the last undone change.
+     * @param editor The text editor to apply the redo operation on.
+     */
+    void redo(TextEditor& editor)
+    {
+        if (!m_redoStack.empty())
+        {
+            m_undoStack.push(editor.save());
+            editor.restore(m_redoStack.top());
+            m_redoStack.pop();
+        }
+    }
+
+private:
+    std::stack<std::shared_ptr<EditorMemento>> m_undoStack; ///< Stack of undo states.
+    std::stack<std::shared_ptr<EditorMemento>> m_redoStack; ///< Stack of redo states.
+};
+
+
+/**
+ * @brief Caretaker storing reverse diffs instead of full document copies.
+ *
+ * Each saved transition keeps only the changed span (offset, removed text,
+ * inserted text), so memory grows with edit size, not document size. Every
+ * checkpointInterval-th entry additionally stores the full prior state, which
+ * bounds the cost of restoring after the budget collapses older deltas. When
+ * the summed entry size exceeds the memory budget, the oldest entries are
+ * dropped — undo depth shrinks, the editor never breaks.
+ */
+class DeltaHistoryManager
+{
+public:
+    /**
+     * @brief Constructs the history manager.
+     * @param checkpointInterval Store a full checkpoint every N saves.
+     * @param memoryBudgetBytes Collapse oldest entries past this history size.
+     */
+    DeltaHistoryManager(std::size_t checkpointInterval = 16,
+                        std::size_t memoryBudgetBytes = 1024 * 1024)
+        : m_checkpointInterval(checkpointInterval), m_memoryBudget(memoryBudgetBytes)
+    {}
+
+    /**
+     * @brief Records the transition from the last saved state to the editor's current one.
+     * @param editor The editor whose state was just changed.
+     */
+    void saveState(const TextEditor& editor)
+    {
+        const std::string current = editor.getText();
+        Entry entry = makeDelta(m_lastSaved, current);
+        if (m_saveCount % m_checkpointInterval == 0)
+        {
+            entry.fullOld = m_lastSaved; // Periodic checkpoint: O(1) restore target.
+            entry.isCheckpoint = true;
+        }
+        ++m_saveCount;
+
+        m_historyBytes += entry.bytes();
+        m_undo.push_back(std::move(entry));
+        m_redo.clear();
+        m_lastSaved = current;
+
+        enforceBudget();
+    }
+
+    /**
+     * @brief Undoes the last change by applying its reverse diff.
+     * @param editor The text editor to apply the undo operation on.
+     */
+    void undo(TextEditor& editor)
+    {
+        if (m_undo.empty())
+        {
+            return;
+        }
+        Entry entry = std::move(m_undo.back());
+        m_undo.pop_back();
+        m_historyBytes -= entry.bytes();
+
+        std::string text = editor.getText();
+        if (entry.isCheckpoint)
+        {
+            text = entry.fullOld; // Checkpoint: restore directly.
+        }
+        else
+        {
+            text.replace(entry.offset, entry.inserted.size(), entry.removed);
+        }
+        editor.setText(text);
+        m_lastSaved = text;
+
+        m_historyBytes += entry.bytes();
+        m_redo.push_back(std::move(entry)); // Same entry replays forward for redo.
+    }
+
+    /**
+     * @brief Redoes the last undone change by replaying its forward diff.
+     * @param editor The text editor to apply the redo operation on.
+     */
+    void redo(TextEditor& editor)
+    {
+        if (m_redo.empty())
+        {
+            return;
+        }
+        Entry entry = std::move(m_redo.back());
+        m_redo.pop_back();
+        m_historyBytes -= entry.bytes();
+
+        std::string text = editor.getText();
+        text.replace(entry.offset, entry.removed.size(), entry.inserted);
+        editor.setText(text);
+        m_lastSaved = text;
+
+        m_historyBytes += entry.bytes();
+        m_undo.push_back(std::move(entry));
+    }
+
+    /**
+     * @brief Bytes currently held by the history (deltas plus checkpoints).
+     */
+    std::size_t historyBytes() const { return m_historyBytes; }
+
+    /**
+     * @brief Number of undo steps currently available.
+     */
+    std::size_t undoDepth() const { return m_undo.size(); }
+
+private:
+    /**
+     * @brief One saved transition; supports both undo and redo directions.
+     */
+    struct Entry
+    {
+        std::size_t offset{0};   ///< Where the change begins.
+        std::string removed;     ///< Text the edit removed (applied on undo).
+        std::string inserted;    ///< Text the edit inserted (applied on redo).
+        std::string fullOld;     ///< Complete prior state; checkpoints only.
+        bool isCheckpoint{false};
+
+        std::size_t bytes() const
+        {
+            return removed.size() + inserted.size() + fullOld.size() + sizeof(Entry);
+        }
+    };
+
+    /**
+     * @brief Computes the minimal changed span between two states.
+     */
+    static Entry makeDelta(const std::string& oldText, const std::string& newText)
+    {
+        std::size_t prefix = 0;
+        std::size_t maxPrefix = std::min(oldText.size(), newText.size());
+        while (prefix < maxPrefix && oldText[prefix] == newText[prefix])
+        {
+            ++prefix;
+        }
+        std::size_t suffix = 0;
+        std::size_t maxSuffix = std::min(oldText.size(), newText.size()) - prefix;
+        while (suffix < maxSuffix &&
+               oldText[oldText.size() - 1 - suffix] == newText[newText.size() - 1 - suffix])
+        {
+            ++suffix;
+        }
+
+        Entry entry;
+        entry.offset = prefix;
+        entry.removed = oldText.substr(prefix, oldText.size() - prefix - suffix);
+        entry.inserted = newText.substr(prefix, newText.size() - prefix - suffix);
+        return entry;
+    }
+
+    /**
+     * @brief Drops the oldest entries until the history fits the budget.
+     */
+    void enforceBudget()
+    {
+        while (m_historyBytes > m_memoryBudget && m_undo.size() > 1)
+        {
+            m_historyBytes -= m_undo.front().bytes();
+            m_undo.pop_front();
+        }
+    }
+
+    std::size_t m_checkpointInterval;
+    std::size_t m_memoryBudget;
+    std::deque<Entry> m_undo;   ///< Oldest at front, so the budget can trim there.
+    std::deque<Entry> m_redo;
+    std::string m_lastSaved;    ///< The state the next delta is computed against.
+    std::size_t m_saveCount{0};
+    std::size_t m_historyBytes{0};
+};
+
+/**
+ * @brief Demonstrates the text editor with undo/redo using the Memento Pattern.
+ */
+int main()
+{
+    TextEditor editor;
+    HistoryManager history;
+
+    editor.setText("Hello");
+    history.saveState(editor.save());
+
+    editor.setText("World");
+    history.saveState(editor.save());
+
+    editor.setText("!");
+    history.saveState(editor.save());
+
+    std::cout << "Current text: " << editor.getText() << "\n";
+
+    history.undo(editor);
+    std::cout << "After undo: " << editor.getText() << "\n";
+
+    history.undo(editor);
+    std::cout << "After undo: " << editor.getText() << "\n";
+
+    history.undo(editor);
+    std::cout << "After undo: " << editor.getText() << "\n";
+
+    history.redo(editor);
+    std::cout << "After redo: " << editor.getText() << "\n";
+
+    history.redo(editor);
+    std::cout << "After redo: " << editor.getText() << "\n";
+
+    // Delta-based history: large document, small edits, small history.
+    TextEditor bigEditor;
+    DeltaHistoryManager deltaHistory(4, 64 * 1024);
+
+    std::string document(100000, 'x'); // A large document...
+    bigEditor.setText(document);
+    deltaHistory.saveState(bigEditor);
+
+    bigEditor.setText(document + " appended line");   // ...with small edits.
+    deltaHistory.saveState(bigEditor);
+    bigEditor.setText(document + " appended line twice");
+    deltaHistory.saveState(bigEditor);
+
+    std::cout << "Delta history for a " << document.size() << "-byte document: "
+              << deltaHistory.historyBytes() << " bytes, depth " << deltaHistory.undoDepth() << "\n";
+
+    deltaHistory.undo(bigEditor);
+    std::cout << "Delta undo tail: ..." << bigEditor.getText().substr(bigEditor.getText().size() - 14) << "\n";
+    deltaHistory.redo(bigEditor);
+    std::cout << "Delta redo tail: ..." << bigEditor.getText().substr(bigEditor.getText().size() - 14) << "\n";
 
- #include <iostream>
- #include <memory>
- #include <stack>
- #include <string>
- 
- /**
-  * @brief Memento class that stores the state of the text editor.
-  */
- class EditorMemento
- {
- public:
-     explicit EditorMemento(std::string state) : m_state(std::move(state)) {}
- 
-     /**
-      * @brief Retrieves the stored state.
-      * @return The stored text.
-      */
-     std::string getState() const
-     {
-         return m_state;
-     }
- 
- private:
-     std::string m_state; ///< Stored text content.
- };
- 
- /**
-  * @brief The Originator, representing a text editor.
-  */
- class TextEditor
- {
- public:
-     /**
-      * @brief Sets the text in the editor.
-      * @param text The new text.
-      */
-     void setText(const std::string& text)
-     {
-         m_text = text;
-     }
- 
-     /**
-      * @brief Gets the current text.
-      * @return The current text in the editor.
-      */
-     std::string getText() const
-     {
-         return m_text;
-     }
- 
-     /**
-      * @brief Saves the current state to a memento.
-      * @return A shared pointer to a memento storing the current state.
-      */
-     std::shared_ptr<EditorMemento> save() const
-     {
-         return std::make_shared<EditorMemento>(m_text);
-     }
- 
-     /**
-      * @brief Restores the editor's state from a memento.
-      * @param memento The memento to restore from.
-      */
-     void restore(std::shared_ptr<EditorMemento> memento)
-     {
-         if (memento)
-         {
-             m_text = memento->getState();
-         }
-     }
- 
- private:
-     std::string m_text; ///< Current text content in the editor.
- };
- 
- /**
-  * @brief The Caretaker that manages undo/redo functionality.
-  */
- class HistoryManager
- {
- public:
-     /**
-      * @brief Saves a snapshot of the editor's state.
-      * @param memento The memento storing the state.
-      */
-     void saveState(std::shared_ptr<EditorMemento> memento)
-     {
-         m_undoStack.push(memento);
-         m_redoStack = std::stack<std::shared_ptr<EditorMemento>>(); // Clear redo stack on new action
-     }
- 
-     /**
-      * @brief Undoes the last change.
-      * @param editor The text editor to apply the undo operation on.
-      */
-     void undo(TextEditor& editor)
-     {
-         if (!m_undoStack.empty())
-         {
-             m_redoStack.push(editor.save());
-             editor.restore(m_undoStack.top());
-             m_undoStack.pop();
-         }
-     }
- 
-     /**
-      * @brief Redoes the last undone change.
-      * @param editor The text editor to apply the redo operation on.
-      */
-     void redo(TextEditor& editor)
-     {
-         if (!m_redoStack.empty())
-         {
-             m_undoStack.push(editor.save());
-             editor.restore(m_redoStack.top());
-             m_redoStack.pop();
-         }
-     }
- 
- private:
-     std::stack<std::shared_ptr<EditorMemento>> m_undoStack; ///< Stack of undo states.
-     std::stack<std::shared_ptr<EditorMemento>> m_redoStack; ///< Stack of redo states.
- };
- 
- /**
-  * @brief Demonstrates the text editor with undo/redo using the Memento Pattern.
-  */
- int main()
- {
-     TextEditor editor;
-     HistoryManager history;
- 
-     editor.setText("Hello");
-     history.saveState(editor.save());
- 
-     editor.setText("World");
-     history.saveState(editor.save());
- 
-     editor.setText("!");
-     history.saveState(editor.save());
- 
-     std::cout << "Current text: " << editor.getText() << "\n";
- 
-     history.undo(editor);
-     std::cout << "After undo: " << editor.getText() << "\n";
- 
-     history.undo(editor);
-     std::cout << "After undo: " << editor.getText() << "\n";
- 
-     history.undo(editor);
-     std::cout << "After undo: " << editor.getText() << "\n";
- 
-     history.redo(editor);
-     std::cout << "After redo: " << editor.getText() << "\n";
- 
-     history.redo(editor);
-     std::cout << "After redo: " << editor.getText() << "\n";
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
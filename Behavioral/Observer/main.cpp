@@ -2,113 +2,377 @@
  * @brief Observer Pattern example for a Game Event System.
  *
  * **Key Concepts:**
- * 1. **Subject (`GameEvent`)** - Maintains a list of observers and notifies them of changes.
+ * 1. **Subject (`GameEvent`)** - Maintains observers and notifies them of changes.
  * 2. **Observer Interface (`GameObserver`)** - Defines an interface for objects that need updates.
  * 3. **Concrete Observers (`HUD`, `Logger`)** - React to game events, such as player health updates.
+ * 4. **Signal/Slot Dispatcher (`EventDispatcher`)** - A high-rate alternative: observers subscribe
+ *    per event kind, callbacks live in small-buffer-optimized delegates (no shared_ptr ref-count
+ *    traffic), and subscriptions detach in O(1) through stable handles.
  *
  * **Benefits:**
  * - **Decouples** event producers from consumers.
  * - Supports **multiple independent observers** reacting to the same event.
  * - Easily **extendable** (new observers can be added without modifying existing code).
+ * - Observers only see event kinds they subscribed to; detach never scans a vector.
  */
 
- #include <iostream>
- #include <memory>
- #include <vector>
- 
- /**
-  * @brief Observer interface for game events.
-  */
- class GameObserver
- {
- public:
-     virtual ~GameObserver() = default;
-     virtual void onHealthChanged(int health) = 0;
- };
- 
- /**
-  * @brief Represents a player that notifies observers of health changes.
-  */
- class GameEvent
- {
- public:
-     /**
-      * @brief Registers an observer.
-      * @param observer The observer to add.
-      */
-     void addObserver(std::shared_ptr<GameObserver> observer)
-     {
-         m_observers.push_back(observer);
-     }
- 
-     /**
-      * @brief Sets player health and notifies observers.
-      * @param health The new health value.
-      */
-     void setHealth(int health)
-     {
-         m_health = health;
-         notifyObservers();
-     }
- 
- private:
-     int m_health{100}; ///< Player's health.
-     std::vector<std::shared_ptr<GameObserver>> m_observers; ///< List of observers.
- 
-     /**
-      * @brief Notifies all observers of a health change.
-      */
-     void notifyObservers()
-     {
-         for (auto& observer : m_observers)
-         {
-             observer->onHealthChanged(m_health);
-         }
-     }
- };
- 
- /**
-  * @brief Displays player's health on the HUD.
-  */
- class HUD : public GameObserver
- {
- public:
-     void onHealthChanged(int health) override
-     {
-         std::cout << "[HUD] Player Health: " << health << "\n";
-     }
- };
- 
- /**
-  * @brief Logs player's health changes.
-  */
- class Logger : public GameObserver
- {
- public:
-     void onHealthChanged(int health) override
-     {
-         std::cout << "[Logger] Health changed to: " << health << "\n";
-     }
- };
- 
- /**
-  * @brief Demonstrates the Game Event System using the Observer Pattern.
-  */
- int main()
- {
-     auto player = std::make_shared<GameEvent>();
-     auto hud = std::make_shared<HUD>();
-     auto logger = std::make_shared<Logger>();
- 
-     // Register observers
-     player->addObserver(hud);
-     player->addObserver(logger);
- 
-     // Simulated health changes
-     player->setHealth(90);
-     player->setHealth(75);
-     player->setHealth(50);
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+/**
+ * @brief Observer interface for game events.
+ */
+class GameObserver
+{
+public:
+    virtual ~GameObserver() = default;
+    virtual void onHealthChanged(int health) = 0;
+};
+
+/**
+ * @brief Represents a player that notifies observers of health changes.
+ */
+class GameEvent
+{
+public:
+    /**
+     * @brief Registers an observer.
+     * @param observer The observer to add.
+     */
+    void addObserver(std::shared_ptr<GameObserver> observer)
+    {
+        m_observers.push_back(observer);
+    }
+
+    /**
+     * @brief Sets player health and notifies observers.
+     * @param health The new health value.
+     */
+    void setHealth(int health)
+    {
+        m_health = health;
+        notifyObservers();
+    }
+
+private:
+    int m_health{100}; ///< Player's health.
+    std::vector<std::shared_ptr<GameObserver>> m_observers; ///< List of observers.
+
+    /**
+     * @brief Notifies all observers of a health change.
+     */
+    void notifyObservers()
+    {
+        for (auto& observer : m_observers)
+        {
+            observer->onHealthChanged(m_health);
+        }
+    }
+};
+
+/**
+ * @brief Kinds of game events the dispatcher can route.
+ */
+enum class EventKind : std::size_t
+{
+    HealthChanged = 0,
+    ManaChanged = 1,
+    Count
+};
+
+/**
+ * @brief Fixed-capacity delegate for void(int) callbacks.
+ *
+ * Small callables (lambdas capturing a pointer or two) live inline in the
+ * delegate's buffer — no heap allocation and no shared_ptr ref counting.
+ * Larger callables fall back to the heap transparently.
+ */
+class Delegate
+{
+public:
+    static constexpr std::size_t INLINE_SIZE = 32; ///< Bytes of inline storage.
+
+    Delegate() = default;
+
+    template <typename Callable>
+    Delegate(Callable callable)
+    {
+        if constexpr (sizeof(Callable) <= INLINE_SIZE && alignof(Callable) <= alignof(std::max_align_t))
+        {
+            new (m_storage.data()) Callable(std::move(callable));
+            m_invoke = [](void* storage, int value) { (*static_cast<Callable*>(storage))(value); };
+            m_destroy = [](void* storage) { static_cast<Callable*>(storage)->~Callable(); };
+            m_moveFrom = [](void* storage, void* other)
+            {
+                new (storage) Callable(std::move(*static_cast<Callable*>(other)));
+                static_cast<Callable*>(other)->~Callable();
+            };
+            m_inline = true;
+        }
+        else
+        {
+            m_heap = new Callable(std::move(callable));
+            m_invoke = [](void* target, int value) { (*static_cast<Callable*>(target))(value); };
+            m_destroy = [](void* target) { delete static_cast<Callable*>(target); };
+        }
+    }
+
+    Delegate(Delegate&& other) noexcept
+    {
+        moveFrom(std::move(other));
+    }
+
+    Delegate& operator=(Delegate&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            moveFrom(std::move(other));
+        }
+        return *this;
+    }
+
+    Delegate(const Delegate&) = delete;
+    Delegate& operator=(const Delegate&) = delete;
+
+    ~Delegate()
+    {
+        reset();
+    }
+
+    void operator()(int value)
+    {
+        m_invoke(target(), value);
+    }
+
+private:
+    void* target()
+    {
+        return m_inline ? static_cast<void*>(m_storage.data()) : m_heap;
+    }
+
+    void reset()
+    {
+        if (m_destroy)
+        {
+            m_destroy(target());
+        }
+        m_invoke = nullptr;
+        m_destroy = nullptr;
+        m_moveFrom = nullptr;
+        m_heap = nullptr;
+        m_inline = false;
+    }
+
+    void moveFrom(Delegate&& other)
+    {
+        m_invoke = other.m_invoke;
+        m_destroy = other.m_destroy;
+        m_moveFrom = other.m_moveFrom;
+        m_inline = other.m_inline;
+        if (m_inline)
+        {
+            m_moveFrom(m_storage.data(), other.m_storage.data());
+        }
+        else
+        {
+            m_heap = other.m_heap;
+        }
+        other.m_invoke = nullptr;
+        other.m_destroy = nullptr;
+        other.m_moveFrom = nullptr;
+        other.m_heap = nullptr;
+        other.m_inline = false;
+    }
+
+    alignas(std::max_align_t) std::array<std::byte, INLINE_SIZE> m_storage; ///< Inline slot.
+    void* m_heap{nullptr};                        ///< Fallback for large callables.
+    void (*m_invoke)(void*, int){nullptr};
+    void (*m_destroy)(void*){nullptr};
+    void (*m_moveFrom)(void*, void*){nullptr};    ///< Relocates the inline callable.
+    bool m_inline{false};
+};
+
+/**
+ * @brief Stable subscription handle returned by EventDispatcher::connect.
+ */
+struct ConnectionHandle
+{
+    std::uint32_t index{0};      ///< Slot-table index.
+    std::uint32_t generation{0}; ///< Guards against stale handles.
+};
+
+/**
+ * @brief Type-segregated signal/slot registry with O(1) detach.
+ *
+ * Each event kind keeps its own dense delegate list, so firing an event only
+ * touches subscribers of that kind. Handles index a slot table whose entries
+ * track where each delegate currently lives; detaching swap-removes the
+ * delegate and patches the moved entry — no scanning, no tombstones.
+ */
+class EventDispatcher
+{
+public:
+    /**
+     * @brief Subscribes a callback to an event kind.
+     * @param kind The event kind to listen for.
+     * @param delegate The callback (stored inline when small).
+     * @return A handle for O(1) disconnect.
+     */
+    ConnectionHandle connect(EventKind kind, Delegate delegate)
+    {
+        auto& list = m_lists[static_cast<std::size_t>(kind)];
+
+        std::uint32_t slotIndex;
+        if (m_freeSlots.empty())
+        {
+            slotIndex = static_cast<std::uint32_t>(m_slots.size());
+            m_slots.push_back(Slot{kind, static_cast<std::uint32_t>(list.entries.size()), 0});
+        }
+        else
+        {
+            slotIndex = m_freeSlots.back();
+            m_freeSlots.pop_back();
+            m_slots[slotIndex].kind = kind;
+            m_slots[slotIndex].position = static_cast<std::uint32_t>(list.entries.size());
+        }
+
+        list.entries.push_back(Entry{std::move(delegate), slotIndex});
+        return ConnectionHandle{slotIndex, m_slots[slotIndex].generation};
+    }
+
+    /**
+     * @brief Unsubscribes in O(1); stale handles are ignored.
+     */
+    void disconnect(ConnectionHandle handle)
+    {
+        if (handle.index >= m_slots.size() || m_slots[handle.index].generation != handle.generation)
+        {
+            return; // Already disconnected or recycled.
+        }
+        Slot& slot = m_slots[handle.index];
+        auto& entries = m_lists[static_cast<std::size_t>(slot.kind)].entries;
+
+        std::uint32_t position = slot.position;
+        entries[position] = std::move(entries.back());
+        m_slots[entries[position].slotIndex].position = position; // Patch the moved entry's slot.
+        entries.pop_back();
+
+        ++slot.generation; // Invalidate outstanding copies of the handle.
+        m_freeSlots.push_back(handle.index);
+    }
+
+    /**
+     * @brief Fires an event to exactly the subscribers of its kind.
+     */
+    void emit(EventKind kind, int value)
+    {
+        for (auto& entry : m_lists[static_cast<std::size_t>(kind)].entries)
+        {
+            entry.delegate(value);
+        }
+    }
+
+private:
+    /**
+     * @brief A live subscription: the delegate plus a back-pointer to its slot.
+     */
+    struct Entry
+    {
+        Delegate delegate;
+        std::uint32_t slotIndex;
+    };
+
+    /**
+     * @brief Dense subscriber list for one event kind.
+     */
+    struct KindList
+    {
+        std::vector<Entry> entries;
+    };
+
+    /**
+     * @brief Where a handle's delegate currently lives.
+     */
+    struct Slot
+    {
+        EventKind kind;
+        std::uint32_t position;   ///< Index into the kind's entry list.
+        std::uint32_t generation; ///< Bumped on disconnect.
+    };
+
+    std::array<KindList, static_cast<std::size_t>(EventKind::Count)> m_lists; ///< Per-kind subscribers.
+    std::vector<Slot> m_slots;              ///< Handle table.
+    std::vector<std::uint32_t> m_freeSlots; ///< Recycled handle-table indices.
+};
+
+/**
+ * @brief Displays player's health on the HUD.
+ */
+class HUD : public GameObserver
+{
+public:
+    void onHealthChanged(int health) override
+    {
+        std::cout << "[HUD] Player Health: " << health << "\n";
+    }
+};
+
+/**
+ * @brief Logs player's health changes.
+ */
+class Logger : public GameObserver
+{
+public:
+    void onHealthChanged(int health) override
+    {
+        std::cout << "[Logger] Health changed to: " << health << "\n";
+    }
+};
+
+/**
+ * @brief Demonstrates the Game Event System using the Observer Pattern.
+ */
+int main()
+{
+    auto player = std::make_shared<GameEvent>();
+    auto hud = std::make_shared<HUD>();
+    auto logger = std::make_shared<Logger>();
+
+    // Register observers
+    player->addObserver(hud);
+    player->addObserver(logger);
+
+    // Simulated health changes
+    player->setHealth(90);
+    player->setHealth(75);
+    player->setHealth(50);
+
+    // High-rate path: signal/slot dispatcher with per-kind lists and handles.
+    EventDispatcher dispatcher;
+    HUD rawHud;
+    Logger rawLogger;
+
+    auto hudHandle = dispatcher.connect(EventKind::HealthChanged,
+                                        Delegate([&rawHud](int health) { rawHud.onHealthChanged(health); }));
+    auto logHandle = dispatcher.connect(EventKind::HealthChanged,
+                                        Delegate([&rawLogger](int health) { rawLogger.onHealthChanged(health); }));
+    dispatcher.connect(EventKind::ManaChanged,
+                       Delegate([](int mana) { std::cout << "[HUD] Player Mana: " << mana << "\n"; }));
+
+    dispatcher.emit(EventKind::HealthChanged, 40); // Both health subscribers fire.
+    dispatcher.emit(EventKind::ManaChanged, 80);   // Only the mana subscriber fires.
+
+    dispatcher.disconnect(logHandle);              // O(1) detach via the handle.
+    dispatcher.emit(EventKind::HealthChanged, 25); // Logger no longer notified.
+
+    dispatcher.disconnect(hudHandle);
+
+    return 0;
+}
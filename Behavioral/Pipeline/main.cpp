@@ -14,91 +14,352 @@
  * - Improved maintainability: Each function (step) in the pipeline has a single responsibility.
  * - Easy extensibility: New functions can be added to the pipeline easily.
  * - Decoupling: Each function is independent of others in terms of logic.
+ * - Static composition: make_pipeline(f1, f2, ...) fixes the stage list at compile time, so the
+ *   whole chain can inline and the payload moves from stage to stage without a single copy.
+ * - Streaming mode: processStream() runs each stage on its own thread connected by bounded
+ *   SPSC queues, so stages overlap, slow stages apply backpressure, and per-queue occupancy
+ *   metrics point at the bottleneck stage.
  */
 
- #include <iostream>
- #include <memory>
- #include <string>
- #include <functional>
- #include <vector>
- 
- /**
-  * @brief
-  * Pipeline class that processes data through a sequence of functions.
-  */
- class Pipeline
- {
- public:
-     /**
-      * @brief Add a processing step to the pipeline.
-      * @param step Function that processes a string and returns the processed string.
-      */
-     void addStep(const std::function<std::string(const std::string &)> &step)
-     {
-         m_steps.push_back(step);
-     }
- 
-     /**
-      * @brief Execute the pipeline on the provided input data.
-      * @param input Data to be processed.
-      * @return Processed data after applying each step in the pipeline.
-      */
-     std::string execute(const std::string &input)
-     {
-         std::string result = input;
-         for (auto &step : m_steps)
-         {
-             result = step(result);
-         }
-         return result;
-     }
- 
- private:
-     std::vector<std::function<std::string(const std::string &)>> m_steps; ///< List of processing steps in the pipeline.
- };
- 
- /**
-  * @brief Example of a concrete processing step.
-  * Converts a string to uppercase.
-  * @param input Data to be converted.
-  * @return Uppercase string.
-  */
- std::string toUpperCase(const std::string &input)
- {
-     std::string result = input;
-     for (auto &ch : result)
-     {
-         ch = std::toupper(ch);
-     }
-     return result;
- }
- 
- /**
-  * @brief Example of another concrete processing step.
-  * Reverses the string.
-  * @param input Data to be reversed.
-  * @return Reversed string.
-  */
- std::string reverseString(const std::string &input)
- {
-     return std::string(input.rbegin(), input.rend());
- }
- 
- int main()
- {
-     // Create a pipeline
-     Pipeline pipeline;
- 
-     // Add steps to the pipeline
-     pipeline.addStep(toUpperCase);
-     pipeline.addStep(reverseString);
- 
-     // Execute the pipeline with input data
-     std::string input = "hello world";
-     std::string output = pipeline.execute(input);
- 
-     std::cout << "Processed Output: " << output << std::endl;
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <memory>
+#include <string>
+#include <functional>
+#include <vector>
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <atomic>
+#include <thread>
+#include <optional>
+
+/**
+ * @brief Bounded single-producer/single-consumer queue linking two pipeline stages.
+ *
+ * One stage pushes, the next pops; with a single thread on each end the ring
+ * only needs acquire/release on the head and tail counters. A full queue makes
+ * the producer wait — that is the backpressure that stops a fast stage from
+ * flooding a slow one. Occupancy is sampled at every push so the hot queues
+ * (those feeding the bottleneck stage) are visible afterwards.
+ *
+ * @tparam T Element type.
+ */
+template <typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(std::size_t capacity) : m_capacity(capacity), m_slots(capacity) {}
+
+    /**
+     * @brief Pushes a value, waiting while the queue is full (backpressure).
+     */
+    void push(T value)
+    {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        while (tail - m_head.load(std::memory_order_acquire) >= m_capacity)
+        {
+            std::this_thread::yield(); // Consumer is behind: wait.
+        }
+        m_occupancySum += tail - m_head.load(std::memory_order_relaxed);
+        ++m_pushes;
+        m_slots[tail % m_capacity] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Pops the next value, or nothing once the queue is closed and drained.
+     */
+    std::optional<T> pop()
+    {
+        std::size_t head = m_head.load(std::memory_order_relaxed);
+        while (head == m_tail.load(std::memory_order_acquire))
+        {
+            if (m_closed.load(std::memory_order_acquire))
+            {
+                if (head == m_tail.load(std::memory_order_acquire))
+                {
+                    return std::nullopt; // Closed and fully drained.
+                }
+                continue;
+            }
+            std::this_thread::yield(); // Producer is behind: wait.
+        }
+        T value = std::move(m_slots[head % m_capacity]);
+        m_head.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    /**
+     * @brief Signals that no more values will be pushed.
+     */
+    void close()
+    {
+        m_closed.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Average number of queued items observed at push time.
+     */
+    double averageOccupancy() const
+    {
+        return m_pushes == 0 ? 0.0 : static_cast<double>(m_occupancySum) / static_cast<double>(m_pushes);
+    }
+
+private:
+    std::size_t m_capacity;                      ///< Bound; full queue blocks the producer.
+    std::vector<T> m_slots;                      ///< Ring storage.
+    alignas(64) std::atomic<std::size_t> m_head{0}; ///< Consumer cursor.
+    alignas(64) std::atomic<std::size_t> m_tail{0}; ///< Producer cursor.
+    std::atomic<bool> m_closed{false};           ///< Set once the producer finishes.
+    std::size_t m_occupancySum{0};               ///< Producer-side occupancy samples.
+    std::size_t m_pushes{0};                     ///< Number of samples taken.
+};
+
+/**
+ * @brief
+ * Pipeline class that processes data through a sequence of functions.
+ */
+class Pipeline
+{
+public:
+    /**
+     * @brief Add a processing step to the pipeline.
+     * @param step Function that processes a string and returns the processed string.
+     */
+    void addStep(const std::function<std::string(const std::string &)> &step)
+    {
+        m_steps.push_back(step);
+    }
+
+    /**
+     * @brief Execute the pipeline on the provided input data.
+     * @param input Data to be processed.
+     * @return Processed data after applying each step in the pipeline.
+     */
+    std::string execute(const std::string &input)
+    {
+        std::string result = input;
+        for (auto &step : m_steps)
+        {
+            result = step(result);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Streams a batch of inputs through the pipeline with one thread per stage.
+     *
+     * Stages are connected by bounded SPSC queues, so every stage works on a
+     * different record at the same time and a slow stage throttles its
+     * upstream instead of stalling the whole chain. Per-queue occupancy is
+     * reported so the bottleneck stage can be identified and widened.
+     *
+     * @param inputs The records to process.
+     * @param queueCapacity Bound of each inter-stage queue.
+     * @return The processed records, in input order.
+     */
+    std::vector<std::string> processStream(std::vector<std::string> inputs, std::size_t queueCapacity = 64)
+    {
+        std::size_t stageCount = m_steps.size();
+        std::vector<std::unique_ptr<SpscQueue<std::string>>> queues;
+        for (std::size_t i = 0; i + 1 < stageCount; ++i)
+        {
+            queues.push_back(std::make_unique<SpscQueue<std::string>>(queueCapacity));
+        }
+
+        std::vector<std::string> outputs;
+        std::vector<std::thread> workers;
+        for (std::size_t stage = 0; stage < stageCount; ++stage)
+        {
+            workers.emplace_back([this, stage, stageCount, &queues, &inputs, &outputs]
+            {
+                std::size_t index = 0;
+                for (;;)
+                {
+                    std::string record;
+                    if (stage == 0) // First stage pulls straight from the input batch.
+                    {
+                        if (index >= inputs.size())
+                        {
+                            break;
+                        }
+                        record = std::move(inputs[index++]);
+                    }
+                    else
+                    {
+                        auto popped = queues[stage - 1]->pop();
+                        if (!popped)
+                        {
+                            break; // Upstream closed and drained.
+                        }
+                        record = std::move(*popped);
+                    }
+
+                    record = m_steps[stage](record);
+
+                    if (stage + 1 < stageCount)
+                    {
+                        queues[stage]->push(std::move(record)); // Blocks when downstream is behind.
+                    }
+                    else
+                    {
+                        outputs.push_back(std::move(record)); // Only the last stage writes here.
+                    }
+                }
+                if (stage + 1 < stageCount)
+                {
+                    queues[stage]->close();
+                }
+            });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+
+        for (std::size_t i = 0; i < queues.size(); ++i)
+        {
+            std::cout << "Stage " << i << " -> " << i + 1 << " queue: average occupancy "
+                      << queues[i]->averageOccupancy() << "\n";
+        }
+        return outputs;
+    }
+
+private:
+    std::vector<std::function<std::string(const std::string &)>> m_steps; ///< List of processing steps in the pipeline.
+};
+
+/**
+ * @brief Compile-time composed pipeline: the stage list is part of the type.
+ *
+ * Stages are held in a tuple, so there is no std::function type erasure and
+ * the compiler sees the whole chain at once — every call can inline. The
+ * payload is forwarded as an rvalue through each stage; stages that take
+ * their argument by value and return it simply move it along.
+ *
+ * @tparam Steps The stage callables, in execution order.
+ */
+template <typename... Steps>
+class StaticPipeline
+{
+public:
+    explicit StaticPipeline(Steps... steps) : m_steps(std::move(steps)...) {}
+
+    /**
+     * @brief Execute the pipeline, moving the payload through every stage.
+     * @param input Data to be processed (consumed).
+     * @return Processed data after applying each step in the pipeline.
+     */
+    template <typename T>
+    auto execute(T &&input)
+    {
+        return executeFrom<0>(std::forward<T>(input));
+    }
+
+private:
+    /**
+     * @brief Applies stages Index.. recursively; each application is a move, never a copy.
+     */
+    template <std::size_t Index, typename T>
+    auto executeFrom(T &&value)
+    {
+        if constexpr (Index == sizeof...(Steps))
+        {
+            return std::forward<T>(value);
+        }
+        else
+        {
+            return executeFrom<Index + 1>(std::get<Index>(m_steps)(std::forward<T>(value)));
+        }
+    }
+
+    std::tuple<Steps...> m_steps; ///< Stage callables; no type erasure.
+};
+
+/**
+ * @brief Builds a statically composed pipeline from the given stages.
+ * @param steps The stage callables, in execution order.
+ */
+template <typename... Steps>
+StaticPipeline<Steps...> make_pipeline(Steps... steps)
+{
+    return StaticPipeline<Steps...>(std::move(steps)...);
+}
+
+/**
+ * @brief Example of a concrete processing step.
+ * Converts a string to uppercase.
+ * @param input Data to be converted.
+ * @return Uppercase string.
+ */
+std::string toUpperCase(const std::string &input)
+{
+    std::string result = input;
+    for (auto &ch : result)
+    {
+        ch = std::toupper(ch);
+    }
+    return result;
+}
+
+/**
+ * @brief Example of another concrete processing step.
+ * Reverses the string.
+ * @param input Data to be reversed.
+ * @return Reversed string.
+ */
+std::string reverseString(const std::string &input)
+{
+    return std::string(input.rbegin(), input.rend());
+}
+
+/**
+ * @brief In-place variants used by the static pipeline: take by value, mutate, move out.
+ */
+std::string toUpperCaseInPlace(std::string input)
+{
+    for (auto &ch : input)
+    {
+        ch = std::toupper(ch);
+    }
+    return input;
+}
+
+std::string reverseInPlace(std::string input)
+{
+    std::reverse(input.begin(), input.end());
+    return input;
+}
+
+int main()
+{
+    // Create a pipeline
+    Pipeline pipeline;
+
+    // Add steps to the pipeline
+    pipeline.addStep(toUpperCase);
+    pipeline.addStep(reverseString);
+
+    // Execute the pipeline with input data
+    std::string input = "hello world";
+    std::string output = pipeline.execute(input);
+
+    std::cout << "Processed Output: " << output << std::endl;
+
+    // Statically composed pipeline: stages inline, payload is moved end to end.
+    auto staticPipeline = make_pipeline(toUpperCaseInPlace, reverseInPlace);
+    std::string record = "hello world";
+    std::string staticOutput = staticPipeline.execute(std::move(record));
+
+    std::cout << "Static Pipeline Output: " << staticOutput << std::endl;
+
+    // Streaming mode: one thread per stage, bounded queues in between.
+    std::vector<std::string> batch = {"alpha", "bravo", "charlie", "delta", "echo"};
+    auto streamed = pipeline.processStream(std::move(batch), 4);
+    for (const auto &item : streamed)
+    {
+        std::cout << "Streamed Output: " << item << std::endl;
+    }
+
+    return 0;
+}
@@ -10,110 +10,396 @@
  * - Allows complex conditions to be expressed in a reusable and composable way.
  * - Decouples the logic from the objects, making it easier to modify or extend.
  * - Promotes maintainability and flexibility in business rule checks.
+ *
+ * Naively, composite specifications cost O(records x predicates) virtual calls. The
+ * compilation layer flattens an And/Or/Not tree into a flat predicate program with
+ * jump-based short-circuiting, evaluated in one pass per record over plain structs.
+ * A sorted age index lets a selective age predicate prune candidates before any
+ * per-record evaluation runs at all.
  */
 
- #include <iostream>
- #include <memory>
- #include <vector>
- #include <functional>
- 
- /// @brief Abstract Specification interface that defines the method for checking an object.
- class Specification
- {
- public:
-     virtual ~Specification() = default;
- 
-     /// @brief Checks if the object meets the condition defined by the specification.
-     /// @param item The object to be checked.
-     /// @return True if the object meets the condition, otherwise false.
-     virtual bool isSatisfiedBy(const std::shared_ptr<class Person>& item) const = 0;
- };
- 
- /// @brief Concrete Specification that checks if a person is older than a certain age.
- class AgeSpecification : public Specification
- {
- public:
-     explicit AgeSpecification(int age) : m_age(age) {}
- 
-     bool isSatisfiedBy(const std::shared_ptr<class Person>& person) const override;
- 
- private:
-     int m_age; ///< Minimum age for the specification.
- };
- 
- /// @brief Concrete Specification that checks if a person has a certain name.
- class NameSpecification : public Specification
- {
- public:
-     explicit NameSpecification(const std::string& name) : m_name(name) {}
- 
-     bool isSatisfiedBy(const std::shared_ptr<class Person>& person) const override;
- 
- private:
-     std::string m_name; ///< Name for the specification.
- };
- 
- /// @brief Person class to demonstrate the specification pattern.
- class Person
- {
- public:
-     Person(const std::string& name, int age) : m_name(name), m_age(age) {}
- 
-     std::string getName() const { return m_name; }
-     int getAge() const { return m_age; }
- 
- private:
-     std::string m_name; ///< Name of the person.
-     int m_age; ///< Age of the person.
- };
- 
- /// @brief AgeSpecification implementation that checks if a person is older than the given age.
- bool AgeSpecification::isSatisfiedBy(const std::shared_ptr<Person>& person) const
- {
-     return person->getAge() > m_age;
- }
- 
- /// @brief NameSpecification implementation that checks if a person's name matches.
- bool NameSpecification::isSatisfiedBy(const std::shared_ptr<Person>& person) const
- {
-     return person->getName() == m_name;
- }
- 
- /// @brief A helper function to filter persons using a specification.
- void filterPersons(const std::vector<std::shared_ptr<Person>>& persons, const Specification& specification)
- {
-     for (const auto& person : persons)
-     {
-         if (specification.isSatisfiedBy(person))
-         {
-             std::cout << "Person " << person->getName() << " meets the specification.\n";
-         }
-         else
-         {
-             std::cout << "Person " << person->getName() << " does NOT meet the specification.\n";
-         }
-     }
- }
- 
- int main()
- {
-     // Creating some persons
-     std::vector<std::shared_ptr<Person>> persons;
-     persons.push_back(std::make_shared<Person>("Alice", 30));
-     persons.push_back(std::make_shared<Person>("Bob", 25));
-     persons.push_back(std::make_shared<Person>("Charlie", 35));
- 
-     // Creating specifications
-     AgeSpecification ageSpec(28);
-     NameSpecification nameSpec("Alice");
- 
-     // Filtering persons based on the specifications
-     std::cout << "Checking Age Specification:\n";
-     filterPersons(persons, ageSpec);
- 
-     std::cout << "\nChecking Name Specification:\n";
-     filterPersons(persons, nameSpec);
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <string>
+#include <chrono>
+#include <cstdint>
+
+/// @brief Abstract Specification interface that defines the method for checking an object.
+class Specification
+{
+public:
+    virtual ~Specification() = default;
+
+    /// @brief Checks if the object meets the condition defined by the specification.
+    /// @param item The object to be checked.
+    /// @return True if the object meets the condition, otherwise false.
+    virtual bool isSatisfiedBy(const std::shared_ptr<class Person>& item) const = 0;
+};
+
+/// @brief Concrete Specification that checks if a person is older than a certain age.
+class AgeSpecification : public Specification
+{
+public:
+    explicit AgeSpecification(int age) : m_age(age) {}
+
+    bool isSatisfiedBy(const std::shared_ptr<class Person>& person) const override;
+
+    int minimumAge() const { return m_age; }
+
+private:
+    int m_age; ///< Minimum age for the specification.
+};
+
+/// @brief Concrete Specification that checks if a person has a certain name.
+class NameSpecification : public Specification
+{
+public:
+    explicit NameSpecification(const std::string& name) : m_name(name) {}
+
+    bool isSatisfiedBy(const std::shared_ptr<class Person>& person) const override;
+
+    const std::string& name() const { return m_name; }
+
+private:
+    std::string m_name; ///< Name for the specification.
+};
+
+/// @brief Composite Specification: satisfied when both operands are.
+class AndSpecification : public Specification
+{
+public:
+    AndSpecification(std::shared_ptr<Specification> left, std::shared_ptr<Specification> right)
+        : m_left(std::move(left)), m_right(std::move(right)) {}
+
+    bool isSatisfiedBy(const std::shared_ptr<class Person>& person) const override
+    {
+        return m_left->isSatisfiedBy(person) && m_right->isSatisfiedBy(person);
+    }
+
+    const Specification& left() const { return *m_left; }
+    const Specification& right() const { return *m_right; }
+
+private:
+    std::shared_ptr<Specification> m_left;  ///< First operand.
+    std::shared_ptr<Specification> m_right; ///< Second operand.
+};
+
+/// @brief Composite Specification: satisfied when either operand is.
+class OrSpecification : public Specification
+{
+public:
+    OrSpecification(std::shared_ptr<Specification> left, std::shared_ptr<Specification> right)
+        : m_left(std::move(left)), m_right(std::move(right)) {}
+
+    bool isSatisfiedBy(const std::shared_ptr<class Person>& person) const override
+    {
+        return m_left->isSatisfiedBy(person) || m_right->isSatisfiedBy(person);
+    }
+
+    const Specification& left() const { return *m_left; }
+    const Specification& right() const { return *m_right; }
+
+private:
+    std::shared_ptr<Specification> m_left;  ///< First operand.
+    std::shared_ptr<Specification> m_right; ///< Second operand.
+};
+
+/// @brief Composite Specification: satisfied when the operand is not.
+class NotSpecification : public Specification
+{
+public:
+    explicit NotSpecification(std::shared_ptr<Specification> inner)
+        : m_inner(std::move(inner)) {}
+
+    bool isSatisfiedBy(const std::shared_ptr<class Person>& person) const override
+    {
+        return !m_inner->isSatisfiedBy(person);
+    }
+
+    const Specification& inner() const { return *m_inner; }
+
+private:
+    std::shared_ptr<Specification> m_inner; ///< Negated operand.
+};
+
+/// @brief Person class to demonstrate the specification pattern.
+class Person
+{
+public:
+    Person(const std::string& name, int age) : m_name(name), m_age(age) {}
+
+    std::string getName() const { return m_name; }
+    int getAge() const { return m_age; }
+
+private:
+    std::string m_name; ///< Name of the person.
+    int m_age; ///< Age of the person.
+};
+
+/// @brief AgeSpecification implementation that checks if a person is older than the given age.
+bool AgeSpecification::isSatisfiedBy(const std::shared_ptr<Person>& person) const
+{
+    return person->getAge() > m_age;
+}
+
+/// @brief NameSpecification implementation that checks if a person's name matches.
+bool NameSpecification::isSatisfiedBy(const std::shared_ptr<Person>& person) const
+{
+    return person->getName() == m_name;
+}
+
+/// @brief Plain record evaluated by compiled predicate programs; no heap objects.
+struct PersonRecord
+{
+    std::string name;
+    int age;
+};
+
+/// @brief A specification tree compiled into a flat program with short-circuit jumps.
+///
+/// Leaves test one attribute and set the accumulator; And/Or compile into a
+/// conditional jump over the right-hand side, so evaluation of one record is a
+/// single pass over contiguous instructions that stops as soon as the outcome
+/// is decided — no virtual calls, no tree walking.
+class CompiledSpecification
+{
+public:
+    /// @brief Flattens a specification tree; composites become jump-threaded code.
+    static CompiledSpecification compile(const Specification& specification)
+    {
+        CompiledSpecification program;
+        program.compileNode(specification);
+        return program;
+    }
+
+    /// @brief Evaluates the program against one record.
+    bool matches(const PersonRecord& record) const
+    {
+        bool accumulator = false;
+        std::size_t pc = 0;
+        while (pc < m_code.size())
+        {
+            const Op& op = m_code[pc];
+            switch (op.kind)
+            {
+                case OpKind::TestAgeGreater:
+                    accumulator = record.age > op.operand;
+                    ++pc;
+                    break;
+                case OpKind::TestNameEquals:
+                    accumulator = record.name == m_names[op.operand];
+                    ++pc;
+                    break;
+                case OpKind::JumpIfFalse:
+                    pc = accumulator ? pc + 1 : static_cast<std::size_t>(op.operand);
+                    break;
+                case OpKind::JumpIfTrue:
+                    pc = accumulator ? static_cast<std::size_t>(op.operand) : pc + 1;
+                    break;
+                case OpKind::Negate:
+                    accumulator = !accumulator;
+                    ++pc;
+                    break;
+            }
+        }
+        return accumulator;
+    }
+
+    std::size_t size() const { return m_code.size(); }
+
+private:
+    enum class OpKind : std::uint8_t
+    {
+        TestAgeGreater, ///< accumulator = age > operand.
+        TestNameEquals, ///< accumulator = name == names[operand].
+        JumpIfFalse,    ///< Short-circuits And: skip to operand when false.
+        JumpIfTrue,     ///< Short-circuits Or: skip to operand when true.
+        Negate          ///< accumulator = !accumulator.
+    };
+
+    struct Op
+    {
+        OpKind kind;
+        int operand; ///< Threshold, name-table index, or jump target.
+    };
+
+    /// @brief Emits the node's code; dispatches on the concrete specification type.
+    void compileNode(const Specification& node)
+    {
+        if (const auto* age = dynamic_cast<const AgeSpecification*>(&node))
+        {
+            m_code.push_back({OpKind::TestAgeGreater, age->minimumAge()});
+        }
+        else if (const auto* name = dynamic_cast<const NameSpecification*>(&node))
+        {
+            m_names.push_back(name->name());
+            m_code.push_back({OpKind::TestNameEquals, static_cast<int>(m_names.size() - 1)});
+        }
+        else if (const auto* conjunction = dynamic_cast<const AndSpecification*>(&node))
+        {
+            compileNode(conjunction->left());
+            std::size_t jump = m_code.size();
+            m_code.push_back({OpKind::JumpIfFalse, 0}); // Patched to skip the right side.
+            compileNode(conjunction->right());
+            m_code[jump].operand = static_cast<int>(m_code.size());
+        }
+        else if (const auto* disjunction = dynamic_cast<const OrSpecification*>(&node))
+        {
+            compileNode(disjunction->left());
+            std::size_t jump = m_code.size();
+            m_code.push_back({OpKind::JumpIfTrue, 0});
+            compileNode(disjunction->right());
+            m_code[jump].operand = static_cast<int>(m_code.size());
+        }
+        else if (const auto* negation = dynamic_cast<const NotSpecification*>(&node))
+        {
+            compileNode(negation->inner());
+            m_code.push_back({OpKind::Negate, 0});
+        }
+    }
+
+    std::vector<Op> m_code;            ///< Flat short-circuiting program.
+    std::vector<std::string> m_names;  ///< Name literals referenced by index.
+};
+
+/// @brief Record set with a sorted age index for candidate pruning.
+///
+/// The index keeps record positions ordered by age, so an age predicate
+/// resolves to a contiguous index range via binary search — the compiled
+/// program then only ever sees those candidates.
+class PersonSet
+{
+public:
+    void add(PersonRecord record)
+    {
+        m_records.push_back(std::move(record));
+        m_indexDirty = true;
+    }
+
+    const std::vector<PersonRecord>& records() const { return m_records; }
+
+    /// @brief Counts matches by scanning every record with the compiled program.
+    std::size_t countMatches(const CompiledSpecification& program) const
+    {
+        std::size_t count = 0;
+        for (const PersonRecord& record : m_records)
+        {
+            count += program.matches(record);
+        }
+        return count;
+    }
+
+    /// @brief Counts matches among records with age > minimumAge, using the index.
+    std::size_t countMatchesOlderThan(int minimumAge, const CompiledSpecification& program) const
+    {
+        rebuildIndexIfNeeded();
+        auto first = std::upper_bound(m_byAge.begin(), m_byAge.end(), minimumAge,
+                                      [this](int age, std::size_t position)
+                                      { return age < m_records[position].age; });
+        std::size_t count = 0;
+        for (auto it = first; it != m_byAge.end(); ++it)
+        {
+            count += program.matches(m_records[*it]);
+        }
+        return count;
+    }
+
+private:
+    void rebuildIndexIfNeeded() const
+    {
+        if (!m_indexDirty)
+        {
+            return;
+        }
+        m_byAge.resize(m_records.size());
+        for (std::size_t i = 0; i < m_byAge.size(); ++i)
+        {
+            m_byAge[i] = i;
+        }
+        std::sort(m_byAge.begin(), m_byAge.end(), [this](std::size_t a, std::size_t b)
+                  { return m_records[a].age < m_records[b].age; });
+        m_indexDirty = false;
+    }
+
+    std::vector<PersonRecord> m_records;      ///< The record set itself.
+    mutable std::vector<std::size_t> m_byAge; ///< Record positions sorted by age.
+    mutable bool m_indexDirty{false};         ///< Index rebuilt lazily on demand.
+};
+
+/// @brief A helper function to filter persons using a specification.
+void filterPersons(const std::vector<std::shared_ptr<Person>>& persons, const Specification& specification)
+{
+    for (const auto& person : persons)
+    {
+        if (specification.isSatisfiedBy(person))
+        {
+            std::cout << "Person " << person->getName() << " meets the specification.\n";
+        }
+        else
+        {
+            std::cout << "Person " << person->getName() << " does NOT meet the specification.\n";
+        }
+    }
+}
+
+int main()
+{
+    // Creating some persons
+    std::vector<std::shared_ptr<Person>> persons;
+    persons.push_back(std::make_shared<Person>("Alice", 30));
+    persons.push_back(std::make_shared<Person>("Bob", 25));
+    persons.push_back(std::make_shared<Person>("Charlie", 35));
+
+    // Creating specifications
+    AgeSpecification ageSpec(28);
+    NameSpecification nameSpec("Alice");
+
+    // Filtering persons based on the specifications
+    std::cout << "Checking Age Specification:\n";
+    filterPersons(persons, ageSpec);
+
+    std::cout << "\nChecking Name Specification:\n";
+    filterPersons(persons, nameSpec);
+
+    // Selective composite query: age > 74 AND name == "Alice", over a large record set.
+    auto composite = std::make_shared<AndSpecification>(
+        std::make_shared<AgeSpecification>(74),
+        std::make_shared<NameSpecification>("Alice"));
+    auto program = CompiledSpecification::compile(*composite);
+
+    PersonSet population;
+    const char* names[] = {"Alice", "Bob", "Charlie", "Diana"};
+    for (int i = 0; i < 1000000; ++i)
+    {
+        population.add(PersonRecord{names[i % 4], 18 + i % 61});
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t virtualCount = 0;
+    for (const PersonRecord& record : population.records())
+    {
+        auto person = std::make_shared<Person>(record.name, record.age);
+        virtualCount += composite->isSatisfiedBy(person);
+    }
+    double virtualTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    std::size_t compiledCount = population.countMatches(program);
+    double compiledTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    population.countMatchesOlderThan(74, program); // Build the age index up front.
+    start = std::chrono::steady_clock::now();
+    std::size_t indexedCount = population.countMatchesOlderThan(74, program);
+    double indexedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "\nComposite query over " << population.records().size() << " records ("
+              << program.size() << " instruction(s)):\n"
+              << "  virtual tree:   " << virtualCount << " matches in " << virtualTime << " ms\n"
+              << "  compiled scan:  " << compiledCount << " matches in " << compiledTime << " ms\n"
+              << "  age-index scan: " << indexedCount << " matches in " << indexedTime << " ms\n";
+
+    return 0;
+}
@@ -10,123 +10,208 @@
  * - **Encapsulates state-specific behavior** inside separate classes.
  * - **Allows state transitions** without modifying the context class.
  * - **Follows Open/Closed Principle** (new states can be added without modifying `Character`).
+ *
+ * Allocating a fresh state object per transition is pure overhead once agents number in
+ * the hundred thousands. The table-driven mode below keeps states as enum values with a
+ * static transition/action table, stores each agent's state as a plain byte in a
+ * contiguous agent array, and ticks every agent with updateAll() — a branch-predictable
+ * linear loop with zero allocations.
+ */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <array>
+#include <span>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Forward declaration of the Character class to avoid circular dependency.
+ */
+class Character;
+
+/**
+ * @brief Abstract state interface defining movement behavior.
+ */
+class MovementState
+{
+public:
+    virtual ~MovementState() = default;
+
+    /**
+     * @brief Handles movement logic for the current state.
+     * @param character Reference to the character.
+     */
+    virtual void handleMovement(std::shared_ptr<Character> character) = 0;
+
+    /**
+     * @brief Returns the name of the current state.
+     * @return State name as a string.
+     */
+    virtual std::string getStateName() const = 0;
+};
+
+/**
+ * @brief Represents a character that can change movement states.
+ */
+class Character : public std::enable_shared_from_this<Character>
+{
+public:
+    Character() : m_state(std::make_shared<IdleState>()) {}
+
+    /**
+     * @brief Sets the character's movement state.
+     * @param state The new movement state.
+     */
+    void setState(std::shared_ptr<MovementState> state)
+    {
+        m_state = state;
+    }
+
+    /**
+     * @brief Executes movement logic based on the current state.
+     */
+    void move()
+    {
+        m_state->handleMovement(shared_from_this());
+    }
+
+    /**
+     * @brief Prints the current state of the character.
+     */
+    void printState() const
+    {
+        std::cout << "Character is now: " << m_state->getStateName() << "\n";
+    }
+
+private:
+    std::shared_ptr<MovementState> m_state; ///< Current movement state.
+
+    /**
+     * @brief Concrete Idle state.
+     */
+    class IdleState : public MovementState
+    {
+    public:
+        void handleMovement(std::shared_ptr<Character> character) override
+        {
+            std::cout << "Character is standing still...\n";
+            character->setState(std::make_shared<RunningState>());
+        }
+
+        std::string getStateName() const override
+        {
+            return "Idle";
+        }
+    };
+
+    /**
+     * @brief Concrete Running state.
+     */
+    class RunningState : public MovementState
+    {
+    public:
+        void handleMovement(std::shared_ptr<Character> character) override
+        {
+            std::cout << "Character is running...\n";
+            character->setState(std::make_shared<IdleState>());
+        }
+
+        std::string getStateName() const override
+        {
+            return "Running";
+        }
+    };
+};
+
+/**
+ * @brief Movement states as plain enum values for the table-driven mode.
+ */
+enum class AgentState : std::uint8_t
+{
+    Idle = 0,
+    Running = 1,
+    Count
+};
+
+/**
+ * @brief One AI agent: a byte of state plus its accumulated movement.
+ *
+ * Stored by value in contiguous arrays; nothing here allocates or refcounts.
+ */
+struct Agent
+{
+    AgentState state{AgentState::Idle};
+    float distance{0.0f}; ///< Distance covered while running.
+};
+
+/**
+ * @brief Static transition/action table indexed by the current state.
+ *
+ * Each row holds the successor state and the per-tick movement delta, so a
+ * tick is two array loads and an add — no virtual call, no allocation.
+ */
+struct StateRow
+{
+    AgentState next;
+    float moveDelta;
+};
+
+inline constexpr std::array<StateRow, static_cast<std::size_t>(AgentState::Count)> STATE_TABLE{{
+    {AgentState::Running, 0.0f}, // Idle: stand still, then start running.
+    {AgentState::Idle, 1.0f},    // Running: cover ground, then stop.
+}};
+
+/// @brief State name for reporting; mirrors MovementState::getStateName().
+constexpr const char* stateName(AgentState state)
+{
+    return state == AgentState::Idle ? "Idle" : "Running";
+}
+
+/**
+ * @brief Ticks every agent once: a linear pass over contiguous state bytes.
  */
+inline void updateAll(std::span<Agent> agents)
+{
+    for (Agent& agent : agents)
+    {
+        const StateRow& row = STATE_TABLE[static_cast<std::size_t>(agent.state)];
+        agent.distance += row.moveDelta;
+        agent.state = row.next;
+    }
+}
+
+/**
+ * @brief Demonstrates the State Pattern in a game character's movement.
+ */
+int main()
+{
+    auto player = std::make_shared<Character>();
+
+    player->printState();
+    player->move(); // Transition to Running
+    player->printState();
+    player->move(); // Transition back to Idle
+    player->printState();
+
+    // Table-driven mode: 100k agents ticked as one linear pass.
+    std::vector<Agent> agents(100000);
+    agents[0].state = AgentState::Running;
+
+    constexpr int ticks = 100;
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; ++tick)
+    {
+        updateAll(agents);
+    }
+    double tableTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Agent 0 is now: " << stateName(agents[0].state)
+              << " after covering " << agents[0].distance << " unit(s)\n";
+    std::cout << agents.size() << " agents x " << ticks << " ticks: " << tableTime << " ms ("
+              << tableTime * 1e6 / (agents.size() * ticks) << " ns per agent-tick), zero allocations\n";
 
- #include <iostream>
- #include <memory>
- 
- /**
-  * @brief Forward declaration of the Character class to avoid circular dependency.
-  */
- class Character;
- 
- /**
-  * @brief Abstract state interface defining movement behavior.
-  */
- class MovementState
- {
- public:
-     virtual ~MovementState() = default;
- 
-     /**
-      * @brief Handles movement logic for the current state.
-      * @param character Reference to the character.
-      */
-     virtual void handleMovement(std::shared_ptr<Character> character) = 0;
- 
-     /**
-      * @brief Returns the name of the current state.
-      * @return State name as a string.
-      */
-     virtual std::string getStateName() const = 0;
- };
- 
- /**
-  * @brief Represents a character that can change movement states.
-  */
- class Character : public std::enable_shared_from_this<Character>
- {
- public:
-     Character() : m_state(std::make_shared<IdleState>()) {}
- 
-     /**
-      * @brief Sets the character's movement state.
-      * @param state The new movement state.
-      */
-     void setState(std::shared_ptr<MovementState> state)
-     {
-         m_state = state;
-     }
- 
-     /**
-      * @brief Executes movement logic based on the current state.
-      */
-     void move()
-     {
-         m_state->handleMovement(shared_from_this());
-     }
- 
-     /**
-      * @brief Prints the current state of the character.
-      */
-     void printState() const
-     {
-         std::cout << "Character is now: " << m_state->getStateName() << "\n";
-     }
- 
- private:
-     std::shared_ptr<MovementState> m_state; ///< Current movement state.
- 
-     /**
-      * @brief Concrete Idle state.
-      */
-     class IdleState : public MovementState
-     {
-     public:
-         void handleMovement(std::shared_ptr<Character> character) override
-         {
-             std::cout << "Character is standing still...\n";
-             character->setState(std::make_shared<RunningState>());
-         }
- 
-         std::string getStateName() const override
-         {
-             return "Idle";
-         }
-     };
- 
-     /**
-      * @brief Concrete Running state.
-      */
-     class RunningState : public MovementState
-     {
-     public:
-         void handleMovement(std::shared_ptr<Character> character) override
-         {
-             std::cout << "Character is running...\n";
-             character->setState(std::make_shared<IdleState>());
-         }
- 
-         std::string getStateName() const override
-         {
-             return "Running";
-         }
-     };
- };
- 
- /**
-  * @brief Demonstrates the State Pattern in a game character's movement.
-  */
- int main()
- {
-     auto player = std::make_shared<Character>();
- 
-     player->printState();
-     player->move(); // Transition to Running
-     player->printState();
-     player->move(); // Transition back to Idle
-     player->printState();
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
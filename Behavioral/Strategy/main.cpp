@@ -10,99 +10,327 @@
  * - **Encapsulates algorithm variations** inside separate classes.
  * - **Allows dynamic strategy selection** at runtime.
  * - **Follows Open/Closed Principle** (new attack types can be added without modifying `Character`).
+ *
+ * Holding the strategy behind a shared_ptr and dispatching virtually per action does not
+ * scale to tens of thousands of characters per tick. InlineAttack is an SBO-based
+ * polymorphic value (no heap, no refcount) tagged with its concrete kind, and
+ * runCombatTick() groups combatants by kind and executes each group as one
+ * type-homogeneous tight loop instead of mixed virtual dispatch.
+ */
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <span>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+/**
+ * @brief Abstract strategy interface defining attack behavior.
+ */
+class AttackStrategy
+{
+public:
+    virtual ~AttackStrategy() = default;
+
+    /**
+     * @brief Executes an attack.
+     */
+    virtual void attack() const = 0;
+
+    /**
+     * @brief Damage dealt for a given character power; used by simulations.
+     */
+    virtual int damage(int power) const = 0;
+};
+
+/**
+ * @brief Concrete strategy for melee attacks.
+ */
+class MeleeAttack : public AttackStrategy
+{
+public:
+    void attack() const override
+    {
+        std::cout << "Performs a melee attack with a sword!\n";
+    }
+
+    int damage(int power) const override
+    {
+        return power * 2 + 1;
+    }
+};
+
+/**
+ * @brief Concrete strategy for ranged attacks.
+ */
+class RangedAttack : public AttackStrategy
+{
+public:
+    void attack() const override
+    {
+        std::cout << "Shoots an arrow from a bow!\n";
+    }
+
+    int damage(int power) const override
+    {
+        return power + 5;
+    }
+};
+
+/**
+ * @brief Represents a game character that can switch attack strategies.
+ */
+class Character
+{
+public:
+    /**
+     * @brief Sets the attack strategy for the character.
+     * @param strategy The new attack strategy.
+     */
+    void setAttackStrategy(std::shared_ptr<AttackStrategy> strategy)
+    {
+        m_attackStrategy = strategy;
+    }
+
+    /**
+     * @brief Executes the currently set attack strategy.
+     */
+    void performAttack() const
+    {
+        if (m_attackStrategy)
+        {
+            m_attackStrategy->attack();
+        }
+        else
+        {
+            std::cout << "No attack strategy set!\n";
+        }
+    }
+
+private:
+    std::shared_ptr<AttackStrategy> m_attackStrategy; ///< Current attack strategy.
+};
+
+/**
+ * @brief Concrete strategy kinds; the tag that makes batch grouping possible.
+ */
+enum class AttackKind : std::uint8_t
+{
+    Melee = 0,
+    Ranged = 1,
+    Count
+};
+
+/**
+ * @brief Value strategies for the batch path; plain structs, no vtable.
+ */
+struct MeleeDamage
+{
+    int weaponBonus{1};
+
+    int damage(int power) const { return power * 2 + weaponBonus; }
+};
+
+struct RangedDamage
+{
+    int arrowBonus{5};
+
+    int damage(int power) const { return power + arrowBonus; }
+};
+
+/**
+ * @brief SBO-based polymorphic strategy value: no heap, no refcount.
+ *
+ * The concrete strategy lives inline in the holder's buffer and is invoked
+ * through one stored function pointer; the kind tag lets callers regroup
+ * mixed populations into type-homogeneous batches and sidestep even that
+ * indirect call.
  */
+class InlineAttack
+{
+public:
+    static constexpr std::size_t INLINE_SIZE = 16; ///< Bytes of inline storage.
+
+    template <typename Strategy>
+    InlineAttack(Strategy strategy, AttackKind kind)
+        : m_kind(kind)
+    {
+        static_assert(sizeof(Strategy) <= INLINE_SIZE && alignof(Strategy) <= alignof(std::max_align_t),
+                      "Strategy must fit the inline buffer");
+        static_assert(std::is_trivially_copyable_v<Strategy>,
+                      "Inline strategies are copied by value");
+        new (m_storage.data()) Strategy(std::move(strategy));
+        m_invoke = [](const void* storage, int power)
+        {
+            return static_cast<const Strategy*>(storage)->damage(power);
+        };
+    }
+
+    /**
+     * @brief Generic dispatch: one indirect call, no virtual table.
+     */
+    int execute(int power) const
+    {
+        return m_invoke(m_storage.data(), power);
+    }
+
+    /**
+     * @brief Typed access for homogeneous batch loops; kind must match.
+     */
+    template <typename Strategy>
+    const Strategy& as() const
+    {
+        return *reinterpret_cast<const Strategy*>(m_storage.data());
+    }
+
+    AttackKind kind() const { return m_kind; }
+
+private:
+    alignas(std::max_align_t) std::array<std::byte, INLINE_SIZE> m_storage; ///< Inline strategy.
+    int (*m_invoke)(const void*, int);
+    AttackKind m_kind;
+};
+
+/**
+ * @brief One simulated combatant: inline strategy plus its stats, by value.
+ */
+struct Combatant
+{
+    InlineAttack attack;
+    int power;
+};
+
+/**
+ * @brief Contiguous per-kind spans over a partitioned roster.
+ *
+ * Built once while the roster is stable and reused across ticks; only roster
+ * changes require regrouping.
+ */
+struct StrategyGroups
+{
+    std::array<std::span<const Combatant>, static_cast<std::size_t>(AttackKind::Count)> spans;
+};
+
+/**
+ * @brief Partitions the roster in place so each strategy kind is contiguous.
+ *
+ * Physically reordering (rather than keeping index lists) means the batch
+ * loops stream straight through memory with no gather indirection.
+ */
+inline StrategyGroups groupByStrategy(std::span<Combatant> combatants)
+{
+    std::stable_sort(combatants.begin(), combatants.end(),
+                     [](const Combatant& a, const Combatant& b)
+                     {
+                         return a.attack.kind() < b.attack.kind();
+                     });
+    StrategyGroups groups;
+    std::size_t begin = 0;
+    for (std::size_t kind = 0; kind < groups.spans.size(); ++kind)
+    {
+        std::size_t end = begin;
+        while (end < combatants.size() &&
+               combatants[end].attack.kind() == static_cast<AttackKind>(kind))
+        {
+            ++end;
+        }
+        groups.spans[kind] = combatants.subspan(begin, end - begin);
+        begin = end;
+    }
+    return groups;
+}
+
+/**
+ * @brief Runs one combat tick over pre-grouped combatants.
+ *
+ * Each group runs as a tight loop over one concrete strategy type — the
+ * compiler sees the exact damage() body, so the mixed-population virtual
+ * dispatch becomes a couple of vectorizable linear passes.
+ *
+ * @return Total damage dealt this tick.
+ */
+inline long long runCombatTick(const StrategyGroups& groups)
+{
+    long long total = 0;
+    for (const Combatant& combatant : groups.spans[static_cast<std::size_t>(AttackKind::Melee)])
+    {
+        total += combatant.attack.as<MeleeDamage>().damage(combatant.power);
+    }
+    for (const Combatant& combatant : groups.spans[static_cast<std::size_t>(AttackKind::Ranged)])
+    {
+        total += combatant.attack.as<RangedDamage>().damage(combatant.power);
+    }
+    return total;
+}
+
+/**
+ * @brief Demonstrates the Strategy Pattern in a game character's attack system.
+ */
+int main()
+{
+    auto player = std::make_shared<Character>();
+
+    auto melee = std::make_shared<MeleeAttack>();
+    auto ranged = std::make_shared<RangedAttack>();
+
+    player->setAttackStrategy(melee);
+    player->performAttack(); // Melee attack
+
+    player->setAttackStrategy(ranged);
+    player->performAttack(); // Ranged attack
+
+    // Inline strategy values and kind-grouped batch execution.
+    constexpr int combatantCount = 50000;
+    constexpr int ticks = 30;
+
+    std::vector<Combatant> combatants;
+    combatants.reserve(combatantCount);
+    std::vector<std::pair<std::shared_ptr<AttackStrategy>, int>> virtualCombatants;
+    virtualCombatants.reserve(combatantCount);
+    for (int i = 0; i < combatantCount; ++i)
+    {
+        int power = 1 + i % 10;
+        if (i % 3 == 0)
+        {
+            combatants.push_back(Combatant{InlineAttack(RangedDamage{}, AttackKind::Ranged), power});
+            virtualCombatants.emplace_back(ranged, power);
+        }
+        else
+        {
+            combatants.push_back(Combatant{InlineAttack(MeleeDamage{}, AttackKind::Melee), power});
+            virtualCombatants.emplace_back(melee, power);
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    long long virtualTotal = 0;
+    for (int tick = 0; tick < ticks; ++tick)
+    {
+        for (const auto& [strategy, power] : virtualCombatants)
+        {
+            virtualTotal += strategy->damage(power);
+        }
+    }
+    double virtualTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    StrategyGroups groups = groupByStrategy(combatants); // Regrouped only on roster changes.
+    start = std::chrono::steady_clock::now();
+    long long batchTotal = 0;
+    for (int tick = 0; tick < ticks; ++tick)
+    {
+        batchTotal += runCombatTick(groups);
+    }
+    double batchTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << combatantCount << " combatants x " << ticks << " ticks: virtual "
+              << virtualTime << " ms, grouped batch " << batchTime << " ms (damage "
+              << virtualTotal << " / " << batchTotal << ")\n";
 
- #include <iostream>
- #include <memory>
- 
- /**
-  * @brief Abstract strategy interface defining attack behavior.
-  */
- class AttackStrategy
- {
- public:
-     virtual ~AttackStrategy() = default;
- 
-     /**
-      * @brief Executes an attack.
-      */
-     virtual void attack() const = 0;
- };
- 
- /**
-  * @brief Concrete strategy for melee attacks.
-  */
- class MeleeAttack : public AttackStrategy
- {
- public:
-     void attack() const override
-     {
-         std::cout << "Performs a melee attack with a sword!\n";
-     }
- };
- 
- /**
-  * @brief Concrete strategy for ranged attacks.
-  */
- class RangedAttack : public AttackStrategy
- {
- public:
-     void attack() const override
-     {
-         std::cout << "Shoots an arrow from a bow!\n";
-     }
- };
- 
- /**
-  * @brief Represents a game character that can switch attack strategies.
-  */
- class Character
- {
- public:
-     /**
-      * @brief Sets the attack strategy for the character.
-      * @param strategy The new attack strategy.
-      */
-     void setAttackStrategy(std::shared_ptr<AttackStrategy> strategy)
-     {
-         m_attackStrategy = strategy;
-     }
- 
-     /**
-      * @brief Executes the currently set attack strategy.
-      */
-     void performAttack() const
-     {
-         if (m_attackStrategy)
-         {
-             m_attackStrategy->attack();
-         }
-         else
-         {
-             std::cout << "No attack strategy set!\n";
-         }
-     }
- 
- private:
-     std::shared_ptr<AttackStrategy> m_attackStrategy; ///< Current attack strategy.
- };
- 
- /**
-  * @brief Demonstrates the Strategy Pattern in a game character's attack system.
-  */
- int main()
- {
-     auto player = std::make_shared<Character>();
- 
-     auto melee = std::make_shared<MeleeAttack>();
-     auto ranged = std::make_shared<RangedAttack>();
- 
-     player->setAttackStrategy(melee);
-     player->performAttack(); // Melee attack
- 
-     player->setAttackStrategy(ranged);
-     player->performAttack(); // Ranged attack
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
@@ -10,97 +10,293 @@
  * - Promotes code reuse by implementing common steps in the base class while allowing customization in subclasses.
  * - Provides a clear structure for algorithms with common steps and customizable parts.
  * - Avoids code duplication by allowing specific steps to be overridden without modifying the algorithm structure.
+ *
+ * When thousands of instances share identical intermediate steps, recomputing every
+ * stage per object is wasted work. CachedMeal lets each stage declare a cache key so
+ * identical sub-results are computed once in a shared StageCache, and prepareAll()
+ * schedules independent instances across a thread pool while each instance still runs
+ * its own steps strictly in template order.
+ */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <span>
+#include <unordered_map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+/**
+ * @brief Abstract class defining the template method for preparing a meal.
+ */
+class Meal
+{
+public:
+    // Template method defines the sequence of steps to prepare the meal.
+    void prepareMeal()
+    {
+        cookMainIngredient();
+        addCondiments();
+        serve();
+    }
+
+    virtual ~Meal() = default;
+
+private:
+    /**
+     * @brief Abstract method for cooking the main ingredient, must be implemented by subclasses.
+     */
+    virtual void cookMainIngredient() = 0;
+
+    /**
+     * @brief Abstract method for adding condiments, must be implemented by subclasses.
+     */
+    virtual void addCondiments() = 0;
+
+    /**
+     * @brief Concrete method for serving the meal. This step is common to all meals.
+     */
+    void serve()
+    {
+        std::cout << "Meal is served!" << std::endl;
+    }
+};
+
+/**
+ * @brief Concrete class implementing the vegetarian meal preparation.
+ */
+class VegetarianMeal : public Meal
+{
+private:
+    void cookMainIngredient() override
+    {
+        std::cout << "Cooking vegetarian main ingredient (tofu)." << std::endl;
+    }
+
+    void addCondiments() override
+    {
+        std::cout << "Adding vegetarian condiments (soy sauce, spices)." << std::endl;
+    }
+};
+
+/**
+ * @brief Concrete class implementing the non-vegetarian meal preparation.
  */
+class NonVegetarianMeal : public Meal
+{
+private:
+    void cookMainIngredient() override
+    {
+        std::cout << "Cooking non-vegetarian main ingredient (chicken)." << std::endl;
+    }
+
+    void addCondiments() override
+    {
+        std::cout << "Adding non-vegetarian condiments (garlic, pepper)." << std::endl;
+    }
+};
+
+/**
+ * @brief Shared store of memoized stage results, keyed by stage name + key.
+ *
+ * getOrCompute() runs the stage only when no identical result exists yet;
+ * concurrent callers of the same key may race to compute, but the cache
+ * stays consistent and every later caller hits.
+ */
+class StageCache
+{
+public:
+    /**
+     * @brief Returns the cached result for key, computing it on first use.
+     */
+    std::string getOrCompute(const std::string& key, const std::function<std::string()>& compute)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            auto it = m_entries.find(key);
+            if (it != m_entries.end())
+            {
+                m_hits.fetch_add(1, std::memory_order_relaxed);
+                return it->second;
+            }
+        }
+        std::string result = compute(); // Computed outside the lock.
+        m_computations.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard lock(m_mutex);
+        return m_entries.emplace(key, std::move(result)).first->second;
+    }
+
+    std::size_t computations() const { return m_computations.load(); }
+    std::size_t hits() const { return m_hits.load(); }
+
+private:
+    std::mutex m_mutex;
+    std::unordered_map<std::string, std::string> m_entries; ///< stage:key -> result.
+    std::atomic<std::size_t> m_computations{0};
+    std::atomic<std::size_t> m_hits{0};
+};
+
+/**
+ * @brief Template method with memoized stages for batch preparation.
+ *
+ * The skeleton is unchanged — cook, season, serve, in that order — but each
+ * overridable stage also declares a cache key describing its inputs. Stages
+ * with equal keys produce equal results, so the shared StageCache computes
+ * each distinct sub-result once across the whole batch.
+ */
+class CachedMeal
+{
+public:
+    virtual ~CachedMeal() = default;
+
+    /**
+     * @brief Template method: runs the fixed steps in order, hitting the
+     *        cache for any stage whose key was already computed.
+     */
+    std::string prepare(StageCache& cache)
+    {
+        std::string main = cache.getOrCompute("cook:" + mainIngredientKey(),
+                                              [this] { return cookMainIngredient(); });
+        std::string condiments = cache.getOrCompute("season:" + condimentsKey(),
+                                                    [this] { return addCondiments(); });
+        return serve(main, condiments);
+    }
+
+private:
+    /// @brief Cache key describing the cooking stage's inputs.
+    virtual std::string mainIngredientKey() const = 0;
+
+    /// @brief Cache key describing the seasoning stage's inputs.
+    virtual std::string condimentsKey() const = 0;
+
+    virtual std::string cookMainIngredient() const = 0;
+    virtual std::string addCondiments() const = 0;
+
+    /**
+     * @brief Common final step; cheap, so never memoized.
+     */
+    std::string serve(const std::string& main, const std::string& condiments) const
+    {
+        return main + " with " + condiments;
+    }
+};
+
+/**
+ * @brief Batch report meal: a deliberately expensive cookable stage.
+ */
+class ReportMeal : public CachedMeal
+{
+public:
+    ReportMeal(std::string ingredient, std::string condiments)
+        : m_ingredient(std::move(ingredient)), m_condiments(std::move(condiments))
+    {}
+
+private:
+    std::string mainIngredientKey() const override { return m_ingredient; }
+    std::string condimentsKey() const override { return m_condiments; }
+
+    std::string cookMainIngredient() const override
+    {
+        // Stands in for an expensive shared sub-computation.
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        for (int round = 0; round < 200000; ++round)
+        {
+            for (char c : m_ingredient)
+            {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+            }
+        }
+        return "cooked " + m_ingredient + " [" + std::to_string(hash % 1000) + "]";
+    }
+
+    std::string addCondiments() const override
+    {
+        return m_condiments;
+    }
+
+    std::string m_ingredient;  ///< Cooking-stage input; doubles as its cache key.
+    std::string m_condiments;  ///< Seasoning-stage input; doubles as its cache key.
+};
+
+/**
+ * @brief Prepares every meal in the batch across a thread pool.
+ *
+ * Instances are independent, so workers claim them from a shared atomic
+ * counter; each claimed instance still executes its own template steps in
+ * the fixed order, and all workers share one StageCache.
+ */
+inline std::vector<std::string> prepareAll(std::span<const std::shared_ptr<CachedMeal>> meals,
+                                           StageCache& cache,
+                                           unsigned threadCount)
+{
+    std::vector<std::string> results(meals.size());
+    std::atomic<std::size_t> nextIndex{0};
+    auto worker = [&]
+    {
+        for (std::size_t i = nextIndex.fetch_add(1); i < meals.size(); i = nextIndex.fetch_add(1))
+        {
+            results[i] = meals[i]->prepare(cache);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threadCount; ++t)
+    {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers)
+    {
+        thread.join();
+    }
+    return results;
+}
+
+/**
+ * @brief Demonstrates the Template Method pattern for preparing meals.
+ */
+int main()
+{
+    // Create a shared pointer to a VegetarianMeal and prepare it.
+    std::shared_ptr<Meal> vegetarianMeal = std::make_shared<VegetarianMeal>();
+    std::cout << "Preparing Vegetarian Meal:" << std::endl;
+    vegetarianMeal->prepareMeal();
+    std::cout << std::endl;
+
+    // Create a shared pointer to a NonVegetarianMeal and prepare it.
+    std::shared_ptr<Meal> nonVegetarianMeal = std::make_shared<NonVegetarianMeal>();
+    std::cout << "Preparing Non-Vegetarian Meal:" << std::endl;
+    nonVegetarianMeal->prepareMeal();
+    std::cout << std::endl;
+
+    // Memoized stages + batch preparation: 4000 instances, 4 distinct recipes.
+    constexpr std::size_t mealCount = 4000;
+    std::vector<std::shared_ptr<CachedMeal>> batch;
+    batch.reserve(mealCount);
+    for (std::size_t i = 0; i < mealCount; ++i)
+    {
+        batch.push_back(std::make_shared<ReportMeal>(i % 2 ? "tofu" : "chicken",
+                                                     i % 4 < 2 ? "soy sauce" : "pepper"));
+    }
+
+    StageCache coldCache;
+    auto start = std::chrono::steady_clock::now();
+    auto first = batch.front()->prepare(coldCache);
+    double oneTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    StageCache cache;
+    unsigned threadCount = std::max(2u, std::thread::hardware_concurrency());
+    start = std::chrono::steady_clock::now();
+    auto results = prepareAll(batch, cache, threadCount);
+    double batchTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "First meal (" << oneTime << " ms uncached): " << first << std::endl;
+    std::cout << mealCount << " meal(s) on " << threadCount << " thread(s): " << batchTime
+              << " ms, " << cache.computations() << " stage computation(s), "
+              << cache.hits() << " cache hit(s)" << std::endl;
+    std::cout << "Last meal: " << results.back() << std::endl;
 
- #include <iostream>
- #include <memory>
- 
- /**
-  * @brief Abstract class defining the template method for preparing a meal.
-  */
- class Meal
- {
- public:
-     // Template method defines the sequence of steps to prepare the meal.
-     void prepareMeal()
-     {
-         cookMainIngredient();
-         addCondiments();
-         serve();
-     }
- 
-     virtual ~Meal() = default;
- 
- private:
-     /**
-      * @brief Abstract method for cooking the main ingredient, must be implemented by subclasses.
-      */
-     virtual void cookMainIngredient() = 0;
- 
-     /**
-      * @brief Abstract method for adding condiments, must be implemented by subclasses.
-      */
-     virtual void addCondiments() = 0;
- 
-     /**
-      * @brief Concrete method for serving the meal. This step is common to all meals.
-      */
-     void serve()
-     {
-         std::cout << "Meal is served!" << std::endl;
-     }
- };
- 
- /**
-  * @brief Concrete class implementing the vegetarian meal preparation.
-  */
- class VegetarianMeal : public Meal
- {
- private:
-     void cookMainIngredient() override
-     {
-         std::cout << "Cooking vegetarian main ingredient (tofu)." << std::endl;
-     }
- 
-     void addCondiments() override
-     {
-         std::cout << "Adding vegetarian condiments (soy sauce, spices)." << std::endl;
-     }
- };
- 
- /**
-  * @brief Concrete class implementing the non-vegetarian meal preparation.
-  */
- class NonVegetarianMeal : public Meal
- {
- private:
-     void cookMainIngredient() override
-     {
-         std::cout << "Cooking non-vegetarian main ingredient (chicken)." << std::endl;
-     }
- 
-     void addCondiments() override
-     {
-         std::cout << "Adding non-vegetarian condiments (garlic, pepper)." << std::endl;
-     }
- };
- 
- /**
-  * @brief Demonstrates the Template Method pattern for preparing meals.
-  */
- int main()
- {
-     // Create a shared pointer to a VegetarianMeal and prepare it.
-     std::shared_ptr<Meal> vegetarianMeal = std::make_shared<VegetarianMeal>();
-     std::cout << "Preparing Vegetarian Meal:" << std::endl;
-     vegetarianMeal->prepareMeal();
-     std::cout << std::endl;
- 
-     // Create a shared pointer to a NonVegetarianMeal and prepare it.
-     std::shared_ptr<Meal> nonVegetarianMeal = std::make_shared<NonVegetarianMeal>();
-     std::cout << "Preparing Non-Vegetarian Meal:" << std::endl;
-     nonVegetarianMeal->prepareMeal();
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
@@ -10,134 +10,385 @@
  * - Prevents logging from blocking the main application flow.
  * - Improves responsiveness in real-time or high-throughput systems.
  * - Automatically processes logs in the background.
+ *
+ * For burst rates the classic per-message queue allocates and wakes the worker constantly,
+ * so a second transport (`RingLogger`) is included: producers copy into preallocated
+ * fixed-size ring slots (no heap allocation), the worker drains in large batches with a
+ * single wake per batch, and the overflow policy (block or drop-oldest) is selectable.
+ */
+
+#include <iostream>
+#include <queue>
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <functional>
+#include <cstring>
+#include <cstdint>
+
+/**
+ * @brief Manages an asynchronous logging system using the Active Object pattern.
+ */
+class Logger
+{
+public:
+    /**
+     * @brief Constructs the Logger and starts the worker thread.
+     */
+    Logger()
+    {
+        m_worker = std::make_unique<std::thread>(&Logger::processLogs, this);
+    }
+
+    /**
+     * @brief Destroys the Logger and ensures all logs are processed.
+     */
+    ~Logger()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_running = false;
+        }
+        m_cv.notify_one();
+        if (m_worker->joinable())
+        {
+            m_worker->join();
+        }
+    }
+
+    /**
+     * @brief Asynchronously logs a message.
+     * @param message The message to log.
+     */
+    void logMessage(const std::string& message)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_logQueue.push(message);
+        }
+        m_cv.notify_one();
+    }
+
+    /**
+     * @brief Waits for all log messages to be processed before exiting.
+     */
+    void waitForCompletion()
+    {
+        while (true)
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_logQueue.empty())
+            {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+
+private:
+    std::queue<std::string> m_logQueue; ///< Queue of log messages.
+    std::mutex m_mutex;                 ///< Protects access to the queue.
+    std::condition_variable m_cv;       ///< Notifies the worker thread.
+    std::unique_ptr<std::thread> m_worker; ///< Worker thread processing logs.
+    std::atomic<bool> m_running{true};  ///< Flag to control worker execution.
+
+    /**
+     * @brief Processes log messages asynchronously.
+     */
+    void processLogs()
+    {
+        while (true)
+        {
+            std::unique_lock lock(m_mutex);
+            m_cv.wait(lock, [this] { return !m_logQueue.empty() || !m_running; });
+
+            if (!m_running && m_logQueue.empty())
+            {
+                break;
+            }
+
+            while (!m_logQueue.empty())
+            {
+                std::cout << "Log: " << m_logQueue.front() << std::endl;
+                m_logQueue.pop();
+                // Simulate a slow logging operation
+                std::this_thread::sleep_for(std::chrono::milliseconds(2000));
+            }
+        }
+    }
+};
+
+
+/**
+ * @brief Batched asynchronous logger over a preallocated ring buffer.
+ *
+ * Producers claim a slot with one atomic increment and memcpy the message into
+ * its fixed-size preallocated buffer — no heap allocation, no lock. The worker
+ * is woken only when the ring transitions from empty to non-empty and then
+ * drains everything available in one batch, so bursts cost one wakeup, not one
+ * per message. When the ring is full the configured policy either blocks the
+ * producer or drops the oldest pending message to make room.
+ */
+class RingLogger
+{
+public:
+    /**
+     * @brief What a producer does when the ring is full.
+     */
+    enum class OverflowPolicy
+    {
+        Block,     ///< Wait for the worker to free a slot.
+        DropOldest ///< Discard the oldest pending message to make room.
+    };
+
+    static constexpr std::size_t MESSAGE_CAPACITY = 120; ///< Bytes per slot (truncating).
+
+    /**
+     * @brief Constructs the logger and starts the draining worker.
+     * @param capacity Ring size; must be a power of two.
+     * @param policy Overflow behavior when producers outrun the worker.
+     * @param sink Where drained messages go; defaults to stdout.
+     */
+    RingLogger(std::size_t capacity,
+               OverflowPolicy policy,
+               std::function<void(const char*, std::size_t)> sink = {})
+        : m_capacity(capacity), m_mask(capacity - 1), m_policy(policy),
+          m_slots(capacity), m_sink(std::move(sink))
+    {
+        for (std::size_t i = 0; i < capacity; ++i)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        if (!m_sink)
+        {
+            m_sink = [](const char* text, std::size_t length)
+            {
+                std::cout << "Log: ";
+                std::cout.write(text, static_cast<std::streamsize>(length));
+                std::cout << '\n';
+            };
+        }
+        m_worker = std::thread(&RingLogger::drainLoop, this);
+    }
+
+    ~RingLogger()
+    {
+        m_running.store(false, std::memory_order_release);
+        m_wake.notify_one();
+        m_worker.join();
+    }
+
+    /**
+     * @brief Copies a message into a preallocated slot; never allocates.
+     * @param message The message text (truncated to MESSAGE_CAPACITY bytes).
+     */
+    void log(const char* message)
+    {
+        std::size_t length = std::min(std::strlen(message), MESSAGE_CAPACITY);
+        for (;;)
+        {
+            std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+            Slot& slot = m_slots[pos & m_mask];
+            std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    std::memcpy(slot.text, message, length);
+                    slot.length = static_cast<std::uint16_t>(length);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    if (pos == m_dequeuePos.load(std::memory_order_acquire))
+                    {
+                        m_wake.notify_one(); // Ring was empty: one wake starts the batch.
+                    }
+                    return;
+                }
+            }
+            else if (diff < 0) // Ring full.
+            {
+                if (m_policy == OverflowPolicy::Block)
+                {
+                    std::this_thread::yield();
+                }
+                else
+                {
+                    char discard[MESSAGE_CAPACITY];
+                    std::uint16_t discardLength;
+                    if (tryPop(discard, discardLength))
+                    {
+                        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Blocks until every queued message has been drained.
+     */
+    void waitForCompletion()
+    {
+        while (m_dequeuePos.load(std::memory_order_acquire) !=
+               m_enqueuePos.load(std::memory_order_acquire))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    /**
+     * @brief Messages discarded by the DropOldest policy.
+     */
+    std::size_t droppedCount() const { return m_droppedCount.load(); }
+
+    /**
+     * @brief Worker wakeups and messages drained — shows the batching ratio.
+     */
+    std::size_t batchCount() const { return m_batchCount.load(); }
+    std::size_t drainedCount() const { return m_drainedCount.load(); }
+
+private:
+    /**
+     * @brief One preallocated message slot.
+     */
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        std::uint16_t length{0};
+        char text[MESSAGE_CAPACITY];
+    };
+
+    /**
+     * @brief Pops one message; used by the worker and by drop-oldest producers.
+     */
+    bool tryPop(char* text, std::uint16_t& length)
+    {
+        for (;;)
+        {
+            std::size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+            Slot& slot = m_slots[pos & m_mask];
+            std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff < 0)
+            {
+                return false; // Empty.
+            }
+            if (diff == 0 &&
+                m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                length = slot.length;
+                std::memcpy(text, slot.text, length);
+                slot.sequence.store(pos + m_capacity, std::memory_order_release);
+                return true;
+            }
+        }
+    }
+
+    /**
+     * @brief Worker loop: sleep until woken, then drain everything in one batch.
+     */
+    void drainLoop()
+    {
+        char text[MESSAGE_CAPACITY];
+        std::uint16_t length;
+        std::mutex waitMutex;
+        while (m_running.load(std::memory_order_acquire) ||
+               m_dequeuePos.load(std::memory_order_acquire) != m_enqueuePos.load(std::memory_order_acquire))
+        {
+            std::size_t drained = 0;
+            while (tryPop(text, length))
+            {
+                m_sink(text, length);
+                ++drained;
+            }
+            if (drained > 0)
+            {
+                m_batchCount.fetch_add(1, std::memory_order_relaxed);
+                m_drainedCount.fetch_add(drained, std::memory_order_relaxed);
+                continue; // More may have arrived while draining.
+            }
+            std::unique_lock lock(waitMutex);
+            m_wake.wait_for(lock, std::chrono::milliseconds(1)); // Timed as a safety net.
+        }
+    }
+
+    std::size_t m_capacity;
+    std::size_t m_mask;
+    OverflowPolicy m_policy;
+    std::vector<Slot> m_slots;                               ///< Preallocated message slots.
+    alignas(64) std::atomic<std::size_t> m_enqueuePos{0};    ///< Producer cursor.
+    alignas(64) std::atomic<std::size_t> m_dequeuePos{0};    ///< Consumer cursor.
+    std::atomic<bool> m_running{true};
+    std::atomic<std::size_t> m_droppedCount{0};
+    std::atomic<std::size_t> m_batchCount{0};
+    std::atomic<std::size_t> m_drainedCount{0};
+    std::condition_variable m_wake;                          ///< Signaled on empty-to-non-empty.
+    std::function<void(const char*, std::size_t)> m_sink;    ///< Batch-drained output.
+    std::thread m_worker;
+};
+
+/**
+ * @brief Demonstrates the Active Object pattern with an asynchronous logger.
  */
+int main()
+{
+    auto logger = std::make_shared<Logger>();
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // All calls return immediately without blocking the main thread, even though logging takes 2 sec per log
+    logger->logMessage("Starting application...");
+    logger->logMessage("User logged in");
+    logger->logMessage("Data processing started");
+    logger->logMessage("Data processing finished");
+    logger->logMessage("User logged out");
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+
+    std::cout << " --------------------\n"<< "Time taken to queue all log messages: " << duration << " ms\n--------------------\n";
+
+    // Ensure all logs are processed before program exits
+    logger->waitForCompletion();
+
+    // Ring-buffer transport: preallocated slots, batched drain, one wake per burst.
+    {
+        std::atomic<std::size_t> consumed{0};
+        RingLogger ringLogger(1024, RingLogger::OverflowPolicy::Block,
+                              [&consumed](const char*, std::size_t) { consumed.fetch_add(1, std::memory_order_relaxed); });
+
+        constexpr int messageCount = 100000;
+        auto ringStart = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < messageCount; ++i)
+        {
+            ringLogger.log("burst log line");
+        }
+        auto ringEnd = std::chrono::high_resolution_clock::now();
+        ringLogger.waitForCompletion();
+
+        auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(ringEnd - ringStart).count();
+        std::cout << "RingLogger: " << messageCount << " messages, "
+                  << nanos / messageCount << " ns per enqueue, "
+                  << ringLogger.drainedCount() << " drained in "
+                  << ringLogger.batchCount() << " batch(es)\n";
+    }
+
+    // Drop-oldest policy: producers never block even if the worker stalls.
+    {
+        RingLogger droppingLogger(8, RingLogger::OverflowPolicy::DropOldest,
+                                  [](const char*, std::size_t) { std::this_thread::sleep_for(std::chrono::microseconds(50)); });
+        for (int i = 0; i < 1000; ++i)
+        {
+            droppingLogger.log("overflowing line");
+        }
+        droppingLogger.waitForCompletion();
+        std::cout << "DropOldest policy discarded " << droppingLogger.droppedCount() << " message(s)\n";
+    }
 
- #include <iostream>
- #include <queue>
- #include <string>
- #include <memory>
- #include <thread>
- #include <mutex>
- #include <condition_variable>
- #include <atomic>
- #include <chrono>
- 
- /**
-  * @brief Manages an asynchronous logging system using the Active Object pattern.
-  */
- class Logger
- {
- public:
-     /**
-      * @brief Constructs the Logger and starts the worker thread.
-      */
-     Logger()
-     {
-         m_worker = std::make_unique<std::thread>(&Logger::processLogs, this);
-     }
- 
-     /**
-      * @brief Destroys the Logger and ensures all logs are processed.
-      */
-     ~Logger()
-     {
-         {
-             std::lock_guard lock(m_mutex);
-             m_running = false;
-         }
-         m_cv.notify_one();
-         if (m_worker->joinable())
-         {
-             m_worker->join();
-         }
-     }
- 
-     /**
-      * @brief Asynchronously logs a message.
-      * @param message The message to log.
-      */
-     void logMessage(const std::string& message)
-     {
-         {
-             std::lock_guard lock(m_mutex);
-             m_logQueue.push(message);
-         }
-         m_cv.notify_one();
-     }
- 
-     /**
-      * @brief Waits for all log messages to be processed before exiting.
-      */
-     void waitForCompletion()
-     {
-         while (true)
-         {
-             std::lock_guard lock(m_mutex);
-             if (m_logQueue.empty())
-             {
-                 break;
-             }
-             std::this_thread::sleep_for(std::chrono::milliseconds(100));
-         }
-     }
- 
- private:
-     std::queue<std::string> m_logQueue; ///< Queue of log messages.
-     std::mutex m_mutex;                 ///< Protects access to the queue.
-     std::condition_variable m_cv;       ///< Notifies the worker thread.
-     std::unique_ptr<std::thread> m_worker; ///< Worker thread processing logs.
-     std::atomic<bool> m_running{true};  ///< Flag to control worker execution.
- 
-     /**
-      * @brief Processes log messages asynchronously.
-      */
-     void processLogs()
-     {
-         while (true)
-         {
-             std::unique_lock lock(m_mutex);
-             m_cv.wait(lock, [this] { return !m_logQueue.empty() || !m_running; });
- 
-             if (!m_running && m_logQueue.empty())
-             {
-                 break;
-             }
- 
-             while (!m_logQueue.empty())
-             {
-                 std::cout << "Log: " << m_logQueue.front() << std::endl;
-                 m_logQueue.pop();
-                 // Simulate a slow logging operation
-                 std::this_thread::sleep_for(std::chrono::milliseconds(2000));
-             }
-         }
-     }
- };
- 
- /**
-  * @brief Demonstrates the Active Object pattern with an asynchronous logger.
-  */
- int main()
- {
-     auto logger = std::make_shared<Logger>();
- 
-     auto startTime = std::chrono::high_resolution_clock::now();
- 
-     // All calls return immediately without blocking the main thread, even though logging takes 2 sec per log
-     logger->logMessage("Starting application...");
-     logger->logMessage("User logged in");
-     logger->logMessage("Data processing started");
-     logger->logMessage("Data processing finished");
-     logger->logMessage("User logged out");
- 
-     auto endTime = std::chrono::high_resolution_clock::now();
-     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
- 
-     std::cout << " --------------------\n"<< "Time taken to queue all log messages: " << duration << " ms\n--------------------\n";
- 
-     // Ensure all logs are processed before program exits
-     logger->waitForCompletion();
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
@@ -1,60 +1,407 @@
 /**
  * @brief
  * The Future design pattern simplifies working with asynchronous programming by allowing you to get the result of an operation that may not be complete yet.
- * 
+ *
  * Key Concepts:
  * - Asynchronous computation: Enables non-blocking operations, where the computation may occur in the background.
  * - Future: An object that represents the result of an operation that may be in progress, allowing you to retrieve the result later.
  * - Promises: Used to set the result of the computation at some point in the future.
- * 
+ *
  * Benefits:
  * - Simplifies concurrency: Allows performing operations in parallel without blocking the main thread.
  * - Synchronizes results: You can retrieve the result once the task is completed without needing to manually manage synchronization.
  * - Suitable for I/O-bound or long-running tasks: Ideal for operations like file reading, network requests, or complex calculations.
+ *
+ * Bare std::async spawns a thread per call and offers only a blocking get(). The
+ * lightweight library below adds LightFuture/LightPromise with then() continuation
+ * chaining, whenAll/whenAny combinators and a shared TaskPool, and completes inline:
+ * a continuation attached to a ready future runs immediately on the attaching thread,
+ * so chains of ready futures cost nanoseconds instead of scheduler round trips.
  */
 
- #include <iostream>
- #include <thread>
- #include <future>
- #include <chrono>
- 
- /**
-  * @brief Simulates a long-running asynchronous operation.
-  * 
-  * This function simulates a computation by sleeping for a few seconds,
-  * then returns the computed result.
-  * 
-  * @param input The input value for the computation.
-  * @return The computed result (input * 2).
-  */
- int longRunningComputation(int input)
- {
-     std::this_thread::sleep_for(std::chrono::seconds(2));  // Simulate work
-     return input * 2;
- }
- 
- /**
-  * @brief Main function to demonstrate the Future pattern.
-  * 
-  * In this function, we initiate an asynchronous computation using std::async
-  * and then retrieve the result using std::future.
-  * 
-  * @return int Exit status.
-  */
- int main()
- {
-     // Create a future that will hold the result of the asynchronous task
-     std::future<int> resultFuture = std::async(std::launch::async, longRunningComputation, 10);
- 
-     // Perform other tasks while the long-running computation is in progress
-     std::cout << "Doing some other work while waiting for the result...\n";
- 
-     // Get the result of the asynchronous operation (this will block until the computation is complete)
-     int result = resultFuture.get();  // Blocks here until the result is available
- 
-     // Output the result of the computation
-     std::cout << "The result of the computation is: " << result << "\n";
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <thread>
+#include <future>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <optional>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <type_traits>
+
+/**
+ * @brief Shared completion state behind one future/promise pair.
+ *
+ * Continuations attached before completion are stored; the completing
+ * thread runs them when the value arrives. A continuation attached after
+ * completion runs inline on the attaching thread — no queueing, no wakeup.
+ */
+template <typename T>
+class FutureState
+{
+public:
+    /**
+     * @brief Publishes the value and runs any stored continuations inline.
+     */
+    void set(T value)
+    {
+        std::vector<std::function<void(const T&)>> pending;
+        {
+            std::lock_guard lock(m_mutex);
+            m_value = std::move(value);
+            pending.swap(m_continuations);
+        }
+        m_ready.notify_all();
+        for (auto& continuation : pending)
+        {
+            continuation(*m_value); // Inline on the completing thread.
+        }
+    }
+
+    /**
+     * @brief Attaches a continuation; runs it immediately when already ready.
+     */
+    void onReady(std::function<void(const T&)> continuation)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            if (!m_value)
+            {
+                m_continuations.push_back(std::move(continuation));
+                return;
+            }
+        }
+        continuation(*m_value); // Already complete: inline on this thread.
+    }
+
+    /**
+     * @brief Blocks until the value is available.
+     */
+    const T& get()
+    {
+        std::unique_lock lock(m_mutex);
+        m_ready.wait(lock, [this] { return m_value.has_value(); });
+        return *m_value;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_ready;
+    std::optional<T> m_value;                                  ///< Set exactly once.
+    std::vector<std::function<void(const T&)>> m_continuations; ///< Pending callbacks.
+};
+
+template <typename T>
+class LightFuture;
+
+/**
+ * @brief Producer side: completes the shared state exactly once.
+ */
+template <typename T>
+class LightPromise
+{
+public:
+    LightPromise() : m_state(std::make_shared<FutureState<T>>()) {}
+
+    /// @brief The consumer handle bound to this promise.
+    LightFuture<T> getFuture() const { return LightFuture<T>(m_state); }
+
+    /// @brief Completes the promise; continuations run on this thread.
+    void setValue(T value) { m_state->set(std::move(value)); }
+
+private:
+    std::shared_ptr<FutureState<T>> m_state;
+};
+
+/**
+ * @brief Consumer side: blocking get(), plus non-blocking then() chaining.
+ */
+template <typename T>
+class LightFuture
+{
+public:
+    explicit LightFuture(std::shared_ptr<FutureState<T>> state) : m_state(std::move(state)) {}
+
+    /// @brief Blocks until the value arrives.
+    const T& get() { return m_state->get(); }
+
+    /// @brief Attaches a raw callback; used by the combinators.
+    void onReady(std::function<void(const T&)> continuation)
+    {
+        m_state->onReady(std::move(continuation));
+    }
+
+    /**
+     * @brief Chains a transformation; returns the future of its result.
+     *
+     * The transformation runs on whichever thread completes this future —
+     * inline and immediately when the future is already ready.
+     */
+    template <typename Fn>
+    auto then(Fn fn) -> LightFuture<std::invoke_result_t<Fn, const T&>>
+    {
+        using R = std::invoke_result_t<Fn, const T&>;
+        auto next = std::make_shared<FutureState<R>>();
+        m_state->onReady([next, fn = std::move(fn)](const T& value)
+        {
+            next->set(fn(value));
+        });
+        return LightFuture<R>(next);
+    }
+
+private:
+    std::shared_ptr<FutureState<T>> m_state;
+};
+
+/**
+ * @brief Shared worker pool: tasks reuse long-lived threads.
+ *
+ * submit() returns a LightFuture completed by whichever worker runs the
+ * task, so continuations chain straight onto pool results without any
+ * per-call thread spawn.
+ */
+class TaskPool
+{
+public:
+    explicit TaskPool(unsigned threadCount)
+    {
+        for (unsigned t = 0; t < threadCount; ++t)
+        {
+            m_workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~TaskPool()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief Schedules fn on the pool and returns the future of its result.
+     */
+    template <typename Fn>
+    auto submit(Fn fn) -> LightFuture<std::invoke_result_t<Fn>>
+    {
+        using R = std::invoke_result_t<Fn>;
+        LightPromise<R> promise;
+        LightFuture<R> future = promise.getFuture();
+        {
+            std::lock_guard lock(m_mutex);
+            m_tasks.push_back([promise, fn = std::move(fn)]() mutable
+            {
+                promise.setValue(fn());
+            });
+        }
+        m_wake.notify_one();
+        return future;
+    }
+
+private:
+    void workerLoop()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(m_mutex);
+                m_wake.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+                if (m_stopping && m_tasks.empty())
+                {
+                    return;
+                }
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_tasks; ///< Pending work, FIFO.
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping{false};
+};
+
+/**
+ * @brief Completes when every input future has completed.
+ * @return Future of all values, in input order.
+ */
+template <typename T>
+LightFuture<std::vector<T>> whenAll(std::vector<LightFuture<T>> futures)
+{
+    struct AllState
+    {
+        std::vector<T> values;
+        std::atomic<std::size_t> remaining;
+        std::shared_ptr<FutureState<std::vector<T>>> out = std::make_shared<FutureState<std::vector<T>>>();
+    };
+    auto state = std::make_shared<AllState>();
+    state->values.resize(futures.size());
+    state->remaining.store(futures.size());
+    for (std::size_t i = 0; i < futures.size(); ++i)
+    {
+        futures[i].onReady([state, i](const T& value)
+        {
+            state->values[i] = value; // Each callback owns its own slot.
+            if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                state->out->set(std::move(state->values));
+            }
+        });
+    }
+    return LightFuture<std::vector<T>>(state->out);
+}
+
+/**
+ * @brief Completes with the first input future to complete.
+ */
+template <typename T>
+LightFuture<T> whenAny(std::vector<LightFuture<T>> futures)
+{
+    struct AnyState
+    {
+        std::atomic<bool> won{false};
+        std::shared_ptr<FutureState<T>> out = std::make_shared<FutureState<T>>();
+    };
+    auto state = std::make_shared<AnyState>();
+    for (auto& future : futures)
+    {
+        future.onReady([state](const T& value)
+        {
+            if (!state->won.exchange(true, std::memory_order_acq_rel))
+            {
+                state->out->set(value);
+            }
+        });
+    }
+    return LightFuture<T>(state->out);
+}
+
+/**
+ * @brief Simulates a long-running asynchronous operation.
+ *
+ * This function simulates a computation by sleeping for a few seconds,
+ * then returns the computed result.
+ *
+ * @param input The input value for the computation.
+ * @return The computed result (input * 2).
+ */
+int longRunningComputation(int input)
+{
+    std::this_thread::sleep_for(std::chrono::seconds(2));  // Simulate work
+    return input * 2;
+}
+
+/**
+ * @brief Main function to demonstrate the Future pattern.
+ *
+ * In this function, we initiate an asynchronous computation using std::async
+ * and then retrieve the result using std::future.
+ *
+ * @return int Exit status.
+ */
+int main()
+{
+    // Create a future that will hold the result of the asynchronous task
+    std::future<int> resultFuture = std::async(std::launch::async, longRunningComputation, 10);
+
+    // Perform other tasks while the long-running computation is in progress
+    std::cout << "Doing some other work while waiting for the result...\n";
+
+    // Get the result of the asynchronous operation (this will block until the computation is complete)
+    int result = resultFuture.get();  // Blocks here until the result is available
+
+    // Output the result of the computation
+    std::cout << "The result of the computation is: " << result << "\n";
+
+    // Lightweight futures: pooled fan-out, combinators, inline completion.
+    TaskPool pool(std::max(2u, std::thread::hardware_concurrency()));
+
+    // Fan out sub-operations on the shared pool and join with whenAll.
+    std::vector<LightFuture<int>> subOperations;
+    for (int i = 0; i < 32; ++i)
+    {
+        subOperations.push_back(pool.submit([i] { return i * i; })
+                                    .then([](const int& v) { return v + 1; }));
+    }
+    LightFuture<std::vector<int>> joined = whenAll(std::move(subOperations));
+    int fanOutSum = 0;
+    for (int value : joined.get())
+    {
+        fanOutSum += value;
+    }
+    std::cout << "whenAll over 32 pooled sub-operations: sum = " << fanOutSum << "\n";
+
+    // whenAny resolves with the fastest of competing replicas.
+    std::vector<LightFuture<int>> replicas;
+    for (int i = 0; i < 3; ++i)
+    {
+        replicas.push_back(pool.submit([i]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10 * (3 - i)));
+            return i;
+        }));
+    }
+    std::cout << "whenAny picked replica " << whenAny(std::move(replicas)).get() << "\n";
+
+    // Inline completion: a chain over a ready future never leaves this thread.
+    constexpr int chainLength = 100000;
+    LightPromise<int> readyPromise;
+    readyPromise.setValue(0);
+    LightFuture<int> chain = readyPromise.getFuture();
+    auto startChain = std::chrono::steady_clock::now();
+    for (int i = 0; i < chainLength; ++i)
+    {
+        chain = chain.then([](const int& v) { return v + 1; });
+    }
+    double chainTime = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startChain).count();
+    std::cout << chainLength << "-link ready chain: value " << chain.get() << ", "
+              << chainTime / chainLength << " ns per link\n";
+
+    // Thread churn vs shared pool for many small tasks.
+    constexpr int taskCount = 300;
+    auto startAsync = std::chrono::steady_clock::now();
+    {
+        std::vector<std::future<int>> futures;
+        for (int i = 0; i < taskCount; ++i)
+        {
+            futures.push_back(std::async(std::launch::async, [i] { return i; }));
+        }
+        for (auto& future : futures)
+        {
+            future.get();
+        }
+    }
+    double asyncTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startAsync).count();
+
+    auto startPool = std::chrono::steady_clock::now();
+    {
+        std::vector<LightFuture<int>> futures;
+        for (int i = 0; i < taskCount; ++i)
+        {
+            futures.push_back(pool.submit([i] { return i; }));
+        }
+        for (auto& future : futures)
+        {
+            future.get();
+        }
+    }
+    double poolTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startPool).count();
+    std::cout << taskCount << " small task(s): std::async " << asyncTime
+              << " ms (one thread each), shared pool " << poolTime << " ms\n";
+
+    return 0;
+}
@@ -10,95 +10,266 @@
  * - Prevents unnecessary CPU usage in multithreading.
  * - Ensures data is accessed only when available.
  * - Avoids race conditions with proper locking mechanisms.
+ *
+ * Parking on the condition variable for every empty check and signaling per enqueue
+ * costs a futex sleep/wake per item, which is brutal when items arrive in bursts
+ * microseconds apart. BurstQueue adds an adaptive wait — bounded spin, then yield,
+ * then block — plus putAll() batch enqueue that wakes waiters once per batch and
+ * takeUpTo() batch dequeue, cutting wakeups by an order of magnitude under bursts.
+ */
+
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <memory>
+#include <chrono>
+#include <span>
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief A thread-safe queue implementing the Guarded Suspension pattern.
  */
+class GuardedQueue
+{
+public:
+    /**
+     * @brief Adds data to the queue and notifies the consumer.
+     * @param value The integer value to add.
+     */
+    void addData(int value)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_dataQueue.push(value);
+        }
+        m_cv.notify_one();
+    }
+
+    /**
+     * @brief Retrieves and removes data from the queue, suspending if empty.
+     * @return The retrieved integer value.
+     */
+    int getData()
+    {
+        std::unique_lock lock(m_mutex);
+        m_cv.wait(lock, [this] { return !m_dataQueue.empty(); }); // Suspend if queue is empty
+
+        int value = m_dataQueue.front();
+        m_dataQueue.pop();
+        return value;
+    }
+
+private:
+    std::queue<int> m_dataQueue; ///< Queue storing integer values.
+    std::mutex m_mutex;          ///< Mutex for thread safety.
+    std::condition_variable m_cv; ///< Condition variable for synchronization.
+};
+
+/**
+ * @brief Guarded queue tuned for bursty traffic.
+ *
+ * Producers enqueue whole bursts under one lock and wake waiters once per
+ * batch, only when someone is actually parked. Consumers drain up to n items
+ * per call and wait adaptively: a bounded spin on an approximate size counter
+ * first (items arriving microseconds later are caught without any syscall),
+ * then a few yields, and only then a real condition-variable block.
+ */
+class BurstQueue
+{
+public:
+    static constexpr int SPIN_LIMIT = 4000; ///< Empty-check spins before yielding.
+    static constexpr int YIELD_LIMIT = 16;  ///< Yields before blocking for real.
+
+    /**
+     * @brief Enqueues one value; a batch of one.
+     */
+    void put(int value)
+    {
+        putAll(std::span<const int>(&value, 1));
+    }
+
+    /**
+     * @brief Enqueues a whole burst under one lock with at most one wakeup.
+     */
+    void putAll(std::span<const int> values)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            for (int value : values)
+            {
+                m_dataQueue.push(value);
+            }
+            m_approxSize.store(m_dataQueue.size(), std::memory_order_release);
+        }
+        if (m_waiters.load(std::memory_order_acquire) > 0)
+        {
+            m_cv.notify_all(); // Once per batch, and only when someone sleeps.
+            m_signals.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Dequeues up to out.size() items, suspending adaptively if empty.
+     * @return The number of items written to out; always at least one.
+     */
+    std::size_t takeUpTo(std::span<int> out)
+    {
+        // Phase 1: spin — bursts land microseconds apart, so most waits end here.
+        for (int spin = 0; spin < SPIN_LIMIT; ++spin)
+        {
+            if (m_approxSize.load(std::memory_order_acquire) > 0)
+            {
+                break;
+            }
+        }
+        // Phase 2: yield the core a few times before paying for a real sleep.
+        for (int attempt = 0; attempt < YIELD_LIMIT && m_approxSize.load(std::memory_order_acquire) == 0; ++attempt)
+        {
+            std::this_thread::yield();
+        }
+
+        std::unique_lock lock(m_mutex);
+        if (m_dataQueue.empty())
+        {
+            // Phase 3: block until a producer signals.
+            m_waiters.fetch_add(1, std::memory_order_acq_rel);
+            m_blockedWaits.fetch_add(1, std::memory_order_relaxed);
+            m_cv.wait(lock, [this] { return !m_dataQueue.empty(); });
+            m_waiters.fetch_sub(1, std::memory_order_acq_rel);
+        }
+        std::size_t taken = 0;
+        while (taken < out.size() && !m_dataQueue.empty())
+        {
+            out[taken++] = m_dataQueue.front();
+            m_dataQueue.pop();
+        }
+        m_approxSize.store(m_dataQueue.size(), std::memory_order_release);
+        return taken;
+    }
+
+    std::size_t signals() const { return m_signals.load(); }
+    std::size_t blockedWaits() const { return m_blockedWaits.load(); }
+
+private:
+    std::queue<int> m_dataQueue;             ///< Queued values.
+    std::mutex m_mutex;                      ///< Guards the queue.
+    std::condition_variable m_cv;            ///< Parks consumers that ran out of spins.
+    std::atomic<std::size_t> m_approxSize{0}; ///< Lock-free size hint for spinners.
+    std::atomic<int> m_waiters{0};           ///< Consumers currently blocked.
+    std::atomic<std::size_t> m_signals{0};   ///< notify_all calls actually issued.
+    std::atomic<std::size_t> m_blockedWaits{0}; ///< Waits that reached the cv.
+};
+
+/**
+ * @brief Simulates a data producer that generates values and adds them to the queue.
+ * @param queue Shared queue instance.
+ */
+void producer(std::shared_ptr<GuardedQueue> queue)
+{
+    for (int i = 1; i <= 5; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1000)); // Simulate delay
+        queue->addData(i);
+        std::cout << "Produced: " << i << std::endl;
+    }
+}
+
+/**
+ * @brief Simulates a data consumer that retrieves values from the queue.
+ * @param queue Shared queue instance.
+ */
+void consumer(std::shared_ptr<GuardedQueue> queue)
+{
+    for (int i = 1; i <= 5; ++i)
+    {
+        int value = queue->getData();
+        std::cout << "Consumed: " << value << std::endl;
+    }
+}
+
+/**
+ * @brief Demonstrates the Guarded Suspension pattern with producer-consumer threads.
+ */
+int main()
+{
+    auto queue = std::make_shared<GuardedQueue>();
+
+    std::thread producerThread(producer, queue);
+    std::thread consumerThread(consumer, queue);
+
+    producerThread.join();
+    consumerThread.join();
+
+    // Burst mode: batch enqueue/dequeue with adaptive spin-then-wait.
+    constexpr int burstCount = 200;
+    constexpr int burstSize = 256;
+    constexpr int totalItems = burstCount * burstSize;
+
+    auto classic = std::make_shared<GuardedQueue>();
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::thread classicProducer([classic]
+        {
+            for (int i = 0; i < totalItems; ++i)
+            {
+                classic->addData(i); // One lock + one notify per item.
+            }
+        });
+        std::thread classicConsumer([classic]
+        {
+            for (int i = 0; i < totalItems; ++i)
+            {
+                classic->getData();
+            }
+        });
+        classicProducer.join();
+        classicConsumer.join();
+    }
+    double classicTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    auto bursty = std::make_shared<BurstQueue>();
+    long long burstSum = 0;
+    start = std::chrono::steady_clock::now();
+    {
+        std::thread burstProducer([bursty]
+        {
+            std::vector<int> burst(burstSize);
+            for (int b = 0; b < burstCount; ++b)
+            {
+                for (int i = 0; i < burstSize; ++i)
+                {
+                    burst[i] = b * burstSize + i;
+                }
+                bursty->putAll(burst);
+            }
+        });
+        std::thread burstConsumer([bursty, &burstSum]
+        {
+            std::vector<int> items(64);
+            int received = 0;
+            while (received < totalItems)
+            {
+                std::size_t taken = bursty->takeUpTo(items);
+                received += static_cast<int>(taken);
+                for (std::size_t i = 0; i < taken; ++i)
+                {
+                    burstSum += items[i];
+                }
+            }
+        });
+        burstProducer.join();
+        burstConsumer.join();
+    }
+    double burstTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << totalItems << " item(s): per-item queue " << classicTime << " ms ("
+              << totalItems << " notifies), burst queue " << burstTime << " ms ("
+              << bursty->signals() << " notifies, " << bursty->blockedWaits()
+              << " real sleep(s), checksum " << burstSum << ")" << std::endl;
 
- #include <iostream>
- #include <thread>
- #include <mutex>
- #include <condition_variable>
- #include <queue>
- #include <memory>
- #include <chrono>
- 
- /**
-  * @brief A thread-safe queue implementing the Guarded Suspension pattern.
-  */
- class GuardedQueue
- {
- public:
-     /**
-      * @brief Adds data to the queue and notifies the consumer.
-      * @param value The integer value to add.
-      */
-     void addData(int value)
-     {
-         {
-             std::lock_guard lock(m_mutex);
-             m_dataQueue.push(value);
-         }
-         m_cv.notify_one();
-     }
- 
-     /**
-      * @brief Retrieves and removes data from the queue, suspending if empty.
-      * @return The retrieved integer value.
-      */
-     int getData()
-     {
-         std::unique_lock lock(m_mutex);
-         m_cv.wait(lock, [this] { return !m_dataQueue.empty(); }); // Suspend if queue is empty
- 
-         int value = m_dataQueue.front();
-         m_dataQueue.pop();
-         return value;
-     }
- 
- private:
-     std::queue<int> m_dataQueue; ///< Queue storing integer values.
-     std::mutex m_mutex;          ///< Mutex for thread safety.
-     std::condition_variable m_cv; ///< Condition variable for synchronization.
- };
- 
- /**
-  * @brief Simulates a data producer that generates values and adds them to the queue.
-  * @param queue Shared queue instance.
-  */
- void producer(std::shared_ptr<GuardedQueue> queue)
- {
-     for (int i = 1; i <= 5; ++i)
-     {
-         std::this_thread::sleep_for(std::chrono::milliseconds(1000)); // Simulate delay
-         queue->addData(i);
-         std::cout << "Produced: " << i << std::endl;
-     }
- }
- 
- /**
-  * @brief Simulates a data consumer that retrieves values from the queue.
-  * @param queue Shared queue instance.
-  */
- void consumer(std::shared_ptr<GuardedQueue> queue)
- {
-     for (int i = 1; i <= 5; ++i)
-     {
-         int value = queue->getData();
-         std::cout << "Consumed: " << value << std::endl;
-     }
- }
- 
- /**
-  * @brief Demonstrates the Guarded Suspension pattern with producer-consumer threads.
-  */
- int main()
- {
-     auto queue = std::make_shared<GuardedQueue>();
- 
-     std::thread producerThread(producer, queue);
-     std::thread consumerThread(consumer, queue);
- 
-     producerThread.join();
-     consumerThread.join();
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
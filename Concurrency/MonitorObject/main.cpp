@@ -10,99 +10,243 @@
  * - Prevents race conditions in concurrent transactions.
  * - Ensures fairness by suspending insufficient withdrawals instead of failing.
  * - Encapsulates all synchronization logic within the object.
+ *
+ * Serializing reads and writes behind the same mutex makes readers queue behind
+ * writers even though reads dominate 100:1 in accounting workloads. The seqlock
+ * variant below keeps every mutation inside the monitor's mutex but has writers
+ * bump a version counter around the change; readers validate the version before
+ * and after a lock-free read and retry on a concurrent write, so the dominant
+ * read path never touches the lock.
+ */
+
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <condition_variable>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Thread-safe bank account with blocking withdrawals.
+ */
+class BankAccount
+{
+public:
+    /**
+     * @brief Constructs a bank account with an initial balance.
+     * @param initialBalance The starting balance.
+     */
+    explicit BankAccount(double initialBalance) : m_balance(initialBalance) {}
+
+    /**
+     * @brief Deposits money into the account safely and notifies waiting withdrawals.
+     * @param amount The amount to deposit.
+     */
+    void deposit(double amount)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_balance += amount;
+            std::cout << "Deposited: $" << amount << " | Balance: $" << m_balance << std::endl;
+        }
+        m_cv.notify_all(); // Notify waiting threads
+    }
+
+    /**
+     * @brief Withdraws money safely, blocking if insufficient funds.
+     * @param amount The amount to withdraw.
+     */
+    void withdraw(double amount)
+    {
+        std::unique_lock lock(m_mutex);
+        if (m_balance<amount) std::cout << "Not enough funds. Awaiting for a deposit..." << std::endl;
+        m_cv.wait(lock, [&] { return m_balance >= amount; }); // Wait until enough balance
+
+        m_balance -= amount;
+        std::cout << "Withdrawn: $" << amount << " | Balance: $" << m_balance << std::endl;
+    }
+
+    /**
+     * @brief Retrieves the current balance safely.
+     * @return The current balance.
+     */
+    double getBalance()
+    {
+        std::lock_guard lock(m_mutex);
+        return m_balance;
+    }
+
+private:
+    double m_balance; ///< The bank account balance.
+    std::mutex m_mutex; ///< Mutex for synchronizing access.
+    std::condition_variable m_cv; ///< Condition variable to manage waiting withdrawals.
+};
+
+/**
+ * @brief I/O-free monitor account: the baseline for the mixed-workload benchmark.
+ *
+ * Same locking discipline as BankAccount — every operation, reads included,
+ * takes the one mutex — without the console output that would dominate timing.
+ */
+class PlainMonitorAccount
+{
+public:
+    explicit PlainMonitorAccount(double initialBalance) : m_balance(initialBalance) {}
+
+    void deposit(double amount)
+    {
+        std::lock_guard lock(m_mutex);
+        m_balance += amount;
+    }
+
+    double getBalance() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_balance;
+    }
+
+private:
+    double m_balance;
+    mutable std::mutex m_mutex;
+};
+
+/**
+ * @brief Monitor account with seqlock-style optimistic reads.
+ *
+ * Writers still serialize on the monitor mutex, preserving the invariants,
+ * but they increment the version to an odd value before mutating and back to
+ * even after. Readers never lock: they snapshot the version, read the
+ * balance, and re-validate — retrying in the rare case a write overlapped.
+ * At 100 reads per write, the retry rate is negligible and reads are
+ * contention-free.
+ */
+class SeqlockBankAccount
+{
+public:
+    explicit SeqlockBankAccount(double initialBalance) : m_balance(initialBalance) {}
+
+    /**
+     * @brief Deposits under the monitor mutex, versioned for readers.
+     */
+    void deposit(double amount)
+    {
+        std::lock_guard lock(m_mutex);
+        m_version.fetch_add(1, std::memory_order_release); // Odd: write in progress.
+        std::atomic_ref<double>(m_balance).store(m_balance + amount, std::memory_order_relaxed);
+        m_version.fetch_add(1, std::memory_order_release); // Even: write complete.
+    }
+
+    /**
+     * @brief Lock-free optimistic read; retries while a write overlaps.
+     */
+    double getBalance() const
+    {
+        for (;;)
+        {
+            std::uint64_t before = m_version.load(std::memory_order_acquire);
+            if (before % 2 == 0)
+            {
+                double balance = std::atomic_ref<const double>(m_balance).load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_version.load(std::memory_order_relaxed) == before)
+                {
+                    return balance;
+                }
+            }
+            m_retries.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t retries() const { return m_retries.load(); }
+
+private:
+    double m_balance;                              ///< Guarded by m_mutex for writers.
+    std::mutex m_mutex;                            ///< Writers only; readers never lock.
+    std::atomic<std::uint64_t> m_version{0};       ///< Odd while a write is in flight.
+    mutable std::atomic<std::size_t> m_retries{0}; ///< Optimistic reads that had to retry.
+};
+
+/**
+ * @brief Times a mixed read/write workload across threads.
+ * @param readsPerWrite Reads issued between consecutive deposits per thread.
+ */
+template <typename Account>
+double runMixedWorkload(Account& account, int threadCount, int opsPerThread, int readsPerWrite)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        workers.emplace_back([&account, opsPerThread, readsPerWrite]
+        {
+            double sink = 0.0;
+            for (int i = 0; i < opsPerThread; ++i)
+            {
+                if (i % (readsPerWrite + 1) == 0)
+                {
+                    account.deposit(1.0);
+                }
+                else
+                {
+                    sink += account.getBalance();
+                }
+            }
+            std::atomic_ref<double> keep(sink); // Keep the reads observable.
+            keep.load(std::memory_order_relaxed);
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Demonstrates the Monitor Object pattern with a bank account.
  */
+int main()
+{
+    auto account = std::make_shared<BankAccount>(50.0);
+
+    std::cout << "Initial Balance: $" << account->getBalance() << std::endl;
+
+    std::vector<std::thread> threads;
+
+    // Attempt to withdraw more than the available balance (this will block)
+    std::cout << "Attempting to withdraw 100..." << std::endl;
+    threads.emplace_back([&] { account->withdraw(100.0); });
+
+    // Simulate delay before deposit
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+
+    // Deposit enough money to unblock the withdrawal
+    threads.emplace_back([&] { account->deposit(100.0); });
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::cout << "Final Balance: $" << account->getBalance() << std::endl;
+
+    // Optimistic reads vs the plain monitor at several read/write ratios.
+    constexpr int threadCount = 4;
+    constexpr int opsPerThread = 500000;
+    for (int readsPerWrite : {10, 100, 1000})
+    {
+        PlainMonitorAccount plain(0.0);
+        double plainTime = runMixedWorkload(plain, threadCount, opsPerThread, readsPerWrite);
+
+        SeqlockBankAccount seqlock(0.0);
+        double seqlockTime = runMixedWorkload(seqlock, threadCount, opsPerThread, readsPerWrite);
 
- #include <iostream>
- #include <thread>
- #include <mutex>
- #include <memory>
- #include <vector>
- #include <condition_variable>
- #include <chrono>
- 
- /**
-  * @brief Thread-safe bank account with blocking withdrawals.
-  */
- class BankAccount
- {
- public:
-     /**
-      * @brief Constructs a bank account with an initial balance.
-      * @param initialBalance The starting balance.
-      */
-     explicit BankAccount(double initialBalance) : m_balance(initialBalance) {}
- 
-     /**
-      * @brief Deposits money into the account safely and notifies waiting withdrawals.
-      * @param amount The amount to deposit.
-      */
-     void deposit(double amount)
-     {
-         {
-             std::lock_guard lock(m_mutex);
-             m_balance += amount;
-             std::cout << "Deposited: $" << amount << " | Balance: $" << m_balance << std::endl;
-         }
-         m_cv.notify_all(); // Notify waiting threads
-     }
- 
-     /**
-      * @brief Withdraws money safely, blocking if insufficient funds.
-      * @param amount The amount to withdraw.
-      */
-     void withdraw(double amount)
-     {
-         std::unique_lock lock(m_mutex);
-         if (m_balance<amount) std::cout << "Not enough funds. Awaiting for a deposit..." << std::endl;
-         m_cv.wait(lock, [&] { return m_balance >= amount; }); // Wait until enough balance
- 
-         m_balance -= amount;
-         std::cout << "Withdrawn: $" << amount << " | Balance: $" << m_balance << std::endl;
-     }
- 
-     /**
-      * @brief Retrieves the current balance safely.
-      * @return The current balance.
-      */
-     double getBalance()
-     {
-         std::lock_guard lock(m_mutex);
-         return m_balance;
-     }
- 
- private:
-     double m_balance; ///< The bank account balance.
-     std::mutex m_mutex; ///< Mutex for synchronizing access.
-     std::condition_variable m_cv; ///< Condition variable to manage waiting withdrawals.
- };
- 
- /**
-  * @brief Demonstrates the Monitor Object pattern with a bank account.
-  */
- int main()
- {
-     auto account = std::make_shared<BankAccount>(50.0);
- 
-     std::cout << "Initial Balance: $" << account->getBalance() << std::endl;
-
-     std::vector<std::thread> threads;
- 
-     // Attempt to withdraw more than the available balance (this will block)
-     std::cout << "Attempting to withdraw 100..." << std::endl;
-     threads.emplace_back([&] { account->withdraw(100.0); });
- 
-     // Simulate delay before deposit
-     std::this_thread::sleep_for(std::chrono::seconds(2));
- 
-     // Deposit enough money to unblock the withdrawal
-     threads.emplace_back([&] { account->deposit(100.0); });
- 
-     for (auto& thread : threads)
-     {
-         thread.join();
-     }
- 
-     std::cout << "Final Balance: $" << account->getBalance() << std::endl;
-     return 0;
- }
- 
\ No newline at end of file
+        std::cout << readsPerWrite << " read(s)/write: monitor " << plainTime
+                  << " ms, seqlock " << seqlockTime << " ms ("
+                  << seqlock.retries() << " retried read(s))" << std::endl;
+    }
+    return 0;
+}
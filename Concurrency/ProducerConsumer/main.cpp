@@ -1,123 +1,343 @@
 /**
  * @brief
- * The Producer-Consumer design pattern solves problems related to shared data access 
- * by ensuring proper synchronization between producer and consumer threads. 
- * It typically involves two types of threads: producers that generate data and consumers 
- * that process the data. A buffer (or queue) is used to temporarily hold the data 
- * until the consumer can process it. This pattern ensures that the producers and consumers 
+ * The Producer-Consumer design pattern solves problems related to shared data access
+ * by ensuring proper synchronization between producer and consumer threads.
+ * It typically involves two types of threads: producers that generate data and consumers
+ * that process the data. A buffer (or queue) is used to temporarily hold the data
+ * until the consumer can process it. This pattern ensures that the producers and consumers
  * operate in synchronization, avoiding race conditions and data inconsistencies.
- * 
+ *
  * Key Concepts:
  * - Producer: A thread responsible for generating data.
  * - Consumer: A thread responsible for consuming or processing the data.
  * - Shared Queue: A common data structure used by both producers and consumers for synchronization.
  * - Synchronization: Ensures that only one thread can access the shared data at a time.
- * 
+ * - Lock-Free Ring Buffer: A bounded MPMC alternative where producers and consumers claim
+ *   slots with atomic sequence counters instead of taking a lock.
+ *
  * Benefits:
  * - Prevents race conditions: Ensures proper synchronization between producer and consumer threads.
  * - Efficient data processing: Producers and consumers can operate concurrently, improving throughput.
- * - Simple and effective for multithreading: Makes handling shared data and synchronization easy.
+ * - The ring-buffer mode avoids the lock convoy that caps the mutex queue under heavy load.
  */
 
- #include <iostream>
- #include <thread>
- #include <queue>
- #include <condition_variable>
- #include <memory>
- #include <chrono>
- 
- class ProducerConsumer
- {
- public:
-     ProducerConsumer()
-         : m_done(false) {}
- 
-     /**
-      * @brief Adds data to the shared queue (Producer).
-      * @param data The data to be added.
-      */
-     void produce(int data)
-     {
-         std::unique_lock<std::mutex> lock(m_mutex);
-         m_queue.push(data);
-         std::cout << "Produced: " << data << std::endl;
-         m_condVar.notify_one();  // Notify the consumer that data is available.
-     }
- 
-     /**
-      * @brief Consumes data from the shared queue (Consumer).
-      */
-     void consume()
-     {
-         while (!m_done)
-         {
-             std::unique_lock<std::mutex> lock(m_mutex);
-             m_condVar.wait(lock, [this] { return !m_queue.empty() || m_done; });  // Wait until there's data or the task is done.
- 
-             if (!m_queue.empty())
-             {
-                 int data = m_queue.front();
-                 m_queue.pop();
-                 std::cout << "Consumed: " << data << std::endl;
-             }
-         }
-     }
- 
-     /**
-      * @brief Stops the producer and consumer after finishing work.
-      */
-     void stop()
-     {
-         std::unique_lock<std::mutex> lock(m_mutex);
-         m_done = true;
-         m_condVar.notify_all();  // Notify all waiting threads to exit.
-     }
- 
- private:
-     std::queue<int> m_queue; ///< The shared queue to hold data for the consumer.
-     std::mutex m_mutex; ///< Mutex to synchronize access to the queue.
-     std::condition_variable m_condVar; ///< Condition variable to synchronize the threads.
-     bool m_done; ///< Flag to indicate when to stop the consumer thread.
- };
- 
- /**
-  * @brief A function to simulate a producer's work.
-  * @param producerConsumer Shared pointer to the ProducerConsumer object.
-  */
- void producerTask(std::shared_ptr<ProducerConsumer> producerConsumer)
- {
-     for (int i = 0; i < 10; ++i)
-     {
-         std::this_thread::sleep_for(std::chrono::milliseconds(100)); // Simulate work
-         producerConsumer->produce(i);
-     }
- }
- 
- /**
-  * @brief A function to simulate a consumer's work.
-  * @param producerConsumer Shared pointer to the ProducerConsumer object.
-  */
- void consumerTask(std::shared_ptr<ProducerConsumer> producerConsumer)
- {
-     producerConsumer->consume();
- }
- 
- int main()
- {
-     std::shared_ptr<ProducerConsumer> producerConsumer = std::make_shared<ProducerConsumer>();
- 
-     std::thread producer(producerTask, producerConsumer);
-     std::thread consumer(consumerTask, producerConsumer);
- 
-     // Wait for the producer to finish producing
-     producer.join();
- 
-     // Stop the consumer and allow it to exit the loop
-     producerConsumer->stop();
- 
-     // Wait for the consumer to finish
-     consumer.join();
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <thread>
+#include <queue>
+#include <condition_variable>
+#include <memory>
+#include <chrono>
+#include <atomic>
+#include <vector>
+
+class ProducerConsumer
+{
+public:
+    ProducerConsumer()
+        : m_done(false) {}
+
+    /**
+     * @brief Adds data to the shared queue (Producer).
+     * @param data The data to be added.
+     */
+    void produce(int data)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_queue.push(data);
+        std::cout << "Produced: " << data << std::endl;
+        m_condVar.notify_one();  // Notify the consumer that data is available.
+    }
+
+    /**
+     * @brief Consumes data from the shared queue (Consumer).
+     */
+    void consume()
+    {
+        while (!m_done)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condVar.wait(lock, [this] { return !m_queue.empty() || m_done; });  // Wait until there's data or the task is done.
+
+            if (!m_queue.empty())
+            {
+                int data = m_queue.front();
+                m_queue.pop();
+                std::cout << "Consumed: " << data << std::endl;
+            }
+        }
+    }
+
+    /**
+     * @brief Stops the producer and consumer after finishing work.
+     */
+    void stop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done = true;
+        m_condVar.notify_all();  // Notify all waiting threads to exit.
+    }
+
+private:
+    std::queue<int> m_queue; ///< The shared queue to hold data for the consumer.
+    std::mutex m_mutex; ///< Mutex to synchronize access to the queue.
+    std::condition_variable m_condVar; ///< Condition variable to synchronize the threads.
+    bool m_done; ///< Flag to indicate when to stop the consumer thread.
+};
+
+/**
+ * @brief Bounded lock-free MPMC ring buffer (Vyukov-style sequence counters).
+ *
+ * Each cell carries a sequence number that tells producers and consumers
+ * whether the slot is free or filled for their turn around the ring, so a
+ * push or pop is one CAS on the position counter plus a store — no mutex.
+ * Head and tail counters live on separate cache lines to avoid false sharing.
+ *
+ * @tparam T Element type.
+ * @tparam Capacity Ring size; must be a power of two.
+ */
+template <typename T, std::size_t Capacity>
+class LockFreeRingBuffer
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    LockFreeRingBuffer() : m_cells(Capacity)
+    {
+        for (std::size_t i = 0; i < Capacity; ++i)
+        {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Attempts to push an element without blocking.
+     * @return false if the buffer is full.
+     */
+    bool tryPush(const T& value)
+    {
+        std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell = m_cells[pos & MASK];
+            std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // Slot still holds an unconsumed element: full.
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed); // Lost the race; retry.
+            }
+        }
+    }
+
+    /**
+     * @brief Attempts to pop an element without blocking.
+     * @return false if the buffer is empty.
+     */
+    bool tryPop(T& value)
+    {
+        std::size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell = m_cells[pos & MASK];
+            std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    value = cell.value;
+                    cell.sequence.store(pos + Capacity, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // Slot not yet filled for this lap: empty.
+            }
+            else
+            {
+                pos = m_dequeuePos.load(std::memory_order_relaxed); // Lost the race; retry.
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t MASK = Capacity - 1;
+
+    /**
+     * @brief One ring slot plus its turn counter.
+     */
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    std::vector<Cell> m_cells; ///< The ring storage.
+    alignas(64) std::atomic<std::size_t> m_enqueuePos{0}; ///< Producer cursor; own cache line.
+    alignas(64) std::atomic<std::size_t> m_dequeuePos{0}; ///< Consumer cursor; own cache line.
+};
+
+/**
+ * @brief Bounded mutex-and-condition-variable queue used as the benchmark baseline.
+ *
+ * Mirrors the synchronization of ProducerConsumer but without per-item logging,
+ * so the comparison measures the queues rather than std::cout.
+ *
+ * @tparam T Element type.
+ */
+template <typename T>
+class BoundedMutexQueue
+{
+public:
+    explicit BoundedMutexQueue(std::size_t capacity) : m_capacity(capacity) {}
+
+    bool tryPush(const T& value)
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_queue.size() >= m_capacity)
+        {
+            return false;
+        }
+        m_queue.push(value);
+        return true;
+    }
+
+    bool tryPop(T& value)
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_queue.empty())
+        {
+            return false;
+        }
+        value = m_queue.front();
+        m_queue.pop();
+        return true;
+    }
+
+private:
+    std::size_t m_capacity;
+    std::queue<T> m_queue;
+    std::mutex m_mutex;
+};
+
+/**
+ * @brief Runs pairCount producers and consumers through a queue and reports throughput.
+ * @param name Label for the report line.
+ * @param queue The queue under test (must provide tryPush/tryPop).
+ * @param pairCount Number of producer-consumer pairs.
+ * @param itemsPerPair Items produced (and consumed) by each pair.
+ */
+template <typename Queue>
+void benchmarkQueue(const std::string& name, Queue& queue, int pairCount, int itemsPerPair)
+{
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int p = 0; p < pairCount; ++p)
+    {
+        threads.emplace_back([&queue, itemsPerPair]
+        {
+            for (int i = 0; i < itemsPerPair; ++i)
+            {
+                while (!queue.tryPush(i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        threads.emplace_back([&queue, itemsPerPair]
+        {
+            int value;
+            for (int i = 0; i < itemsPerPair; ++i)
+            {
+                while (!queue.tryPop(value))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double total = static_cast<double>(pairCount) * itemsPerPair;
+    std::cout << "  " << name << ", " << pairCount << " pair(s): "
+              << static_cast<long>(total / elapsed / 1000.0) << "k items/sec\n";
+}
+
+/**
+ * @brief Compares the mutex queue against the lock-free ring at 2/4/8 pairs.
+ */
+void runBenchmark()
+{
+    constexpr int itemsPerPair = 50000;
+    std::cout << "Throughput benchmark (" << itemsPerPair << " items per pair):\n";
+    for (int pairs : {2, 4, 8})
+    {
+        BoundedMutexQueue<int> mutexQueue(1024);
+        benchmarkQueue("mutex queue   ", mutexQueue, pairs, itemsPerPair);
+
+        LockFreeRingBuffer<int, 1024> ringBuffer;
+        benchmarkQueue("lock-free ring", ringBuffer, pairs, itemsPerPair);
+    }
+}
+
+/**
+ * @brief A function to simulate a producer's work.
+ * @param producerConsumer Shared pointer to the ProducerConsumer object.
+ */
+void producerTask(std::shared_ptr<ProducerConsumer> producerConsumer)
+{
+    for (int i = 0; i < 10; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100)); // Simulate work
+        producerConsumer->produce(i);
+    }
+}
+
+/**
+ * @brief A function to simulate a consumer's work.
+ * @param producerConsumer Shared pointer to the ProducerConsumer object.
+ */
+void consumerTask(std::shared_ptr<ProducerConsumer> producerConsumer)
+{
+    producerConsumer->consume();
+}
+
+int main()
+{
+    std::shared_ptr<ProducerConsumer> producerConsumer = std::make_shared<ProducerConsumer>();
+
+    std::thread producer(producerTask, producerConsumer);
+    std::thread consumer(consumerTask, producerConsumer);
+
+    // Wait for the producer to finish producing
+    producer.join();
+
+    // Stop the consumer and allow it to exit the loop
+    producerConsumer->stop();
+
+    // Wait for the consumer to finish
+    consumer.join();
+
+    // Compare the classic queue against the lock-free ring buffer.
+    runBenchmark();
+
+    return 0;
+}
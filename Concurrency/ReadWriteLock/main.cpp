@@ -1,105 +1,296 @@
 /**
  * @brief
- * The Read-Write Lock pattern allows multiple threads to read shared data concurrently while providing exclusive 
- * access for a thread when writing data. This improves performance in scenarios where read operations are much more 
+ * The Read-Write Lock pattern allows multiple threads to read shared data concurrently while providing exclusive
+ * access for a thread when writing data. This improves performance in scenarios where read operations are much more
  * frequent than write operations.
- * 
+ *
  * Key concepts:
  * - Read Access: Allows multiple threads to read data concurrently.
  * - Write Access: Ensures that only one thread can write at a time, preventing other threads from reading or writing during the operation.
  * - Performance: This pattern optimizes performance in read-heavy scenarios by allowing concurrent reads while serializing writes.
- * 
+ * - RCU (Read-Copy-Update): For read-dominated workloads, readers follow an atomic pointer to an
+ *   immutable snapshot with no lock at all; writers publish a new snapshot and reclaim the old one
+ *   only after every reader that could see it has left its read-side section (epoch-based).
+ *
  * Benefits:
  * - Increased concurrency: Multiple threads can read shared data without blocking each other.
  * - Improved performance: By avoiding unnecessary locks during read operations, the overall performance of the system is enhanced.
  * - Fine-grained control: Allows controlling access for reading and writing separately.
+ * - The RCU mode removes even the shared-mode lock word readers would otherwise bounce between cores.
  */
 
- #include <iostream>
- #include <shared_mutex>
- #include <memory>
- #include <string>
- #include <thread>
- #include <vector>
- #include <mutex>
- 
- /**
-  * @brief
-  * A simple Read-Write Lock example that demonstrates the use of read-write locks for thread-safe read and write operations.
-  */
- class SharedData
- {
- public:
-     /**
-      * @brief Sets the data value.
-      * Uses a write lock to ensure exclusive access to the data while writing.
-      * 
-      * @param data The value to set.
-      */
-     void setData(const std::string &data)
-     {
-         std::unique_lock<std::shared_mutex> writeLock(m_rwMutex); // Write lock
-         m_data = data;
-         std::cout << "Data set to: " << m_data << std::endl;
-     }
- 
-     /**
-      * @brief Gets the data value.
-      * Uses a read lock to allow multiple threads to read the data concurrently.
-      * 
-      * @return The current data value.
-      */
-     std::string getData() const
-     {
-         std::shared_lock<std::shared_mutex> readLock(m_rwMutex); // Read lock
-         return m_data;
-     }
- 
- private:
-     mutable std::shared_mutex m_rwMutex; ///< Mutex for read-write locking.
-     std::string m_data; ///< Shared data.
- };
- 
- /**
-  * @brief Simulates a reader thread that reads data.
-  * @param sharedData The shared data object to read from.
-  */
- void reader(const SharedData &sharedData)
- {
-     std::cout << "Reader: " << sharedData.getData() << std::endl;
- }
- 
- /**
-  * @brief Simulates a writer thread that writes data.
-  * @param sharedData The shared data object to write to.
-  * @param newData The new data to write.
-  */
- void writer(SharedData &sharedData, const std::string &newData)
- {
-     sharedData.setData(newData);
- }
- 
- int main()
- {
-     SharedData sharedData;
- 
-     // Start a writer thread
-     std::thread writerThread(writer, std::ref(sharedData), "Hello, World!");
- 
-     // Start several reader threads
-     std::vector<std::thread> readerThreads;
-     for (int i = 0; i < 5; ++i)
-     {
-         readerThreads.push_back(std::thread(reader, std::cref(sharedData)));
-     }
- 
-     // Join writer and reader threads
-     writerThread.join();
-     for (auto &t : readerThreads)
-     {
-         t.join();
-     }
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <shared_mutex>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief
+ * A simple Read-Write Lock example that demonstrates the use of read-write locks for thread-safe read and write operations.
+ */
+class SharedData
+{
+public:
+    /**
+     * @brief Sets the data value.
+     * Uses a write lock to ensure exclusive access to the data while writing.
+     *
+     * @param data The value to set.
+     */
+    void setData(const std::string &data)
+    {
+        std::unique_lock<std::shared_mutex> writeLock(m_rwMutex); // Write lock
+        m_data = data;
+    }
+
+    /**
+     * @brief Gets the data value.
+     * Uses a read lock to allow multiple threads to read the data concurrently.
+     *
+     * @return The current data value.
+     */
+    std::string getData() const
+    {
+        std::shared_lock<std::shared_mutex> readLock(m_rwMutex); // Read lock
+        return m_data;
+    }
+
+private:
+    mutable std::shared_mutex m_rwMutex; ///< Mutex for read-write locking.
+    std::string m_data; ///< Shared data.
+};
+
+/**
+ * @brief RCU-style shared data: lock-free readers, epoch-reclaimed snapshots.
+ *
+ * The current value lives behind an atomic pointer to an immutable snapshot.
+ * A reader announces the epoch it entered in a per-thread slot (its own cache
+ * line), follows the pointer, and clears the slot — no lock, no shared
+ * counter. A writer builds a new snapshot, publishes it with one atomic
+ * exchange, then waits until every reader that entered before the publication
+ * has left its read-side section before deleting the old snapshot.
+ */
+class RcuSharedData
+{
+public:
+    static constexpr std::size_t MAX_READERS = 64; ///< Registered reader slots.
+
+    explicit RcuSharedData(std::string initial)
+        : m_current(new std::string(std::move(initial))) {}
+
+    ~RcuSharedData()
+    {
+        delete m_current.load(std::memory_order_relaxed);
+    }
+
+    RcuSharedData(const RcuSharedData &) = delete;
+    RcuSharedData &operator=(const RcuSharedData &) = delete;
+
+    /**
+     * @brief Claims a reader slot; each reading thread registers once.
+     * @return The slot index to pass to getData().
+     */
+    std::size_t registerReader()
+    {
+        for (std::size_t i = 0; i < MAX_READERS; ++i)
+        {
+            bool expected = false;
+            if (m_slots[i].used.compare_exchange_strong(expected, true))
+            {
+                return i;
+            }
+        }
+        throw std::runtime_error("RcuSharedData: out of reader slots");
+    }
+
+    /**
+     * @brief Releases a reader slot.
+     */
+    void unregisterReader(std::size_t slot)
+    {
+        m_slots[slot].used.store(false, std::memory_order_release);
+    }
+
+    /**
+     * @brief Lock-free read: announce the epoch, follow the pointer, leave.
+     * @param slot The reader's registered slot index.
+     * @return A copy of the current snapshot.
+     */
+    std::string getData(std::size_t slot) const
+    {
+        m_slots[slot].epoch.store(m_globalEpoch.load(std::memory_order_seq_cst),
+                                  std::memory_order_seq_cst);
+        const std::string *snapshot = m_current.load(std::memory_order_acquire);
+        std::string value = *snapshot;
+        m_slots[slot].epoch.store(0, std::memory_order_release); // Quiescent again.
+        return value;
+    }
+
+    /**
+     * @brief Publishes a new snapshot and reclaims the old one once safe.
+     * @param data The value to set.
+     */
+    void setData(std::string data)
+    {
+        auto *fresh = new std::string(std::move(data));
+        const std::string *old = m_current.exchange(fresh, std::memory_order_acq_rel);
+        synchronize(); // Wait until no reader can still hold the old pointer.
+        delete old;
+    }
+
+private:
+    /**
+     * @brief Per-reader epoch announcement; padded to its own cache line.
+     */
+    struct alignas(64) ReaderSlot
+    {
+        std::atomic<std::uint64_t> epoch{0}; ///< 0 = quiescent; else entry epoch.
+        std::atomic<bool> used{false};
+    };
+
+    /**
+     * @brief Grace period: waits for readers that entered before the new epoch.
+     */
+    void synchronize()
+    {
+        std::uint64_t target = m_globalEpoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+        for (std::size_t i = 0; i < MAX_READERS; ++i)
+        {
+            if (!m_slots[i].used.load(std::memory_order_acquire))
+            {
+                continue;
+            }
+            std::uint64_t epoch;
+            while ((epoch = m_slots[i].epoch.load(std::memory_order_acquire)) != 0 && epoch < target)
+            {
+                std::this_thread::yield(); // Reader is still inside an old-epoch section.
+            }
+        }
+    }
+
+    std::atomic<const std::string *> m_current;          ///< Pointer to the immutable snapshot.
+    std::atomic<std::uint64_t> m_globalEpoch{1};         ///< Advances on every update.
+    mutable ReaderSlot m_slots[MAX_READERS];             ///< Registered reader epochs.
+};
+
+/**
+ * @brief Simulates a reader thread that reads data.
+ * @param sharedData The shared data object to read from.
+ */
+void reader(const SharedData &sharedData)
+{
+    std::cout << "Reader: " << sharedData.getData() << std::endl;
+}
+
+/**
+ * @brief Simulates a writer thread that writes data.
+ * @param sharedData The shared data object to write to.
+ * @param newData The new data to write.
+ */
+void writer(SharedData &sharedData, const std::string &newData)
+{
+    sharedData.setData(newData);
+    std::cout << "Data set to: " << newData << std::endl;
+}
+
+/**
+ * @brief Measures aggregate read throughput at several reader-thread counts.
+ *
+ * The workload is read-only (the 99.9%-read case); each configuration is run
+ * against the shared_mutex implementation and the RCU mode.
+ */
+void readerScalingBenchmark()
+{
+    constexpr int readsPerThread = 50000;
+
+    SharedData lockedData;
+    lockedData.setData("benchmark payload");
+    RcuSharedData rcuData("benchmark payload");
+
+    std::cout << "Reader scaling (" << readsPerThread << " reads per thread):\n";
+    for (int threadCount : {4, 8, 16, 32, 48})
+    {
+        // shared_mutex readers.
+        auto start = std::chrono::steady_clock::now();
+        {
+            std::vector<std::thread> threads;
+            for (int t = 0; t < threadCount; ++t)
+            {
+                threads.emplace_back([&lockedData]
+                {
+                    for (int i = 0; i < readsPerThread; ++i)
+                    {
+                        volatile std::size_t sink = lockedData.getData().size();
+                        (void)sink;
+                    }
+                });
+            }
+            for (auto &thread : threads) { thread.join(); }
+        }
+        double lockedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        // RCU readers.
+        start = std::chrono::steady_clock::now();
+        {
+            std::vector<std::thread> threads;
+            for (int t = 0; t < threadCount; ++t)
+            {
+                threads.emplace_back([&rcuData]
+                {
+                    std::size_t slot = rcuData.registerReader();
+                    for (int i = 0; i < readsPerThread; ++i)
+                    {
+                        volatile std::size_t sink = rcuData.getData(slot).size();
+                        (void)sink;
+                    }
+                    rcuData.unregisterReader(slot);
+                });
+            }
+            for (auto &thread : threads) { thread.join(); }
+        }
+        double rcuTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "  " << threadCount << " readers: shared_mutex " << lockedTime
+                  << " ms, RCU " << rcuTime << " ms\n";
+    }
+}
+
+int main()
+{
+    SharedData sharedData;
+
+    // Start a writer thread
+    std::thread writerThread(writer, std::ref(sharedData), "Hello, World!");
+
+    // Start several reader threads
+    std::vector<std::thread> readerThreads;
+    for (int i = 0; i < 5; ++i)
+    {
+        readerThreads.push_back(std::thread(reader, std::cref(sharedData)));
+    }
+
+    // Join writer and reader threads
+    writerThread.join();
+    for (auto &t : readerThreads)
+    {
+        t.join();
+    }
+
+    // RCU mode: lock-free readers, atomically published updates.
+    RcuSharedData rcuData("initial");
+    std::size_t slot = rcuData.registerReader();
+    std::cout << "RCU read: " << rcuData.getData(slot) << std::endl;
+    rcuData.setData("updated snapshot");
+    std::cout << "RCU read: " << rcuData.getData(slot) << std::endl;
+    rcuData.unregisterReader(slot);
+
+    readerScalingBenchmark();
+
+    return 0;
+}
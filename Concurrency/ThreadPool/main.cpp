@@ -1,123 +1,350 @@
 /**
- * @brief Thread Pool Pattern Example: Efficient Task Execution with a Fixed Thread Pool
+ * @brief Thread Pool Pattern Example: Work-Stealing Task Execution with a Fixed Thread Pool
  *
  * **Key Concepts:**
  * 1. **Thread Management**: Uses a fixed number of threads to execute tasks.
- * 2. **Task Queueing**: Incoming tasks are queued and processed by available threads.
- * 3. **Efficient Resource Utilization**: Threads are reused instead of frequently creating/destroying them.
+ * 2. **Per-Worker Deques**: Each worker owns a lock-free Chase-Lev deque; the owner pushes and
+ *    pops at the bottom while idle workers steal from the top.
+ * 3. **Submission Inbox**: External callers submit through a shared inbox; workers drain it in
+ *    chunks into their local deque, so the shared lock is taken once per chunk, not per task.
+ * 4. **Work Stealing**: A worker whose deque drains picks random victims and steals their
+ *    oldest tasks, keeping all cores busy under irregular load.
  *
  * **Benefits:**
  * - Reduces overhead from thread creation and destruction.
- * - Ensures parallel execution of tasks with limited resources.
- * - Improves responsiveness in applications requiring frequent task execution.
+ * - Near-linear scaling: workers run from their own deque without touching a shared lock.
+ * - enqueueBatch() submits many tasks under a single synchronization operation.
  */
 
- #include <iostream>
- #include <vector>
- #include <queue>
- #include <thread>
- #include <mutex>
- #include <condition_variable>
- #include <functional>
- #include <memory>
- #include <atomic>
- 
- /**
-  * @brief Manages a pool of worker threads that execute queued tasks.
-  */
- class ThreadPool
- {
- public:
-     /**
-      * @brief Constructs a thread pool with the given number of worker threads.
-      * @param threadCount Number of worker threads.
-      */
-     explicit ThreadPool(size_t threadCount) : m_running(true)
-     {
-         for (size_t i = 0; i < threadCount; ++i)
-         {
-             m_workers.emplace_back([this]
-             {
-                 while (true)
-                 {
-                     std::function<void()> task;
-                     {
-                         std::unique_lock lock(m_mutex);
-                         m_condition.wait(lock, [this] { return !m_tasks.empty() || !m_running; });
- 
-                         if (!m_running && m_tasks.empty())
-                         {
-                             return;
-                         }
- 
-                         task = std::move(m_tasks.front());
-                         m_tasks.pop();
-                     }
-                     task(); // Execute the task
-                 }
-             });
-         }
-     }
- 
-     /**
-      * @brief Destroys the thread pool, ensuring all tasks complete before shutdown.
-      */
-     ~ThreadPool()
-     {
-         {
-             std::lock_guard lock(m_mutex);
-             m_running = false;
-         }
-         m_condition.notify_all();
- 
-         for (auto& worker : m_workers)
-         {
-             if (worker.joinable())
-             {
-                 worker.join();
-             }
-         }
-     }
- 
-     /**
-      * @brief Adds a new task to the queue for execution by a worker thread.
-      * @param task The function to execute asynchronously.
-      */
-     void enqueueTask(std::function<void()> task)
-     {
-         {
-             std::lock_guard lock(m_mutex);
-             m_tasks.push(std::move(task));
-         }
-         m_condition.notify_one();
-     }
- 
- private:
-     std::vector<std::thread> m_workers; ///< Worker threads.
-     std::queue<std::function<void()>> m_tasks; ///< Task queue.
-     std::mutex m_mutex; ///< Synchronizes access to task queue.
-     std::condition_variable m_condition; ///< Notifies workers of new tasks.
-     std::atomic<bool> m_running; ///< Controls worker execution.
- };
- 
- /**
-  * @brief Demonstrates the Thread Pool pattern with multiple tasks.
-  */
- int main()
- {
-     constexpr size_t threadCount = 4;
-     auto pool = std::make_shared<ThreadPool>(threadCount);
- 
-     for (int i = 0; i < 10; ++i)
-     {
-         pool->enqueueTask([i]
-         {
-             std::cout << "Task " << i << " is executing on thread " << std::this_thread::get_id() << std::endl;
-             std::this_thread::sleep_for(std::chrono::milliseconds(500)); // Simulate work
-         });
-     }
- 
-     std::this_thread::sleep_for(std::chrono::seconds(3)); // Allow time for tasks to finish
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <random>
+#include <span>
+#include <chrono>
+
+/**
+ * @brief A task stored by the pool.
+ */
+using Task = std::function<void()>;
+
+/**
+ * @brief Bounded lock-free work-stealing deque (Chase-Lev).
+ *
+ * The owning worker pushes and pops at the bottom without contention; thieves
+ * CAS the top index to claim the oldest task. Slots hold heap-allocated task
+ * pointers so that ownership transfers with a single atomic exchange.
+ */
+class WorkStealingDeque
+{
+public:
+    static constexpr std::size_t CAPACITY = 4096; ///< Power of two; demo-sized.
+
+    WorkStealingDeque() : m_slots(CAPACITY) {}
+
+    /**
+     * @brief Pushes a task at the bottom. Owner thread only.
+     * @return false when the deque is full (caller should run the task inline).
+     */
+    bool pushBottom(Task *task)
+    {
+        std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        std::int64_t top = m_top.load(std::memory_order_acquire);
+        if (bottom - top >= static_cast<std::int64_t>(CAPACITY))
+        {
+            return false;
+        }
+        m_slots[bottom & MASK].store(task, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pops the most recently pushed task. Owner thread only.
+     * @return The task, or nullptr if the deque is empty (or lost a race to a thief).
+     */
+    Task *popBottom()
+    {
+        std::int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top = m_top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Task *task = m_slots[bottom & MASK].load(std::memory_order_relaxed);
+        if (top != bottom)
+        {
+            return task; // More than one task left; no thief can reach this slot.
+        }
+
+        // Last task: race the thieves for it.
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            task = nullptr; // A thief won.
+        }
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return task;
+    }
+
+    /**
+     * @brief Steals the oldest task. Safe to call from any thread.
+     * @return The task, or nullptr if empty or the CAS lost to a concurrent pop/steal.
+     */
+    Task *steal()
+    {
+        std::int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+        {
+            return nullptr;
+        }
+
+        Task *task = m_slots[top & MASK].load(std::memory_order_relaxed);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+        return task;
+    }
+
+private:
+    static constexpr std::int64_t MASK = static_cast<std::int64_t>(CAPACITY) - 1;
+
+    alignas(64) std::atomic<std::int64_t> m_top{0};    ///< Thief end; own cache line.
+    alignas(64) std::atomic<std::int64_t> m_bottom{0}; ///< Owner end; own cache line.
+    std::vector<std::atomic<Task *>> m_slots;          ///< Ring of task pointers.
+};
+
+/**
+ * @brief Manages a pool of worker threads that execute tasks from work-stealing deques.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief Constructs a thread pool with the given number of worker threads.
+     * @param threadCount Number of worker threads.
+     */
+    explicit ThreadPool(size_t threadCount) : m_running(true)
+    {
+        m_deques.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            m_deques.push_back(std::make_unique<WorkStealingDeque>());
+        }
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            m_workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    /**
+     * @brief Destroys the thread pool, ensuring all tasks complete before shutdown.
+     */
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard lock(m_inboxMutex);
+            m_running = false;
+        }
+        m_condition.notify_all();
+
+        for (auto &worker : m_workers)
+        {
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+    }
+
+    /**
+     * @brief Adds a new task to the submission inbox for execution by a worker thread.
+     * @param task The function to execute asynchronously.
+     */
+    void enqueueTask(Task task)
+    {
+        {
+            std::lock_guard lock(m_inboxMutex);
+            m_inbox.push_back(std::move(task));
+        }
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+        m_condition.notify_one();
+    }
+
+    /**
+     * @brief Submits a span of tasks under a single lock acquisition and wakeup.
+     * @param tasks The tasks to execute asynchronously.
+     */
+    void enqueueBatch(std::span<Task> tasks)
+    {
+        {
+            std::lock_guard lock(m_inboxMutex);
+            for (Task &task : tasks)
+            {
+                m_inbox.push_back(std::move(task));
+            }
+        }
+        m_pending.fetch_add(tasks.size(), std::memory_order_relaxed);
+        m_condition.notify_all();
+    }
+
+private:
+    static constexpr size_t DRAIN_CHUNK = 32; ///< Inbox tasks claimed per lock acquisition.
+
+    /**
+     * @brief Main loop of one worker: local pop, inbox drain, randomized steal, then sleep.
+     */
+    void workerLoop(size_t index)
+    {
+        WorkStealingDeque &local = *m_deques[index];
+        std::minstd_rand rng(static_cast<unsigned>(index) * 2654435761u + 1u);
+
+        while (true)
+        {
+            if (Task *task = local.popBottom())
+            {
+                run(task);
+                continue;
+            }
+            if (drainInbox(local))
+            {
+                continue;
+            }
+            if (Task *task = stealFromVictim(index, rng))
+            {
+                run(task);
+                continue;
+            }
+
+            std::unique_lock lock(m_inboxMutex);
+            if (!m_running && m_pending.load(std::memory_order_acquire) == 0)
+            {
+                return;
+            }
+            // Timed wait: work may appear in a victim's deque without an inbox notification.
+            m_condition.wait_for(lock, std::chrono::milliseconds(1),
+                                 [this] { return !m_inbox.empty() || !m_running; });
+        }
+    }
+
+    /**
+     * @brief Moves up to DRAIN_CHUNK inbox tasks into the local deque in one lock acquisition.
+     * @return true if at least one task was claimed.
+     */
+    bool drainInbox(WorkStealingDeque &local)
+    {
+        std::vector<Task> claimed;
+        {
+            std::lock_guard lock(m_inboxMutex);
+            size_t count = std::min(m_inbox.size(), DRAIN_CHUNK);
+            for (size_t i = 0; i < count; ++i)
+            {
+                claimed.push_back(std::move(m_inbox.front()));
+                m_inbox.pop_front();
+            }
+        }
+        if (claimed.empty())
+        {
+            return false;
+        }
+        for (Task &task : claimed)
+        {
+            auto *heapTask = new Task(std::move(task));
+            if (!local.pushBottom(heapTask))
+            {
+                run(heapTask); // Deque full: execute inline rather than block.
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Attempts to steal one task from a randomly chosen victim.
+     */
+    Task *stealFromVictim(size_t self, std::minstd_rand &rng)
+    {
+        size_t count = m_deques.size();
+        if (count < 2)
+        {
+            return nullptr;
+        }
+        for (size_t attempt = 0; attempt < count; ++attempt)
+        {
+            size_t victim = rng() % count;
+            if (victim == self)
+            {
+                continue;
+            }
+            if (Task *task = m_deques[victim]->steal())
+            {
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Executes a heap-allocated task and releases it.
+     */
+    void run(Task *task)
+    {
+        (*task)();
+        delete task;
+        m_pending.fetch_sub(1, std::memory_order_release);
+    }
+
+    std::vector<std::thread> m_workers;                        ///< Worker threads.
+    std::vector<std::unique_ptr<WorkStealingDeque>> m_deques;  ///< One lock-free deque per worker.
+    std::deque<Task> m_inbox;                                  ///< Submission inbox for external callers.
+    std::mutex m_inboxMutex;                                   ///< Synchronizes access to the inbox.
+    std::condition_variable m_condition;                       ///< Wakes sleeping workers.
+    std::atomic<size_t> m_pending{0};                          ///< Tasks submitted but not yet finished.
+    bool m_running;                                            ///< Controls worker execution (under m_inboxMutex).
+};
+
+/**
+ * @brief Demonstrates the Thread Pool pattern with individual and batched tasks.
+ */
+int main()
+{
+    constexpr size_t threadCount = 4;
+    auto pool = std::make_shared<ThreadPool>(threadCount);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        pool->enqueueTask([i]
+        {
+            std::cout << "Task " << i << " is executing on thread " << std::this_thread::get_id() << std::endl;
+            std::this_thread::sleep_for(std::chrono::milliseconds(100)); // Simulate work
+        });
+    }
+
+    // Batch submission: one lock acquisition for the whole group.
+    std::vector<Task> batch;
+    for (int i = 4; i < 10; ++i)
+    {
+        batch.push_back([i]
+        {
+            std::cout << "Batched task " << i << " is executing on thread " << std::this_thread::get_id() << std::endl;
+            std::this_thread::sleep_for(std::chrono::milliseconds(100)); // Simulate work
+        });
+    }
+    pool->enqueueBatch(batch);
+
+    std::this_thread::sleep_for(std::chrono::seconds(1)); // Allow time for tasks to finish
+    return 0;
+}
@@ -3,98 +3,263 @@
  * The Thread-Specific Storage (TSS) design pattern is used when you need to store data
  * that is unique to each thread. This pattern ensures that each thread has its own instance
  * of a variable, preventing conflicts between threads accessing the same data.
- * 
+ *
  * Explanation:
- * 
- * Thread-Specific Storage: The ThreadSpecificStorage class stores a unique value for each thread using the thread_local keyword. 
+ *
+ * Thread-Specific Storage: The ThreadSpecificStorage class stores a unique value for each thread using the thread_local keyword.
  * This allows each thread to have its own instance of m_threadLocalData.
- * 
+ *
  * Key Concepts:
  * - Thread-local storage: Data that is only accessible to the thread that created it.
  * - Thread safety: Ensures that each thread can access its own unique data without interference.
  * - Memory isolation: Data is isolated between threads, which can improve concurrency and reduce contention.
- * 
+ *
  * Benefits:
  * - Efficient for multi-threaded applications: Avoids the need for mutexes or other synchronization methods to access thread-local data.
  * - Prevents data race conditions: Since each thread has its own copy of the data, no other thread can modify it.
  * - Ideal for thread-local storage like thread IDs, logging, or thread-specific counters.
+ *
+ * thread_local alone cannot be aggregated across threads, and routing per-thread values
+ * through a mutex-guarded map costs a global lock on every access — the opposite of what
+ * TLS should cost. SlabThreadStorage registers each thread once through a lock-free slot
+ * counter; afterwards the thread touches its own cache-line-padded slab slot with zero
+ * synchronization, while forEach() snapshots every thread's value for aggregation without
+ * ever stopping the writers.
  */
 
- #include <iostream>
- #include <thread>
- #include <vector>
- #include <memory>
- #include <mutex>
- 
- /**
-  * @brief A class representing thread-specific storage.
-  * This class demonstrates how to store unique data for each thread.
-  */
- class ThreadSpecificStorage
- {
- public:
-     /**
-      * @brief Sets a value specific to the current thread.
-      * @param value The value to store for the current thread.
-      */
-     void setValue(int value)
-     {
-         m_threadLocalData = value; // Store value specific to the current thread
-     }
- 
-     /**
-      * @brief Gets the value specific to the current thread.
-      * @return The value stored for the current thread.
-      */
-     int getValue() const
-     {
-         return m_threadLocalData;
-     }
- 
- private:
-     thread_local static int m_threadLocalData; ///< Thread-specific data.
- };
- 
- thread_local int ThreadSpecificStorage::m_threadLocalData;
-
- /**
-  * @brief Function that simulates work by each thread, setting and getting its thread-specific data.
-  * @param threadId The unique identifier for the thread.
-  */
- void threadFunction(int threadId)
- {
-     ThreadSpecificStorage threadStorage;
- 
-     // Set a unique value for each thread
-     threadStorage.setValue(threadId);
- 
-     // Simulate some processing
-     std::this_thread::sleep_for(std::chrono::milliseconds(100));
- 
-     // Get the thread-specific value and print it
-     std::cout << "Thread " << threadId << " has value: " << threadStorage.getValue() << std::endl;
- }
- 
- /**
-  * @brief The main entry point of the program.
-  * This function starts multiple threads, each working with thread-specific storage.
-  */
- int main()
- {
-     std::vector<std::thread> threads;
- 
-     // Create and start multiple threads
-     for (int i = 0; i < 5; ++i)
-     {
-         threads.push_back(std::thread(threadFunction, i));
-     }
- 
-     // Wait for all threads to complete
-     for (auto& t : threads)
-     {
-         t.join();
-     }
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <map>
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <stdexcept>
+#include <cstddef>
+
+/**
+ * @brief A class representing thread-specific storage.
+ * This class demonstrates how to store unique data for each thread.
+ */
+class ThreadSpecificStorage
+{
+public:
+    /**
+     * @brief Sets a value specific to the current thread.
+     * @param value The value to store for the current thread.
+     */
+    void setValue(int value)
+    {
+        m_threadLocalData = value; // Store value specific to the current thread
+    }
+
+    /**
+     * @brief Gets the value specific to the current thread.
+     * @return The value stored for the current thread.
+     */
+    int getValue() const
+    {
+        return m_threadLocalData;
+    }
+
+private:
+    thread_local static int m_threadLocalData; ///< Thread-specific data.
+};
+
+thread_local int ThreadSpecificStorage::m_threadLocalData;
+
+/**
+ * @brief Per-thread storage behind one global lock; the slow baseline.
+ *
+ * Every access from every thread serializes on the same mutex, so this
+ * scales inversely with thread count.
+ */
+template <typename T>
+class MutexThreadStorage
+{
+public:
+    void setValue(const T& value)
+    {
+        std::lock_guard lock(m_mutex);
+        m_values[std::this_thread::get_id()] = value;
+    }
+
+    T getValue() const
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_values.find(std::this_thread::get_id());
+        return it == m_values.end() ? T{} : it->second;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::map<std::thread::id, T> m_values; ///< One entry per thread.
+};
+
+/**
+ * @brief Typed thread-specific slab with lock-free registration.
+ *
+ * A thread calls registerThread() exactly once to claim a slot index from an
+ * atomic counter; from then on slot(index) is a plain array access into the
+ * contiguous slab with zero synchronization. Slots are padded to a cache
+ * line so neighbouring threads never false-share, and the contiguous layout
+ * is what lets forEach() aggregate every thread's value in one linear pass.
+ */
+template <typename T>
+class SlabThreadStorage
+{
+public:
+    static constexpr std::size_t MAX_THREADS = 64; ///< Fixed slab capacity.
+
+    /**
+     * @brief Claims a slot for the calling thread; call once per thread.
+     * @return The slot index used for all later accesses.
+     */
+    std::size_t registerThread()
+    {
+        std::size_t index = m_registered.fetch_add(1, std::memory_order_acq_rel);
+        if (index >= MAX_THREADS)
+        {
+            throw std::runtime_error("SlabThreadStorage: slot capacity exhausted");
+        }
+        return index;
+    }
+
+    /**
+     * @brief The calling thread's slot; a plain array access, no locking.
+     */
+    T& slot(std::size_t index)
+    {
+        return m_slots[index].value;
+    }
+
+    /**
+     * @brief Aggregates all registered threads' values without stopping writers.
+     *
+     * Values are read through atomic_ref, so concurrent writers are never
+     * blocked and the snapshot sees each slot's value atomically (though
+     * different slots may be from slightly different moments).
+     */
+    template <typename Fn>
+    void forEach(Fn fn) const
+    {
+        std::size_t count = std::min(m_registered.load(std::memory_order_acquire), MAX_THREADS);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            fn(i, std::atomic_ref<const T>(m_slots[i].value).load(std::memory_order_relaxed));
+        }
+    }
+
+private:
+    /**
+     * @brief One thread's value, padded to its own cache line.
+     */
+    struct alignas(64) Slot
+    {
+        T value{};
+    };
+
+    std::array<Slot, MAX_THREADS> m_slots;       ///< Contiguous typed slab.
+    std::atomic<std::size_t> m_registered{0};    ///< Lock-free slot allocator.
+};
+
+/**
+ * @brief Function that simulates work by each thread, setting and getting its thread-specific data.
+ * @param threadId The unique identifier for the thread.
+ */
+void threadFunction(int threadId)
+{
+    ThreadSpecificStorage threadStorage;
+
+    // Set a unique value for each thread
+    threadStorage.setValue(threadId);
+
+    // Simulate some processing
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // Get the thread-specific value and print it
+    std::cout << "Thread " << threadId << " has value: " << threadStorage.getValue() << std::endl;
+}
+
+/**
+ * @brief The main entry point of the program.
+ * This function starts multiple threads, each working with thread-specific storage.
+ */
+int main()
+{
+    std::vector<std::thread> threads;
+
+    // Create and start multiple threads
+    for (int i = 0; i < 5; ++i)
+    {
+        threads.push_back(std::thread(threadFunction, i));
+    }
+
+    // Wait for all threads to complete
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    // Slab mode: register once, then every access is a plain array store.
+    constexpr int workerCount = 4;
+    constexpr int increments = 2000000;
+
+    MutexThreadStorage<long long> lockedStorage;
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < workerCount; ++t)
+        {
+            workers.emplace_back([&lockedStorage]
+            {
+                for (int i = 0; i < increments; ++i)
+                {
+                    lockedStorage.setValue(lockedStorage.getValue() + 1);
+                }
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    }
+    double lockedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    SlabThreadStorage<long long> slabStorage;
+    long long liveSnapshot = 0;
+    start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < workerCount; ++t)
+        {
+            workers.emplace_back([&slabStorage]
+            {
+                std::size_t slotIndex = slabStorage.registerThread(); // Once per thread.
+                long long& counter = slabStorage.slot(slotIndex);
+                for (int i = 0; i < increments; ++i)
+                {
+                    std::atomic_ref<long long>(counter).store(counter + 1, std::memory_order_relaxed);
+                }
+            });
+        }
+        // Aggregate mid-run: writers are never stopped.
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        slabStorage.forEach([&liveSnapshot](std::size_t, long long value) { liveSnapshot += value; });
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    }
+    double slabTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    long long total = 0;
+    slabStorage.forEach([&total](std::size_t, long long value) { total += value; });
+    std::cout << workerCount << " thread(s) x " << increments << " increment(s): mutex map "
+              << lockedTime << " ms, slab " << slabTime << " ms\n";
+    std::cout << "Live snapshot mid-run: " << liveSnapshot << ", final total: " << total << std::endl;
+
+    return 0;
+}
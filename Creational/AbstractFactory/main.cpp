@@ -1,145 +1,337 @@
 /**
  * @brief Abstract Factory Pattern Example
- * 
- * The Abstract Factory Pattern provides an interface for creating families of related or 
- * dependent objects without specifying their concrete classes. This pattern allows clients 
- * to work with abstract classes, instead of the concrete class implementations, 
+ *
+ * The Abstract Factory Pattern provides an interface for creating families of related or
+ * dependent objects without specifying their concrete classes. This pattern allows clients
+ * to work with abstract classes, instead of the concrete class implementations,
  * which promotes loose coupling.
- * 
+ *
  * Key Concepts:
  * - Defines an interface for creating related objects.
  * - Allows clients to work with abstract interfaces rather than concrete implementations.
  * - Helps manage complex object creation by organizing it into families of products.
- * 
+ *
  * Benefits:
  * - Provides flexibility to change the concrete classes of the products.
  * - Enhances maintainability by abstracting object creation.
  * - Allows for easy extension by adding new products without affecting client code.
+ *
+ * Building every widget of every themed set as an independent heap object wastes
+ * memory and time when thousands of sets are 95% identical. The flyweight mode
+ * below has factories return handles into a shared immutable widget-template
+ * arena; a themed set shares its factory's base layout and records only
+ * copy-on-write overrides, so creating a set costs O(differing widgets)
+ * allocations instead of O(total widgets).
  */
 
- #include <iostream>
- #include <memory>
- #include <string>
- 
- // Abstract Product: A family of related products
- class Button
- {
- public:
-     virtual void render() = 0; ///< Pure virtual method to render the button
-     virtual ~Button() = default; ///< Virtual destructor
- };
- 
- class Label
- {
- public:
-     virtual void render() = 0; ///< Pure virtual method to render the label
-     virtual ~Label() = default; ///< Virtual destructor
- };
- 
- // Concrete Product A1
- class WindowsButton : public Button
- {
- public:
-     void render() override
-     {
-         std::cout << "Rendering Windows Button" << std::endl;
-     }
- };
- 
- // Concrete Product A2
- class LinuxButton : public Button
- {
- public:
-     void render() override
-     {
-         std::cout << "Rendering Linux Button" << std::endl;
-     }
- };
- 
- // Concrete Product B1
- class WindowsLabel : public Label
- {
- public:
-     void render() override
-     {
-         std::cout << "Rendering Windows Label" << std::endl;
-     }
- };
- 
- // Concrete Product B2
- class LinuxLabel : public Label
- {
- public:
-     void render() override
-     {
-         std::cout << "Rendering Linux Label" << std::endl;
-     }
- };
- 
- // Abstract Factory: Defines an interface for creating related products
- class GUIFactory
- {
- public:
-     virtual std::shared_ptr<Button> createButton() = 0; ///< Pure virtual method to create a button
-     virtual std::shared_ptr<Label> createLabel() = 0; ///< Pure virtual method to create a label
-     virtual ~GUIFactory() = default; ///< Virtual destructor
- };
- 
- // Concrete Factory 1
- class WindowsFactory : public GUIFactory
- {
- public:
-     std::shared_ptr<Button> createButton() override
-     {
-         return std::make_shared<WindowsButton>(); ///< Create Windows button
-     }
- 
-     std::shared_ptr<Label> createLabel() override
-     {
-         return std::make_shared<WindowsLabel>(); ///< Create Windows label
-     }
- };
- 
- // Concrete Factory 2
- class LinuxFactory : public GUIFactory
- {
- public:
-     std::shared_ptr<Button> createButton() override
-     {
-         return std::make_shared<LinuxButton>(); ///< Create Linux button
-     }
- 
-     std::shared_ptr<Label> createLabel() override
-     {
-         return std::make_shared<LinuxLabel>(); ///< Create Linux label
-     }
- };
- 
- // Client code that uses the abstract factory to get products
- int main()
- {
-     // Choose the factory based on the operating system (this can be dynamic at runtime)
-     std::shared_ptr<GUIFactory> m_factory;
- 
-     std::string os = "Windows"; // Assume the OS is Windows for this example
- 
-     if (os == "Windows")
-     {
-         m_factory = std::make_shared<WindowsFactory>(); ///< Use Windows factory
-     }
-     else
-     {
-         m_factory = std::make_shared<LinuxFactory>(); ///< Use Linux factory
-     }
- 
-     // Create a button and a label using the factory
-     auto m_button = m_factory->createButton();
-     auto m_label = m_factory->createLabel();
- 
-     // Render the button and label
-     m_button->render();
-     m_label->render();
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <chrono>
+#include <cstdint>
+
+// Abstract Product: A family of related products
+class Button
+{
+public:
+    virtual void render() = 0; ///< Pure virtual method to render the button
+    virtual ~Button() = default; ///< Virtual destructor
+};
+
+class Label
+{
+public:
+    virtual void render() = 0; ///< Pure virtual method to render the label
+    virtual ~Label() = default; ///< Virtual destructor
+};
+
+// Concrete Product A1
+class WindowsButton : public Button
+{
+public:
+    void render() override
+    {
+        std::cout << "Rendering Windows Button" << std::endl;
+    }
+};
+
+// Concrete Product A2
+class LinuxButton : public Button
+{
+public:
+    void render() override
+    {
+        std::cout << "Rendering Linux Button" << std::endl;
+    }
+};
+
+// Concrete Product B1
+class WindowsLabel : public Label
+{
+public:
+    void render() override
+    {
+        std::cout << "Rendering Windows Label" << std::endl;
+    }
+};
+
+// Concrete Product B2
+class LinuxLabel : public Label
+{
+public:
+    void render() override
+    {
+        std::cout << "Rendering Linux Label" << std::endl;
+    }
+};
+
+// Abstract Factory: Defines an interface for creating related products
+class GUIFactory
+{
+public:
+    virtual std::shared_ptr<Button> createButton() = 0; ///< Pure virtual method to create a button
+    virtual std::shared_ptr<Label> createLabel() = 0; ///< Pure virtual method to create a label
+    virtual ~GUIFactory() = default; ///< Virtual destructor
+};
+
+// Concrete Factory 1
+class WindowsFactory : public GUIFactory
+{
+public:
+    std::shared_ptr<Button> createButton() override
+    {
+        return std::make_shared<WindowsButton>(); ///< Create Windows button
+    }
+
+    std::shared_ptr<Label> createLabel() override
+    {
+        return std::make_shared<WindowsLabel>(); ///< Create Windows label
+    }
+};
+
+// Concrete Factory 2
+class LinuxFactory : public GUIFactory
+{
+public:
+    std::shared_ptr<Button> createButton() override
+    {
+        return std::make_shared<LinuxButton>(); ///< Create Linux button
+    }
+
+    std::shared_ptr<Label> createLabel() override
+    {
+        return std::make_shared<LinuxLabel>(); ///< Create Linux label
+    }
+};
+
+// Flyweight mode: shared immutable templates, handle-based widget sets.
+
+/**
+ * @brief Immutable description of one widget; shared by every set using it.
+ */
+struct WidgetTemplate
+{
+    enum class Kind : std::uint8_t { Button, Label };
+
+    Kind kind;
+    std::string theme;
+    std::string caption;
+    std::uint32_t color;
+};
+
+/// @brief Index of a template inside the arena; 4 bytes instead of a pointer.
+using WidgetHandle = std::uint32_t;
+
+/**
+ * @brief Arena owning every widget template; templates never move or mutate.
+ */
+class WidgetTemplateArena
+{
+public:
+    /// @brief Adds a template and returns its handle.
+    WidgetHandle intern(WidgetTemplate widgetTemplate)
+    {
+        m_templates.push_back(std::move(widgetTemplate));
+        return static_cast<WidgetHandle>(m_templates.size() - 1);
+    }
+
+    /// @brief Resolves a handle; plain array indexing.
+    const WidgetTemplate& resolve(WidgetHandle handle) const
+    {
+        return m_templates[handle];
+    }
+
+    std::size_t size() const { return m_templates.size(); }
+
+private:
+    std::vector<WidgetTemplate> m_templates; ///< Immutable once interned.
+};
+
+/**
+ * @brief A themed widget set sharing its factory's base layout.
+ *
+ * The base layout is a shared immutable handle list; per-instance
+ * differences are recorded as sparse (slot, handle) overrides. Creating a
+ * set is one shared_ptr copy, and customizing it allocates only for the
+ * widgets that actually differ.
+ */
+class WidgetSet
+{
+public:
+    WidgetSet(std::shared_ptr<const std::vector<WidgetHandle>> baseLayout,
+              const WidgetTemplateArena* arena)
+        : m_baseLayout(std::move(baseLayout)), m_arena(arena)
+    {}
+
+    /// @brief Overrides one slot with a different template; O(1) amortized.
+    void overrideWidget(std::size_t slot, WidgetHandle handle)
+    {
+        for (auto& [overriddenSlot, overriddenHandle] : m_overrides)
+        {
+            if (overriddenSlot == slot)
+            {
+                overriddenHandle = handle;
+                return;
+            }
+        }
+        m_overrides.emplace_back(slot, handle);
+    }
+
+    /// @brief The template shown in a slot, override-aware.
+    const WidgetTemplate& widgetAt(std::size_t slot) const
+    {
+        for (const auto& [overriddenSlot, handle] : m_overrides)
+        {
+            if (overriddenSlot == slot)
+            {
+                return m_arena->resolve(handle);
+            }
+        }
+        return m_arena->resolve((*m_baseLayout)[slot]);
+    }
+
+    std::size_t size() const { return m_baseLayout->size(); }
+    std::size_t overrideCount() const { return m_overrides.size(); }
+
+private:
+    std::shared_ptr<const std::vector<WidgetHandle>> m_baseLayout; ///< Shared, immutable.
+    std::vector<std::pair<std::size_t, WidgetHandle>> m_overrides; ///< Sparse differences.
+    const WidgetTemplateArena* m_arena;                            ///< Shared template store.
+};
+
+/**
+ * @brief Theme factory producing flyweight-backed widget sets.
+ *
+ * The factory interns its theme's templates once and freezes a base layout;
+ * every createWidgetSet() call just shares that layout. The arena is shared
+ * across factories, so identical widgets of different themes still coexist
+ * without duplication.
+ */
+class ThemedSetFactory
+{
+public:
+    ThemedSetFactory(std::string theme, std::size_t widgetCount, WidgetTemplateArena& arena)
+        : m_arena(&arena)
+    {
+        auto layout = std::make_shared<std::vector<WidgetHandle>>();
+        layout->reserve(widgetCount);
+        for (std::size_t i = 0; i < widgetCount; ++i)
+        {
+            layout->push_back(arena.intern(WidgetTemplate{
+                i % 4 == 0 ? WidgetTemplate::Kind::Button : WidgetTemplate::Kind::Label,
+                theme,
+                "widget-" + std::to_string(i),
+                i % 4 == 0 ? 0x3366ccu : 0xddddddu}));
+        }
+        m_baseLayout = std::move(layout);
+    }
+
+    /// @brief A new themed set: one refcount bump, zero widget allocations.
+    WidgetSet createWidgetSet() const
+    {
+        return WidgetSet(m_baseLayout, m_arena);
+    }
+
+private:
+    std::shared_ptr<const std::vector<WidgetHandle>> m_baseLayout; ///< Frozen at construction.
+    WidgetTemplateArena* m_arena;
+};
+
+// Client code that uses the abstract factory to get products
+int main()
+{
+    // Choose the factory based on the operating system (this can be dynamic at runtime)
+    std::shared_ptr<GUIFactory> m_factory;
+
+    std::string os = "Windows"; // Assume the OS is Windows for this example
+
+    if (os == "Windows")
+    {
+        m_factory = std::make_shared<WindowsFactory>(); ///< Use Windows factory
+    }
+    else
+    {
+        m_factory = std::make_shared<LinuxFactory>(); ///< Use Linux factory
+    }
+
+    // Create a button and a label using the factory
+    auto m_button = m_factory->createButton();
+    auto m_label = m_factory->createLabel();
+
+    // Render the button and label
+    m_button->render();
+    m_label->render();
+
+    // Flyweight sets: thousands of 95%-identical themed widget sets.
+    constexpr std::size_t setCount = 2000;
+    constexpr std::size_t widgetsPerSet = 40;
+    constexpr std::size_t differingWidgets = 2;
+
+    // Baseline: every widget of every set as its own heap object.
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::vector<std::shared_ptr<WidgetTemplate>>> naiveSets;
+        naiveSets.reserve(setCount);
+        for (std::size_t s = 0; s < setCount; ++s)
+        {
+            std::vector<std::shared_ptr<WidgetTemplate>> set;
+            set.reserve(widgetsPerSet);
+            for (std::size_t i = 0; i < widgetsPerSet; ++i)
+            {
+                set.push_back(std::make_shared<WidgetTemplate>(WidgetTemplate{
+                    WidgetTemplate::Kind::Label, "Dark", "widget-" + std::to_string(i), 0xddddddu}));
+            }
+            naiveSets.push_back(std::move(set));
+        }
+    }
+    double naiveTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    WidgetTemplateArena arena;
+    ThemedSetFactory darkFactory("Dark", widgetsPerSet, arena);
+    WidgetHandle accentButton = arena.intern(
+        WidgetTemplate{WidgetTemplate::Kind::Button, "Dark", "accent", 0xff6600u});
+
+    start = std::chrono::steady_clock::now();
+    std::vector<WidgetSet> flyweightSets;
+    flyweightSets.reserve(setCount);
+    for (std::size_t s = 0; s < setCount; ++s)
+    {
+        WidgetSet set = darkFactory.createWidgetSet();
+        for (std::size_t d = 0; d < differingWidgets; ++d)
+        {
+            set.overrideWidget((s + d) % widgetsPerSet, accentButton); // Only the diffs.
+        }
+        flyweightSets.push_back(std::move(set));
+    }
+    double flyweightTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << setCount << " set(s) x " << widgetsPerSet << " widget(s): per-widget heap "
+              << naiveTime << " ms, flyweight sets " << flyweightTime << " ms ("
+              << arena.size() << " template(s) total, "
+              << flyweightSets.front().overrideCount() << " override(s) per set)" << std::endl;
+
+    return 0;
+}
@@ -12,288 +12,485 @@
  * 2. `VeggiePizzaBuilder` and `CheesePizzaBuilder` are concrete builders that implement the `PizzaBuilder` interface and define specific details for building a Veggie Pizza and Cheese Pizza.
  * 3. The `PizzaDirector` takes a builder object and coordinates the construction process, ensuring the pizza is assembled step by step.
  * 4. Finally, the client code constructs different pizzas using the builder pattern and describes the resulting pizzas.
+ *
+ * The shared_ptr-held builder copies its strings into the product one step at a
+ * time, which dominates when the same shape assembles order documents with
+ * thousands of line items. OrderBuilder below is move-centric: every chainable
+ * step is rvalue-qualified and moves the partially built product through the
+ * chain, reserve() preallocates item storage once, and buildInto(arena)
+ * constructs the finished document in caller-owned memory — zero intermediate
+ * copies end to end.
+ */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <chrono>
+#include <cstddef>
+#include <new>
+
+/**
+ * @brief Product class representing a pizza.
+ *
+ * The `Pizza` class represents the complex object that is being built. It has methods for setting
+ * its dough, sauce, and toppings, as well as for describing the pizza.
+ */
+class Pizza
+{
+public:
+    /**
+     * @brief Set the dough for the pizza.
+     *
+     * @param dough The type of dough for the pizza (e.g., "Whole Wheat", "Regular").
+     */
+    void setDough(const std::string &dough)
+    {
+        dough_ = dough;
+    }
+
+    /**
+     * @brief Set the sauce for the pizza.
+     *
+     * @param sauce The type of sauce for the pizza (e.g., "Tomato", "Cream").
+     */
+    void setSauce(const std::string &sauce)
+    {
+        sauce_ = sauce;
+    }
+
+    /**
+     * @brief Set the toppings for the pizza.
+     *
+     * @param toppings A list of toppings for the pizza (e.g., "Olives", "Cheese").
+     */
+    void setToppings(const std::vector<std::string> &toppings)
+    {
+        toppings_ = toppings;
+    }
+
+    /**
+     * @brief Describe the pizza.
+     *
+     * This method prints out a description of the pizza, including its dough, sauce, and toppings.
+     */
+    void describe() const
+    {
+        std::cout << "Pizza with " << dough_ << " dough, "
+                  << sauce_ << " sauce, and toppings: ";
+        for (const auto &topping : toppings_)
+        {
+            std::cout << topping << " ";
+        }
+        std::cout << "\n";
+    }
+
+private:
+    std::string dough_; ///< Dough type for the pizza
+    std::string sauce_; ///< Sauce type for the pizza
+    std::vector<std::string> toppings_; ///< List of toppings for the pizza
+};
+
+/**
+ * @brief Abstract Builder class for constructing pizzas.
+ *
+ * The `PizzaBuilder` class defines the abstract interface for constructing the different parts of a pizza,
+ * such as the dough, sauce, and toppings. Concrete builders implement this interface to build specific types of pizzas.
+ */
+class PizzaBuilder
+{
+public:
+    virtual ~PizzaBuilder() = default;
+
+    /**
+     * @brief Build the dough for the pizza.
+     *
+     * Concrete builders must implement this method to define how the dough is built.
+     */
+    virtual void buildDough() = 0;
+
+    /**
+     * @brief Build the sauce for the pizza.
+     *
+     * Concrete builders must implement this method to define how the sauce is built.
+     */
+    virtual void buildSauce() = 0;
+
+    /**
+     * @brief Build the toppings for the pizza.
+     *
+     * Concrete builders must implement this method to define how the toppings are built.
+     */
+    virtual void buildToppings() = 0;
+
+    /**
+     * @brief Get the constructed pizza.
+     *
+     * This method returns the pizza object after it has been fully constructed.
+     *
+     * @return A shared pointer to the constructed pizza.
+     */
+    virtual std::shared_ptr<Pizza> getPizza() = 0;
+};
+
+/**
+ * @brief Concrete builder class for creating Veggie pizza.
+ *
+ * The `VeggiePizzaBuilder` class is a concrete implementation of the `PizzaBuilder` interface. It builds
+ * a Veggie pizza by specifying the dough, sauce, and toppings.
+ */
+class VeggiePizzaBuilder : public PizzaBuilder
+{
+public:
+    VeggiePizzaBuilder() : pizza_(std::make_shared<Pizza>()) {}
+
+    /**
+     * @brief Build the dough for the Veggie pizza.
+     *
+     * Sets the dough to "Whole Wheat".
+     */
+    void buildDough() override
+    {
+        pizza_->setDough("Whole Wheat");
+    }
+
+    /**
+     * @brief Build the sauce for the Veggie pizza.
+     *
+     * Sets the sauce to "Tomato".
+     */
+    void buildSauce() override
+    {
+        pizza_->setSauce("Tomato");
+    }
+
+    /**
+     * @brief Build the toppings for the Veggie pizza.
+     *
+     * Adds "Olives", "Bell Peppers", and "Mushrooms" as toppings.
+     */
+    void buildToppings() override
+    {
+        pizza_->setToppings({"Olives", "Bell Peppers", "Mushrooms"});
+    }
+
+    /**
+     * @brief Get the constructed Veggie pizza.
+     *
+     * Returns the fully constructed Veggie pizza.
+     *
+     * @return A shared pointer to the constructed Veggie pizza.
+     */
+    std::shared_ptr<Pizza> getPizza() override
+    {
+        return pizza_;
+    }
+
+private:
+    std::shared_ptr<Pizza> pizza_; ///< The pizza object being constructed
+};
+
+/**
+ * @brief Concrete builder class for creating Cheese pizza.
+ *
+ * The `CheesePizzaBuilder` class is a concrete implementation of the `PizzaBuilder` interface. It builds
+ * a Cheese pizza by specifying the dough, sauce, and toppings.
+ */
+class CheesePizzaBuilder : public PizzaBuilder
+{
+public:
+    CheesePizzaBuilder() : pizza_(std::make_shared<Pizza>()) {}
+
+    /**
+     * @brief Build the dough for the Cheese pizza.
+     *
+     * Sets the dough to "Regular".
+     */
+    void buildDough() override
+    {
+        pizza_->setDough("Regular");
+    }
+
+    /**
+     * @brief Build the sauce for the Cheese pizza.
+     *
+     * Sets the sauce to "Cream".
+     */
+    void buildSauce() override
+    {
+        pizza_->setSauce("Cream");
+    }
+
+    /**
+     * @brief Build the toppings for the Cheese pizza.
+     *
+     * Adds "Cheese" as the only topping.
+     */
+    void buildToppings() override
+    {
+        pizza_->setToppings({"Cheese"});
+    }
+
+    /**
+     * @brief Get the constructed Cheese pizza.
+     *
+     * Returns the fully constructed Cheese pizza.
+     *
+     * @return A shared pointer to the constructed Cheese pizza.
+     */
+    std::shared_ptr<Pizza> getPizza() override
+    {
+        return pizza_;
+    }
+
+private:
+    std::shared_ptr<Pizza> pizza_; ///< The pizza object being constructed
+};
+
+/**
+ * @brief Director class that constructs pizzas using a builder.
+ *
+ * The `PizzaDirector` class coordinates the construction of a pizza by using a `PizzaBuilder` object.
+ * It controls the steps of pizza creation without needing to know the details of the pizza.
+ */
+class PizzaDirector
+{
+public:
+    /**
+     * @brief Constructor that accepts a builder.
+     *
+     * @param builder A shared pointer to a `PizzaBuilder` object used to construct the pizza.
+     */
+    PizzaDirector(std::shared_ptr<PizzaBuilder> builder)
+        : builder_(builder) {}
+
+    /**
+     * @brief Construct a pizza using the builder.
+     *
+     * This method uses the builder to construct the pizza step by step (dough, sauce, toppings).
+     *
+     * @return A shared pointer to the constructed pizza.
+     */
+    std::shared_ptr<Pizza> construct()
+    {
+        builder_->buildDough();
+        builder_->buildSauce();
+        builder_->buildToppings();
+        return builder_->getPizza();
+    }
+
+private:
+    std::shared_ptr<PizzaBuilder> builder_; ///< The builder used to construct the pizza
+};
+
+/**
+ * @brief A large built product: an order document with many line items.
  */
+struct OrderDocument
+{
+    std::string customer;               ///< Who the order belongs to.
+    std::vector<std::string> lineItems; ///< Potentially thousands of items.
+};
+
+/**
+ * @brief Caller-owned storage that buildInto() constructs documents in.
+ *
+ * A bump allocator over one reservation; destroyAll() runs the destructors of
+ * every document built into it and recycles the memory.
+ */
+class OrderArena
+{
+public:
+    explicit OrderArena(std::size_t capacityBytes)
+        : m_buffer(capacityBytes)
+    {}
+
+    ~OrderArena() { destroyAll(); }
+
+    /// @brief Reserves aligned storage for one document; nullptr when full.
+    void* allocate(std::size_t bytes, std::size_t alignment)
+    {
+        std::size_t offset = (m_used + alignment - 1) & ~(alignment - 1);
+        if (offset + bytes > m_buffer.size())
+        {
+            return nullptr;
+        }
+        m_used = offset + bytes;
+        return m_buffer.data() + offset;
+    }
+
+    /// @brief Remembers a constructed document so destroyAll() can clean it up.
+    void track(OrderDocument* document) { m_documents.push_back(document); }
+
+    /// @brief Destroys every tracked document and resets the bump offset.
+    void destroyAll()
+    {
+        for (OrderDocument* document : m_documents)
+        {
+            document->~OrderDocument();
+        }
+        m_documents.clear();
+        m_used = 0;
+    }
+
+    std::size_t documentCount() const { return m_documents.size(); }
+
+private:
+    std::vector<std::byte> m_buffer;          ///< The single backing allocation.
+    std::size_t m_used{0};                    ///< Bump offset.
+    std::vector<OrderDocument*> m_documents;  ///< Built documents, for cleanup.
+};
+
+/**
+ * @brief Copy-style value builder; the baseline the move pipeline replaces.
+ *
+ * Each chain step returns a fresh builder by value, copying the partially
+ * built document — for an n-item order that is O(n^2) string copies.
+ */
+class CopyOrderBuilder
+{
+public:
+    CopyOrderBuilder customer(const std::string& name) const
+    {
+        CopyOrderBuilder next(*this);
+        next.m_document.customer = name;
+        return next;
+    }
+
+    CopyOrderBuilder addItem(const std::string& item) const
+    {
+        CopyOrderBuilder next(*this); // Copies every item accumulated so far.
+        next.m_document.lineItems.push_back(item);
+        return next;
+    }
+
+    OrderDocument build() const { return m_document; }
+
+private:
+    OrderDocument m_document;
+};
+
+/**
+ * @brief Move-centric builder: the product flows through the chain by move.
+ *
+ * Every step is rvalue-qualified, so the chain only compiles on temporaries
+ * or explicitly moved builders and each step hands the same document along
+ * without copying it. reserve() sizes the item storage once up front, and
+ * the buildInto() terminal constructs the finished document directly in a
+ * caller-owned arena.
+ */
+class OrderBuilder
+{
+public:
+    /// @brief Preallocates line-item storage once; no growth reallocations later.
+    OrderBuilder&& reserve(std::size_t itemCount) &&
+    {
+        m_document.lineItems.reserve(itemCount);
+        return std::move(*this);
+    }
+
+    /// @brief Names the customer; the string is moved in, not copied.
+    OrderBuilder&& customer(std::string name) &&
+    {
+        m_document.customer = std::move(name);
+        return std::move(*this);
+    }
+
+    /// @brief Appends one line item by move.
+    OrderBuilder&& addItem(std::string item) &&
+    {
+        m_document.lineItems.push_back(std::move(item));
+        return std::move(*this);
+    }
+
+    /// @brief Terminal step: moves the finished document out.
+    OrderDocument build() &&
+    {
+        return std::move(m_document);
+    }
+
+    /**
+     * @brief Terminal step: constructs the document in caller-owned memory.
+     * @return The arena-resident document, or nullptr if the arena is full.
+     */
+    OrderDocument* buildInto(OrderArena& arena) &&
+    {
+        void* storage = arena.allocate(sizeof(OrderDocument), alignof(OrderDocument));
+        if (!storage)
+        {
+            return nullptr;
+        }
+        auto* document = new (storage) OrderDocument(std::move(m_document));
+        arena.track(document);
+        return document;
+    }
+
+private:
+    OrderDocument m_document; ///< The product, moved through every step.
+};
+
+/**
+ * @brief Main function demonstrating the Builder pattern.
+ *
+ * This function demonstrates the use of the Builder pattern to construct different types of pizzas
+ * (Veggie and Cheese) using respective builders and a director.
+ */
+int main()
+{
+    // Use VeggiePizzaBuilder
+    auto veggieBuilder = std::make_shared<VeggiePizzaBuilder>();
+    PizzaDirector director(veggieBuilder);
+
+    auto veggiePizza = director.construct();
+    veggiePizza->describe();
+
+    // Use CheesePizzaBuilder
+    auto cheeseBuilder = std::make_shared<CheesePizzaBuilder>();
+    PizzaDirector director2(cheeseBuilder);
+
+    auto cheesePizza = director2.construct();
+    cheesePizza->describe();
+
+    // Move pipeline: large order documents with zero intermediate copies.
+    constexpr std::size_t orderCount = 400;
+    constexpr std::size_t itemsPerOrder = 100;
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<OrderDocument> copyOrders;
+        copyOrders.reserve(orderCount);
+        for (std::size_t o = 0; o < orderCount; ++o)
+        {
+            CopyOrderBuilder builder;
+            builder = builder.customer("customer-" + std::to_string(o));
+            for (std::size_t i = 0; i < itemsPerOrder; ++i)
+            {
+                builder = builder.addItem("line-item-stock-keeping-unit-" + std::to_string(i));
+            }
+            copyOrders.push_back(builder.build());
+        }
+    }
+    double copyTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    OrderArena arena(orderCount * sizeof(OrderDocument) + alignof(OrderDocument));
+    start = std::chrono::steady_clock::now();
+    for (std::size_t o = 0; o < orderCount; ++o)
+    {
+        OrderBuilder builder = std::move(OrderBuilder{})
+            .reserve(itemsPerOrder)
+            .customer("customer-" + std::to_string(o));
+        for (std::size_t i = 0; i < itemsPerOrder; ++i)
+        {
+            builder = std::move(builder).addItem("line-item-stock-keeping-unit-" + std::to_string(i));
+        }
+        std::move(builder).buildInto(arena); // Final product lands in caller memory.
+    }
+    double moveTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << orderCount << " order(s) x " << itemsPerOrder << " item(s): copy chain "
+              << copyTime << " ms, move pipeline into arena " << moveTime << " ms ("
+              << arena.documentCount() << " document(s) arena-resident)" << std::endl;
 
- #include <iostream>
- #include <memory>
- #include <string>
- #include <vector>
- 
- /**
-  * @brief Product class representing a pizza.
-  *
-  * The `Pizza` class represents the complex object that is being built. It has methods for setting
-  * its dough, sauce, and toppings, as well as for describing the pizza.
-  */
- class Pizza
- {
- public:
-     /**
-      * @brief Set the dough for the pizza.
-      * 
-      * @param dough The type of dough for the pizza (e.g., "Whole Wheat", "Regular").
-      */
-     void setDough(const std::string &dough)
-     {
-         dough_ = dough;
-     }
- 
-     /**
-      * @brief Set the sauce for the pizza.
-      * 
-      * @param sauce The type of sauce for the pizza (e.g., "Tomato", "Cream").
-      */
-     void setSauce(const std::string &sauce)
-     {
-         sauce_ = sauce;
-     }
- 
-     /**
-      * @brief Set the toppings for the pizza.
-      * 
-      * @param toppings A list of toppings for the pizza (e.g., "Olives", "Cheese").
-      */
-     void setToppings(const std::vector<std::string> &toppings)
-     {
-         toppings_ = toppings;
-     }
- 
-     /**
-      * @brief Describe the pizza.
-      * 
-      * This method prints out a description of the pizza, including its dough, sauce, and toppings.
-      */
-     void describe() const
-     {
-         std::cout << "Pizza with " << dough_ << " dough, "
-                   << sauce_ << " sauce, and toppings: ";
-         for (const auto &topping : toppings_)
-         {
-             std::cout << topping << " ";
-         }
-         std::cout << "\n";
-     }
- 
- private:
-     std::string dough_; ///< Dough type for the pizza
-     std::string sauce_; ///< Sauce type for the pizza
-     std::vector<std::string> toppings_; ///< List of toppings for the pizza
- };
- 
- /**
-  * @brief Abstract Builder class for constructing pizzas.
-  *
-  * The `PizzaBuilder` class defines the abstract interface for constructing the different parts of a pizza,
-  * such as the dough, sauce, and toppings. Concrete builders implement this interface to build specific types of pizzas.
-  */
- class PizzaBuilder
- {
- public:
-     virtual ~PizzaBuilder() = default;
- 
-     /**
-      * @brief Build the dough for the pizza.
-      * 
-      * Concrete builders must implement this method to define how the dough is built.
-      */
-     virtual void buildDough() = 0;
- 
-     /**
-      * @brief Build the sauce for the pizza.
-      * 
-      * Concrete builders must implement this method to define how the sauce is built.
-      */
-     virtual void buildSauce() = 0;
- 
-     /**
-      * @brief Build the toppings for the pizza.
-      * 
-      * Concrete builders must implement this method to define how the toppings are built.
-      */
-     virtual void buildToppings() = 0;
- 
-     /**
-      * @brief Get the constructed pizza.
-      * 
-      * This method returns the pizza object after it has been fully constructed.
-      * 
-      * @return A shared pointer to the constructed pizza.
-      */
-     virtual std::shared_ptr<Pizza> getPizza() = 0;
- };
- 
- /**
-  * @brief Concrete builder class for creating Veggie pizza.
-  *
-  * The `VeggiePizzaBuilder` class is a concrete implementation of the `PizzaBuilder` interface. It builds
-  * a Veggie pizza by specifying the dough, sauce, and toppings.
-  */
- class VeggiePizzaBuilder : public PizzaBuilder
- {
- public:
-     VeggiePizzaBuilder() : pizza_(std::make_shared<Pizza>()) {}
- 
-     /**
-      * @brief Build the dough for the Veggie pizza.
-      * 
-      * Sets the dough to "Whole Wheat".
-      */
-     void buildDough() override
-     {
-         pizza_->setDough("Whole Wheat");
-     }
- 
-     /**
-      * @brief Build the sauce for the Veggie pizza.
-      * 
-      * Sets the sauce to "Tomato".
-      */
-     void buildSauce() override
-     {
-         pizza_->setSauce("Tomato");
-     }
- 
-     /**
-      * @brief Build the toppings for the Veggie pizza.
-      * 
-      * Adds "Olives", "Bell Peppers", and "Mushrooms" as toppings.
-      */
-     void buildToppings() override
-     {
-         pizza_->setToppings({"Olives", "Bell Peppers", "Mushrooms"});
-     }
- 
-     /**
-      * @brief Get the constructed Veggie pizza.
-      * 
-      * Returns the fully constructed Veggie pizza.
-      * 
-      * @return A shared pointer to the constructed Veggie pizza.
-      */
-     std::shared_ptr<Pizza> getPizza() override
-     {
-         return pizza_;
-     }
- 
- private:
-     std::shared_ptr<Pizza> pizza_; ///< The pizza object being constructed
- };
- 
- /**
-  * @brief Concrete builder class for creating Cheese pizza.
-  *
-  * The `CheesePizzaBuilder` class is a concrete implementation of the `PizzaBuilder` interface. It builds
-  * a Cheese pizza by specifying the dough, sauce, and toppings.
-  */
- class CheesePizzaBuilder : public PizzaBuilder
- {
- public:
-     CheesePizzaBuilder() : pizza_(std::make_shared<Pizza>()) {}
- 
-     /**
-      * @brief Build the dough for the Cheese pizza.
-      * 
-      * Sets the dough to "Regular".
-      */
-     void buildDough() override
-     {
-         pizza_->setDough("Regular");
-     }
- 
-     /**
-      * @brief Build the sauce for the Cheese pizza.
-      * 
-      * Sets the sauce to "Cream".
-      */
-     void buildSauce() override
-     {
-         pizza_->setSauce("Cream");
-     }
- 
-     /**
-      * @brief Build the toppings for the Cheese pizza.
-      * 
-      * Adds "Cheese" as the only topping.
-      */
-     void buildToppings() override
-     {
-         pizza_->setToppings({"Cheese"});
-     }
- 
-     /**
-      * @brief Get the constructed Cheese pizza.
-      * 
-      * Returns the fully constructed Cheese pizza.
-      * 
-      * @return A shared pointer to the constructed Cheese pizza.
-      */
-     std::shared_ptr<Pizza> getPizza() override
-     {
-         return pizza_;
-     }
- 
- private:
-     std::shared_ptr<Pizza> pizza_; ///< The pizza object being constructed
- };
- 
- /**
-  * @brief Director class that constructs pizzas using a builder.
-  *
-  * The `PizzaDirector` class coordinates the construction of a pizza by using a `PizzaBuilder` object. 
-  * It controls the steps of pizza creation without needing to know the details of the pizza.
-  */
- class PizzaDirector
- {
- public:
-     /**
-      * @brief Constructor that accepts a builder.
-      * 
-      * @param builder A shared pointer to a `PizzaBuilder` object used to construct the pizza.
-      */
-     PizzaDirector(std::shared_ptr<PizzaBuilder> builder)
-         : builder_(builder) {}
- 
-     /**
-      * @brief Construct a pizza using the builder.
-      * 
-      * This method uses the builder to construct the pizza step by step (dough, sauce, toppings).
-      * 
-      * @return A shared pointer to the constructed pizza.
-      */
-     std::shared_ptr<Pizza> construct()
-     {
-         builder_->buildDough();
-         builder_->buildSauce();
-         builder_->buildToppings();
-         return builder_->getPizza();
-     }
- 
- private:
-     std::shared_ptr<PizzaBuilder> builder_; ///< The builder used to construct the pizza
- };
- 
- /**
-  * @brief Main function demonstrating the Builder pattern.
-  *
-  * This function demonstrates the use of the Builder pattern to construct different types of pizzas
-  * (Veggie and Cheese) using respective builders and a director.
-  */
- int main()
- {
-     // Use VeggiePizzaBuilder
-     auto veggieBuilder = std::make_shared<VeggiePizzaBuilder>();
-     PizzaDirector director(veggieBuilder);
- 
-     auto veggiePizza = director.construct();
-     veggiePizza->describe();
- 
-     // Use CheesePizzaBuilder
-     auto cheeseBuilder = std::make_shared<CheesePizzaBuilder>();
-     PizzaDirector director2(cheeseBuilder);
- 
-     auto cheesePizza = director2.construct();
-     cheesePizza->describe();
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
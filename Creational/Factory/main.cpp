@@ -1,96 +1,256 @@
 /**
  * @brief Factory Pattern Example
- * 
- * The Factory Pattern provides a way to encapsulate the object creation logic. 
- * It allows for creating instances of a class without exposing the exact instantiation logic 
- * to the client. This pattern is useful when you want to manage the creation of objects 
+ *
+ * The Factory Pattern provides a way to encapsulate the object creation logic.
+ * It allows for creating instances of a class without exposing the exact instantiation logic
+ * to the client. This pattern is useful when you want to manage the creation of objects
  * without tightly coupling the client to the class's concrete implementation.
- * 
+ *
  * Key Concepts:
  * - Encapsulation of object creation logic.
  * - Separation of object construction from client code.
  * - Simplifies object creation when multiple variations exist.
- * 
+ *
  * Benefits:
  * - Simplifies the client code by abstracting away object creation.
  * - Allows for flexibility in how objects are created.
+ *
+ * Branching on a runtime string and allocating per creation is wasteful when a
+ * screen load instantiates ~100k components. The compile-time registry below
+ * registers components via template specialization so create<ButtonTag>() resolves
+ * statically and inlines, maps dynamic strings through a perfect hash instead of
+ * chained compares, and bulk-creates into a contiguous arena so screen construction
+ * is one allocation and a linear initialization sweep.
  */
 
- #include <iostream>
- #include <memory>
- #include <string>
- 
- // Abstract Component: A base class for various UI elements
- class Component
- {
- public:
-     virtual void render() = 0; ///< Pure virtual method to render the component
-     virtual ~Component() = default; ///< Virtual destructor
- };
- 
- // Concrete Component: Button
- class Button : public Component
- {
- public:
-     void render() override
-     {
-         std::cout << "Rendering Button" << std::endl;
-     }
- };
- 
- // Concrete Component: Label
- class Label : public Component
- {
- public:
-     void render() override
-     {
-         std::cout << "Rendering Label" << std::endl;
-     }
- };
- 
- // Factory: A class that creates components based on certain conditions
- class ComponentFactory
- {
- public:
-     /**
-      * @brief Creates a component based on the specified type.
-      * 
-      * This factory method returns a shared pointer to the requested component type.
-      * 
-      * @param type The type of component to create (e.g., "Button" or "Label").
-      * @return A shared pointer to the created component.
-      */
-     static std::shared_ptr<Component> createComponent(const std::string &type)
-     {
-         if (type == "Button")
-         {
-             return std::make_shared<Button>(); ///< Create and return a Button instance
-         }
-         else if (type == "Label")
-         {
-             return std::make_shared<Label>(); ///< Create and return a Label instance
-         }
-         return nullptr; ///< Return nullptr if type is unknown
-     }
- };
- 
- // Client code using the Factory to create components
- int main()
- {
-     // Create a Button using the factory
-     auto m_button = ComponentFactory::createComponent("Button");
-     if (m_button)
-     {
-         m_button->render(); ///< Renders the Button
-     }
- 
-     // Create a Label using the factory
-     auto m_label = ComponentFactory::createComponent("Label");
-     if (m_label)
-     {
-         m_label->render(); ///< Renders the Label
-     }
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <span>
+#include <optional>
+#include <chrono>
+#include <cstdint>
+
+// Abstract Component: A base class for various UI elements
+class Component
+{
+public:
+    virtual void render() = 0; ///< Pure virtual method to render the component
+    virtual ~Component() = default; ///< Virtual destructor
+};
+
+// Concrete Component: Button
+class Button : public Component
+{
+public:
+    void render() override
+    {
+        std::cout << "Rendering Button" << std::endl;
+    }
+};
+
+// Concrete Component: Label
+class Label : public Component
+{
+public:
+    void render() override
+    {
+        std::cout << "Rendering Label" << std::endl;
+    }
+};
+
+// Factory: A class that creates components based on certain conditions
+class ComponentFactory
+{
+public:
+    /**
+     * @brief Creates a component based on the specified type.
+     *
+     * This factory method returns a shared pointer to the requested component type.
+     *
+     * @param type The type of component to create (e.g., "Button" or "Label").
+     * @return A shared pointer to the created component.
+     */
+    static std::shared_ptr<Component> createComponent(const std::string &type)
+    {
+        if (type == "Button")
+        {
+            return std::make_shared<Button>(); ///< Create and return a Button instance
+        }
+        else if (type == "Label")
+        {
+            return std::make_shared<Label>(); ///< Create and return a Label instance
+        }
+        return nullptr; ///< Return nullptr if type is unknown
+    }
+};
+
+// Tags naming each component type at compile time
+struct ButtonTag {};
+struct LabelTag {};
+
+// Compile-time registry: one specialization per component type.
+// create<Tag>() resolves through this trait statically — no string, no branch.
+template <typename Tag>
+struct ComponentTraits;
+
+template <>
+struct ComponentTraits<ButtonTag>
+{
+    using type = Button;
+    static constexpr std::string_view name = "Button";
+    static constexpr std::uint8_t kindId = 0;
+};
+
+template <>
+struct ComponentTraits<LabelTag>
+{
+    using type = Label;
+    static constexpr std::string_view name = "Label";
+    static constexpr std::uint8_t kindId = 1;
+};
+
+/**
+ * @brief Statically dispatched creation; inlines to the constructor call.
+ */
+template <typename Tag>
+typename ComponentTraits<Tag>::type create()
+{
+    return typename ComponentTraits<Tag>::type{};
+}
+
+/**
+ * @brief Perfect-hash string->kind for the dynamic case.
+ *
+ * "Button" and "Label" differ in length, so length-5 is a collision-free
+ * index into a two-entry table; one string compare verifies the candidate.
+ */
+inline std::optional<std::uint8_t> kindFromName(std::string_view name)
+{
+    static constexpr std::array<std::string_view, 2> NAMES{ComponentTraits<LabelTag>::name,
+                                                           ComponentTraits<ButtonTag>::name};
+    static constexpr std::array<std::uint8_t, 2> KINDS{ComponentTraits<LabelTag>::kindId,
+                                                       ComponentTraits<ButtonTag>::kindId};
+    std::size_t slot = name.size() - 5;
+    if (slot < NAMES.size() && NAMES[slot] == name)
+    {
+        return KINDS[slot];
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Contiguous per-type component storage for one screen.
+ *
+ * build() counts each kind, reserves both columns once, and fills them in a
+ * single linear sweep — no per-component allocation, and renderAll() walks
+ * homogeneous arrays where the compiler sees the concrete render() bodies.
+ */
+class ScreenArena
+{
+public:
+    /**
+     * @brief Bulk-creates components from a list of kind ids.
+     */
+    void build(std::span<const std::uint8_t> kinds)
+    {
+        std::size_t buttonCount = 0;
+        for (std::uint8_t kind : kinds)
+        {
+            buttonCount += kind == ComponentTraits<ButtonTag>::kindId;
+        }
+        m_buttons.clear();
+        m_labels.clear();
+        m_buttons.reserve(buttonCount);
+        m_labels.reserve(kinds.size() - buttonCount);
+        for (std::uint8_t kind : kinds)
+        {
+            if (kind == ComponentTraits<ButtonTag>::kindId)
+            {
+                m_buttons.emplace_back();
+            }
+            else
+            {
+                m_labels.emplace_back();
+            }
+        }
+    }
+
+    std::size_t size() const { return m_buttons.size() + m_labels.size(); }
+
+    /// @brief Renders every component, column by column.
+    void renderAll()
+    {
+        for (Button& button : m_buttons)
+        {
+            button.render();
+        }
+        for (Label& label : m_labels)
+        {
+            label.render();
+        }
+    }
+
+private:
+    std::vector<Button> m_buttons; ///< All buttons, contiguous.
+    std::vector<Label> m_labels;   ///< All labels, contiguous.
+};
+
+// Client code using the Factory to create components
+int main()
+{
+    // Create a Button using the factory
+    auto m_button = ComponentFactory::createComponent("Button");
+    if (m_button)
+    {
+        m_button->render(); ///< Renders the Button
+    }
+
+    // Create a Label using the factory
+    auto m_label = ComponentFactory::createComponent("Label");
+    if (m_label)
+    {
+        m_label->render(); ///< Renders the Label
+    }
+
+    // Static dispatch: resolved at compile time, no string anywhere.
+    Button staticButton = create<ButtonTag>();
+    staticButton.render();
+
+    // Perfect hash replaces the if/else chain for dynamic names.
+    std::cout << "kindFromName(\"Label\") = " << int(*kindFromName("Label"))
+              << ", unknown -> " << (kindFromName("Slider") ? "hit" : "miss") << std::endl;
+
+    // Screen load: 100k components, string factory vs bulk arena.
+    constexpr std::size_t componentCount = 100000;
+    std::vector<std::string> names;
+    std::vector<std::uint8_t> kinds;
+    for (std::size_t i = 0; i < componentCount; ++i)
+    {
+        names.push_back(i % 2 ? "Button" : "Label");
+        kinds.push_back(*kindFromName(names.back()));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<Component>> heapComponents;
+    heapComponents.reserve(componentCount);
+    for (const std::string& name : names)
+    {
+        heapComponents.push_back(ComponentFactory::createComponent(name));
+    }
+    double factoryTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    ScreenArena screen;
+    start = std::chrono::steady_clock::now();
+    screen.build(kinds);
+    double arenaTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << componentCount << " component(s): string factory " << factoryTime
+              << " ms, arena sweep " << arenaTime << " ms (" << screen.size()
+              << " built)" << std::endl;
+
+    return 0;
+}
@@ -12,152 +12,352 @@
  * 3. `ConcreteCreator` classes will implement the `createProduct` method to create specific products.
  *
  * This example uses the Factory Method pattern to create different types of `Animal` objects.
+ *
+ * Heap-allocating every product is too expensive when the same shape creates half a
+ * million instances per second. The pooled factories below back each concrete factory
+ * with a typed slab pool: released instances recycle onto a free list, createBatch()
+ * amortizes the pool lock over whole batches, and slots live in preallocated slabs so
+ * steady-state creation does zero heap allocations.
+ */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <cstddef>
+#include <new>
+
+/**
+ * @brief Abstract base class representing an animal.
+ *
+ * The `Animal` class defines the interface that all concrete animal classes must implement.
+ * Each animal class will have a `speak` method that defines the sound the animal makes.
+ */
+class Animal
+{
+public:
+    /**
+     * @brief Speak the sound of the animal.
+     *
+     * This method will be overridden by each concrete animal class to simulate the sound the animal makes.
+     */
+    virtual void speak() const = 0;
+
+    virtual ~Animal() = default; ///< Virtual destructor for proper cleanup of derived objects
+};
+
+/**
+ * @brief Concrete class representing a Dog.
+ *
+ * The `Dog` class implements the `speak` method to simulate the sound of a dog barking.
  */
+class Dog : public Animal
+{
+public:
+    /**
+     * @brief Simulate the sound of a dog barking.
+     *
+     * This method overrides the `speak` method to simulate the barking of a dog.
+     */
+    void speak() const override
+    {
+        std::cout << "Woof! Woof!\n";
+    }
+};
+
+/**
+ * @brief Concrete class representing a Cat.
+ *
+ * The `Cat` class implements the `speak` method to simulate the sound of a cat meowing.
+ */
+class Cat : public Animal
+{
+public:
+    /**
+     * @brief Simulate the sound of a cat meowing.
+     *
+     * This method overrides the `speak` method to simulate the meowing of a cat.
+     */
+    void speak() const override
+    {
+        std::cout << "Meow! Meow!\n";
+    }
+};
+
+/**
+ * @brief Abstract base class for animal factories.
+ *
+ * The `AnimalFactory` class declares the `createAnimal` method, which must be implemented
+ * by all concrete factories to create specific types of animals.
+ */
+class AnimalFactory
+{
+public:
+    /**
+     * @brief Create an animal.
+     *
+     * This method must be overridden by concrete factories to create a specific type of animal.
+     *
+     * @return A unique pointer to a new `Animal` object.
+     */
+    virtual std::unique_ptr<Animal> createAnimal() const = 0;
+
+    virtual ~AnimalFactory() = default; ///< Virtual destructor for proper cleanup of derived factories
+};
+
+/**
+ * @brief Concrete factory for creating Dog objects.
+ *
+ * The `DogFactory` class implements the `createAnimal` method to create `Dog` objects.
+ */
+class DogFactory : public AnimalFactory
+{
+public:
+    /**
+     * @brief Create a Dog object.
+     *
+     * This method overrides the `createAnimal` method to create and return a new `Dog` object.
+     *
+     * @return A unique pointer to a new `Dog` object.
+     */
+    std::unique_ptr<Animal> createAnimal() const override
+    {
+        return std::make_unique<Dog>();
+    }
+};
+
+/**
+ * @brief Concrete factory for creating Cat objects.
+ *
+ * The `CatFactory` class implements the `createAnimal` method to create `Cat` objects.
+ */
+class CatFactory : public AnimalFactory
+{
+public:
+    /**
+     * @brief Create a Cat object.
+     *
+     * This method overrides the `createAnimal` method to create and return a new `Cat` object.
+     *
+     * @return A unique pointer to a new `Cat` object.
+     */
+    std::unique_ptr<Animal> createAnimal() const override
+    {
+        return std::make_unique<Cat>();
+    }
+};
+
+/**
+ * @brief Type-erased deleter returning a pooled product to its pool.
+ */
+struct PoolReleaser
+{
+    void (*release)(void* pool, Animal* animal){nullptr};
+    void* pool{nullptr};
+
+    void operator()(Animal* animal) const
+    {
+        if (animal)
+        {
+            release(pool, animal);
+        }
+    }
+};
+
+/// @brief A pooled product: destroys back into its slab slot, never to the heap.
+using PooledAnimal = std::unique_ptr<Animal, PoolReleaser>;
+
+/**
+ * @brief Typed object pool built from preallocated slabs.
+ *
+ * Slots live in fixed-size slabs whose addresses never move; released
+ * instances are destroyed in place and chained onto a free list for
+ * recycling. Steady state — acquire/release at matched rates — touches the
+ * heap zero times; a new slab is allocated only when the pool genuinely
+ * grows.
+ */
+template <typename T>
+class TypedAnimalPool
+{
+public:
+    static constexpr std::size_t SLAB_SLOTS = 1024; ///< Instances per slab.
+
+    /**
+     * @brief Creates one pooled instance; recycles a free slot when possible.
+     */
+    PooledAnimal acquire()
+    {
+        std::lock_guard lock(m_mutex);
+        return makeFromSlot(popSlot());
+    }
+
+    /**
+     * @brief Creates count instances under a single lock acquisition.
+     */
+    std::vector<PooledAnimal> acquireBatch(std::size_t count)
+    {
+        std::vector<PooledAnimal> batch;
+        batch.reserve(count);
+        std::lock_guard lock(m_mutex);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            batch.push_back(makeFromSlot(popSlot()));
+        }
+        return batch;
+    }
+
+    std::size_t slabCount() const { return m_slabs.size(); }
+    std::size_t recycled() const { return m_recycled; }
+
+private:
+    /**
+     * @brief One slab slot: raw storage doubling as a free-list link.
+     */
+    union Slot
+    {
+        alignas(T) std::byte storage[sizeof(T)];
+        Slot* nextFree;
+    };
+
+    /// @brief Pops a free slot, growing by one slab when the list is empty.
+    Slot* popSlot()
+    {
+        if (!m_freeList)
+        {
+            m_slabs.push_back(std::make_unique<Slot[]>(SLAB_SLOTS)); // Only growth allocates.
+            Slot* slab = m_slabs.back().get();
+            for (std::size_t i = 0; i < SLAB_SLOTS; ++i)
+            {
+                slab[i].nextFree = m_freeList;
+                m_freeList = &slab[i];
+            }
+        }
+        Slot* slot = m_freeList;
+        m_freeList = slot->nextFree;
+        return slot;
+    }
+
+    /// @brief Constructs the product in the slot and wires up its releaser.
+    PooledAnimal makeFromSlot(Slot* slot)
+    {
+        T* instance = new (slot->storage) T();
+        return PooledAnimal(instance, PoolReleaser{&TypedAnimalPool::releaseInto, this});
+    }
+
+    /// @brief Destroys the instance in place and recycles its slot.
+    static void releaseInto(void* pool, Animal* animal)
+    {
+        auto* self = static_cast<TypedAnimalPool*>(pool);
+        static_cast<T*>(animal)->~T();
+        Slot* slot = reinterpret_cast<Slot*>(animal);
+        std::lock_guard lock(self->m_mutex);
+        slot->nextFree = self->m_freeList;
+        self->m_freeList = slot;
+        ++self->m_recycled;
+    }
+
+    std::mutex m_mutex;
+    Slot* m_freeList{nullptr};                      ///< Recycled slots, LIFO.
+    std::vector<std::unique_ptr<Slot[]>> m_slabs;   ///< Stable slot storage.
+    std::size_t m_recycled{0};                      ///< Instances returned to the pool.
+};
+
+/**
+ * @brief Factory interface whose products come from pools, not the heap.
+ */
+class PooledAnimalFactory
+{
+public:
+    virtual ~PooledAnimalFactory() = default;
+
+    /// @brief Creates one pooled animal.
+    virtual PooledAnimal createAnimal() = 0;
+
+    /// @brief Creates a batch of pooled animals under one pool lock.
+    virtual std::vector<PooledAnimal> createBatch(std::size_t count) = 0;
+};
+
+/**
+ * @brief Dog factory backed by a typed slab pool.
+ */
+class PooledDogFactory : public PooledAnimalFactory
+{
+public:
+    PooledAnimal createAnimal() override { return m_pool.acquire(); }
+    std::vector<PooledAnimal> createBatch(std::size_t count) override { return m_pool.acquireBatch(count); }
+
+    const TypedAnimalPool<Dog>& pool() const { return m_pool; }
+
+private:
+    TypedAnimalPool<Dog> m_pool; ///< Slab storage shared by all Dogs.
+};
+
+/**
+ * @brief Cat factory backed by a typed slab pool.
+ */
+class PooledCatFactory : public PooledAnimalFactory
+{
+public:
+    PooledAnimal createAnimal() override { return m_pool.acquire(); }
+    std::vector<PooledAnimal> createBatch(std::size_t count) override { return m_pool.acquireBatch(count); }
+
+private:
+    TypedAnimalPool<Cat> m_pool;
+};
+
+/**
+ * @brief Client code to demonstrate the Factory Method pattern.
+ *
+ * The `main` function demonstrates how to use different concrete factories to create
+ * specific animal objects (e.g., `Dog` and `Cat`) without directly instantiating them.
+ */
+int main()
+{
+    std::unique_ptr<AnimalFactory> factory;
+
+    // Creating a Dog
+    factory = std::make_unique<DogFactory>();
+    auto dog = factory->createAnimal();
+    dog->speak();  ///< Dog speaks
+
+    // Creating a Cat
+    factory = std::make_unique<CatFactory>();
+    auto cat = factory->createAnimal();
+    cat->speak();  ///< Cat speaks
+
+    // Pooled creation: steady-state batches never touch the heap.
+    constexpr std::size_t messages = 500000;
+    constexpr std::size_t batchSize = 64;
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        DogFactory heapFactory;
+        for (std::size_t i = 0; i < messages; i += batchSize)
+        {
+            std::vector<std::unique_ptr<Animal>> batch;
+            batch.reserve(batchSize);
+            for (std::size_t j = 0; j < batchSize; ++j)
+            {
+                batch.push_back(heapFactory.createAnimal()); // One malloc each.
+            }
+        }
+    }
+    double heapTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    PooledDogFactory pooledFactory;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < messages; i += batchSize)
+    {
+        auto batch = pooledFactory.createBatch(batchSize); // Recycled slots, one lock.
+    }
+    double pooledTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << messages << " creation(s): heap factory " << heapTime
+              << " ms, pooled batches " << pooledTime << " ms ("
+              << pooledFactory.pool().slabCount() << " slab(s) ever allocated, "
+              << pooledFactory.pool().recycled() << " recycle(s))" << std::endl;
 
- #include <iostream>
- #include <memory>
- #include <string>
- 
- /**
-  * @brief Abstract base class representing an animal.
-  * 
-  * The `Animal` class defines the interface that all concrete animal classes must implement.
-  * Each animal class will have a `speak` method that defines the sound the animal makes.
-  */
- class Animal
- {
- public:
-     /**
-      * @brief Speak the sound of the animal.
-      * 
-      * This method will be overridden by each concrete animal class to simulate the sound the animal makes.
-      */
-     virtual void speak() const = 0;
- 
-     virtual ~Animal() = default; ///< Virtual destructor for proper cleanup of derived objects
- };
- 
- /**
-  * @brief Concrete class representing a Dog.
-  * 
-  * The `Dog` class implements the `speak` method to simulate the sound of a dog barking.
-  */
- class Dog : public Animal
- {
- public:
-     /**
-      * @brief Simulate the sound of a dog barking.
-      * 
-      * This method overrides the `speak` method to simulate the barking of a dog.
-      */
-     void speak() const override
-     {
-         std::cout << "Woof! Woof!\n";
-     }
- };
- 
- /**
-  * @brief Concrete class representing a Cat.
-  * 
-  * The `Cat` class implements the `speak` method to simulate the sound of a cat meowing.
-  */
- class Cat : public Animal
- {
- public:
-     /**
-      * @brief Simulate the sound of a cat meowing.
-      * 
-      * This method overrides the `speak` method to simulate the meowing of a cat.
-      */
-     void speak() const override
-     {
-         std::cout << "Meow! Meow!\n";
-     }
- };
- 
- /**
-  * @brief Abstract base class for animal factories.
-  * 
-  * The `AnimalFactory` class declares the `createAnimal` method, which must be implemented
-  * by all concrete factories to create specific types of animals.
-  */
- class AnimalFactory
- {
- public:
-     /**
-      * @brief Create an animal.
-      * 
-      * This method must be overridden by concrete factories to create a specific type of animal.
-      * 
-      * @return A unique pointer to a new `Animal` object.
-      */
-     virtual std::unique_ptr<Animal> createAnimal() const = 0;
- 
-     virtual ~AnimalFactory() = default; ///< Virtual destructor for proper cleanup of derived factories
- };
- 
- /**
-  * @brief Concrete factory for creating Dog objects.
-  * 
-  * The `DogFactory` class implements the `createAnimal` method to create `Dog` objects.
-  */
- class DogFactory : public AnimalFactory
- {
- public:
-     /**
-      * @brief Create a Dog object.
-      * 
-      * This method overrides the `createAnimal` method to create and return a new `Dog` object.
-      * 
-      * @return A unique pointer to a new `Dog` object.
-      */
-     std::unique_ptr<Animal> createAnimal() const override
-     {
-         return std::make_unique<Dog>();
-     }
- };
- 
- /**
-  * @brief Concrete factory for creating Cat objects.
-  * 
-  * The `CatFactory` class implements the `createAnimal` method to create `Cat` objects.
-  */
- class CatFactory : public AnimalFactory
- {
- public:
-     /**
-      * @brief Create a Cat object.
-      * 
-      * This method overrides the `createAnimal` method to create and return a new `Cat` object.
-      * 
-      * @return A unique pointer to a new `Cat` object.
-      */
-     std::unique_ptr<Animal> createAnimal() const override
-     {
-         return std::make_unique<Cat>();
-     }
- };
- 
- /**
-  * @brief Client code to demonstrate the Factory Method pattern.
-  * 
-  * The `main` function demonstrates how to use different concrete factories to create
-  * specific animal objects (e.g., `Dog` and `Cat`) without directly instantiating them.
-  */
- int main()
- {
-     std::unique_ptr<AnimalFactory> factory;
- 
-     // Creating a Dog
-     factory = std::make_unique<DogFactory>();
-     auto dog = factory->createAnimal();
-     dog->speak();  ///< Dog speaks
- 
-     // Creating a Cat
-     factory = std::make_unique<CatFactory>();
-     auto cat = factory->createAnimal();
-     cat->speak();  ///< Cat speaks
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
@@ -10,11 +10,25 @@
  * 1. **Lazy Initialization**: The object `ExpensiveResource` is created only when it is first accessed.
  * 2. **Delayed Creation**: The first access to the `ExpensiveResource` introduces a simulated delay (e.g., file loading or network call).
  * 3. **Efficient Resource Usage**: The object is not created at program startup, thus saving resources if not used.
+ *
+ * Plain lazy initialization is neither thread-safe nor able to hide the construction
+ * cost: after a deploy, the first request eats the whole initialization latency.
+ * WarmResourcePool below publishes each resource with atomic double-checked
+ * initialization (no lock on the hot path once initialized), and warmup() constructs
+ * declared resources on a background thread in priority order so the critical path
+ * is already hot when traffic arrives.
  */
 #include <iostream>
 #include <memory>
 #include <thread>
 #include <chrono>
+#include <string>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <cstddef>
 
 /**
  * @brief A class that simulates an expensive resource.
@@ -78,6 +92,142 @@ private:
     std::unique_ptr<ExpensiveResource> resource_;  ///< Holds the lazy-initialized resource
 };
 
+/**
+ * @brief A named resource with a configurable simulated construction cost.
+ */
+class SimulatedResource
+{
+public:
+    SimulatedResource(std::string name, std::chrono::milliseconds constructionCost)
+        : m_name(std::move(name))
+    {
+        std::this_thread::sleep_for(constructionCost); // Simulated load/connect cost.
+    }
+
+    const std::string& name() const { return m_name; }
+
+private:
+    std::string m_name;
+};
+
+/**
+ * @brief Lazily initialized resource pool with background warmup.
+ *
+ * Resources are declared up front with a factory and a warmup priority.
+ * get() uses double-checked publication: one atomic acquire-load on the hot
+ * path once the resource exists, with the slot mutex taken only during the
+ * single construction. warmup() runs the declared factories on a background
+ * thread, highest priority first, so by the time real traffic calls get()
+ * the critical resources are already built.
+ */
+class WarmResourcePool
+{
+public:
+    /// @brief Handle returned by declare(); index into the slot array.
+    using Handle = std::size_t;
+
+    /**
+     * @brief Declares a resource; nothing is constructed yet.
+     * @param priority Higher values warm up first.
+     */
+    Handle declare(std::string name, int priority,
+                   std::function<std::unique_ptr<SimulatedResource>()> factory)
+    {
+        m_slots.push_back(std::make_unique<Slot>());
+        Slot& slot = *m_slots.back();
+        slot.name = std::move(name);
+        slot.priority = priority;
+        slot.factory = std::move(factory);
+        return m_slots.size() - 1;
+    }
+
+    /**
+     * @brief The resource, constructed on first use.
+     *
+     * Fast path is a single atomic load; the mutex is touched only by
+     * threads that race on the very first access.
+     */
+    SimulatedResource& get(Handle handle)
+    {
+        Slot& slot = *m_slots[handle];
+        SimulatedResource* resource = slot.published.load(std::memory_order_acquire);
+        if (!resource)
+        {
+            std::lock_guard lock(slot.initMutex);
+            resource = slot.published.load(std::memory_order_relaxed);
+            if (!resource)
+            {
+                slot.storage = slot.factory();
+                resource = slot.storage.get();
+                slot.published.store(resource, std::memory_order_release);
+            }
+        }
+        return *resource;
+    }
+
+    /**
+     * @brief Starts background construction of all declared resources,
+     *        highest priority first. Call during startup; traffic that
+     *        arrives early still initializes safely via get().
+     */
+    void warmup()
+    {
+        m_warmupThread = std::thread([this]
+        {
+            std::vector<Handle> order(m_slots.size());
+            for (Handle h = 0; h < order.size(); ++h)
+            {
+                order[h] = h;
+            }
+            std::sort(order.begin(), order.end(), [this](Handle a, Handle b)
+            {
+                return m_slots[a]->priority > m_slots[b]->priority;
+            });
+            for (Handle handle : order)
+            {
+                get(handle); // Same double-checked path as real traffic.
+            }
+        });
+    }
+
+    /// @brief Blocks until background warmup has finished.
+    void waitForWarmup()
+    {
+        if (m_warmupThread.joinable())
+        {
+            m_warmupThread.join();
+        }
+    }
+
+    /// @brief True once the resource has been constructed, without constructing it.
+    bool isWarm(Handle handle) const
+    {
+        return m_slots[handle]->published.load(std::memory_order_acquire) != nullptr;
+    }
+
+    ~WarmResourcePool()
+    {
+        waitForWarmup();
+    }
+
+private:
+    /**
+     * @brief One declared resource: factory, priority and published pointer.
+     */
+    struct Slot
+    {
+        std::string name;
+        int priority{0};
+        std::function<std::unique_ptr<SimulatedResource>()> factory;
+        std::unique_ptr<SimulatedResource> storage;          ///< Owns the instance.
+        std::atomic<SimulatedResource*> published{nullptr};  ///< Set once, read lock-free.
+        std::mutex initMutex;                                ///< First construction only.
+    };
+
+    std::vector<std::unique_ptr<Slot>> m_slots; ///< Stable slot addresses.
+    std::thread m_warmupThread;
+};
+
 /**
  * @brief Main function demonstrating lazy initialization.
  *
@@ -100,5 +250,54 @@ int main()
     std::cout << "Accessing resource again..." << std::endl;
     manager.getResource().doSomething();  // No delay now
 
+    // Warm pool: declared resources, priority-ordered background warmup.
+    WarmResourcePool pool;
+    auto critical = pool.declare("search-index", 10, []
+    {
+        return std::make_unique<SimulatedResource>("search-index", std::chrono::milliseconds(80));
+    });
+    auto secondary = pool.declare("session-store", 5, []
+    {
+        return std::make_unique<SimulatedResource>("session-store", std::chrono::milliseconds(40));
+    });
+    auto rarelyUsed = pool.declare("report-exporter", 1, []
+    {
+        return std::make_unique<SimulatedResource>("report-exporter", std::chrono::milliseconds(40));
+    });
+
+    pool.warmup(); // Startup: construction proceeds in the background.
+    std::this_thread::sleep_for(std::chrono::milliseconds(140)); // Deploy window before traffic.
+
+    // First request after deploy: the critical resource is already hot.
+    auto start = std::chrono::steady_clock::now();
+    SimulatedResource& hot = pool.get(critical);
+    double firstAccess = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "First request hit " << hot.name() << " in " << firstAccess
+              << " ms (warm: " << std::boolalpha << pool.isWarm(critical) << ")" << std::endl;
+
+    pool.waitForWarmup();
+    std::cout << "After warmup - session-store warm: " << pool.isWarm(secondary)
+              << ", report-exporter warm: " << pool.isWarm(rarelyUsed) << std::endl;
+
+    // Double-checked publication: concurrent first accesses construct once.
+    WarmResourcePool racePool;
+    std::atomic<int> constructions{0};
+    auto contested = racePool.declare("contested", 0, [&constructions]
+    {
+        constructions.fetch_add(1);
+        return std::make_unique<SimulatedResource>("contested", std::chrono::milliseconds(20));
+    });
+    std::vector<std::thread> racers;
+    for (int t = 0; t < 4; ++t)
+    {
+        racers.emplace_back([&racePool, contested] { racePool.get(contested); });
+    }
+    for (auto& racer : racers)
+    {
+        racer.join();
+    }
+    std::cout << "4 concurrent first accesses -> " << constructions.load()
+              << " construction(s)" << std::endl;
+
     return 0;
 }
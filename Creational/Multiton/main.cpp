@@ -10,88 +10,381 @@
  * 2. **Private Constructor**: The constructor of `Multiton` is private to prevent direct instantiation.
  * 3. **Factory Method (`getInstance`)**: A static method that provides access to a shared instance based on a given key.
  * 4. **Storage (`instances_`)**: A static map to hold the shared instances of `Multiton`, indexed by the unique keys.
+ *
+ * Guarding the key->instance map with a mutex taxes every resolution with a lock
+ * plus string hashing — pure overhead when instances are resolved per request.
+ * TenantConfigRegistry below keeps resolution lock-free: lookups probe an immutable
+ * open-addressed table published by atomic pointer swap (insertions build a new
+ * table off to the side), and a small thread-local cache turns repeated
+ * resolutions of the same tenant into a single compare.
  */
 
- #include <iostream>
- #include <memory>
- #include <unordered_map>
- #include <string>
- 
- /**
-  * @brief Multiton class that manages instances identified by unique keys.
-  * 
-  * The `Multiton` class ensures that only one instance is created for each unique key.
-  * It manages instances via a static `std::unordered_map` and provides access
-  * to these instances using a static `getInstance` method.
-  */
- class Multiton
- {
- public:
-     /**
-      * @brief Get the instance of Multiton identified by the given key.
-      * 
-      * If the instance with the given key doesn't exist, it will be created.
-      * 
-      * @param key The unique key used to identify the instance.
-      * @return A shared pointer to the `Multiton` instance associated with the key.
-      */
-     static std::shared_ptr<Multiton> getInstance(const std::string& key)
-     {
-         // If no instance exists for the given key, create one
-         if (instances_.find(key) == instances_.end())
-         {
-             instances_[key] = std::shared_ptr<Multiton>(new Multiton(key)); // Pass key to constructor
-         }
- 
-         return instances_[key];
-     }
- 
-     /**
-      * @brief Example method to demonstrate functionality.
-      * 
-      * Prints out the key that identifies this specific instance.
-      */
-     void printKey() const
-     {
-         std::cout << "Instance with key: " << key_ << std::endl;
-     }
- 
- private:
-     /**
-      * @brief Private constructor to prevent direct instantiation.
-      * 
-      * The constructor is private to ensure that instances can only be created via the `getInstance` method.
-      * 
-      * @param key The unique key used to identify this instance.
-      */
-     Multiton(const std::string& key) : key_(key) {}
- 
-     std::string key_; ///< Key that identifies this particular instance
- 
-     /**
-      * @brief Static map to hold the instances of Multiton, indexed by unique keys.
-      */
-     static std::unordered_map<std::string, std::shared_ptr<Multiton>> instances_;
- };
- 
- // Initialize the static member
- std::unordered_map<std::string, std::shared_ptr<Multiton>> Multiton::instances_;
- 
- int main()
- {
-     // Get instances of Multiton with different keys
-     auto instanceA = Multiton::getInstance("A");
-     instanceA->printKey();
- 
-     auto instanceB = Multiton::getInstance("B");
-     instanceB->printKey();
- 
-     auto instanceC = Multiton::getInstance("A");
-     instanceC->printKey(); // Should print the same key "A" as instanceA
- 
-     // Demonstrating that instances "A" and "B" are different
-     std::cout << (instanceA == instanceC ? "Same instance" : "Different instance") << std::endl;
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Multiton class that manages instances identified by unique keys.
+ *
+ * The `Multiton` class ensures that only one instance is created for each unique key.
+ * It manages instances via a static `std::unordered_map` and provides access
+ * to these instances using a static `getInstance` method.
+ */
+class Multiton
+{
+public:
+    /**
+     * @brief Get the instance of Multiton identified by the given key.
+     *
+     * If the instance with the given key doesn't exist, it will be created.
+     *
+     * @param key The unique key used to identify the instance.
+     * @return A shared pointer to the `Multiton` instance associated with the key.
+     */
+    static std::shared_ptr<Multiton> getInstance(const std::string& key)
+    {
+        // If no instance exists for the given key, create one
+        if (instances_.find(key) == instances_.end())
+        {
+            instances_[key] = std::shared_ptr<Multiton>(new Multiton(key)); // Pass key to constructor
+        }
+
+        return instances_[key];
+    }
+
+    /**
+     * @brief Example method to demonstrate functionality.
+     *
+     * Prints out the key that identifies this specific instance.
+     */
+    void printKey() const
+    {
+        std::cout << "Instance with key: " << key_ << std::endl;
+    }
+
+private:
+    /**
+     * @brief Private constructor to prevent direct instantiation.
+     *
+     * The constructor is private to ensure that instances can only be created via the `getInstance` method.
+     *
+     * @param key The unique key used to identify this instance.
+     */
+    Multiton(const std::string& key) : key_(key) {}
+
+    std::string key_; ///< Key that identifies this particular instance
+
+    /**
+     * @brief Static map to hold the instances of Multiton, indexed by unique keys.
+     */
+    static std::unordered_map<std::string, std::shared_ptr<Multiton>> instances_;
+};
+
+// Initialize the static member
+std::unordered_map<std::string, std::shared_ptr<Multiton>> Multiton::instances_;
+
+/**
+ * @brief Per-tenant configuration: the payload the registry multitons.
+ */
+struct TenantConfig
+{
+    std::string tenant;
+    int rateLimit;
+};
+
+/**
+ * @brief Mutex-guarded multiton registry; the baseline every request pays for.
+ */
+class LockedRegistry
+{
+public:
+    std::shared_ptr<const TenantConfig> getInstance(const std::string& key)
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_instances.find(key);
+        if (it == m_instances.end())
+        {
+            it = m_instances.emplace(key, std::make_shared<const TenantConfig>(TenantConfig{key, 100})).first;
+        }
+        return it->second;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::unordered_map<std::string, std::shared_ptr<const TenantConfig>> m_instances;
+};
+
+/**
+ * @brief Multiton registry with a lock-free resolution fast path.
+ *
+ * The key->instance table is an immutable open-addressed array. Readers load
+ * it through one atomic pointer and probe with a precomputed hash — no lock,
+ * no allocation. Insertion (rare: first resolution of a new tenant) builds a
+ * grown copy under a writer mutex and publishes it with an atomic pointer
+ * swap; retired tables are kept alive so in-flight readers and thread-local
+ * cache entries never dangle. A per-thread cache of recent (key, instance)
+ * pairs short-circuits repeated resolutions of the same tenant.
+ */
+class TenantConfigRegistry
+{
+public:
+    static constexpr std::size_t CACHE_SIZE = 4; ///< Recent pairs cached per thread.
+
+    TenantConfigRegistry()
+    {
+        auto initial = std::make_unique<Table>();
+        initial->slots.resize(INITIAL_CAPACITY);
+        m_current.store(initial.get(), std::memory_order_release);
+        m_retired.push_back(std::move(initial));
+    }
+
+    /**
+     * @brief Resolves the tenant's instance, creating it on first use.
+     */
+    std::shared_ptr<const TenantConfig> getInstance(std::string_view key)
+    {
+        std::uint64_t hash = hashKey(key);
+
+        // Fast path 0: this thread resolved the tenant moments ago.
+        for (const CachedPair& cached : t_cache)
+        {
+            if (cached.registry == this && cached.hash == hash && cached.entry->key == key)
+            {
+                return cached.entry->config;
+            }
+        }
+
+        // Fast path 1: lock-free probe of the published table.
+        const Table* table = m_current.load(std::memory_order_acquire);
+        if (const Entry* entry = probe(*table, hash, key))
+        {
+            remember(hash, entry);
+            return entry->config;
+        }
+
+        // Slow path: first resolution of this tenant — build and publish.
+        return insert(hash, key);
+    }
+
+    /**
+     * @brief Borrowing fast-path resolution for per-request hot paths.
+     *
+     * Returns a plain reference instead of bumping the shared_ptr refcount;
+     * safe because the registry never destroys a published instance.
+     */
+    const TenantConfig& resolve(std::string_view key)
+    {
+        std::uint64_t hash = hashKey(key);
+        for (const CachedPair& cached : t_cache)
+        {
+            if (cached.registry == this && cached.hash == hash && cached.entry->key == key)
+            {
+                return *cached.entry->config;
+            }
+        }
+        const Table* table = m_current.load(std::memory_order_acquire);
+        if (const Entry* entry = probe(*table, hash, key))
+        {
+            remember(hash, entry);
+            return *entry->config;
+        }
+        return *insert(hash, key);
+    }
+
+private:
+    static constexpr std::size_t INITIAL_CAPACITY = 16; ///< Power of two.
+
+    /**
+     * @brief One occupied table slot; empty slots have a null config.
+     */
+    struct Entry
+    {
+        std::uint64_t hash{0};
+        std::string key;
+        std::shared_ptr<const TenantConfig> config;
+    };
+
+    /**
+     * @brief Immutable once published; readers probe without synchronization.
+     */
+    struct Table
+    {
+        std::vector<Entry> slots;
+        std::size_t occupied{0};
+    };
+
+    /**
+     * @brief One thread-local cache slot; entry points into a live table.
+     */
+    struct CachedPair
+    {
+        const TenantConfigRegistry* registry{nullptr};
+        std::uint64_t hash{0};
+        const Entry* entry{nullptr};
+    };
+
+    static std::uint64_t hashKey(std::string_view key)
+    {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        for (char c : key)
+        {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+        }
+        return hash | 1; // Never zero: zero marks empty slots.
+    }
+
+    static const Entry* probe(const Table& table, std::uint64_t hash, std::string_view key)
+    {
+        std::size_t mask = table.slots.size() - 1;
+        for (std::size_t i = hash & mask; table.slots[i].config; i = (i + 1) & mask)
+        {
+            if (table.slots[i].hash == hash && table.slots[i].key == key)
+            {
+                return &table.slots[i];
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief Records a resolution in the thread-local cache, round-robin.
+    void remember(std::uint64_t hash, const Entry* entry)
+    {
+        t_cache[t_cacheNext % CACHE_SIZE] = CachedPair{this, hash, entry};
+        ++t_cacheNext;
+    }
+
+    /**
+     * @brief Builds a new table containing the key and publishes it.
+     */
+    std::shared_ptr<const TenantConfig> insert(std::uint64_t hash, std::string_view key)
+    {
+        std::lock_guard lock(m_writeMutex);
+        const Table* current = m_current.load(std::memory_order_acquire);
+        if (const Entry* entry = probe(*current, hash, key))
+        {
+            return entry->config; // Another thread inserted while we waited.
+        }
+        auto next = std::make_unique<Table>();
+        std::size_t capacity = current->slots.size();
+        if ((current->occupied + 1) * 2 >= capacity)
+        {
+            capacity *= 2; // Stay under 50% load for short probe chains.
+        }
+        next->slots.resize(capacity);
+        next->occupied = current->occupied + 1;
+        for (const Entry& entry : current->slots)
+        {
+            if (entry.config)
+            {
+                place(*next, entry);
+            }
+        }
+        Entry fresh{hash, std::string(key),
+                    std::make_shared<const TenantConfig>(TenantConfig{std::string(key), 100})};
+        std::shared_ptr<const TenantConfig> config = fresh.config;
+        place(*next, std::move(fresh));
+        m_current.store(next.get(), std::memory_order_release);
+        m_retired.push_back(std::move(next)); // Keeps old tables' entries alive.
+        return config;
+    }
+
+    static void place(Table& table, Entry entry)
+    {
+        std::size_t mask = table.slots.size() - 1;
+        std::size_t i = entry.hash & mask;
+        while (table.slots[i].config)
+        {
+            i = (i + 1) & mask;
+        }
+        table.slots[i] = std::move(entry);
+    }
+
+    std::atomic<const Table*> m_current;               ///< The published table.
+    std::mutex m_writeMutex;                           ///< Serializes insertions only.
+    std::vector<std::unique_ptr<Table>> m_retired;     ///< All tables ever published.
+    static thread_local std::array<CachedPair, CACHE_SIZE> t_cache;
+    static thread_local std::size_t t_cacheNext;
+};
+
+thread_local std::array<TenantConfigRegistry::CachedPair, TenantConfigRegistry::CACHE_SIZE>
+    TenantConfigRegistry::t_cache{};
+thread_local std::size_t TenantConfigRegistry::t_cacheNext = 0;
+
+int main()
+{
+    // Get instances of Multiton with different keys
+    auto instanceA = Multiton::getInstance("A");
+    instanceA->printKey();
+
+    auto instanceB = Multiton::getInstance("B");
+    instanceB->printKey();
+
+    auto instanceC = Multiton::getInstance("A");
+    instanceC->printKey(); // Should print the same key "A" as instanceA
+
+    // Demonstrating that instances "A" and "B" are different
+    std::cout << (instanceA == instanceC ? "Same instance" : "Different instance") << std::endl;
+
+    // Lock-free resolution: per-tenant configs resolved on every request.
+    constexpr int tenantCount = 16;
+    constexpr int lookups = 1000000;
+    constexpr int threadCount = 4;
+
+    std::vector<std::string> tenants;
+    for (int i = 0; i < tenantCount; ++i)
+    {
+        tenants.push_back("tenant-" + std::to_string(i));
+    }
+
+    auto runResolutions = [&tenants](auto& registry)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threadCount; ++t)
+        {
+            workers.emplace_back([&tenants, &registry, t]
+            {
+                // Each thread mostly re-resolves its own tenant, as requests do.
+                const std::string& own = tenants[t % tenants.size()];
+                int sink = 0;
+                for (int i = 0; i < lookups; ++i)
+                {
+                    const std::string& key = i % 8 == 0 ? tenants[i % tenants.size()] : own;
+                    if constexpr (requires { registry.resolve(key); })
+                    {
+                        sink += registry.resolve(key).rateLimit;
+                    }
+                    else
+                    {
+                        sink += registry.getInstance(key)->rateLimit;
+                    }
+                }
+                std::atomic_ref<int>(sink).load(std::memory_order_relaxed); // Keep lookups observable.
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    LockedRegistry locked;
+    double lockedTime = runResolutions(locked);
+    TenantConfigRegistry lockFree;
+    double lockFreeTime = runResolutions(lockFree);
+
+    std::cout << threadCount << " thread(s) x " << lookups << " resolution(s): mutex map "
+              << lockedTime << " ms, lock-free table + thread cache " << lockFreeTime << " ms" << std::endl;
+
+    return 0;
+}
@@ -7,155 +7,392 @@
  * 
  * In this example, the pool manages reusable `Connection` objects using `std::shared_ptr`. 
  * The pool creates and manages a set number of connections, and clients can acquire and release them.
+ *
+ * A slab-backed variant (`SlabPool`) is included for high-churn workloads: objects are
+ * placement-constructed into contiguous slabs, a free list threaded through the unused slots
+ * gives O(1) acquire/release, RAII leases replace shared_ptr control blocks, and an optional
+ * per-thread cache refills in batches so the common path never touches the global lock.
+ */
+
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+#include <mutex>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+/**
+ * @brief Connection class representing a resource.
+ * 
+ * The `Connection` class simulates a resource that can be acquired and used.
+ */
+class Connection
+{
+public:
+    /**
+     * @brief Construct a new Connection object.
+     * 
+     * Initializes the connection and marks it as available.
+     */
+    Connection()
+    {
+        std::cout << "Connection created.\n";
+    }
+
+    /**
+     * @brief Simulate a connection usage.
+     * 
+     * This method simulates the work done while a connection is in use.
+     */
+    void use()
+    {
+        std::cout << "Connection is being used.\n";
+    }
+
+    /**
+     * @brief Destruct the Connection object.
+     * 
+     * Cleans up when the connection is destroyed.
+     */
+    ~Connection()
+    {
+        std::cout << "Connection destroyed.\n";
+    }
+};
+
+/**
+ * @brief ObjectPool class that manages a pool of connections.
+ * 
+ * The `ObjectPool` class manages a collection of reusable `Connection` objects. Clients can acquire and release
+ * connections, and the pool ensures efficient management of resources.
+ */
+class ObjectPool
+{
+public:
+    /**
+     * @brief Construct a new ObjectPool object.
+     * 
+     * Initializes the pool with a fixed number of connections.
+     * 
+     * @param size The number of connections to pre-allocate in the pool.
+     */
+    explicit ObjectPool(size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            pool_.push(std::make_shared<Connection>());
+        }
+    }
+
+    /**
+     * @brief Acquire a connection from the pool.
+     * 
+     * This method returns a `Connection` object if available.
+     * If no connections are available, it throws an exception.
+     * 
+     * @return A shared pointer to a `Connection` object.
+     * 
+     * @throws std::runtime_error If no connections are available in the pool.
+     */
+    std::shared_ptr<Connection> acquire()
+    {
+        if (pool_.empty())
+        {
+            throw std::runtime_error("No available connections in the pool.");
+        }
+        auto connection = pool_.front();
+        pool_.pop();
+        return connection;
+    }
+
+    /**
+     * @brief Release a connection back to the pool.
+     * 
+     * This method returns a connection object to the pool to be reused.
+     * 
+     * @param connection A `Connection` object to be returned to the pool.
+     */
+    void release(std::shared_ptr<Connection> connection)
+    {
+        pool_.push(connection);
+    }
+
+    /**
+     * @brief Destructor to clean up the pool.
+     * 
+     * This destructor ensures that any remaining resources are cleaned up when the pool is destroyed.
+     */
+    ~ObjectPool() = default;
+
+private:
+    std::queue<std::shared_ptr<Connection>> pool_; ///< The pool of available connections.
+};
+
+
+/**
+ * @brief Slab-backed object pool with an intrusive free list and RAII leases.
+ *
+ * Storage is carved out of contiguous slabs of SlabSize slots; free slots are
+ * threaded into an intrusive singly linked list, so acquire and release are a
+ * pointer pop/push — O(1), no per-object heap allocation and no shared_ptr
+ * control block. Objects are placement-constructed on acquire and destroyed on
+ * release, so a pooled slot carries no stale state.
+ *
+ * @tparam T The pooled object type.
+ * @tparam SlabSize Objects per slab.
  */
+template <typename T, std::size_t SlabSize = 64>
+class SlabPool
+{
+public:
+    /**
+     * @brief A slot: either a live object or a link in the free list.
+     */
+    union Slot
+    {
+        Slot() {}
+        ~Slot() {}
+        Slot *next;                                  ///< Valid while the slot is free.
+        alignas(T) std::byte storage[sizeof(T)];     ///< Valid while the slot is leased.
+    };
+
+    /**
+     * @brief Move-only RAII lease; returns the object to its pool on destruction.
+     */
+    class Lease
+    {
+    public:
+        Lease() = default;
+        Lease(SlabPool *pool, T *object) : m_pool(pool), m_object(object) {}
+
+        Lease(Lease &&other) noexcept : m_pool(other.m_pool), m_object(other.m_object)
+        {
+            other.m_pool = nullptr;
+            other.m_object = nullptr;
+        }
+
+        Lease &operator=(Lease &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                m_pool = other.m_pool;
+                m_object = other.m_object;
+                other.m_pool = nullptr;
+                other.m_object = nullptr;
+            }
+            return *this;
+        }
+
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+
+        ~Lease() { reset(); }
+
+        T *operator->() const { return m_object; }
+        T &operator*() const { return *m_object; }
+        explicit operator bool() const { return m_object != nullptr; }
+
+    private:
+        void reset()
+        {
+            if (m_pool && m_object)
+            {
+                m_pool->release(m_object);
+            }
+            m_pool = nullptr;
+            m_object = nullptr;
+        }
+
+        SlabPool *m_pool{nullptr};
+        T *m_object{nullptr};
+    };
+
+    /**
+     * @brief Per-thread sub-pool: refills from (and drains to) the shared pool in batches.
+     *
+     * A thread that owns a ThreadCache acquires and releases through it without
+     * touching the global lock except once per RefillBatch slots.
+     */
+    class ThreadCache
+    {
+    public:
+        static constexpr std::size_t RefillBatch = 16; ///< Slots moved per lock acquisition.
+
+        explicit ThreadCache(SlabPool &pool) : m_pool(pool) {}
+
+        ~ThreadCache()
+        {
+            m_pool.returnSlots(m_free); // Give cached slots back on thread exit.
+        }
+
+        /**
+         * @brief Acquires a lease, refilling the local cache when it runs dry.
+         */
+        template <typename... Args>
+        Lease acquire(Args &&...args)
+        {
+            if (m_free.empty())
+            {
+                m_pool.refill(m_free, RefillBatch); // One lock for a whole batch.
+            }
+            Slot *slot = m_free.back();
+            m_free.pop_back();
+            return Lease(&m_pool, std::construct_at(reinterpret_cast<T *>(slot->storage),
+                                                    std::forward<Args>(args)...));
+        }
+
+    private:
+        SlabPool &m_pool;
+        std::vector<Slot *> m_free; ///< Locally cached free slots.
+    };
+
+    SlabPool() = default;
+    SlabPool(const SlabPool &) = delete;
+    SlabPool &operator=(const SlabPool &) = delete;
+
+    /**
+     * @brief Acquires a lease on a pooled object; O(1) free-list pop.
+     */
+    template <typename... Args>
+    Lease acquire(Args &&...args)
+    {
+        Slot *slot;
+        {
+            std::lock_guard lock(m_mutex);
+            slot = popSlotLocked();
+        }
+        return Lease(this, std::construct_at(reinterpret_cast<T *>(slot->storage),
+                                             std::forward<Args>(args)...));
+    }
+
+private:
+    friend class ThreadCache;
+
+    /**
+     * @brief Destroys an object and pushes its slot back; O(1) free-list push.
+     */
+    void release(T *object)
+    {
+        object->~T();
+        auto *slot = reinterpret_cast<Slot *>(object);
+        std::lock_guard lock(m_mutex);
+        slot->next = m_freeList;
+        m_freeList = slot;
+    }
+
+    /**
+     * @brief Pops a free slot, growing a new slab when the list is empty.
+     */
+    Slot *popSlotLocked()
+    {
+        if (!m_freeList)
+        {
+            growLocked();
+        }
+        Slot *slot = m_freeList;
+        m_freeList = slot->next;
+        return slot;
+    }
+
+    /**
+     * @brief Allocates one contiguous slab and threads it into the free list.
+     */
+    void growLocked()
+    {
+        auto slab = std::make_unique<Slot[]>(SlabSize);
+        for (std::size_t i = 0; i < SlabSize; ++i)
+        {
+            slab[i].next = m_freeList;
+            m_freeList = &slab[i];
+        }
+        m_slabs.push_back(std::move(slab));
+    }
+
+    /**
+     * @brief Moves up to count free slots into a thread cache under one lock.
+     */
+    void refill(std::vector<Slot *> &into, std::size_t count)
+    {
+        std::lock_guard lock(m_mutex);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            into.push_back(popSlotLocked());
+        }
+    }
+
+    /**
+     * @brief Returns a batch of cached slots to the shared free list.
+     */
+    void returnSlots(std::vector<Slot *> &slots)
+    {
+        std::lock_guard lock(m_mutex);
+        for (Slot *slot : slots)
+        {
+            slot->next = m_freeList;
+            m_freeList = slot;
+        }
+        slots.clear();
+    }
+
+    std::mutex m_mutex;                             ///< Guards the shared free list.
+    Slot *m_freeList{nullptr};                      ///< Intrusive list of free slots.
+    std::vector<std::unique_ptr<Slot[]>> m_slabs;   ///< Contiguous slab storage.
+};
+
+/**
+ * @brief Main function to demonstrate the Object Pool pattern.
+ * 
+ * In the `main` function, an object pool is created with a fixed number of connections.
+ * Connections are acquired, used, and released back into the pool.
+ */
+int main()
+{
+    try
+    {
+        // Create an ObjectPool with 3 connections
+        ObjectPool pool(3);
+
+        // Acquire and use a connection
+        auto connection1 = pool.acquire();
+        connection1->use();
+
+        // Acquire and use another connection
+        auto connection2 = pool.acquire();
+        connection2->use();
+
+        // Release connections back to the pool
+        pool.release(connection1);
+        pool.release(connection2);
+
+        // Acquire another connection after releasing
+        auto connection3 = pool.acquire();
+        connection3->use();
+
+    }
+    catch (const std::runtime_error &e)
+    {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+
+    // Slab-backed pool: RAII leases, O(1) free-list acquire, no shared_ptr.
+    SlabPool<Connection> slabPool;
+    {
+        auto lease1 = slabPool.acquire();
+        lease1->use();
+        auto lease2 = slabPool.acquire();
+        lease2->use();
+    } // Leases return their slots automatically.
+
+    // Per-thread sub-pool: the common path never takes the global lock.
+    {
+        SlabPool<Connection>::ThreadCache cache(slabPool);
+        auto lease = cache.acquire();
+        lease->use();
+    }
 
- #include <iostream>
- #include <memory>
- #include <queue>
- #include <stdexcept>
- 
- /**
-  * @brief Connection class representing a resource.
-  * 
-  * The `Connection` class simulates a resource that can be acquired and used.
-  */
- class Connection
- {
- public:
-     /**
-      * @brief Construct a new Connection object.
-      * 
-      * Initializes the connection and marks it as available.
-      */
-     Connection()
-     {
-         std::cout << "Connection created.\n";
-     }
- 
-     /**
-      * @brief Simulate a connection usage.
-      * 
-      * This method simulates the work done while a connection is in use.
-      */
-     void use()
-     {
-         std::cout << "Connection is being used.\n";
-     }
- 
-     /**
-      * @brief Destruct the Connection object.
-      * 
-      * Cleans up when the connection is destroyed.
-      */
-     ~Connection()
-     {
-         std::cout << "Connection destroyed.\n";
-     }
- };
- 
- /**
-  * @brief ObjectPool class that manages a pool of connections.
-  * 
-  * The `ObjectPool` class manages a collection of reusable `Connection` objects. Clients can acquire and release
-  * connections, and the pool ensures efficient management of resources.
-  */
- class ObjectPool
- {
- public:
-     /**
-      * @brief Construct a new ObjectPool object.
-      * 
-      * Initializes the pool with a fixed number of connections.
-      * 
-      * @param size The number of connections to pre-allocate in the pool.
-      */
-     explicit ObjectPool(size_t size)
-     {
-         for (size_t i = 0; i < size; ++i)
-         {
-             pool_.push(std::make_shared<Connection>());
-         }
-     }
- 
-     /**
-      * @brief Acquire a connection from the pool.
-      * 
-      * This method returns a `Connection` object if available.
-      * If no connections are available, it throws an exception.
-      * 
-      * @return A shared pointer to a `Connection` object.
-      * 
-      * @throws std::runtime_error If no connections are available in the pool.
-      */
-     std::shared_ptr<Connection> acquire()
-     {
-         if (pool_.empty())
-         {
-             throw std::runtime_error("No available connections in the pool.");
-         }
-         auto connection = pool_.front();
-         pool_.pop();
-         return connection;
-     }
- 
-     /**
-      * @brief Release a connection back to the pool.
-      * 
-      * This method returns a connection object to the pool to be reused.
-      * 
-      * @param connection A `Connection` object to be returned to the pool.
-      */
-     void release(std::shared_ptr<Connection> connection)
-     {
-         pool_.push(connection);
-     }
- 
-     /**
-      * @brief Destructor to clean up the pool.
-      * 
-      * This destructor ensures that any remaining resources are cleaned up when the pool is destroyed.
-      */
-     ~ObjectPool() = default;
- 
- private:
-     std::queue<std::shared_ptr<Connection>> pool_; ///< The pool of available connections.
- };
- 
- /**
-  * @brief Main function to demonstrate the Object Pool pattern.
-  * 
-  * In the `main` function, an object pool is created with a fixed number of connections.
-  * Connections are acquired, used, and released back into the pool.
-  */
- int main()
- {
-     try
-     {
-         // Create an ObjectPool with 3 connections
-         ObjectPool pool(3);
- 
-         // Acquire and use a connection
-         auto connection1 = pool.acquire();
-         connection1->use();
- 
-         // Acquire and use another connection
-         auto connection2 = pool.acquire();
-         connection2->use();
- 
-         // Release connections back to the pool
-         pool.release(connection1);
-         pool.release(connection2);
- 
-         // Acquire another connection after releasing
-         auto connection3 = pool.acquire();
-         connection3->use();
- 
-     }
-     catch (const std::runtime_error &e)
-     {
-         std::cout << "Error: " << e.what() << std::endl;
-     }
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
@@ -12,10 +12,24 @@
  * 3. The client uses the `clone` method to create copies of objects without needing to know the details of their creation.
  *
  * This example demonstrates the Prototype pattern where we create and clone `Shape` objects.
+ *
+ * Cloning one heap allocation at a time via virtual clone() is fine for single objects
+ * but not for spawners that clone prototypes in bursts of tens of thousands. The
+ * registry below adds spawn(prototypeId, count, arena): N instances are placement-
+ * cloned into a caller-supplied arena in one pass — an exponential memcpy fill for
+ * trivially copyable prototypes — so a burst costs one arena reservation instead of
+ * N malloc calls.
  */
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
+#include <span>
+#include <chrono>
+#include <cstring>
+#include <cstddef>
+#include <type_traits>
+#include <cstdint>
 
 /**
  * @brief Abstract base class for shapes.
@@ -129,6 +143,113 @@ private:
     int height_; ///< The height of the rectangle
 };
 
+/**
+ * @brief Caller-supplied bump arena backing burst spawns.
+ *
+ * One up-front reservation; allocate() just advances an offset. reset()
+ * recycles the whole arena between frames without freeing.
+ */
+class SpawnArena
+{
+public:
+    explicit SpawnArena(std::size_t capacityBytes)
+        : m_buffer(capacityBytes)
+    {}
+
+    /**
+     * @brief Reserves count objects of type T; nullptr when the arena is full.
+     */
+    template <typename T>
+    T* allocate(std::size_t count)
+    {
+        std::size_t offset = (m_used + alignof(T) - 1) & ~(alignof(T) - 1);
+        if (offset + count * sizeof(T) > m_buffer.size())
+        {
+            return nullptr;
+        }
+        m_used = offset + count * sizeof(T);
+        return reinterpret_cast<T*>(m_buffer.data() + offset);
+    }
+
+    /// @brief Forgets all reservations; memory is reused, never freed.
+    void reset() { m_used = 0; }
+
+private:
+    std::vector<std::byte> m_buffer; ///< The single backing allocation.
+    std::size_t m_used{0};           ///< Bump offset.
+};
+
+/**
+ * @brief Registry of prototypes with bulk arena cloning.
+ *
+ * Prototypes are registered once and spawned in bursts: spawn() reserves the
+ * whole burst from the arena and clones in one pass. Trivially copyable
+ * prototypes use an exponential memcpy fill — copy one, then double the
+ * copied region until the burst is full — everything else placement-copies.
+ */
+template <typename T>
+class PrototypeRegistry
+{
+public:
+    using PrototypeId = std::size_t;
+
+    /// @brief Registers a prototype; the returned id names it in spawn calls.
+    PrototypeId registerPrototype(T prototype)
+    {
+        m_prototypes.push_back(std::move(prototype));
+        return m_prototypes.size() - 1;
+    }
+
+    /**
+     * @brief Clones count instances of a prototype into the arena.
+     * @return Span over the spawned instances; empty if the arena is full.
+     */
+    std::span<T> spawn(PrototypeId id, std::size_t count, SpawnArena& arena) const
+    {
+        T* storage = arena.allocate<T>(count);
+        if (!storage || count == 0)
+        {
+            return {};
+        }
+        const T& prototype = m_prototypes[id];
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            // Exponential fill: one seed copy, then memcpy doubles the region.
+            std::memcpy(storage, &prototype, sizeof(T));
+            std::size_t filled = 1;
+            while (filled < count)
+            {
+                std::size_t chunk = std::min(filled, count - filled);
+                std::memcpy(storage + filled, storage, chunk * sizeof(T));
+                filled += chunk;
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                new (storage + i) T(prototype); // Placement copy-clone.
+            }
+        }
+        return std::span<T>(storage, count);
+    }
+
+private:
+    std::vector<T> m_prototypes; ///< Registered prototype instances.
+};
+
+/**
+ * @brief A trivially copyable particle; the payload burst spawners clone.
+ */
+struct Particle
+{
+    float x, y;
+    float vx, vy;
+    std::uint32_t color;
+};
+
+static_assert(std::is_trivially_copyable_v<Particle>);
+
 /**
  * @brief Client code to demonstrate the Prototype pattern.
  * 
@@ -146,5 +267,30 @@ int main()
     std::unique_ptr<Shape> clonedRectangle = rectanglePrototype->clone();
     clonedRectangle->draw();  ///< Drawing the cloned rectangle
 
+    // Burst spawning: one arena reservation instead of N mallocs.
+    constexpr std::size_t burst = 100000;
+
+    PrototypeRegistry<Particle> registry;
+    auto sparkId = registry.registerPrototype(Particle{0.0f, 0.0f, 1.5f, -0.5f, 0xffaa33u});
+
+    // Baseline: per-instance heap clones, as the virtual path would do.
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::unique_ptr<Particle>> heapClones;
+    heapClones.reserve(burst);
+    for (std::size_t i = 0; i < burst; ++i)
+    {
+        heapClones.push_back(std::make_unique<Particle>(Particle{0.0f, 0.0f, 1.5f, -0.5f, 0xffaa33u}));
+    }
+    double heapTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    SpawnArena arena(burst * sizeof(Particle) + alignof(Particle));
+    start = std::chrono::steady_clock::now();
+    std::span<Particle> sparks = registry.spawn(sparkId, burst, arena);
+    double arenaTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << burst << " clone(s): per-instance heap " << heapTime
+              << " ms, arena memcpy spawn " << arenaTime << " ms (first color 0x"
+              << std::hex << sparks.front().color << std::dec << ", count " << sparks.size() << ")\n";
+
     return 0;
 }
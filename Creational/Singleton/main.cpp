@@ -3,7 +3,7 @@
  *
  * **Explanation:**
  *
- * 1. **`Dog` Class**: 
+ * 1. **`Dog` Class**:
  *    - `Dog` is a simple class with a `bark()` method and a private constructor to prevent direct instantiation.
  *    - `Dog` can be any class, and the Singleton behavior will work for it.
  *
@@ -13,16 +13,33 @@
  *
  * 3. **Template Usage**:
  *    - In the `main()` function, `SingletonCreator<Dog>::getInstance()` is used to get the singleton instance of `Dog`, and the same instance is returned each time.
- * 
+ *
  * 4. **Lazy Initialization**:
  *    - The lambda inside `getInstance()` ensures that the `Dog` instance is created only when needed and is shared across calls.
  *
  * **Key Features**:
  * - **Template Flexibility**: The manager can handle singleton creation for any class, not just `Dog`. For instance, `SingletonCreator<Cat>::getInstance()` would manage a `Cat` singleton.
  * - **Static Lambda**: The lambda inside `getInstance()` ensures that the `Dog` object is created lazily (only when first accessed) and remains unique throughout the program.
+ *
+ * Function-local statics are fine for one singleton but say nothing about
+ * startup, where dozens of singletons constructing eagerly and serially add
+ * their costs up. SingletonRegistry below declares singletons with their
+ * dependencies, initializes independent ones in parallel across a startup
+ * pool (wall time collapses to the dependency graph's critical path), leaves
+ * cold ones lazy until first use, and records per-singleton init times for
+ * instrumentation.
  */
 #include <iostream>
 #include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 
 /**
  * @brief A template class to manage the singleton instance of any type `T`.
@@ -50,12 +67,216 @@ public:
         static auto instance = []() -> std::unique_ptr<T> {
             return std::make_unique<T>();  // Lazy initialization of the instance
         }();
-        
+
         // Return the reference to the unique instance
         return *instance;
     }
 };
 
+/**
+ * @brief Startup-aware registry of singletons with dependency ordering.
+ *
+ * Singletons are declared up front with their dependencies and an init
+ * function. startup() runs every eager singleton across a worker pool in
+ * topological order — a singleton becomes runnable the moment its last
+ * dependency finishes — so independent init work overlaps and wall time is
+ * the dependency graph's critical path, not the serial sum. Lazy singletons
+ * are skipped at startup and constructed on first ensureInitialized(),
+ * which is safe to race from any thread. Every init is timed.
+ */
+class SingletonRegistry
+{
+public:
+    using SingletonId = std::size_t;
+    using InitFn = std::function<void()>;
+
+    enum class Mode { Eager, Lazy };
+
+    /**
+     * @brief Declares a singleton; dependencies must be declared first.
+     * @return The id used to reference it as a dependency or in ensureInitialized().
+     */
+    SingletonId declare(std::string name, Mode mode, std::vector<SingletonId> dependencies, InitFn init)
+    {
+        auto entry = std::make_unique<Entry>();
+        entry->name = std::move(name);
+        entry->mode = mode;
+        entry->dependencies = std::move(dependencies);
+        entry->init = std::move(init);
+        SingletonId id = m_entries.size();
+        for (SingletonId dependency : entry->dependencies)
+        {
+            m_entries[dependency]->dependents.push_back(id);
+        }
+        m_entries.push_back(std::move(entry));
+        return id;
+    }
+
+    /**
+     * @brief Initializes every eager singleton across a pool of workers.
+     *
+     * Eager singletons with no unfinished dependencies seed a ready queue;
+     * each worker pops one, runs its init, and unblocks its dependents.
+     * Returns when all eager singletons are ready.
+     */
+    void startup(unsigned threadCount)
+    {
+        std::size_t eagerRemaining = 0;
+        {
+            std::lock_guard lock(m_queueMutex);
+            for (auto& entry : m_entries)
+            {
+                if (entry->mode != Mode::Eager || entry->state.load(std::memory_order_acquire) == READY)
+                {
+                    continue;
+                }
+                ++eagerRemaining;
+                entry->pendingDeps.store(entry->dependencies.size(), std::memory_order_relaxed);
+                if (entry->dependencies.empty())
+                {
+                    m_readyQueue.push_back(entry.get());
+                }
+            }
+            m_eagerRemaining = eagerRemaining;
+        }
+        if (eagerRemaining == 0)
+        {
+            return;
+        }
+        m_queueCv.notify_all();
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threadCount; ++t)
+        {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief Constructs a singleton (and its dependencies) on demand.
+     *
+     * Double-checked: ready singletons return immediately with no locking,
+     * racing first accesses construct exactly once.
+     */
+    void ensureInitialized(SingletonId id)
+    {
+        Entry& entry = *m_entries[id];
+        if (entry.state.load(std::memory_order_acquire) == READY)
+        {
+            return;
+        }
+        for (SingletonId dependency : entry.dependencies)
+        {
+            ensureInitialized(dependency);
+        }
+        runInit(entry);
+    }
+
+    /// @brief Milliseconds the singleton's init took; 0 if still cold.
+    double initMillis(SingletonId id) const
+    {
+        return m_entries[id]->initMs;
+    }
+
+    /// @brief Prints one instrumentation line per declared singleton.
+    void report() const
+    {
+        for (const auto& entry : m_entries)
+        {
+            bool ready = entry->state.load(std::memory_order_acquire) == READY;
+            std::cout << "  " << entry->name << ": "
+                      << (ready ? "ready" : "cold (lazy)");
+            if (ready)
+            {
+                std::cout << ", init " << entry->initMs << " ms";
+            }
+            std::cout << "\n";
+        }
+    }
+
+private:
+    static constexpr int COLD = 0;
+    static constexpr int READY = 2;
+
+    /**
+     * @brief One declared singleton and its scheduling state.
+     */
+    struct Entry
+    {
+        std::string name;
+        Mode mode{Mode::Eager};
+        std::vector<SingletonId> dependencies;
+        std::vector<SingletonId> dependents;    ///< Reverse edges, for unblocking.
+        InitFn init;
+        std::atomic<int> state{COLD};
+        std::mutex initMutex;                   ///< Serializes racing lazy inits.
+        std::atomic<std::size_t> pendingDeps{0}; ///< Unfinished deps during startup.
+        double initMs{0};
+    };
+
+    /// @brief Runs one init exactly once, timing it.
+    void runInit(Entry& entry)
+    {
+        std::lock_guard lock(entry.initMutex);
+        if (entry.state.load(std::memory_order_acquire) == READY)
+        {
+            return;
+        }
+        auto start = std::chrono::steady_clock::now();
+        entry.init();
+        entry.initMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        entry.state.store(READY, std::memory_order_release);
+    }
+
+    /// @brief Pops ready singletons until every eager one is initialized.
+    void workerLoop()
+    {
+        for (;;)
+        {
+            Entry* entry = nullptr;
+            {
+                std::unique_lock lock(m_queueMutex);
+                m_queueCv.wait(lock, [this] { return !m_readyQueue.empty() || m_eagerRemaining == 0; });
+                if (m_eagerRemaining == 0)
+                {
+                    return;
+                }
+                entry = m_readyQueue.back();
+                m_readyQueue.pop_back();
+            }
+            runInit(*entry);
+            std::lock_guard lock(m_queueMutex);
+            for (SingletonId dependentId : entry->dependents)
+            {
+                Entry& dependent = *m_entries[dependentId];
+                if (dependent.mode == Mode::Eager
+                    && dependent.pendingDeps.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    m_readyQueue.push_back(&dependent);
+                }
+            }
+            --m_eagerRemaining;
+            m_queueCv.notify_all(); // New work, or everyone-done: wake all waiters.
+        }
+    }
+
+    std::vector<std::unique_ptr<Entry>> m_entries; ///< Declaration order = id order.
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueCv;
+    std::vector<Entry*> m_readyQueue;              ///< Runnable eager singletons.
+    std::size_t m_eagerRemaining{0};
+};
+
+/// @brief Stands in for a service constructor with a known startup cost.
+static void simulateInit(int milliseconds)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+}
+
 /**
  * @brief A simple class representing a Dog.
  *
@@ -87,15 +308,45 @@ int main()
 {
     // Accessing the Dog singleton via SingletonCreator
     SingletonCreator<Dog>::getInstance().bark();
-    
+
     // Ensure that the same instance is being returned each time
     auto& dog1 = SingletonCreator<Dog>::getInstance();
     auto& dog2 = SingletonCreator<Dog>::getInstance();
-    
+
     if (&dog1 == &dog2)
     {
         std::cout << "Both references point to the same instance of Dog." << std::endl;
     }
 
+    // Registry startup: parallel init along the dependency graph.
+    SingletonRegistry registry;
+    using Mode = SingletonRegistry::Mode;
+    auto config   = registry.declare("config",   Mode::Eager, {},                 [] { simulateInit(20); });
+    auto logging  = registry.declare("logging",  Mode::Eager, {config},           [] { simulateInit(20); });
+    auto metrics  = registry.declare("metrics",  Mode::Eager, {config},           [] { simulateInit(30); });
+    auto database = registry.declare("database", Mode::Eager, {config, logging},  [] { simulateInit(60); });
+    auto cache    = registry.declare("cache",    Mode::Eager, {config},           [] { simulateInit(40); });
+    auto auth     = registry.declare("auth",     Mode::Eager, {database},         [] { simulateInit(50); });
+    auto search   = registry.declare("search",   Mode::Eager, {cache},            [] { simulateInit(50); });
+    auto billing  = registry.declare("billing",  Mode::Eager, {database, auth},   [] { simulateInit(40); });
+    auto exporter = registry.declare("exporter", Mode::Lazy,  {metrics},          [] { simulateInit(80); });
+
+    constexpr double serialCost = 20 + 20 + 30 + 60 + 40 + 50 + 50 + 40; // What eager-serial would pay.
+
+    auto start = std::chrono::steady_clock::now();
+    registry.startup(3);
+    double startupTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Startup: serial sum would be " << serialCost << " ms, parallel startup took "
+              << startupTime << " ms (critical path config->database->auth->billing = 170 ms)\n";
+    registry.report();
+
+    // Cold singleton constructed on first use only.
+    start = std::chrono::steady_clock::now();
+    registry.ensureInitialized(exporter);
+    double lazyTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Lazy exporter first use: " << lazyTime << " ms (init "
+              << registry.initMillis(exporter) << " ms)" << std::endl;
+
     return 0;
 }
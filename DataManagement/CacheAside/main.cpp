@@ -17,213 +17,431 @@
  * @note In this example, the cache is simulated using an unordered_map and the database is simulated by a simple function.
  */
 
- #include <iostream>
- #include <memory>
- #include <unordered_map>
- #include <string>
- 
- /**
-  * @brief Represents an entity in the system that can be cached.
-  * 
-  * In this example, we simulate a "Customer" entity with an ID and a name.
-  */
- class Customer
- {
- public:
-     Customer(int id, const std::string &name) : m_id(id), m_name(name) {}
- 
-     /**
-      * @brief Gets the customer ID.
-      * @return The customer ID.
-      */
-     int getId() const { return m_id; }
- 
-     /**
-      * @brief Gets the customer name.
-      * @return The customer name.
-      */
-     std::string getName() const { return m_name; }
- 
- private:
-     int m_id;               ///< Customer ID
-     std::string m_name;     ///< Customer Name
- };
- 
- /**
-  * @brief Interface for a cache system.
-  * 
-  * The cache interface defines methods for retrieving and storing data in the cache.
-  */
- class ICache
- {
- public:
-     virtual ~ICache() = default;
- 
-     /**
-      * @brief Gets the value from the cache based on the key.
-      * @param key The key to retrieve the value.
-      * @return A shared pointer to the value if found, nullptr otherwise.
-      */
-     virtual std::shared_ptr<Customer> get(int key) const = 0;
- 
-     /**
-      * @brief Puts the value into the cache with the given key.
-      * @param key The key to store the value under.
-      * @param value The value to store in the cache.
-      */
-     virtual void put(int key, const std::shared_ptr<Customer> &value) = 0;
- };
- 
- /**
-  * @brief Concrete cache implementation using an unordered_map.
-  * 
-  * This implementation simulates the behavior of a cache using an unordered_map.
-  */
- class Cache : public ICache
- {
- public:
-     /**
-      * @brief Gets the value from the cache based on the key.
-      * @param key The key to retrieve the value.
-      * @return A shared pointer to the value if found, nullptr otherwise.
-      */
-     std::shared_ptr<Customer> get(int key) const override
-     {
-         auto it = m_cache.find(key);
-         if (it != m_cache.end())
-         {
-             return it->second;
-         }
-         return nullptr;
-     }
- 
-     /**
-      * @brief Puts the value into the cache with the given key.
-      * @param key The key to store the value under.
-      * @param value The value to store in the cache.
-      */
-     void put(int key, const std::shared_ptr<Customer> &value) override
-     {
-         m_cache[key] = value;
-     }
- 
- private:
-     mutable std::unordered_map<int, std::shared_ptr<Customer>> m_cache; ///< Simulated cache storage
- };
- 
- /**
-  * @brief Interface for a data source, such as a database.
-  * 
-  * The data source interface defines the method for retrieving data from a storage system.
-  */
- class IDataSource
- {
- public:
-     virtual ~IDataSource() = default;
- 
-     /**
-      * @brief Retrieves the customer data from the database.
-      * @param id The ID of the customer to retrieve.
-      * @return A shared pointer to the customer if found, nullptr otherwise.
-      */
-     virtual std::shared_ptr<Customer> getCustomer(int id) const = 0;
- };
- 
- /**
-  * @brief Concrete data source implementation simulating a database.
-  * 
-  * This implementation simulates retrieving a customer from a database.
-  */
- class DataSource : public IDataSource
- {
- public:
-     /**
-      * @brief Retrieves the customer data from the database.
-      * @param id The ID of the customer to retrieve.
-      * @return A shared pointer to the customer if found, nullptr otherwise.
-      */
-     std::shared_ptr<Customer> getCustomer(int id) const override
-     {
-         if (id == 1)
-         {
-             return std::make_shared<Customer>(1, "John Doe");
-         }
-         else if (id == 2)
-         {
-             return std::make_shared<Customer>(2, "Jane Smith");
-         }
-         return nullptr;
-     }
- };
- 
- /**
-  * @brief Implements the Cache-Aside pattern.
-  * 
-  * The Cache-Aside pattern ensures that data is retrieved from the cache first, and if not found, it loads from the database
-  * and stores the result in the cache for future use.
-  */
- class CacheAside
- {
- public:
-     /**
-      * @brief Constructs a Cache-Aside object with the given cache and data source.
-      * @param cache The cache to use for storing and retrieving data.
-      * @param dataSource The data source to load data from if not found in the cache.
-      */
-     CacheAside(std::shared_ptr<ICache> cache, std::shared_ptr<IDataSource> dataSource)
-         : m_cache(std::move(cache)), m_dataSource(std::move(dataSource)) {}
- 
-     /**
-      * @brief Retrieves a customer, first checking the cache and then the database.
-      * @param id The ID of the customer to retrieve.
-      * @return A shared pointer to the customer if found.
-      */
-     std::shared_ptr<Customer> getCustomer(int id)
-     {
-         // Try to get customer from cache
-         auto customer = m_cache->get(id);
-         if (customer)
-         {
-             std::cout << "Cache hit: Retrieved customer from cache.\n";
-             return customer;
-         }
- 
-         // If not found in cache, get it from the data source
-         std::cout << "Cache miss: Retrieving customer from database.\n";
-         customer = m_dataSource->getCustomer(id);
- 
-         // Store the retrieved customer in the cache
-         if (customer)
-         {
-             m_cache->put(id, customer);
-             std::cout << "Storing customer in cache.\n";
-         }
- 
-         return customer;
-     }
- 
- private:
-     std::shared_ptr<ICache> m_cache;       ///< The cache to store data
-     std::shared_ptr<IDataSource> m_dataSource; ///< The data source to load data from
- };
- 
- /**
-  * @brief Main function to demonstrate the Cache-Aside pattern.
-  */
- int main()
- {
-     // Initialize the cache and data source
-     auto cache = std::make_shared<Cache>();
-     auto dataSource = std::make_shared<DataSource>();
- 
-     // Create the CacheAside object with the cache and data source
-     CacheAside cacheAside(cache, dataSource);
- 
-     // Try to get customers (with cache misses and hits)
-     auto customer1 = cacheAside.getCustomer(1); // Should miss the cache and load from the "database"
-     auto customer2 = cacheAside.getCustomer(2); // Should miss the cache and load from the "database"
-     auto customer3 = cacheAside.getCustomer(1); // Should hit the cache this time
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <string>
+#include <list>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+
+/**
+ * @brief Represents an entity in the system that can be cached.
+ * 
+ * In this example, we simulate a "Customer" entity with an ID and a name.
+ */
+class Customer
+{
+public:
+    Customer(int id, const std::string &name) : m_id(id), m_name(name) {}
+
+    /**
+     * @brief Gets the customer ID.
+     * @return The customer ID.
+     */
+    int getId() const { return m_id; }
+
+    /**
+     * @brief Gets the customer name.
+     * @return The customer name.
+     */
+    std::string getName() const { return m_name; }
+
+private:
+    int m_id;               ///< Customer ID
+    std::string m_name;     ///< Customer Name
+};
+
+/**
+ * @brief Interface for a cache system.
+ * 
+ * The cache interface defines methods for retrieving and storing data in the cache.
+ */
+class ICache
+{
+public:
+    virtual ~ICache() = default;
+
+    /**
+     * @brief Gets the value from the cache based on the key.
+     * @param key The key to retrieve the value.
+     * @return A shared pointer to the value if found, nullptr otherwise.
+     */
+    virtual std::shared_ptr<Customer> get(int key) const = 0;
+
+    /**
+     * @brief Puts the value into the cache with the given key.
+     * @param key The key to store the value under.
+     * @param value The value to store in the cache.
+     */
+    virtual void put(int key, const std::shared_ptr<Customer> &value) = 0;
+};
+
+/**
+ * @brief Concrete cache implementation using an unordered_map.
+ * 
+ * This implementation simulates the behavior of a cache using an unordered_map.
+ */
+class Cache : public ICache
+{
+public:
+    /**
+     * @brief Gets the value from the cache based on the key.
+     * @param key The key to retrieve the value.
+     * @return A shared pointer to the value if found, nullptr otherwise.
+     */
+    std::shared_ptr<Customer> get(int key) const override
+    {
+        auto it = m_cache.find(key);
+        if (it != m_cache.end())
+        {
+            return it->second;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Puts the value into the cache with the given key.
+     * @param key The key to store the value under.
+     * @param value The value to store in the cache.
+     */
+    void put(int key, const std::shared_ptr<Customer> &value) override
+    {
+        m_cache[key] = value;
+    }
+
+private:
+    mutable std::unordered_map<int, std::shared_ptr<Customer>> m_cache; ///< Simulated cache storage
+};
+
+
+/**
+ * @brief Production cache engine: sharded, TTL-expiring, LRU-bounded, instrumented.
+ *
+ * Keys are spread across N independently locked shards so concurrent threads
+ * rarely contend on the same mutex. Each entry carries an expiry deadline:
+ * stale entries are dropped lazily on get() and proactively by a background
+ * sweeper thread. Every shard is bounded and evicts its least-recently-used
+ * entry when full. Hit, miss, eviction and expiry counters are exported so
+ * the cache can be sized from real traffic.
+ */
+class ShardedCache : public ICache
+{
+public:
+    /**
+     * @brief Aggregated counters exported for capacity planning.
+     */
+    struct Stats
+    {
+        std::size_t hits{0};      ///< get() found a live entry.
+        std::size_t misses{0};    ///< get() found nothing (or only a stale entry).
+        std::size_t evictions{0}; ///< Entries dropped by the LRU bound.
+        std::size_t expired{0};   ///< Entries dropped because their TTL elapsed.
+    };
+
+    /**
+     * @brief Constructs the cache engine.
+     * @param shardCount Number of independently locked shards.
+     * @param entriesPerShard LRU capacity of each shard.
+     * @param ttl Time-to-live applied to every entry.
+     * @param sweepInterval How often the background sweeper scans for stale entries.
+     */
+    ShardedCache(std::size_t shardCount,
+                 std::size_t entriesPerShard,
+                 std::chrono::milliseconds ttl,
+                 std::chrono::milliseconds sweepInterval = std::chrono::milliseconds(100))
+        : m_shards(shardCount), m_entriesPerShard(entriesPerShard), m_ttl(ttl)
+    {
+        m_sweeper = std::thread([this, sweepInterval] { sweeperLoop(sweepInterval); });
+    }
+
+    ~ShardedCache() override
+    {
+        {
+            std::lock_guard lock(m_sweeperMutex);
+            m_running = false;
+        }
+        m_sweeperWake.notify_one();
+        m_sweeper.join();
+    }
+
+    /**
+     * @brief Gets the value from the cache based on the key.
+     *
+     * A stale entry is removed here (lazy expiry) and reported as a miss.
+     *
+     * @param key The key to retrieve the value.
+     * @return A shared pointer to the value if found, nullptr otherwise.
+     */
+    std::shared_ptr<Customer> get(int key) const override
+    {
+        Shard& shard = shardFor(key);
+        std::lock_guard lock(shard.mutex);
+
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end())
+        {
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        if (std::chrono::steady_clock::now() >= it->second.expiry)
+        {
+            shard.lru.erase(it->second.lruPosition);
+            shard.entries.erase(it);
+            m_expired.fetch_add(1, std::memory_order_relaxed);
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lruPosition); // Mark most recently used.
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        return it->second.value;
+    }
+
+    /**
+     * @brief Puts the value into the cache with the given key.
+     *
+     * Evicts the shard's least-recently-used entry when the shard is full.
+     *
+     * @param key The key to store the value under.
+     * @param value The value to store in the cache.
+     */
+    void put(int key, const std::shared_ptr<Customer>& value) override
+    {
+        Shard& shard = shardFor(key);
+        std::lock_guard lock(shard.mutex);
+
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end())
+        {
+            it->second.value = value;
+            it->second.expiry = std::chrono::steady_clock::now() + m_ttl;
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lruPosition);
+            return;
+        }
+
+        if (shard.entries.size() >= m_entriesPerShard)
+        {
+            int victim = shard.lru.back();
+            shard.lru.pop_back();
+            shard.entries.erase(victim);
+            m_evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        shard.lru.push_front(key);
+        shard.entries[key] = Entry{value, std::chrono::steady_clock::now() + m_ttl, shard.lru.begin()};
+    }
+
+    /**
+     * @brief Returns a snapshot of the hit/miss/eviction/expiry counters.
+     */
+    Stats stats() const
+    {
+        return Stats{m_hits.load(), m_misses.load(), m_evictions.load(), m_expired.load()};
+    }
+
+private:
+    /**
+     * @brief A cached value plus its TTL deadline and LRU bookkeeping.
+     */
+    struct Entry
+    {
+        std::shared_ptr<Customer> value;
+        std::chrono::steady_clock::time_point expiry;
+        std::list<int>::iterator lruPosition;
+    };
+
+    /**
+     * @brief One independently locked slice of the key space.
+     */
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::unordered_map<int, Entry> entries;
+        std::list<int> lru; ///< Front = most recently used.
+    };
+
+    /**
+     * @brief Maps a key to its shard.
+     */
+    Shard& shardFor(int key) const
+    {
+        return m_shards[static_cast<std::size_t>(key) % m_shards.size()];
+    }
+
+    /**
+     * @brief Background expiry: periodically drops entries whose TTL elapsed.
+     */
+    void sweeperLoop(std::chrono::milliseconds interval)
+    {
+        std::unique_lock lock(m_sweeperMutex);
+        while (m_running)
+        {
+            m_sweeperWake.wait_for(lock, interval, [this] { return !m_running; });
+            if (!m_running)
+            {
+                return;
+            }
+            auto now = std::chrono::steady_clock::now();
+            for (Shard& shard : m_shards)
+            {
+                std::lock_guard shardLock(shard.mutex);
+                for (auto it = shard.entries.begin(); it != shard.entries.end();)
+                {
+                    if (now >= it->second.expiry)
+                    {
+                        shard.lru.erase(it->second.lruPosition);
+                        it = shard.entries.erase(it);
+                        m_expired.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+            }
+        }
+    }
+
+    mutable std::vector<Shard> m_shards;       ///< Independently locked shards.
+    std::size_t m_entriesPerShard;             ///< LRU capacity per shard.
+    std::chrono::milliseconds m_ttl;           ///< Time-to-live for every entry.
+
+    mutable std::atomic<std::size_t> m_hits{0};
+    mutable std::atomic<std::size_t> m_misses{0};
+    std::atomic<std::size_t> m_evictions{0};
+    mutable std::atomic<std::size_t> m_expired{0};
+
+    std::thread m_sweeper;                     ///< Background expiry thread.
+    std::mutex m_sweeperMutex;
+    std::condition_variable m_sweeperWake;
+    bool m_running{true};                      ///< Guarded by m_sweeperMutex.
+};
+
+/**
+ * @brief Interface for a data source, such as a database.
+ * 
+ * The data source interface defines the method for retrieving data from a storage system.
+ */
+class IDataSource
+{
+public:
+    virtual ~IDataSource() = default;
+
+    /**
+     * @brief Retrieves the customer data from the database.
+     * @param id The ID of the customer to retrieve.
+     * @return A shared pointer to the customer if found, nullptr otherwise.
+     */
+    virtual std::shared_ptr<Customer> getCustomer(int id) const = 0;
+};
+
+/**
+ * @brief Concrete data source implementation simulating a database.
+ * 
+ * This implementation simulates retrieving a customer from a database.
+ */
+class DataSource : public IDataSource
+{
+public:
+    /**
+     * @brief Retrieves the customer data from the database.
+     * @param id The ID of the customer to retrieve.
+     * @return A shared pointer to the customer if found, nullptr otherwise.
+     */
+    std::shared_ptr<Customer> getCustomer(int id) const override
+    {
+        if (id == 1)
+        {
+            return std::make_shared<Customer>(1, "John Doe");
+        }
+        else if (id == 2)
+        {
+            return std::make_shared<Customer>(2, "Jane Smith");
+        }
+        return nullptr;
+    }
+};
+
+/**
+ * @brief Implements the Cache-Aside pattern.
+ * 
+ * The Cache-Aside pattern ensures that data is retrieved from the cache first, and if not found, it loads from the database
+ * and stores the result in the cache for future use.
+ */
+class CacheAside
+{
+public:
+    /**
+     * @brief Constructs a Cache-Aside object with the given cache and data source.
+     * @param cache The cache to use for storing and retrieving data.
+     * @param dataSource The data source to load data from if not found in the cache.
+     */
+    CacheAside(std::shared_ptr<ICache> cache, std::shared_ptr<IDataSource> dataSource)
+        : m_cache(std::move(cache)), m_dataSource(std::move(dataSource)) {}
+
+    /**
+     * @brief Retrieves a customer, first checking the cache and then the database.
+     * @param id The ID of the customer to retrieve.
+     * @return A shared pointer to the customer if found.
+     */
+    std::shared_ptr<Customer> getCustomer(int id)
+    {
+        // Try to get customer from cache
+        auto customer = m_cache->get(id);
+        if (customer)
+        {
+            std::cout << "Cache hit: Retrieved customer from cache.\n";
+            return customer;
+        }
+
+        // If not found in cache, get it from the data source
+        std::cout << "Cache miss: Retrieving customer from database.\n";
+        customer = m_dataSource->getCustomer(id);
+
+        // Store the retrieved customer in the cache
+        if (customer)
+        {
+            m_cache->put(id, customer);
+            std::cout << "Storing customer in cache.\n";
+        }
+
+        return customer;
+    }
+
+private:
+    std::shared_ptr<ICache> m_cache;       ///< The cache to store data
+    std::shared_ptr<IDataSource> m_dataSource; ///< The data source to load data from
+};
+
+/**
+ * @brief Main function to demonstrate the Cache-Aside pattern.
+ */
+int main()
+{
+    // Initialize the cache engine and data source
+    auto cache = std::make_shared<ShardedCache>(4, 64, std::chrono::milliseconds(200));
+    auto dataSource = std::make_shared<DataSource>();
+
+    // Create the CacheAside object with the cache and data source
+    CacheAside cacheAside(cache, dataSource);
+
+    // Try to get customers (with cache misses and hits)
+    auto customer1 = cacheAside.getCustomer(1); // Should miss the cache and load from the "database"
+    auto customer2 = cacheAside.getCustomer(2); // Should miss the cache and load from the "database"
+    auto customer3 = cacheAside.getCustomer(1); // Should hit the cache this time
+
+    // Let the TTL elapse; the background sweeper reclaims the stale entries.
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    auto customer4 = cacheAside.getCustomer(1); // TTL expired: misses and reloads
+
+    auto stats = cache->stats();
+    std::cout << "Cache stats: " << stats.hits << " hit(s), " << stats.misses << " miss(es), "
+              << stats.evictions << " eviction(s), " << stats.expired << " expired\n";
+
+    return 0;
+}
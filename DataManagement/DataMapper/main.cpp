@@ -10,167 +10,377 @@
  * - Enables better separation of concerns, keeping the domain logic separate from the persistence logic.
  * - Allows for easier changes to the database schema without impacting the business logic.
  * - Enhances testability by making the domain objects simpler to test.
+ *
+ * Re-hydrating the same hot users on every findById wastes both allocations and backend
+ * round trips. The identity-map layer keeps one canonical in-memory instance per id in
+ * lock-striped shards, hydrates batches of misses in a single backend fetch, and uses
+ * per-id generations so a write invalidates only that id instead of flushing the map.
  */
 
- #include <iostream>
- #include <memory>
- #include <vector>
- #include <string>
- 
- /**
-  * @brief A simple User model that represents a user in-memory.
-  */
- class User
- {
- public:
-     /**
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <array>
+#include <mutex>
+#include <span>
+#include <cstdint>
+
+/**
+ * @brief A simple User model that represents a user in-memory.
+ */
+class User
+{
+public:
+    /**
       * @brief Constructs a User object.
       * @param id The ID of the user.
       * @param name The name of the user.
       */
-     User(int id, const std::string& name)
-         : m_id(id), m_name(name)
-     {}
- 
-     /**
+    User(int id, const std::string& name)
+        : m_id(id), m_name(name)
+    {}
+
+    /**
       * @brief Gets the user's ID.
       * @return The ID of the user.
       */
-     int getId() const { return m_id; }
- 
-     /**
+    int getId() const { return m_id; }
+
+    /**
       * @brief Gets the user's name.
       * @return The name of the user.
       */
-     const std::string& getName() const { return m_name; }
- 
- private:
-     int m_id;          ///< The ID of the user.
-     std::string m_name;///< The name of the user.
- };
- 
- /**
-  * @brief Interface for a Data Mapper that handles the persistence logic for the User object.
-  */
- class IUserDataMapper
- {
- public:
-     virtual ~IUserDataMapper() = default;
- 
-     /**
+    const std::string& getName() const { return m_name; }
+
+private:
+    int m_id;          ///< The ID of the user.
+    std::string m_name;///< The name of the user.
+};
+
+/**
+ * @brief Interface for a Data Mapper that handles the persistence logic for the User object.
+ */
+class IUserDataMapper
+{
+public:
+    virtual ~IUserDataMapper() = default;
+
+    /**
       * @brief Saves a user to the database.
       * @param user The user to save.
       */
-     virtual void save(const std::shared_ptr<User>& user) = 0;
- 
-     /**
+    virtual void save(const std::shared_ptr<User>& user) = 0;
+
+    /**
       * @brief Retrieves a user by ID from the database.
       * @param id The ID of the user.
       * @return A shared pointer to the user if found, nullptr otherwise.
       */
-     virtual std::shared_ptr<User> findById(int id) const = 0;
- };
- 
- /**
-  * @brief Concrete implementation of IUserDataMapper that uses a simple in-memory "database".
-  */
- class InMemoryUserDataMapper : public IUserDataMapper
- {
- public:
-     /**
+    virtual std::shared_ptr<User> findById(int id) const = 0;
+};
+
+/**
+ * @brief Concrete implementation of IUserDataMapper that uses a simple in-memory "database".
+ */
+class InMemoryUserDataMapper : public IUserDataMapper
+{
+public:
+    /**
       * @brief Saves a user to the in-memory database.
       * @param user The user to save.
       */
-     void save(const std::shared_ptr<User>& user) override
-     {
-         m_users.push_back(user);
-         std::cout << "User saved: " << user->getName() << std::endl;
-     }
- 
-     /**
+    void save(const std::shared_ptr<User>& user) override
+    {
+        m_users.push_back(user);
+        std::cout << "User saved: " << user->getName() << std::endl;
+    }
+
+    /**
       * @brief Finds a user by ID in the in-memory database.
       * @param id The ID of the user.
       * @return A shared pointer to the user if found, nullptr otherwise.
       */
-     std::shared_ptr<User> findById(int id) const override
-     {
-         for (const auto& user : m_users)
-         {
-             if (user->getId() == id)
-             {
-                 return user;
-             }
-         }
-         return nullptr;
-     }
- 
- private:
-     std::vector<std::shared_ptr<User>> m_users; ///< In-memory storage for users.
- };
- 
- /**
-  * @brief A service class that interacts with the Data Mapper to manage user data.
-  */
- class UserService
- {
- public:
-     /**
+    std::shared_ptr<User> findById(int id) const override
+    {
+        for (const auto& user : m_users)
+        {
+            if (user->getId() == id)
+            {
+                return user;
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    std::vector<std::shared_ptr<User>> m_users; ///< In-memory storage for users.
+};
+
+/**
+ * @brief Simulated database gateway: plain rows, batch fetch, hydration counter.
+ */
+class UserRowGateway
+{
+public:
+    /**
+     * @brief Upserts one row.
+     */
+    void writeRow(int id, const std::string& name)
+    {
+        m_rows[id] = name;
+    }
+
+    /**
+     * @brief Fetches a batch of rows in one round trip.
+     * @param ids The ids to fetch.
+     * @return Hydrated users, one per id found.
+     */
+    std::vector<std::shared_ptr<User>> fetchRows(std::span<const int> ids)
+    {
+        ++m_roundTrips;
+        std::vector<std::shared_ptr<User>> result;
+        for (int id : ids)
+        {
+            auto it = m_rows.find(id);
+            if (it != m_rows.end())
+            {
+                ++m_hydrations;
+                result.push_back(std::make_shared<User>(id, it->second));
+            }
+        }
+        return result;
+    }
+
+    std::size_t hydrations() const { return m_hydrations; }
+    std::size_t roundTrips() const { return m_roundTrips; }
+
+private:
+    std::unordered_map<int, std::string> m_rows; ///< The "database" rows.
+    std::size_t m_hydrations{0};                 ///< Users constructed from rows.
+    std::size_t m_roundTrips{0};                 ///< Batch fetches issued.
+};
+
+/**
+ * @brief Data mapper with a lock-striped identity map in front of the gateway.
+ *
+ * Each id maps to one canonical User instance; repeated findById calls return
+ * the same object without touching the backend. Entries carry the per-id
+ * generation they were hydrated under — save() bumps that id's generation, so
+ * the stale instance is refreshed on next access while every other cached id
+ * stays valid. Striping the map across shards keeps concurrent handlers from
+ * serializing on one lock.
+ */
+class IdentityMapUserDataMapper : public IUserDataMapper
+{
+public:
+    static constexpr std::size_t SHARD_COUNT = 8;
+
+    explicit IdentityMapUserDataMapper(std::shared_ptr<UserRowGateway> gateway)
+        : m_gateway(std::move(gateway))
+    {}
+
+    /**
+     * @brief Writes through to the gateway and invalidates only this id.
+     */
+    void save(const std::shared_ptr<User>& user) override
+    {
+        m_gateway->writeRow(user->getId(), user->getName());
+        Shard& shard = shardFor(user->getId());
+        std::lock_guard lock(shard.mutex);
+        ++shard.generations[user->getId()]; // Cached instance for this id is now stale.
+        std::cout << "User saved: " << user->getName() << std::endl;
+    }
+
+    /**
+     * @brief Returns the canonical instance, hydrating on miss or staleness.
+     */
+    std::shared_ptr<User> findById(int id) const override
+    {
+        Shard& shard = shardFor(id);
+        {
+            std::lock_guard lock(shard.mutex);
+            auto it = shard.entries.find(id);
+            if (it != shard.entries.end() && it->second.generation == currentGeneration(shard, id))
+            {
+                return it->second.user;
+            }
+        }
+        auto fetched = m_gateway->fetchRows(std::span<const int>(&id, 1));
+        if (fetched.empty())
+        {
+            return nullptr;
+        }
+        std::lock_guard lock(shard.mutex);
+        shard.entries[id] = Entry{fetched.front(), currentGeneration(shard, id)};
+        return fetched.front();
+    }
+
+    /**
+     * @brief Bulk lookup: resident ids come from the map, all misses are
+     *        hydrated in one gateway round trip.
+     */
+    std::vector<std::shared_ptr<User>> findByIds(std::span<const int> ids) const
+    {
+        std::vector<std::shared_ptr<User>> result(ids.size());
+        std::vector<int> missing;
+        std::vector<std::size_t> missingSlots;
+
+        for (std::size_t i = 0; i < ids.size(); ++i)
+        {
+            Shard& shard = shardFor(ids[i]);
+            std::lock_guard lock(shard.mutex);
+            auto it = shard.entries.find(ids[i]);
+            if (it != shard.entries.end() && it->second.generation == currentGeneration(shard, ids[i]))
+            {
+                result[i] = it->second.user;
+            }
+            else
+            {
+                missing.push_back(ids[i]);
+                missingSlots.push_back(i);
+            }
+        }
+
+        if (!missing.empty())
+        {
+            auto fetched = m_gateway->fetchRows(missing); // One batch round trip.
+            for (std::size_t i = 0; i < fetched.size(); ++i)
+            {
+                int id = fetched[i]->getId();
+                Shard& shard = shardFor(id);
+                std::lock_guard lock(shard.mutex);
+                shard.entries[id] = Entry{fetched[i], currentGeneration(shard, id)};
+                result[missingSlots[i]] = fetched[i];
+            }
+        }
+        return result;
+    }
+
+private:
+    /**
+     * @brief A cached canonical instance and the generation it was loaded under.
+     */
+    struct Entry
+    {
+        std::shared_ptr<User> user;
+        std::uint64_t generation{0};
+    };
+
+    /**
+     * @brief One stripe of the identity map with its own lock.
+     */
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::unordered_map<int, Entry> entries;          ///< id -> canonical instance.
+        std::unordered_map<int, std::uint64_t> generations; ///< id -> write generation.
+    };
+
+    Shard& shardFor(int id) const
+    {
+        return m_shards[static_cast<std::size_t>(id) % SHARD_COUNT];
+    }
+
+    static std::uint64_t currentGeneration(const Shard& shard, int id)
+    {
+        auto it = shard.generations.find(id);
+        return it == shard.generations.end() ? 0 : it->second;
+    }
+
+    std::shared_ptr<UserRowGateway> m_gateway;        ///< Backing row store.
+    mutable std::array<Shard, SHARD_COUNT> m_shards;  ///< Lock-striped identity map.
+};
+
+/**
+ * @brief A service class that interacts with the Data Mapper to manage user data.
+ */
+class UserService
+{
+public:
+    /**
       * @brief Constructs the UserService with a given data mapper.
       * @param dataMapper The data mapper for accessing the user data.
       */
-     UserService(const std::shared_ptr<IUserDataMapper>& dataMapper)
-         : m_dataMapper(dataMapper)
-     {}
- 
-     /**
+    UserService(const std::shared_ptr<IUserDataMapper>& dataMapper)
+        : m_dataMapper(dataMapper)
+    {}
+
+    /**
       * @brief Saves a user to the database via the data mapper.
       * @param id The ID of the user.
       * @param name The name of the user.
       */
-     void saveUser(int id, const std::string& name)
-     {
-         auto user = std::make_shared<User>(id, name);
-         m_dataMapper->save(user);
-     }
- 
-     /**
+    void saveUser(int id, const std::string& name)
+    {
+        auto user = std::make_shared<User>(id, name);
+        m_dataMapper->save(user);
+    }
+
+    /**
       * @brief Retrieves a user by ID from the database via the data mapper.
       * @param id The ID of the user.
       * @return A shared pointer to the user, or nullptr if the user is not found.
       */
-     std::shared_ptr<User> getUserById(int id) const
-     {
-         return m_dataMapper->findById(id);
-     }
- 
- private:
-     std::shared_ptr<IUserDataMapper> m_dataMapper; ///< The data mapper for user data.
- };
- 
- /**
-  * @brief Main function that demonstrates the Data Mapper pattern.
-  */
- int main()
- {
-     // Create the data mapper and service.
-     auto userDataMapper = std::make_shared<InMemoryUserDataMapper>();
-     UserService userService(userDataMapper);
- 
-     // Save some users.
-     userService.saveUser(1, "Alice");
-     userService.saveUser(2, "Bob");
- 
-     // Retrieve a user by ID.
-     auto user = userService.getUserById(1);
-     if (user)
-     {
-         std::cout << "Found user: " << user->getName() << std::endl;
-     }
-     else
-     {
-         std::cout << "User not found" << std::endl;
-     }
- 
-     return 0;
- }
- 
\ No newline at end of file
+    std::shared_ptr<User> getUserById(int id) const
+    {
+        return m_dataMapper->findById(id);
+    }
+
+private:
+    std::shared_ptr<IUserDataMapper> m_dataMapper; ///< The data mapper for user data.
+};
+
+/**
+ * @brief Main function that demonstrates the Data Mapper pattern.
+ */
+int main()
+{
+    // Create the data mapper and service.
+    auto userDataMapper = std::make_shared<InMemoryUserDataMapper>();
+    UserService userService(userDataMapper);
+
+    // Save some users.
+    userService.saveUser(1, "Alice");
+    userService.saveUser(2, "Bob");
+
+    // Retrieve a user by ID.
+    auto user = userService.getUserById(1);
+    if (user)
+    {
+        std::cout << "Found user: " << user->getName() << std::endl;
+    }
+    else
+    {
+        std::cout << "User not found" << std::endl;
+    }
+
+    // Identity map: one canonical instance per id, batch hydration, per-id invalidation.
+    auto gateway = std::make_shared<UserRowGateway>();
+    auto identityMapper = std::make_shared<IdentityMapUserDataMapper>(gateway);
+    UserService cachedService(identityMapper);
+
+    cachedService.saveUser(1, "Alice");
+    cachedService.saveUser(2, "Bob");
+    cachedService.saveUser(3, "Charlie");
+
+    auto first = cachedService.getUserById(1);
+    auto second = cachedService.getUserById(1);
+    std::cout << "Same canonical instance: " << (first.get() == second.get())
+              << ", hydrations: " << gateway->hydrations() << std::endl;
+
+    // Bulk lookup: id 1 is resident, 2 and 3 hydrate in one round trip.
+    int wanted[] = {1, 2, 3};
+    auto users = identityMapper->findByIds(wanted);
+    std::cout << "findByIds hydrated " << users.size() << " user(s) in "
+              << gateway->roundTrips() << " total round trip(s)" << std::endl;
+
+    // A write bumps only that id's generation; other entries stay cached.
+    cachedService.saveUser(1, "Alicia");
+    std::cout << "After save, id 1 re-hydrates: " << cachedService.getUserById(1)->getName()
+              << ", id 2 stays cached: " << (identityMapper->findById(2).get() == users[1].get())
+              << std::endl;
+
+    return 0;
+}
@@ -10,94 +10,293 @@
  * - Saves resources by deferring the initialization until necessary.
  * - Can improve performance in scenarios where not all objects are used immediately.
  * - Useful in databases and ORM systems where not all data is required upfront.
+ *
+ * Unbounded lazy materialization eventually holds every record ever touched. The
+ * BoundedUserCache below caps live records: user slots come from a preallocated arena
+ * (no per-node heap allocation) threaded by an intrusive doubly-linked LRU list, the
+ * least-recently-used record is evicted through a callback when the arena is full, and
+ * prefetch() loads a batch of users in one simulated backend round trip instead of N
+ * individual lazy faults.
  */
 
- #include <iostream>
- #include <memory>
- #include <string>
- 
- /**
-  * @brief A class that simulates the loading of user data lazily from a database.
-  */
- class User
- {
- public:
-     /**
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <span>
+#include <cstdint>
+
+/**
+ * @brief A class that simulates the loading of user data lazily from a database.
+ */
+class User
+{
+public:
+    /**
       * @brief Constructor for the User class.
       * @param id The unique identifier for the user.
       */
-     User(int id)
-         : m_id(id)
-     {
-     }
- 
-     /**
+    User(int id)
+        : m_id(id)
+    {
+    }
+
+    /**
       * @brief Gets the user data.
       * 
       * Lazy loads the user data the first time it is accessed.
       * @return A string representing the user data.
       */
-     std::string getUserData()
-     {
-         if (!m_data)
-         {
-             loadData();
-         }
-         return *m_data;
-     }
- 
- private:
-     int m_id;                          ///< The unique ID of the user.
-     std::shared_ptr<std::string> m_data; ///< Holds user data, initialized lazily.
- 
-     /**
+    std::string getUserData()
+    {
+        if (!m_data)
+        {
+            loadData();
+        }
+        return *m_data;
+    }
+
+private:
+    int m_id;                          ///< The unique ID of the user.
+    std::shared_ptr<std::string> m_data; ///< Holds user data, initialized lazily.
+
+    /**
       * @brief Simulates loading user data from a database.
       * This is a private method that simulates the lazy loading of user data.
       */
-     void loadData()
-     {
-         // Simulate a delay for loading data (e.g., database query).
-         std::cout << "Loading data for user " << m_id << " from the database..." << std::endl;
-         m_data = std::make_shared<std::string>("User Data for ID: " + std::to_string(m_id));
-     }
- };
- 
- /**
-  * @brief A class that demonstrates the lazy loading pattern by interacting with the User class.
-  */
- class UserManager
- {
- public:
-     /**
+    void loadData()
+    {
+        // Simulate a delay for loading data (e.g., database query).
+        std::cout << "Loading data for user " << m_id << " from the database..." << std::endl;
+        m_data = std::make_shared<std::string>("User Data for ID: " + std::to_string(m_id));
+    }
+};
+
+/**
+ * @brief A class that demonstrates the lazy loading pattern by interacting with the User class.
+ */
+class UserManager
+{
+public:
+    /**
       * @brief Creates a new User instance.
       * @param id The unique identifier for the user.
       * @return A shared pointer to the created user.
       */
-     std::shared_ptr<User> createUser(int id)
-     {
-         return std::make_shared<User>(id);
-     }
- };
- 
- /**
-  * @brief Main function demonstrating Lazy Load pattern.
-  */
- int main()
- {
-     UserManager userManager;
- 
-     // Create a new user.
-     auto user = userManager.createUser(1);
- 
-     // At this point, the user data is not loaded yet.
-     std::cout << "User created. Data not loaded yet.\n";
- 
-     // Accessing user data for the first time triggers the lazy loading.
-     std::cout << "User Data: " << user->getUserData() << std::endl;
- 
-     // On subsequent calls, the data is already loaded.
-     std::cout << "User Data (second access): " << user->getUserData() << std::endl;
- 
-     return 0;
- }
- 
\ No newline at end of file
+    std::shared_ptr<User> createUser(int id)
+    {
+        return std::make_shared<User>(id);
+    }
+};
+
+/**
+ * @brief Bounded lazy-loading cache: arena slots, intrusive LRU, batch prefetch.
+ *
+ * All user records live in one preallocated arena; the LRU list is threaded
+ * through the records themselves as prev/next slot indices, so touching or
+ * evicting a user never allocates. When the arena is full the least recently
+ * used record is recycled and the eviction callback observes it on the way out.
+ */
+class BoundedUserCache
+{
+public:
+    using EvictionCallback = std::function<void(int id, const std::string& data)>;
+
+    /**
+     * @brief Creates the cache with a fixed capacity.
+     * @param capacity Maximum number of live user records.
+     * @param onEvict Invoked for each record as it is evicted.
+     */
+    explicit BoundedUserCache(std::size_t capacity, EvictionCallback onEvict = {})
+        : m_arena(capacity), m_onEvict(std::move(onEvict))
+    {
+        m_slots.reserve(capacity);
+        for (std::size_t i = 0; i < capacity; ++i)
+        {
+            m_arena[i].next = static_cast<std::int32_t>(i) + 1; // Free-list chain.
+        }
+        m_arena[capacity - 1].next = NIL;
+        m_freeHead = 0;
+    }
+
+    /**
+     * @brief Gets a user's data, lazily loading it on first access.
+     *
+     * A hit promotes the record to most-recently-used; a miss loads from the
+     * backend into an arena slot, evicting the LRU record if the arena is full.
+     *
+     * @param id The unique identifier for the user.
+     * @return The user's data.
+     */
+    const std::string& getUserData(int id)
+    {
+        auto it = m_slots.find(id);
+        if (it != m_slots.end())
+        {
+            touch(it->second);
+            return m_arena[it->second].data;
+        }
+        std::cout << "Loading data for user " << id << " from the database..." << std::endl;
+        std::int32_t slot = emplace(id);
+        m_arena[slot].data = "User Data for ID: " + std::to_string(id);
+        return m_arena[slot].data;
+    }
+
+    /**
+     * @brief Loads a batch of users in one backend round trip.
+     * @param ids The users to materialize; already-resident ids are just touched.
+     */
+    void prefetch(std::span<const int> ids)
+    {
+        std::vector<int> missing;
+        for (int id : ids)
+        {
+            auto it = m_slots.find(id);
+            if (it != m_slots.end())
+            {
+                touch(it->second);
+            }
+            else
+            {
+                missing.push_back(id);
+            }
+        }
+        if (missing.empty())
+        {
+            return;
+        }
+        std::cout << "Batch-loading " << missing.size() << " user(s) in one round trip..." << std::endl;
+        for (int id : missing)
+        {
+            std::int32_t slot = emplace(id);
+            m_arena[slot].data = "User Data for ID: " + std::to_string(id);
+        }
+    }
+
+    std::size_t size() const { return m_slots.size(); }
+
+private:
+    static constexpr std::int32_t NIL = -1;
+
+    /**
+     * @brief One arena slot; the LRU list runs through prev/next.
+     */
+    struct Record
+    {
+        int id{0};
+        std::string data;
+        std::int32_t prev{NIL}; ///< Towards most recently used.
+        std::int32_t next{NIL}; ///< Towards least recently used (or free-list link).
+    };
+
+    /**
+     * @brief Unlinks a record from the LRU list.
+     */
+    void unlink(std::int32_t slot)
+    {
+        Record& record = m_arena[slot];
+        (record.prev == NIL ? m_head : m_arena[record.prev].next) = record.next;
+        (record.next == NIL ? m_tail : m_arena[record.next].prev) = record.prev;
+    }
+
+    /**
+     * @brief Links a record at the most-recently-used end.
+     */
+    void linkFront(std::int32_t slot)
+    {
+        Record& record = m_arena[slot];
+        record.prev = NIL;
+        record.next = m_head;
+        (m_head == NIL ? m_tail : m_arena[m_head].prev) = slot;
+        m_head = slot;
+    }
+
+    /**
+     * @brief Promotes a resident record to most recently used.
+     */
+    void touch(std::int32_t slot)
+    {
+        if (m_head != slot)
+        {
+            unlink(slot);
+            linkFront(slot);
+        }
+    }
+
+    /**
+     * @brief Claims a slot for a new record, evicting the LRU one if needed.
+     */
+    std::int32_t emplace(int id)
+    {
+        std::int32_t slot;
+        if (m_freeHead != NIL)
+        {
+            slot = m_freeHead;
+            m_freeHead = m_arena[slot].next;
+        }
+        else
+        {
+            slot = m_tail; // Arena full: recycle the least recently used record.
+            Record& victim = m_arena[slot];
+            if (m_onEvict)
+            {
+                m_onEvict(victim.id, victim.data);
+            }
+            m_slots.erase(victim.id);
+            unlink(slot);
+        }
+        m_arena[slot].id = id;
+        linkFront(slot);
+        m_slots.emplace(id, slot);
+        return slot;
+    }
+
+    std::vector<Record> m_arena;                   ///< Preallocated record storage.
+    std::unordered_map<int, std::int32_t> m_slots; ///< id -> arena slot.
+    std::int32_t m_freeHead{NIL};                  ///< Head of the free-slot chain.
+    std::int32_t m_head{NIL};                      ///< Most recently used slot.
+    std::int32_t m_tail{NIL};                      ///< Least recently used slot.
+    EvictionCallback m_onEvict;                    ///< Observes evicted records.
+};
+
+/**
+ * @brief Main function demonstrating Lazy Load pattern.
+ */
+int main()
+{
+    UserManager userManager;
+
+    // Create a new user.
+    auto user = userManager.createUser(1);
+
+    // At this point, the user data is not loaded yet.
+    std::cout << "User created. Data not loaded yet.\n";
+
+    // Accessing user data for the first time triggers the lazy loading.
+    std::cout << "User Data: " << user->getUserData() << std::endl;
+
+    // On subsequent calls, the data is already loaded.
+    std::cout << "User Data (second access): " << user->getUserData() << std::endl;
+
+    // Bounded lazy loading: capacity 3, intrusive LRU, eviction callback.
+    BoundedUserCache cache(3, [](int id, const std::string&)
+    {
+        std::cout << "Evicting user " << id << " (least recently used)\n";
+    });
+
+    cache.getUserData(1);
+    cache.getUserData(2);
+    cache.getUserData(3);
+    cache.getUserData(1); // Touch: user 1 becomes most recently used.
+    cache.getUserData(4); // Full: evicts user 2, the LRU record.
+    std::cout << "Cache holds " << cache.size() << " user(s)\n";
+
+    // Batch prefetch: one round trip instead of per-user lazy faults.
+    int wanted[] = {1, 5, 6};
+    cache.prefetch(wanted);
+    std::cout << "User Data (prefetched): " << cache.getUserData(5) << std::endl;
+
+    return 0;
+}
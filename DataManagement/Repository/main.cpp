@@ -10,194 +10,366 @@
  * - Promotes the single responsibility principle by separating data access logic from business logic.
  * - Improves code maintainability and testability.
  * - Can easily be extended to support different data sources without modifying other parts of the application.
+ *
+ * For read-heavy replicas the shared_ptr-per-user layout scans poorly: every attribute
+ * filter chases pointers and copies shared_ptrs. ColumnarUserRepository stores id, name
+ * and age in parallel contiguous arrays, maintains hash indexes (id, name) and a sorted
+ * age index on write, and answers queries with lightweight row handles — filtered scans
+ * run cache-linear over one column and indexed lookups are O(1) or O(log n).
  */
 
- #include <iostream>
- #include <memory>
- #include <vector>
- #include <string>
- 
- /**
-  * @brief A simple User model that contains user data.
-  */
- class User
- {
- public:
-     /**
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <chrono>
+
+/**
+ * @brief A simple User model that contains user data.
+ */
+class User
+{
+public:
+    /**
       * @brief Constructs a User object with an ID and name.
       * @param id The ID of the user.
       * @param name The name of the user.
       */
-     User(int id, const std::string& name)
-         : m_id(id), m_name(name)
-     {}
- 
-     /**
+    User(int id, const std::string& name)
+        : m_id(id), m_name(name)
+    {}
+
+    /**
       * @brief Gets the user's ID.
       * @return The ID of the user.
       */
-     int getId() const { return m_id; }
- 
-     /**
+    int getId() const { return m_id; }
+
+    /**
       * @brief Gets the user's name.
       * @return The name of the user.
       */
-     const std::string& getName() const { return m_name; }
- 
- private:
-     int m_id;          ///< The unique ID of the user.
-     std::string m_name;///< The name of the user.
- };
- 
- /**
-  * @brief Interface for a User repository that defines the contract for data access.
-  */
- class IUserRepository
- {
- public:
-     virtual ~IUserRepository() = default;
- 
-     /**
+    const std::string& getName() const { return m_name; }
+
+private:
+    int m_id;          ///< The unique ID of the user.
+    std::string m_name;///< The name of the user.
+};
+
+/**
+ * @brief Interface for a User repository that defines the contract for data access.
+ */
+class IUserRepository
+{
+public:
+    virtual ~IUserRepository() = default;
+
+    /**
       * @brief Adds a user to the repository.
       * @param user The user to add.
       */
-     virtual void addUser(const std::shared_ptr<User>& user) = 0;
- 
-     /**
+    virtual void addUser(const std::shared_ptr<User>& user) = 0;
+
+    /**
       * @brief Gets a user by ID.
       * @param id The ID of the user to retrieve.
       * @return A shared pointer to the user if found, nullptr otherwise.
       */
-     virtual std::shared_ptr<User> getUserById(int id) const = 0;
- 
-     /**
+    virtual std::shared_ptr<User> getUserById(int id) const = 0;
+
+    /**
       * @brief Lists all users in the repository.
       * @return A list of all users.
       */
-     virtual std::vector<std::shared_ptr<User>> getAllUsers() const = 0;
- };
- 
- /**
-  * @brief A concrete implementation of the IUserRepository that uses an in-memory container for data storage.
-  */
- class InMemoryUserRepository : public IUserRepository
- {
- public:
-     /**
+    virtual std::vector<std::shared_ptr<User>> getAllUsers() const = 0;
+};
+
+/**
+ * @brief A concrete implementation of the IUserRepository that uses an in-memory container for data storage.
+ */
+class InMemoryUserRepository : public IUserRepository
+{
+public:
+    /**
       * @brief Adds a user to the in-memory repository.
       * @param user The user to add.
       */
-     void addUser(const std::shared_ptr<User>& user) override
-     {
-         m_users.push_back(user);
-     }
- 
-     /**
+    void addUser(const std::shared_ptr<User>& user) override
+    {
+        m_users.push_back(user);
+    }
+
+    /**
       * @brief Gets a user by ID from the in-memory repository.
       * @param id The ID of the user to retrieve.
       * @return A shared pointer to the user if found, nullptr otherwise.
       */
-     std::shared_ptr<User> getUserById(int id) const override
-     {
-         for (const auto& user : m_users)
-         {
-             if (user->getId() == id)
-             {
-                 return user;
-             }
-         }
-         return nullptr;
-     }
- 
-     /**
+    std::shared_ptr<User> getUserById(int id) const override
+    {
+        for (const auto& user : m_users)
+        {
+            if (user->getId() == id)
+            {
+                return user;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
       * @brief Lists all users in the in-memory repository.
       * @return A list of all users.
       */
-     std::vector<std::shared_ptr<User>> getAllUsers() const override
-     {
-         return m_users;
-     }
- 
- private:
-     std::vector<std::shared_ptr<User>> m_users; ///< In-memory list of users.
- };
- 
- /**
-  * @brief A class that demonstrates the use of the Repository pattern for managing users.
-  */
- class UserService
- {
- public:
-     /**
+    std::vector<std::shared_ptr<User>> getAllUsers() const override
+    {
+        return m_users;
+    }
+
+private:
+    std::vector<std::shared_ptr<User>> m_users; ///< In-memory list of users.
+};
+
+/**
+ * @brief Columnar user storage: parallel arrays plus secondary indexes.
+ *
+ * Rows never move, so a RowHandle is just an index into the columns. Queries
+ * return handles, not copies; the caller dereferences only the attributes it
+ * needs. Hash indexes give O(1) id and name lookups, the sorted age index
+ * gives O(log n) range queries, and findWhere() scans one contiguous column.
+ */
+class ColumnarUserRepository
+{
+public:
+    /**
+     * @brief Lightweight, copy-free view of one stored row.
+     */
+    class RowHandle
+    {
+    public:
+        RowHandle(const ColumnarUserRepository& repository, std::size_t row)
+            : m_repository(&repository), m_row(row) {}
+
+        int id() const { return m_repository->m_ids[m_row]; }
+        const std::string& name() const { return m_repository->m_names[m_row]; }
+        int age() const { return m_repository->m_ages[m_row]; }
+
+    private:
+        const ColumnarUserRepository* m_repository; ///< Owning store.
+        std::size_t m_row;                          ///< Row position in the columns.
+    };
+
+    /**
+     * @brief Appends a row and updates every index.
+     * @param id The user's unique ID.
+     * @param name The user's name.
+     * @param age The user's age.
+     */
+    void addUser(int id, const std::string& name, int age)
+    {
+        std::size_t row = m_ids.size();
+        m_ids.push_back(id);
+        m_names.push_back(name);
+        m_ages.push_back(age);
+
+        m_byId.emplace(id, row);
+        m_byName[name].push_back(row);
+        auto position = std::upper_bound(m_byAge.begin(), m_byAge.end(), age,
+                                         [this](int value, std::size_t existing)
+                                         { return value < m_ages[existing]; });
+        m_byAge.insert(position, row); // Keeps the age index sorted on write.
+    }
+
+    /**
+     * @brief O(1) lookup through the id hash index.
+     * @return The row handle, or an empty vector slot if absent.
+     */
+    std::vector<RowHandle> findById(int id) const
+    {
+        auto it = m_byId.find(id);
+        if (it == m_byId.end())
+        {
+            return {};
+        }
+        return {RowHandle(*this, it->second)};
+    }
+
+    /**
+     * @brief O(1) lookup of all rows with a given name via the name hash index.
+     */
+    std::vector<RowHandle> findByName(const std::string& name) const
+    {
+        std::vector<RowHandle> result;
+        auto it = m_byName.find(name);
+        if (it != m_byName.end())
+        {
+            for (std::size_t row : it->second)
+            {
+                result.emplace_back(*this, row);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief O(log n + k) age range query through the sorted age index.
+     */
+    std::vector<RowHandle> findAgeBetween(int minimumAge, int maximumAge) const
+    {
+        auto first = std::lower_bound(m_byAge.begin(), m_byAge.end(), minimumAge,
+                                      [this](std::size_t existing, int value)
+                                      { return m_ages[existing] < value; });
+        std::vector<RowHandle> result;
+        for (auto it = first; it != m_byAge.end() && m_ages[*it] <= maximumAge; ++it)
+        {
+            result.emplace_back(*this, *it);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Cache-linear filtered scan; the predicate sees one row handle.
+     */
+    template <typename Predicate>
+    std::vector<RowHandle> findWhere(Predicate predicate) const
+    {
+        std::vector<RowHandle> result;
+        for (std::size_t row = 0; row < m_ids.size(); ++row)
+        {
+            RowHandle handle(*this, row);
+            if (predicate(handle))
+            {
+                result.push_back(handle);
+            }
+        }
+        return result;
+    }
+
+    std::size_t size() const { return m_ids.size(); }
+
+private:
+    std::vector<int> m_ids;           ///< id column.
+    std::vector<std::string> m_names; ///< name column.
+    std::vector<int> m_ages;          ///< age column.
+
+    std::unordered_map<int, std::size_t> m_byId;                      ///< id -> row.
+    std::unordered_map<std::string, std::vector<std::size_t>> m_byName; ///< name -> rows.
+    std::vector<std::size_t> m_byAge;                                 ///< Rows sorted by age.
+};
+
+/**
+ * @brief A class that demonstrates the use of the Repository pattern for managing users.
+ */
+class UserService
+{
+public:
+    /**
       * @brief Constructs a UserService with a given repository.
       * @param repository The repository to use for managing users.
       */
-     UserService(const std::shared_ptr<IUserRepository>& repository)
-         : m_repository(repository)
-     {}
- 
-     /**
+    UserService(const std::shared_ptr<IUserRepository>& repository)
+        : m_repository(repository)
+    {}
+
+    /**
       * @brief Adds a user to the repository.
       * @param id The ID of the user.
       * @param name The name of the user.
       */
-     void addUser(int id, const std::string& name)
-     {
-         auto user = std::make_shared<User>(id, name);
-         m_repository->addUser(user);
-     }
- 
-     /**
+    void addUser(int id, const std::string& name)
+    {
+        auto user = std::make_shared<User>(id, name);
+        m_repository->addUser(user);
+    }
+
+    /**
       * @brief Retrieves a user by ID from the repository.
       * @param id The ID of the user.
       * @return A shared pointer to the user, or nullptr if the user is not found.
       */
-     std::shared_ptr<User> getUserById(int id) const
-     {
-         return m_repository->getUserById(id);
-     }
- 
-     /**
+    std::shared_ptr<User> getUserById(int id) const
+    {
+        return m_repository->getUserById(id);
+    }
+
+    /**
       * @brief Retrieves all users from the repository.
       * @return A list of all users.
       */
-     std::vector<std::shared_ptr<User>> getAllUsers() const
-     {
-         return m_repository->getAllUsers();
-     }
- 
- private:
-     std::shared_ptr<IUserRepository> m_repository; ///< The repository for managing users.
- };
- 
- /**
-  * @brief Main function that demonstrates the Repository pattern in action.
-  */
- int main()
- {
-     // Create the repository and service.
-     auto userRepository = std::make_shared<InMemoryUserRepository>();
-     UserService userService(userRepository);
- 
-     // Add some users.
-     userService.addUser(1, "Alice");
-     userService.addUser(2, "Bob");
- 
-     // Retrieve a user by ID.
-     auto user = userService.getUserById(1);
-     if (user)
-     {
-         std::cout << "Found user: " << user->getName() << std::endl;
-     }
- 
-     // List all users.
-     auto allUsers = userService.getAllUsers();
-     std::cout << "All users:\n";
-     for (const auto& u : allUsers)
-     {
-         std::cout << u->getName() << std::endl;
-     }
- 
-     return 0;
- }
- 
\ No newline at end of file
+    std::vector<std::shared_ptr<User>> getAllUsers() const
+    {
+        return m_repository->getAllUsers();
+    }
+
+private:
+    std::shared_ptr<IUserRepository> m_repository; ///< The repository for managing users.
+};
+
+/**
+ * @brief Main function that demonstrates the Repository pattern in action.
+ */
+int main()
+{
+    // Create the repository and service.
+    auto userRepository = std::make_shared<InMemoryUserRepository>();
+    UserService userService(userRepository);
+
+    // Add some users.
+    userService.addUser(1, "Alice");
+    userService.addUser(2, "Bob");
+
+    // Retrieve a user by ID.
+    auto user = userService.getUserById(1);
+    if (user)
+    {
+        std::cout << "Found user: " << user->getName() << std::endl;
+    }
+
+    // List all users.
+    auto allUsers = userService.getAllUsers();
+    std::cout << "All users:\n";
+    for (const auto& u : allUsers)
+    {
+        std::cout << u->getName() << std::endl;
+    }
+
+    // Columnar storage with secondary indexes and copy-free row handles.
+    ColumnarUserRepository columns;
+    const char* names[] = {"Alice", "Bob", "Charlie", "Diana"};
+    for (int i = 0; i < 200000; ++i)
+    {
+        columns.addUser(i, names[i % 4], 18 + (i * 7) % 60);
+    }
+
+    auto alice = columns.findById(0);
+    std::cout << "findById(0): " << alice.front().name() << ", age " << alice.front().age() << std::endl;
+    std::cout << "findByName(\"Bob\"): " << columns.findByName("Bob").size() << " row(s)" << std::endl;
+    std::cout << "findAgeBetween(30, 32): " << columns.findAgeBetween(30, 32).size() << " row(s)" << std::endl;
+
+    // Filtered scan comparison: pointer-chasing repository vs one linear column pass.
+    auto scanRepository = std::make_shared<InMemoryUserRepository>();
+    for (int i = 0; i < 200000; ++i)
+    {
+        scanRepository->addUser(std::make_shared<User>(i, names[i % 4]));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t pointerMatches = 0;
+    for (const auto& candidate : scanRepository->getAllUsers())
+    {
+        pointerMatches += candidate->getName() == "Diana";
+    }
+    double pointerTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    std::size_t columnMatches = columns.findWhere([](const ColumnarUserRepository::RowHandle& row)
+                                                  { return row.name() == "Diana"; }).size();
+    double columnTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Name filter over " << columns.size() << " rows: shared_ptr scan "
+              << pointerTime << " ms (" << pointerMatches << "), columnar scan "
+              << columnTime << " ms (" << columnMatches << ")" << std::endl;
+
+    return 0;
+}
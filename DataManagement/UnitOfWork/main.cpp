@@ -22,6 +22,8 @@
  * - Atomicity: Changes are committed as a whole, ensuring consistency and preventing partial updates.
  * - Easy Rollback: If an error occurs, all changes can be undone in a single operation.
  * - Centralized Management: Operations are managed in a centralized fashion, reducing the complexity of managing data updates.
+ * - Batched Flush: Inserts, updates and deletes are grouped into configurable-size batches and
+ *   flushed through bulk repository calls, and dirty tracking skips entities that never changed.
  */
 
 class Customer
@@ -60,6 +62,14 @@ public:
     virtual void add(const std::shared_ptr<Customer> &entity) = 0;
     virtual void update(const std::shared_ptr<Customer> &entity) = 0;
     virtual void remove(const std::shared_ptr<Customer> &entity) = 0;
+
+    /**
+     * @brief Bulk variants: apply a whole batch in one repository round trip.
+     */
+    virtual void addBatch(const std::vector<std::shared_ptr<Customer>> &entities) = 0;
+    virtual void updateBatch(const std::vector<std::shared_ptr<Customer>> &entities) = 0;
+    virtual void removeBatch(const std::vector<std::shared_ptr<Customer>> &entities) = 0;
+
     virtual void commit() = 0;
     virtual void rollback() = 0;
 };
@@ -106,6 +116,33 @@ public:
         }
     }
 
+    void addBatch(const std::vector<std::shared_ptr<Customer>> &entities) override
+    {
+        std::cout << "Bulk insert of " << entities.size() << " customer(s) in one round trip\n";
+        for (const auto &entity : entities)
+        {
+            add(entity);
+        }
+    }
+
+    void updateBatch(const std::vector<std::shared_ptr<Customer>> &entities) override
+    {
+        std::cout << "Bulk update of " << entities.size() << " customer(s) in one round trip\n";
+        for (const auto &entity : entities)
+        {
+            update(entity);
+        }
+    }
+
+    void removeBatch(const std::vector<std::shared_ptr<Customer>> &entities) override
+    {
+        std::cout << "Bulk delete of " << entities.size() << " customer(s) in one round trip\n";
+        for (const auto &entity : entities)
+        {
+            remove(entity);
+        }
+    }
+
     void commit() override
     {
         std::cout << "Committing changes to the repository...\n";
@@ -136,32 +173,133 @@ private:
     std::vector<std::function<void()>> m_rollbackOperations;      ///< Operations to rollback
 };
 
+/**
+ * @brief Tracks registered entities and flushes them to the repository in batches.
+ *
+ * Registered entities are snapshotted on registration; at commit, entities
+ * whose fields never changed are skipped entirely (defensive registrations
+ * cost nothing), and the rest are grouped into batches of a configurable
+ * size flushed through the repository's bulk API.
+ */
 class UnitOfWork
 {
 public:
+    /**
+     * @brief Constructs the unit of work with a flush batch size.
+     * @param batchSize Maximum entities per bulk repository call.
+     */
+    explicit UnitOfWork(std::size_t batchSize = 100) : m_batchSize(batchSize) {}
+
     void registerRepository(std::shared_ptr<IRepository> repository)
     {
         m_repository = repository;
     }
 
+    /**
+     * @brief Registers a brand-new entity for insertion at commit.
+     */
+    void registerNew(const std::shared_ptr<Customer> &entity)
+    {
+        m_newEntities.push_back(entity);
+    }
+
+    /**
+     * @brief Registers a possibly-modified entity, snapshotting its fields.
+     *
+     * Safe to call defensively: entities whose fields still match the
+     * snapshot at commit time are skipped.
+     */
+    void registerDirty(const std::shared_ptr<Customer> &entity)
+    {
+        if (m_snapshots.find(entity->getId()) == m_snapshots.end())
+        {
+            m_snapshots[entity->getId()] = entity->getName();
+            m_trackedEntities.push_back(entity);
+        }
+    }
+
+    /**
+     * @brief Registers an entity for deletion at commit.
+     */
+    void registerRemoved(const std::shared_ptr<Customer> &entity)
+    {
+        m_removedEntities.push_back(entity);
+    }
+
+    /**
+     * @brief Flushes all pending work in batches, then commits the repository.
+     */
     void commit()
     {
+        std::size_t skipped = 0;
+        std::vector<std::shared_ptr<Customer>> dirty;
+        for (const auto &entity : m_trackedEntities)
+        {
+            if (entity->getName() != m_snapshots[entity->getId()])
+            {
+                dirty.push_back(entity);
+            }
+            else
+            {
+                ++skipped; // Unchanged since registration: no flush needed.
+            }
+        }
+        if (skipped > 0)
+        {
+            std::cout << "Dirty tracking: skipped " << skipped << " unchanged entit(ies)\n";
+        }
+
+        flushInBatches(m_newEntities, [this](const auto &batch) { m_repository->addBatch(batch); });
+        flushInBatches(dirty, [this](const auto &batch) { m_repository->updateBatch(batch); });
+        flushInBatches(m_removedEntities, [this](const auto &batch) { m_repository->removeBatch(batch); });
+
         m_repository->commit();
+        clear();
     }
 
     void rollback()
     {
         m_repository->rollback();
+        clear();
     }
 
 private:
+    /**
+     * @brief Slices pending entities into batches and flushes each through one bulk call.
+     */
+    template <typename Flush>
+    void flushInBatches(const std::vector<std::shared_ptr<Customer>> &entities, Flush flush)
+    {
+        for (std::size_t begin = 0; begin < entities.size(); begin += m_batchSize)
+        {
+            std::size_t end = std::min(begin + m_batchSize, entities.size());
+            flush(std::vector<std::shared_ptr<Customer>>(entities.begin() + begin, entities.begin() + end));
+        }
+    }
+
+    /**
+     * @brief Resets all registrations after a commit or rollback.
+     */
+    void clear()
+    {
+        m_newEntities.clear();
+        m_trackedEntities.clear();
+        m_removedEntities.clear();
+        m_snapshots.clear();
+    }
+
+    std::size_t m_batchSize;                                   ///< Entities per bulk call.
     std::shared_ptr<IRepository> m_repository;
+    std::vector<std::shared_ptr<Customer>> m_newEntities;      ///< Pending inserts.
+    std::vector<std::shared_ptr<Customer>> m_trackedEntities;  ///< Registered for update, maybe clean.
+    std::vector<std::shared_ptr<Customer>> m_removedEntities;  ///< Pending deletes.
+    std::unordered_map<int, std::string> m_snapshots;          ///< Field snapshots for dirty detection.
 };
 
 int main()
 {
-    // Create a Unit of Work
-    UnitOfWork unitOfWork;
+    // Create a Unit of Work flushing at most 2 entities per bulk call
+    UnitOfWork unitOfWork(2);
 
     // Create a repository
     auto repository = std::make_shared<CustomerRepository>();
@@ -172,16 +310,22 @@ int main()
     // Create some customers
     auto customer1 = std::make_shared<Customer>(1, "John Doe");
     auto customer2 = std::make_shared<Customer>(2, "Jane Smith");
+    auto customer3 = std::make_shared<Customer>(3, "Bob Brown");
+    auto customer4 = std::make_shared<Customer>(4, "Ann White");
+
+    // Register work against the unit of work instead of the repository directly
+    unitOfWork.registerNew(customer1);
+    unitOfWork.registerNew(customer2);
+    unitOfWork.registerNew(customer3);
+    unitOfWork.registerNew(customer4);
+    unitOfWork.commit(); // Inserts flushed as two batches of 2
 
-    // Add, update, and remove customers (simulating a set of operations)
-    repository->add(customer1);
-    repository->add(customer2);
+    unitOfWork.registerDirty(customer2); // Will actually change
+    unitOfWork.registerDirty(customer3); // Defensive registration: never modified
     customer2->setName("Jane Johnson");
-    repository->update(customer2);
-    repository->remove(customer1);
+    unitOfWork.registerRemoved(customer1);
 
-    // Now commit or rollback
-    // Simulate a successful commit
+    // Now commit: customer3 is skipped by dirty tracking
     unitOfWork.commit();
 
     // Simulate rolling back changes (uncomment to test rollback)
@@ -11,108 +11,310 @@
  * - Simplifies client-side interaction by providing a unified entry point.
  * - Reduces the complexity of handling multiple microservices.
  * - Centralizes authentication, rate-limiting, logging, etc.
+ *
+ * Routing is precompiled: registered paths are built once into a trie keyed by path
+ * segments, and per-request matching walks string_view slices of the incoming path with
+ * zero allocation and no string hashing. Every route carries atomic request counters and
+ * a log2 latency histogram, so hot routes are visible without a separate metrics pass.
+ */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <functional>
+#include <vector>
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Base class for all services. Defines the common interface for all microservices.
+ */
+class Service
+{
+public:
+    virtual ~Service() = default;
+
+    /**
+     * @brief Handles the service request.
+     * @param id The unique identifier for the resource.
+     * @return The result from the service.
+     */
+    virtual std::string handleRequest(int id) = 0;
+};
+
+/**
+ * @brief User service that handles user-related requests.
+ */
+class UserService : public Service
+{
+public:
+    /**
+     * @brief Fetch user details.
+     * @param userId The unique identifier for the user.
+     * @return The user details.
+     */
+    std::string handleRequest(int userId) override
+    {
+        return "User details for user " + std::to_string(userId);
+    }
+};
+
+/**
+ * @brief Product service that handles product-related requests.
+ */
+class ProductService : public Service
+{
+public:
+    /**
+     * @brief Fetch product details.
+     * @param productId The unique identifier for the product.
+     * @return The product details.
+     */
+    std::string handleRequest(int productId) override
+    {
+        return "Product details for product " + std::to_string(productId);
+    }
+};
+
+
+/**
+ * @brief Per-route counters: request count plus a log2 latency histogram.
+ *
+ * Updated with relaxed atomic increments on the request path; read whenever
+ * someone wants to see which routes are hot.
  */
+struct RouteStats
+{
+    static constexpr std::size_t BUCKET_COUNT = 8; ///< Buckets: <1us, <2us, <4us, ...
+
+    std::atomic<std::uint64_t> requests{0};
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> latencyBuckets{};
+
+    /**
+     * @brief Records one request and its latency.
+     */
+    void record(std::chrono::nanoseconds latency)
+    {
+        requests.fetch_add(1, std::memory_order_relaxed);
+        std::uint64_t micros = static_cast<std::uint64_t>(latency.count()) / 1000;
+        std::size_t bucket = 0;
+        while (micros > 0 && bucket + 1 < BUCKET_COUNT)
+        {
+            micros >>= 1;
+            ++bucket;
+        }
+        latencyBuckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Precompiled routing table: a segment trie matched with string_views.
+ *
+ * Routes are registered once at startup and compiled into a trie whose edges
+ * are path segments. Request-time matching slices the incoming path into
+ * string_view segments and walks the trie — no allocation, no hashing, no
+ * map lookup. Each terminal node owns the route's service and stats.
+ */
+class RouteTable
+{
+public:
+    struct Node;
+
+    /**
+     * @brief Registers a route; call only during setup, before routing starts.
+     * @param path Slash-separated route path, e.g. "/user/profile".
+     * @param service The service handling the route.
+     */
+    void registerRoute(std::string_view path, std::shared_ptr<Service> service)
+    {
+        Node* node = &m_root;
+        forEachSegment(path, [&node](std::string_view segment)
+        {
+            for (auto& child : node->children)
+            {
+                if (child.label == segment)
+                {
+                    node = child.node.get();
+                    return;
+                }
+            }
+            node->children.push_back(Edge{std::string(segment), std::make_unique<Node>()});
+            node = node->children.back().node.get();
+        });
+        node->service = std::move(service);
+        node->stats = std::make_unique<RouteStats>();
+        node->path = std::string(path);
+    }
+
+    /**
+     * @brief Matches a request path; zero allocation on this path.
+     * @param path The incoming request path.
+     * @return The matched node, or nullptr if no route matches.
+     */
+    const Node* match(std::string_view path) const; // Defined below Node for clarity.
+
+    /**
+     * @brief Trie node: children edges plus, for terminals, the route payload.
+     */
+    struct Node
+    {
+        struct Edge
+        {
+            std::string label;          ///< Owned segment text (set at registration).
+            std::unique_ptr<Node> node;
+        };
+        std::vector<Edge> children;     ///< Few per node; scanned linearly without hashing.
+        std::shared_ptr<Service> service; ///< Set on terminal nodes only.
+        std::unique_ptr<RouteStats> stats;
+        std::string path;               ///< Full route path, for reporting.
+    };
+    using Edge = Node::Edge;
+
+    /**
+     * @brief Prints the per-route counters and latency histograms.
+     */
+    void printStats() const
+    {
+        printStats(m_root);
+    }
+
+private:
+    /**
+     * @brief Applies fn to every non-empty slash-separated segment of path.
+     */
+    template <typename Fn>
+    static void forEachSegment(std::string_view path, Fn fn)
+    {
+        while (!path.empty())
+        {
+            if (path.front() == '/')
+            {
+                path.remove_prefix(1);
+                continue;
+            }
+            std::size_t end = path.find('/');
+            fn(path.substr(0, end));
+            path.remove_prefix(end == std::string_view::npos ? path.size() : end);
+        }
+    }
+
+    void printStats(const Node& node) const
+    {
+        if (node.stats)
+        {
+            std::cout << "  " << node.path << ": " << node.stats->requests.load() << " request(s), latency";
+            for (std::size_t i = 0; i < RouteStats::BUCKET_COUNT; ++i)
+            {
+                std::cout << " [" << (1u << i) << "us:" << node.stats->latencyBuckets[i].load() << "]";
+            }
+            std::cout << "\n";
+        }
+        for (const auto& child : node.children)
+        {
+            printStats(*child.node);
+        }
+    }
+
+    Node m_root;
+
+    friend class ApiGateway;
+};
+
+inline const RouteTable::Node* RouteTable::match(std::string_view path) const
+{
+    const Node* node = &m_root;
+    bool matched = true;
+    forEachSegment(path, [&node, &matched](std::string_view segment)
+    {
+        if (!matched)
+        {
+            return;
+        }
+        for (const auto& child : node->children)
+        {
+            if (child.label == segment)
+            {
+                node = child.node.get();
+                return;
+            }
+        }
+        matched = false;
+    });
+    return (matched && node->service) ? node : nullptr;
+}
+
+/**
+ * @brief The API Gateway class that routes requests to the appropriate microservices.
+ */
+class ApiGateway
+{
+public:
+    ApiGateway()
+    {
+        // Register routes once; the trie is the compiled routing table.
+        m_routes.registerRoute("/user", std::make_shared<UserService>());
+        m_routes.registerRoute("/product", std::make_shared<ProductService>());
+    }
+
+    /**
+     * @brief Handles the incoming API requests and routes them to the appropriate microservice.
+     *
+     * The path is matched against the precompiled segment trie with
+     * string_view slices — no allocation or hashing per request — and the
+     * matched route's counters are updated inline.
+     *
+     * @param path The request path (e.g. "/user").
+     * @param id The ID parameter to pass to the service.
+     * @return The result from the service.
+     */
+    std::string handleRequest(std::string_view path, int id)
+    {
+        auto start = std::chrono::steady_clock::now();
+        const RouteTable::Node* route = m_routes.match(path);
+        if (!route)
+        {
+            return "Service not found";
+        }
+        std::string result = route->service->handleRequest(id);
+        route->stats->record(std::chrono::steady_clock::now() - start);
+        return result;
+    }
+
+    /**
+     * @brief Prints per-route request counters and latency histograms.
+     */
+    void printRouteStats() const
+    {
+        std::cout << "Route stats:\n";
+        m_routes.printStats();
+    }
+
+private:
+    RouteTable m_routes; ///< Precompiled segment trie with per-route stats.
+};
+
+/**
+ * @brief Demonstrates the API Gateway pattern by routing requests to various microservices.
+ */
+int main()
+{
+    auto apiGateway = std::make_shared<ApiGateway>();
+
+    // Simulate requests
+    std::cout << "API Gateway: " << apiGateway->handleRequest("/user", 101) << std::endl;
+    std::cout << "API Gateway: " << apiGateway->handleRequest("/product", 202) << std::endl;
+    std::cout << "API Gateway: " << apiGateway->handleRequest("/order", 303) << std::endl; // Invalid route
+
+    // Hot-route visibility comes straight from the routing table.
+    for (int i = 0; i < 1000; ++i)
+    {
+        apiGateway->handleRequest("/user", i);
+    }
+    apiGateway->printRouteStats();
 
- #include <iostream>
- #include <memory>
- #include <string>
- #include <unordered_map>
- #include <functional>
- 
- /**
-  * @brief Base class for all services. Defines the common interface for all microservices.
-  */
- class Service
- {
- public:
-     virtual ~Service() = default;
- 
-     /**
-      * @brief Handles the service request.
-      * @param id The unique identifier for the resource.
-      * @return The result from the service.
-      */
-     virtual std::string handleRequest(int id) = 0;
- };
- 
- /**
-  * @brief User service that handles user-related requests.
-  */
- class UserService : public Service
- {
- public:
-     /**
-      * @brief Fetch user details.
-      * @param userId The unique identifier for the user.
-      * @return The user details.
-      */
-     std::string handleRequest(int userId) override
-     {
-         return "User details for user " + std::to_string(userId);
-     }
- };
- 
- /**
-  * @brief Product service that handles product-related requests.
-  */
- class ProductService : public Service
- {
- public:
-     /**
-      * @brief Fetch product details.
-      * @param productId The unique identifier for the product.
-      * @return The product details.
-      */
-     std::string handleRequest(int productId) override
-     {
-         return "Product details for product " + std::to_string(productId);
-     }
- };
- 
- /**
-  * @brief The API Gateway class that routes requests to the appropriate microservices.
-  */
- class ApiGateway
- {
- public:
-     ApiGateway()
-     {
-         // Register services
-         m_services["user"] = std::make_shared<UserService>();
-         m_services["product"] = std::make_shared<ProductService>();
-     }
- 
-     /**
-      * @brief Handles the incoming API requests and routes them to the appropriate microservice.
-      * @param service The service to call ("user" or "product").
-      * @param id The ID parameter to pass to the service.
-      * @return The result from the service.
-      */
-     std::string handleRequest(const std::string& service, int id)
-     {
-         if (m_services.find(service) != m_services.end())
-         {
-             return m_services[service]->handleRequest(id);
-         }
-         return "Service not found";
-     }
- 
- private:
-     std::unordered_map<std::string, std::shared_ptr<Service>> m_services; ///< Map of service names to service instances.
- };
- 
- /**
-  * @brief Demonstrates the API Gateway pattern by routing requests to various microservices.
-  */
- int main()
- {
-     auto apiGateway = std::make_shared<ApiGateway>();
- 
-     // Simulate requests
-     std::cout << "API Gateway: " << apiGateway->handleRequest("user", 101) << std::endl;
-     std::cout << "API Gateway: " << apiGateway->handleRequest("product", 202) << std::endl;
-     std::cout << "API Gateway: " << apiGateway->handleRequest("order", 303) << std::endl; // Invalid service
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
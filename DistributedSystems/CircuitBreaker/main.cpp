@@ -11,134 +11,422 @@
  * - Improves system stability by avoiding repeated failures.
  * - Allows fallback mechanisms or retries.
  * - Helps prevent cascading failures in distributed systems.
+ *
+ * Beyond the classic consecutive-failure breaker, this example includes a sliding-window
+ * breaker that reacts to failure *rate* and slow-call rate over a ring of per-interval
+ * atomic counters, and recovers through adaptive half-open probing that ramps traffic
+ * gradually. Per-call bookkeeping is a handful of atomic increments — no mutex.
+ */
+
+#include <iostream>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <array>
+#include <cstdint>
+
+class CircuitBreaker
+{
+public:
+    /**
+     * @brief Constructs a circuit breaker with a given failure threshold and timeout.
+     * @param failureThreshold The number of consecutive failures before opening the circuit.
+     * @param timeoutSeconds The time (in seconds) to wait before attempting to reset the circuit after it has opened.
+     */
+    CircuitBreaker(int failureThreshold, int timeoutSeconds)
+        : m_failureThreshold(failureThreshold), m_timeoutSeconds(timeoutSeconds), m_failureCount(0), m_circuitOpen(false)
+    {}
+
+    /**
+     * @brief Attempts to execute an operation. If the circuit is open or failures exceed the threshold, it will prevent execution.
+     * @param operation The operation to execute, represented as a callable (e.g., function, lambda).
+     * @return `true` if the operation is successfully executed, `false` otherwise.
+     */
+    bool execute(std::function<bool()> operation)
+    {
+        if (m_circuitOpen)
+        {
+            std::cout << "Circuit is open. Operation will not be executed.\n";
+            return false;
+        }
+
+        bool success = operation();
+        
+        if (!success)
+        {
+            m_failureCount++;
+            std::cout << "Operation failed. Failure count: " << m_failureCount << "/" << m_failureThreshold << "\n";
+            
+            if (m_failureCount >= m_failureThreshold)
+            {
+                openCircuit();
+            }
+        }
+        else
+        {
+            m_failureCount = 0;  // Reset failure count on success.
+        }
+
+        return success;
+    }
+
+    /**
+     * @brief Resets the circuit after the timeout period if the circuit is open.
+     */
+    void resetCircuit()
+    {
+        if (m_circuitOpen)
+        {
+            std::cout << "Circuit is open, waiting for reset...\n";
+            std::this_thread::sleep_for(std::chrono::seconds(m_timeoutSeconds));
+            std::cout << "Resetting circuit...\n";
+            m_circuitOpen = false;
+            m_failureCount = 0;  // Reset failure count after resetting the circuit.
+        }
+    }
+
+private:
+    int m_failureThreshold; ///< The number of consecutive failures before the circuit is opened.
+    int m_timeoutSeconds;   ///< The timeout period before attempting to reset the circuit.
+    int m_failureCount;     ///< The current count of consecutive failures.
+    bool m_circuitOpen;     ///< A flag indicating if the circuit is open (i.e., no more attempts allowed).
+    
+    /**
+     * @brief Opens the circuit, preventing further operation attempts until reset.
+     */
+    void openCircuit()
+    {
+        std::cout << "Circuit opened due to failure threshold reached.\n";
+        m_circuitOpen = true;
+    }
+};
+
+
+/**
+ * @brief Rate-based circuit breaker over a lock-free sliding window.
+ *
+ * Outcomes are recorded into a ring of per-interval buckets holding atomic
+ * success/failure/slow-call counters; a bucket is lazily recycled (CAS on its
+ * interval stamp) when time moves past it, so the window slides without any
+ * lock or maintenance thread. The circuit opens when the failure rate or the
+ * slow-call rate over the window crosses its threshold. Recovery is gradual:
+ * in half-open state only a fraction of calls is admitted as probes, and each
+ * streak of successful probes doubles the admitted fraction until the circuit
+ * closes; one failed probe reopens it.
+ */
+class SlidingWindowCircuitBreaker
+{
+public:
+    /**
+     * @brief Constructs the breaker.
+     * @param failureRateThreshold Open when failures/calls over the window exceeds this.
+     * @param slowCallRateThreshold Open when slow calls/calls exceeds this.
+     * @param slowCallMillis A call at or above this latency counts as slow.
+     * @param openCooldown How long the circuit stays open before probing.
+     * @param minimumCalls No decision is made below this many calls in the window.
+     */
+    SlidingWindowCircuitBreaker(double failureRateThreshold,
+                                double slowCallRateThreshold,
+                                std::uint32_t slowCallMillis,
+                                std::chrono::milliseconds openCooldown,
+                                std::uint32_t minimumCalls = 10)
+        : m_failureRateThreshold(failureRateThreshold),
+          m_slowCallRateThreshold(slowCallRateThreshold),
+          m_slowCallMillis(slowCallMillis),
+          m_openCooldown(openCooldown),
+          m_minimumCalls(minimumCalls)
+    {}
+
+    /**
+     * @brief Executes the operation if the breaker admits the call.
+     * @param operation Callable returning success/failure.
+     * @return true when the call ran and succeeded.
+     */
+    bool execute(const std::function<bool()>& operation)
+    {
+        if (!admit())
+        {
+            return false; // Shed without running the operation.
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        bool success = operation();
+        auto latency = static_cast<std::uint32_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+
+        record(success, latency);
+        return success;
+    }
+
+    /**
+     * @brief Current state name, for observability.
+     */
+    const char* stateName() const
+    {
+        switch (m_state.load(std::memory_order_acquire))
+        {
+            case State::Closed:   return "closed";
+            case State::Open:     return "open";
+            case State::HalfOpen: return "half-open";
+        }
+        return "?";
+    }
+
+private:
+    static constexpr std::size_t BUCKET_COUNT = 8;   ///< Ring size.
+    static constexpr std::uint32_t INTERVAL_MS = 100; ///< Width of one bucket.
+    static constexpr std::uint32_t MAX_PROBE_SHIFT = 3; ///< Start by admitting 1/8 of calls.
+
+    enum class State : std::uint8_t { Closed, Open, HalfOpen };
+
+    /**
+     * @brief Per-interval counters; recycled in place as the window slides.
+     */
+    struct Bucket
+    {
+        std::atomic<std::uint64_t> interval{0}; ///< Which interval these counts belong to.
+        std::atomic<std::uint32_t> successes{0};
+        std::atomic<std::uint32_t> failures{0};
+        std::atomic<std::uint32_t> slowCalls{0};
+    };
+
+    /**
+     * @brief Decides whether this call may run, handling state transitions.
+     */
+    bool admit()
+    {
+        State state = m_state.load(std::memory_order_acquire);
+        if (state == State::Closed)
+        {
+            return true;
+        }
+        if (state == State::Open)
+        {
+            auto now = std::chrono::steady_clock::now().time_since_epoch();
+            if (now - std::chrono::steady_clock::duration(m_openedAt.load(std::memory_order_acquire)) < m_openCooldown)
+            {
+                return false;
+            }
+            State expected = State::Open; // Cooldown elapsed: start probing.
+            if (m_state.compare_exchange_strong(expected, State::HalfOpen))
+            {
+                m_probeShift.store(MAX_PROBE_SHIFT, std::memory_order_release);
+                m_probeSuccesses.store(0, std::memory_order_release);
+            }
+        }
+
+        // Half-open: admit 1 of every 2^shift calls as a probe.
+        std::uint32_t shift = m_probeShift.load(std::memory_order_acquire);
+        std::uint64_t ticket = m_probeTicket.fetch_add(1, std::memory_order_relaxed);
+        return (ticket & ((1u << shift) - 1)) == 0;
+    }
+
+    /**
+     * @brief Per-call bookkeeping: a few atomic increments, never a mutex.
+     */
+    void record(bool success, std::uint32_t latencyMillis)
+    {
+        Bucket& bucket = currentBucket();
+        if (success)
+        {
+            bucket.successes.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            bucket.failures.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (latencyMillis >= m_slowCallMillis)
+        {
+            bucket.slowCalls.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        State state = m_state.load(std::memory_order_acquire);
+        if (state == State::HalfOpen)
+        {
+            onProbeResult(success);
+        }
+        else if (state == State::Closed)
+        {
+            evaluateWindow();
+        }
+    }
+
+    /**
+     * @brief Finds (and if stale, recycles) the bucket for the current interval.
+     */
+    Bucket& currentBucket()
+    {
+        std::uint64_t interval = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count()) / INTERVAL_MS;
+        Bucket& bucket = m_buckets[interval % BUCKET_COUNT];
+        std::uint64_t stamped = bucket.interval.load(std::memory_order_acquire);
+        if (stamped != interval &&
+            bucket.interval.compare_exchange_strong(stamped, interval)) // One winner resets.
+        {
+            bucket.successes.store(0, std::memory_order_relaxed);
+            bucket.failures.store(0, std::memory_order_relaxed);
+            bucket.slowCalls.store(0, std::memory_order_relaxed);
+        }
+        return bucket;
+    }
+
+    /**
+     * @brief Opens the circuit when a windowed rate crosses its threshold.
+     */
+    void evaluateWindow()
+    {
+        std::uint64_t currentInterval = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count()) / INTERVAL_MS;
+
+        std::uint32_t successes = 0, failures = 0, slowCalls = 0;
+        for (const Bucket& bucket : m_buckets)
+        {
+            std::uint64_t stamped = bucket.interval.load(std::memory_order_acquire);
+            if (currentInterval - stamped < BUCKET_COUNT) // Still inside the window.
+            {
+                successes += bucket.successes.load(std::memory_order_relaxed);
+                failures += bucket.failures.load(std::memory_order_relaxed);
+                slowCalls += bucket.slowCalls.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::uint32_t total = successes + failures;
+        if (total < m_minimumCalls)
+        {
+            return;
+        }
+        double failureRate = static_cast<double>(failures) / total;
+        double slowRate = static_cast<double>(slowCalls) / total;
+        if (failureRate >= m_failureRateThreshold || slowRate >= m_slowCallRateThreshold)
+        {
+            State expected = State::Closed;
+            if (m_state.compare_exchange_strong(expected, State::Open))
+            {
+                m_openedAt.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                                 std::memory_order_release);
+                std::cout << "[breaker] opened (failure rate " << failureRate
+                          << ", slow rate " << slowRate << ")\n";
+            }
+        }
+    }
+
+    /**
+     * @brief Adaptive probing: successes widen the admitted fraction, a failure reopens.
+     */
+    void onProbeResult(bool success)
+    {
+        if (!success)
+        {
+            State expected = State::HalfOpen;
+            if (m_state.compare_exchange_strong(expected, State::Open))
+            {
+                m_openedAt.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                                 std::memory_order_release);
+                std::cout << "[breaker] probe failed, reopening\n";
+            }
+            return;
+        }
+
+        std::uint32_t streak = m_probeSuccesses.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (streak % PROBES_PER_RAMP == 0)
+        {
+            std::uint32_t shift = m_probeShift.load(std::memory_order_acquire);
+            if (shift > 0)
+            {
+                m_probeShift.store(shift - 1, std::memory_order_release); // Double admitted traffic.
+                std::cout << "[breaker] ramping probes to 1/" << (1u << (shift - 1)) << " of calls\n";
+            }
+            else
+            {
+                State expected = State::HalfOpen;
+                if (m_state.compare_exchange_strong(expected, State::Closed))
+                {
+                    std::cout << "[breaker] closed after successful ramp\n";
+                }
+            }
+        }
+    }
+
+    static constexpr std::uint32_t PROBES_PER_RAMP = 2; ///< Successful probes per ramp step.
+
+    double m_failureRateThreshold;
+    double m_slowCallRateThreshold;
+    std::uint32_t m_slowCallMillis;
+    std::chrono::milliseconds m_openCooldown;
+    std::uint32_t m_minimumCalls;
+
+    std::array<Bucket, BUCKET_COUNT> m_buckets;            ///< Sliding-window ring.
+    std::atomic<State> m_state{State::Closed};
+    std::atomic<std::chrono::steady_clock::rep> m_openedAt{0};
+    std::atomic<std::uint32_t> m_probeShift{MAX_PROBE_SHIFT}; ///< Admit 1/2^shift in half-open.
+    std::atomic<std::uint64_t> m_probeTicket{0};
+    std::atomic<std::uint32_t> m_probeSuccesses{0};
+};
+
+/**
+ * @brief Simulates an operation that may fail intermittently.
+ * @return `true` for success, `false` for failure.
+ */
+bool riskyOperation()
+{
+    static int attempt = 0;
+    attempt++;
+    if (attempt % 6 == 0)
+    {
+        std::cout << "Operation succeeded.\n";
+        return true;
+    }
+    else
+    {
+        std::cout << "Operation failed.\n";
+        return false;
+    }
+}
+
+/**
+ * @brief Demonstrates the usage of the Circuit Breaker pattern.
  */
+int main()
+{
+    // Create a circuit breaker that opens after 3 consecutive failures and has a 5-second timeout before resetting.
+    auto circuitBreaker = std::make_shared<CircuitBreaker>(3, 5);
+
+    // Try to execute the risky operation multiple times
+    for (int i = 0; i < 10; ++i)
+    {
+        if (!circuitBreaker->execute(riskyOperation))
+        {
+            std::cout << "Retrying...\n";
+        }
+
+        // If the circuit is open, wait before retrying.
+        if (i % 5 == 0)
+        {
+            circuitBreaker->resetCircuit();
+        }
+    }
+
+    // Rate-based breaker: opens on windowed failure rate, recovers by ramping probes.
+    SlidingWindowCircuitBreaker rateBreaker(0.5, 0.5, 50, std::chrono::milliseconds(200));
+
+    std::cout << "\nPhase 1: unhealthy service (80% failures)\n";
+    for (int i = 0; i < 30; ++i)
+    {
+        rateBreaker.execute([i] { return i % 5 == 0; });
+    }
+    std::cout << "State: " << rateBreaker.stateName() << "\n";
+
+    std::cout << "Phase 2: service recovered; probes ramp traffic back\n";
+    std::this_thread::sleep_for(std::chrono::milliseconds(250)); // Let the cooldown elapse.
+    for (int i = 0; i < 60; ++i)
+    {
+        rateBreaker.execute([] { return true; });
+    }
+    std::cout << "State: " << rateBreaker.stateName() << "\n";
 
- #include <iostream>
- #include <memory>
- #include <chrono>
- #include <thread>
- #include <atomic>
- #include <functional>
- 
- class CircuitBreaker
- {
- public:
-     /**
-      * @brief Constructs a circuit breaker with a given failure threshold and timeout.
-      * @param failureThreshold The number of consecutive failures before opening the circuit.
-      * @param timeoutSeconds The time (in seconds) to wait before attempting to reset the circuit after it has opened.
-      */
-     CircuitBreaker(int failureThreshold, int timeoutSeconds)
-         : m_failureThreshold(failureThreshold), m_timeoutSeconds(timeoutSeconds), m_failureCount(0), m_circuitOpen(false)
-     {}
- 
-     /**
-      * @brief Attempts to execute an operation. If the circuit is open or failures exceed the threshold, it will prevent execution.
-      * @param operation The operation to execute, represented as a callable (e.g., function, lambda).
-      * @return `true` if the operation is successfully executed, `false` otherwise.
-      */
-     bool execute(std::function<bool()> operation)
-     {
-         if (m_circuitOpen)
-         {
-             std::cout << "Circuit is open. Operation will not be executed.\n";
-             return false;
-         }
- 
-         bool success = operation();
-         
-         if (!success)
-         {
-             m_failureCount++;
-             std::cout << "Operation failed. Failure count: " << m_failureCount << "/" << m_failureThreshold << "\n";
-             
-             if (m_failureCount >= m_failureThreshold)
-             {
-                 openCircuit();
-             }
-         }
-         else
-         {
-             m_failureCount = 0;  // Reset failure count on success.
-         }
- 
-         return success;
-     }
- 
-     /**
-      * @brief Resets the circuit after the timeout period if the circuit is open.
-      */
-     void resetCircuit()
-     {
-         if (m_circuitOpen)
-         {
-             std::cout << "Circuit is open, waiting for reset...\n";
-             std::this_thread::sleep_for(std::chrono::seconds(m_timeoutSeconds));
-             std::cout << "Resetting circuit...\n";
-             m_circuitOpen = false;
-             m_failureCount = 0;  // Reset failure count after resetting the circuit.
-         }
-     }
- 
- private:
-     int m_failureThreshold; ///< The number of consecutive failures before the circuit is opened.
-     int m_timeoutSeconds;   ///< The timeout period before attempting to reset the circuit.
-     int m_failureCount;     ///< The current count of consecutive failures.
-     bool m_circuitOpen;     ///< A flag indicating if the circuit is open (i.e., no more attempts allowed).
-     
-     /**
-      * @brief Opens the circuit, preventing further operation attempts until reset.
-      */
-     void openCircuit()
-     {
-         std::cout << "Circuit opened due to failure threshold reached.\n";
-         m_circuitOpen = true;
-     }
- };
- 
- /**
-  * @brief Simulates an operation that may fail intermittently.
-  * @return `true` for success, `false` for failure.
-  */
- bool riskyOperation()
- {
-     static int attempt = 0;
-     attempt++;
-     if (attempt % 6 == 0)
-     {
-         std::cout << "Operation succeeded.\n";
-         return true;
-     }
-     else
-     {
-         std::cout << "Operation failed.\n";
-         return false;
-     }
- }
- 
- /**
-  * @brief Demonstrates the usage of the Circuit Breaker pattern.
-  */
- int main()
- {
-     // Create a circuit breaker that opens after 3 consecutive failures and has a 5-second timeout before resetting.
-     auto circuitBreaker = std::make_shared<CircuitBreaker>(3, 5);
- 
-     // Try to execute the risky operation multiple times
-     for (int i = 0; i < 10; ++i)
-     {
-         if (!circuitBreaker->execute(riskyOperation))
-         {
-             std::cout << "Retrying...\n";
-         }
- 
-         // If the circuit is open, wait before retrying.
-         if (i % 5 == 0)
-         {
-             circuitBreaker->resetCircuit();
-         }
-     }
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
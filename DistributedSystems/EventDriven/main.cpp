@@ -11,150 +11,397 @@
  * - Promotes asynchronous communication between components.
  * - Components can be added or modified independently, improving scalability and maintainability.
  * - Enables real-time processing of events, such as in message queues, real-time analytics, or notifications.
+ *
+ * The synchronous EventPublisher stalls every publisher behind its slowest listener, so an
+ * asynchronous bus is included as well: subscribers register per topic, each owns a bounded
+ * queue drained in batches by a small worker pool, events are moved (not copied) into the
+ * queues, and listeners that can amortize receive whole batches through onEvents().
+ */
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <string>
+#include <span>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <unordered_map>
+
+/**
+ * @brief Event class represents an event in the system.
+ *        This serves as a base class for specific event types.
+ */
+class Event
+{
+public:
+    virtual ~Event() = default;
+
+    /**
+     * @brief Retrieves the type of event.
+     * @return A string representing the event type.
+     */
+    virtual std::string getEventType() const = 0;
+};
+
+/**
+ * @brief A specific event that occurs when a user logs in.
+ */
+class UserLoginEvent : public Event
+{
+public:
+    /**
+     * @brief Constructor for UserLoginEvent.
+     * @param username The username of the user who logged in.
+     */
+    UserLoginEvent(const std::string& username)
+        : m_username(username)
+    {
+    }
+
+    /**
+     * @brief Retrieves the event type.
+     * @return A string representing the event type.
+     */
+    std::string getEventType() const override
+    {
+        return "UserLoginEvent";
+    }
+
+    /**
+     * @brief Retrieves the username.
+     * @return The username of the logged-in user.
+     */
+    std::string getUsername() const
+    {
+        return m_username;
+    }
+
+private:
+    std::string m_username; ///< The username of the user who logged in.
+};
+
+/**
+ * @brief A listener that reacts to events.
+ */
+class EventListener
+{
+public:
+    virtual ~EventListener() = default;
+
+    /**
+     * @brief Handles an event when it occurs.
+     * @param event The event to handle.
+     */
+    virtual void onEvent(const std::shared_ptr<Event>& event) = 0;
+
+    /**
+     * @brief Handles a whole batch at once; override to amortize per-event cost.
+     * @param events The batch, in publication order.
+     */
+    virtual void onEvents(std::span<const std::shared_ptr<Event>> events)
+    {
+        for (const auto& event : events)
+        {
+            onEvent(event);
+        }
+    }
+};
+
+/**
+ * @brief A specific listener that reacts to user login events.
+ */
+class UserLoginListener : public EventListener
+{
+public:
+    /**
+     * @brief Handles a user login event.
+     * @param event The event to handle.
+     */
+    void onEvent(const std::shared_ptr<Event>& event) override
+    {
+        // Check if the event is a UserLoginEvent.
+        auto loginEvent = std::dynamic_pointer_cast<UserLoginEvent>(event);
+        if (loginEvent)
+        {
+            std::cout << "User logged in: " << loginEvent->getUsername() << std::endl;
+        }
+    }
+};
+
+/**
+ * @brief EventPublisher publishes events to listeners.
  */
+class EventPublisher
+{
+public:
+    /**
+     * @brief Adds a listener to the list of listeners.
+     * @param listener The listener to add.
+     */
+    void addListener(const std::shared_ptr<EventListener>& listener)
+    {
+        m_listeners.push_back(listener);
+    }
+
+    /**
+     * @brief Publishes an event to all listeners.
+     * @param event The event to publish.
+     */
+    void publishEvent(const std::shared_ptr<Event>& event)
+    {
+        for (const auto& listener : m_listeners)
+        {
+            listener->onEvent(event);
+        }
+    }
+
+private:
+    std::vector<std::shared_ptr<EventListener>> m_listeners; ///< List of listeners to notify.
+};
+
+
+/**
+ * @brief Asynchronous, topic-routed event bus with per-subscriber queues.
+ *
+ * publishEvent() only moves the event into the bounded queue of each
+ * subscriber of the topic and returns — listener cost never touches the
+ * publisher. A small worker pool drains subscriber queues: a drain swaps the
+ * whole pending queue out under the subscriber's lock and delivers it as one
+ * onEvents() batch, so slow listeners fall behind on their own queue (events
+ * beyond the bound are dropped and counted) without stalling anyone else.
+ */
+class AsyncEventBus
+{
+public:
+    /**
+     * @brief Starts the bus with a pool of worker threads.
+     * @param workerCount Threads draining subscriber queues.
+     * @param queueCapacity Bound of each subscriber's pending queue.
+     */
+    explicit AsyncEventBus(std::size_t workerCount = 2, std::size_t queueCapacity = 1024)
+        : m_queueCapacity(queueCapacity)
+    {
+        for (std::size_t i = 0; i < workerCount; ++i)
+        {
+            m_workers.emplace_back(&AsyncEventBus::workerLoop, this);
+        }
+    }
+
+    ~AsyncEventBus()
+    {
+        waitForIdle();
+        {
+            std::lock_guard lock(m_readyMutex);
+            m_running = false;
+        }
+        m_readyWake.notify_all();
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief Subscribes a listener to one topic.
+     */
+    void subscribe(const std::string& topic, std::shared_ptr<EventListener> listener)
+    {
+        auto subscription = std::make_shared<Subscription>();
+        subscription->listener = std::move(listener);
+        std::lock_guard lock(m_topicsMutex);
+        m_topics[topic].push_back(std::move(subscription));
+    }
+
+    /**
+     * @brief Publishes an event to a topic; returns as soon as it is queued.
+     *
+     * The event is moved into the last subscriber's queue; earlier
+     * subscribers share ownership via a pointer copy (no event copy).
+     */
+    void publishEvent(const std::string& topic, std::shared_ptr<Event> event)
+    {
+        std::vector<std::shared_ptr<Subscription>>* subscriptions;
+        {
+            std::lock_guard lock(m_topicsMutex);
+            auto it = m_topics.find(topic);
+            if (it == m_topics.end())
+            {
+                return;
+            }
+            subscriptions = &it->second;
+        }
+
+        for (std::size_t i = 0; i < subscriptions->size(); ++i)
+        {
+            bool last = (i + 1 == subscriptions->size());
+            enqueue(*(*subscriptions)[i], last ? std::move(event) : event);
+        }
+    }
+
+    /**
+     * @brief Events dropped because a subscriber's queue was full.
+     */
+    std::size_t droppedCount() const { return m_dropped.load(); }
+
+    /**
+     * @brief Blocks until every queued event has been delivered.
+     */
+    void waitForIdle()
+    {
+        while (m_pending.load(std::memory_order_acquire) != 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+private:
+    /**
+     * @brief One subscriber plus its bounded pending queue.
+     */
+    struct Subscription
+    {
+        std::shared_ptr<EventListener> listener;
+        std::mutex mutex;
+        std::vector<std::shared_ptr<Event>> pending; ///< Swapped out wholesale per drain.
+        bool scheduled{false};                       ///< Already in the ready queue?
+    };
+
+    /**
+     * @brief Moves an event into a subscriber's queue and schedules a drain.
+     */
+    void enqueue(Subscription& subscription, std::shared_ptr<Event> event)
+    {
+        bool schedule = false;
+        {
+            std::lock_guard lock(subscription.mutex);
+            if (subscription.pending.size() >= m_queueCapacity)
+            {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return; // Backpressure policy: shed on this subscriber only.
+            }
+            subscription.pending.push_back(std::move(event));
+            if (!subscription.scheduled)
+            {
+                subscription.scheduled = true;
+                schedule = true;
+            }
+        }
+        m_pending.fetch_add(1, std::memory_order_release);
+        if (schedule)
+        {
+            std::lock_guard lock(m_readyMutex);
+            m_ready.push_back(&subscription);
+            m_readyWake.notify_one();
+        }
+    }
+
+    /**
+     * @brief Worker: pop a subscriber, deliver its whole backlog as one batch.
+     */
+    void workerLoop()
+    {
+        for (;;)
+        {
+            Subscription* subscription;
+            {
+                std::unique_lock lock(m_readyMutex);
+                m_readyWake.wait(lock, [this] { return !m_ready.empty() || !m_running; });
+                if (!m_running && m_ready.empty())
+                {
+                    return;
+                }
+                subscription = m_ready.front();
+                m_ready.pop_front();
+            }
+
+            std::vector<std::shared_ptr<Event>> batch;
+            {
+                std::lock_guard lock(subscription->mutex);
+                batch.swap(subscription->pending);
+                subscription->scheduled = false;
+            }
+            if (!batch.empty())
+            {
+                subscription->listener->onEvents(batch); // One delivery for the whole backlog.
+                m_pending.fetch_sub(batch.size(), std::memory_order_release);
+            }
+        }
+    }
+
+    std::size_t m_queueCapacity;
+    std::mutex m_topicsMutex;
+    std::unordered_map<std::string, std::vector<std::shared_ptr<Subscription>>> m_topics;
+
+    std::mutex m_readyMutex;
+    std::condition_variable m_readyWake;
+    std::deque<Subscription*> m_ready;     ///< Subscribers with undrained events.
+    std::vector<std::thread> m_workers;
+    bool m_running{true};                  ///< Guarded by m_readyMutex.
+    std::atomic<std::size_t> m_pending{0}; ///< Queued but undelivered events.
+    std::atomic<std::size_t> m_dropped{0};
+};
+
+/**
+ * @brief A listener that amortizes work across whole batches of events.
+ */
+class BatchAuditListener : public EventListener
+{
+public:
+    void onEvent(const std::shared_ptr<Event>& event) override
+    {
+        onEvents(std::span<const std::shared_ptr<Event>>(&event, 1));
+    }
+
+    void onEvents(std::span<const std::shared_ptr<Event>> events) override
+    {
+        m_total += events.size();
+        std::cout << "[audit] received batch of " << events.size()
+                  << " event(s), total " << m_total << "\n";
+    }
+
+private:
+    std::size_t m_total{0};
+};
+
+/**
+ * @brief Demonstrates an event-driven system with an event publisher, event listener, and event handling.
+ */
+int main()
+{
+    // Create an event publisher and a listener.
+    EventPublisher eventPublisher;
+    auto userLoginListener = std::make_shared<UserLoginListener>();
+    eventPublisher.addListener(userLoginListener);
+
+    // Create a user login event.
+    auto loginEvent = std::make_shared<UserLoginEvent>("john_doe");
+
+    // Publish the event, triggering the listener to handle it.
+    eventPublisher.publishEvent(loginEvent);
+
+    // Asynchronous bus: publishers finish in queue-insert time, listeners run on workers.
+    {
+        AsyncEventBus bus(2, 256);
+        bus.subscribe("user.login", std::make_shared<UserLoginListener>());
+        bus.subscribe("user.login", std::make_shared<BatchAuditListener>());
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 5; ++i)
+        {
+            bus.publishEvent("user.login", std::make_shared<UserLoginEvent>("user_" + std::to_string(i)));
+        }
+        auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        std::cout << "Published 5 events in " << nanos / 5 << " ns each (listener cost excluded)\n";
+
+        bus.waitForIdle();
+        std::cout << "Dropped: " << bus.droppedCount() << "\n";
+    }
 
- #include <iostream>
- #include <vector>
- #include <memory>
- #include <functional>
- #include <string>
- 
- /**
-  * @brief Event class represents an event in the system.
-  *        This serves as a base class for specific event types.
-  */
- class Event
- {
- public:
-     virtual ~Event() = default;
- 
-     /**
-      * @brief Retrieves the type of event.
-      * @return A string representing the event type.
-      */
-     virtual std::string getEventType() const = 0;
- };
- 
- /**
-  * @brief A specific event that occurs when a user logs in.
-  */
- class UserLoginEvent : public Event
- {
- public:
-     /**
-      * @brief Constructor for UserLoginEvent.
-      * @param username The username of the user who logged in.
-      */
-     UserLoginEvent(const std::string& username)
-         : m_username(username)
-     {
-     }
- 
-     /**
-      * @brief Retrieves the event type.
-      * @return A string representing the event type.
-      */
-     std::string getEventType() const override
-     {
-         return "UserLoginEvent";
-     }
- 
-     /**
-      * @brief Retrieves the username.
-      * @return The username of the logged-in user.
-      */
-     std::string getUsername() const
-     {
-         return m_username;
-     }
- 
- private:
-     std::string m_username; ///< The username of the user who logged in.
- };
- 
- /**
-  * @brief A listener that reacts to events.
-  */
- class EventListener
- {
- public:
-     virtual ~EventListener() = default;
- 
-     /**
-      * @brief Handles an event when it occurs.
-      * @param event The event to handle.
-      */
-     virtual void onEvent(const std::shared_ptr<Event>& event) = 0;
- };
- 
- /**
-  * @brief A specific listener that reacts to user login events.
-  */
- class UserLoginListener : public EventListener
- {
- public:
-     /**
-      * @brief Handles a user login event.
-      * @param event The event to handle.
-      */
-     void onEvent(const std::shared_ptr<Event>& event) override
-     {
-         // Check if the event is a UserLoginEvent.
-         auto loginEvent = std::dynamic_pointer_cast<UserLoginEvent>(event);
-         if (loginEvent)
-         {
-             std::cout << "User logged in: " << loginEvent->getUsername() << std::endl;
-         }
-     }
- };
- 
- /**
-  * @brief EventPublisher publishes events to listeners.
-  */
- class EventPublisher
- {
- public:
-     /**
-      * @brief Adds a listener to the list of listeners.
-      * @param listener The listener to add.
-      */
-     void addListener(const std::shared_ptr<EventListener>& listener)
-     {
-         m_listeners.push_back(listener);
-     }
- 
-     /**
-      * @brief Publishes an event to all listeners.
-      * @param event The event to publish.
-      */
-     void publishEvent(const std::shared_ptr<Event>& event)
-     {
-         for (const auto& listener : m_listeners)
-         {
-             listener->onEvent(event);
-         }
-     }
- 
- private:
-     std::vector<std::shared_ptr<EventListener>> m_listeners; ///< List of listeners to notify.
- };
- 
- /**
-  * @brief Demonstrates an event-driven system with an event publisher, event listener, and event handling.
-  */
- int main()
- {
-     // Create an event publisher and a listener.
-     EventPublisher eventPublisher;
-     auto userLoginListener = std::make_shared<UserLoginListener>();
-     eventPublisher.addListener(userLoginListener);
- 
-     // Create a user login event.
-     auto loginEvent = std::make_shared<UserLoginEvent>("john_doe");
- 
-     // Publish the event, triggering the listener to handle it.
-     eventPublisher.publishEvent(loginEvent);
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
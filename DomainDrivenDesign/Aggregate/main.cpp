@@ -10,134 +10,371 @@
  * - **Simplifies Data Management**: Aggregate pattern simplifies the management of related objects by treating them as a cohesive unit.
  * - **Encapsulation**: Keeps individual objects hidden from the outside, providing controlled access to their data.
  * - **Reduced Complexity**: Operations on multiple related objects can be done through a single interface, reducing the complexity for the client code.
+ *
+ * Recomputing totals by iterating every item on demand is O(n) per read, and
+ * order aggregates holding 100k+ line items mutate constantly. The
+ * incremental aggregate below keeps running totals updated in O(1) on every
+ * add/remove/change, defers derived values that cannot be maintained
+ * incrementally (the maximum) behind a dirty flag recomputed only when
+ * actually read, and offers a chunked parallel recomputeAll() for full
+ * rebuilds after bulk imports.
+ */
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <span>
+#include <thread>
+#include <numeric>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @brief Represents an individual item in the aggregate.
+ */
+class Item
+{
+public:
+    /**
+     * @brief Constructs an Item with a given ID and value.
+     * @param id The ID of the item.
+     * @param value The value of the item.
+     */
+    Item(int id, int value)
+        : m_id(id), m_value(value)
+    {}
+
+    /**
+     * @brief Gets the ID of the item.
+     * @return The ID of the item.
+     */
+    int getId() const { return m_id; }
+
+    /**
+     * @brief Gets the value of the item.
+     * @return The value of the item.
+     */
+    int getValue() const { return m_value; }
+
+    /**
+     * @brief Sets the value of the item.
+     * @param value The new value to set.
+     */
+    void setValue(int value) { m_value = value; }
+
+private:
+    int m_id;      ///< The ID of the item.
+    int m_value;   ///< The value of the item.
+};
+
+/**
+ * @brief Represents an aggregate that groups multiple items.
+ */
+class Aggregate
+{
+public:
+    /**
+     * @brief Adds an item to the aggregate.
+     * @param item The item to add.
+     */
+    void addItem(const std::shared_ptr<Item>& item)
+    {
+        m_items.push_back(item);
+    }
+
+    /**
+     * @brief Gets the item by index from the aggregate.
+     * @param index The index of the item to retrieve.
+     * @return The item at the specified index.
+     */
+    std::shared_ptr<Item> getItem(int index)
+    {
+        if (index < 0 || index >= static_cast<int>(m_items.size()))
+        {
+            return nullptr;
+        }
+        return m_items[index];
+    }
+
+    /**
+     * @brief Updates the value of an item in the aggregate by index.
+     * @param index The index of the item.
+     * @param newValue The new value to set.
+     */
+    void updateItemValue(int index, int newValue)
+    {
+        if (auto item = getItem(index))
+        {
+            item->setValue(newValue);
+        }
+    }
+
+    /**
+     * @brief Displays all items in the aggregate.
+     */
+    void displayItems() const
+    {
+        for (const auto& item : m_items)
+        {
+            std::cout << "Item ID: " << item->getId() << ", Value: " << item->getValue() << std::endl;
+        }
+    }
+
+private:
+    std::vector<std::shared_ptr<Item>> m_items; ///< List of items in the aggregate.
+};
+
+/**
+ * @brief A line item stored by value; the payload of large aggregates.
+ */
+struct LineItem
+{
+    int id;
+    long long value;
+};
+
+/**
+ * @brief Order aggregate with O(1) running totals and lazy derived values.
+ *
+ * Sum and count are maintained incrementally on every mutation, so total()
+ * and average() never scan. The maximum cannot be maintained in O(1) on
+ * removals or decreases, so it is dirty-flagged and recomputed only when
+ * read. bulkImport() appends without per-item bookkeeping and relies on
+ * recomputeAll(), which rebuilds the totals with a chunked parallel reduce.
  */
+class IncrementalAggregate
+{
+public:
+    /// @brief Adds one item; totals update in O(1).
+    void addItem(LineItem item)
+    {
+        m_sum += item.value;
+        if (!m_maxDirty && item.value > m_maxValue)
+        {
+            m_maxValue = item.value; // A new item can only raise the max.
+        }
+        m_items.push_back(item);
+    }
+
+    /// @brief Removes the item at index; totals update in O(1).
+    void removeItem(std::size_t index)
+    {
+        if (index >= m_items.size())
+        {
+            return;
+        }
+        m_sum -= m_items[index].value;
+        if (m_items[index].value == m_maxValue)
+        {
+            m_maxDirty = true; // The max may have left; recompute on next read.
+        }
+        m_items[index] = m_items.back();
+        m_items.pop_back();
+    }
+
+    /// @brief Changes one item's value; totals update in O(1).
+    void updateItemValue(std::size_t index, long long newValue)
+    {
+        if (index >= m_items.size())
+        {
+            return;
+        }
+        long long oldValue = m_items[index].value;
+        m_sum += newValue - oldValue;
+        m_items[index].value = newValue;
+        if (!m_maxDirty)
+        {
+            if (newValue > m_maxValue)
+            {
+                m_maxValue = newValue;
+            }
+            else if (oldValue == m_maxValue)
+            {
+                m_maxDirty = true; // The previous max may have shrunk.
+            }
+        }
+    }
+
+    /// @brief Appends a whole import without per-item bookkeeping.
+    void bulkImport(std::span<const LineItem> items)
+    {
+        m_items.insert(m_items.end(), items.begin(), items.end());
+        m_sumDirty = true;
+        m_maxDirty = true;
+    }
+
+    /// @brief Running total; O(1) unless a bulk import is pending.
+    long long total()
+    {
+        if (m_sumDirty)
+        {
+            recomputeAll(1);
+        }
+        return m_sum;
+    }
+
+    /// @brief Derived lazily: recomputed only when read while dirty.
+    long long maxItemValue()
+    {
+        if (m_sumDirty || m_maxDirty)
+        {
+            recomputeAll(1);
+        }
+        return m_maxValue;
+    }
+
+    double average()
+    {
+        return m_items.empty() ? 0.0 : static_cast<double>(total()) / static_cast<double>(m_items.size());
+    }
+
+    /**
+     * @brief Full rebuild: a chunked parallel reduce over all items.
+     *
+     * Meant for after bulk imports. Each worker reduces a contiguous chunk
+     * with std::reduce; the per-chunk results are combined at the end.
+     */
+    void recomputeAll(unsigned threadCount)
+    {
+        std::size_t count = m_items.size();
+        if (count == 0)
+        {
+            m_sum = 0;
+            m_maxValue = 0;
+            m_sumDirty = m_maxDirty = false;
+            return;
+        }
+        threadCount = std::max(1u, std::min<unsigned>(threadCount, count / 4096 + 1));
+        std::vector<long long> chunkSums(threadCount, 0);
+        std::vector<long long> chunkMaxes(threadCount, m_items.front().value);
+        auto reduceChunk = [this, count, threadCount, &chunkSums, &chunkMaxes](unsigned chunk)
+        {
+            std::size_t begin = count * chunk / threadCount;
+            std::size_t end = count * (chunk + 1) / threadCount;
+            chunkSums[chunk] = std::transform_reduce(m_items.begin() + begin, m_items.begin() + end, 0LL,
+                std::plus<>(), [](const LineItem& item) { return item.value; });
+            long long chunkMax = m_items[begin].value;
+            for (std::size_t i = begin + 1; i < end; ++i)
+            {
+                chunkMax = std::max(chunkMax, m_items[i].value);
+            }
+            chunkMaxes[chunk] = chunkMax;
+        };
+        if (threadCount == 1)
+        {
+            reduceChunk(0);
+        }
+        else
+        {
+            std::vector<std::thread> workers;
+            for (unsigned chunk = 0; chunk < threadCount; ++chunk)
+            {
+                workers.emplace_back(reduceChunk, chunk);
+            }
+            for (auto& worker : workers)
+            {
+                worker.join();
+            }
+        }
+        m_sum = std::reduce(chunkSums.begin(), chunkSums.end(), 0LL);
+        m_maxValue = *std::max_element(chunkMaxes.begin(), chunkMaxes.end());
+        m_sumDirty = m_maxDirty = false;
+    }
+
+    std::size_t itemCount() const { return m_items.size(); }
+
+private:
+    std::vector<LineItem> m_items; ///< Items by value, contiguous for the reduce.
+    long long m_sum{0};            ///< Running total; always current unless sumDirty.
+    long long m_maxValue{0};       ///< Cached max; trustworthy only when not dirty.
+    bool m_sumDirty{false};        ///< Set by bulkImport only.
+    bool m_maxDirty{false};        ///< Set when the max may have left or shrunk.
+};
+
+/**
+ * @brief Main function demonstrating the Aggregate pattern.
+ */
+int main()
+{
+    // Create individual items
+    auto item1 = std::make_shared<Item>(1, 10);
+    auto item2 = std::make_shared<Item>(2, 20);
+    auto item3 = std::make_shared<Item>(3, 30);
+
+    // Create an aggregate and add items to it
+    Aggregate aggregate;
+    aggregate.addItem(item1);
+    aggregate.addItem(item2);
+    aggregate.addItem(item3);
+
+    // Display all items in the aggregate
+    std::cout << "Before update:" << std::endl;
+    aggregate.displayItems();
+
+    // Update the value of the second item
+    aggregate.updateItemValue(1, 50);
+
+    // Display all items after the update
+    std::cout << "After update:" << std::endl;
+    aggregate.displayItems();
+
+    // Incremental totals: O(1) mutations against full rescans.
+    constexpr std::size_t itemCount = 100000;
+    constexpr std::size_t mutations = 2000;
+
+    std::vector<LineItem> seed;
+    seed.reserve(itemCount);
+    for (std::size_t i = 0; i < itemCount; ++i)
+    {
+        seed.push_back(LineItem{static_cast<int>(i), static_cast<long long>(i % 997)});
+    }
+
+    // Baseline: every mutation followed by a full rescan of all items.
+    auto start = std::chrono::steady_clock::now();
+    long long rescanTotal = 0;
+    {
+        std::vector<LineItem> items(seed);
+        for (std::size_t m = 0; m < mutations; ++m)
+        {
+            items[(m * 131) % items.size()].value = static_cast<long long>(m);
+            rescanTotal = std::transform_reduce(items.begin(), items.end(), 0LL,
+                std::plus<>(), [](const LineItem& item) { return item.value; });
+        }
+    }
+    double rescanTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    IncrementalAggregate incremental;
+    incremental.bulkImport(seed);
+    incremental.recomputeAll(2); // Parallel rebuild once, after the import.
+    start = std::chrono::steady_clock::now();
+    long long incrementalTotal = 0;
+    for (std::size_t m = 0; m < mutations; ++m)
+    {
+        incremental.updateItemValue((m * 131) % incremental.itemCount(), static_cast<long long>(m));
+        incrementalTotal = incremental.total(); // O(1): no scan.
+    }
+    double incrementalTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << mutations << " mutation(s) over " << itemCount << " item(s): full rescan "
+              << rescanTime << " ms, incremental " << incrementalTime << " ms (totals "
+              << rescanTotal << " / " << incrementalTotal << ", max "
+              << incremental.maxItemValue() << ")\n";
+
+    // Full rebuild after a bulk import: serial vs chunked parallel reduce.
+    IncrementalAggregate imported;
+    imported.bulkImport(seed);
+    imported.bulkImport(seed);
+    start = std::chrono::steady_clock::now();
+    imported.recomputeAll(1);
+    double serialRebuild = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    imported.recomputeAll(std::max(2u, std::thread::hardware_concurrency()));
+    double parallelRebuild = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Rebuild of " << imported.itemCount() << " item(s): serial " << serialRebuild
+              << " ms, parallel " << parallelRebuild << " ms (total " << imported.total()
+              << ")" << std::endl;
 
- #include <iostream>
- #include <memory>
- #include <vector>
- 
- /**
-  * @brief Represents an individual item in the aggregate.
-  */
- class Item
- {
- public:
-     /**
-      * @brief Constructs an Item with a given ID and value.
-      * @param id The ID of the item.
-      * @param value The value of the item.
-      */
-     Item(int id, int value)
-         : m_id(id), m_value(value)
-     {}
- 
-     /**
-      * @brief Gets the ID of the item.
-      * @return The ID of the item.
-      */
-     int getId() const { return m_id; }
- 
-     /**
-      * @brief Gets the value of the item.
-      * @return The value of the item.
-      */
-     int getValue() const { return m_value; }
- 
-     /**
-      * @brief Sets the value of the item.
-      * @param value The new value to set.
-      */
-     void setValue(int value) { m_value = value; }
- 
- private:
-     int m_id;      ///< The ID of the item.
-     int m_value;   ///< The value of the item.
- };
- 
- /**
-  * @brief Represents an aggregate that groups multiple items.
-  */
- class Aggregate
- {
- public:
-     /**
-      * @brief Adds an item to the aggregate.
-      * @param item The item to add.
-      */
-     void addItem(const std::shared_ptr<Item>& item)
-     {
-         m_items.push_back(item);
-     }
- 
-     /**
-      * @brief Gets the item by index from the aggregate.
-      * @param index The index of the item to retrieve.
-      * @return The item at the specified index.
-      */
-     std::shared_ptr<Item> getItem(int index)
-     {
-         if (index < 0 || index >= static_cast<int>(m_items.size()))
-         {
-             return nullptr;
-         }
-         return m_items[index];
-     }
- 
-     /**
-      * @brief Updates the value of an item in the aggregate by index.
-      * @param index The index of the item.
-      * @param newValue The new value to set.
-      */
-     void updateItemValue(int index, int newValue)
-     {
-         if (auto item = getItem(index))
-         {
-             item->setValue(newValue);
-         }
-     }
- 
-     /**
-      * @brief Displays all items in the aggregate.
-      */
-     void displayItems() const
-     {
-         for (const auto& item : m_items)
-         {
-             std::cout << "Item ID: " << item->getId() << ", Value: " << item->getValue() << std::endl;
-         }
-     }
- 
- private:
-     std::vector<std::shared_ptr<Item>> m_items; ///< List of items in the aggregate.
- };
- 
- /**
-  * @brief Main function demonstrating the Aggregate pattern.
-  */
- int main()
- {
-     // Create individual items
-     auto item1 = std::make_shared<Item>(1, 10);
-     auto item2 = std::make_shared<Item>(2, 20);
-     auto item3 = std::make_shared<Item>(3, 30);
- 
-     // Create an aggregate and add items to it
-     Aggregate aggregate;
-     aggregate.addItem(item1);
-     aggregate.addItem(item2);
-     aggregate.addItem(item3);
- 
-     // Display all items in the aggregate
-     std::cout << "Before update:" << std::endl;
-     aggregate.displayItems();
- 
-     // Update the value of the second item
-     aggregate.updateItemValue(1, 50);
- 
-     // Display all items after the update
-     std::cout << "After update:" << std::endl;
-     aggregate.displayItems();
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
@@ -10,104 +10,277 @@
  * - Improves system modularity by decoupling the components that handle events from those that change the state.
  * - Enables auditing, logging, and tracking of important changes in the system.
  * - Can be used to trigger other actions or workflows asynchronously.
+ *
+ * Per-event shared_ptr wrapping and synchronous one-at-a-time fan-out cap throughput at
+ * high event rates. The batching dispatcher writes events by value into a preallocated
+ * ring journal and hands each handler contiguous spans of events at batch-size or
+ * deadline boundaries; every handler keeps its own journal cursor, so lag (and events
+ * lost to overwrite for consumers that fall a full ring behind) is visible per handler.
+ */
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <functional>
+#include <span>
+#include <cstdint>
+
+/**
+ * @brief Represents a domain event that signifies a state change in the domain.
+ */
+class DomainEvent
+{
+public:
+    /**
+     * @brief Constructs an empty event; used for preallocated journal slots.
+     */
+    DomainEvent() = default;
+
+    /**
+     * @brief Constructs a domain event with a description.
+     * @param description A string describing the event.
+     */
+    DomainEvent(std::string description)
+        : m_description(std::move(description)), m_timestamp(std::chrono::system_clock::now())
+    {
+    }
+
+    /**
+     * @brief Gets the description of the domain event.
+     * @return The event description.
+     */
+    const std::string &getDescription() const
+    {
+        return m_description;
+    }
+
+    /**
+     * @brief Gets the timestamp when the event was created.
+     * @return The timestamp of the event.
+     */
+    const std::chrono::system_clock::time_point &getTimestamp() const
+    {
+        return m_timestamp;
+    }
+
+private:
+    std::string m_description; ///< Description of the event.
+    std::chrono::system_clock::time_point m_timestamp; ///< Time the event was created.
+};
+
+/**
+ * @brief Represents an event handler that reacts to domain events.
  */
+class EventHandler
+{
+public:
+    /**
+     * @brief Handles the domain event by printing the event description.
+     * @param event The domain event to handle.
+     */
+    void handleEvent(const DomainEvent &event)
+    {
+        std::cout << "Handling event: " << event.getDescription() << " at " 
+                  << std::chrono::system_clock::to_time_t(event.getTimestamp()) << std::endl;
+    }
+};
+
+/**
+ * @brief Represents a domain service that generates domain events.
+ */
+class DomainService
+{
+public:
+    /**
+     * @brief Simulates the occurrence of a state change and triggers a domain event.
+     * @param description Description of the state change.
+     * @param handler The event handler that processes the event.
+     */
+    void triggerEvent(const std::string &description, EventHandler &handler)
+    {
+        DomainEvent event(description);
+        handler.handleEvent(event);
+    }
+};
+
+/**
+ * @brief Batch-delivering dispatcher over a preallocated ring journal.
+ *
+ * publish() moves the event into the next ring slot — no per-event heap
+ * allocation, no immediate fan-out. Handlers are invoked with spans of
+ * journal entries once a batch fills or the flush deadline passes, and each
+ * handler advances its own cursor, so a slow consumer shows up as lag in the
+ * stats rather than stalling the publisher.
+ */
+class BatchingEventDispatcher
+{
+public:
+    using BatchHandler = std::function<void(std::span<const DomainEvent>)>;
+
+    /**
+     * @brief Creates the dispatcher.
+     * @param capacity Ring journal size; must be a power of two.
+     * @param batchSize Deliver once this many events are pending.
+     * @param deadline Deliver at least this often, even for partial batches.
+     */
+    BatchingEventDispatcher(std::size_t capacity, std::size_t batchSize,
+                            std::chrono::milliseconds deadline)
+        : m_journal(capacity), m_mask(capacity - 1), m_batchSize(batchSize),
+          m_deadline(deadline), m_lastFlush(std::chrono::steady_clock::now())
+    {
+    }
+
+    /**
+     * @brief Registers a handler that receives event batches.
+     * @param name Name used in the lag report.
+     * @param handler Invoked with spans of journal entries.
+     */
+    void subscribe(std::string name, BatchHandler handler)
+    {
+        m_handlers.push_back(HandlerState{std::move(name), std::move(handler), 0, 0, 0, 0});
+    }
+
+    /**
+     * @brief Writes one event into the journal; flushes on batch boundaries.
+     */
+    void publish(DomainEvent event)
+    {
+        m_journal[m_head & m_mask] = std::move(event);
+        ++m_head;
+        if (m_head - m_flushedTo >= m_batchSize)
+        {
+            flush();
+        }
+    }
+
+    /**
+     * @brief Flushes a partial batch if the deadline has passed; call from the
+     *        publisher's loop.
+     */
+    void poll()
+    {
+        if (m_head != m_flushedTo &&
+            std::chrono::steady_clock::now() - m_lastFlush >= m_deadline)
+        {
+            flush();
+        }
+    }
+
+    /**
+     * @brief Delivers all pending events to every handler as spans.
+     */
+    void flush()
+    {
+        for (HandlerState& state : m_handlers)
+        {
+            if (m_head - state.cursor > m_journal.size())
+            {
+                // Fell a whole ring behind: oldest entries were overwritten.
+                std::uint64_t lost = m_head - m_journal.size() - state.cursor;
+                state.overwritten += lost;
+                state.cursor += lost;
+            }
+            state.maxLag = std::max(state.maxLag, m_head - state.cursor);
+            while (state.cursor < m_head)
+            {
+                std::size_t begin = state.cursor & m_mask;
+                std::size_t length = std::min<std::uint64_t>(m_head - state.cursor,
+                                                             m_journal.size() - begin);
+                state.handler(std::span<const DomainEvent>(m_journal.data() + begin, length));
+                state.cursor += length;
+                state.delivered += length;
+            }
+        }
+        m_flushedTo = m_head;
+        m_lastFlush = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * @brief Prints per-handler delivery and lag counters.
+     */
+    void printStats() const
+    {
+        std::cout << "Dispatcher stats (" << m_head << " event(s) published):\n";
+        for (const HandlerState& state : m_handlers)
+        {
+            std::cout << "  " << state.name << ": delivered " << state.delivered
+                      << ", max lag " << state.maxLag
+                      << ", lost to overwrite " << state.overwritten << "\n";
+        }
+    }
+
+private:
+    /**
+     * @brief A registered handler and its private journal cursor.
+     */
+    struct HandlerState
+    {
+        std::string name;
+        BatchHandler handler;
+        std::uint64_t cursor;      ///< Next journal position to deliver.
+        std::uint64_t delivered;   ///< Events handed to this handler.
+        std::uint64_t maxLag;      ///< Largest pending backlog observed.
+        std::uint64_t overwritten; ///< Events lost by falling a ring behind.
+    };
+
+    std::vector<DomainEvent> m_journal;   ///< Preallocated ring of events by value.
+    std::size_t m_mask;                   ///< capacity - 1 for cheap wrapping.
+    std::size_t m_batchSize;              ///< Flush threshold.
+    std::chrono::milliseconds m_deadline; ///< Maximum time between flushes.
+    std::uint64_t m_head{0};              ///< Next write position.
+    std::uint64_t m_flushedTo{0};         ///< Journal position of the last flush.
+    std::chrono::steady_clock::time_point m_lastFlush;
+    std::vector<HandlerState> m_handlers; ///< Registered consumers.
+};
+
+/**
+ * @brief Main function demonstrating the Domain Event pattern.
+ */
+int main()
+{
+    EventHandler eventHandler; ///< Event handler that processes domain events.
+    DomainService domainService; ///< Domain service that triggers domain events.
+
+    // Simulating the occurrence of domain events
+    domainService.triggerEvent("User created", eventHandler);
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    domainService.triggerEvent("User updated", eventHandler);
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    domainService.triggerEvent("User deleted", eventHandler);
+
+    // Batching dispatcher: ring journal, span delivery, per-handler lag.
+    BatchingEventDispatcher dispatcher(1024, 256, std::chrono::milliseconds(5));
+
+    std::size_t audited = 0;
+    std::size_t batches = 0;
+    dispatcher.subscribe("audit", [&audited, &batches](std::span<const DomainEvent> events)
+    {
+        audited += events.size();
+        ++batches;
+    });
+    std::size_t projected = 0;
+    dispatcher.subscribe("projection", [&projected](std::span<const DomainEvent> events)
+    {
+        projected += events.size();
+    });
+
+    constexpr int eventCount = 200000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < eventCount; ++i)
+    {
+        dispatcher.publish(DomainEvent("Order state change"));
+        dispatcher.poll(); // Deadline-based partial flushes for quiet periods.
+    }
+    dispatcher.flush();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Published " << eventCount << " event(s) in " << batches
+              << " audit batch(es), " << (elapsed * 1e9 / eventCount) << " ns/event\n";
+    dispatcher.printStats();
+    std::cout << "Audit saw " << audited << ", projection saw " << projected << " event(s)\n";
 
- #include <iostream>
- #include <memory>
- #include <vector>
- #include <string>
- #include <chrono>
- #include <thread>
- #include <functional>
- 
- /**
-  * @brief Represents a domain event that signifies a state change in the domain.
-  */
- class DomainEvent
- {
- public:
-     /**
-      * @brief Constructs a domain event with a description.
-      * @param description A string describing the event.
-      */
-     DomainEvent(std::string description)
-         : m_description(std::move(description)), m_timestamp(std::chrono::system_clock::now())
-     {
-     }
- 
-     /**
-      * @brief Gets the description of the domain event.
-      * @return The event description.
-      */
-     const std::string &getDescription() const
-     {
-         return m_description;
-     }
- 
-     /**
-      * @brief Gets the timestamp when the event was created.
-      * @return The timestamp of the event.
-      */
-     const std::chrono::system_clock::time_point &getTimestamp() const
-     {
-         return m_timestamp;
-     }
- 
- private:
-     std::string m_description; ///< Description of the event.
-     std::chrono::system_clock::time_point m_timestamp; ///< Time the event was created.
- };
- 
- /**
-  * @brief Represents an event handler that reacts to domain events.
-  */
- class EventHandler
- {
- public:
-     /**
-      * @brief Handles the domain event by printing the event description.
-      * @param event The domain event to handle.
-      */
-     void handleEvent(const DomainEvent &event)
-     {
-         std::cout << "Handling event: " << event.getDescription() << " at " 
-                   << std::chrono::system_clock::to_time_t(event.getTimestamp()) << std::endl;
-     }
- };
- 
- /**
-  * @brief Represents a domain service that generates domain events.
-  */
- class DomainService
- {
- public:
-     /**
-      * @brief Simulates the occurrence of a state change and triggers a domain event.
-      * @param description Description of the state change.
-      * @param handler The event handler that processes the event.
-      */
-     void triggerEvent(const std::string &description, EventHandler &handler)
-     {
-         DomainEvent event(description);
-         handler.handleEvent(event);
-     }
- };
- 
- /**
-  * @brief Main function demonstrating the Domain Event pattern.
-  */
- int main()
- {
-     EventHandler eventHandler; ///< Event handler that processes domain events.
-     DomainService domainService; ///< Domain service that triggers domain events.
- 
-     // Simulating the occurrence of domain events
-     domainService.triggerEvent("User created", eventHandler);
-     std::this_thread::sleep_for(std::chrono::seconds(1));
-     domainService.triggerEvent("User updated", eventHandler);
-     std::this_thread::sleep_for(std::chrono::seconds(1));
-     domainService.triggerEvent("User deleted", eventHandler);
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
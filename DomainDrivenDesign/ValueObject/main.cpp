@@ -10,102 +10,232 @@
  * - Improves consistency by ensuring objects cannot be altered after creation.
  * - Enables better comparison between objects since equality is determined by value, not identity.
  * - Helps avoid errors related to shared mutable state.
+ *
+ * For engines that mint billions of transient values, the per-instance currency string is
+ * the cost that matters. PackedMoney interns currency codes as small handles resolved
+ * through a constexpr table, making the value a trivially copyable 16-byte POD that packs
+ * densely into arrays, with bulk helpers (sum/convert over spans) that aggregate a
+ * portfolio in one vectorizable loop with zero allocation.
  */
 
- #include <iostream>
- #include <string>
- #include <memory>
- 
- /**
-  * @brief Represents a Value Object that models a Money concept.
-  */
- class Money
- {
- public:
-     /**
+#include <iostream>
+#include <string>
+#include <memory>
+#include <array>
+#include <string_view>
+#include <span>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Represents a Value Object that models a Money concept.
+ */
+class Money
+{
+public:
+    /**
       * @brief Constructs a Money object with a specific amount and currency.
       * @param amount The amount of money.
       * @param currency The currency in which the amount is specified.
       */
-     Money(double amount, const std::string& currency)
-         : m_amount(amount), m_currency(currency)
-     {
-     }
- 
-     /**
+    Money(double amount, const std::string& currency)
+        : m_amount(amount), m_currency(currency)
+    {
+    }
+
+    /**
       * @brief Gets the amount of money.
       * @return The amount of money.
       */
-     double getAmount() const
-     {
-         return m_amount;
-     }
- 
-     /**
+    double getAmount() const
+    {
+        return m_amount;
+    }
+
+    /**
       * @brief Gets the currency of the money.
       * @return The currency of the money.
       */
-     const std::string& getCurrency() const
-     {
-         return m_currency;
-     }
- 
-     /**
+    const std::string& getCurrency() const
+    {
+        return m_currency;
+    }
+
+    /**
       * @brief Compares two Money objects for equality based on amount and currency.
       * @param other Another Money object.
       * @return True if the two Money objects are equal, false otherwise.
       */
-     bool operator==(const Money& other) const
-     {
-         return m_amount == other.m_amount && m_currency == other.m_currency;
-     }
- 
-     /**
+    bool operator==(const Money& other) const
+    {
+        return m_amount == other.m_amount && m_currency == other.m_currency;
+    }
+
+    /**
       * @brief Displays the money in a readable format.
       */
-     void display() const
-     {
-         std::cout << m_amount << " " << m_currency << std::endl;
-     }
- 
- private:
-     double m_amount; ///< The amount of money.
-     std::string m_currency; ///< The currency of the money.
- };
- 
- /**
-  * @brief Demonstrates the use of Value Object pattern with Money.
-  */
- int main()
- {
-     auto money1 = std::make_shared<Money>(100.50, "USD");
-     auto money2 = std::make_shared<Money>(100.50, "USD");
-     auto money3 = std::make_shared<Money>(200.00, "EUR");
- 
-     // Display money objects
-     money1->display();
-     money2->display();
-     money3->display();
- 
-     // Check equality
-     if (*money1 == *money2)
-     {
-         std::cout << "Money1 and Money2 are equal." << std::endl;
-     }
-     else
-     {
-         std::cout << "Money1 and Money2 are not equal." << std::endl;
-     }
- 
-     if (*money1 == *money3)
-     {
-         std::cout << "Money1 and Money3 are equal." << std::endl;
-     }
-     else
-     {
-         std::cout << "Money1 and Money3 are not equal." << std::endl;
-     }
- 
-     return 0;
- }
- 
\ No newline at end of file
+    void display() const
+    {
+        std::cout << m_amount << " " << m_currency << std::endl;
+    }
+
+private:
+    double m_amount; ///< The amount of money.
+    std::string m_currency; ///< The currency of the money.
+};
+
+/**
+ * @brief Interned currency codes: small handles into a constexpr table.
+ */
+enum class Currency : std::uint32_t
+{
+    USD = 0,
+    EUR = 1,
+    GBP = 2,
+    JPY = 3,
+    Count
+};
+
+/// @brief Code table indexed by Currency; resolution is a constexpr array load.
+inline constexpr std::array<std::string_view, static_cast<std::size_t>(Currency::Count)>
+    CURRENCY_CODES{"USD", "EUR", "GBP", "JPY"};
+
+/// @brief Resolves a currency handle to its ISO code.
+constexpr std::string_view currencyCode(Currency currency)
+{
+    return CURRENCY_CODES[static_cast<std::size_t>(currency)];
+}
+
+/**
+ * @brief Allocation-free Money: a trivially copyable 16-byte value.
+ *
+ * Same value semantics as Money — immutable, compared by value — but the
+ * currency is an interned handle instead of an owned string, so arrays of
+ * PackedMoney are dense, cache-linear and safe to memcpy. All operations are
+ * constexpr; nothing ever touches the heap.
+ */
+struct PackedMoney
+{
+    double amount;     ///< The amount of money.
+    Currency currency; ///< Interned currency handle.
+    std::uint32_t pad{0};
+
+    constexpr bool operator==(const PackedMoney& other) const
+    {
+        return amount == other.amount && currency == other.currency;
+    }
+
+    void display() const
+    {
+        std::cout << amount << " " << currencyCode(currency) << std::endl;
+    }
+};
+
+static_assert(sizeof(PackedMoney) == 16, "PackedMoney must stay a 16-byte POD");
+static_assert(std::is_trivially_copyable_v<PackedMoney>, "PackedMoney must be trivially copyable");
+
+/**
+ * @brief Sums a span of values already known to share one currency.
+ *
+ * The loop reads amounts out of densely packed 16-byte values — no pointer
+ * chasing, no string compares — so the compiler can vectorize it.
+ */
+inline double sumAmounts(std::span<const PackedMoney> values)
+{
+    double total = 0.0;
+    for (const PackedMoney& value : values)
+    {
+        total += value.amount;
+    }
+    return total;
+}
+
+/**
+ * @brief Converts a span of values into the target currency in one pass.
+ * @param values The values to convert.
+ * @param rates Conversion rate into the target currency, indexed by Currency.
+ * @param target The target currency.
+ * @return Total of all values expressed in the target currency.
+ */
+inline double convertAndSum(std::span<const PackedMoney> values,
+                            const std::array<double, static_cast<std::size_t>(Currency::Count)>& rates,
+                            Currency target)
+{
+    (void)target; // Rates are already expressed into the target currency.
+    double total = 0.0;
+    for (const PackedMoney& value : values)
+    {
+        total += value.amount * rates[static_cast<std::size_t>(value.currency)];
+    }
+    return total;
+}
+
+/**
+ * @brief Demonstrates the use of Value Object pattern with Money.
+ */
+int main()
+{
+    auto money1 = std::make_shared<Money>(100.50, "USD");
+    auto money2 = std::make_shared<Money>(100.50, "USD");
+    auto money3 = std::make_shared<Money>(200.00, "EUR");
+
+    // Display money objects
+    money1->display();
+    money2->display();
+    money3->display();
+
+    // Check equality
+    if (*money1 == *money2)
+    {
+        std::cout << "Money1 and Money2 are equal." << std::endl;
+    }
+    else
+    {
+        std::cout << "Money1 and Money2 are not equal." << std::endl;
+    }
+
+    if (*money1 == *money3)
+    {
+        std::cout << "Money1 and Money3 are equal." << std::endl;
+    }
+    else
+    {
+        std::cout << "Money1 and Money3 are not equal." << std::endl;
+    }
+
+    // Packed values: same semantics, 16 bytes, no allocation.
+    constexpr PackedMoney packed1{100.50, Currency::USD};
+    constexpr PackedMoney packed2{100.50, Currency::USD};
+    static_assert(packed1 == packed2, "Value equality holds at compile time");
+    packed1.display();
+
+    // Portfolio aggregation as one vectorizable pass over dense storage.
+    std::vector<PackedMoney> portfolio;
+    portfolio.reserve(1000000);
+    for (int i = 0; i < 1000000; ++i)
+    {
+        portfolio.push_back(PackedMoney{1.0 + i % 100, static_cast<Currency>(i % 4)});
+    }
+
+    constexpr std::array<double, static_cast<std::size_t>(Currency::Count)> toUsd{1.0, 1.09, 1.27, 0.0067};
+
+    auto start = std::chrono::steady_clock::now();
+    double stringTotal = 0.0;
+    for (const PackedMoney& value : portfolio)
+    {
+        Money boxed(value.amount, std::string(currencyCode(value.currency))); // Legacy path allocates.
+        stringTotal += boxed.getAmount() * toUsd[static_cast<std::size_t>(value.currency)];
+    }
+    double stringTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    double packedTotal = convertAndSum(portfolio, toUsd, Currency::USD);
+    double packedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Portfolio of " << portfolio.size() << " values in USD: string-backed "
+              << stringTime << " ms, packed " << packedTime << " ms (totals "
+              << stringTotal << " / " << packedTotal << ")" << std::endl;
+
+    return 0;
+}
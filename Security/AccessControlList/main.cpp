@@ -10,182 +10,333 @@
  * - Provides fine-grained control over who can access specific resources in a system.
  * - Helps improve system security by defining precise permissions for different users or groups.
  * - Simplifies management of access controls by centralizing permission definitions.
+ *
+ * Checks run against a precompiled index: a flat open-addressed hash keyed on the packed
+ * (userId, resourceId) pair with a permission bitmask per entry. Policy edits rebuild the
+ * index and publish it through an atomic generation-stamped pointer swap, so concurrent
+ * readers stay lock-free on the hot path while updates remain safe.
+ */
+
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <optional>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <chrono>
+
+/**
+ * @brief A class representing a user in the system.
+ */
+class User
+{
+public:
+    /**
+     * @brief Constructs a User object.
+     * @param id The ID of the user.
+     * @param name The name of the user.
+     */
+    User(int id, const std::string& name)
+        : m_id(id), m_name(name)
+    {}
+
+    /**
+     * @brief Gets the ID of the user.
+     * @return The ID of the user.
+     */
+    int getId() const { return m_id; }
+
+    /**
+     * @brief Gets the name of the user.
+     * @return The name of the user.
+     */
+    const std::string& getName() const { return m_name; }
+
+private:
+    int m_id;          ///< The ID of the user.
+    std::string m_name;///< The name of the user.
+};
+
+/**
+ * @brief A class representing a resource in the system.
+ */
+class Resource
+{
+public:
+    /**
+     * @brief Constructs a Resource object.
+     * @param id The ID of the resource.
+     * @param name The name of the resource.
+     */
+    Resource(int id, const std::string& name)
+        : m_id(id), m_name(name)
+    {}
+
+    /**
+     * @brief Gets the ID of the resource.
+     * @return The ID of the resource.
+     */
+    int getId() const { return m_id; }
+
+    /**
+     * @brief Gets the name of the resource.
+     * @return The name of the resource.
+     */
+    const std::string& getName() const { return m_name; }
+
+private:
+    int m_id;          ///< The ID of the resource.
+    std::string m_name;///< The name of the resource.
+};
+
+/**
+ * @brief A class representing a permission (read, write, delete, etc.) associated with a resource.
+ */
+class Permission
+{
+public:
+    enum class Type
+    {
+        READ,
+        WRITE,
+        DELETE
+    };
+
+    /**
+     * @brief Constructs a Permission object.
+     * @param type The type of permission (e.g., READ, WRITE, DELETE).
+     */
+    Permission(Type type)
+        : m_type(type)
+    {}
+
+    /**
+     * @brief Gets the type of permission.
+     * @return The type of permission.
+     */
+    Type getType() const { return m_type; }
+
+private:
+    Type m_type; ///< The type of permission.
+};
+
+/**
+ * @brief A class that implements the Access Control List (ACL) pattern.
+ *
+ * Grants accumulate in an edit map; hasPermission() consults a compiled,
+ * immutable index published through an atomic pointer. A check is a single
+ * probe of a flat hash over packed 64-bit (userId, resourceId) keys plus a
+ * bitmask test — no node walking, no per-entry scan, no lock.
+ */
+class AccessControlList
+{
+public:
+    /**
+     * @brief Adds a permission for a user on a specific resource.
+     * @param user The user who will be granted the permission.
+     * @param resource The resource on which the user is granted the permission.
+     * @param permission The permission granted to the user on the resource.
+     */
+    void addPermission(const std::shared_ptr<User>& user, const std::shared_ptr<Resource>& resource, const Permission& permission)
+    {
+        std::lock_guard lock(m_writeMutex);
+        m_edits[packKey(user->getId(), resource->getId())] |= maskFor(permission.getType());
+        m_dirty.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Checks if a user has a specific permission on a resource.
+     *
+     * Hot path: one atomic pointer load, one flat-hash probe, one bit test.
+     *
+     * @param user The user to check.
+     * @param resource The resource to check.
+     * @param permission The permission to check.
+     * @return true if the user has the permission, false otherwise.
+     */
+    bool hasPermission(const std::shared_ptr<User>& user, const std::shared_ptr<Resource>& resource, const Permission& permission)
+    {
+        if (m_dirty.load(std::memory_order_acquire))
+        {
+            compile(); // First check after an edit pays the rebuild; the rest are lock-free.
+        }
+        const Index* index = m_index.load(std::memory_order_acquire);
+        if (!index)
+        {
+            return false;
+        }
+        return (index->lookup(packKey(user->getId(), resource->getId())) & maskFor(permission.getType())) != 0;
+    }
+
+    /**
+     * @brief Generation of the currently published index.
+     */
+    std::uint64_t generation() const
+    {
+        const Index* index = m_index.load(std::memory_order_acquire);
+        return index ? index->generation : 0;
+    }
+
+    ~AccessControlList()
+    {
+        for (const Index* index : m_retired)
+        {
+            delete index;
+        }
+        delete m_index.load(std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * @brief Immutable flat hash: open addressing, linear probing, bitmask values.
+     */
+    struct Index
+    {
+        static constexpr std::uint64_t EMPTY_KEY = ~0ull;
+
+        std::uint64_t generation;
+        std::size_t mask;                 ///< Capacity - 1 (capacity is a power of two).
+        std::vector<std::uint64_t> keys;  ///< Packed (userId, resourceId) keys.
+        std::vector<std::uint8_t> masks;  ///< Permission bitmask per entry.
+
+        Index(std::uint64_t gen, const std::unordered_map<std::uint64_t, std::uint8_t>& entries)
+            : generation(gen)
+        {
+            std::size_t capacity = 16;
+            while (capacity < entries.size() * 2) // Keep load factor under 50%.
+            {
+                capacity <<= 1;
+            }
+            mask = capacity - 1;
+            keys.assign(capacity, EMPTY_KEY);
+            masks.assign(capacity, 0);
+            for (const auto& [key, permissionMask] : entries)
+            {
+                std::size_t slot = hashKey(key) & mask;
+                while (keys[slot] != EMPTY_KEY)
+                {
+                    slot = (slot + 1) & mask;
+                }
+                keys[slot] = key;
+                masks[slot] = permissionMask;
+            }
+        }
+
+        /**
+         * @brief Probes for a key; returns its permission mask or 0.
+         */
+        std::uint8_t lookup(std::uint64_t key) const
+        {
+            std::size_t slot = hashKey(key) & mask;
+            while (keys[slot] != EMPTY_KEY)
+            {
+                if (keys[slot] == key)
+                {
+                    return masks[slot];
+                }
+                slot = (slot + 1) & mask;
+            }
+            return 0;
+        }
+
+        static std::uint64_t hashKey(std::uint64_t key)
+        {
+            key ^= key >> 33; // 64-bit mix (splitmix-style finalizer).
+            key *= 0xff51afd7ed558ccdull;
+            key ^= key >> 33;
+            return key;
+        }
+    };
+
+    /**
+     * @brief Packs the (userId, resourceId) pair into one 64-bit key.
+     */
+    static std::uint64_t packKey(int userId, int resourceId)
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(userId)) << 32) |
+               static_cast<std::uint32_t>(resourceId);
+    }
+
+    /**
+     * @brief One bit per permission type.
+     */
+    static std::uint8_t maskFor(Permission::Type type)
+    {
+        return static_cast<std::uint8_t>(1u << static_cast<int>(type));
+    }
+
+    /**
+     * @brief Builds a new index from the edit map and publishes it atomically.
+     *
+     * The previous generation is retired, not freed, so readers still probing
+     * it stay safe; retired indexes are reclaimed when the ACL is destroyed.
+     */
+    void compile()
+    {
+        std::lock_guard lock(m_writeMutex);
+        if (!m_dirty.load(std::memory_order_acquire))
+        {
+            return; // Another thread compiled while we waited.
+        }
+        auto* fresh = new Index(++m_generation, m_edits);
+        const Index* old = m_index.exchange(fresh, std::memory_order_acq_rel);
+        if (old)
+        {
+            m_retired.push_back(old);
+        }
+        m_dirty.store(false, std::memory_order_release);
+    }
+
+    std::mutex m_writeMutex;                                  ///< Serializes edits and compiles.
+    std::unordered_map<std::uint64_t, std::uint8_t> m_edits;  ///< Pending policy, by packed key.
+    std::atomic<const Index*> m_index{nullptr};               ///< Published immutable index.
+    std::vector<const Index*> m_retired;                      ///< Old generations kept for in-flight readers.
+    std::atomic<bool> m_dirty{false};
+    std::uint64_t m_generation{0};
+};
+
+/**
+ * @brief Main function demonstrating the Access Control List (ACL) pattern.
  */
+int main()
+{
+    // Create users
+    auto user1 = std::make_shared<User>(1, "Alice");
+    auto user2 = std::make_shared<User>(2, "Bob");
+
+    // Create resources
+    auto resource1 = std::make_shared<Resource>(1, "Document1");
+    auto resource2 = std::make_shared<Resource>(2, "Document2");
+
+    // Create ACL and add permissions
+    AccessControlList acl;
+    acl.addPermission(user1, resource1, Permission(Permission::Type::READ));
+    acl.addPermission(user1, resource1, Permission(Permission::Type::WRITE));
+    acl.addPermission(user2, resource2, Permission(Permission::Type::READ));
+
+    // Check permissions
+    std::cout << "Alice has READ access to Document1: " << acl.hasPermission(user1, resource1, Permission(Permission::Type::READ)) << std::endl;
+    std::cout << "Alice has DELETE access to Document1: " << acl.hasPermission(user1, resource1, Permission(Permission::Type::DELETE)) << std::endl;
+    std::cout << "Bob has READ access to Document2: " << acl.hasPermission(user2, resource2, Permission(Permission::Type::READ)) << std::endl;
+
+    // A policy update swaps in a new generation; readers never block.
+    acl.addPermission(user2, resource1, Permission(Permission::Type::WRITE));
+    std::cout << "Bob has WRITE access to Document1: " << acl.hasPermission(user2, resource1, Permission(Permission::Type::WRITE)) << std::endl;
+    std::cout << "Index generation: " << acl.generation() << std::endl;
+
+    // Hot-path cost of the compiled index.
+    constexpr int checks = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    bool all = true;
+    for (int i = 0; i < checks; ++i)
+    {
+        all &= acl.hasPermission(user1, resource1, Permission(Permission::Type::READ));
+    }
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Checked " << checks << " permissions in " << nanos / checks << " ns each (all granted: " << all << ")\n";
 
- #include <iostream>
- #include <memory>
- #include <unordered_map>
- #include <string>
- #include <vector>
- #include <optional>
- 
- /**
-  * @brief A class representing a user in the system.
-  */
- class User
- {
- public:
-     /**
-      * @brief Constructs a User object.
-      * @param id The ID of the user.
-      * @param name The name of the user.
-      */
-     User(int id, const std::string& name)
-         : m_id(id), m_name(name)
-     {}
- 
-     /**
-      * @brief Gets the ID of the user.
-      * @return The ID of the user.
-      */
-     int getId() const { return m_id; }
- 
-     /**
-      * @brief Gets the name of the user.
-      * @return The name of the user.
-      */
-     const std::string& getName() const { return m_name; }
- 
- private:
-     int m_id;          ///< The ID of the user.
-     std::string m_name;///< The name of the user.
- };
- 
- /**
-  * @brief A class representing a resource in the system.
-  */
- class Resource
- {
- public:
-     /**
-      * @brief Constructs a Resource object.
-      * @param id The ID of the resource.
-      * @param name The name of the resource.
-      */
-     Resource(int id, const std::string& name)
-         : m_id(id), m_name(name)
-     {}
- 
-     /**
-      * @brief Gets the ID of the resource.
-      * @return The ID of the resource.
-      */
-     int getId() const { return m_id; }
- 
-     /**
-      * @brief Gets the name of the resource.
-      * @return The name of the resource.
-      */
-     const std::string& getName() const { return m_name; }
- 
- private:
-     int m_id;          ///< The ID of the resource.
-     std::string m_name;///< The name of the resource.
- };
- 
- /**
-  * @brief A class representing a permission (read, write, delete, etc.) associated with a resource.
-  */
- class Permission
- {
- public:
-     enum class Type
-     {
-         READ,
-         WRITE,
-         DELETE
-     };
- 
-     /**
-      * @brief Constructs a Permission object.
-      * @param type The type of permission (e.g., READ, WRITE, DELETE).
-      */
-     Permission(Type type)
-         : m_type(type)
-     {}
- 
-     /**
-      * @brief Gets the type of permission.
-      * @return The type of permission.
-      */
-     Type getType() const { return m_type; }
- 
- private:
-     Type m_type; ///< The type of permission.
- };
- 
- /**
-  * @brief A class that implements the Access Control List (ACL) pattern.
-  */
- class AccessControlList
- {
- public:
-     /**
-      * @brief Adds a permission for a user on a specific resource.
-      * @param user The user who will be granted the permission.
-      * @param resource The resource on which the user is granted the permission.
-      * @param permission The permission granted to the user on the resource.
-      */
-     void addPermission(const std::shared_ptr<User>& user, const std::shared_ptr<Resource>& resource, const Permission& permission)
-     {
-         m_permissions[user->getId()][resource->getId()].push_back(permission);
-     }
- 
-     /**
-      * @brief Checks if a user has a specific permission on a resource.
-      * @param user The user to check.
-      * @param resource The resource to check.
-      * @param permission The permission to check.
-      * @return true if the user has the permission, false otherwise.
-      */
-     bool hasPermission(const std::shared_ptr<User>& user, const std::shared_ptr<Resource>& resource, const Permission& permission)
-     {
-         auto userPermissions = m_permissions.find(user->getId());
-         if (userPermissions != m_permissions.end())
-         {
-             auto resourcePermissions = userPermissions->second.find(resource->getId());
-             if (resourcePermissions != userPermissions->second.end())
-             {
-                 for (const auto& p : resourcePermissions->second)
-                 {
-                     if (p.getType() == permission.getType())
-                     {
-                         return true;
-                     }
-                 }
-             }
-         }
-         return false;
-     }
- 
- private:
-     std::unordered_map<int, std::unordered_map<int, std::vector<Permission>>> m_permissions; ///< A map of user IDs to resource IDs to permissions.
- };
- 
- /**
-  * @brief Main function demonstrating the Access Control List (ACL) pattern.
-  */
- int main()
- {
-     // Create users
-     auto user1 = std::make_shared<User>(1, "Alice");
-     auto user2 = std::make_shared<User>(2, "Bob");
- 
-     // Create resources
-     auto resource1 = std::make_shared<Resource>(1, "Document1");
-     auto resource2 = std::make_shared<Resource>(2, "Document2");
- 
-     // Create ACL and add permissions
-     AccessControlList acl;
-     acl.addPermission(user1, resource1, Permission(Permission::Type::READ));
-     acl.addPermission(user1, resource1, Permission(Permission::Type::WRITE));
-     acl.addPermission(user2, resource2, Permission(Permission::Type::READ));
- 
-     // Check permissions
-     std::cout << "Alice has READ access to Document1: " << acl.hasPermission(user1, resource1, Permission(Permission::Type::READ)) << std::endl;
-     std::cout << "Alice has DELETE access to Document1: " << acl.hasPermission(user1, resource1, Permission(Permission::Type::DELETE)) << std::endl;
-     std::cout << "Bob has READ access to Document2: " << acl.hasPermission(user2, resource2, Permission(Permission::Type::READ)) << std::endl;
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
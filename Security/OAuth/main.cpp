@@ -3,178 +3,469 @@
  * The OAuth design pattern is a popular method for delegated access to resources. In OAuth, a client application is granted
  * access to a user's data on a server by using a token instead of credentials. OAuth allows third-party applications to
  * request authorization from the user to access resources on their behalf.
- * 
+ *
  * Key Concepts:
  * - Client: The application that is requesting access to the user's resources.
  * - Authorization Server: The server that issues tokens after authenticating the user.
  * - Resource Server: The server that holds the user's data and validates the token before granting access.
  * - Access Token: A token issued by the authorization server that allows the client to access the user's resources.
- * 
+ *
  * Benefits:
  * - Secure: OAuth allows third-party apps to access user data without exposing user credentials.
  * - Flexible: OAuth tokens can be scoped to specific actions, providing granular access.
  * - Decouples Authentication: Authentication is handled by the authorization server, and the client doesn't need to manage user credentials.
- * 
+ *
  * @note This is a simplified example to demonstrate OAuth concepts and does not cover all the complex details of a full OAuth flow.
+ *
+ * Validating every token by asking the issuing server is a network hop per
+ * request. The additions below cut that out three ways: self-validating
+ * tokens carry signed claims the resource server verifies locally with a
+ * cached key; opaque tokens go through a sharded introspection cache whose
+ * entries live exactly until the token expires; and the authorization server
+ * issues whole batches under one authentication so bulk service-account
+ * rotations are one amortized operation instead of thousands of serial
+ * grants.
  */
 
- #include <iostream>
- #include <memory>
- #include <string>
- #include <unordered_map>
- 
- /**
-  * @brief Represents an OAuth access token.
-  * 
-  * The access token is used to authenticate and authorize a client application to access the user's resources.
-  */
- class AccessToken
- {
- public:
-     AccessToken(const std::string &token, const std::string &scope)
-         : m_token(token), m_scope(scope) {}
- 
-     /**
-      * @brief Gets the access token string.
-      * @return The access token.
-      */
-     std::string getToken() const { return m_token; }
- 
-     /**
-      * @brief Gets the scope of the access token.
-      * @return The scope of the access token.
-      */
-     std::string getScope() const { return m_scope; }
- 
- private:
-     std::string m_token;  ///< Access token string
-     std::string m_scope;  ///< Scope of the access token (e.g., "read", "write")
- };
- 
- /**
-  * @brief Represents an authorization server that issues access tokens.
-  * 
-  * This server will authenticate the user and issue an access token for the client to access protected resources.
-  */
- class AuthorizationServer
- {
- public:
-     /**
-      * @brief Authenticates the user and issues an access token.
-      * @param clientId The client ID requesting authorization.
-      * @param clientSecret The client secret for authentication.
-      * @param scope The scope for which the access token is issued.
-      * @return A shared pointer to the issued access token.
-      */
-     std::shared_ptr<AccessToken> issueAccessToken(const std::string &clientId, const std::string &clientSecret, const std::string &scope)
-     {
-         // In a real implementation, clientId and clientSecret would be validated, and user authentication would occur here.
-         // This is a simplified example.
-         std::cout << "Authenticating client " << clientId << "...\n";
-         if (clientId == "trusted-client" && clientSecret == "secret")
-         {
-             std::cout << "Client authenticated successfully. Issuing access token...\n";
-             return std::make_shared<AccessToken>("sample_token_123", scope);  // Simulate issuing an access token.
-         }
-         std::cout << "Authentication failed for client " << clientId << ".\n";
-         return nullptr;
-     }
- };
- 
- /**
-  * @brief Represents a resource server that provides data to the client based on an access token.
-  * 
-  * The resource server will validate the access token and ensure that the client has the necessary scope to access the data.
-  */
- class ResourceServer
- {
- public:
-     /**
-      * @brief Validates the access token and returns the requested resource if valid.
-      * @param token The access token to validate.
-      * @param resource The resource to access.
-      * @return The requested resource if valid, otherwise an error message.
-      */
-     std::string accessResource(const std::shared_ptr<AccessToken> &token, const std::string &resource)
-     {
-         if (token && validateToken(token))
-         {
-             std::cout << "Token valid. Accessing resource: " << resource << "\n";
-             return "Resource Data for " + resource;  // Simulate returning the resource data.
-         }
-         std::cout << "Invalid token or insufficient scope.\n";
-         return "Access Denied";
-     }
- 
- private:
-     /**
-      * @brief Validates the provided access token.
-      * @param token The access token to validate.
-      * @return True if the token is valid, otherwise false.
-      */
-     bool validateToken(const std::shared_ptr<AccessToken> &token)
-     {
-         // For simplicity, this example only checks the token's existence and scope.
-         return token != nullptr && token->getScope() == "read";
-     }
- };
- 
- /**
-  * @brief Simulates the client application that interacts with the Authorization Server and the Resource Server.
-  * 
-  * The client will first request an access token from the Authorization Server and then use that token to access a resource
-  * from the Resource Server.
-  */
- class OAuthClient
- {
- public:
-     /**
-      * @brief Constructs an OAuth client with the provided authorization and resource servers.
-      * @param authServer The authorization server to request access tokens from.
-      * @param resourceServer The resource server to access data from.
-      */
-     OAuthClient(std::shared_ptr<AuthorizationServer> authServer, std::shared_ptr<ResourceServer> resourceServer)
-         : m_authServer(std::move(authServer)), m_resourceServer(std::move(resourceServer)) {}
- 
-     /**
-      * @brief Requests an access token from the authorization server and then accesses a resource from the resource server.
-      * @param clientId The client ID requesting authorization.
-      * @param clientSecret The client secret for authentication.
-      * @param scope The scope for the access token.
-      * @param resource The resource to access.
-      */
-     void performOAuthFlow(const std::string &clientId, const std::string &clientSecret, const std::string &scope, const std::string &resource)
-     {
-         // Request access token from authorization server
-         auto token = m_authServer->issueAccessToken(clientId, clientSecret, scope);
-         if (token)
-         {
-             // Use the access token to access the resource
-             std::string resourceData = m_resourceServer->accessResource(token, resource);
-             std::cout << "Resource data: " << resourceData << "\n";
-         }
-     }
- 
- private:
-     std::shared_ptr<AuthorizationServer> m_authServer; ///< The authorization server
-     std::shared_ptr<ResourceServer> m_resourceServer;  ///< The resource server
- };
- 
- /**
-  * @brief Main function to demonstrate the OAuth design pattern.
-  */
- int main()
- {
-     // Create the authorization server and resource server
-     auto authServer = std::make_shared<AuthorizationServer>();
-     auto resourceServer = std::make_shared<ResourceServer>();
- 
-     // Create the OAuth client
-     OAuthClient client(authServer, resourceServer);
- 
-     // Simulate the OAuth flow: Request an access token and access a resource
-     client.performOAuthFlow("trusted-client", "secret", "read", "user_profile");
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <array>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Represents an OAuth access token.
+ *
+ * The access token is used to authenticate and authorize a client application to access the user's resources.
+ */
+class AccessToken
+{
+public:
+    AccessToken(const std::string &token, const std::string &scope)
+        : m_token(token), m_scope(scope) {}
+
+    /**
+     * @brief Gets the access token string.
+     * @return The access token.
+     */
+    std::string getToken() const { return m_token; }
+
+    /**
+     * @brief Gets the scope of the access token.
+     * @return The scope of the access token.
+     */
+    std::string getScope() const { return m_scope; }
+
+private:
+    std::string m_token;  ///< Access token string
+    std::string m_scope;  ///< Scope of the access token (e.g., "read", "write")
+};
+
+/**
+ * @brief Represents an authorization server that issues access tokens.
+ *
+ * This server will authenticate the user and issue an access token for the client to access protected resources.
+ */
+class AuthorizationServer
+{
+public:
+    /**
+     * @brief Authenticates the user and issues an access token.
+     * @param clientId The client ID requesting authorization.
+     * @param clientSecret The client secret for authentication.
+     * @param scope The scope for which the access token is issued.
+     * @return A shared pointer to the issued access token.
+     */
+    std::shared_ptr<AccessToken> issueAccessToken(const std::string &clientId, const std::string &clientSecret, const std::string &scope)
+    {
+        // In a real implementation, clientId and clientSecret would be validated, and user authentication would occur here.
+        // This is a simplified example.
+        std::cout << "Authenticating client " << clientId << "...\n";
+        if (clientId == "trusted-client" && clientSecret == "secret")
+        {
+            std::cout << "Client authenticated successfully. Issuing access token...\n";
+            return std::make_shared<AccessToken>("sample_token_123", scope);  // Simulate issuing an access token.
+        }
+        std::cout << "Authentication failed for client " << clientId << ".\n";
+        return nullptr;
+    }
+};
+
+/**
+ * @brief Represents a resource server that provides data to the client based on an access token.
+ *
+ * The resource server will validate the access token and ensure that the client has the necessary scope to access the data.
+ */
+class ResourceServer
+{
+public:
+    /**
+     * @brief Validates the access token and returns the requested resource if valid.
+     * @param token The access token to validate.
+     * @param resource The resource to access.
+     * @return The requested resource if valid, otherwise an error message.
+     */
+    std::string accessResource(const std::shared_ptr<AccessToken> &token, const std::string &resource)
+    {
+        if (token && validateToken(token))
+        {
+            std::cout << "Token valid. Accessing resource: " << resource << "\n";
+            return "Resource Data for " + resource;  // Simulate returning the resource data.
+        }
+        std::cout << "Invalid token or insufficient scope.\n";
+        return "Access Denied";
+    }
+
+private:
+    /**
+     * @brief Validates the provided access token.
+     * @param token The access token to validate.
+     * @return True if the token is valid, otherwise false.
+     */
+    bool validateToken(const std::shared_ptr<AccessToken> &token)
+    {
+        // For simplicity, this example only checks the token's existence and scope.
+        return token != nullptr && token->getScope() == "read";
+    }
+};
+
+/// @brief Stands in for one network round trip of known latency.
+static void simulateNetworkHop(std::chrono::microseconds latency)
+{
+    std::this_thread::sleep_for(latency);
+}
+
+/// @brief FNV-1a over a string; the demo-grade signing primitive used below.
+static std::uint64_t fnvHash(std::uint64_t seed, std::string_view text)
+{
+    std::uint64_t hash = seed ^ 14695981039346656037ull;
+    for (char c : text)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief A self-validating token: signed claims, verifiable without a hop.
+ */
+struct SignedToken
+{
+    std::string clientId;
+    std::string scope;
+    std::uint64_t serial;                          ///< Unique per token.
+    std::chrono::steady_clock::time_point expiry;
+    std::uint64_t signature;                       ///< Over all claims, keyed.
+};
+
+/**
+ * @brief Authorization server with signed tokens and batched issuance.
+ *
+ * Each grant pays a client-authentication overhead; issueBatch()
+ * authenticates once and then only mints, so a 10k-token rotation is one
+ * amortized operation. Opaque tokens remain introspectable — at the cost
+ * of a network hop per introspection.
+ */
+class FastAuthorizationServer
+{
+public:
+    static constexpr auto AUTH_OVERHEAD = std::chrono::microseconds(50);      ///< Per grant.
+    static constexpr auto INTROSPECTION_HOP = std::chrono::microseconds(200); ///< Per remote check.
+
+    /// @brief Issues one signed token; pays the full grant overhead.
+    SignedToken issueSigned(const std::string& clientId, const std::string& scope,
+                            std::chrono::milliseconds timeToLive)
+    {
+        simulateNetworkHop(AUTH_OVERHEAD); // Client authentication + audit.
+        return mint(clientId, scope, timeToLive);
+    }
+
+    /// @brief Issues count tokens under a single authentication.
+    std::vector<SignedToken> issueBatch(const std::string& clientId, const std::string& scope,
+                                        std::chrono::milliseconds timeToLive, std::size_t count)
+    {
+        simulateNetworkHop(AUTH_OVERHEAD); // Once for the whole rotation.
+        std::vector<SignedToken> batch;
+        batch.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            batch.push_back(mint(clientId, scope, timeToLive));
+        }
+        return batch;
+    }
+
+    /// @brief Issues an opaque token; validity lives only on this server.
+    std::string issueOpaque(const std::string& clientId, std::chrono::milliseconds timeToLive)
+    {
+        simulateNetworkHop(AUTH_OVERHEAD);
+        std::string token = "opaque-" + clientId + "-" + std::to_string(++m_serialCounter);
+        m_opaqueExpiry[token] = std::chrono::steady_clock::now() + timeToLive;
+        return token;
+    }
+
+    /**
+     * @brief Remote introspection: the network hop the cache exists to avoid.
+     * @return Whether the token is known and unexpired, plus its expiry.
+     */
+    bool introspect(const std::string& token, std::chrono::steady_clock::time_point& expiryOut)
+    {
+        simulateNetworkHop(INTROSPECTION_HOP);
+        ++m_introspections;
+        auto it = m_opaqueExpiry.find(token);
+        if (it == m_opaqueExpiry.end() || std::chrono::steady_clock::now() >= it->second)
+        {
+            return false;
+        }
+        expiryOut = it->second;
+        return true;
+    }
+
+    /// @brief The key resource servers cache to verify signatures locally.
+    std::uint64_t validationKey() const { return m_signingKey; }
+
+    std::size_t introspections() const { return m_introspections; }
+
+private:
+    /// @brief Builds and signs one token; no authentication cost here.
+    SignedToken mint(const std::string& clientId, const std::string& scope,
+                     std::chrono::milliseconds timeToLive)
+    {
+        SignedToken token;
+        token.clientId = clientId;
+        token.scope = scope;
+        token.serial = ++m_serialCounter;
+        token.expiry = std::chrono::steady_clock::now() + timeToLive;
+        token.signature = sign(token, m_signingKey);
+        return token;
+    }
+
+public:
+    /// @brief Signature over every claim; shared with resource servers.
+    static std::uint64_t sign(const SignedToken& token, std::uint64_t key)
+    {
+        std::uint64_t hash = fnvHash(key, token.clientId);
+        hash = fnvHash(hash, token.scope);
+        hash ^= token.serial * 1099511628211ull;
+        hash ^= static_cast<std::uint64_t>(token.expiry.time_since_epoch().count());
+        return hash;
+    }
+
+private:
+    std::uint64_t m_signingKey{0x5eed5eed5eed5eedull}; ///< Demo-grade key.
+    std::uint64_t m_serialCounter{0};
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> m_opaqueExpiry;
+    std::size_t m_introspections{0};
+};
+
+/**
+ * @brief Resource server validating locally and caching introspections.
+ *
+ * Signed tokens are verified with the cached key — no hop at all. Opaque
+ * tokens hit a sharded cache first; entries carry the token's own expiry
+ * as their TTL, so a cached verdict can never outlive the token.
+ */
+class CachedResourceServer
+{
+public:
+    static constexpr std::size_t SHARD_COUNT = 8;
+
+    explicit CachedResourceServer(std::shared_ptr<FastAuthorizationServer> authServer)
+        : m_authServer(std::move(authServer)),
+          m_cachedKey(m_authServer->validationKey()) // Fetched once, reused forever.
+    {}
+
+    /// @brief Local check: recompute the signature and check expiry. No hop.
+    bool validateSigned(const SignedToken& token) const
+    {
+        return token.signature == FastAuthorizationServer::sign(token, m_cachedKey)
+            && std::chrono::steady_clock::now() < token.expiry;
+    }
+
+    /**
+     * @brief Opaque validation through the sharded introspection cache.
+     */
+    bool validateOpaque(const std::string& token)
+    {
+        auto now = std::chrono::steady_clock::now();
+        Shard& shard = m_shards[fnvHash(0, token) % SHARD_COUNT];
+        {
+            std::lock_guard lock(shard.mutex);
+            auto it = shard.entries.find(token);
+            if (it != shard.entries.end() && now < it->second)
+            {
+                ++shard.hits;
+                return true; // Cached verdict, still within the token's lifetime.
+            }
+        }
+        std::chrono::steady_clock::time_point expiry;
+        if (!m_authServer->introspect(token, expiry))
+        {
+            return false; // Negative verdicts are not cached: revocation stays prompt.
+        }
+        std::lock_guard lock(shard.mutex);
+        shard.entries[token] = expiry; // TTL is the token's own expiry.
+        return true;
+    }
+
+    std::size_t cacheHits() const
+    {
+        std::size_t total = 0;
+        for (const Shard& shard : m_shards)
+        {
+            total += shard.hits;
+        }
+        return total;
+    }
+
+private:
+    /**
+     * @brief One cache shard; independent lock, so lookups rarely contend.
+     */
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::chrono::steady_clock::time_point> entries;
+        std::size_t hits{0};
+    };
+
+    std::shared_ptr<FastAuthorizationServer> m_authServer;
+    std::uint64_t m_cachedKey; ///< Validation key, cached at construction.
+    std::array<Shard, SHARD_COUNT> m_shards;
+};
+
+/**
+ * @brief Simulates the client application that interacts with the Authorization Server and the Resource Server.
+ *
+ * The client will first request an access token from the Authorization Server and then use that token to access a resource
+ * from the Resource Server.
+ */
+class OAuthClient
+{
+public:
+    /**
+     * @brief Constructs an OAuth client with the provided authorization and resource servers.
+     * @param authServer The authorization server to request access tokens from.
+     * @param resourceServer The resource server to access data from.
+     */
+    OAuthClient(std::shared_ptr<AuthorizationServer> authServer, std::shared_ptr<ResourceServer> resourceServer)
+        : m_authServer(std::move(authServer)), m_resourceServer(std::move(resourceServer)) {}
+
+    /**
+     * @brief Requests an access token from the authorization server and then accesses a resource from the resource server.
+     * @param clientId The client ID requesting authorization.
+     * @param clientSecret The client secret for authentication.
+     * @param scope The scope for the access token.
+     * @param resource The resource to access.
+     */
+    void performOAuthFlow(const std::string &clientId, const std::string &clientSecret, const std::string &scope, const std::string &resource)
+    {
+        // Request access token from authorization server
+        auto token = m_authServer->issueAccessToken(clientId, clientSecret, scope);
+        if (token)
+        {
+            // Use the access token to access the resource
+            std::string resourceData = m_resourceServer->accessResource(token, resource);
+            std::cout << "Resource data: " << resourceData << "\n";
+        }
+    }
+
+private:
+    std::shared_ptr<AuthorizationServer> m_authServer; ///< The authorization server
+    std::shared_ptr<ResourceServer> m_resourceServer;  ///< The resource server
+};
+
+/**
+ * @brief Main function to demonstrate the OAuth design pattern.
+ */
+int main()
+{
+    // Create the authorization server and resource server
+    auto authServer = std::make_shared<AuthorizationServer>();
+    auto resourceServer = std::make_shared<ResourceServer>();
+
+    // Create the OAuth client
+    OAuthClient client(authServer, resourceServer);
+
+    // Simulate the OAuth flow: Request an access token and access a resource
+    client.performOAuthFlow("trusted-client", "secret", "read", "user_profile");
+
+    // Validation modes: remote introspection vs cache vs local signatures.
+    constexpr std::size_t requestCount = 2000;
+    constexpr std::size_t activeTokens = 20;
+    const auto tokenLifetime = std::chrono::milliseconds(60000);
+
+    auto fastAuth = std::make_shared<FastAuthorizationServer>();
+    CachedResourceServer cachedResource(fastAuth);
+
+    std::vector<std::string> opaqueTokens;
+    for (std::size_t i = 0; i < activeTokens; ++i)
+    {
+        opaqueTokens.push_back(fastAuth->issueOpaque("service-account", tokenLifetime));
+    }
+
+    // Remote-only: every request is an introspection hop.
+    auto start = std::chrono::steady_clock::now();
+    std::size_t remoteValid = 0;
+    for (std::size_t i = 0; i < requestCount; ++i)
+    {
+        std::chrono::steady_clock::time_point expiry;
+        remoteValid += fastAuth->introspect(opaqueTokens[i % activeTokens], expiry) ? 1 : 0;
+    }
+    double remoteTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Cached: one hop per distinct token, then shard-local hits.
+    start = std::chrono::steady_clock::now();
+    std::size_t cachedValid = 0;
+    for (std::size_t i = 0; i < requestCount; ++i)
+    {
+        cachedValid += cachedResource.validateOpaque(opaqueTokens[i % activeTokens]) ? 1 : 0;
+    }
+    double cachedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Self-validating: signature recomputed locally with the cached key.
+    SignedToken signedToken = fastAuth->issueSigned("service-account", "read", tokenLifetime);
+    start = std::chrono::steady_clock::now();
+    std::size_t signedValid = 0;
+    for (std::size_t i = 0; i < requestCount; ++i)
+    {
+        signedValid += cachedResource.validateSigned(signedToken) ? 1 : 0;
+    }
+    double signedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    SignedToken tampered = signedToken;
+    tampered.scope = "write";
+
+    std::cout << requestCount << " validation(s): remote " << remoteTime << " ms, cached "
+              << cachedTime << " ms (" << cachedResource.cacheHits() << " hit(s)), local signed "
+              << signedTime << " ms (valid " << remoteValid << "/" << cachedValid << "/"
+              << signedValid << ", tampered "
+              << (cachedResource.validateSigned(tampered) ? "accepted" : "rejected") << ")\n";
+
+    // Bulk rotation: serial grants vs one batched issuance.
+    constexpr std::size_t rotationSize = 2000;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < rotationSize; ++i)
+    {
+        fastAuth->issueSigned("service-account", "read", tokenLifetime);
+    }
+    double serialIssue = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    auto rotated = fastAuth->issueBatch("service-account", "read", tokenLifetime, rotationSize);
+    double batchIssue = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << rotationSize << " token rotation: serial grants " << serialIssue
+              << " ms, batched issuance " << batchIssue << " ms ("
+              << rotated.size() << " token(s))" << std::endl;
+
+    return 0;
+}
@@ -3,158 +3,354 @@
  * The Permission-based Access Control (PBAC) design pattern provides a method for controlling access to system resources
  * based on a user's role and permissions. The pattern helps ensure that users can only access resources or perform actions
  * they are authorized for, thereby improving system security.
- * 
+ *
  * Key Concepts:
  * - Roles: Represent categories or groups that users belong to (e.g., "Admin", "User", "Manager").
  * - Permissions: Define what actions a role can perform on specific resources (e.g., "read", "write").
  * - Access Control: Ensures that only authorized users can access resources based on their roles and permissions.
- * 
+ *
  * Benefits:
  * - Fine-Grained Security: Allows precise control over who can access what resources.
  * - Flexible: Permissions can be easily added or removed from roles, making it adaptable to changing security requirements.
  * - Centralized Management: Permissions are managed centrally, simplifying security management and auditing.
+ *
+ * Answering a permission check by walking roles and comparing permission
+ * strings is far too slow for a per-API-call authz layer. The compiled
+ * representation below interns permissions to dense integer ids at
+ * registration, stores each role's grants as a fixed bitset, and caches on
+ * each user the OR of its roles' bitsets — rebuilt lazily when a role's
+ * generation counter shows it changed — so hasPermission() is a single bit
+ * test.
  */
 
- #include <iostream>
- #include <memory>
- #include <string>
- #include <unordered_map>
- #include <vector>
- 
- /**
-  * @brief Represents a permission in the system.
-  * 
-  * A permission defines an action that can be performed on a resource (e.g., "read", "write").
-  */
- class Permission
- {
- public:
-     Permission(const std::string &action) : m_action(action) {}
- 
-     /**
-      * @brief Gets the action associated with the permission.
-      * @return The action as a string.
-      */
-     std::string getAction() const { return m_action; }
- 
- private:
-     std::string m_action; ///< The action (e.g., "read", "write")
- };
- 
- /**
-  * @brief Represents a role in the system.
-  * 
-  * A role groups permissions together and assigns them to users.
-  */
- class Role
- {
- public:
-     Role(const std::string &roleName) : m_roleName(roleName) {}
- 
-     /**
-      * @brief Adds a permission to the role.
-      * @param permission The permission to add to the role.
-      */
-     void addPermission(const std::shared_ptr<Permission> &permission)
-     {
-         m_permissions.push_back(permission);
-     }
- 
-     /**
-      * @brief Checks if the role has the given permission.
-      * @param permission The permission to check.
-      * @return True if the role has the permission, otherwise false.
-      */
-     bool hasPermission(const std::shared_ptr<Permission> &permission) const
-     {
-         for (const auto &perm : m_permissions)
-         {
-             if (perm->getAction() == permission->getAction())
-             {
-                 return true;
-             }
-         }
-         return false;
-     }
- 
-     /**
-      * @brief Gets the role name.
-      * @return The name of the role.
-      */
-     std::string getRoleName() const { return m_roleName; }
- 
- private:
-     std::string m_roleName;                             ///< The name of the role (e.g., "Admin")
-     std::vector<std::shared_ptr<Permission>> m_permissions; ///< Permissions assigned to the role
- };
- 
- /**
-  * @brief Represents a user in the system.
-  * 
-  * A user has a role, and the permissions granted to the user are based on their role.
-  */
- class User
- {
- public:
-     User(const std::string &userName, const std::shared_ptr<Role> &role)
-         : m_userName(userName), m_role(role) {}
- 
-     /**
-      * @brief Checks if the user has a specific permission based on their role.
-      * @param permission The permission to check.
-      * @return True if the user has the permission, otherwise false.
-      */
-     bool hasPermission(const std::shared_ptr<Permission> &permission) const
-     {
-         return m_role->hasPermission(permission);
-     }
- 
-     /**
-      * @brief Gets the username.
-      * @return The username.
-      */
-     std::string getUserName() const { return m_userName; }
- 
- private:
-     std::string m_userName;           ///< The username
-     std::shared_ptr<Role> m_role;     ///< The role assigned to the user
- };
- 
- /**
-  * @brief Main function to demonstrate the PBAC design pattern.
-  * 
-  * In this example, we create roles, assign permissions to them, and then check if users have those permissions.
-  */
- int main()
- {
-     // Create permissions
-     auto readPermission = std::make_shared<Permission>("read");
-     auto writePermission = std::make_shared<Permission>("write");
- 
-     // Create roles
-     auto adminRole = std::make_shared<Role>("Admin");
-     adminRole->addPermission(readPermission);
-     adminRole->addPermission(writePermission);
- 
-     auto userRole = std::make_shared<Role>("User");
-     userRole->addPermission(readPermission);
- 
-     // Create users
-     auto adminUser = std::make_shared<User>("admin_user", adminRole);
-     auto normalUser = std::make_shared<User>("normal_user", userRole);
- 
-     // Check permissions for admin user
-     std::cout << adminUser->getUserName() << " has read permission: "
-               << (adminUser->hasPermission(readPermission) ? "Yes" : "No") << "\n";
-     std::cout << adminUser->getUserName() << " has write permission: "
-               << (adminUser->hasPermission(writePermission) ? "Yes" : "No") << "\n";
- 
-     // Check permissions for normal user
-     std::cout << normalUser->getUserName() << " has read permission: "
-               << (normalUser->hasPermission(readPermission) ? "Yes" : "No") << "\n";
-     std::cout << normalUser->getUserName() << " has write permission: "
-               << (normalUser->hasPermission(writePermission) ? "Yes" : "No") << "\n";
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <bitset>
+#include <optional>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Represents a permission in the system.
+ *
+ * A permission defines an action that can be performed on a resource (e.g., "read", "write").
+ */
+class Permission
+{
+public:
+    Permission(const std::string &action) : m_action(action) {}
+
+    /**
+     * @brief Gets the action associated with the permission.
+     * @return The action as a string.
+     */
+    std::string getAction() const { return m_action; }
+
+private:
+    std::string m_action; ///< The action (e.g., "read", "write")
+};
+
+/**
+ * @brief Represents a role in the system.
+ *
+ * A role groups permissions together and assigns them to users.
+ */
+class Role
+{
+public:
+    Role(const std::string &roleName) : m_roleName(roleName) {}
+
+    /**
+     * @brief Adds a permission to the role.
+     * @param permission The permission to add to the role.
+     */
+    void addPermission(const std::shared_ptr<Permission> &permission)
+    {
+        m_permissions.push_back(permission);
+    }
+
+    /**
+     * @brief Checks if the role has the given permission.
+     * @param permission The permission to check.
+     * @return True if the role has the permission, otherwise false.
+     */
+    bool hasPermission(const std::shared_ptr<Permission> &permission) const
+    {
+        for (const auto &perm : m_permissions)
+        {
+            if (perm->getAction() == permission->getAction())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Gets the role name.
+     * @return The name of the role.
+     */
+    std::string getRoleName() const { return m_roleName; }
+
+private:
+    std::string m_roleName;                             ///< The name of the role (e.g., "Admin")
+    std::vector<std::shared_ptr<Permission>> m_permissions; ///< Permissions assigned to the role
+};
+
+/**
+ * @brief Represents a user in the system.
+ *
+ * A user has a role, and the permissions granted to the user are based on their role.
+ */
+class User
+{
+public:
+    User(const std::string &userName, const std::shared_ptr<Role> &role)
+        : m_userName(userName), m_role(role) {}
+
+    /**
+     * @brief Checks if the user has a specific permission based on their role.
+     * @param permission The permission to check.
+     * @return True if the user has the permission, otherwise false.
+     */
+    bool hasPermission(const std::shared_ptr<Permission> &permission) const
+    {
+        return m_role->hasPermission(permission);
+    }
+
+    /**
+     * @brief Gets the username.
+     * @return The username.
+     */
+    std::string getUserName() const { return m_userName; }
+
+private:
+    std::string m_userName;           ///< The username
+    std::shared_ptr<Role> m_role;     ///< The role assigned to the user
+};
+
+/**
+ * @brief Interns permission actions to dense integer ids at registration.
+ */
+class PermissionRegistry
+{
+public:
+    static constexpr std::size_t MAX_PERMISSIONS = 256; ///< Bitset width.
+
+    using PermissionId = std::size_t;
+    using PermissionMask = std::bitset<MAX_PERMISSIONS>;
+
+    /// @brief Returns the action's dense id, interning it on first sight.
+    PermissionId intern(std::string_view action)
+    {
+        auto it = m_ids.find(std::string(action));
+        if (it != m_ids.end())
+        {
+            return it->second;
+        }
+        PermissionId id = m_ids.size();
+        m_ids.emplace(std::string(action), id);
+        return id;
+    }
+
+    /// @brief The id of an already-registered action, if any.
+    std::optional<PermissionId> lookup(std::string_view action) const
+    {
+        auto it = m_ids.find(std::string(action));
+        if (it == m_ids.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    std::size_t size() const { return m_ids.size(); }
+
+private:
+    std::unordered_map<std::string, PermissionId> m_ids; ///< Action -> dense id.
+};
+
+/**
+ * @brief A role compiled to one fixed bitset of granted permission ids.
+ *
+ * Every grant or revoke bumps the generation counter so user-side caches
+ * know to rebuild.
+ */
+class CompiledRole
+{
+public:
+    CompiledRole(std::string roleName, PermissionRegistry& registry)
+        : m_roleName(std::move(roleName)), m_registry(&registry)
+    {}
+
+    void grant(std::string_view action)
+    {
+        m_mask.set(m_registry->intern(action));
+        ++m_generation;
+    }
+
+    void revoke(std::string_view action)
+    {
+        if (auto id = m_registry->lookup(action))
+        {
+            m_mask.reset(*id);
+            ++m_generation;
+        }
+    }
+
+    const PermissionRegistry::PermissionMask& mask() const { return m_mask; }
+    std::uint64_t generation() const { return m_generation; }
+    const std::string& getRoleName() const { return m_roleName; }
+
+private:
+    std::string m_roleName;
+    PermissionRegistry* m_registry;
+    PermissionRegistry::PermissionMask m_mask; ///< One bit per granted permission.
+    std::uint64_t m_generation{0};             ///< Bumped on every grant/revoke.
+};
+
+/**
+ * @brief A user caching the OR of its roles' bitsets.
+ *
+ * hasPermission() is a generation check plus one bit test; the combined
+ * mask is rebuilt only after a role actually changed.
+ */
+class CompiledUser
+{
+public:
+    CompiledUser(std::string userName, std::vector<std::shared_ptr<CompiledRole>> roles)
+        : m_userName(std::move(userName)), m_roles(std::move(roles))
+    {
+        rebuild();
+    }
+
+    /// @brief Single bit test; rebuilds the cached mask if a role changed.
+    bool hasPermission(PermissionRegistry::PermissionId id) const
+    {
+        std::uint64_t generationSum = 0;
+        for (const auto& role : m_roles)
+        {
+            generationSum += role->generation();
+        }
+        if (generationSum != m_cachedGenerationSum)
+        {
+            rebuild();
+        }
+        return m_cachedMask.test(id);
+    }
+
+    const std::string& getUserName() const { return m_userName; }
+
+private:
+    /// @brief Re-ORs the role masks and records the generations they had.
+    void rebuild() const
+    {
+        m_cachedMask.reset();
+        m_cachedGenerationSum = 0;
+        for (const auto& role : m_roles)
+        {
+            m_cachedMask |= role->mask();
+            m_cachedGenerationSum += role->generation();
+        }
+    }
+
+    std::string m_userName;
+    std::vector<std::shared_ptr<CompiledRole>> m_roles;
+    mutable PermissionRegistry::PermissionMask m_cachedMask; ///< OR of the role masks.
+    mutable std::uint64_t m_cachedGenerationSum{0};          ///< Validity stamp.
+};
+
+/**
+ * @brief Main function to demonstrate the PBAC design pattern.
+ *
+ * In this example, we create roles, assign permissions to them, and then check if users have those permissions.
+ */
+int main()
+{
+    // Create permissions
+    auto readPermission = std::make_shared<Permission>("read");
+    auto writePermission = std::make_shared<Permission>("write");
+
+    // Create roles
+    auto adminRole = std::make_shared<Role>("Admin");
+    adminRole->addPermission(readPermission);
+    adminRole->addPermission(writePermission);
+
+    auto userRole = std::make_shared<Role>("User");
+    userRole->addPermission(readPermission);
+
+    // Create users
+    auto adminUser = std::make_shared<User>("admin_user", adminRole);
+    auto normalUser = std::make_shared<User>("normal_user", userRole);
+
+    // Check permissions for admin user
+    std::cout << adminUser->getUserName() << " has read permission: "
+              << (adminUser->hasPermission(readPermission) ? "Yes" : "No") << "\n";
+    std::cout << adminUser->getUserName() << " has write permission: "
+              << (adminUser->hasPermission(writePermission) ? "Yes" : "No") << "\n";
+
+    // Check permissions for normal user
+    std::cout << normalUser->getUserName() << " has read permission: "
+              << (normalUser->hasPermission(readPermission) ? "Yes" : "No") << "\n";
+    std::cout << normalUser->getUserName() << " has write permission: "
+              << (normalUser->hasPermission(writePermission) ? "Yes" : "No") << "\n";
+
+    // Compiled mode: dense ids and bitsets against nested string scans.
+    constexpr int checkCount = 2000000;
+    constexpr int permissionsPerRole = 30;
+
+    // Baseline roles with string permission collections.
+    auto heavyRole = std::make_shared<Role>("Reporting");
+    std::vector<std::shared_ptr<Permission>> permissions;
+    for (int i = 0; i < permissionsPerRole; ++i)
+    {
+        permissions.push_back(std::make_shared<Permission>("resource.action." + std::to_string(i)));
+        heavyRole->addPermission(permissions.back());
+    }
+    auto heavyUser = std::make_shared<User>("report_user", heavyRole);
+
+    auto start = std::chrono::steady_clock::now();
+    int stringGranted = 0;
+    for (int i = 0; i < checkCount; ++i)
+    {
+        stringGranted += heavyUser->hasPermission(permissions[i % permissionsPerRole]) ? 1 : 0;
+    }
+    double stringTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    PermissionRegistry registry;
+    auto compiledRole = std::make_shared<CompiledRole>("Reporting", registry);
+    std::vector<PermissionRegistry::PermissionId> permissionIds;
+    for (int i = 0; i < permissionsPerRole; ++i)
+    {
+        std::string action = "resource.action." + std::to_string(i);
+        compiledRole->grant(action);
+        permissionIds.push_back(*registry.lookup(action)); // Interned once, checked by id.
+    }
+    CompiledUser compiledUser("report_user", {compiledRole});
+
+    start = std::chrono::steady_clock::now();
+    int bitGranted = 0;
+    for (int i = 0; i < checkCount; ++i)
+    {
+        bitGranted += compiledUser.hasPermission(permissionIds[i % permissionsPerRole]) ? 1 : 0;
+    }
+    double bitTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << checkCount << " check(s): string scans " << stringTime << " ms, bit tests "
+              << bitTime << " ms (granted " << stringGranted << " / " << bitGranted << ")\n";
+
+    // A role change invalidates the user's cached mask via the generation.
+    compiledRole->revoke("resource.action.0");
+    std::cout << "After revoke: action.0 "
+              << (compiledUser.hasPermission(permissionIds[0]) ? "granted" : "denied")
+              << ", action.1 "
+              << (compiledUser.hasPermission(permissionIds[1]) ? "granted" : "denied")
+              << std::endl;
+
+    return 0;
+}
@@ -11,153 +11,327 @@
  * - **Decentralized**: The client can authenticate itself without relying on session storage on the server.
  * - **Security**: Tokens are often signed and can be encrypted, providing secure communication between client and server.
  * - **Flexibility**: Tokens can contain more information, allowing for richer interactions and fine-grained authorization.
+ *
+ * Validation is built for the hot path: tokens carry a self-contained signed payload that is
+ * verified by recomputing the signature — no issued-token lookup at all. Recently validated
+ * tokens land in a sharded cache keyed by token hash, and revocation is checked against a
+ * Bloom bitmap of atomic words, so the revocation test is O(1) and lock-free for readers.
+ */
+
+#include <iostream>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <ctime>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+
+/**
+ * @brief Represents a user in the system.
+ */
+class User
+{
+public:
+    /**
+     * @brief Constructs a User object.
+     * @param id The ID of the user.
+     * @param name The name of the user.
+     */
+    User(int id, const std::string& name)
+        : m_id(id), m_name(name)
+    {}
+
+    /**
+     * @brief Gets the ID of the user.
+     * @return The ID of the user.
+     */
+    int getId() const { return m_id; }
+
+    /**
+     * @brief Gets the name of the user.
+     * @return The name of the user.
+     */
+    const std::string& getName() const { return m_name; }
+
+private:
+    int m_id;            ///< The ID of the user.
+    std::string m_name;  ///< The name of the user.
+};
+
+/**
+ * @brief A class to represent a token used for authentication.
+ */
+class Token
+{
+public:
+    /**
+     * @brief Constructs a Token object.
+     * @param user The user for whom the token is created.
+     * @param expirationTime The expiration time for the token.
+     */
+    Token(const std::shared_ptr<User>& user, const std::chrono::system_clock::time_point& expirationTime)
+        : m_user(user), m_expirationTime(expirationTime)
+    {
+        generateToken();
+    }
+
+    /**
+     * @brief Generates a simple token by encoding user info and expiration time.
+     * This is a simplified version, in real systems, it would be signed and possibly encrypted.
+     */
+    void generateToken()
+    {
+        std::ostringstream oss;
+        oss << m_user->getId() << ":" << m_user->getName() << ":"
+            << std::chrono::duration_cast<std::chrono::seconds>(m_expirationTime.time_since_epoch()).count();
+        m_token = oss.str();
+    }
+
+    /**
+     * @brief Appends the issuer's signature, making the token self-contained.
+     * @param signature Signature over the payload computed by the issuer.
+     */
+    void sign(std::uint64_t signature)
+    {
+        std::ostringstream oss;
+        oss << m_token << ":" << std::hex << signature;
+        m_token = oss.str();
+    }
+
+    /**
+     * @brief The payload portion (everything before the signature).
+     */
+    std::string payload() const
+    {
+        return m_token.substr(0, m_token.rfind(':'));
+    }
+
+    /**
+     * @brief The signature portion, parsed back to an integer.
+     */
+    std::uint64_t signature() const
+    {
+        return std::stoull(m_token.substr(m_token.rfind(':') + 1), nullptr, 16);
+    }
+
+    /**
+     * @brief Expiration time, decoded straight from the token itself.
+     */
+    std::chrono::system_clock::time_point expiration() const { return m_expirationTime; }
+
+    /**
+     * @brief Gets the token string.
+     * @return The token string.
+     */
+    const std::string& getToken() const { return m_token; }
+
+    /**
+     * @brief Checks if the token is expired.
+     * @return true if the token is expired, false otherwise.
+     */
+    bool isExpired() const
+    {
+        return std::chrono::system_clock::now() > m_expirationTime;
+    }
+
+private:
+    std::shared_ptr<User> m_user;              ///< The user associated with the token.
+    std::chrono::system_clock::time_point m_expirationTime; ///< The expiration time of the token.
+    std::string m_token;                       ///< The generated token string.
+};
+
+/**
+ * @brief A class that handles authentication using token-based methods.
+ *
+ * verifyToken() never searches an issued-token collection. The check order is:
+ * revocation Bloom bitmap (lock-free atomic reads), then the sharded cache of
+ * recently validated tokens (keyed by token hash), then — only on a cache
+ * miss — recomputation of the token's signature from its own payload.
+ */
+class AuthenticationService
+{
+public:
+    static constexpr std::size_t CACHE_SHARDS = 4;
+
+    explicit AuthenticationService(std::uint64_t secret = 0x5eed5eed5eed5eedull)
+        : m_secret(secret)
+    {}
+
+    /**
+     * @brief Authenticates a user and generates a signed token.
+     * @param user The user to authenticate.
+     * @return The generated authentication token.
+     */
+    std::shared_ptr<Token> authenticate(const std::shared_ptr<User>& user)
+    {
+        auto expirationTime = std::chrono::system_clock::now() + std::chrono::minutes(30);  // Token valid for 30 minutes
+        auto token = std::make_shared<Token>(user, expirationTime);
+        token->sign(signPayload(token->getToken())); // The whole unsigned token is the payload.
+        return token;
+    }
+
+    /**
+     * @brief Verifies if a token is valid.
+     * @param token The token to validate.
+     * @return true if the token is valid, unrevoked and not expired, false otherwise.
+     */
+    bool verifyToken(const std::shared_ptr<Token>& token)
+    {
+        std::uint64_t tokenHash = hashString(token->getToken());
+
+        if (maybeRevoked(tokenHash))
+        {
+            return false; // Bloom filter may rarely reject an unrevoked token, never the reverse.
+        }
+
+        // Sharded cache of recently validated tokens.
+        CacheShard& shard = m_shards[tokenHash % CACHE_SHARDS];
+        {
+            std::lock_guard lock(shard.mutex);
+            auto it = shard.entries.find(tokenHash);
+            if (it != shard.entries.end() && std::chrono::system_clock::now() <= it->second)
+            {
+                m_cacheHits.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        // Slow path: the token proves itself — recompute the signature.
+        m_signatureChecks.fetch_add(1, std::memory_order_relaxed);
+        if (token->isExpired() || token->signature() != signPayload(token->payload()))
+        {
+            return false;
+        }
+
+        std::lock_guard lock(shard.mutex);
+        shard.entries[tokenHash] = token->expiration();
+        return true;
+    }
+
+    /**
+     * @brief Revokes a token: sets its Bloom bits and drops it from the cache.
+     */
+    void revoke(const std::shared_ptr<Token>& token)
+    {
+        std::uint64_t tokenHash = hashString(token->getToken());
+        for (std::size_t probe = 0; probe < BLOOM_PROBES; ++probe)
+        {
+            std::uint64_t bit = bloomBit(tokenHash, probe);
+            m_revokedBloom[bit / 64].fetch_or(1ull << (bit % 64), std::memory_order_release);
+        }
+        CacheShard& shard = m_shards[tokenHash % CACHE_SHARDS];
+        std::lock_guard lock(shard.mutex);
+        shard.entries.erase(tokenHash);
+    }
+
+    std::size_t cacheHits() const { return m_cacheHits.load(); }
+    std::size_t signatureChecks() const { return m_signatureChecks.load(); }
+
+private:
+    static constexpr std::size_t BLOOM_BITS = 4096;
+    static constexpr std::size_t BLOOM_PROBES = 2;
+
+    /**
+     * @brief One slice of the validation cache with its own lock.
+     */
+    struct CacheShard
+    {
+        std::mutex mutex;
+        std::unordered_map<std::uint64_t, std::chrono::system_clock::time_point> entries; ///< hash -> expiry
+    };
+
+    /**
+     * @brief FNV-1a over the payload mixed with the server secret (demo MAC).
+     */
+    std::uint64_t signPayload(const std::string& payload) const
+    {
+        return hashString(payload) ^ (m_secret * 0x9e3779b97f4a7c15ull);
+    }
+
+    static std::uint64_t hashString(const std::string& text)
+    {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        for (char c : text)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    static std::uint64_t bloomBit(std::uint64_t hash, std::size_t probe)
+    {
+        return (hash >> (probe * 17)) % BLOOM_BITS;
+    }
+
+    /**
+     * @brief Lock-free revocation check: a couple of atomic word reads.
+     */
+    bool maybeRevoked(std::uint64_t tokenHash) const
+    {
+        for (std::size_t probe = 0; probe < BLOOM_PROBES; ++probe)
+        {
+            std::uint64_t bit = bloomBit(tokenHash, probe);
+            if (!(m_revokedBloom[bit / 64].load(std::memory_order_acquire) & (1ull << (bit % 64))))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::uint64_t m_secret;                                      ///< Issuer signing secret.
+    std::array<CacheShard, CACHE_SHARDS> m_shards;               ///< Sharded validation cache.
+    std::array<std::atomic<std::uint64_t>, BLOOM_BITS / 64> m_revokedBloom{}; ///< Revocation bitmap.
+    std::atomic<std::size_t> m_cacheHits{0};
+    std::atomic<std::size_t> m_signatureChecks{0};
+};
+
+/**
+ * @brief Main function demonstrating Token-Based Authentication.
  */
+int main()
+{
+    // Create a user
+    auto user = std::make_shared<User>(1, "Alice");
+
+    // Create an authentication service
+    AuthenticationService authService;
+
+    // Authenticate user and generate a token
+    auto token = authService.authenticate(user);
+    std::cout << "Generated Token: " << token->getToken() << std::endl;
+
+    // Verify if the token is still valid
+    if (authService.verifyToken(token))
+    {
+        std::cout << "Token is valid!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Token is expired!" << std::endl;
+    }
+
+    // Repeat validations hit the sharded cache, not the signature check.
+    authService.verifyToken(token);
+    authService.verifyToken(token);
+    std::cout << "Signature checks: " << authService.signatureChecks()
+              << ", cache hits: " << authService.cacheHits() << std::endl;
+
+    // A tampered token fails signature verification without any lookup.
+    auto forged = std::make_shared<Token>(std::make_shared<User>(1, "Mallory"),
+                                          std::chrono::system_clock::now() + std::chrono::minutes(30));
+    forged->sign(0xdeadbeef);
+    std::cout << "Forged token accepted: " << authService.verifyToken(forged) << std::endl;
+
+    // Revocation flips Bloom bits; the read side stays lock-free.
+    authService.revoke(token);
+    std::cout << "Token valid after revocation: " << authService.verifyToken(token) << std::endl;
 
- #include <iostream>
- #include <string>
- #include <memory>
- #include <unordered_map>
- #include <ctime>
- #include <chrono>
- #include <sstream>
- #include <iomanip>
- 
- /**
-  * @brief Represents a user in the system.
-  */
- class User
- {
- public:
-     /**
-      * @brief Constructs a User object.
-      * @param id The ID of the user.
-      * @param name The name of the user.
-      */
-     User(int id, const std::string& name)
-         : m_id(id), m_name(name)
-     {}
- 
-     /**
-      * @brief Gets the ID of the user.
-      * @return The ID of the user.
-      */
-     int getId() const { return m_id; }
- 
-     /**
-      * @brief Gets the name of the user.
-      * @return The name of the user.
-      */
-     const std::string& getName() const { return m_name; }
- 
- private:
-     int m_id;            ///< The ID of the user.
-     std::string m_name;  ///< The name of the user.
- };
- 
- /**
-  * @brief A class to represent a token used for authentication.
-  */
- class Token
- {
- public:
-     /**
-      * @brief Constructs a Token object.
-      * @param user The user for whom the token is created.
-      * @param expirationTime The expiration time for the token.
-      */
-     Token(const std::shared_ptr<User>& user, const std::chrono::system_clock::time_point& expirationTime)
-         : m_user(user), m_expirationTime(expirationTime)
-     {
-         generateToken();
-     }
- 
-     /**
-      * @brief Generates a simple token by encoding user info and expiration time.
-      * This is a simplified version, in real systems, it would be signed and possibly encrypted.
-      */
-     void generateToken()
-     {
-         std::ostringstream oss;
-         oss << m_user->getId() << ":" << m_user->getName() << ":"
-             << std::chrono::duration_cast<std::chrono::seconds>(m_expirationTime.time_since_epoch()).count();
-         m_token = oss.str();
-     }
- 
-     /**
-      * @brief Gets the token string.
-      * @return The token string.
-      */
-     const std::string& getToken() const { return m_token; }
- 
-     /**
-      * @brief Checks if the token is expired.
-      * @return true if the token is expired, false otherwise.
-      */
-     bool isExpired() const
-     {
-         return std::chrono::system_clock::now() > m_expirationTime;
-     }
- 
- private:
-     std::shared_ptr<User> m_user;              ///< The user associated with the token.
-     std::chrono::system_clock::time_point m_expirationTime; ///< The expiration time of the token.
-     std::string m_token;                       ///< The generated token string.
- };
- 
- /**
-  * @brief A class that handles authentication using token-based methods.
-  */
- class AuthenticationService
- {
- public:
-     /**
-      * @brief Authenticates a user and generates a token.
-      * @param user The user to authenticate.
-      * @return The generated authentication token.
-      */
-     std::shared_ptr<Token> authenticate(const std::shared_ptr<User>& user)
-     {
-         auto expirationTime = std::chrono::system_clock::now() + std::chrono::minutes(30);  // Token valid for 30 minutes
-         auto token = std::make_shared<Token>(user, expirationTime);
-         return token;
-     }
- 
-     /**
-      * @brief Verifies if a token is valid.
-      * @param token The token to validate.
-      * @return true if the token is valid and not expired, false otherwise.
-      */
-     bool verifyToken(const std::shared_ptr<Token>& token)
-     {
-         return !token->isExpired();
-     }
- };
- 
- /**
-  * @brief Main function demonstrating Token-Based Authentication.
-  */
- int main()
- {
-     // Create a user
-     auto user = std::make_shared<User>(1, "Alice");
- 
-     // Create an authentication service
-     AuthenticationService authService;
- 
-     // Authenticate user and generate a token
-     auto token = authService.authenticate(user);
-     std::cout << "Generated Token: " << token->getToken() << std::endl;
- 
-     // Verify if the token is still valid
-     if (authService.verifyToken(token))
-     {
-         std::cout << "Token is valid!" << std::endl;
-     }
-     else
-     {
-         std::cout << "Token is expired!" << std::endl;
-     }
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
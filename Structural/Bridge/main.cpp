@@ -1,209 +1,454 @@
 /**
  * @brief Bridge pattern example that separates abstraction and implementation into distinct class hierarchies.
  *
- * The **Bridge** pattern is used to separate an abstraction from its implementation so that both can evolve independently. 
+ * The **Bridge** pattern is used to separate an abstraction from its implementation so that both can evolve independently.
  * It decouples the abstraction (interface) and the implementation (concrete functionality) into separate class hierarchies.
- * 
+ *
  * **Key Concepts:**
  * 1. **Abstraction (`Shape`)**: The high-level abstraction that delegates tasks to the implementation.
  * 2. **Refined Abstraction (`Circle`, `Square`)**: The concrete implementations of the abstraction.
  * 3. **Implementor (`DrawingAPI`)**: The interface for the implementation classes.
  * 4. **Concrete Implementor (`OpenGLAPI`, `DirectXAPI`)**: The actual implementation classes for the drawing.
- * 
+ *
  * **How it works:**
  * 1. `Shape` provides a high-level interface to draw shapes.
  * 2. `DrawingAPI` is the interface that defines the drawing methods.
  * 3. `OpenGLAPI` and `DirectXAPI` provide concrete implementations of the drawing methods.
  * 4. `Circle` and `Square` extend the `Shape` abstraction and call the drawing methods from `DrawingAPI` to perform the actual rendering.
+ *
+ * A virtual dispatch per shape is wasted work when the backend never changes
+ * mid-frame. The batched bridge below has shapes submit plain draw commands
+ * into a command buffer; the frame is flushed through the selected backend
+ * with one virtual dispatch per batch, and the flush itself is a template
+ * over the concrete backend so the inner loop inlines the backend's draw
+ * routines and stays vectorizable.
+ */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <span>
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @brief Interface for drawing shapes.
+ *
+ * The `DrawingAPI` interface defines the methods for drawing shapes. Concrete implementations of this interface
+ * provide different ways to render shapes, such as OpenGL or DirectX.
+ */
+class DrawingAPI
+{
+public:
+    virtual ~DrawingAPI() = default;
+
+    /**
+     * @brief Draw a circle.
+     *
+     * This method will be implemented by concrete classes like OpenGLAPI or DirectXAPI.
+     *
+     * @param radius The radius of the circle.
+     * @param x The x-coordinate of the center of the circle.
+     * @param y The y-coordinate of the center of the circle.
+     */
+    virtual void drawCircle(double radius, double x, double y) const = 0;
+
+    /**
+     * @brief Draw a square.
+     *
+     * This method will be implemented by concrete classes like OpenGLAPI or DirectXAPI.
+     *
+     * @param side The side length of the square.
+     * @param x The x-coordinate of the top-left corner of the square.
+     * @param y The y-coordinate of the top-left corner of the square.
+     */
+    virtual void drawSquare(double side, double x, double y) const = 0;
+};
+
+/**
+ * @brief Concrete implementor for OpenGL rendering.
+ *
+ * The `OpenGLAPI` class provides an OpenGL-specific implementation for drawing shapes, such as circles and squares.
+ */
+class OpenGLAPI : public DrawingAPI
+{
+public:
+    void drawCircle(double radius, double x, double y) const override
+    {
+        std::cout << "Drawing Circle with OpenGL: radius = " << radius
+                  << ", center = (" << x << ", " << y << ")\n";
+    }
+
+    void drawSquare(double side, double x, double y) const override
+    {
+        std::cout << "Drawing Square with OpenGL: side = " << side
+                  << ", top-left corner = (" << x << ", " << y << ")\n";
+    }
+};
+
+/**
+ * @brief Concrete implementor for DirectX rendering.
+ *
+ * The `DirectXAPI` class provides a DirectX-specific implementation for drawing shapes, such as circles and squares.
+ */
+class DirectXAPI : public DrawingAPI
+{
+public:
+    void drawCircle(double radius, double x, double y) const override
+    {
+        std::cout << "Drawing Circle with DirectX: radius = " << radius
+                  << ", center = (" << x << ", " << y << ")\n";
+    }
+
+    void drawSquare(double side, double x, double y) const override
+    {
+        std::cout << "Drawing Square with DirectX: side = " << side
+                  << ", top-left corner = (" << x << ", " << y << ")\n";
+    }
+};
+
+/**
+ * @brief Abstraction class for shapes.
+ *
+ * The `Shape` class defines the abstraction for geometric shapes. It delegates the drawing task to the `DrawingAPI` interface.
+ */
+class Shape
+{
+public:
+    virtual ~Shape() = default;
+
+    /**
+     * @brief Set the drawing API for the shape.
+     *
+     * This method allows us to assign a specific drawing API to the shape, like OpenGL or DirectX.
+     *
+     * @param drawingAPI A shared pointer to the `DrawingAPI` implementation.
+     */
+    void setDrawingAPI(std::shared_ptr<DrawingAPI> drawingAPI)
+    {
+        m_drawingAPI = drawingAPI;
+    }
+
+    /**
+     * @brief Draw the shape.
+     *
+     * This is a high-level method that delegates the drawing task to the drawing API.
+     */
+    virtual void draw() const = 0;
+
+protected:
+    std::shared_ptr<DrawingAPI> m_drawingAPI; ///< The drawing API used to render the shape
+};
+
+/**
+ * @brief Refined abstraction for Circle shape.
+ *
+ * The `Circle` class is a concrete implementation of the `Shape` abstraction. It uses the drawing API to draw a circle.
+ */
+class Circle : public Shape
+{
+public:
+    Circle(double radius, double x, double y)
+        : m_radius(radius), m_x(x), m_y(y) {}
+
+    /**
+     * @brief Draw the circle by delegating to the drawing API.
+     */
+    void draw() const override
+    {
+        m_drawingAPI->drawCircle(m_radius, m_x, m_y);
+    }
+
+private:
+    double m_radius; ///< The radius of the circle
+    double m_x;      ///< The x-coordinate of the circle's center
+    double m_y;      ///< The y-coordinate of the circle's center
+};
+
+/**
+ * @brief Refined abstraction for Square shape.
+ *
+ * The `Square` class is a concrete implementation of the `Shape` abstraction. It uses the drawing API to draw a square.
+ */
+class Square : public Shape
+{
+public:
+    Square(double side, double x, double y)
+        : m_side(side), m_x(x), m_y(y) {}
+
+    /**
+     * @brief Draw the square by delegating to the drawing API.
+     */
+    void draw() const override
+    {
+        m_drawingAPI->drawSquare(m_side, m_x, m_y);
+    }
+
+private:
+    double m_side; ///< The side length of the square
+    double m_x;    ///< The x-coordinate of the square's top-left corner
+    double m_y;    ///< The y-coordinate of the square's top-left corner
+};
+
+/**
+ * @brief One recorded draw; shapes submit these instead of calling out.
+ */
+struct DrawCommand
+{
+    enum class Kind : unsigned char { Circle, Square };
+
+    Kind kind;
+    double size; ///< Radius or side length.
+    double x;
+    double y;
+};
+
+/**
+ * @brief Per-frame command buffer the shapes submit into.
  */
+class CommandBuffer
+{
+public:
+    void submitCircle(double radius, double x, double y)
+    {
+        m_commands.push_back(DrawCommand{DrawCommand::Kind::Circle, radius, x, y});
+    }
+
+    void submitSquare(double side, double x, double y)
+    {
+        m_commands.push_back(DrawCommand{DrawCommand::Kind::Square, side, x, y});
+    }
+
+    std::span<const DrawCommand> commands() const { return m_commands; }
+    void reserve(std::size_t count) { m_commands.reserve(count); }
+    void clear() { m_commands.clear(); }
+
+private:
+    std::vector<DrawCommand> m_commands; ///< Contiguous, iteration-friendly.
+};
+
+/**
+ * @brief Concrete batch backend: plain inline methods, no virtuals.
+ *
+ * The print-free area accumulators stand in for backend draw-call setup.
+ */
+class BatchOpenGL
+{
+public:
+    void circle(double radius, double x, double y)
+    {
+        m_accumulated += radius * radius * 3.14159265358979 + x * 0.5 + y * 0.25;
+    }
+
+    void square(double side, double x, double y)
+    {
+        m_accumulated += side * side + x * 0.25 + y * 0.5;
+    }
+
+    double accumulated() const { return m_accumulated; }
+
+private:
+    double m_accumulated{0.0};
+};
+
+/**
+ * @brief Second concrete batch backend with its own draw arithmetic.
+ */
+class BatchDirectX
+{
+public:
+    void circle(double radius, double x, double y)
+    {
+        m_accumulated += radius * 6.28318530717959 + x * 0.125 + y;
+    }
+
+    void square(double side, double x, double y)
+    {
+        m_accumulated += side * 4.0 + x + y * 0.125;
+    }
+
+    double accumulated() const { return m_accumulated; }
+
+private:
+    double m_accumulated{0.0};
+};
+
+/**
+ * @brief Flushes a whole frame through one concrete backend.
+ *
+ * Templated on the backend, so circle()/square() are direct calls the
+ * compiler inlines into the loop — no indirection left on the per-shape
+ * path.
+ */
+template <typename Backend>
+void flush(std::span<const DrawCommand> commands, Backend& backend)
+{
+    for (const DrawCommand& command : commands)
+    {
+        if (command.kind == DrawCommand::Kind::Circle)
+        {
+            backend.circle(command.size, command.x, command.y);
+        }
+        else
+        {
+            backend.square(command.size, command.x, command.y);
+        }
+    }
+}
+
+/**
+ * @brief Type-erased flush point: one virtual dispatch per batch.
+ *
+ * Each implementation forwards straight into the templated flush for its
+ * backend, so the virtual boundary is crossed once per frame, not per
+ * shape.
+ */
+class BatchRenderer
+{
+public:
+    virtual ~BatchRenderer() = default;
+
+    virtual void flushBatch(std::span<const DrawCommand> commands) = 0;
+    virtual double accumulated() const = 0;
+};
+
+/**
+ * @brief OpenGL batch renderer; owns its inlining backend.
+ */
+class OpenGLBatchRenderer : public BatchRenderer
+{
+public:
+    void flushBatch(std::span<const DrawCommand> commands) override
+    {
+        flush(commands, m_backend); // The only virtual hop this frame.
+    }
+
+    double accumulated() const override { return m_backend.accumulated(); }
+
+private:
+    BatchOpenGL m_backend;
+};
+
+/**
+ * @brief DirectX batch renderer; owns its inlining backend.
+ */
+class DirectXBatchRenderer : public BatchRenderer
+{
+public:
+    void flushBatch(std::span<const DrawCommand> commands) override
+    {
+        flush(commands, m_backend);
+    }
+
+    double accumulated() const override { return m_backend.accumulated(); }
+
+private:
+    BatchDirectX m_backend;
+};
+
+/**
+ * @brief Print-free per-shape virtual backend; the baseline the batch replaces.
+ */
+class QuietDrawingAPI
+{
+public:
+    virtual ~QuietDrawingAPI() = default;
+
+    virtual void drawCircle(double radius, double x, double y) = 0;
+    virtual void drawSquare(double side, double x, double y) = 0;
+};
+
+/**
+ * @brief Quiet OpenGL implementor matching BatchOpenGL's arithmetic.
+ */
+class QuietOpenGLAPI : public QuietDrawingAPI
+{
+public:
+    void drawCircle(double radius, double x, double y) override
+    {
+        m_accumulated += radius * radius * 3.14159265358979 + x * 0.5 + y * 0.25;
+    }
+
+    void drawSquare(double side, double x, double y) override
+    {
+        m_accumulated += side * side + x * 0.25 + y * 0.5;
+    }
+
+    double accumulated() const { return m_accumulated; }
+
+private:
+    double m_accumulated{0.0};
+};
+
+/**
+ * @brief Main function demonstrating the Bridge pattern.
+ *
+ * The function demonstrates how the abstraction (`Shape`) is decoupled from the implementation (`DrawingAPI`).
+ * The same shape (e.g., Circle or Square) can be drawn using different implementations (e.g., OpenGL or DirectX).
+ */
+int main()
+{
+    // Create OpenGL and DirectX drawing APIs
+    std::shared_ptr<DrawingAPI> openGLAPI = std::make_shared<OpenGLAPI>();
+    std::shared_ptr<DrawingAPI> directXAPI = std::make_shared<DirectXAPI>();
+
+    // Create shapes and associate them with drawing APIs
+    Circle circle(5.0, 10.0, 15.0);
+    circle.setDrawingAPI(openGLAPI);
+
+    Square square(4.0, 20.0, 25.0);
+    square.setDrawingAPI(directXAPI);
+
+    // Draw shapes using OpenGL and DirectX
+    std::cout << "Drawing shapes with OpenGL and DirectX:\n";
+    circle.draw();  // Uses OpenGL
+    square.draw();  // Uses DirectX
+
+    // Batched bridge: one virtual dispatch per frame, inlined inner loop.
+    constexpr std::size_t shapeCount = 5000000;
+
+    CommandBuffer frame;
+    frame.reserve(shapeCount);
+    for (std::size_t i = 0; i < shapeCount; ++i)
+    {
+        double coordinate = static_cast<double>(i % 1024);
+        if (i % 2 == 0)
+        {
+            frame.submitCircle(2.0, coordinate, coordinate * 0.5);
+        }
+        else
+        {
+            frame.submitSquare(3.0, coordinate * 0.5, coordinate);
+        }
+    }
+
+    // Baseline: one virtual dispatch per shape.
+    QuietOpenGLAPI perShapeBackend;
+    QuietDrawingAPI* virtualBackend = &perShapeBackend;
+    auto start = std::chrono::steady_clock::now();
+    for (const DrawCommand& command : frame.commands())
+    {
+        if (command.kind == DrawCommand::Kind::Circle)
+        {
+            virtualBackend->drawCircle(command.size, command.x, command.y);
+        }
+        else
+        {
+            virtualBackend->drawSquare(command.size, command.x, command.y);
+        }
+    }
+    double perShapeTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::unique_ptr<BatchRenderer> renderer = std::make_unique<OpenGLBatchRenderer>();
+    start = std::chrono::steady_clock::now();
+    renderer->flushBatch(frame.commands()); // One virtual hop for 5M shapes.
+    double batchTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << shapeCount << " shape(s): per-shape virtual " << perShapeTime
+              << " ms, batched flush " << batchTime << " ms (checksums "
+              << perShapeBackend.accumulated() << " / " << renderer->accumulated()
+              << ")" << std::endl;
 
- #include <iostream>
- #include <memory>
- #include <string>
- 
- /**
-  * @brief Interface for drawing shapes.
-  *
-  * The `DrawingAPI` interface defines the methods for drawing shapes. Concrete implementations of this interface
-  * provide different ways to render shapes, such as OpenGL or DirectX.
-  */
- class DrawingAPI
- {
- public:
-     virtual ~DrawingAPI() = default;
- 
-     /**
-      * @brief Draw a circle.
-      * 
-      * This method will be implemented by concrete classes like OpenGLAPI or DirectXAPI.
-      *
-      * @param radius The radius of the circle.
-      * @param x The x-coordinate of the center of the circle.
-      * @param y The y-coordinate of the center of the circle.
-      */
-     virtual void drawCircle(double radius, double x, double y) const = 0;
- 
-     /**
-      * @brief Draw a square.
-      * 
-      * This method will be implemented by concrete classes like OpenGLAPI or DirectXAPI.
-      *
-      * @param side The side length of the square.
-      * @param x The x-coordinate of the top-left corner of the square.
-      * @param y The y-coordinate of the top-left corner of the square.
-      */
-     virtual void drawSquare(double side, double x, double y) const = 0;
- };
- 
- /**
-  * @brief Concrete implementor for OpenGL rendering.
-  *
-  * The `OpenGLAPI` class provides an OpenGL-specific implementation for drawing shapes, such as circles and squares.
-  */
- class OpenGLAPI : public DrawingAPI
- {
- public:
-     void drawCircle(double radius, double x, double y) const override
-     {
-         std::cout << "Drawing Circle with OpenGL: radius = " << radius 
-                   << ", center = (" << x << ", " << y << ")\n";
-     }
- 
-     void drawSquare(double side, double x, double y) const override
-     {
-         std::cout << "Drawing Square with OpenGL: side = " << side 
-                   << ", top-left corner = (" << x << ", " << y << ")\n";
-     }
- };
- 
- /**
-  * @brief Concrete implementor for DirectX rendering.
-  *
-  * The `DirectXAPI` class provides a DirectX-specific implementation for drawing shapes, such as circles and squares.
-  */
- class DirectXAPI : public DrawingAPI
- {
- public:
-     void drawCircle(double radius, double x, double y) const override
-     {
-         std::cout << "Drawing Circle with DirectX: radius = " << radius 
-                   << ", center = (" << x << ", " << y << ")\n";
-     }
- 
-     void drawSquare(double side, double x, double y) const override
-     {
-         std::cout << "Drawing Square with DirectX: side = " << side 
-                   << ", top-left corner = (" << x << ", " << y << ")\n";
-     }
- };
- 
- /**
-  * @brief Abstraction class for shapes.
-  *
-  * The `Shape` class defines the abstraction for geometric shapes. It delegates the drawing task to the `DrawingAPI` interface.
-  */
- class Shape
- {
- public:
-     virtual ~Shape() = default;
- 
-     /**
-      * @brief Set the drawing API for the shape.
-      * 
-      * This method allows us to assign a specific drawing API to the shape, like OpenGL or DirectX.
-      *
-      * @param drawingAPI A shared pointer to the `DrawingAPI` implementation.
-      */
-     void setDrawingAPI(std::shared_ptr<DrawingAPI> drawingAPI)
-     {
-         m_drawingAPI = drawingAPI;
-     }
- 
-     /**
-      * @brief Draw the shape.
-      * 
-      * This is a high-level method that delegates the drawing task to the drawing API.
-      */
-     virtual void draw() const = 0;
- 
- protected:
-     std::shared_ptr<DrawingAPI> m_drawingAPI; ///< The drawing API used to render the shape
- };
- 
- /**
-  * @brief Refined abstraction for Circle shape.
-  *
-  * The `Circle` class is a concrete implementation of the `Shape` abstraction. It uses the drawing API to draw a circle.
-  */
- class Circle : public Shape
- {
- public:
-     Circle(double radius, double x, double y)
-         : m_radius(radius), m_x(x), m_y(y) {}
- 
-     /**
-      * @brief Draw the circle by delegating to the drawing API.
-      */
-     void draw() const override
-     {
-         m_drawingAPI->drawCircle(m_radius, m_x, m_y);
-     }
- 
- private:
-     double m_radius; ///< The radius of the circle
-     double m_x;      ///< The x-coordinate of the circle's center
-     double m_y;      ///< The y-coordinate of the circle's center
- };
- 
- /**
-  * @brief Refined abstraction for Square shape.
-  *
-  * The `Square` class is a concrete implementation of the `Shape` abstraction. It uses the drawing API to draw a square.
-  */
- class Square : public Shape
- {
- public:
-     Square(double side, double x, double y)
-         : m_side(side), m_x(x), m_y(y) {}
- 
-     /**
-      * @brief Draw the square by delegating to the drawing API.
-      */
-     void draw() const override
-     {
-         m_drawingAPI->drawSquare(m_side, m_x, m_y);
-     }
- 
- private:
-     double m_side; ///< The side length of the square
-     double m_x;    ///< The x-coordinate of the square's top-left corner
-     double m_y;    ///< The y-coordinate of the square's top-left corner
- };
- 
- /**
-  * @brief Main function demonstrating the Bridge pattern.
-  *
-  * The function demonstrates how the abstraction (`Shape`) is decoupled from the implementation (`DrawingAPI`).
-  * The same shape (e.g., Circle or Square) can be drawn using different implementations (e.g., OpenGL or DirectX).
-  */
- int main()
- {
-     // Create OpenGL and DirectX drawing APIs
-     std::shared_ptr<DrawingAPI> openGLAPI = std::make_shared<OpenGLAPI>();
-     std::shared_ptr<DrawingAPI> directXAPI = std::make_shared<DirectXAPI>();
- 
-     // Create shapes and associate them with drawing APIs
-     Circle circle(5.0, 10.0, 15.0);
-     circle.setDrawingAPI(openGLAPI);
- 
-     Square square(4.0, 20.0, 25.0);
-     square.setDrawingAPI(directXAPI);
- 
-     // Draw shapes using OpenGL and DirectX
-     std::cout << "Drawing shapes with OpenGL and DirectX:\n";
-     circle.draw();  // Uses OpenGL
-     square.draw();  // Uses DirectX
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
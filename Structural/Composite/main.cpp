@@ -15,169 +15,450 @@
  * 2. `Circle` and `Rectangle` are leaf objects that implement the `Graphic` interface and provide their own drawing behavior.
  * 3. `Group` is a composite object that holds multiple `Graphic` objects (either `Circle`, `Rectangle`, or other `Group` objects).
  * 4. The client can call the same interface (`draw()`) on both individual objects and composite objects.
+ *
+ * Deep recursion over shared_ptr children chases pointers on every pass, which dominates
+ * traversal time on large scene graphs. Two additions address that: `CowGroup`, a
+ * persistent composite whose subtrees are immutable and shared (cloning a group copies
+ * one shared_ptr — O(1)), and `FlattenedScene`, a contiguous linearization (node data +
+ * depth + subtree-skip offsets) cached against the root and rebuilt lazily after a
+ * structural change, so full-scene draw/area passes are a linear sweep.
+ */
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <variant>
+#include <chrono>
+#include <cstdint>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/**
+ * @brief Abstract Component class representing graphical objects.
+ *
+ * The `Graphic` class defines the interface for all concrete objects in the composition, both leaf and composite.
  */
+class Graphic
+{
+public:
+    virtual ~Graphic() = default;
+
+    /**
+     * @brief Draw the graphic.
+     *
+     * This method must be implemented by both leaf and composite objects. For leaf objects, it draws a single object. 
+     * For composite objects, it delegates the drawing task to their child components.
+     */
+    virtual void draw() const = 0;
+
+    /**
+     * @brief Area of this graphic; groups sum their children.
+     */
+    virtual double area() const = 0;
+};
+
+/**
+ * @brief Leaf class representing a circle.
+ *
+ * The `Circle` class is a leaf node in the composite structure. It represents an individual graphical object 
+ * (a circle in this case).
+ */
+class Circle : public Graphic
+{
+public:
+    /**
+     * @brief Constructor to initialize circle properties.
+     *
+     * @param x The x-coordinate of the circle's center.
+     * @param y The y-coordinate of the circle's center.
+     * @param radius The radius of the circle.
+     */
+    Circle(double x, double y, double radius)
+        : m_x(x), m_y(y), m_radius(radius) {}
+
+    /**
+     * @brief Draw the circle.
+     *
+     * This method draws the circle by printing its properties to the console.
+     */
+    void draw() const override
+    {
+        std::cout << "Drawing Circle at (" << m_x << ", " << m_y << ") with radius " << m_radius << std::endl;
+    }
+
+    double area() const override
+    {
+        return M_PI * m_radius * m_radius;
+    }
+
+private:
+    double m_x;      ///< The x-coordinate of the circle's center
+    double m_y;      ///< The y-coordinate of the circle's center
+    double m_radius; ///< The radius of the circle
+};
+
+/**
+ * @brief Leaf class representing a rectangle.
+ *
+ * The `Rectangle` class is a leaf node in the composite structure. It represents an individual graphical object 
+ * (a rectangle in this case).
+ */
+class Rectangle : public Graphic
+{
+public:
+    /**
+     * @brief Constructor to initialize rectangle properties.
+     *
+     * @param x The x-coordinate of the rectangle's top-left corner.
+     * @param y The y-coordinate of the rectangle's top-left corner.
+     * @param width The width of the rectangle.
+     * @param height The height of the rectangle.
+     */
+    Rectangle(double x, double y, double width, double height)
+        : m_x(x), m_y(y), m_width(width), m_height(height) {}
+
+    /**
+     * @brief Draw the rectangle.
+     *
+     * This method draws the rectangle by printing its properties to the console.
+     */
+    void draw() const override
+    {
+        std::cout << "Drawing Rectangle at (" << m_x << ", " << m_y << ") with width " << m_width 
+                  << " and height " << m_height << std::endl;
+    }
+
+    double area() const override
+    {
+        return m_width * m_height;
+    }
+
+private:
+    double m_x;      ///< The x-coordinate of the rectangle's top-left corner
+    double m_y;      ///< The y-coordinate of the rectangle's top-left corner
+    double m_width;  ///< The width of the rectangle
+    double m_height; ///< The height of the rectangle
+};
+
+/**
+ * @brief Composite class representing a group of graphical objects.
+ *
+ * The `Group` class is a composite that contains other `Graphic` objects. It is capable of adding, removing,
+ * and drawing all its child components (which can be both leaf and other composite objects).
+ */
+class Group : public Graphic
+{
+public:
+    /**
+     * @brief Add a graphic to the group.
+     *
+     * Adds a `Graphic` object (either leaf or composite) to the group's collection of child components.
+     *
+     * @param graphic A shared pointer to a `Graphic` object.
+     */
+    void add(const std::shared_ptr<Graphic>& graphic)
+    {
+        m_graphics.push_back(graphic);
+    }
+
+    /**
+     * @brief Draw all the graphics in the group.
+     *
+     * This method delegates the drawing task to all its child components.
+     */
+    void draw() const override
+    {
+        std::cout << "Drawing Group:" << std::endl;
+        for (const auto& graphic : m_graphics)
+        {
+            graphic->draw();
+        }
+    }
+
+    double area() const override
+    {
+        double total = 0.0;
+        for (const auto& graphic : m_graphics)
+        {
+            total += graphic->area();
+        }
+        return total;
+    }
+
+private:
+    std::vector<std::shared_ptr<Graphic>> m_graphics; ///< The list of child components (either leaf or composite)
+};
+
+/**
+ * @brief Plain leaf payloads used by the copy-on-write tree and the flat cache.
+ */
+struct CircleData
+{
+    double x, y, radius;
+
+    bool operator==(const CircleData&) const = default;
+};
+
+struct RectangleData
+{
+    double x, y, width, height;
+
+    bool operator==(const RectangleData&) const = default;
+};
+
+/**
+ * @brief Persistent composite: immutable nodes, structurally shared subtrees.
+ *
+ * Every mutation returns a new CowGroup whose node shares all unchanged
+ * children with the original, so cloning a group of any size is copying one
+ * shared_ptr and editing deep scenes never duplicates untouched subtrees.
+ */
+class CowGroup
+{
+public:
+    struct Node;
+    using Child = std::variant<CircleData, RectangleData, std::shared_ptr<const Node>>;
+
+    /**
+     * @brief Immutable group node; children are leaf payloads or shared subtrees.
+     */
+    struct Node
+    {
+        std::vector<Child> children;
+    };
+
+    CowGroup() : m_root(std::make_shared<Node>()) {}
+
+    /**
+     * @brief Returns a new group with the child appended; existing children
+     *        are shared, not copied.
+     */
+    CowGroup with(Child child) const
+    {
+        auto node = std::make_shared<Node>(*m_root); // Shallow copy: shares subtrees.
+        node->children.push_back(std::move(child));
+        return CowGroup(std::move(node));
+    }
+
+    /**
+     * @brief O(1) clone: both groups share the same immutable root.
+     */
+    CowGroup clone() const
+    {
+        return *this;
+    }
+
+    const std::shared_ptr<const Node>& root() const { return m_root; }
+
+private:
+    explicit CowGroup(std::shared_ptr<const Node> root) : m_root(std::move(root)) {}
+
+    std::shared_ptr<const Node> m_root; ///< Immutable, structurally shared tree.
+};
+
+/**
+ * @brief Contiguous linearization of a CowGroup for sweep-style passes.
+ *
+ * Each entry records its depth and the size of its subtree, so a consumer can
+ * either walk everything linearly (draw, area) or skip a whole subtree by
+ * jumping ahead `subtreeSize` entries. The cache keys on the root node
+ * pointer: because trees are immutable, pointer equality means the
+ * linearization is still valid, and any structural change rebuilds it lazily
+ * on next use.
+ */
+class FlattenedScene
+{
+public:
+    /**
+     * @brief One linearized node.
+     */
+    struct FlatNode
+    {
+        enum class Kind : std::uint8_t { Group, Circle, Rectangle };
+
+        Kind kind;
+        std::uint16_t depth;       ///< Nesting depth, for indented drawing.
+        std::uint32_t subtreeSize; ///< Entries to skip to jump past this subtree.
+        double a{0}, b{0}, c{0}, d{0}; ///< Payload (x, y, radius / width, height).
+    };
+
+    /**
+     * @brief Ensures the linearization matches the group; rebuilds only if the
+     *        root changed since the last build.
+     */
+    void update(const CowGroup& group)
+    {
+        if (m_builtFrom == group.root().get())
+        {
+            return; // Structure unchanged: the cached linearization is valid.
+        }
+        m_nodes.clear();
+        appendNode(*group.root(), 0);
+        m_builtFrom = group.root().get();
+    }
+
+    /**
+     * @brief Full-scene draw as one linear sweep over contiguous nodes.
+     */
+    void draw() const
+    {
+        for (const FlatNode& node : m_nodes)
+        {
+            std::cout << std::string(node.depth * 2, ' ');
+            switch (node.kind)
+            {
+                case FlatNode::Kind::Group:
+                    std::cout << "Group (" << node.subtreeSize << " node(s))\n";
+                    break;
+                case FlatNode::Kind::Circle:
+                    std::cout << "Circle at (" << node.a << ", " << node.b << ") radius " << node.c << "\n";
+                    break;
+                case FlatNode::Kind::Rectangle:
+                    std::cout << "Rectangle at (" << node.a << ", " << node.b << ") size "
+                              << node.c << "x" << node.d << "\n";
+                    break;
+            }
+        }
+    }
+
+    /**
+     * @brief Total area as a branch-light sweep; no pointer chasing.
+     */
+    double totalArea() const
+    {
+        double total = 0.0;
+        for (const FlatNode& node : m_nodes)
+        {
+            if (node.kind == FlatNode::Kind::Circle)
+            {
+                total += M_PI * node.c * node.c;
+            }
+            else if (node.kind == FlatNode::Kind::Rectangle)
+            {
+                total += node.c * node.d;
+            }
+        }
+        return total;
+    }
+
+    std::size_t size() const { return m_nodes.size(); }
+
+private:
+    /**
+     * @brief Emits a group and its children depth-first; patches subtreeSize.
+     */
+    void appendNode(const CowGroup::Node& node, std::uint16_t depth)
+    {
+        std::size_t position = m_nodes.size();
+        m_nodes.push_back(FlatNode{FlatNode::Kind::Group, depth, 0});
+        for (const CowGroup::Child& child : node.children)
+        {
+            if (const auto* circle = std::get_if<CircleData>(&child))
+            {
+                m_nodes.push_back(FlatNode{FlatNode::Kind::Circle, static_cast<std::uint16_t>(depth + 1), 1,
+                                           circle->x, circle->y, circle->radius});
+            }
+            else if (const auto* rectangle = std::get_if<RectangleData>(&child))
+            {
+                m_nodes.push_back(FlatNode{FlatNode::Kind::Rectangle, static_cast<std::uint16_t>(depth + 1), 1,
+                                           rectangle->x, rectangle->y, rectangle->width, rectangle->height});
+            }
+            else
+            {
+                appendNode(*std::get<std::shared_ptr<const CowGroup::Node>>(child),
+                           static_cast<std::uint16_t>(depth + 1));
+            }
+        }
+        m_nodes[position].subtreeSize = static_cast<std::uint32_t>(m_nodes.size() - position);
+    }
+
+    std::vector<FlatNode> m_nodes;              ///< Depth-first linearization.
+    const CowGroup::Node* m_builtFrom{nullptr}; ///< Root identity of the cached build.
+};
+
+/**
+ * @brief Main function demonstrating the Composite pattern.
+ *
+ * The function demonstrates how individual graphical objects (`Circle`, `Rectangle`) and composite objects (`Group`) 
+ * can be treated uniformly. A group of shapes can be drawn using the same `draw()` method.
+ */
+int main()
+{
+    // Create leaf objects (circle and rectangle)
+    std::shared_ptr<Graphic> circle1 = std::make_shared<Circle>(5.0, 10.0, 15.0);
+    std::shared_ptr<Graphic> rectangle1 = std::make_shared<Rectangle>(1.0, 1.0, 4.0, 6.0);
+
+    // Create a group and add the shapes to it
+    std::shared_ptr<Group> group1 = std::make_shared<Group>();
+    group1->add(circle1);
+    group1->add(rectangle1);
+
+    // Create another group and add a shape and another group
+    std::shared_ptr<Group> group2 = std::make_shared<Group>();
+    group2->add(group1);
+    group2->add(std::make_shared<Circle>(20.0, 25.0, 10.0));
+
+    // Draw the entire structure (groups and individual shapes)
+    std::cout << "Drawing all shapes:" << std::endl;
+    group2->draw(); // Drawing group2 (which includes group1 and another circle)
+
+    // Copy-on-write groups: O(1) clone, shared unchanged subtrees.
+    CowGroup inner;
+    inner = inner.with(CircleData{5.0, 10.0, 15.0})
+                 .with(RectangleData{1.0, 1.0, 4.0, 6.0});
+    CowGroup scene;
+    scene = scene.with(inner.root()).with(CircleData{20.0, 25.0, 10.0});
+
+    CowGroup copy = scene.clone(); // Shares the whole tree: one shared_ptr copy.
+    copy = copy.with(RectangleData{0.0, 0.0, 2.0, 2.0}); // Only the root node is new.
+    std::cout << "\nClone shares subtrees: " << (copy.root()->children[0] == scene.root()->children[0]) << std::endl;
+
+    // Flattened traversal cache: linear sweep instead of recursive descent.
+    FlattenedScene flat;
+    flat.update(scene);
+    std::cout << "Flattened scene (" << flat.size() << " node(s)):" << std::endl;
+    flat.draw();
+
+    // Traversal benchmark: recursive virtual walk vs flat sweep over 200k leaves.
+    auto bigVirtual = std::make_shared<Group>();
+    CowGroup bigCow;
+    for (int g = 0; g < 200; ++g)
+    {
+        auto subgroup = std::make_shared<Group>();
+        CowGroup cowSubgroup;
+        for (int i = 0; i < 1000; ++i)
+        {
+            if (i % 2 == 0)
+            {
+                subgroup->add(std::make_shared<Circle>(g, i, 1.0 + i % 7));
+                cowSubgroup = cowSubgroup.with(CircleData{double(g), double(i), 1.0 + i % 7});
+            }
+            else
+            {
+                subgroup->add(std::make_shared<Rectangle>(g, i, 2.0, 3.0 + i % 5));
+                cowSubgroup = cowSubgroup.with(RectangleData{double(g), double(i), 2.0, 3.0 + i % 5});
+            }
+        }
+        bigVirtual->add(subgroup);
+        bigCow = bigCow.with(cowSubgroup.root());
+    }
+
+    FlattenedScene bigFlat;
+    bigFlat.update(bigCow);
+
+    auto start = std::chrono::steady_clock::now();
+    double virtualArea = bigVirtual->area();
+    double virtualTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    double flatArea = bigFlat.totalArea();
+    double flatTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Area pass over " << bigFlat.size() << " flat node(s): recursive "
+              << virtualTime << " ms, flat sweep " << flatTime << " ms (areas "
+              << virtualArea << " / " << flatArea << ")" << std::endl;
 
- #include <iostream>
- #include <memory>
- #include <vector>
- 
- /**
-  * @brief Abstract Component class representing graphical objects.
-  *
-  * The `Graphic` class defines the interface for all concrete objects in the composition, both leaf and composite.
-  */
- class Graphic
- {
- public:
-     virtual ~Graphic() = default;
- 
-     /**
-      * @brief Draw the graphic.
-      *
-      * This method must be implemented by both leaf and composite objects. For leaf objects, it draws a single object. 
-      * For composite objects, it delegates the drawing task to their child components.
-      */
-     virtual void draw() const = 0;
- };
- 
- /**
-  * @brief Leaf class representing a circle.
-  *
-  * The `Circle` class is a leaf node in the composite structure. It represents an individual graphical object 
-  * (a circle in this case).
-  */
- class Circle : public Graphic
- {
- public:
-     /**
-      * @brief Constructor to initialize circle properties.
-      *
-      * @param x The x-coordinate of the circle's center.
-      * @param y The y-coordinate of the circle's center.
-      * @param radius The radius of the circle.
-      */
-     Circle(double x, double y, double radius)
-         : m_x(x), m_y(y), m_radius(radius) {}
- 
-     /**
-      * @brief Draw the circle.
-      *
-      * This method draws the circle by printing its properties to the console.
-      */
-     void draw() const override
-     {
-         std::cout << "Drawing Circle at (" << m_x << ", " << m_y << ") with radius " << m_radius << std::endl;
-     }
- 
- private:
-     double m_x;      ///< The x-coordinate of the circle's center
-     double m_y;      ///< The y-coordinate of the circle's center
-     double m_radius; ///< The radius of the circle
- };
- 
- /**
-  * @brief Leaf class representing a rectangle.
-  *
-  * The `Rectangle` class is a leaf node in the composite structure. It represents an individual graphical object 
-  * (a rectangle in this case).
-  */
- class Rectangle : public Graphic
- {
- public:
-     /**
-      * @brief Constructor to initialize rectangle properties.
-      *
-      * @param x The x-coordinate of the rectangle's top-left corner.
-      * @param y The y-coordinate of the rectangle's top-left corner.
-      * @param width The width of the rectangle.
-      * @param height The height of the rectangle.
-      */
-     Rectangle(double x, double y, double width, double height)
-         : m_x(x), m_y(y), m_width(width), m_height(height) {}
- 
-     /**
-      * @brief Draw the rectangle.
-      *
-      * This method draws the rectangle by printing its properties to the console.
-      */
-     void draw() const override
-     {
-         std::cout << "Drawing Rectangle at (" << m_x << ", " << m_y << ") with width " << m_width 
-                   << " and height " << m_height << std::endl;
-     }
- 
- private:
-     double m_x;      ///< The x-coordinate of the rectangle's top-left corner
-     double m_y;      ///< The y-coordinate of the rectangle's top-left corner
-     double m_width;  ///< The width of the rectangle
-     double m_height; ///< The height of the rectangle
- };
- 
- /**
-  * @brief Composite class representing a group of graphical objects.
-  *
-  * The `Group` class is a composite that contains other `Graphic` objects. It is capable of adding, removing,
-  * and drawing all its child components (which can be both leaf and other composite objects).
-  */
- class Group : public Graphic
- {
- public:
-     /**
-      * @brief Add a graphic to the group.
-      *
-      * Adds a `Graphic` object (either leaf or composite) to the group's collection of child components.
-      *
-      * @param graphic A shared pointer to a `Graphic` object.
-      */
-     void add(const std::shared_ptr<Graphic>& graphic)
-     {
-         m_graphics.push_back(graphic);
-     }
- 
-     /**
-      * @brief Draw all the graphics in the group.
-      *
-      * This method delegates the drawing task to all its child components.
-      */
-     void draw() const override
-     {
-         std::cout << "Drawing Group:" << std::endl;
-         for (const auto& graphic : m_graphics)
-         {
-             graphic->draw();
-         }
-     }
- 
- private:
-     std::vector<std::shared_ptr<Graphic>> m_graphics; ///< The list of child components (either leaf or composite)
- };
- 
- /**
-  * @brief Main function demonstrating the Composite pattern.
-  *
-  * The function demonstrates how individual graphical objects (`Circle`, `Rectangle`) and composite objects (`Group`) 
-  * can be treated uniformly. A group of shapes can be drawn using the same `draw()` method.
-  */
- int main()
- {
-     // Create leaf objects (circle and rectangle)
-     std::shared_ptr<Graphic> circle1 = std::make_shared<Circle>(5.0, 10.0, 15.0);
-     std::shared_ptr<Graphic> rectangle1 = std::make_shared<Rectangle>(1.0, 1.0, 4.0, 6.0);
- 
-     // Create a group and add the shapes to it
-     std::shared_ptr<Group> group1 = std::make_shared<Group>();
-     group1->add(circle1);
-     group1->add(rectangle1);
- 
-     // Create another group and add a shape and another group
-     std::shared_ptr<Group> group2 = std::make_shared<Group>();
-     group2->add(group1);
-     group2->add(std::make_shared<Circle>(20.0, 25.0, 10.0));
- 
-     // Draw the entire structure (groups and individual shapes)
-     std::cout << "Drawing all shapes:" << std::endl;
-     group2->draw(); // Drawing group2 (which includes group1 and another circle)
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
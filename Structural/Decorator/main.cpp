@@ -17,218 +17,332 @@
  * 3. `CoffeeDecorator` is an abstract decorator that wraps a `Coffee` object, allowing additional functionality.
  * 4. `MilkDecorator` and `SugarDecorator` are concrete decorators that add milk and sugar to the coffee, respectively.
  * 5. The client can dynamically "decorate" the coffee object by wrapping it in various decorators.
+ *
+ * Wrapping one heap node per ingredient and walking the chain virtually is wasteful when
+ * millions of products are configured this way. CoffeeConfig is a value-based alternative:
+ * the configuration is per-ingredient counts over a static constexpr ingredient table, and
+ * cost()/description() fold the table in one loop — constexpr-foldable when the
+ * configuration is known at compile time, with zero per-product allocation.
+ */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <array>
+#include <string_view>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Abstract Component class representing the base Coffee object.
+ *
+ * The `Coffee` class defines the interface for the object being decorated. All concrete objects
+ * (like `SimpleCoffee`) and decorators (like `MilkDecorator`) follow this interface.
  */
+class Coffee
+{
+public:
+    virtual ~Coffee() = default;
+
+    /**
+     * @brief Get the description of the coffee.
+     *
+     * This method returns a description of the coffee.
+     *
+     * @return A string describing the coffee.
+     */
+    virtual std::string getDescription() const = 0;
+
+    /**
+     * @brief Get the cost of the coffee.
+     *
+     * This method returns the cost of the coffee.
+     *
+     * @return The cost of the coffee.
+     */
+    virtual double cost() const = 0;
+};
+
+/**
+ * @brief Concrete Component class representing a simple coffee.
+ *
+ * The `SimpleCoffee` class implements the basic behavior of the `Coffee` interface.
+ * It represents a basic coffee without any additions.
+ */
+class SimpleCoffee : public Coffee
+{
+public:
+    /**
+     * @brief Get the description of the simple coffee.
+     *
+     * @return A string description of the simple coffee ("Simple Coffee").
+     */
+    std::string getDescription() const override
+    {
+        return "Simple Coffee";
+    }
+
+    /**
+     * @brief Get the cost of the simple coffee.
+     *
+     * @return The cost of the simple coffee (5.0).
+     */
+    double cost() const override
+    {
+        return 5.0;
+    }
+};
+
+/**
+ * @brief Abstract Decorator class for adding functionality to a Coffee object.
+ *
+ * The `CoffeeDecorator` class wraps a `Coffee` object and adds functionality to it.
+ * All concrete decorators must extend this class and implement their own behavior.
+ */
+class CoffeeDecorator : public Coffee
+{
+public:
+    /**
+     * @brief Constructor that accepts a `Coffee` object to decorate.
+     *
+     * @param coffee A shared pointer to the `Coffee` object to be decorated.
+     */
+    explicit CoffeeDecorator(std::shared_ptr<Coffee> coffee)
+        : m_coffee(coffee)
+    {
+    }
+
+    /**
+     * @brief Get the description of the decorated coffee.
+     *
+     * This method delegates to the wrapped `Coffee` object's `getDescription()` method.
+     *
+     * @return The description of the decorated coffee.
+     */
+    std::string getDescription() const override
+    {
+        return m_coffee->getDescription();
+    }
+
+    /**
+     * @brief Get the cost of the decorated coffee.
+     *
+     * This method delegates to the wrapped `Coffee` object's `cost()` method.
+     *
+     * @return The cost of the decorated coffee.
+     */
+    double cost() const override
+    {
+        return m_coffee->cost();
+    }
+
+protected:
+    std::shared_ptr<Coffee> m_coffee; ///< The `Coffee` object being decorated
+};
+
+/**
+ * @brief Concrete Decorator class for adding milk to the coffee.
+ *
+ * The `MilkDecorator` class adds milk functionality to the coffee object.
+ */
+class MilkDecorator : public CoffeeDecorator
+{
+public:
+    /**
+     * @brief Constructor that accepts a `Coffee` object to decorate.
+     *
+     * @param coffee A shared pointer to the `Coffee` object to be decorated.
+     */
+    explicit MilkDecorator(std::shared_ptr<Coffee> coffee)
+        : CoffeeDecorator(coffee)
+    {
+    }
+
+    /**
+     * @brief Get the description of the coffee with milk.
+     *
+     * @return A string description of the coffee with milk ("Simple Coffee with Milk").
+     */
+    std::string getDescription() const override
+    {
+        return m_coffee->getDescription() + " with Milk";
+    }
+
+    /**
+     * @brief Get the cost of the coffee with milk.
+     *
+     * @return The cost of the coffee with milk (cost of the base coffee + 1.0 for milk).
+     */
+    double cost() const override
+    {
+        return m_coffee->cost() + 1.0;
+    }
+};
+
+/**
+ * @brief Concrete Decorator class for adding sugar to the coffee.
+ *
+ * The `SugarDecorator` class adds sugar functionality to the coffee object.
+ */
+class SugarDecorator : public CoffeeDecorator
+{
+public:
+    /**
+     * @brief Constructor that accepts a `Coffee` object to decorate.
+     *
+     * @param coffee A shared pointer to the `Coffee` object to be decorated.
+     */
+    explicit SugarDecorator(std::shared_ptr<Coffee> coffee)
+        : CoffeeDecorator(coffee)
+    {
+    }
+
+    /**
+     * @brief Get the description of the coffee with sugar.
+     *
+     * @return A string description of the coffee with sugar ("Simple Coffee with Sugar").
+     */
+    std::string getDescription() const override
+    {
+        return m_coffee->getDescription() + " with Sugar";
+    }
+
+    /**
+     * @brief Get the cost of the coffee with sugar.
+     *
+     * @return The cost of the coffee with sugar (cost of the base coffee + 0.5 for sugar).
+     */
+    double cost() const override
+    {
+        return m_coffee->cost() + 0.5;
+    }
+};
+
+/**
+ * @brief Static ingredient table shared by every configuration.
+ */
+struct Ingredient
+{
+    std::string_view name;
+    double cost;
+};
+
+inline constexpr std::array<Ingredient, 2> INGREDIENTS{{
+    {"Milk", 1.0},
+    {"Sugar", 0.5},
+}};
+
+/**
+ * @brief Value-based decorator composition: counts over the ingredient table.
+ *
+ * A configured product is 16-ish bytes of counts instead of a chain of heap
+ * nodes; adding an ingredient bumps a counter. cost() folds the table in one
+ * loop and is constexpr, so fully known configurations collapse to a constant
+ * at compile time. description() walks the same table once.
+ */
+class CoffeeConfig
+{
+public:
+    static constexpr double BASE_COST = 5.0; ///< SimpleCoffee's cost.
+
+    /**
+     * @brief Returns a copy with one more unit of the given ingredient.
+     */
+    constexpr CoffeeConfig with(std::size_t ingredient) const
+    {
+        CoffeeConfig result = *this;
+        ++result.m_counts[ingredient];
+        return result;
+    }
+
+    /**
+     * @brief Cost folded over the ingredient table; constexpr-foldable.
+     */
+    constexpr double cost() const
+    {
+        double total = BASE_COST;
+        for (std::size_t i = 0; i < INGREDIENTS.size(); ++i)
+        {
+            total += INGREDIENTS[i].cost * m_counts[i];
+        }
+        return total;
+    }
+
+    /**
+     * @brief Description built in one pass over the table.
+     */
+    std::string description() const
+    {
+        std::string text = "Simple Coffee";
+        for (std::size_t i = 0; i < INGREDIENTS.size(); ++i)
+        {
+            for (std::uint8_t unit = 0; unit < m_counts[i]; ++unit)
+            {
+                text += " with ";
+                text += INGREDIENTS[i].name;
+            }
+        }
+        return text;
+    }
+
+private:
+    std::array<std::uint8_t, INGREDIENTS.size()> m_counts{}; ///< Units per ingredient.
+};
+
+/// @brief Ingredient indexes into INGREDIENTS, for readable configuration code.
+inline constexpr std::size_t MILK = 0;
+inline constexpr std::size_t SUGAR = 1;
+
+/**
+ * @brief Main function demonstrating the Decorator pattern.
+ *
+ * This function demonstrates how the Decorator pattern allows you to add new functionality 
+ * (milk, sugar) to a coffee object dynamically, without modifying the base `SimpleCoffee` class.
+ */
+int main()
+{
+    // Create a simple coffee
+    std::shared_ptr<Coffee> coffee = std::make_shared<SimpleCoffee>();
+
+    // Decorate the coffee with milk
+    std::shared_ptr<Coffee> milkCoffee = std::make_shared<MilkDecorator>(coffee);
+
+    // Decorate the milk coffee with sugar
+    std::shared_ptr<Coffee> milkSugarCoffee = std::make_shared<SugarDecorator>(milkCoffee);
+
+    // Output the description and cost of the final coffee
+    std::cout << "Description: " << milkSugarCoffee->getDescription() << std::endl;
+    std::cout << "Cost: $" << milkSugarCoffee->cost() << std::endl;
+
+    // Value-based composition: same product, no heap nodes, no virtual walk.
+    constexpr CoffeeConfig configured = CoffeeConfig{}.with(MILK).with(SUGAR);
+    static_assert(configured.cost() == 6.5, "Cost folds at compile time");
+    std::cout << "Description: " << configured.description() << std::endl;
+    std::cout << "Cost: $" << configured.cost() << std::endl;
+
+    // Configuration benchmark: build-and-price a product a million times.
+    constexpr int products = 1000000;
+    volatile double sink = 0.0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < products; ++i)
+    {
+        std::shared_ptr<Coffee> chained = std::make_shared<SugarDecorator>(
+            std::make_shared<MilkDecorator>(std::make_shared<SimpleCoffee>()));
+        sink = sink + chained->cost();
+    }
+    double chainTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < products; ++i)
+    {
+        sink = sink + CoffeeConfig{}.with(MILK).with(SUGAR).cost();
+    }
+    double valueTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << products << " configured products: decorator chain " << chainTime
+              << " ms, value config " << valueTime << " ms" << std::endl;
+    (void)sink;
 
- #include <iostream>
- #include <memory>
- #include <string>
- 
- /**
-  * @brief Abstract Component class representing the base Coffee object.
-  *
-  * The `Coffee` class defines the interface for the object being decorated. All concrete objects
-  * (like `SimpleCoffee`) and decorators (like `MilkDecorator`) follow this interface.
-  */
- class Coffee
- {
- public:
-     virtual ~Coffee() = default;
- 
-     /**
-      * @brief Get the description of the coffee.
-      *
-      * This method returns a description of the coffee.
-      *
-      * @return A string describing the coffee.
-      */
-     virtual std::string getDescription() const = 0;
- 
-     /**
-      * @brief Get the cost of the coffee.
-      *
-      * This method returns the cost of the coffee.
-      *
-      * @return The cost of the coffee.
-      */
-     virtual double cost() const = 0;
- };
- 
- /**
-  * @brief Concrete Component class representing a simple coffee.
-  *
-  * The `SimpleCoffee` class implements the basic behavior of the `Coffee` interface.
-  * It represents a basic coffee without any additions.
-  */
- class SimpleCoffee : public Coffee
- {
- public:
-     /**
-      * @brief Get the description of the simple coffee.
-      *
-      * @return A string description of the simple coffee ("Simple Coffee").
-      */
-     std::string getDescription() const override
-     {
-         return "Simple Coffee";
-     }
- 
-     /**
-      * @brief Get the cost of the simple coffee.
-      *
-      * @return The cost of the simple coffee (5.0).
-      */
-     double cost() const override
-     {
-         return 5.0;
-     }
- };
- 
- /**
-  * @brief Abstract Decorator class for adding functionality to a Coffee object.
-  *
-  * The `CoffeeDecorator` class wraps a `Coffee` object and adds functionality to it.
-  * All concrete decorators must extend this class and implement their own behavior.
-  */
- class CoffeeDecorator : public Coffee
- {
- public:
-     /**
-      * @brief Constructor that accepts a `Coffee` object to decorate.
-      *
-      * @param coffee A shared pointer to the `Coffee` object to be decorated.
-      */
-     explicit CoffeeDecorator(std::shared_ptr<Coffee> coffee)
-         : m_coffee(coffee)
-     {
-     }
- 
-     /**
-      * @brief Get the description of the decorated coffee.
-      *
-      * This method delegates to the wrapped `Coffee` object's `getDescription()` method.
-      *
-      * @return The description of the decorated coffee.
-      */
-     std::string getDescription() const override
-     {
-         return m_coffee->getDescription();
-     }
- 
-     /**
-      * @brief Get the cost of the decorated coffee.
-      *
-      * This method delegates to the wrapped `Coffee` object's `cost()` method.
-      *
-      * @return The cost of the decorated coffee.
-      */
-     double cost() const override
-     {
-         return m_coffee->cost();
-     }
- 
- protected:
-     std::shared_ptr<Coffee> m_coffee; ///< The `Coffee` object being decorated
- };
- 
- /**
-  * @brief Concrete Decorator class for adding milk to the coffee.
-  *
-  * The `MilkDecorator` class adds milk functionality to the coffee object.
-  */
- class MilkDecorator : public CoffeeDecorator
- {
- public:
-     /**
-      * @brief Constructor that accepts a `Coffee` object to decorate.
-      *
-      * @param coffee A shared pointer to the `Coffee` object to be decorated.
-      */
-     explicit MilkDecorator(std::shared_ptr<Coffee> coffee)
-         : CoffeeDecorator(coffee)
-     {
-     }
- 
-     /**
-      * @brief Get the description of the coffee with milk.
-      *
-      * @return A string description of the coffee with milk ("Simple Coffee with Milk").
-      */
-     std::string getDescription() const override
-     {
-         return m_coffee->getDescription() + " with Milk";
-     }
- 
-     /**
-      * @brief Get the cost of the coffee with milk.
-      *
-      * @return The cost of the coffee with milk (cost of the base coffee + 1.0 for milk).
-      */
-     double cost() const override
-     {
-         return m_coffee->cost() + 1.0;
-     }
- };
- 
- /**
-  * @brief Concrete Decorator class for adding sugar to the coffee.
-  *
-  * The `SugarDecorator` class adds sugar functionality to the coffee object.
-  */
- class SugarDecorator : public CoffeeDecorator
- {
- public:
-     /**
-      * @brief Constructor that accepts a `Coffee` object to decorate.
-      *
-      * @param coffee A shared pointer to the `Coffee` object to be decorated.
-      */
-     explicit SugarDecorator(std::shared_ptr<Coffee> coffee)
-         : CoffeeDecorator(coffee)
-     {
-     }
- 
-     /**
-      * @brief Get the description of the coffee with sugar.
-      *
-      * @return A string description of the coffee with sugar ("Simple Coffee with Sugar").
-      */
-     std::string getDescription() const override
-     {
-         return m_coffee->getDescription() + " with Sugar";
-     }
- 
-     /**
-      * @brief Get the cost of the coffee with sugar.
-      *
-      * @return The cost of the coffee with sugar (cost of the base coffee + 0.5 for sugar).
-      */
-     double cost() const override
-     {
-         return m_coffee->cost() + 0.5;
-     }
- };
- 
- /**
-  * @brief Main function demonstrating the Decorator pattern.
-  *
-  * This function demonstrates how the Decorator pattern allows you to add new functionality 
-  * (milk, sugar) to a coffee object dynamically, without modifying the base `SimpleCoffee` class.
-  */
- int main()
- {
-     // Create a simple coffee
-     std::shared_ptr<Coffee> coffee = std::make_shared<SimpleCoffee>();
- 
-     // Decorate the coffee with milk
-     std::shared_ptr<Coffee> milkCoffee = std::make_shared<MilkDecorator>(coffee);
- 
-     // Decorate the milk coffee with sugar
-     std::shared_ptr<Coffee> milkSugarCoffee = std::make_shared<SugarDecorator>(milkCoffee);
- 
-     // Output the description and cost of the final coffee
-     std::cout << "Description: " << milkSugarCoffee->getDescription() << std::endl;
-     std::cout << "Cost: $" << milkSugarCoffee->cost() << std::endl;
- 
-     return 0;
- }
- 
\ No newline at end of file
+    return 0;
+}
@@ -2,11 +2,11 @@
  * @brief Dependency Injection Pattern in C++23 using shared_ptr.
  *
  * **Key Concepts:**
- * 1. **Dependency Injection (DI)**: A design pattern that promotes loose coupling by injecting dependencies 
+ * 1. **Dependency Injection (DI)**: A design pattern that promotes loose coupling by injecting dependencies
  *    rather than creating them inside a class.
  * 2. **Service Interface (`Service`)**: An abstract interface defining the contract for services.
  * 3. **Concrete Implementations (`ConcreteService`, `AnotherService`)**: Different implementations of the `Service` interface.
- * 4. **Client (`Client`)**: A class that depends on `Service` but does not create it internally. Instead, it receives 
+ * 4. **Client (`Client`)**: A class that depends on `Service` but does not create it internally. Instead, it receives
  *    an instance of `Service` via the constructor (injected dependency).
  *
  * **How it Works:**
@@ -18,118 +18,419 @@
  * - **Loose Coupling**: The `Client` is independent of specific `Service` implementations.
  * - **Testability**: Makes unit testing easier by allowing mock services to be injected.
  * - **Flexibility**: Allows changing or extending services at runtime without modifying dependent classes.
+ *
+ * A container that resolves every binding at runtime — map lookups, type
+ * erasure, shared_ptr control blocks — adds seconds to boot once the graph
+ * reaches thousands of bindings. The static container below declares
+ * bindings as template specializations, so the object graph is resolved and
+ * inlined at compile time for statically known components; instances are
+ * constructed in one contiguous graph arena, and singleton/transient
+ * lifetimes are enforced by the binding's type with no refcounting on the
+ * resolution path.
+ */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <functional>
+#include <vector>
+#include <type_traits>
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @brief Service Interface for the Dependency Injection pattern.
+ *
+ * The `Service` interface defines the contract for services that can be injected.
  */
+class Service
+{
+public:
+    virtual ~Service() = default;
 
- #include <iostream>
- #include <memory>
- #include <string>
- 
- /**
-  * @brief Service Interface for the Dependency Injection pattern.
-  * 
-  * The `Service` interface defines the contract for services that can be injected.
-  */
- class Service
- {
- public:
-     virtual ~Service() = default;
- 
-     /**
+    /**
       * @brief Perform some action defined by the service.
       *
       * This function should be implemented by concrete services to perform an operation.
       */
-     virtual void performAction() const = 0;
- };
- 
- /**
-  * @brief Concrete implementation of the Service interface.
-  * 
-  * `ConcreteService` is a specific implementation of the `Service` interface. It provides
-  * the actual behavior for `performAction()`.
-  */
- class ConcreteService : public Service
- {
- public:
-     /**
+    virtual void performAction() const = 0;
+};
+
+/**
+ * @brief Concrete implementation of the Service interface.
+ *
+ * `ConcreteService` is a specific implementation of the `Service` interface. It provides
+ * the actual behavior for `performAction()`.
+ */
+class ConcreteService : public Service
+{
+public:
+    /**
       * @brief Perform a specific action.
       *
       * This implementation prints a message when the action is performed.
       */
-     void performAction() const override
-     {
-         std::cout << "ConcreteService is performing an action." << std::endl;
-     }
- };
- 
- /**
-  * @brief Another concrete implementation of the Service interface.
-  * 
-  * `AnotherService` is another service that provides its own implementation of `performAction()`.
-  */
- class AnotherService : public Service
- {
- public:
-     /**
+    void performAction() const override
+    {
+        std::cout << "ConcreteService is performing an action." << std::endl;
+    }
+};
+
+/**
+ * @brief Another concrete implementation of the Service interface.
+ *
+ * `AnotherService` is another service that provides its own implementation of `performAction()`.
+ */
+class AnotherService : public Service
+{
+public:
+    /**
       * @brief Perform a different action.
       *
       * This implementation prints a different message when the action is performed.
       */
-     void performAction() const override
-     {
-         std::cout << "AnotherService is performing a different action." << std::endl;
-     }
- };
- 
- /**
-  * @brief Client class that uses dependency injection to receive its dependencies.
-  * 
-  * The `Client` class depends on the `Service` interface. The service is injected via the
-  * constructor, allowing the client to interact with any concrete implementation of `Service`.
-  */
- class Client
- {
- public:
-     /**
+    void performAction() const override
+    {
+        std::cout << "AnotherService is performing a different action." << std::endl;
+    }
+};
+
+/**
+ * @brief Client class that uses dependency injection to receive its dependencies.
+ *
+ * The `Client` class depends on the `Service` interface. The service is injected via the
+ * constructor, allowing the client to interact with any concrete implementation of `Service`.
+ */
+class Client
+{
+public:
+    /**
       * @brief Constructor that accepts a shared pointer to a Service.
-      * 
+      *
       * @param service A shared pointer to an object that implements the `Service` interface.
       */
-     Client(std::shared_ptr<Service> service) : m_service(service) {}
- 
-     /**
+    Client(std::shared_ptr<Service> service) : m_service(service) {}
+
+    /**
       * @brief Perform the action using the injected service.
       *
       * This method calls the `performAction()` method of the injected service.
       */
-     void executeAction() const
-     {
-         m_service->performAction();
-     }
- 
- private:
-     std::shared_ptr<Service> m_service;  ///< The service dependency that is injected into the client.
- };
- 
- /**
-  * @brief Main function demonstrating Dependency Injection.
-  * 
-  * In this example, we create different services and inject them into the `Client` class.
-  * This allows the client to work with different behaviors without being tightly coupled
-  * to any specific service implementation.
-  */
- int main()
- {
-     // Inject ConcreteService into Client
-     std::shared_ptr<Service> service1 = std::make_shared<ConcreteService>();
-     Client client1(service1);
-     client1.executeAction();  // Output: ConcreteService is performing an action.
- 
-     // Inject AnotherService into Client
-     std::shared_ptr<Service> service2 = std::make_shared<AnotherService>();
-     Client client2(service2);
-     client2.executeAction();  // Output: AnotherService is performing a different action.
- 
-     return 0;
- }
- 
\ No newline at end of file
+    void executeAction() const
+    {
+        m_service->performAction();
+    }
+
+private:
+    std::shared_ptr<Service> m_service;  ///< The service dependency that is injected into the client.
+};
+
+/**
+ * @brief Quiet leaf component used by the container benchmarks.
+ */
+class QuietLogger
+{
+public:
+    void log() { ++m_lines; }
+    std::size_t lines() const { return m_lines; }
+
+private:
+    std::size_t m_lines{0}; ///< Messages seen.
+};
+
+/**
+ * @brief Singleton component with one dependency.
+ */
+class ConnectionPool
+{
+public:
+    explicit ConnectionPool(QuietLogger& logger)
+        : m_logger(logger)
+    {
+        m_logger.log(); // "pool ready"
+    }
+
+    std::size_t lease() { return ++m_leases; }
+
+private:
+    QuietLogger& m_logger;
+    std::size_t m_leases{0};
+};
+
+/**
+ * @brief Transient component; one is built per request.
+ */
+class RequestProcessor
+{
+public:
+    RequestProcessor(ConnectionPool& pool, QuietLogger& logger)
+        : m_pool(pool), m_logger(logger)
+    {}
+
+    std::size_t process()
+    {
+        m_logger.log();
+        return m_pool.lease();
+    }
+
+private:
+    ConnectionPool& m_pool;
+    QuietLogger& m_logger;
+};
+
+/**
+ * @brief Runtime container baseline: string-keyed factories, shared_ptr graphs.
+ */
+class RuntimeContainer
+{
+public:
+    /// @brief Registers a type-erased factory under a binding name.
+    void bind(const std::string& name, std::function<std::shared_ptr<void>(RuntimeContainer&)> factory)
+    {
+        m_factories[name] = std::move(factory);
+    }
+
+    /// @brief Resolves a binding; singletons are cached by name.
+    template <typename T>
+    std::shared_ptr<T> resolveSingleton(const std::string& name)
+    {
+        auto cached = m_singletons.find(name);
+        if (cached != m_singletons.end())
+        {
+            return std::static_pointer_cast<T>(cached->second);
+        }
+        std::shared_ptr<void> instance = m_factories.at(name)(*this);
+        m_singletons.emplace(name, instance);
+        return std::static_pointer_cast<T>(instance);
+    }
+
+    /// @brief Resolves a fresh instance through the factory map.
+    template <typename T>
+    std::shared_ptr<T> resolveTransient(const std::string& name)
+    {
+        return std::static_pointer_cast<T>(m_factories.at(name)(*this));
+    }
+
+private:
+    std::unordered_map<std::string, std::function<std::shared_ptr<void>(RuntimeContainer&)>> m_factories;
+    std::unordered_map<std::string, std::shared_ptr<void>> m_singletons;
+};
+
+/**
+ * @brief Arena that holds an entire object graph in one allocation.
+ *
+ * Instances are placement-new'd into bump-allocated storage and torn down
+ * together when the arena is destroyed, newest first.
+ */
+class GraphArena
+{
+public:
+    explicit GraphArena(std::size_t capacityBytes)
+        : m_buffer(capacityBytes)
+    {}
+
+    ~GraphArena()
+    {
+        for (auto it = m_deleters.rbegin(); it != m_deleters.rend(); ++it)
+        {
+            it->destroy(it->object);
+        }
+    }
+
+    /// @brief Constructs a T in the arena and registers its destructor.
+    template <typename T, typename... Args>
+    T& construct(Args&&... args)
+    {
+        std::size_t offset = (m_used + alignof(T) - 1) & ~(alignof(T) - 1);
+        m_used = offset + sizeof(T);
+        T* object = new (m_buffer.data() + offset) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            m_deleters.push_back({object, [](void* raw) { static_cast<T*>(raw)->~T(); }});
+        }
+        return *object;
+    }
+
+private:
+    struct Deleter
+    {
+        void* object;
+        void (*destroy)(void*);
+    };
+
+    std::vector<std::byte> m_buffer; ///< The single graph allocation.
+    std::size_t m_used{0};           ///< Bump offset.
+    std::vector<Deleter> m_deleters; ///< Non-trivial teardowns, in order.
+};
+
+/// @brief Lifetime policies enforced by the binding's type.
+struct SingletonLifetime {};
+struct TransientLifetime {};
+
+/**
+ * @brief Binding declarations: one template specialization per interface.
+ *
+ * The primary template is left undefined, so resolving an unbound
+ * interface fails at compile time.
+ */
+template <typename Interface>
+struct Binding;
+
+/// @brief Interface tags for the statically wired graph.
+struct LoggerService {};
+struct PoolService {};
+struct ProcessorService {};
+
+template <>
+struct Binding<LoggerService>
+{
+    using Implementation = QuietLogger;
+    using Lifetime = SingletonLifetime;
+};
+
+template <>
+struct Binding<PoolService>
+{
+    using Implementation = ConnectionPool;
+    using Lifetime = SingletonLifetime;
+};
+
+template <>
+struct Binding<ProcessorService>
+{
+    using Implementation = RequestProcessor;
+    using Lifetime = TransientLifetime;
+};
+
+/**
+ * @brief Compile-time container: bindings are types, resolution is inlined.
+ *
+ * resolve<Interface>() returns a plain reference — no shared_ptr, no
+ * refcount. Singletons are constructed on first resolve and cached in a
+ * per-implementation slot; transients get a fresh arena instance per call.
+ * Because every binding is known statically, the whole resolution chain
+ * inlines and the graph lands contiguously in the arena.
+ */
+class StaticContainer
+{
+public:
+    explicit StaticContainer(std::size_t arenaBytes)
+        : m_arena(arenaBytes)
+    {}
+
+    /// @brief Resolves an interface to its bound implementation.
+    template <typename Interface>
+    typename Binding<Interface>::Implementation& resolve()
+    {
+        using Impl = typename Binding<Interface>::Implementation;
+        if constexpr (std::is_same_v<typename Binding<Interface>::Lifetime, SingletonLifetime>)
+        {
+            Impl*& slot = SingletonSlot<Impl>::instance;
+            if (!slot)
+            {
+                slot = &construct<Impl>();
+            }
+            return *slot;
+        }
+        else
+        {
+            return construct<Impl>(); // Transient: fresh, still arena-resident.
+        }
+    }
+
+private:
+    /// @brief Process-wide singleton slot for one implementation type.
+    template <typename Impl>
+    struct SingletonSlot
+    {
+        static inline Impl* instance = nullptr;
+    };
+
+    /// @brief Builds an implementation, wiring its dependencies recursively.
+    template <typename Impl>
+    Impl& construct()
+    {
+        if constexpr (std::is_same_v<Impl, ConnectionPool>)
+        {
+            return m_arena.construct<Impl>(resolve<LoggerService>());
+        }
+        else if constexpr (std::is_same_v<Impl, RequestProcessor>)
+        {
+            return m_arena.construct<Impl>(resolve<PoolService>(), resolve<LoggerService>());
+        }
+        else
+        {
+            return m_arena.construct<Impl>();
+        }
+    }
+
+    GraphArena m_arena;
+};
+
+/**
+ * @brief Main function demonstrating Dependency Injection.
+ *
+ * In this example, we create different services and inject them into the `Client` class.
+ * This allows the client to work with different behaviors without being tightly coupled
+ * to any specific service implementation.
+ */
+int main()
+{
+    // Inject ConcreteService into Client
+    std::shared_ptr<Service> service1 = std::make_shared<ConcreteService>();
+    Client client1(service1);
+    client1.executeAction();  // Output: ConcreteService is performing an action.
+
+    // Inject AnotherService into Client
+    std::shared_ptr<Service> service2 = std::make_shared<AnotherService>();
+    Client client2(service2);
+    client2.executeAction();  // Output: AnotherService is performing a different action.
+
+    // Container showdown: runtime factory maps vs compile-time bindings.
+    constexpr std::size_t resolveCount = 200000;
+
+    RuntimeContainer runtime;
+    runtime.bind("logger", [](RuntimeContainer&) -> std::shared_ptr<void>
+    {
+        return std::make_shared<QuietLogger>();
+    });
+    runtime.bind("pool", [](RuntimeContainer& container) -> std::shared_ptr<void>
+    {
+        return std::make_shared<ConnectionPool>(*container.resolveSingleton<QuietLogger>("logger"));
+    });
+    runtime.bind("processor", [](RuntimeContainer& container) -> std::shared_ptr<void>
+    {
+        return std::make_shared<RequestProcessor>(*container.resolveSingleton<ConnectionPool>("pool"),
+                                                  *container.resolveSingleton<QuietLogger>("logger"));
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t runtimeLeases = 0;
+    for (std::size_t i = 0; i < resolveCount; ++i)
+    {
+        runtimeLeases += runtime.resolveTransient<RequestProcessor>("processor")->process();
+    }
+    double runtimeTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    StaticContainer container(resolveCount * sizeof(RequestProcessor) + 1024);
+    start = std::chrono::steady_clock::now();
+    std::size_t staticLeases = 0;
+    for (std::size_t i = 0; i < resolveCount; ++i)
+    {
+        staticLeases += container.resolve<ProcessorService>().process(); // Inlined, no refcounts.
+    }
+    double staticTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Lifetimes: the singleton pool is one instance; processors are fresh.
+    bool sharedPool = &container.resolve<PoolService>() == &container.resolve<PoolService>();
+    bool freshProcessors = &container.resolve<ProcessorService>() != &container.resolve<ProcessorService>();
+
+    std::cout << resolveCount << " resolution(s): runtime container " << runtimeTime
+              << " ms, static container " << staticTime << " ms (leases "
+              << runtimeLeases << " / " << staticLeases << "; singleton pool shared: "
+              << (sharedPool ? "yes" : "no") << ", transient processors fresh: "
+              << (freshProcessors ? "yes" : "no") << ")" << std::endl;
+
+    return 0;
+}
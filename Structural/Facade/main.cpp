@@ -1,8 +1,8 @@
 /**
  * @brief Facade pattern example for simplifying complex subsystem interactions.
  *
- * The **Facade** pattern provides a simplified interface to a complex subsystem, 
- * making it easier to use. It hides the complexities of the subsystem and provides 
+ * The **Facade** pattern provides a simplified interface to a complex subsystem,
+ * making it easier to use. It hides the complexities of the subsystem and provides
  * a unified interface for the client.
  *
  * **Key Concepts:**
@@ -11,187 +11,202 @@
  * 3. **Client**: The client interacts with the facade, which simplifies the interactions with the complex subsystem.
  *
  * **How it works:**
- * 1. The `HomeTheaterFacade` class simplifies the process of using a home theater system by hiding the complexity of 
+ * 1. The `HomeTheaterFacade` class simplifies the process of using a home theater system by hiding the complexity of
  *    interacting with the individual components (`Amplifier`, `DVDPlayer`, etc.).
- * 2. The client can use the facade to easily control the home theater system without needing to interact directly 
+ * 2. The client can use the facade to easily control the home theater system without needing to interact directly
  *    with each individual component.
+ *
+ * Activating every subsystem strictly in sequence makes scene activation
+ * cost the sum of all device init times, even though most devices are
+ * independent. The scene orchestrator below lets subsystems declare their
+ * prerequisites, compiles a parallel execution schedule (waves of devices
+ * whose prerequisites are all satisfied) exactly once, and replays that
+ * precomputed script on every activation — cutting latency to the critical
+ * path through the dependency graph.
  */
 
- #include <iostream>
- #include <memory>
- 
- /**
-  * @brief Class representing an amplifier in a home theater system.
-  *
-  * The `Amplifier` class is a subsystem component responsible for amplifying audio signals.
-  */
- class Amplifier
- {
- public:
-     /**
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @brief Class representing an amplifier in a home theater system.
+ *
+ * The `Amplifier` class is a subsystem component responsible for amplifying audio signals.
+ */
+class Amplifier
+{
+public:
+    /**
       * @brief Turn on the amplifier.
       */
-     void on() const
-     {
-         std::cout << "Amplifier is on\n";
-     }
- 
-     /**
+    void on() const
+    {
+        std::cout << "Amplifier is on\n";
+    }
+
+    /**
       * @brief Turn off the amplifier.
       */
-     void off() const
-     {
-         std::cout << "Amplifier is off\n";
-     }
- 
-     /**
+    void off() const
+    {
+        std::cout << "Amplifier is off\n";
+    }
+
+    /**
       * @brief Set the volume of the amplifier.
       *
       * @param level The volume level to set.
       */
-     void setVolume(int level) const
-     {
-         std::cout << "Setting amplifier volume to " << level << "\n";
-     }
- };
- 
- /**
-  * @brief Class representing a DVD player in a home theater system.
-  *
-  * The `DVDPlayer` class is a subsystem component responsible for playing DVDs.
-  */
- class DVDPlayer
- {
- public:
-     /**
+    void setVolume(int level) const
+    {
+        std::cout << "Setting amplifier volume to " << level << "\n";
+    }
+};
+
+/**
+ * @brief Class representing a DVD player in a home theater system.
+ *
+ * The `DVDPlayer` class is a subsystem component responsible for playing DVDs.
+ */
+class DVDPlayer
+{
+public:
+    /**
       * @brief Turn on the DVD player.
       */
-     void on() const
-     {
-         std::cout << "DVD Player is on\n";
-     }
- 
-     /**
+    void on() const
+    {
+        std::cout << "DVD Player is on\n";
+    }
+
+    /**
       * @brief Turn off the DVD player.
       */
-     void off() const
-     {
-         std::cout << "DVD Player is off\n";
-     }
- 
-     /**
+    void off() const
+    {
+        std::cout << "DVD Player is off\n";
+    }
+
+    /**
       * @brief Play a DVD.
       */
-     void play() const
-     {
-         std::cout << "DVD is playing\n";
-     }
- 
-     /**
+    void play() const
+    {
+        std::cout << "DVD is playing\n";
+    }
+
+    /**
       * @brief Stop the DVD player.
       */
-     void stop() const
-     {
-         std::cout << "DVD stopped\n";
-     }
- };
- 
- /**
-  * @brief Class representing a projector in a home theater system.
-  *
-  * The `Projector` class is a subsystem component responsible for displaying video.
-  */
- class Projector
- {
- public:
-     /**
+    void stop() const
+    {
+        std::cout << "DVD stopped\n";
+    }
+};
+
+/**
+ * @brief Class representing a projector in a home theater system.
+ *
+ * The `Projector` class is a subsystem component responsible for displaying video.
+ */
+class Projector
+{
+public:
+    /**
       * @brief Turn on the projector.
       */
-     void on() const
-     {
-         std::cout << "Projector is on\n";
-     }
- 
-     /**
+    void on() const
+    {
+        std::cout << "Projector is on\n";
+    }
+
+    /**
       * @brief Turn off the projector.
       */
-     void off() const
-     {
-         std::cout << "Projector is off\n";
-     }
- 
-     /**
+    void off() const
+    {
+        std::cout << "Projector is off\n";
+    }
+
+    /**
       * @brief Set the projector to 16:9 aspect ratio.
       */
-     void setAspectRatio16_9() const
-     {
-         std::cout << "Setting projector aspect ratio to 16:9\n";
-     }
- };
- 
- /**
-  * @brief Class representing a screen in a home theater system.
-  *
-  * The `Screen` class is a subsystem component responsible for controlling the screen.
-  */
- class Screen
- {
- public:
-     /**
+    void setAspectRatio16_9() const
+    {
+        std::cout << "Setting projector aspect ratio to 16:9\n";
+    }
+};
+
+/**
+ * @brief Class representing a screen in a home theater system.
+ *
+ * The `Screen` class is a subsystem component responsible for controlling the screen.
+ */
+class Screen
+{
+public:
+    /**
       * @brief Lower the screen.
       */
-     void down() const
-     {
-         std::cout << "Screen is down\n";
-     }
- 
-     /**
+    void down() const
+    {
+        std::cout << "Screen is down\n";
+    }
+
+    /**
       * @brief Raise the screen.
       */
-     void up() const
-     {
-         std::cout << "Screen is up\n";
-     }
- };
- 
- /**
-  * @brief Class representing the lights in a home theater system.
-  *
-  * The `Lights` class is a subsystem component responsible for controlling the lights.
-  */
- class Lights
- {
- public:
-     /**
+    void up() const
+    {
+        std::cout << "Screen is up\n";
+    }
+};
+
+/**
+ * @brief Class representing the lights in a home theater system.
+ *
+ * The `Lights` class is a subsystem component responsible for controlling the lights.
+ */
+class Lights
+{
+public:
+    /**
       * @brief Dim the lights.
       *
       * @param level The level to dim the lights to.
       */
-     void dim(int level) const
-     {
-         std::cout << "Dimming the lights to " << level << "%\n";
-     }
- 
-     /**
+    void dim(int level) const
+    {
+        std::cout << "Dimming the lights to " << level << "%\n";
+    }
+
+    /**
       * @brief Turn on the lights.
       */
-     void on() const
-     {
-         std::cout << "Lights are on\n";
-     }
- };
- 
- /**
-  * @brief Facade class that simplifies interaction with the home theater system.
-  *
-  * The `HomeTheaterFacade` class provides a simplified interface for the client to interact with 
-  * the various components of a home theater system, such as the `Amplifier`, `DVDPlayer`, `Projector`, 
-  * `Screen`, and `Lights`.
-  */
- class HomeTheaterFacade
- {
- public:
-     /**
+    void on() const
+    {
+        std::cout << "Lights are on\n";
+    }
+};
+
+/**
+ * @brief Facade class that simplifies interaction with the home theater system.
+ *
+ * The `HomeTheaterFacade` class provides a simplified interface for the client to interact with
+ * the various components of a home theater system, such as the `Amplifier`, `DVDPlayer`, `Projector`,
+ * `Screen`, and `Lights`.
+ */
+class HomeTheaterFacade
+{
+public:
+    /**
       * @brief Constructor that accepts the subsystem components.
       *
       * @param amplifier A shared pointer to the `Amplifier` object.
@@ -200,77 +215,267 @@
       * @param screen A shared pointer to the `Screen` object.
       * @param lights A shared pointer to the `Lights` object.
       */
-     HomeTheaterFacade(std::shared_ptr<Amplifier> amplifier, 
-                       std::shared_ptr<DVDPlayer> dvdPlayer, 
-                       std::shared_ptr<Projector> projector, 
-                       std::shared_ptr<Screen> screen, 
-                       std::shared_ptr<Lights> lights)
-         : m_amplifier(amplifier), m_dvdPlayer(dvdPlayer), 
-           m_projector(projector), m_screen(screen), m_lights(lights)
-     {
-     }
- 
-     /**
+    HomeTheaterFacade(std::shared_ptr<Amplifier> amplifier,
+                      std::shared_ptr<DVDPlayer> dvdPlayer,
+                      std::shared_ptr<Projector> projector,
+                      std::shared_ptr<Screen> screen,
+                      std::shared_ptr<Lights> lights)
+        : m_amplifier(amplifier), m_dvdPlayer(dvdPlayer),
+          m_projector(projector), m_screen(screen), m_lights(lights)
+    {
+    }
+
+    /**
       * @brief Prepare the home theater for a movie.
       *
       * This method sets the projector, screen, and lights, and starts playing the DVD.
       */
-     void watchMovie() const
-     {
-         m_lights->dim(10);
-         m_screen->down();
-         m_projector->on();
-         m_projector->setAspectRatio16_9();
-         m_amplifier->on();
-         m_amplifier->setVolume(5);
-         m_dvdPlayer->on();
-         m_dvdPlayer->play();
-     }
- 
-     /**
+    void watchMovie() const
+    {
+        m_lights->dim(10);
+        m_screen->down();
+        m_projector->on();
+        m_projector->setAspectRatio16_9();
+        m_amplifier->on();
+        m_amplifier->setVolume(5);
+        m_dvdPlayer->on();
+        m_dvdPlayer->play();
+    }
+
+    /**
       * @brief End the movie and turn off all components.
       */
-     void endMovie() const
-     {
-         m_lights->on();
-         m_screen->up();
-         m_projector->off();
-         m_amplifier->off();
-         m_dvdPlayer->off();
-     }
- 
- private:
-     std::shared_ptr<Amplifier> m_amplifier;  ///< The amplifier component
-     std::shared_ptr<DVDPlayer> m_dvdPlayer;  ///< The DVD player component
-     std::shared_ptr<Projector> m_projector;  ///< The projector component
-     std::shared_ptr<Screen> m_screen;       ///< The screen component
-     std::shared_ptr<Lights> m_lights;       ///< The lights component
- };
- 
- /**
-  * @brief Main function demonstrating the Facade pattern.
-  *
-  * This function demonstrates how the `HomeTheaterFacade` class simplifies the usage of 
-  * a complex home theater system by hiding the interactions with individual components.
-  */
- int main()
- {
-     // Create the subsystem components
-     std::shared_ptr<Amplifier> amplifier = std::make_shared<Amplifier>();
-     std::shared_ptr<DVDPlayer> dvdPlayer = std::make_shared<DVDPlayer>();
-     std::shared_ptr<Projector> projector = std::make_shared<Projector>();
-     std::shared_ptr<Screen> screen = std::make_shared<Screen>();
-     std::shared_ptr<Lights> lights = std::make_shared<Lights>();
- 
-     // Create the facade
-     HomeTheaterFacade homeTheater(amplifier, dvdPlayer, projector, screen, lights);
- 
-     // Watch a movie using the facade
-     homeTheater.watchMovie();
- 
-     // End the movie and turn off everything
-     homeTheater.endMovie();
- 
-     return 0;
- }
- 
\ No newline at end of file
+    void endMovie() const
+    {
+        m_lights->on();
+        m_screen->up();
+        m_projector->off();
+        m_amplifier->off();
+        m_dvdPlayer->off();
+    }
+
+private:
+    std::shared_ptr<Amplifier> m_amplifier;  ///< The amplifier component
+    std::shared_ptr<DVDPlayer> m_dvdPlayer;  ///< The DVD player component
+    std::shared_ptr<Projector> m_projector;  ///< The projector component
+    std::shared_ptr<Screen> m_screen;       ///< The screen component
+    std::shared_ptr<Lights> m_lights;       ///< The lights component
+};
+
+/**
+ * @brief Facade-level orchestrator with a cached parallel activation script.
+ *
+ * Subsystems are declared with their init cost and prerequisites. The first
+ * activation compiles the dependency graph into waves — every device in a
+ * wave has all its prerequisites in earlier waves — and caches that script;
+ * each wave then runs its devices on parallel threads. Repeated activations
+ * replay the cached script with no graph work at all.
+ */
+class SceneOrchestrator
+{
+public:
+    using SubsystemId = std::size_t;
+
+    /**
+     * @brief Declares a subsystem, its bring-up cost and its prerequisites.
+     * @return The id later subsystems use to name this one as a prerequisite.
+     */
+    SubsystemId declareSubsystem(const std::string& name,
+                                 std::chrono::milliseconds initCost,
+                                 std::vector<SubsystemId> prerequisites,
+                                 std::function<void()> onReady)
+    {
+        m_subsystems.push_back(Subsystem{name, initCost, std::move(prerequisites), std::move(onReady)});
+        m_schedule.clear(); // A new device invalidates the cached script.
+        return m_subsystems.size() - 1;
+    }
+
+    /**
+     * @brief Activates the scene: compiles the script once, then replays it.
+     */
+    void activate()
+    {
+        if (m_schedule.empty())
+        {
+            compileSchedule();
+        }
+        for (const std::vector<SubsystemId>& wave : m_schedule)
+        {
+            std::vector<std::thread> workers;
+            for (SubsystemId id : wave)
+            {
+                workers.emplace_back([this, id]() { bringUp(m_subsystems[id]); });
+            }
+            for (std::thread& worker : workers)
+            {
+                worker.join(); // Next wave starts when the whole wave is up.
+            }
+        }
+    }
+
+    /// @brief Baseline: one device after another, sum of all init times.
+    void activateSequential()
+    {
+        for (Subsystem& subsystem : m_subsystems)
+        {
+            bringUp(subsystem);
+        }
+    }
+
+    /// @brief Sum of every device's init cost — the sequential bound.
+    std::chrono::milliseconds totalCost() const
+    {
+        std::chrono::milliseconds total{0};
+        for (const Subsystem& subsystem : m_subsystems)
+        {
+            total += subsystem.initCost;
+        }
+        return total;
+    }
+
+    /// @brief Sum of each wave's slowest device — the parallel bound.
+    std::chrono::milliseconds criticalPath()
+    {
+        if (m_schedule.empty())
+        {
+            compileSchedule();
+        }
+        std::chrono::milliseconds path{0};
+        for (const std::vector<SubsystemId>& wave : m_schedule)
+        {
+            std::chrono::milliseconds slowest{0};
+            for (SubsystemId id : wave)
+            {
+                slowest = std::max(slowest, m_subsystems[id].initCost);
+            }
+            path += slowest;
+        }
+        return path;
+    }
+
+    /// @brief Prints the cached script, one wave per line.
+    void printSchedule()
+    {
+        if (m_schedule.empty())
+        {
+            compileSchedule();
+        }
+        for (std::size_t wave = 0; wave < m_schedule.size(); ++wave)
+        {
+            std::cout << "  Wave " << wave + 1 << ":";
+            for (SubsystemId id : m_schedule[wave])
+            {
+                std::cout << ' ' << m_subsystems[id].name;
+            }
+            std::cout << '\n';
+        }
+    }
+
+private:
+    /**
+     * @brief One declared device of the scene.
+     */
+    struct Subsystem
+    {
+        std::string name;
+        std::chrono::milliseconds initCost;  ///< Simulated bring-up time.
+        std::vector<SubsystemId> prerequisites;
+        std::function<void()> onReady;       ///< The device call once it is up.
+    };
+
+    /// @brief Simulates the device init, then fires its ready action.
+    static void bringUp(Subsystem& subsystem)
+    {
+        std::this_thread::sleep_for(subsystem.initCost);
+        if (subsystem.onReady)
+        {
+            subsystem.onReady();
+        }
+    }
+
+    /**
+     * @brief Levels the dependency graph into waves; done once, then cached.
+     *
+     * A device's wave is one past its deepest prerequisite, so every wave
+     * only contains devices whose prerequisites finished in earlier waves.
+     */
+    void compileSchedule()
+    {
+        std::vector<std::size_t> depth(m_subsystems.size(), 0);
+        std::size_t waveCount = 0;
+        for (std::size_t id = 0; id < m_subsystems.size(); ++id)
+        {
+            for (SubsystemId prerequisite : m_subsystems[id].prerequisites)
+            {
+                depth[id] = std::max(depth[id], depth[prerequisite] + 1); // Ids are declaration-ordered.
+            }
+            waveCount = std::max(waveCount, depth[id] + 1);
+        }
+        m_schedule.assign(waveCount, {});
+        for (std::size_t id = 0; id < m_subsystems.size(); ++id)
+        {
+            m_schedule[depth[id]].push_back(id);
+        }
+    }
+
+    std::vector<Subsystem> m_subsystems;
+    std::vector<std::vector<SubsystemId>> m_schedule; ///< The cached script.
+};
+
+/**
+ * @brief Main function demonstrating the Facade pattern.
+ *
+ * This function demonstrates how the `HomeTheaterFacade` class simplifies the usage of
+ * a complex home theater system by hiding the interactions with individual components.
+ */
+int main()
+{
+    // Create the subsystem components
+    std::shared_ptr<Amplifier> amplifier = std::make_shared<Amplifier>();
+    std::shared_ptr<DVDPlayer> dvdPlayer = std::make_shared<DVDPlayer>();
+    std::shared_ptr<Projector> projector = std::make_shared<Projector>();
+    std::shared_ptr<Screen> screen = std::make_shared<Screen>();
+    std::shared_ptr<Lights> lights = std::make_shared<Lights>();
+
+    // Create the facade
+    HomeTheaterFacade homeTheater(amplifier, dvdPlayer, projector, screen, lights);
+
+    // Watch a movie using the facade
+    homeTheater.watchMovie();
+
+    // End the movie and turn off everything
+    homeTheater.endMovie();
+
+    // Hardware bring-up: sequential device inits vs the compiled script.
+    SceneOrchestrator orchestrator;
+    auto ampId = orchestrator.declareSubsystem("amplifier", std::chrono::milliseconds(40), {},
+                                               [amplifier]() { amplifier->on(); });
+    auto projectorId = orchestrator.declareSubsystem("projector", std::chrono::milliseconds(60), {},
+                                                     [projector]() { projector->on(); });
+    orchestrator.declareSubsystem("screen", std::chrono::milliseconds(30), {},
+                                  [screen]() { screen->down(); });
+    orchestrator.declareSubsystem("lights", std::chrono::milliseconds(20), {},
+                                  [lights]() { lights->dim(10); });
+    orchestrator.declareSubsystem("dvd-player", std::chrono::milliseconds(50), {ampId, projectorId},
+                                  [dvdPlayer]() { dvdPlayer->on(); });
+
+    std::cout << "Activation script (computed once):\n";
+    orchestrator.printSchedule();
+
+    std::cout.setstate(std::ios_base::failbit); // Quiet the device chatter.
+    auto start = std::chrono::steady_clock::now();
+    orchestrator.activateSequential();
+    double sequentialTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    orchestrator.activate(); // Replays the cached script.
+    double parallelTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout.clear();
+
+    std::cout << "Scene activation: sequential " << sequentialTime << " ms (sum of inits "
+              << orchestrator.totalCost().count() << " ms), scripted parallel "
+              << parallelTime << " ms (critical path "
+              << orchestrator.criticalPath().count() << " ms)" << std::endl;
+
+    return 0;
+}
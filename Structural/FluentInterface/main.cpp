@@ -1,5 +1,9 @@
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 
 class MyObject
 {
@@ -13,7 +17,7 @@ public:
         return *this;
     }
 
-    MyObject& print() 
+    MyObject& print()
     {
         std::cout << "Name: " << name << std::endl;
         return *this;
@@ -26,10 +30,142 @@ public:
     }
 };
 
+// Heap-backed baseline: every chained setter copies into a std::string
+class HeapConfig
+{
+private:
+    std::string name;
+    std::string host;
+    int port = 0;
+
+public:
+    HeapConfig& setName(const std::string& newName)
+    {
+        name = newName;
+        return *this;
+    }
+
+    HeapConfig& setHost(const std::string& newHost)
+    {
+        host = newHost;
+        return *this;
+    }
+
+    HeapConfig& setPort(int newPort)
+    {
+        port = newPort;
+        return *this;
+    }
+
+    std::size_t checksum() const
+    {
+        return name.size() + host.size() + static_cast<std::size_t>(port);
+    }
+};
+
+// Fixed-capacity inline string: lives entirely inside the object, constexpr-friendly
+template <std::size_t Capacity>
+class InlineString
+{
+private:
+    char data[Capacity] = {};
+    std::size_t length = 0;
+
+public:
+    constexpr InlineString() = default;
+
+    constexpr void assign(std::string_view text)
+    {
+        length = std::min(text.size(), Capacity);
+        std::copy_n(text.data(), length, data);
+    }
+
+    constexpr std::string_view view() const { return std::string_view(data, length); }
+    constexpr std::size_t size() const { return length; }
+};
+
+// Zero-allocation fluent config: rvalue-qualified chain methods move the
+// temporary along instead of copying, members use inline storage so typical
+// configs never touch the heap, and everything is constexpr so a fully
+// static chain folds to a compile-time constant
+class FluentConfig
+{
+private:
+    InlineString<48> name;
+    InlineString<48> host;
+    int port = 0;
+
+public:
+    constexpr FluentConfig() = default;
+
+    constexpr FluentConfig&& withName(std::string_view newName) &&
+    {
+        name.assign(newName);
+        return std::move(*this);
+    }
+
+    constexpr FluentConfig&& withHost(std::string_view newHost) &&
+    {
+        host.assign(newHost);
+        return std::move(*this);
+    }
+
+    constexpr FluentConfig&& withPort(int newPort) &&
+    {
+        port = newPort;
+        return std::move(*this);
+    }
+
+    constexpr std::size_t checksum() const
+    {
+        return name.size() + host.size() + static_cast<std::size_t>(port);
+    }
+
+    constexpr int getPort() const { return port; }
+};
+
+// A fully static chain folds at compile time
+constexpr FluentConfig staticConfig = FluentConfig{}.withName("static-pipeline").withPort(8080);
+static_assert(staticConfig.getPort() == 8080);
+static_assert(staticConfig.checksum() == 8095);
+
 int main()
 {
     MyObject obj;
     obj.setName("Fluent Example").print().doSomething();
 
+    // Millions of configs per batch: heap-backed chain vs rvalue inline chain
+    constexpr std::size_t configCount = 2000000;
+
+    std::string longName = "batch-configuration-object-name"; // Past SSO, so the baseline allocates
+    std::string longHost = "batch-processing-host.internal";
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t heapTotal = 0;
+    for (std::size_t i = 0; i < configCount; ++i)
+    {
+        HeapConfig config;
+        config.setName(longName).setHost(longHost).setPort(static_cast<int>(i & 1023));
+        heapTotal += config.checksum();
+    }
+    double heapTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    std::size_t inlineTotal = 0;
+    for (std::size_t i = 0; i < configCount; ++i)
+    {
+        FluentConfig config = FluentConfig{}
+            .withName(longName)
+            .withHost(longHost)
+            .withPort(static_cast<int>(i & 1023)); // Moves through the temporary, no heap
+        inlineTotal += config.checksum();
+    }
+    double inlineTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << configCount << " config(s): heap-backed chain " << heapTime
+              << " ms, rvalue inline chain " << inlineTime << " ms (checksums "
+              << heapTotal << " / " << inlineTotal << ", static config port "
+              << staticConfig.getPort() << ")" << std::endl;
+
     return 0;
 }
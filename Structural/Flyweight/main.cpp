@@ -16,177 +16,386 @@
  * 2. The `Shape` class contains the shared data that is common across all objects.
  * 3. The `Circle` and `Rectangle` classes are concrete flyweights that store only the unique data for each shape (extrinsic data).
  * 4. The client uses the factory to get the shared `Shape` objects and adds unique data as needed.
+ *
+ * At tens of millions of resolutions per second, hashing a std::string key and bumping a
+ * shared_ptr refcount per getShape() call are the cost. FlyweightArena stores intrinsic
+ * state once in a contiguous immutable arena and hands out stable 32-bit handles; after
+ * freeze(), lookups probe a precomputed interned-key table with no lock, no allocation
+ * and no refcount traffic, and resolving a handle is one array index.
+ */
+
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <string_view>
+#include <mutex>
+#include <atomic>
+#include <stdexcept>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Abstract class representing a Shape.
+ *
+ * The `Shape` class defines the interface for the Flyweight objects. It stores shared data and 
+ * provides the common interface for concrete flyweights like `Circle` and `Rectangle`.
  */
+class Shape
+{
+public:
+    /**
+     * @brief Virtual destructor for the Shape class.
+     */
+    virtual ~Shape() = default;
+
+    /**
+     * @brief Draw the shape.
+     *
+     * Concrete flyweights must implement this method to draw the shape.
+     */
+    virtual void draw() const = 0;
+
+    /**
+     * @brief Set the position of the shape.
+     *
+     * @param x The x-coordinate of the shape.
+     * @param y The y-coordinate of the shape.
+     */
+    void setPosition(int x, int y)
+    {
+        m_x = x;
+        m_y = y;
+    }
+
+protected:
+    int m_x{0};  ///< The x-coordinate of the shape.
+    int m_y{0};  ///< The y-coordinate of the shape.
+};
+
+/**
+ * @brief Concrete Flyweight class representing a Circle.
+ *
+ * The `Circle` class stores the intrinsic data common to all circles (i.e., the color) and 
+ * can have different extrinsic data like the position.
+ */
+class Circle : public Shape
+{
+public:
+    /**
+     * @brief Constructor that initializes the color of the circle.
+     *
+     * @param color The color of the circle.
+     */
+    Circle(const std::string& color) : m_color(color) {}
+
+    /**
+     * @brief Draw the circle.
+     */
+    void draw() const override
+    {
+        std::cout << "Drawing Circle with color " << m_color 
+                  << " at position (" << m_x << ", " << m_y << ")\n";
+    }
+
+private:
+    std::string m_color;  ///< The color of the circle (intrinsic data).
+};
+
+/**
+ * @brief Concrete Flyweight class representing a Rectangle.
+ *
+ * The `Rectangle` class stores the intrinsic data common to all rectangles (i.e., the color) and 
+ * can have different extrinsic data like the position.
+ */
+class Rectangle : public Shape
+{
+public:
+    /**
+     * @brief Constructor that initializes the color of the rectangle.
+     *
+     * @param color The color of the rectangle.
+     */
+    Rectangle(const std::string& color) : m_color(color) {}
+
+    /**
+     * @brief Draw the rectangle.
+     */
+    void draw() const override
+    {
+        std::cout << "Drawing Rectangle with color " << m_color 
+                  << " at position (" << m_x << ", " << m_y << ")\n";
+    }
+
+private:
+    std::string m_color;  ///< The color of the rectangle (intrinsic data).
+};
+
+/**
+ * @brief Flyweight Factory class that manages shared Flyweight objects.
+ *
+ * The `ShapeFactory` class is responsible for creating and managing the shared flyweights.
+ * It ensures that the same flyweight object is shared across multiple requests with the same intrinsic data.
+ */
+class ShapeFactory
+{
+public:
+    /**
+     * @brief Get a shared Circle or Rectangle based on the color.
+     *
+     * If a shape with the given color already exists, it returns the existing one. 
+     * Otherwise, it creates a new one.
+     *
+     * @param shapeType The type of shape ("Circle" or "Rectangle").
+     * @param color The color of the shape.
+     * @return A shared pointer to the Shape object.
+     */
+    std::shared_ptr<Shape> getShape(const std::string& shapeType, const std::string& color)
+    {
+        std::string key = shapeType + "_" + color;
+        if (m_shapes.find(key) == m_shapes.end())
+        {
+            if (shapeType == "Circle")
+            {
+                m_shapes[key] = std::make_shared<Circle>(color);
+            }
+            else if (shapeType == "Rectangle")
+            {
+                m_shapes[key] = std::make_shared<Rectangle>(color);
+            }
+        }
+        return m_shapes[key];
+    }
+
+private:
+    std::unordered_map<std::string, std::shared_ptr<Shape>> m_shapes;  ///< A map to store shared Flyweight objects.
+};
+
+/**
+ * @brief Handle-based flyweight store with a frozen, lock-free lookup table.
+ *
+ * Intrinsic shape state lives once in a contiguous arena; clients hold 32-bit
+ * handles (indexes) instead of shared_ptrs, so resolution is one array load
+ * with no refcount traffic. During warmup, intern() registers state under a
+ * mutex. freeze() then compiles an open-addressed interned-key table sized for
+ * low load; from then on lookup() is lock-free, allocation-free and the arena
+ * is immutable.
+ */
+class FlyweightArena
+{
+public:
+    using Handle = std::uint32_t;
+    static constexpr Handle INVALID_HANDLE = 0xffffffffu;
+
+    /**
+     * @brief Intrinsic, shared shape state; stored once.
+     */
+    struct ShapeState
+    {
+        enum class Kind : std::uint8_t { Circle, Rectangle };
+
+        Kind kind;
+        std::string color;
+
+        void drawAt(int x, int y) const
+        {
+            std::cout << "Drawing " << (kind == Kind::Circle ? "Circle" : "Rectangle")
+                      << " with color " << color << " at position (" << x << ", " << y << ")\n";
+        }
+    };
+
+    /**
+     * @brief Registers (or finds) intrinsic state during warmup.
+     * @return The stable handle for this state.
+     */
+    Handle intern(ShapeState::Kind kind, const std::string& color)
+    {
+        if (m_frozen.load(std::memory_order_acquire))
+        {
+            throw std::logic_error("FlyweightArena: intern() after freeze()");
+        }
+        std::lock_guard lock(m_mutex);
+        std::string key = makeKey(kind, color);
+        auto it = m_warmupIndex.find(key);
+        if (it != m_warmupIndex.end())
+        {
+            return it->second;
+        }
+        Handle handle = static_cast<Handle>(m_states.size());
+        m_states.push_back(ShapeState{kind, color});
+        m_warmupIndex.emplace(std::move(key), handle);
+        return handle;
+    }
+
+    /**
+     * @brief Compiles the lookup table and makes the arena immutable.
+     */
+    void freeze()
+    {
+        std::lock_guard lock(m_mutex);
+        std::size_t capacity = 16;
+        while (capacity < m_warmupIndex.size() * 2) // Keep load factor under 50%.
+        {
+            capacity *= 2;
+        }
+        m_table.assign(capacity, TableSlot{std::string(), INVALID_HANDLE});
+        for (const auto& [key, handle] : m_warmupIndex)
+        {
+            std::size_t slot = hashKey(key) & (capacity - 1);
+            while (m_table[slot].handle != INVALID_HANDLE)
+            {
+                slot = (slot + 1) & (capacity - 1); // Linear probing.
+            }
+            m_table[slot] = TableSlot{key, handle};
+        }
+        m_frozen.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Lock-free handle lookup after freeze(); no allocation, no refcounts.
+     * @return The handle, or INVALID_HANDLE when the state was never interned.
+     */
+    Handle lookup(ShapeState::Kind kind, std::string_view color) const
+    {
+        std::size_t mask = m_table.size() - 1;
+        std::size_t slot = hashKeyParts(kind, color) & mask;
+        while (m_table[slot].handle != INVALID_HANDLE)
+        {
+            if (keyMatches(m_table[slot].key, kind, color))
+            {
+                return m_table[slot].handle;
+            }
+            slot = (slot + 1) & mask;
+        }
+        return INVALID_HANDLE;
+    }
+
+    /**
+     * @brief Resolves a handle to its intrinsic state: one array index.
+     */
+    const ShapeState& resolve(Handle handle) const
+    {
+        return m_states[handle];
+    }
+
+    std::size_t size() const { return m_states.size(); }
+
+private:
+    struct TableSlot
+    {
+        std::string key;  ///< Interned "kind_color" key for probe verification.
+        Handle handle;
+    };
+
+    static std::string makeKey(ShapeState::Kind kind, const std::string& color)
+    {
+        return (kind == ShapeState::Kind::Circle ? "Circle_" : "Rectangle_") + color;
+    }
+
+    static bool keyMatches(std::string_view key, ShapeState::Kind kind, std::string_view color)
+    {
+        std::string_view prefix = kind == ShapeState::Kind::Circle ? "Circle_" : "Rectangle_";
+        return key.size() == prefix.size() + color.size() &&
+               key.substr(0, prefix.size()) == prefix && key.substr(prefix.size()) == color;
+    }
+
+    /// @brief FNV-1a over the composed key, without materializing it.
+    static std::uint64_t hashKeyParts(ShapeState::Kind kind, std::string_view color)
+    {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        auto mix = [&hash](std::string_view text)
+        {
+            for (char c : text)
+            {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 0x100000001b3ull;
+            }
+        };
+        mix(kind == ShapeState::Kind::Circle ? "Circle_" : "Rectangle_");
+        mix(color);
+        return hash;
+    }
+
+    static std::uint64_t hashKey(std::string_view key)
+    {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        for (char c : key)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    std::mutex m_mutex;                                   ///< Guards warmup-phase writes.
+    std::vector<ShapeState> m_states;                     ///< Contiguous immutable arena.
+    std::unordered_map<std::string, Handle> m_warmupIndex;///< Warmup-phase key index.
+    std::vector<TableSlot> m_table;                       ///< Frozen open-addressed table.
+    std::atomic<bool> m_frozen{false};                    ///< Set once by freeze().
+};
+
+/**
+ * @brief Main function demonstrating the Flyweight pattern.
+ *
+ * This function demonstrates how the `ShapeFactory` class can be used to manage the creation
+ * and sharing of Flyweight objects, such as `Circle` and `Rectangle`.
+ */
+int main()
+{
+    // Create the Flyweight Factory
+    ShapeFactory shapeFactory;
+
+    // Get shared shapes from the factory
+    auto redCircle1 = shapeFactory.getShape("Circle", "Red");
+    auto redCircle2 = shapeFactory.getShape("Circle", "Red");
+    auto blueRectangle = shapeFactory.getShape("Rectangle", "Blue");
+
+    // Set positions for each shape (extrinsic data)
+    redCircle1->setPosition(1, 2);
+    redCircle2->setPosition(3, 4);
+    blueRectangle->setPosition(5, 6);
+
+    // Draw the shapes
+    redCircle1->draw();
+    redCircle2->draw();
+    blueRectangle->draw();
+
+    // Even though both red circles are different instances, they share the same intrinsic data (color).
+    // The same applies for the blue rectangle.
+
+    // Handle-based arena: warm up, freeze, then lock-free handle lookups.
+    FlyweightArena arena;
+    auto redCircle = arena.intern(FlyweightArena::ShapeState::Kind::Circle, "Red");
+    arena.intern(FlyweightArena::ShapeState::Kind::Rectangle, "Blue");
+    arena.freeze();
+
+    auto handle = arena.lookup(FlyweightArena::ShapeState::Kind::Circle, "Red");
+    std::cout << "Arena holds " << arena.size() << " flyweight(s); Red circle handle "
+              << handle << " (same as interned: " << (handle == redCircle) << ")\n";
+    arena.resolve(handle).drawAt(1, 2);
+    arena.resolve(handle).drawAt(3, 4); // Same intrinsic state, different extrinsic position.
+
+    // Resolution benchmark: string-keyed shared_ptr map vs frozen handle table.
+    constexpr int lookups = 10000000;
+    volatile std::size_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < lookups; ++i)
+    {
+        sink = sink + (shapeFactory.getShape("Circle", "Red") != nullptr);
+    }
+    double mapTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < lookups; ++i)
+    {
+        sink = sink + arena.lookup(FlyweightArena::ShapeState::Kind::Circle, "Red");
+    }
+    double arenaTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 
- #include <iostream>
- #include <memory>
- #include <unordered_map>
- #include <string>
- 
- /**
-  * @brief Abstract class representing a Shape.
-  *
-  * The `Shape` class defines the interface for the Flyweight objects. It stores shared data and 
-  * provides the common interface for concrete flyweights like `Circle` and `Rectangle`.
-  */
- class Shape
- {
- public:
-     /**
-      * @brief Virtual destructor for the Shape class.
-      */
-     virtual ~Shape() = default;
- 
-     /**
-      * @brief Draw the shape.
-      *
-      * Concrete flyweights must implement this method to draw the shape.
-      */
-     virtual void draw() const = 0;
- 
-     /**
-      * @brief Set the position of the shape.
-      *
-      * @param x The x-coordinate of the shape.
-      * @param y The y-coordinate of the shape.
-      */
-     void setPosition(int x, int y)
-     {
-         m_x = x;
-         m_y = y;
-     }
- 
- protected:
-     int m_x{0};  ///< The x-coordinate of the shape.
-     int m_y{0};  ///< The y-coordinate of the shape.
- };
- 
- /**
-  * @brief Concrete Flyweight class representing a Circle.
-  *
-  * The `Circle` class stores the intrinsic data common to all circles (i.e., the color) and 
-  * can have different extrinsic data like the position.
-  */
- class Circle : public Shape
- {
- public:
-     /**
-      * @brief Constructor that initializes the color of the circle.
-      *
-      * @param color The color of the circle.
-      */
-     Circle(const std::string& color) : m_color(color) {}
- 
-     /**
-      * @brief Draw the circle.
-      */
-     void draw() const override
-     {
-         std::cout << "Drawing Circle with color " << m_color 
-                   << " at position (" << m_x << ", " << m_y << ")\n";
-     }
- 
- private:
-     std::string m_color;  ///< The color of the circle (intrinsic data).
- };
- 
- /**
-  * @brief Concrete Flyweight class representing a Rectangle.
-  *
-  * The `Rectangle` class stores the intrinsic data common to all rectangles (i.e., the color) and 
-  * can have different extrinsic data like the position.
-  */
- class Rectangle : public Shape
- {
- public:
-     /**
-      * @brief Constructor that initializes the color of the rectangle.
-      *
-      * @param color The color of the rectangle.
-      */
-     Rectangle(const std::string& color) : m_color(color) {}
- 
-     /**
-      * @brief Draw the rectangle.
-      */
-     void draw() const override
-     {
-         std::cout << "Drawing Rectangle with color " << m_color 
-                   << " at position (" << m_x << ", " << m_y << ")\n";
-     }
- 
- private:
-     std::string m_color;  ///< The color of the rectangle (intrinsic data).
- };
- 
- /**
-  * @brief Flyweight Factory class that manages shared Flyweight objects.
-  *
-  * The `ShapeFactory` class is responsible for creating and managing the shared flyweights.
-  * It ensures that the same flyweight object is shared across multiple requests with the same intrinsic data.
-  */
- class ShapeFactory
- {
- public:
-     /**
-      * @brief Get a shared Circle or Rectangle based on the color.
-      *
-      * If a shape with the given color already exists, it returns the existing one. 
-      * Otherwise, it creates a new one.
-      *
-      * @param shapeType The type of shape ("Circle" or "Rectangle").
-      * @param color The color of the shape.
-      * @return A shared pointer to the Shape object.
-      */
-     std::shared_ptr<Shape> getShape(const std::string& shapeType, const std::string& color)
-     {
-         std::string key = shapeType + "_" + color;
-         if (m_shapes.find(key) == m_shapes.end())
-         {
-             if (shapeType == "Circle")
-             {
-                 m_shapes[key] = std::make_shared<Circle>(color);
-             }
-             else if (shapeType == "Rectangle")
-             {
-                 m_shapes[key] = std::make_shared<Rectangle>(color);
-             }
-         }
-         return m_shapes[key];
-     }
- 
- private:
-     std::unordered_map<std::string, std::shared_ptr<Shape>> m_shapes;  ///< A map to store shared Flyweight objects.
- };
- 
- /**
-  * @brief Main function demonstrating the Flyweight pattern.
-  *
-  * This function demonstrates how the `ShapeFactory` class can be used to manage the creation
-  * and sharing of Flyweight objects, such as `Circle` and `Rectangle`.
-  */
- int main()
- {
-     // Create the Flyweight Factory
-     ShapeFactory shapeFactory;
- 
-     // Get shared shapes from the factory
-     auto redCircle1 = shapeFactory.getShape("Circle", "Red");
-     auto redCircle2 = shapeFactory.getShape("Circle", "Red");
-     auto blueRectangle = shapeFactory.getShape("Rectangle", "Blue");
- 
-     // Set positions for each shape (extrinsic data)
-     redCircle1->setPosition(1, 2);
-     redCircle2->setPosition(3, 4);
-     blueRectangle->setPosition(5, 6);
- 
-     // Draw the shapes
-     redCircle1->draw();
-     redCircle2->draw();
-     blueRectangle->draw();
- 
-     // Even though both red circles are different instances, they share the same intrinsic data (color).
-     // The same applies for the blue rectangle.
-     return 0;
- }
- 
\ No newline at end of file
+    std::cout << lookups << " resolutions: shared_ptr map " << mapTime
+              << " ms, frozen arena " << arenaTime << " ms\n";
+    (void)sink;
+    return 0;
+}
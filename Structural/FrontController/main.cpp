@@ -14,113 +14,320 @@
  * - **Centralized Request Handling**: One entry point for request management.
  * - **Decoupling**: Clients do not interact with specific request handlers directly.
  * - **Scalability**: New handlers can be added without modifying existing client code.
+ *
+ * A string-keyed handler map is too slow when dispatch has a budget of tens
+ * of nanoseconds. The compiled controller below interns request types to
+ * dense route ids at registration and dispatches through a direct-indexed
+ * array — no string compares on the hot path — draws handler instances from
+ * per-worker pools so dispatch never allocates, and keeps a per-route
+ * latency histogram in lock-free atomic buckets for live hot-endpoint
+ * visibility.
  */
 
- #include <iostream>
- #include <memory>
- #include <unordered_map>
- #include <string>
- 
- /**
-  * @brief Abstract base class for handling requests.
-  * 
-  * Defines a common interface for all request handlers.
-  */
- class RequestHandler
- {
- public:
-     virtual ~RequestHandler() = default;
- 
-     /**
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <array>
+#include <atomic>
+#include <optional>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Abstract base class for handling requests.
+ *
+ * Defines a common interface for all request handlers.
+ */
+class RequestHandler
+{
+public:
+    virtual ~RequestHandler() = default;
+
+    /**
       * @brief Handles a request.
       * @param request The request string to process.
       */
-     virtual void handleRequest(const std::string &request) const = 0;
- };
- 
- /**
-  * @brief Concrete handler for login requests.
-  */
- class LoginHandler : public RequestHandler
- {
- public:
-     /**
+    virtual void handleRequest(const std::string &request) const = 0;
+};
+
+/**
+ * @brief Concrete handler for login requests.
+ */
+class LoginHandler : public RequestHandler
+{
+public:
+    /**
       * @brief Handles a login request.
       * @param request The request string.
       */
-     void handleRequest(const std::string &request) const override
-     {
-         std::cout << "Handling login request: " << request << std::endl;
-     }
- };
- 
- /**
-  * @brief Concrete handler for data retrieval requests.
-  */
- class DataHandler : public RequestHandler
- {
- public:
-     /**
+    void handleRequest(const std::string &request) const override
+    {
+        std::cout << "Handling login request: " << request << std::endl;
+    }
+};
+
+/**
+ * @brief Concrete handler for data retrieval requests.
+ */
+class DataHandler : public RequestHandler
+{
+public:
+    /**
       * @brief Handles a data request.
       * @param request The request string.
       */
-     void handleRequest(const std::string &request) const override
-     {
-         std::cout << "Handling data retrieval request: " << request << std::endl;
-     }
- };
- 
- /**
-  * @brief Front Controller that manages request handling.
-  * 
-  * Acts as a central entry point for processing requests and delegates them to appropriate handlers.
-  */
- class FrontController
- {
- public:
-     /**
+    void handleRequest(const std::string &request) const override
+    {
+        std::cout << "Handling data retrieval request: " << request << std::endl;
+    }
+};
+
+/**
+ * @brief Front Controller that manages request handling.
+ *
+ * Acts as a central entry point for processing requests and delegates them to appropriate handlers.
+ */
+class FrontController
+{
+public:
+    /**
       * @brief Constructor that initializes request handlers.
       */
-     FrontController()
-     {
-         m_handlers["login"] = std::make_shared<LoginHandler>();
-         m_handlers["data"] = std::make_shared<DataHandler>();
-     }
- 
-     /**
+    FrontController()
+    {
+        m_handlers["login"] = std::make_shared<LoginHandler>();
+        m_handlers["data"] = std::make_shared<DataHandler>();
+    }
+
+    /**
       * @brief Processes a request by delegating to the appropriate handler.
       * @param requestType The type of request (e.g., "login", "data").
       * @param request The actual request data.
       */
-     void processRequest(const std::string &requestType, const std::string &request) const
-     {
-         auto it = m_handlers.find(requestType);
-         if (it != m_handlers.end())
-         {
-             it->second->handleRequest(request);
-         }
-         else
-         {
-             std::cout << "Unknown request type: " << requestType << std::endl;
-         }
-     }
- 
- private:
-     std::unordered_map<std::string, std::shared_ptr<RequestHandler>> m_handlers; ///< Stores request handlers.
- };
- 
- /**
-  * @brief Main function demonstrating the Front Controller pattern.
-  */
- int main()
- {
-     std::shared_ptr<FrontController> controller = std::make_shared<FrontController>();
- 
-     // Client sends requests through the FrontController
-     controller->processRequest("login", "User: Alice");
-     controller->processRequest("data", "Fetch user records");
-     controller->processRequest("unknown", "Some request");  // No handler for this type
- 
-     return 0;
- }
- 
\ No newline at end of file
+    void processRequest(const std::string &requestType, const std::string &request) const
+    {
+        auto it = m_handlers.find(requestType);
+        if (it != m_handlers.end())
+        {
+            it->second->handleRequest(request);
+        }
+        else
+        {
+            std::cout << "Unknown request type: " << requestType << std::endl;
+        }
+    }
+
+private:
+    std::unordered_map<std::string, std::shared_ptr<RequestHandler>> m_handlers; ///< Stores request handlers.
+};
+
+/**
+ * @brief Handler base for the compiled controller; pooled, never shared.
+ */
+class PooledHandler
+{
+public:
+    virtual ~PooledHandler() = default;
+
+    /// @brief Handles one request; the view borrows the caller's buffer.
+    virtual void handle(std::string_view request) = 0;
+};
+
+/**
+ * @brief Pooled counterpart of CountingHandler.
+ */
+class PooledCountingHandler : public PooledHandler
+{
+public:
+    void handle(std::string_view request) override
+    {
+        m_handled += request.size();
+    }
+
+    std::size_t handled() const { return m_handled; }
+
+private:
+    std::size_t m_handled{0}; ///< Bytes seen, as a checksum.
+};
+
+/**
+ * @brief Front controller with interned routes and direct-indexed dispatch.
+ *
+ * registerRoute() interns the request type to a dense RouteId and fills a
+ * per-worker pool of handler instances up front, so dispatch() is an array
+ * index, a pooled-handler virtual call, and a relaxed histogram update —
+ * no string compares, no locks, no allocation. Each worker owns its pool
+ * slot, so workers never contend on handler state.
+ */
+class CompiledFrontController
+{
+public:
+    using RouteId = std::size_t;
+
+    static constexpr std::size_t HISTOGRAM_BUCKETS = 16;    ///< Power-of-two ns buckets.
+    static constexpr std::uint64_t LATENCY_SAMPLE_MASK = 63; ///< Time every 64th dispatch.
+
+    explicit CompiledFrontController(std::size_t workerCount)
+        : m_workerCount(workerCount)
+    {}
+
+    /**
+     * @brief Interns a request type and pre-builds one handler per worker.
+     * @return The dense id to dispatch with; string lookups end here.
+     */
+    RouteId registerRoute(const std::string& requestType,
+                          const std::function<std::unique_ptr<PooledHandler>()>& factory)
+    {
+        RouteId id = m_routes.size();
+        m_routeIds[requestType] = id;
+        auto& route = m_routes.emplace_back();
+        route = std::make_unique<Route>();
+        route->name = requestType;
+        for (std::size_t worker = 0; worker < m_workerCount; ++worker)
+        {
+            route->workerHandlers.push_back(factory()); // Allocated once, here.
+        }
+        return id;
+    }
+
+    /// @brief Resolves a request type once; callers cache the id.
+    std::optional<RouteId> routeId(const std::string& requestType) const
+    {
+        auto it = m_routeIds.find(requestType);
+        if (it == m_routeIds.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Hot path: direct-indexed, allocation-free, lock-free metrics.
+     *
+     * Latency is sampled on every 64th dispatch so the clock reads stay
+     * off the common path; the histogram still tracks the live shape.
+     */
+    void dispatch(RouteId id, std::size_t workerId, std::string_view request)
+    {
+        Route& route = *m_routes[id];
+        std::uint64_t dispatchIndex = route.dispatches.fetch_add(1, std::memory_order_relaxed);
+        if ((dispatchIndex & LATENCY_SAMPLE_MASK) == 0)
+        {
+            auto start = std::chrono::steady_clock::now();
+            route.workerHandlers[workerId]->handle(request);
+            auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            route.histogram[bucketFor(static_cast<std::uint64_t>(nanos))]
+                .fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            route.workerHandlers[workerId]->handle(request); // This worker's own instance.
+        }
+    }
+
+    /// @brief This worker's handler for a route, e.g. to read checksums.
+    PooledHandler& handlerFor(RouteId id, std::size_t workerId)
+    {
+        return *m_routes[id]->workerHandlers[workerId];
+    }
+
+    /// @brief Prints the non-empty latency buckets of one route.
+    void printHistogram(RouteId id) const
+    {
+        const Route& route = *m_routes[id];
+        std::cout << "Latency histogram for \"" << route.name << "\":\n";
+        for (std::size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket)
+        {
+            std::uint64_t count = route.histogram[bucket].load(std::memory_order_relaxed);
+            if (count > 0)
+            {
+                std::cout << "  < " << (1u << (bucket + 1)) << " ns: " << count << '\n';
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief One compiled route: its handlers and its live metrics.
+     */
+    struct Route
+    {
+        std::string name;
+        std::vector<std::unique_ptr<PooledHandler>> workerHandlers; ///< One per worker.
+        std::atomic<std::uint64_t> dispatches{0};                   ///< Drives latency sampling.
+        std::array<std::atomic<std::uint64_t>, HISTOGRAM_BUCKETS> histogram{};
+    };
+
+    /// @brief Maps a nanosecond latency to its power-of-two bucket.
+    static std::size_t bucketFor(std::uint64_t nanos)
+    {
+        std::size_t bucket = 0;
+        while (bucket + 1 < HISTOGRAM_BUCKETS && (2ull << bucket) <= nanos)
+        {
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    std::size_t m_workerCount;
+    std::vector<std::unique_ptr<Route>> m_routes;          ///< Direct-indexed by RouteId.
+    std::unordered_map<std::string, RouteId> m_routeIds;   ///< Registration-time only.
+};
+
+/**
+ * @brief Main function demonstrating the Front Controller pattern.
+ */
+int main()
+{
+    std::shared_ptr<FrontController> controller = std::make_shared<FrontController>();
+
+    // Client sends requests through the FrontController
+    controller->processRequest("login", "User: Alice");
+    controller->processRequest("data", "Fetch user records");
+    controller->processRequest("unknown", "Some request");  // No handler for this type
+
+    // Edge dispatch: string-keyed map vs interned direct-indexed routes.
+    constexpr std::size_t requestCount = 2000000;
+
+    FrontController stringController;
+    CompiledFrontController compiled(1);
+    CompiledFrontController::RouteId loginRoute =
+        compiled.registerRoute("login", []() { return std::make_unique<PooledCountingHandler>(); });
+    CompiledFrontController::RouteId dataRoute =
+        compiled.registerRoute("data", []() { return std::make_unique<PooledCountingHandler>(); });
+
+    std::string request = "payload-0123456789";
+    const std::string types[2] = {"login", "data"};
+
+    std::cout.setstate(std::ios_base::failbit); // Quiet the string path's prints.
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < requestCount; ++i)
+    {
+        stringController.processRequest(types[i & 1], request); // Hash + compare per request.
+    }
+    double stringTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout.clear();
+
+    const CompiledFrontController::RouteId routes[2] = {loginRoute, dataRoute};
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < requestCount; ++i)
+    {
+        compiled.dispatch(routes[i & 1], 0, request); // Array index, no compares.
+    }
+    double compiledTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    auto& loginHandler = static_cast<PooledCountingHandler&>(compiled.handlerFor(loginRoute, 0));
+    auto& dataHandler = static_cast<PooledCountingHandler&>(compiled.handlerFor(dataRoute, 0));
+    std::cout << requestCount << " dispatch(es): string map " << stringTime
+              << " ms, compiled routes " << compiledTime << " ms ("
+              << loginHandler.handled() + dataHandler.handled() << " bytes handled)\n";
+    compiled.printHistogram(loginRoute);
+
+    return 0;
+}
@@ -1,70 +1,218 @@
 /**
  * @brief Object Adapter Pattern Example
- * 
+ *
  * The Object Adapter Pattern allows for an interface of one class to be adapted to
  * a different interface of another class. The adapter wraps the existing object and
  * delegates the call to the adapted interface, making incompatible interfaces compatible.
- * 
+ *
  * Key Concepts:
  * - The adapter acts as a wrapper around an existing object.
  * - Delegates method calls to the wrapped object to make it compatible with the target interface.
  * - Allows existing classes to work with interfaces they weren't originally designed to work with.
- * 
+ *
  * Benefits:
  * - Provides flexibility in working with legacy code without modifying it.
  * - Allows different objects to work together even if they have incompatible interfaces.
  * - Reduces the need to subclass and allows you to compose behavior at runtime.
+ *
+ * The classic adapter charges a virtual hop plus a string copy on every
+ * forwarded call. The CRTP adapter below removes both: the target interface
+ * is a class template over the concrete adapter, so the forward is a direct
+ * inlined call, parameters pass through as string_view/span with zero
+ * copies, and playAll() carries a whole buffer of clips across the legacy
+ * boundary in one call.
  */
 
- #include <iostream>
- #include <memory>
- 
- // Target interface: Expected interface by the client
- class MediaPlayer
- {
- public:
-     virtual void playAudio() = 0; ///< Method to play audio
-     virtual ~MediaPlayer() = default; ///< Virtual destructor
- };
- 
- // Adaptee: Existing class with incompatible interface
- class AudioPlayer
- {
- public:
-     void playAudioFile()
-     {
-         std::cout << "Playing audio file" << std::endl; ///< Method to play audio file
-     }
- };
- 
- // Object Adapter: Adapts the AudioPlayer class to the MediaPlayer interface
- class MediaPlayerAdapter : public MediaPlayer
- {
- public:
-     explicit MediaPlayerAdapter(std::shared_ptr<AudioPlayer> audioPlayer)
-         : m_audioPlayer(std::move(audioPlayer)) {}
- 
-     void playAudio() override
-     {
-         m_audioPlayer->playAudioFile(); ///< Delegates the call to the AudioPlayer object
-     }
- 
- private:
-     std::shared_ptr<AudioPlayer> m_audioPlayer; ///< Wrapped AudioPlayer object
- };
- 
- // Client code
- int main()
- {
-     // Create an instance of AudioPlayer
-     auto m_audioPlayer = std::make_shared<AudioPlayer>();
- 
-     // Adapt the AudioPlayer to MediaPlayer using the Object Adapter
-     std::shared_ptr<MediaPlayer> m_mediaPlayer = std::make_shared<MediaPlayerAdapter>(m_audioPlayer);
- 
-     // Use the adapted object (MediaPlayer interface) to play audio
-     m_mediaPlayer->playAudio();
- 
-     return 0;
- }
- 
\ No newline at end of file
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <chrono>
+#include <cstddef>
+
+// Target interface: Expected interface by the client
+class MediaPlayer
+{
+public:
+    virtual void playAudio() = 0; ///< Method to play audio
+    virtual ~MediaPlayer() = default; ///< Virtual destructor
+};
+
+// Adaptee: Existing class with incompatible interface
+class AudioPlayer
+{
+public:
+    void playAudioFile()
+    {
+        std::cout << "Playing audio file" << std::endl; ///< Method to play audio file
+    }
+};
+
+// Object Adapter: Adapts the AudioPlayer class to the MediaPlayer interface
+class MediaPlayerAdapter : public MediaPlayer
+{
+public:
+    explicit MediaPlayerAdapter(std::shared_ptr<AudioPlayer> audioPlayer)
+        : m_audioPlayer(std::move(audioPlayer)) {}
+
+    void playAudio() override
+    {
+        m_audioPlayer->playAudioFile(); ///< Delegates the call to the AudioPlayer object
+    }
+
+private:
+    std::shared_ptr<AudioPlayer> m_audioPlayer; ///< Wrapped AudioPlayer object
+};
+
+// A clip handed to the playback boundary; views borrow the caller's data
+struct Clip
+{
+    std::string_view name;         ///< Borrowed, never copied
+    std::span<const float> samples; ///< Borrowed, never copied
+};
+
+// Legacy engine (adaptee): quiet decode that accumulates a checksum
+class LegacySampleEngine
+{
+public:
+    void decodeClip(std::string_view name, std::span<const float> samples)
+    {
+        m_checksum += static_cast<double>(name.size());
+        for (float sample : samples)
+        {
+            m_checksum += sample;
+        }
+        ++m_clipsDecoded;
+    }
+
+    double checksum() const { return m_checksum; }
+    std::size_t clipsDecoded() const { return m_clipsDecoded; }
+
+private:
+    double m_checksum{0.0};       ///< Running decode checksum
+    std::size_t m_clipsDecoded{0}; ///< Clips seen by the engine
+};
+
+// Classic adapter boundary: virtual dispatch plus owning-string parameters,
+// so every forwarded call pays an indirection and a heap copy of the name
+class CopyingMediaPlayer
+{
+public:
+    virtual ~CopyingMediaPlayer() = default;
+    virtual void play(std::string name, const std::vector<float>& samples) = 0;
+};
+
+class CopyingEngineAdapter : public CopyingMediaPlayer
+{
+public:
+    explicit CopyingEngineAdapter(std::shared_ptr<LegacySampleEngine> engine)
+        : m_engine(std::move(engine)) {}
+
+    void play(std::string name, const std::vector<float>& samples) override
+    {
+        m_engine->decodeClip(name, samples); ///< The copy already happened at the call site
+    }
+
+private:
+    std::shared_ptr<LegacySampleEngine> m_engine; ///< Wrapped legacy engine
+};
+
+// CRTP target interface: the concrete adapter is known at compile time, so
+// play() is a direct call the compiler inlines — no vtable on the hot path
+template <typename ConcreteAdapter>
+class FastMediaPlayer
+{
+public:
+    // Zero-copy passthrough: views go straight through the seam
+    void play(std::string_view name, std::span<const float> samples)
+    {
+        static_cast<ConcreteAdapter*>(this)->playImpl(name, samples);
+    }
+
+    // Batch passthrough: one adapter crossing for a whole buffer of clips
+    void playAll(std::span<const Clip> clips)
+    {
+        for (const Clip& clip : clips)
+        {
+            static_cast<ConcreteAdapter*>(this)->playImpl(clip.name, clip.samples);
+        }
+    }
+};
+
+// CRTP adapter: the forward is an inlined direct call into the engine
+class FastEngineAdapter : public FastMediaPlayer<FastEngineAdapter>
+{
+public:
+    explicit FastEngineAdapter(std::shared_ptr<LegacySampleEngine> engine)
+        : m_engine(std::move(engine)) {}
+
+    void playImpl(std::string_view name, std::span<const float> samples)
+    {
+        m_engine->decodeClip(name, samples);
+    }
+
+private:
+    std::shared_ptr<LegacySampleEngine> m_engine; ///< Wrapped legacy engine
+};
+
+// Client code
+int main()
+{
+    // Create an instance of AudioPlayer
+    auto m_audioPlayer = std::make_shared<AudioPlayer>();
+
+    // Adapt the AudioPlayer to MediaPlayer using the Object Adapter
+    std::shared_ptr<MediaPlayer> m_mediaPlayer = std::make_shared<MediaPlayerAdapter>(m_audioPlayer);
+
+    // Use the adapted object (MediaPlayer interface) to play audio
+    m_mediaPlayer->playAudio();
+
+    // Adapter overhead: virtual + copies vs CRTP + view passthrough
+    constexpr std::size_t clipCount = 1048576; ///< A whole number of batches
+    constexpr std::size_t batchSize = 256;
+
+    std::vector<std::string> names;
+    names.reserve(clipCount);
+    for (std::size_t i = 0; i < clipCount; ++i)
+    {
+        names.push_back("legacy-archive-audio-clip-track-" + std::to_string(i % 512));
+    }
+    std::vector<float> sampleBank(8);
+    for (std::size_t i = 0; i < sampleBank.size(); ++i)
+    {
+        sampleBank[i] = static_cast<float>(i) * 0.25f;
+    }
+
+    auto copyingEngine = std::make_shared<LegacySampleEngine>();
+    std::shared_ptr<CopyingMediaPlayer> copyingPlayer =
+        std::make_shared<CopyingEngineAdapter>(copyingEngine);
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < clipCount; ++i)
+    {
+        copyingPlayer->play(names[i], sampleBank); // String copied per call
+    }
+    double copyingTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    auto fastEngine = std::make_shared<LegacySampleEngine>();
+    FastEngineAdapter fastPlayer(fastEngine);
+    std::vector<Clip> batch(batchSize);
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < clipCount; i += batchSize)
+    {
+        for (std::size_t j = 0; j < batchSize; ++j)
+        {
+            batch[j] = Clip{names[i + j], sampleBank}; // Views only
+        }
+        fastPlayer.playAll(batch); // One boundary crossing per buffer
+    }
+    double fastTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << clipCount << " clip(s): virtual copying adapter " << copyingTime
+              << " ms, CRTP batch adapter " << fastTime << " ms (checksums "
+              << copyingEngine->checksum() << " / " << fastEngine->checksum()
+              << ", " << fastEngine->clipsDecoded() << " decoded)" << std::endl;
+
+    return 0;
+}
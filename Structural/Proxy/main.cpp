@@ -9,93 +9,323 @@
  * 1. The `RealSubject` class represents the actual object that performs the core functionality.
  * 2. The `Proxy` class controls access to the `RealSubject`, either delaying its creation (lazy initialization) or providing additional functionality like access control.
  * 3. In this example, the `Proxy` class checks if the `RealSubject` is created and, if not, creates it when needed.
+ *
+ * A remote proxy fronting a slow backend should not forward every request.
+ * The caching proxy below memoizes results with a TTL — including negative
+ * caching of misses so repeated lookups of absent keys don't hammer the
+ * backend — coalesces concurrent identical requests onto one in-flight
+ * backend call, and offers an async prefetch() to warm the cache ahead of
+ * anticipated access.
+ */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <optional>
+#include <mutex>
+#include <future>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @brief Abstract Subject class defining common interface.
+ *
+ * This class defines the common interface for both the `RealSubject` and `Proxy`.
+ * This ensures that the Proxy can be used as a replacement for the RealSubject.
  */
+class Subject
+{
+public:
+    virtual ~Subject() = default;
 
- #include <iostream>
- #include <memory>
- 
- /**
-  * @brief Abstract Subject class defining common interface.
-  *
-  * This class defines the common interface for both the `RealSubject` and `Proxy`. 
-  * This ensures that the Proxy can be used as a replacement for the RealSubject.
-  */
- class Subject
- {
- public:
-     virtual ~Subject() = default;
- 
-     /**
+    /**
       * @brief Perform an action.
       *
       * This method should be implemented by both the `RealSubject` and `Proxy`.
       */
-     virtual void request() const = 0;
- };
- 
- /**
-  * @brief RealSubject class representing the actual object.
-  *
-  * The `RealSubject` class is the object that performs the core functionality. 
-  * It is accessed directly by the client when needed.
-  */
- class RealSubject : public Subject
- {
- public:
-     /**
+    virtual void request() const = 0;
+};
+
+/**
+ * @brief RealSubject class representing the actual object.
+ *
+ * The `RealSubject` class is the object that performs the core functionality.
+ * It is accessed directly by the client when needed.
+ */
+class RealSubject : public Subject
+{
+public:
+    /**
       * @brief Perform the core action.
       *
       * This method simulates the core action the real object is responsible for.
       */
-     void request() const override
-     {
-         std::cout << "RealSubject: Handling request." << std::endl;
-     }
- };
- 
- /**
-  * @brief Proxy class controlling access to the RealSubject.
-  *
-  * The `Proxy` class is a placeholder for the `RealSubject`. It controls access to the real object, 
-  * and in this example, it also adds lazy initialization to delay the creation of the `RealSubject`.
-  */
- class Proxy : public Subject
- {
- public:
-     Proxy() = default;
- 
-     /**
+    void request() const override
+    {
+        std::cout << "RealSubject: Handling request." << std::endl;
+    }
+};
+
+/**
+ * @brief Proxy class controlling access to the RealSubject.
+ *
+ * The `Proxy` class is a placeholder for the `RealSubject`. It controls access to the real object,
+ * and in this example, it also adds lazy initialization to delay the creation of the `RealSubject`.
+ */
+class Proxy : public Subject
+{
+public:
+    Proxy() = default;
+
+    /**
       * @brief Perform the action, potentially creating the RealSubject.
       *
       * This method checks if the `RealSubject` is created. If not, it initializes it and then performs the request.
       */
-     void request() const override
-     {
-         if (!m_realSubject)
-         {
-             m_realSubject = std::make_shared<RealSubject>();
-         }
-         m_realSubject->request();
-     }
- 
- private:
-     mutable std::shared_ptr<RealSubject> m_realSubject; ///< Shared pointer to the RealSubject instance.
- };
- 
- /**
-  * @brief Main function demonstrating the Proxy pattern.
-  *
-  * This function demonstrates how the `Proxy` pattern works by using the `Proxy` class to access 
-  * the `RealSubject` through the proxy, controlling access and potentially delaying its creation.
-  */
- int main()
- {
-     // Create a proxy object
-     std::shared_ptr<Subject> proxy = std::make_shared<Proxy>();
- 
-     // The proxy controls access to the RealSubject
-     proxy->request();  // This will create the RealSubject lazily and perform the action.
- 
-     return 0;
- }
- 
\ No newline at end of file
+    void request() const override
+    {
+        if (!m_realSubject)
+        {
+            m_realSubject = std::make_shared<RealSubject>();
+        }
+        m_realSubject->request();
+    }
+
+private:
+    mutable std::shared_ptr<RealSubject> m_realSubject; ///< Shared pointer to the RealSubject instance.
+};
+
+/**
+ * @brief The slow backend a remote proxy fronts; every fetch costs a round trip.
+ */
+class SlowBackend
+{
+public:
+    explicit SlowBackend(std::chrono::microseconds roundTrip)
+        : m_roundTrip(roundTrip)
+    {}
+
+    /// @brief Seeds a key the backend can answer.
+    void store(const std::string& key, const std::string& value)
+    {
+        m_data[key] = value;
+    }
+
+    /**
+     * @brief Fetches a value; absent keys still pay the full round trip.
+     */
+    std::optional<std::string> fetch(const std::string& key)
+    {
+        m_calls.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::sleep_for(m_roundTrip);
+        auto it = m_data.find(key);
+        if (it == m_data.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    std::size_t calls() const { return m_calls.load(std::memory_order_relaxed); }
+
+private:
+    std::unordered_map<std::string, std::string> m_data; ///< Backend table; read-only after seeding.
+    std::chrono::microseconds m_roundTrip;               ///< Simulated network latency.
+    std::atomic<std::size_t> m_calls{0};                 ///< Round trips actually paid.
+};
+
+/**
+ * @brief Caching remote proxy: TTL memoization, negative caching, coalescing.
+ *
+ * Hits — positive or negative — are answered from the cache until their TTL
+ * lapses. A miss under way is tracked in an in-flight table; concurrent
+ * requests for the same key wait on that call's shared future instead of
+ * issuing their own round trip. Negative results get a shorter TTL so a key
+ * that appears on the backend is noticed promptly.
+ */
+class CachingProxy
+{
+public:
+    static constexpr std::chrono::milliseconds POSITIVE_TTL{200}; ///< Fresh window for values.
+    static constexpr std::chrono::milliseconds NEGATIVE_TTL{50};  ///< Shorter, so new keys surface.
+
+    explicit CachingProxy(std::shared_ptr<SlowBackend> backend)
+        : m_backend(std::move(backend))
+    {}
+
+    /**
+     * @brief Answers from cache when fresh; otherwise one coalesced fetch.
+     */
+    std::optional<std::string> get(const std::string& key)
+    {
+        std::shared_future<std::optional<std::string>> inFlight;
+        {
+            std::unique_lock lock(m_mutex);
+            auto now = std::chrono::steady_clock::now();
+            auto it = m_entries.find(key);
+            if (it != m_entries.end() && now < it->second.expiry)
+            {
+                if (it->second.present)
+                {
+                    ++m_hits;
+                    return it->second.value;
+                }
+                ++m_negativeHits; // A remembered miss is still a hit.
+                return std::nullopt;
+            }
+            auto flightIt = m_inFlight.find(key);
+            if (flightIt != m_inFlight.end())
+            {
+                ++m_coalesced;
+                inFlight = flightIt->second; // Share the call already under way.
+            }
+            else
+            {
+                std::promise<std::optional<std::string>> promise;
+                std::shared_future<std::optional<std::string>> future = promise.get_future().share();
+                m_inFlight.emplace(key, future);
+                lock.unlock();
+                std::optional<std::string> result = m_backend->fetch(key); // Round trip, lock released.
+                lock.lock();
+                Entry& entry = m_entries[key];
+                entry.present = result.has_value();
+                entry.value = result.value_or("");
+                entry.expiry = std::chrono::steady_clock::now()
+                             + (entry.present ? POSITIVE_TTL : NEGATIVE_TTL);
+                m_inFlight.erase(key);
+                lock.unlock();
+                promise.set_value(result); // Wake every coalesced waiter.
+                return result;
+            }
+        }
+        return inFlight.get();
+    }
+
+    /// @brief Warms the cache ahead of anticipated access; join via the future.
+    std::future<void> prefetch(const std::string& key)
+    {
+        return std::async(std::launch::async, [this, key]() { (void)get(key); });
+    }
+
+    std::size_t hits() const { return m_hits; }
+    std::size_t negativeHits() const { return m_negativeHits; }
+    std::size_t coalesced() const { return m_coalesced; }
+
+private:
+    /**
+     * @brief One memoized verdict, positive or negative, with its deadline.
+     */
+    struct Entry
+    {
+        bool present{false};
+        std::string value;
+        std::chrono::steady_clock::time_point expiry;
+    };
+
+    std::shared_ptr<SlowBackend> m_backend;
+    std::unordered_map<std::string, Entry> m_entries; ///< Memoized results.
+    std::unordered_map<std::string, std::shared_future<std::optional<std::string>>> m_inFlight; ///< Calls under way.
+    std::mutex m_mutex;
+    std::size_t m_hits{0};         ///< Fresh positive answers.
+    std::size_t m_negativeHits{0}; ///< Fresh remembered misses.
+    std::size_t m_coalesced{0};    ///< Requests that joined an in-flight call.
+};
+
+/**
+ * @brief Main function demonstrating the Proxy pattern.
+ *
+ * This function demonstrates how the `Proxy` pattern works by using the `Proxy` class to access
+ * the `RealSubject` through the proxy, controlling access and potentially delaying its creation.
+ */
+int main()
+{
+    // Create a proxy object
+    std::shared_ptr<Subject> proxy = std::make_shared<Proxy>();
+
+    // The proxy controls access to the RealSubject
+    proxy->request();  // This will create the RealSubject lazily and perform the action.
+
+    // Caching remote proxy: memoized round trips, coalescing, prefetch.
+    constexpr std::size_t keyCount = 40;
+    constexpr std::size_t requestCount = 400;
+
+    auto backend = std::make_shared<SlowBackend>(std::chrono::microseconds(500));
+    for (std::size_t i = 0; i < keyCount; ++i)
+    {
+        backend->store("user:" + std::to_string(i), "profile-" + std::to_string(i));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t directFound = 0;
+    for (std::size_t i = 0; i < requestCount; ++i)
+    {
+        directFound += backend->fetch("user:" + std::to_string(i % keyCount)).has_value() ? 1 : 0;
+    }
+    double directTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::size_t directCalls = backend->calls();
+
+    CachingProxy cachingProxy(backend);
+    start = std::chrono::steady_clock::now();
+    std::size_t cachedFound = 0;
+    for (std::size_t i = 0; i < requestCount; ++i)
+    {
+        cachedFound += cachingProxy.get("user:" + std::to_string(i % keyCount)).has_value() ? 1 : 0;
+    }
+    double cachedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << requestCount << " request(s): direct " << directTime << " ms ("
+              << directCalls << " round trips), cached proxy " << cachedTime
+              << " ms (" << backend->calls() - directCalls << " round trips, "
+              << cachingProxy.hits() << " hits; found " << directFound << " / "
+              << cachedFound << ")\n";
+
+    // Negative caching: repeated misses cost one round trip per TTL window.
+    std::size_t callsBefore = backend->calls();
+    for (int i = 0; i < 50; ++i)
+    {
+        (void)cachingProxy.get("user:unknown");
+    }
+    std::cout << "50 lookups of an absent key: " << backend->calls() - callsBefore
+              << " round trip(s), " << cachingProxy.negativeHits() << " negative hit(s)\n";
+
+    // Coalescing: concurrent identical requests share one in-flight call.
+    callsBefore = backend->calls();
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 8; ++i)
+    {
+        readers.emplace_back([&cachingProxy]() { (void)cachingProxy.get("user:coalesced"); });
+    }
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+    std::cout << "8 concurrent requests for one cold key: " << backend->calls() - callsBefore
+              << " round trip(s), " << cachingProxy.coalesced() << " coalesced\n";
+
+    // Prefetch: pay the round trips before the hot loop needs the keys.
+    CachingProxy warmProxy(backend);
+    std::vector<std::future<void>> warming;
+    for (std::size_t i = 0; i < keyCount; ++i)
+    {
+        warming.push_back(warmProxy.prefetch("user:" + std::to_string(i)));
+    }
+    for (auto& pending : warming)
+    {
+        pending.get();
+    }
+    start = std::chrono::steady_clock::now();
+    std::size_t warmFound = 0;
+    for (std::size_t i = 0; i < requestCount; ++i)
+    {
+        warmFound += warmProxy.get("user:" + std::to_string(i % keyCount)).has_value() ? 1 : 0;
+    }
+    double warmTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << requestCount << " request(s) after prefetch: " << warmTime
+              << " ms, " << warmFound << " found" << std::endl;
+
+    return 0;
+}
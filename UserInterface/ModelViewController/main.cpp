@@ -10,132 +10,384 @@
  * - Separation of concerns: The model, view, and controller can evolve independently.
  * - Increased maintainability: Each layer can be modified without affecting others.
  * - Flexibility: Different views or input methods can be added without changing the model logic.
+ *
+ * Routing a 10k-row table update through per-item notification floods the
+ * view layer: every mutation triggers a rebind of everything. The batch
+ * extensions below store rows contiguously (a vector of structs with stable
+ * row ids), expose bulk mutation APIs that fire a single coalesced
+ * notification per batch, and track the dirty row range so the view
+ * refreshes only the changed slice.
  */
 
- #include <iostream>
- #include <string>
- #include <vector>
- #include <memory>
- 
- /**
-  * @brief Represents the model in the MVC pattern. Manages the list of users.
-  */
- class UserModel
- {
- public:
-     /**
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <span>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Represents the model in the MVC pattern. Manages the list of users.
+ */
+class UserModel
+{
+public:
+    /**
       * @brief Adds a new user to the model.
       * @param userName The name of the user to add.
       */
-     void addUser(const std::string& userName)
-     {
-         m_users.push_back(userName);
-     }
- 
-     /**
+    void addUser(const std::string& userName)
+    {
+        m_users.push_back(userName);
+    }
+
+    /**
       * @brief Retrieves the list of users.
       * @return A vector containing user names.
       */
-     std::vector<std::string> getUsers() const
-     {
-         return m_users;
-     }
- 
- private:
-     std::vector<std::string> m_users; ///< List of users stored in the model.
- };
- 
- /**
-  * @brief Represents the view in the MVC pattern. Displays the list of users.
-  */
- class UserView
- {
- public:
-     /**
+    std::vector<std::string> getUsers() const
+    {
+        return m_users;
+    }
+
+private:
+    std::vector<std::string> m_users; ///< List of users stored in the model.
+};
+
+/**
+ * @brief Represents the view in the MVC pattern. Displays the list of users.
+ */
+class UserView
+{
+public:
+    /**
       * @brief Displays the users to the console.
       * @param users The list of users to display.
       */
-     void showUsers(const std::vector<std::string>& users) const
-     {
-         if (users.empty())
-         {
-             std::cout << "No users found.\n";
-         }
-         else
-         {
-             std::cout << "Users List:\n";
-             for (const auto& user : users)
-             {
-                 std::cout << "- " << user << '\n';
-             }
-         }
-     }
- };
- 
- /**
-  * @brief Represents the controller in the MVC pattern. Manages user input and updates the model.
-  */
- class UserController
- {
- public:
-     /**
+    void showUsers(const std::vector<std::string>& users) const
+    {
+        if (users.empty())
+        {
+            std::cout << "No users found.\n";
+        }
+        else
+        {
+            std::cout << "Users List:\n";
+            for (const auto& user : users)
+            {
+                std::cout << "- " << user << '\n';
+            }
+        }
+    }
+};
+
+/**
+ * @brief Represents the controller in the MVC pattern. Manages user input and updates the model.
+ */
+class UserController
+{
+public:
+    /**
       * @brief Constructor for UserController.
       * @param model The model that stores user data.
       * @param view The view that displays the users.
       */
-     UserController(std::shared_ptr<UserModel> model, std::shared_ptr<UserView> view)
-         : m_model(model), m_view(view)
-     {}
- 
-     /**
+    UserController(std::shared_ptr<UserModel> model, std::shared_ptr<UserView> view)
+        : m_model(model), m_view(view)
+    {}
+
+    /**
       * @brief Adds a new user through the controller and updates the view.
       * @param userName The name of the user to add.
       */
-     void addUser(const std::string& userName)
-     {
-         m_model->addUser(userName); // Update the model
-         updateView(); // Update the view with the latest data
-     }
- 
-     /**
+    void addUser(const std::string& userName)
+    {
+        m_model->addUser(userName); // Update the model
+        updateView(); // Update the view with the latest data
+    }
+
+    /**
       * @brief Displays all users via the view.
       */
-     void showUsers() const
-     {
-         m_view->showUsers(m_model->getUsers());
-     }
- 
- private:
-     /**
+    void showUsers() const
+    {
+        m_view->showUsers(m_model->getUsers());
+    }
+
+private:
+    /**
       * @brief Updates the view with the current list of users from the model.
       */
-     void updateView() const
-     {
-         m_view->showUsers(m_model->getUsers());
-     }
- 
-     std::shared_ptr<UserModel> m_model; ///< The model that stores data.
-     std::shared_ptr<UserView> m_view;   ///< The view that displays the data.
- };
- 
- /**
-  * @brief Main function demonstrating the MVC design pattern.
-  */
- int main()
- {
-     // Create the model, view, and controller objects
-     auto model = std::make_shared<UserModel>();
-     auto view = std::make_shared<UserView>();
-     auto controller = std::make_shared<UserController>(model, view);
- 
-     // Add users through the controller
-     controller->addUser("Alice");
-     controller->addUser("Bob");
-     controller->addUser("Charlie");
- 
-     // Show all users via the controller (which updates the view)
-     controller->showUsers();
- 
-     return 0;
- }
- 
\ No newline at end of file
+    void updateView() const
+    {
+        m_view->showUsers(m_model->getUsers());
+    }
+
+    std::shared_ptr<UserModel> m_model; ///< The model that stores data.
+    std::shared_ptr<UserView> m_view;   ///< The view that displays the data.
+};
+
+/**
+ * @brief Observer interface for range-aware model notifications.
+ */
+class TableObserver
+{
+public:
+    virtual ~TableObserver() = default;
+
+    /**
+     * @brief Called once per committed batch with the dirty row range.
+     * @param firstRow Index of the first changed row.
+     * @param lastRow Index of the last changed row (inclusive).
+     */
+    virtual void onRowsChanged(std::size_t firstRow, std::size_t lastRow) = 0;
+};
+
+/**
+ * @brief Contiguous table model with bulk mutations and dirty-range tracking.
+ *
+ * Rows live in one vector of structs — no per-item heap nodes — and keep
+ * their RowId stable across removals via an id-to-index map. Mutations only
+ * widen the pending dirty range; commit() fires a single coalesced
+ * notification covering everything that changed since the last commit.
+ */
+class TableModel
+{
+public:
+    using RowId = std::uint32_t;
+
+    /**
+     * @brief One table row; stored by value, contiguously.
+     */
+    struct Row
+    {
+        RowId id;
+        std::string name;
+        int visits;
+    };
+
+    void setObserver(TableObserver* observer) { m_observer = observer; }
+
+    /// @brief Appends one row; part of the current batch.
+    RowId addRow(const std::string& name, int visits)
+    {
+        RowId id = m_nextId++;
+        m_index[id] = m_rows.size();
+        m_rows.push_back(Row{id, name, visits});
+        markDirty(m_rows.size() - 1);
+        return id;
+    }
+
+    /// @brief Bulk append: one dirty range covering all new rows.
+    void addRows(std::span<const std::string> names)
+    {
+        m_rows.reserve(m_rows.size() + names.size());
+        for (const std::string& name : names)
+        {
+            addRow(name, 0);
+        }
+    }
+
+    /// @brief Updates one row's visit count; part of the current batch.
+    void updateVisits(RowId id, int visits)
+    {
+        auto it = m_index.find(id);
+        if (it != m_index.end())
+        {
+            m_rows[it->second].visits = visits;
+            markDirty(it->second);
+        }
+    }
+
+    /// @brief Swap-and-pop removal; the moved row joins the dirty range.
+    void removeRow(RowId id)
+    {
+        auto it = m_index.find(id);
+        if (it == m_index.end())
+        {
+            return;
+        }
+        std::size_t index = it->second;
+        m_index.erase(it);
+        if (index != m_rows.size() - 1)
+        {
+            m_rows[index] = std::move(m_rows.back());
+            m_index[m_rows[index].id] = index;
+        }
+        m_rows.pop_back();
+        markDirty(index);
+        if (!m_rows.empty())
+        {
+            markDirty(m_rows.size() - 1); // The tail shrank too.
+        }
+    }
+
+    /**
+     * @brief Fires one coalesced notification for the whole batch.
+     */
+    void commit()
+    {
+        if (m_dirtyFirst > m_dirtyLast)
+        {
+            return; // Nothing changed since the last commit.
+        }
+        std::size_t first = m_dirtyFirst;
+        std::size_t last = std::min(m_dirtyLast, m_rows.empty() ? 0 : m_rows.size() - 1);
+        m_dirtyFirst = SIZE_MAX;
+        m_dirtyLast = 0;
+        if (m_observer && !m_rows.empty())
+        {
+            m_observer->onRowsChanged(first, last);
+        }
+    }
+
+    const std::vector<Row>& rows() const { return m_rows; }
+
+private:
+    /// @brief Widens the pending dirty range to include one row index.
+    void markDirty(std::size_t index)
+    {
+        m_dirtyFirst = std::min(m_dirtyFirst, index);
+        m_dirtyLast = std::max(m_dirtyLast, index);
+    }
+
+    std::vector<Row> m_rows;                        ///< Contiguous row storage.
+    std::unordered_map<RowId, std::size_t> m_index; ///< Stable id -> current index.
+    RowId m_nextId{0};
+    std::size_t m_dirtyFirst{SIZE_MAX};             ///< Pending dirty range, inclusive.
+    std::size_t m_dirtyLast{0};
+    TableObserver* m_observer{nullptr};
+};
+
+/**
+ * @brief View that rebinds its entire row cache on every notification.
+ *
+ * This is the per-row-notification behavior the batch path replaces.
+ */
+class RebindAllView : public TableObserver
+{
+public:
+    explicit RebindAllView(const TableModel& model) : m_model(model) {}
+
+    void onRowsChanged(std::size_t, std::size_t) override
+    {
+        ++m_notifications;
+        m_cache.clear(); // The range is ignored: everything rebinds.
+        for (const TableModel::Row& row : m_model.rows())
+        {
+            m_cache.push_back(row.name);
+            ++m_rowsBound;
+        }
+    }
+
+    std::size_t notifications() const { return m_notifications; }
+    std::size_t rowsBound() const { return m_rowsBound; }
+
+private:
+    const TableModel& m_model;
+    std::vector<std::string> m_cache; ///< The bound display rows.
+    std::size_t m_notifications{0};
+    std::size_t m_rowsBound{0};
+};
+
+/**
+ * @brief View that refreshes only the dirty slice of the table.
+ */
+class RangeBoundView : public TableObserver
+{
+public:
+    explicit RangeBoundView(const TableModel& model) : m_model(model) {}
+
+    void onRowsChanged(std::size_t firstRow, std::size_t lastRow) override
+    {
+        ++m_notifications;
+        const std::vector<TableModel::Row>& rows = m_model.rows();
+        m_cache.resize(rows.size());
+        for (std::size_t i = firstRow; i <= lastRow && i < rows.size(); ++i)
+        {
+            m_cache[i] = rows[i].name; // Only the changed slice rebinds.
+            ++m_rowsBound;
+        }
+    }
+
+    std::size_t notifications() const { return m_notifications; }
+    std::size_t rowsBound() const { return m_rowsBound; }
+
+private:
+    const TableModel& m_model;
+    std::vector<std::string> m_cache; ///< The bound display rows.
+    std::size_t m_notifications{0};
+    std::size_t m_rowsBound{0};
+};
+
+/**
+ * @brief Main function demonstrating the MVC design pattern.
+ */
+int main()
+{
+    // Create the model, view, and controller objects
+    auto model = std::make_shared<UserModel>();
+    auto view = std::make_shared<UserView>();
+    auto controller = std::make_shared<UserController>(model, view);
+
+    // Add users through the controller
+    controller->addUser("Alice");
+    controller->addUser("Bob");
+    controller->addUser("Charlie");
+
+    // Show all users via the controller (which updates the view)
+    controller->showUsers();
+
+    // Admin-table load: per-row notification vs one coalesced batch.
+    constexpr std::size_t rowCount = 10000;
+    constexpr std::size_t updateCount = 500;
+
+    std::vector<std::string> names;
+    names.reserve(rowCount);
+    for (std::size_t i = 0; i < rowCount; ++i)
+    {
+        names.push_back("admin-row-user-" + std::to_string(i));
+    }
+
+    TableModel perRowModel;
+    RebindAllView rebindAllView(perRowModel);
+    perRowModel.setObserver(&rebindAllView);
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string& name : names)
+    {
+        perRowModel.addRow(name, 0);
+        perRowModel.commit(); // One notification per row, full rebind each.
+    }
+    double perRowTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    TableModel batchModel;
+    RangeBoundView rangeView(batchModel);
+    batchModel.setObserver(&rangeView);
+    start = std::chrono::steady_clock::now();
+    batchModel.addRows(names);
+    batchModel.commit(); // One notification for all 10k rows.
+    double batchTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << rowCount << " row(s) loaded: per-row notify " << perRowTime << " ms ("
+              << rebindAllView.notifications() << " notifications, " << rebindAllView.rowsBound()
+              << " rows bound), batched " << batchTime << " ms (" << rangeView.notifications()
+              << " notification, " << rangeView.rowsBound() << " rows bound)\n";
+
+    // An update burst in the middle of the table dirties only that slice.
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < updateCount; ++i)
+    {
+        batchModel.updateVisits(static_cast<TableModel::RowId>(rowCount / 2 + i), 1);
+    }
+    batchModel.commit();
+    double updateTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << updateCount << " update(s): " << updateTime << " ms, view rebound "
+              << rangeView.rowsBound() - rowCount << " row(s) in 1 notification" << std::endl;
+
+    return 0;
+}
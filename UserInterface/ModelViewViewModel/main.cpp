@@ -10,121 +10,364 @@
  * - Separation of concerns between the data, logic, and UI.
  * - Enables easy data formatting for various uses (e.g., API response).
  * - Simplifies testing since the **ViewModel** and **Model** can be tested independently.
+ *
+ * Re-rendering the whole bound view state on every model change burns a
+ * core once thousands of properties update at 1kHz. The differential
+ * binding engine below keeps a per-property dirty flag and version, lets a
+ * frame renderer coalesce updates on a configurable interval so 1kHz input
+ * becomes ~60Hz render work, and tracks the input versions of computed
+ * properties so they recompute only when an input actually changed.
  */
 
- #include <iostream>
- #include <string>
- #include <memory>
- 
- /**
-  * @brief Represents the model in the MVVM pattern. Manages the user's data.
-  */
- class UserModel
- {
- public:
-     /**
+#include <iostream>
+#include <string>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Represents the model in the MVVM pattern. Manages the user's data.
+ */
+class UserModel
+{
+public:
+    /**
       * @brief Sets the user's name.
       * @param name The name of the user.
       */
-     void setName(const std::string& name)
-     {
-         m_name = name;
-     }
- 
-     /**
+    void setName(const std::string& name)
+    {
+        m_name = name;
+    }
+
+    /**
       * @brief Retrieves the user's name.
       * @return The name of the user.
       */
-     std::string getName() const
-     {
-         return m_name;
-     }
- 
-     /**
+    std::string getName() const
+    {
+        return m_name;
+    }
+
+    /**
       * @brief Sets the user's email.
       * @param email The email of the user.
       */
-     void setEmail(const std::string& email)
-     {
-         m_email = email;
-     }
- 
-     /**
+    void setEmail(const std::string& email)
+    {
+        m_email = email;
+    }
+
+    /**
       * @brief Retrieves the user's email.
       * @return The email of the user.
       */
-     std::string getEmail() const
-     {
-         return m_email;
-     }
- 
- private:
-     std::string m_name; ///< The name of the user.
-     std::string m_email; ///< The email of the user.
- };
- 
- /**
-  * @brief Represents the view model in the MVVM pattern. Transforms the model data into a JSON format.
-  */
- class UserViewModel
- {
- public:
-     /**
+    std::string getEmail() const
+    {
+        return m_email;
+    }
+
+private:
+    std::string m_name; ///< The name of the user.
+    std::string m_email; ///< The email of the user.
+};
+
+/**
+ * @brief Represents the view model in the MVVM pattern. Transforms the model data into a JSON format.
+ */
+class UserViewModel
+{
+public:
+    /**
       * @brief Constructor for UserViewModel.
       * @param model The model that stores user data.
       */
-     UserViewModel(std::shared_ptr<UserModel> model)
-         : m_model(model)
-     {}
- 
-     /**
+    UserViewModel(std::shared_ptr<UserModel> model)
+        : m_model(model)
+    {}
+
+    /**
       * @brief Gets the user data formatted as a JSON string.
       * @return The user data in JSON format.
       */
-     std::string getUserAsJson() const
-     {
-         return "{\"name\": \"" + m_model->getName() + "\", \"email\": \"" + m_model->getEmail() + "\"}";
-     }
- 
- private:
-     std::shared_ptr<UserModel> m_model; ///< The model that stores user data.
- };
- 
- /**
-  * @brief Represents the view in the MVVM pattern. Displays the data to the user.
-  */
- class UserView
- {
- public:
-     /**
+    std::string getUserAsJson() const
+    {
+        return "{\"name\": \"" + m_model->getName() + "\", \"email\": \"" + m_model->getEmail() + "\"}";
+    }
+
+private:
+    std::shared_ptr<UserModel> m_model; ///< The model that stores user data.
+};
+
+/**
+ * @brief Represents the view in the MVVM pattern. Displays the data to the user.
+ */
+class UserView
+{
+public:
+    /**
       * @brief Displays the formatted user data in JSON format from the view model.
       * @param viewModel The view model containing the data to display.
       */
-     void displayUserAsJson(const UserViewModel& viewModel)
-     {
-        std::cout << "User Data (JSON Format): " << viewModel.getUserAsJson() << std::endl;
-     }
- };
- 
- /**
-  * @brief Main function demonstrating the MVVM design pattern with JSON output.
-  */
- int main()
- {
-     // Create the model and set some data
-     std::cout << "Create user John Doe" << std::endl;
-     auto model = std::make_shared<UserModel>();
-     model->setName("John Doe");
-     model->setEmail("john.doe@example.com");
- 
-     std::cout << "Pass the user model through the viewModel so it gets formatted" << std::endl;
-     // Create the view model and bind it to the model
-     UserViewModel viewModel(model);
- 
-     // Create the view and display the formatted user data in JSON format
-     UserView view;
-     view.displayUserAsJson(viewModel);
- 
-     return 0;
- }
- 
\ No newline at end of file
+    void displayUserAsJson(const UserViewModel& viewModel)
+    {
+       std::cout << "User Data (JSON Format): " << viewModel.getUserAsJson() << std::endl;
+    }
+};
+
+/**
+ * @brief View model with per-property dirty flags and versioned values.
+ *
+ * set() bumps the property's version and adds it to the dirty list once;
+ * takeDirty() hands the whole list to the renderer and clears the flags.
+ * Computed properties remember the versions of their inputs, so value()
+ * re-evaluates them only when an input actually moved.
+ */
+class DifferentialViewModel
+{
+public:
+    using PropertyId = std::size_t;
+
+    /// @brief Declares a source property with its initial value.
+    PropertyId declareProperty(const std::string& name, double initial)
+    {
+        m_names.push_back(name);
+        m_values.push_back(initial);
+        m_versions.push_back(0);
+        m_dirtyFlags.push_back(false);
+        return m_values.size() - 1;
+    }
+
+    /// @brief Updates a property; no-ops (and stays clean) on equal values.
+    void set(PropertyId id, double value)
+    {
+        if (m_values[id] == value)
+        {
+            return;
+        }
+        m_values[id] = value;
+        ++m_versions[id];
+        if (!m_dirtyFlags[id])
+        {
+            m_dirtyFlags[id] = true;
+            m_dirtyList.push_back(id); // Each property appears at most once.
+        }
+    }
+
+    double value(PropertyId id) const { return m_values[id]; }
+
+    /// @brief Hands over the dirty list and clears every flag.
+    void takeDirty(std::vector<PropertyId>& out)
+    {
+        out.clear();
+        out.swap(m_dirtyList);
+        for (PropertyId id : out)
+        {
+            m_dirtyFlags[id] = false;
+        }
+    }
+
+    using ComputedId = std::size_t;
+
+    /// @brief Declares a computed property over a fixed set of inputs.
+    ComputedId declareComputed(const std::string& name,
+                               std::vector<PropertyId> inputs,
+                               std::function<double(const DifferentialViewModel&)> evaluate)
+    {
+        Computed computed;
+        computed.name = name;
+        computed.inputs = std::move(inputs);
+        computed.evaluate = std::move(evaluate);
+        computed.inputVersions.assign(computed.inputs.size(), std::uint64_t(-1)); // Force first evaluation.
+        m_computed.push_back(std::move(computed));
+        return m_computed.size() - 1;
+    }
+
+    /**
+     * @brief The computed value, re-evaluated only if an input changed.
+     */
+    double computedValue(ComputedId id)
+    {
+        Computed& computed = m_computed[id];
+        bool stale = false;
+        for (std::size_t i = 0; i < computed.inputs.size(); ++i)
+        {
+            if (computed.inputVersions[i] != m_versions[computed.inputs[i]])
+            {
+                computed.inputVersions[i] = m_versions[computed.inputs[i]];
+                stale = true;
+            }
+        }
+        if (stale)
+        {
+            computed.cached = computed.evaluate(*this);
+            ++m_recomputes;
+        }
+        return computed.cached;
+    }
+
+    std::size_t propertyCount() const { return m_values.size(); }
+    std::size_t computedCount() const { return m_computed.size(); }
+    std::size_t recomputes() const { return m_recomputes; }
+
+private:
+    /**
+     * @brief One dependency-tracked computed property.
+     */
+    struct Computed
+    {
+        std::string name;
+        std::vector<PropertyId> inputs;
+        std::function<double(const DifferentialViewModel&)> evaluate;
+        std::vector<std::uint64_t> inputVersions; ///< Input versions at last evaluation.
+        double cached{0.0};
+    };
+
+    std::vector<std::string> m_names;
+    std::vector<double> m_values;            ///< Contiguous property values.
+    std::vector<std::uint64_t> m_versions;   ///< Bumped on every real change.
+    std::vector<bool> m_dirtyFlags;          ///< Guards the dirty list.
+    std::vector<PropertyId> m_dirtyList;     ///< Changed since the last frame.
+    std::vector<Computed> m_computed;
+    std::size_t m_recomputes{0};             ///< Computed evaluations actually run.
+};
+
+/**
+ * @brief Renders frames on a configurable interval, dirty properties only.
+ *
+ * Updates between frames just accumulate in the view model's dirty list;
+ * when a frame is due, the renderer binds the changed properties and pulls
+ * every computed value (cheap version checks, recompute only when stale).
+ */
+class FrameRenderer
+{
+public:
+    FrameRenderer(DifferentialViewModel& viewModel, std::uint64_t frameIntervalMillis)
+        : m_viewModel(viewModel), m_frameInterval(frameIntervalMillis)
+    {}
+
+    /// @brief Renders if the interval elapsed; clock is caller-provided millis.
+    void tick(std::uint64_t nowMillis)
+    {
+        if (nowMillis - m_lastFrame < m_frameInterval)
+        {
+            return;
+        }
+        m_lastFrame = nowMillis;
+        renderFrame();
+    }
+
+    /// @brief One frame: bind the dirty slice, refresh computed bindings.
+    void renderFrame()
+    {
+        ++m_frames;
+        m_viewModel.takeDirty(m_dirtyScratch);
+        for (DifferentialViewModel::PropertyId id : m_dirtyScratch)
+        {
+            m_renderChecksum += m_viewModel.value(id); // Only what changed rebinds.
+            ++m_propertiesRendered;
+        }
+        for (std::size_t id = 0; id < m_viewModel.computedCount(); ++id)
+        {
+            m_renderChecksum += m_viewModel.computedValue(id);
+        }
+    }
+
+    std::size_t frames() const { return m_frames; }
+    std::size_t propertiesRendered() const { return m_propertiesRendered; }
+    double renderChecksum() const { return m_renderChecksum; }
+
+private:
+    DifferentialViewModel& m_viewModel;
+    std::uint64_t m_frameInterval;  ///< Millis between frames (16 ~ 60Hz).
+    std::uint64_t m_lastFrame{0};
+    std::vector<DifferentialViewModel::PropertyId> m_dirtyScratch;
+    std::size_t m_frames{0};
+    std::size_t m_propertiesRendered{0};
+    double m_renderChecksum{0.0};
+};
+
+/**
+ * @brief Main function demonstrating the MVVM design pattern with JSON output.
+ */
+int main()
+{
+    // Create the model and set some data
+    std::cout << "Create user John Doe" << std::endl;
+    auto model = std::make_shared<UserModel>();
+    model->setName("John Doe");
+    model->setEmail("john.doe@example.com");
+
+    std::cout << "Pass the user model through the viewModel so it gets formatted" << std::endl;
+    // Create the view model and bind it to the model
+    UserViewModel viewModel(model);
+
+    // Create the view and display the formatted user data in JSON format
+    UserView view;
+    view.displayUserAsJson(viewModel);
+
+    // Dashboard load: 1kHz feed updates against thousands of bindings.
+    constexpr std::size_t propertyCount = 2000;
+    constexpr std::size_t computedCount = 200;
+    constexpr std::size_t updateCount = 5000;   ///< One per virtual millisecond.
+    constexpr std::uint64_t frameInterval = 16; ///< ~60Hz render cadence.
+
+    // Baseline: every update re-renders every binding and computed value.
+    std::vector<double> naiveValues(propertyCount, 0.0);
+    auto start = std::chrono::steady_clock::now();
+    double naiveChecksum = 0.0;
+    std::size_t naiveRenders = 0;
+    for (std::size_t update = 0; update < updateCount; ++update)
+    {
+        naiveValues[(update * 37) % propertyCount] = static_cast<double>(update);
+        for (double value : naiveValues)
+        {
+            naiveChecksum += value; // Full rebind, every update.
+            ++naiveRenders;
+        }
+        for (std::size_t c = 0; c < computedCount; ++c)
+        {
+            naiveChecksum += naiveValues[c * 3] + naiveValues[c * 3 + 1] + naiveValues[c * 3 + 2];
+        }
+    }
+    double naiveTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Differential engine: dirty flags, 60Hz coalescing, tracked computeds.
+    DifferentialViewModel dashboard;
+    for (std::size_t i = 0; i < propertyCount; ++i)
+    {
+        dashboard.declareProperty("feed." + std::to_string(i), 0.0);
+    }
+    for (std::size_t c = 0; c < computedCount; ++c)
+    {
+        std::vector<DifferentialViewModel::PropertyId> inputs = {c * 3, c * 3 + 1, c * 3 + 2};
+        dashboard.declareComputed("avg." + std::to_string(c), inputs,
+            [inputs](const DifferentialViewModel& vm)
+            {
+                return (vm.value(inputs[0]) + vm.value(inputs[1]) + vm.value(inputs[2])) / 3.0;
+            });
+    }
+    FrameRenderer renderer(dashboard, frameInterval);
+
+    start = std::chrono::steady_clock::now();
+    for (std::size_t update = 0; update < updateCount; ++update)
+    {
+        dashboard.set((update * 37) % propertyCount, static_cast<double>(update));
+        renderer.tick(update); // Virtual millisecond clock: 1kHz in, 60Hz out.
+    }
+    renderer.renderFrame(); // Flush the tail of the last interval.
+    double diffTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << updateCount << " update(s) against " << propertyCount << " binding(s): "
+              << "recompute-everything " << naiveTime << " ms (" << naiveRenders
+              << " rebinds), differential " << diffTime << " ms ("
+              << renderer.frames() << " frames, " << renderer.propertiesRendered()
+              << " rebinds, " << dashboard.recomputes() << " computed recompute(s); "
+              << "checksums " << naiveChecksum << " / " << renderer.renderChecksum()
+              << ")" << std::endl;
+
+    return 0;
+}
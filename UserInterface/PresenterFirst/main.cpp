@@ -10,141 +10,356 @@
  * - Separation of concerns between data (Model), UI (View), and business logic (Presenter).
  * - Promotes testability and flexibility in UI changes, as the Presenter does not directly depend on a specific UI framework.
  * - Facilitates maintenance by isolating the logic of the UI from the data representation.
+ *
+ * When the presenter drives the view synchronously, a slow repaint stalls
+ * model processing. The event-queue seam below decouples them: the model
+ * thread publishes view updates into a bounded lock-free channel and never
+ * blocks on rendering. Updates are conflated — while an element is already
+ * queued, newer values just overwrite its slot, so a view that falls behind
+ * renders only the latest state per element — and the channel tracks queue
+ * depth and conflation counts for instrumentation.
  */
 
- #include <iostream>
- #include <string>
- #include <memory>
- 
- /**
-  * @brief Represents the model in the MVP pattern. Manages the user's data.
-  */
- class UserModel
- {
- public:
-     /**
+#include <iostream>
+#include <string>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <bit>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Represents the model in the MVP pattern. Manages the user's data.
+ */
+class UserModel
+{
+public:
+    /**
       * @brief Sets the user's name.
       * @param name The name of the user.
       */
-     void setName(const std::string& name)
-     {
-         m_name = name;
-     }
- 
-     /**
+    void setName(const std::string& name)
+    {
+        m_name = name;
+    }
+
+    /**
       * @brief Retrieves the user's name.
       * @return The name of the user.
       */
-     std::string getName() const
-     {
-         return m_name;
-     }
- 
- private:
-     std::string m_name; ///< The name of the user.
- };
- 
- /**
-  * @brief Represents the view in the MVP pattern. Displays the data to the user.
-  */
- class UserView
- {
- public:
-     /**
+    std::string getName() const
+    {
+        return m_name;
+    }
+
+private:
+    std::string m_name; ///< The name of the user.
+};
+
+/**
+ * @brief Represents the view in the MVP pattern. Displays the data to the user.
+ */
+class UserView
+{
+public:
+    /**
       * @brief Displays the formatted user data.
       * @param data The data to display.
       */
-     void displayUser(const std::string& data) const
-     {
-         std::cout << "User Data: " << data << std::endl;
-     }
- 
-     /**
+    void displayUser(const std::string& data) const
+    {
+        std::cout << "User Data: " << data << std::endl;
+    }
+
+    /**
       * @brief Sets the presenter to interact with.
       * @param presenter The presenter that controls the view.
       */
-     void setPresenter(std::shared_ptr<class UserPresenter> presenter)
-     {
-         m_presenter = presenter;
-     }
- 
- private:
-     std::shared_ptr<class UserPresenter> m_presenter; ///< The presenter that interacts with this view.
- };
- 
- /**
-  * @brief Represents the presenter in the MVP pattern. Acts as a middleman between the Model and the View.
-  */
- class UserPresenter : public std::enable_shared_from_this<UserPresenter>
- {
- public:
-     /**
+    void setPresenter(std::shared_ptr<class UserPresenter> presenter)
+    {
+        m_presenter = presenter;
+    }
+
+private:
+    std::shared_ptr<class UserPresenter> m_presenter; ///< The presenter that interacts with this view.
+};
+
+/**
+ * @brief Represents the presenter in the MVP pattern. Acts as a middleman between the Model and the View.
+ */
+class UserPresenter : public std::enable_shared_from_this<UserPresenter>
+{
+public:
+    /**
       * @brief Constructs the presenter, taking the model and view.
       * @param model The model that holds user data.
       * @param view The view that displays the data.
       */
-     UserPresenter(std::shared_ptr<UserModel> model, std::shared_ptr<UserView> view)
-         : m_model(model), m_view(view)
-     {
-         // The presenter is constructed, but we will delay calling shared_from_this().
-     }
- 
-     /**
+    UserPresenter(std::shared_ptr<UserModel> model, std::shared_ptr<UserView> view)
+        : m_model(model), m_view(view)
+    {
+        // The presenter is constructed, but we will delay calling shared_from_this().
+    }
+
+    /**
       * @brief Initializes the view by setting the presenter after construction.
       */
-     void initializeView()
-     {
-         m_view->setPresenter(shared_from_this());
-     }
- 
-     /**
+    void initializeView()
+    {
+        m_view->setPresenter(shared_from_this());
+    }
+
+    /**
       * @brief Updates the view with the current user data from the model.
       */
-     void updateView()
-     {
-         std::string data = "Name: " + m_model->getName();
-         m_view->displayUser(data);
-     }
- 
-     /**
+    void updateView()
+    {
+        std::string data = "Name: " + m_model->getName();
+        m_view->displayUser(data);
+    }
+
+    /**
       * @brief Sets the user's name in the model.
       * @param name The name of the user.
       */
-     void setUserName(const std::string& name)
-     {
-         m_model->setName(name);
-         updateView(); // Update the view after setting the name.
-     }
- 
- private:
-     std::shared_ptr<UserModel> m_model; ///< The model that holds user data.
-     std::shared_ptr<UserView> m_view; ///< The view that displays the data.
- };
- 
- /**
-  * @brief Main function demonstrating the Presenter-First (MVP) design pattern.
-  */
- int main()
- {
-     // Create the model and set some initial data
-     auto model = std::make_shared<UserModel>();
-     model->setName("John Doe");
- 
-     // Create the view
-     auto view = std::make_shared<UserView>();
- 
-     // Create the presenter, passing the model and view
-     auto presenter = std::make_shared<UserPresenter>(model, view);
- 
-     // Initialize the view by setting the presenter after the object is fully constructed
-     presenter->initializeView();
- 
-     // Update the view with the current data
-     presenter->updateView();
- 
-     // Change the user's name and update the view again
-     presenter->setUserName("Jane Smith");
- 
-     return 0;
- }
- 
\ No newline at end of file
+    void setUserName(const std::string& name)
+    {
+        m_model->setName(name);
+        updateView(); // Update the view after setting the name.
+    }
+
+private:
+    std::shared_ptr<UserModel> m_model; ///< The model that holds user data.
+    std::shared_ptr<UserView> m_view; ///< The view that displays the data.
+};
+
+/**
+ * @brief Bounded single-producer single-consumer ring of element ids.
+ *
+ * Lock-free: the producer owns the head index, the consumer owns the tail,
+ * and each publishes its side with a release store.
+ */
+class SpscRing
+{
+public:
+    /// @param capacity Must be a power of two.
+    explicit SpscRing(std::size_t capacity)
+        : m_slots(capacity), m_mask(capacity - 1)
+    {}
+
+    /// @brief Producer side; false when the ring is full.
+    bool push(std::uint32_t value)
+    {
+        std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == m_slots.size())
+        {
+            return false;
+        }
+        m_slots[head & m_mask] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Consumer side; false when the ring is empty.
+    bool pop(std::uint32_t& value)
+    {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (m_head.load(std::memory_order_acquire) == tail)
+        {
+            return false;
+        }
+        value = m_slots[tail & m_mask];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Approximate occupancy; exact from the producer's side.
+    std::size_t depth() const
+    {
+        return m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::vector<std::uint32_t> m_slots;
+    std::size_t m_mask;
+    std::atomic<std::size_t> m_head{0}; ///< Producer-owned.
+    std::atomic<std::size_t> m_tail{0}; ///< Consumer-owned.
+};
+
+/**
+ * @brief Conflating view channel: the seam between presenter and view.
+ *
+ * Each view element has a latest-value slot and a pending flag. publish()
+ * overwrites the slot and enqueues the element id only if it was not
+ * already pending — so the ring holds at most one entry per element, the
+ * model thread never blocks, and a view that falls behind repaints just
+ * the newest state. consume() clears the pending flag before reading the
+ * slot, so a publish racing with it safely re-queues the element.
+ */
+class ConflatingViewChannel
+{
+public:
+    ConflatingViewChannel(std::size_t elementCount, std::size_t ringCapacity)
+        : m_ring(ringCapacity), m_values(elementCount), m_pending(elementCount)
+    {}
+
+    /// @brief Model-thread side: overwrite the slot, enqueue if not pending.
+    void publish(std::uint32_t element, double value)
+    {
+        m_values[element].store(std::bit_cast<std::uint64_t>(value), std::memory_order_relaxed);
+        if (!m_pending[element].exchange(true, std::memory_order_acq_rel))
+        {
+            m_ring.push(element); // Cannot fill: at most one entry per element.
+            m_maxDepth = std::max(m_maxDepth, m_ring.depth());
+        }
+        else
+        {
+            m_conflated.fetch_add(1, std::memory_order_relaxed); // Newer value replaced a queued one.
+        }
+        ++m_published;
+    }
+
+    /// @brief View-thread side: the next element and its latest value.
+    bool consume(std::uint32_t& element, double& value)
+    {
+        if (!m_ring.pop(element))
+        {
+            return false;
+        }
+        m_pending[element].store(false, std::memory_order_release); // Before the read: racing publishes re-queue.
+        value = std::bit_cast<double>(m_values[element].load(std::memory_order_acquire));
+        return true;
+    }
+
+    std::size_t published() const { return m_published; }
+    std::size_t conflated() const { return m_conflated.load(std::memory_order_relaxed); }
+    std::size_t maxDepth() const { return m_maxDepth; }
+
+private:
+    SpscRing m_ring;                                ///< Ids awaiting repaint.
+    std::vector<std::atomic<std::uint64_t>> m_values;  ///< Latest value per element.
+    std::vector<std::atomic<bool>> m_pending;          ///< Element already queued?
+    std::size_t m_published{0};                     ///< Model-thread only.
+    std::atomic<std::size_t> m_conflated{0};        ///< Updates absorbed by newer ones.
+    std::size_t m_maxDepth{0};                      ///< Worst backlog seen (model side).
+};
+
+/**
+ * @brief A blotter view whose repaint takes real time per element.
+ */
+class SlowBlotterView
+{
+public:
+    explicit SlowBlotterView(std::chrono::microseconds repaintCost)
+        : m_repaintCost(repaintCost)
+    {}
+
+    /// @brief Repaints one cell; busy-waits to model fixed repaint cost.
+    void renderElement(std::uint32_t element, double value)
+    {
+        auto until = std::chrono::steady_clock::now() + m_repaintCost;
+        while (std::chrono::steady_clock::now() < until)
+        {
+        }
+        m_checksum += value + static_cast<double>(element);
+        ++m_renders;
+    }
+
+    std::size_t renders() const { return m_renders; }
+    double checksum() const { return m_checksum; }
+
+private:
+    std::chrono::microseconds m_repaintCost;
+    std::size_t m_renders{0};
+    double m_checksum{0.0};
+};
+
+/**
+ * @brief Main function demonstrating the Presenter-First (MVP) design pattern.
+ */
+int main()
+{
+    // Create the model and set some initial data
+    auto model = std::make_shared<UserModel>();
+    model->setName("John Doe");
+
+    // Create the view
+    auto view = std::make_shared<UserView>();
+
+    // Create the presenter, passing the model and view
+    auto presenter = std::make_shared<UserPresenter>(model, view);
+
+    // Initialize the view by setting the presenter after the object is fully constructed
+    presenter->initializeView();
+
+    // Update the view with the current data
+    presenter->updateView();
+
+    // Change the user's name and update the view again
+    presenter->setUserName("Jane Smith");
+
+    // Blotter load: synchronous presenter vs the conflating event queue.
+    constexpr std::size_t elementCount = 400;
+    constexpr std::size_t updateCount = 20000;
+    constexpr std::chrono::microseconds repaintCost(20);
+
+    // Synchronous: every model update waits for the repaint it triggers.
+    SlowBlotterView syncView(repaintCost);
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t update = 0; update < updateCount; ++update)
+    {
+        std::uint32_t element = static_cast<std::uint32_t>((update * 13) % elementCount);
+        syncView.renderElement(element, static_cast<double>(update)); // Model stalls here.
+    }
+    double syncTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Decoupled: the model publishes and moves on; the view drains latest-only.
+    ConflatingViewChannel channel(elementCount, 1024);
+    SlowBlotterView asyncView(repaintCost);
+    std::atomic<bool> modelDone{false};
+
+    start = std::chrono::steady_clock::now();
+    std::thread viewThread([&channel, &asyncView, &modelDone]()
+    {
+        std::uint32_t element = 0;
+        double value = 0.0;
+        while (true)
+        {
+            if (channel.consume(element, value))
+            {
+                asyncView.renderElement(element, value);
+            }
+            else if (modelDone.load(std::memory_order_acquire))
+            {
+                break; // Queue drained and no more updates coming.
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    auto modelStart = std::chrono::steady_clock::now();
+    for (std::size_t update = 0; update < updateCount; ++update)
+    {
+        std::uint32_t element = static_cast<std::uint32_t>((update * 13) % elementCount);
+        channel.publish(element, static_cast<double>(update)); // Never blocks on the repaint.
+    }
+    double modelTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - modelStart).count();
+    modelDone.store(true, std::memory_order_release);
+    viewThread.join();
+    double asyncTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << updateCount << " update(s): synchronous " << syncTime << " ms ("
+              << syncView.renders() << " repaints), decoupled model side " << modelTime
+              << " ms, wall " << asyncTime << " ms (" << asyncView.renders()
+              << " repaints, " << channel.conflated() << " conflated, max queue depth "
+              << channel.maxDepth() << ")" << std::endl;
+
+    return 0;
+}